@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArray>
 #include <QString>
 
 class QJsonObject;
@@ -8,4 +9,6 @@ namespace SmileEditor {
     // Publica JSON indentado por troca atômica. O fallback de escrita direta deve permanecer
     // desativado para preservar o arquivo anterior em qualquer falha.
     bool WriteJsonSidecar(const QString& Path, const QJsonObject& Root, const char* Label);
+    // Mesma troca atômica para um payload já serializado (o .smap binário e a exportação JSON dele).
+    bool WriteSidecarBytes(const QString& Path, const QByteArray& Payload, const char* Label);
 }
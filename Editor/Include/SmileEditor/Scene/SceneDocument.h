@@ -5,6 +5,11 @@
 #include <QVector>
 #include "SmileEditor/Viewport/RenderThread.h"
 #include "Smile/Math/Math.h"
+#include "Smile/Scene/SceneMap.h"
+
+#include <vector>
+
+namespace Smile { struct FRenderable; }
 
 namespace SmileEditor {
     // Camada AUTORADA da cena, persistida em <cena>.smap.
@@ -20,6 +25,11 @@ namespace SmileEditor {
     // (a origem no asset), nunca pelo indice na lista viva, que anda a cada remocao, nem pelo
     // Id, que so vale dentro da sessao.
     //
+    // FORMATO: desde a v2 o arquivo e binario (Smile/Scene/SceneMap.h) — registros fixos lidos no
+    // lugar e aplicados numa passada, porque o DOM JSON da v1 pesava com dezenas de milhares de
+    // edicoes. O diff legivel continua disponivel por exportJson(), no schema da v1, e um .smap
+    // v1 antigo ainda abre (o proximo save o regrava em binario).
+    //
     // ESCOPO: cobre a camada de OBJETOS (visibilidade, transform, criados, apagados). O
     // <cena>.materials.json e o <cena>.terrain.json seguem separados de proposito — aquele e
     // chaveado pela identidade do MATERIAL e vale para o asset em qualquer mapa, e este e um
@@ -43,6 +53,8 @@ namespace SmileEditor {
         // Chamado por quem muta a camada autorada (outliner: criar/apagar/esconder; gizmo: mover).
         Q_INVOKABLE void markDirty();
         Q_INVOKABLE bool save();
+        // <cena>.smap.json com o estado ATUAL (o que o save gravaria), para diff e revisao.
+        Q_INVOKABLE bool exportJson();
         Q_INVOKABLE QString mapPath() const { return MapPath; }
 
     signals:
@@ -50,7 +62,9 @@ namespace SmileEditor {
         void Applied(); // .smap aplicado: as pontes precisam reconstruir suas listas
 
     private:
-        bool Apply(const QString& Json);
+        bool Apply(const Smile::FSceneMapView& Map);
+        // Diff da lista viva contra o Baseline: o conteudo do .smap (save e exportJson).
+        void Capture(const std::vector<Smile::FRenderable>& List, Smile::FSceneMap& Out) const;
 
         RendererHandle Renderer;
         QString        MapPath;
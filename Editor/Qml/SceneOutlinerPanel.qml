@@ -318,10 +318,16 @@ Rectangle {
                     sceneDoc.save()
                 }
             }
+            // O .smap e binario desde a v2; o diff legivel sai por aqui, sem tocar o arquivo salvo.
+            TapHandler {
+                enabled: lightsModel.hasSceneFile
+                acceptedButtons: Qt.RightButton
+                onTapped: sceneDoc.exportJson()
+            }
             ToolTip.visible: saveHover.hovered
             ToolTip.delay: 600
             ToolTip.text: lightsModel.hasSceneFile
-                          ? "Salvar cena (<cena>.smap) + luzes"
+                          ? "Salvar cena (<cena>.smap) + luzes\nBotão direito: exportar <cena>.smap.json"
                           : "Carregue uma cena para salvar"
         }
         Item {
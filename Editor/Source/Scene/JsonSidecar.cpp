@@ -7,6 +7,10 @@
 
 namespace SmileEditor {
     bool WriteJsonSidecar(const QString& _Path, const QJsonObject& _Root, const char* _Label) {
+        return WriteSidecarBytes(_Path, QJsonDocument(_Root).toJson(QJsonDocument::Indented), _Label);
+    }
+
+    bool WriteSidecarBytes(const QString& _Path, const QByteArray& _Payload, const char* _Label) {
         const std::string Where = std::string(_Label) + ": " + _Path.toStdString();
 
         QSaveFile File(_Path);
@@ -16,13 +20,12 @@ namespace SmileEditor {
             return false;
         }
 
-        const QByteArray Payload = QJsonDocument(_Root).toJson(QJsonDocument::Indented);
-        const qint64 Written = File.write(Payload);
-        if (Written != Payload.size()) {
+        const qint64 Written = File.write(_Payload);
+        if (Written != _Payload.size()) {
             // Impede que um commit futuro publique um payload incompleto.
             File.cancelWriting();
             Smile::LogError(Where + " — escrita incompleta (" + std::to_string(Written) + " de " +
-                            std::to_string(Payload.size()) + " bytes); o arquivo anterior foi "
+                            std::to_string(_Payload.size()) + " bytes); o arquivo anterior foi "
                             "preservado");
             return false;
         }
@@ -58,6 +58,8 @@ namespace SmileEditor {
 
         explicit operator bool() const { return Value != nullptr; }
         std::vector<Smile::FLight>* operator->() const { return Value; }
+        // Add/remove passam pela cena (AddLight/RemoveLight), que mantem a tabela de Id.
+        Smile::FScene& Scene() const { return Access->GetScene(); }
         Smile::FLight& operator[](size_t _Index) const { return (*Value)[_Index]; }
         size_t size() const { return Value ? Value->size() : 0; }
         auto begin() const { return Value ? Value->begin() : Empty().begin(); }
@@ -344,7 +346,7 @@ namespace SmileEditor {
         L.Position = Renderer->GetCameraPos() + Fwd * 5.0f;
 
         auto Lights = LightsOf(Renderer);
-        Lights->push_back(L);
+        Lights.Scene().AddLight(L);
         Renderer->SetSelectedLight((int)Lights.size() - 1);
         Renderer->ClearSelection(); // selecao de luz e de renderavel sao exclusivas
         // Luz nova ilumina uma regiao que ate agora estava sem ela: mesma invalidacao de uma
@@ -363,7 +365,7 @@ namespace SmileEditor {
         // apagada fica no atlas (mesmo motivo do Renderer::RemoveRenderable).
         Smile::Vec3 GoneMin, GoneMax;
         Lights[(size_t)_Index].InfluenceBounds(GoneMin, GoneMax);
-        Lights->erase(Lights->begin() + _Index);
+        Lights.Scene().RemoveLight(Lights.Scene().EnsureLightId((Smile::u32)_Index));
         Renderer->NotifyGIRegionChanged(GoneMin, GoneMax, Smile::EGIRegionChange::Radiometric);
         Renderer->Settings().MarkSceneContentDirty();
 
@@ -381,12 +383,11 @@ namespace SmileEditor {
         auto Lights = LightsOf(Renderer);
         if (_Index < 0 || _Index >= (int)Lights.size()) return;
         Smile::FLight Copy = Lights[(size_t)_Index];
-        Copy.Id = 0; // copia nasce SEM identidade: o renderer atribui uma nova no proximo
-                     // frame. Herdar o Id faria as duas luzes disputarem o mesmo slot de
-                     // shadow map (uma piscaria em cima da outra).
+        // O AddLight da um Id novo a copia. Herdar o Id faria as duas luzes disputarem o mesmo
+        // slot de shadow map (uma piscaria em cima da outra).
         Copy.Name += " (copia)";
         Copy.Position.X += 1.0f; // desloca pro marker nao nascer em cima do original
-        Lights->push_back(Copy);
+        Lights.Scene().AddLight(Copy);
         Renderer->SetSelectedLight((int)Lights.size() - 1);
         Renderer->ClearSelection();
         Smile::Vec3 CopyMin, CopyMax; Copy.InfluenceBounds(CopyMin, CopyMax);
@@ -499,7 +500,7 @@ namespace SmileEditor {
             // O JSON é fronteira de entrada; preserve o default legado e aplique o mesmo clamp.
             L.RTWeight          = std::clamp(
                 (float)O.value(QStringLiteral("rtWeight")).toDouble(1.0), 0.0f, 1.0f);
-            Lights->push_back(L);
+            Lights.Scene().AddLight(L);
             ++Loaded;
             // Mantem os sequenciais de nome a frente dos "Point N"/"Spot N" carregados.
             if (L.Type == Smile::ELightType::Spot) ++SpotSeq; else ++PointSeq;
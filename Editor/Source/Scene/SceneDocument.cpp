@@ -2,6 +2,7 @@
 #include "SmileEditor/Scene/JsonSidecar.h"
 #include "Smile/Graphics/Renderer/Renderer.h"
 #include "Smile/Scene/Scene.h"
+#include "Smile/Scene/SceneMap.h"
 #include "Smile/Core/Logger.h"
 
 #include <QFile>
@@ -14,17 +15,77 @@
 
 namespace SmileEditor {
     namespace {
-        constexpr int kMapVersion = 1;
+        constexpr int kJsonMapVersion = 1; // a v1 do .smap; continua sendo o schema da exportacao
 
-        QJsonArray Vec3ToJson(const Smile::Vec3& V) {
-            return QJsonArray{ V.X, V.Y, V.Z };
-        }
         Smile::Vec3 JsonToVec3(const QJsonArray& A, const Smile::Vec3& Def) {
             if (A.size() != 3) return Def;
             return Smile::Vec3{ (float)A.at(0).toDouble(Def.X),
                                 (float)A.at(1).toDouble(Def.Y),
                                 (float)A.at(2).toDouble(Def.Z) };
         }
+        void StoreVec3(const Smile::Vec3& V, Smile::f32 (&Out)[3]) {
+            Out[0] = V.X; Out[1] = V.Y; Out[2] = V.Z;
+        }
+        Smile::Vec3 LoadVec3(const Smile::f32 (&V)[3]) {
+            return Smile::Vec3{ V[0], V[1], V[2] };
+        }
+        // Campo ausente no JSON = o valor que o registro binario ja tem (o do cozido/da fonte):
+        // o mesmo default que a v1 aplicava direto no FRenderable.
+        void JsonToField(const QJsonObject& O, const char* Key, Smile::f32 (&Out)[3]) {
+            StoreVec3(JsonToVec3(O.value(QLatin1String(Key)).toArray(), LoadVec3(Out)), Out);
+        }
+
+        // .smap v1 (JSON) -> os mesmos registros da v2, em memoria. Caminho de COMPATIBILIDADE:
+        // mapas salvos antes da v2 continuam abrindo (e o proximo save os regrava em binario), e
+        // e tambem como uma exportacao editada a mao volta para a cena.
+        bool ReadJsonMap(const QByteArray& Bytes, Smile::FSceneMap& Out, QString& Error) {
+            QJsonParseError Err{};
+            const QJsonDocument Doc = QJsonDocument::fromJson(Bytes, &Err);
+            if (Doc.isNull() || !Doc.isObject()) {
+                Error = QStringLiteral("JSON invalido (") + Err.errorString() + QStringLiteral(")");
+                return false;
+            }
+            const QJsonObject Root = Doc.object();
+            if (Root.value(QStringLiteral("version")).toInt(0) != kJsonMapVersion) {
+                Error = QStringLiteral("versao diferente da suportada");
+                return false;
+            }
+            for (const QJsonValue& V : Root.value(QStringLiteral("overrides")).toArray()) {
+                const QJsonObject O = V.toObject();
+                Smile::SSceneMapOverride R{};
+                R.Cooked = O.value(QStringLiteral("cooked")).toInt(-1);
+                if (O.contains(QStringLiteral("pos"))) {
+                    R.Flags |= Smile::kSMapTransform;
+                    R.Scale[0] = R.Scale[1] = R.Scale[2] = 1.0f;
+                    JsonToField(O, "pos", R.Position);
+                    JsonToField(O, "rot", R.Rotation);
+                    JsonToField(O, "scale", R.Scale);
+                }
+                if (!O.value(QStringLiteral("visible")).toBool(true)) R.Flags |= Smile::kSMapHidden;
+                if (O.value(QStringLiteral("dynamic")).toBool(false)) R.Flags |= Smile::kSMapDynamic;
+                Out.Overrides.push_back(R);
+            }
+            for (const QJsonValue& V : Root.value(QStringLiteral("spawned")).toArray()) {
+                const QJsonObject O = V.toObject();
+                Smile::SSceneMapSpawn S{};
+                S.From = O.value(QStringLiteral("from")).toInt(-1);
+                // Sem "pos" a v1 mantinha o transform da fonte; sem kSMapTransform o Apply tambem.
+                if (O.contains(QStringLiteral("pos"))) {
+                    S.Flags |= Smile::kSMapTransform;
+                    S.Scale[0] = S.Scale[1] = S.Scale[2] = 1.0f;
+                    JsonToField(O, "pos", S.Position);
+                    JsonToField(O, "rot", S.Rotation);
+                    JsonToField(O, "scale", S.Scale);
+                }
+                if (!O.value(QStringLiteral("visible")).toBool(true)) S.Flags |= Smile::kSMapHidden;
+                if (O.value(QStringLiteral("dynamic")).toBool(false)) S.Flags |= Smile::kSMapDynamic;
+                Out.AddSpawn(S, O.value(QStringLiteral("name")).toString().toStdString());
+            }
+            for (const QJsonValue& V : Root.value(QStringLiteral("deleted")).toArray())
+                Out.Deleted.push_back(V.toInt(-1));
+            return true;
+        }
+
         bool NearlyEqual(const Smile::Vec3& A, const Smile::Vec3& B) {
             // Tolerancia frouxa de proposito: o transform vem de uma decomposicao em float, e
             // gravar um "override" por causa de 1e-7 de ruido encheria o .smap de entradas que
@@ -67,88 +128,100 @@ namespace SmileEditor {
                 if (R.CookedIndex < 0) continue;
                 if (R.CookedIndex >= CookedCount) CookedCount = R.CookedIndex + 1;
                 if (Baseline.size() <= R.CookedIndex) Baseline.resize(R.CookedIndex + 1);
-                Baseline[R.CookedIndex] = { R.Transform.Position, R.Transform.RotationEuler,
-                                            R.Transform.Scale };
+                // Em MUNDO, como o .smap: o Transform de um filho e relativo ao pai.
+                const Smile::FTransform W = R.WorldTransform();
+                Baseline[R.CookedIndex] = { W.Position, W.RotationEuler, W.Scale };
             }
         }
 
         QFile File(MapPath);
         if (!File.exists()) { emit DirtyChanged(); return; }
-        if (!File.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (!File.open(QIODevice::ReadOnly)) {
             Smile::LogWarning("Mapa: nao foi possivel abrir " + MapPath.toStdString());
             emit DirtyChanged();
             return;
         }
-        const QString Json = QString::fromUtf8(File.readAll());
+        const QByteArray Bytes = File.readAll();
         File.close();
-        if (Apply(Json)) emit Applied();
-        emit DirtyChanged();
-    }
 
-    bool SceneDocument::Apply(const QString& _Json) {
-        QJsonParseError Err{};
-        const QJsonDocument Doc = QJsonDocument::fromJson(_Json.toUtf8(), &Err);
-        if (Doc.isNull() || !Doc.isObject()) {
-            Smile::LogError("Mapa: JSON invalido em " + MapPath.toStdString() + " (" +
-                            Err.errorString().toStdString() + ")");
-            return false;
-        }
-        const QJsonObject Root = Doc.object();
-        if (Root.value(QStringLiteral("version")).toInt(0) != kMapVersion) {
-            Smile::LogWarning("Mapa: versao diferente da suportada; ignorado");
-            return false;
+        // v2 (binario) e lido no lugar: as views apontam para `Bytes`, que vive ate o fim do
+        // Apply. Sem o magic, e um mapa v1 (JSON) — convertido para os mesmos registros.
+        const std::span<const Smile::u8> Raw(reinterpret_cast<const Smile::u8*>(Bytes.constData()),
+                                             (size_t)Bytes.size());
+        Smile::FSceneMapView View;
+        Smile::FSceneMap     Converted;
+        if (Smile::IsBinarySceneMap(Raw)) {
+            std::string Error;
+            if (!Smile::ParseSceneMap(Raw, View, Error)) {
+                Smile::LogError("Mapa: " + MapPath.toStdString() + ": " + Error);
+                emit DirtyChanged();
+                return;
+            }
+        } else {
+            QString Error;
+            if (!ReadJsonMap(Bytes, Converted, Error)) {
+                Smile::LogError("Mapa: " + MapPath.toStdString() + ": " + Error.toStdString() + "; ignorado");
+                emit DirtyChanged();
+                return;
+            }
+            View = Converted.View();
+            Smile::LogInfo("Mapa: " + QFileInfo(MapPath).fileName().toStdString() +
+                           " e v1 (JSON); o proximo save o regrava em binario");
         }
+        if (Apply(View)) emit Applied();
+        emit DirtyChanged();
+    }
 
+    bool SceneDocument::Apply(const Smile::FSceneMapView& _Map) {
         auto Access = Renderer.Lock();
         if (!Access) return false;
         auto& Scene = Access->GetScene();
 
         // Indice do cozido -> posicao atual na lista. Montado UMA vez: aplicar N edicoes com
-        // busca linear seria O(N*M) numa cena de milhares de objetos.
-        QHash<int, int> ByCooked;
+        // busca linear seria O(N*M) numa cena de milhares de objetos. Tabela densa e nao hash: o
+        // cozido numera de 0 a CookedCount-1.
+        Smile::FCookedIndexMap ByCooked;
         {
             const auto& List = Scene.Renderables();
+            ByCooked.Reset((Smile::u32)CookedCount);
             for (int i = 0; i < (int)List.size(); ++i)
-                if (!List[i].Spawned && List[i].CookedIndex >= 0)
-                    ByCooked.insert(List[i].CookedIndex, i);
+                if (!List[i].Spawned && List[i].CookedIndex >= 0) ByCooked.Set(List[i].CookedIndex, i);
         }
 
         int Hidden = 0, Moved = 0, Spawned = 0, Removed = 0, Dynamic = 0;
 
-        // 1) Overrides sobre objetos que vieram do asset.
-        for (const QJsonValue& V : Root.value(QStringLiteral("overrides")).toArray()) {
-            const QJsonObject O = V.toObject();
-            const int Cooked = O.value(QStringLiteral("cooked")).toInt(-1);
-            const auto It = ByCooked.constFind(Cooked);
-            if (It == ByCooked.constEnd()) continue; // o asset mudou; ignora em silencio
-            Smile::FRenderable& R = Scene.Renderables()[(size_t)It.value()];
-            if (O.contains(QStringLiteral("visible"))) {
-                R.Visible = O.value(QStringLiteral("visible")).toBool(true);
-                if (!R.Visible) ++Hidden;
+        // 1) Overrides sobre objetos que vieram do asset. Uma passada sobre registros fixos: e o
+        // passo que escala com o tamanho da edicao, e o unico que nao chama o Renderer.
+        auto& List = Scene.Renderables();
+        for (const Smile::SSceneMapOverride& O : _Map.Overrides) {
+            const Smile::i32 Live = ByCooked.Find(O.Cooked);
+            if (Live < 0) continue; // o asset mudou; ignora em silencio
+            Smile::FRenderable& R = List[(size_t)Live];
+            // So esconde: sem a flag o Visible fica como esta, igual a v1 sem a chave "visible" —
+            // o .visibility.json antigo ja foi aplicado antes e nao pode ser desfeito aqui.
+            if (O.Flags & Smile::kSMapHidden) {
+                R.Visible = false;
+                ++Hidden;
             }
-            if (O.contains(QStringLiteral("pos"))) {
-                R.Transform.Position = JsonToVec3(O.value(QStringLiteral("pos")).toArray(),
-                                                  R.Transform.Position);
-                R.Transform.RotationEuler = JsonToVec3(O.value(QStringLiteral("rot")).toArray(),
-                                                       R.Transform.RotationEuler);
-                R.Transform.Scale = JsonToVec3(O.value(QStringLiteral("scale")).toArray(),
-                                               R.Transform.Scale);
-                R.RefreshWorldBounds();
+            if (O.Flags & Smile::kSMapTransform) {
+                // Mundo -> local do pai. O pai vem antes do filho no cozido, entao um pai movido
+                // pelo mesmo mapa ja esta no lugar quando o filho e convertido.
+                Scene.SetWorldTransform(static_cast<Smile::u32>(Live),
+                                        { LoadVec3(O.Position), LoadVec3(O.Rotation), LoadVec3(O.Scale) });
                 ++Moved;
             }
             // Ausente = estatico (o default). So aparece no arquivo quem foi marcado.
-            if (O.value(QStringLiteral("dynamic")).toBool(false)) {
+            if (O.Flags & Smile::kSMapDynamic) {
                 R.Mobility = Smile::EMobility::Dynamic;
                 ++Dynamic;
             }
         }
 
         // 2) Objetos criados no editor: recria duplicando a fonte, que e o que a copia e.
-        for (const QJsonValue& V : Root.value(QStringLiteral("spawned")).toArray()) {
-            const QJsonObject O = V.toObject();
-            const auto It = ByCooked.constFind(O.value(QStringLiteral("from")).toInt(-1));
-            if (It == ByCooked.constEnd()) continue;
-            const Smile::u64 SourceId = Scene.Renderables()[(size_t)It.value()].Id;
+        for (const Smile::SSceneMapSpawn& O : _Map.Spawned) {
+            const Smile::i32 Live = ByCooked.Find(O.From);
+            if (Live < 0) continue;
+            const Smile::u64 SourceId = Scene.Renderables()[(size_t)Live].Id;
             // WRAPPER do Renderer, e nao o Scene.DuplicateRenderable CRU: o do FScene deixa a
             // lista consistente e o RENDERER desatualizado — o proprio Scene.h avisa disso, e
             // diz que o caminho suportado com a cena carregada e este. Um .smap com "spawned" e
@@ -175,17 +248,16 @@ namespace SmileEditor {
             // ponteiro obtido antes dele nao sobreviveria.
             Smile::FRenderable* Copy = Scene.FindRenderable(NewId);
             if (!Copy) continue;
-            Copy->Name = O.value(QStringLiteral("name")).toString(
-                             QString::fromStdString(Copy->Name)).toStdString();
-            Copy->Visible = O.value(QStringLiteral("visible")).toBool(true);
-            Copy->Transform.Position = JsonToVec3(O.value(QStringLiteral("pos")).toArray(),
-                                                  Copy->Transform.Position);
-            Copy->Transform.RotationEuler = JsonToVec3(O.value(QStringLiteral("rot")).toArray(),
-                                                       Copy->Transform.RotationEuler);
-            Copy->Transform.Scale = JsonToVec3(O.value(QStringLiteral("scale")).toArray(),
-                                               Copy->Transform.Scale);
-            Copy->RefreshWorldBounds();
-            if (O.value(QStringLiteral("dynamic")).toBool(false))
+            const std::string_view Name = _Map.NameOf(O);
+            if (!Name.empty()) Copy->Name = std::string(Name);
+            Copy->Visible = (O.Flags & Smile::kSMapHidden) == 0;
+            if (O.Flags & Smile::kSMapTransform) {
+                const int CopyIndex = Scene.IndexOfRenderable(NewId);
+                if (CopyIndex >= 0)
+                    Scene.SetWorldTransform(static_cast<Smile::u32>(CopyIndex),
+                                            { LoadVec3(O.Position), LoadVec3(O.Rotation), LoadVec3(O.Scale) });
+            }
+            if (O.Flags & Smile::kSMapDynamic)
                 Copy->Mobility = Smile::EMobility::Dynamic;
             ++Spawned;
         }
@@ -193,17 +265,14 @@ namespace SmileEditor {
         // 3) Apagados. POR ULTIMO de proposito: remover embaralha os indices vivos, e o mapa
         // ByCooked acima ficaria podre para os passos 1 e 2.
         {
-            QVector<Smile::u64> ToRemove;
-            const QJsonArray Deleted = Root.value(QStringLiteral("deleted")).toArray();
-            for (const QJsonValue& V : Deleted) {
-                const auto It = ByCooked.constFind(V.toInt(-1));
-                if (It != ByCooked.constEnd())
-                    ToRemove.push_back(Scene.Renderables()[(size_t)It.value()].Id);
+            std::vector<Smile::u64> ToRemove;
+            for (const Smile::i32 Cooked : _Map.Deleted) {
+                const Smile::i32 Live = ByCooked.Find(Cooked);
+                if (Live >= 0) ToRemove.push_back(Scene.Renderables()[(size_t)Live].Id);
             }
             // Coleta os Id ANTES de remover qualquer um: a remocao invalida os indices, mas nao
-            // as identidades.
-            for (Smile::u64 Id : ToRemove)
-                if (Access->RemoveRenderable(Id)) ++Removed;
+            // as identidades. Em lote: uma compactacao da lista e um re-setup, nao um por objeto.
+            Removed += static_cast<int>(Access->RemoveRenderables(ToRemove));
         }
 
         // Os overrides (passo 1) escrevem Visible e Transform DIRETO no FRenderable, sem passar
@@ -217,6 +286,8 @@ namespace SmileEditor {
         // Incondicional: isto roda uma vez por carga de cena, e o preco de um rebuild leve de
         // TLAS a mais nao paga o risco de a condicao esquecer um caso.
         Scene.BumpTransformsVersion();
+        // World e caixas em dia ja na volta daqui, nao so no proximo frame.
+        Scene.UpdateWorldTransforms();
         // Objeto movido ou oculto muda o que o mapa estatico de sombra contem — mesma razao pela
         // qual o olho do Scene Outliner bumpa os dois.
         Scene.BumpStaticCastersVersion();
@@ -234,89 +305,115 @@ namespace SmileEditor {
         emit DirtyChanged();
     }
 
-    bool SceneDocument::save() {
-        // Nenhum caminho de saida daqui pode ser mudo: isto e uma acao do USUARIO. A primeira
-        // versao retornava false em silencio, e quando o save nao aconteceu (a propriedade
-        // sceneDoc nao estava declarada no QML) o log nao tinha uma linha sequer para mostrar
-        // onde parou — o unico sinal era a ausencia do "Mapa salvo".
-        if (!Renderer) {
-            Smile::LogError("Mapa: sem renderer; nada salvo");
-            return false;
-        }
-        if (MapPath.isEmpty()) {
-            Smile::LogError("Mapa: nenhuma cena carregada; nada salvo");
-            return false;
-        }
-        auto Access = Renderer.Lock();
-        if (!Access) {
-            Smile::LogError("Mapa: renderer ocupado; nada salvo");
-            return false;
-        }
-        const auto& List = Access->GetScene().Renderables();
-
-        QJsonArray Overrides, Spawned;
+    void SceneDocument::Capture(const std::vector<Smile::FRenderable>& _List, Smile::FSceneMap& _Out) const {
         // Todo indice do cozido comeca "presente"; o que sobrar sem dono foi apagado.
-        QSet<int> Present;
+        std::vector<bool> Present((size_t)CookedCount, false);
 
-        for (const Smile::FRenderable& R : List) {
+        for (const Smile::FRenderable& R : _List) {
             if (R.CookedIndex < 0) continue; // proxy do terreno e afins: nao sao do asset
 
             const bool IsDynamic = R.Mobility == Smile::EMobility::Dynamic;
-
-            QJsonObject O;
-            O[QStringLiteral("pos")]   = Vec3ToJson(R.Transform.Position);
-            O[QStringLiteral("rot")]   = Vec3ToJson(R.Transform.RotationEuler);
-            O[QStringLiteral("scale")] = Vec3ToJson(R.Transform.Scale);
-            if (!R.Visible) O[QStringLiteral("visible")] = false;
             // Só o que diverge do default vai para o arquivo, como a visibilidade: estático é
-            // o default e a ausência da chave já o descreve.
-            if (IsDynamic) O[QStringLiteral("dynamic")] = true;
+            // o default e a ausência da flag já o descreve.
+            Smile::u32 Flags = 0;
+            if (!R.Visible) Flags |= Smile::kSMapHidden;
+            if (IsDynamic) Flags |= Smile::kSMapDynamic;
 
+            // Transform em MUNDO (o .smap nao sabe de hierarquia); o Apply converte de volta.
+            const Smile::FTransform W = R.WorldTransform();
             if (R.Spawned) {
-                O[QStringLiteral("from")] = R.CookedIndex;
-                O[QStringLiteral("name")] = QString::fromStdString(R.Name);
-                Spawned.append(O);
+                Smile::SSceneMapSpawn S{};
+                S.From  = R.CookedIndex;
+                S.Flags = Flags | Smile::kSMapTransform;
+                StoreVec3(W.Position, S.Position);
+                StoreVec3(W.RotationEuler, S.Rotation);
+                StoreVec3(W.Scale, S.Scale);
+                _Out.AddSpawn(S, R.Name);
                 continue;
             }
 
-            Present.insert(R.CookedIndex);
+            if ((size_t)R.CookedIndex < Present.size()) Present[(size_t)R.CookedIndex] = true;
             // So grava override se algo REALMENTE mudou em relacao ao que o asset trouxe.
             const bool HasBaseline = R.CookedIndex < Baseline.size();
             const bool MovedByUser =
                 !HasBaseline ||
-                !(NearlyEqual(R.Transform.Position, Baseline[R.CookedIndex].Position) &&
-                  NearlyEqual(R.Transform.RotationEuler, Baseline[R.CookedIndex].Rotation) &&
-                  NearlyEqual(R.Transform.Scale, Baseline[R.CookedIndex].Scale));
+                !(NearlyEqual(W.Position, Baseline[R.CookedIndex].Position) &&
+                  NearlyEqual(W.RotationEuler, Baseline[R.CookedIndex].Rotation) &&
+                  NearlyEqual(W.Scale, Baseline[R.CookedIndex].Scale));
             // Mobilidade entra na condicao junto com transform e visibilidade: um objeto
             // marcado como dinamico e um override legitimo mesmo parado e visivel, e sem isto
             // a marcacao seria perdida no save.
             if (!MovedByUser && R.Visible && !IsDynamic) continue;
-            if (!MovedByUser) {
-                O.remove(QStringLiteral("pos"));
-                O.remove(QStringLiteral("rot"));
-                O.remove(QStringLiteral("scale"));
+            Smile::SSceneMapOverride O{};
+            O.Cooked = R.CookedIndex;
+            O.Flags  = Flags;
+            if (MovedByUser) {
+                O.Flags |= Smile::kSMapTransform;
+                StoreVec3(W.Position, O.Position);
+                StoreVec3(W.RotationEuler, O.Rotation);
+                StoreVec3(W.Scale, O.Scale);
             }
-            O[QStringLiteral("cooked")] = R.CookedIndex;
-            Overrides.append(O);
+            _Out.Overrides.push_back(O);
         }
 
-        QJsonArray Deleted;
         for (int i = 0; i < CookedCount; ++i)
-            if (!Present.contains(i)) Deleted.append(i);
+            if (!Present[(size_t)i]) _Out.Deleted.push_back(i);
+    }
 
-        QJsonObject Root;
-        Root[QStringLiteral("version")]   = kMapVersion;
-        Root[QStringLiteral("overrides")] = Overrides;
-        Root[QStringLiteral("spawned")]   = Spawned;
-        Root[QStringLiteral("deleted")]   = Deleted;
+    bool SceneDocument::save() {
+        // Nenhum caminho de saida daqui pode ser mudo: isto e uma acao do USUARIO. A primeira
+        // versao retornava false em silencio, e quando o save nao aconteceu (a propriedade
+        // sceneDoc nao estava declarada no QML) o log nao tinha uma linha sequer para mostrar
+        // onde parou — o unico sinal era a ausencia do "Mapa salvo".
+        if (!Renderer) {
+            Smile::LogError("Mapa: sem renderer; nada salvo");
+            return false;
+        }
+        if (MapPath.isEmpty()) {
+            Smile::LogError("Mapa: nenhuma cena carregada; nada salvo");
+            return false;
+        }
+        auto Access = Renderer.Lock();
+        if (!Access) {
+            Smile::LogError("Mapa: renderer ocupado; nada salvo");
+            return false;
+        }
+        Smile::FSceneMap Map;
+        Capture(Access->GetScene().Renderables(), Map);
 
-        if (!WriteJsonSidecar(MapPath, Root, "Mapa")) return false;
+        const std::vector<Smile::u8> Bytes = Smile::EncodeSceneMap(Map.View());
+        const QByteArray Payload(reinterpret_cast<const char*>(Bytes.data()), (qsizetype)Bytes.size());
+        if (!WriteSidecarBytes(MapPath, Payload, "Mapa")) return false;
 
-        Smile::LogInfo("Mapa salvo: " + std::to_string(Overrides.size()) + " overrides, " +
-                       std::to_string(Spawned.size()) + " criados, " +
-                       std::to_string(Deleted.size()) + " apagados -> " +
+        Smile::LogInfo("Mapa salvo: " + std::to_string(Map.Overrides.size()) + " overrides, " +
+                       std::to_string(Map.Spawned.size()) + " criados, " +
+                       std::to_string(Map.Deleted.size()) + " apagados -> " +
                        QFileInfo(MapPath).fileName().toStdString());
         if (IsDirty) { IsDirty = false; emit DirtyChanged(); }
         return true;
     }
+
+    bool SceneDocument::exportJson() {
+        if (!Renderer || MapPath.isEmpty()) {
+            Smile::LogError("Mapa: nenhuma cena carregada; nada exportado");
+            return false;
+        }
+        Smile::FSceneMap Map;
+        {
+            auto Access = Renderer.Lock();
+            if (!Access) {
+                Smile::LogError("Mapa: renderer ocupado; nada exportado");
+                return false;
+            }
+            Capture(Access->GetScene().Renderables(), Map);
+        }
+        // Fora do lock: serializar texto e escrever em disco nao tocam a cena.
+        const std::string Json = Smile::SceneMapToJson(Map.View());
+        const QString JsonPath = MapPath + ".json";
+        if (!WriteSidecarBytes(JsonPath, QByteArray(Json.data(), (qsizetype)Json.size()), "Mapa (JSON)"))
+            return false;
+        Smile::LogInfo("Mapa exportado: " + std::to_string(Map.Overrides.size()) + " overrides -> " +
+                       QFileInfo(JsonPath).fileName().toStdString());
+        return true;
+    }
 }
@@ -478,6 +478,7 @@ namespace SmileEditor {
         // Nos DOIS sentidos: virar dinamico tira o objeto do mapa estatico, virar estatico o
         // coloca la. Qualquer um dos dois muda o conteudo cacheado.
         Renderer->GetScene().BumpStaticCastersVersion();
+        Renderer->GetScene().MarkHotDirty(static_cast<Smile::u32>(Sel)); // bit de mobilidade do cache SoA
         MarkDirty();
         emit SelectionChanged();
     }
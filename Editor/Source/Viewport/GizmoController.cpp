@@ -102,8 +102,9 @@ namespace SmileEditor {
         if (SpaceFor(IsLight) == ESpace::World || Idx < 0) return;
         const auto& List = R.GetScene().Renderables();
         if (Idx >= static_cast<int>(List.size())) return;
+        // Rotacao de MUNDO: o Transform de um filho e relativo ao pai.
         const Mat44 Rot = Mat44::RotationEulerXYZ(
-            List[static_cast<size_t>(Idx)].Transform.RotationEuler);
+            List[static_cast<size_t>(Idx)].WorldTransform().RotationEuler);
         for (int i = 0; i < 3; ++i) Out[i] = Rot.GetRow3(i).NormalizedSafe(Out[i]);
     }
 
@@ -379,8 +380,10 @@ namespace SmileEditor {
         auto& List = R.GetScene().Renderables();
         if (Idx < 0 || Idx >= static_cast<int>(List.size())) return;
         Smile::FRenderable& Rn = List[static_cast<size_t>(Idx)];
-        Rn.RefreshWorldBounds();
-        R.GetScene().BumpTransformsVersion();
+        // O SetWorldTransform ja marcou por indice, e nao BumpTransformsVersion: roda a cada
+        // movimento do mouse, e a cena refaz so este objeto e os descendentes. Na hora, e nao no
+        // proximo frame, porque a caixa nova e lida logo abaixo.
+        R.GetScene().UpdateWorldTransforms();
         // Invalida os volumes anterior e atual para remover iluminação residual.
         R.NotifyGIRegionChanged(OldMin, OldMax, Smile::EGIRegionChange::Geometry);
         R.NotifyGIRegionChanged(Rn.AABBMin, Rn.AABBMax, Smile::EGIRegionChange::Geometry);
@@ -416,10 +419,12 @@ namespace SmileEditor {
             DragStartPos     = L.Position;
             DragStartSpotDir = L.Direction;
         } else {
-            const Smile::FRenderable& Rn = R.GetScene().Renderables()[static_cast<size_t>(Idx)];
-            DragStartPos    = Rn.Transform.Position;
-            DragStartEuler  = Rn.Transform.RotationEuler;
-            DragStartScale  = Rn.Transform.Scale;
+            // O gesto trabalha em MUNDO; o SetWorldTransform converte para o local do pai.
+            const Smile::FTransform W =
+                R.GetScene().Renderables()[static_cast<size_t>(Idx)].WorldTransform();
+            DragStartPos    = W.Position;
+            DragStartEuler  = W.RotationEuler;
+            DragStartScale  = W.Scale;
         }
 
         if (Mode == EMode::Rotate) {
@@ -515,9 +520,10 @@ namespace SmileEditor {
 
         auto& List = R.GetScene().Renderables();
         if (DragIdx >= static_cast<int>(List.size())) return;
-        Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
+        const Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
         const Vec3 OldMin = Rn.AABBMin, OldMax = Rn.AABBMax;
-        Rn.Transform.Position = NewPos;
+        R.GetScene().SetWorldTransform(static_cast<u32>(DragIdx),
+                                       Smile::FTransform{ NewPos, DragStartEuler, DragStartScale });
         CommitRenderableEdit(R, DragIdx, OldMin, OldMax);
     }
 
@@ -556,13 +562,14 @@ namespace SmileEditor {
 
         auto& List = R.GetScene().Renderables();
         if (DragIdx >= static_cast<int>(List.size())) return;
-        Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
+        const Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
         const Vec3 OldMin = Rn.AABBMin, OldMax = Rn.AABBMax;
         // Recalcula do estado inicial para evitar deriva e manter o pivô fixo.
-        Rn.Transform.RotationEuler =
-            (Mat44::RotationEulerXYZ(DragStartEuler) * Delta).ToEulerXYZ();
-        Rn.Transform.Position = Delta.TransformVectorRow(DragStartPos - DragStartPivot)
-                              + DragStartPivot;
+        Smile::FTransform W;
+        W.RotationEuler = (Mat44::RotationEulerXYZ(DragStartEuler) * Delta).ToEulerXYZ();
+        W.Position      = Delta.TransformVectorRow(DragStartPos - DragStartPivot) + DragStartPivot;
+        W.Scale         = DragStartScale;
+        R.GetScene().SetWorldTransform(static_cast<u32>(DragIdx), W);
         CommitRenderableEdit(R, DragIdx, OldMin, OldMax);
     }
 
@@ -572,7 +579,7 @@ namespace SmileEditor {
         if (!R.ScreenToRay(X, Y, O, Dir)) return;
         auto& List = R.GetScene().Renderables();
         if (DragIdx >= static_cast<int>(List.size())) return;
-        Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
+        const Smile::FRenderable& Rn = List[static_cast<size_t>(DragIdx)];
 
         // Um comprimento de handle corresponde a duplicar a escala, independente da câmera.
         const float T   = AxisParam(O, Dir, DragAxisWorld, DragStartPivot);
@@ -591,12 +598,13 @@ namespace SmileEditor {
         Comp(NewScale, i) = Target;
 
         // Compensa a translação para manter o pivô visual imóvel.
-        const Mat44 Rot = Mat44::RotationEulerXYZ(Rn.Transform.RotationEuler);
+        const Mat44 Rot = Mat44::RotationEulerXYZ(DragStartEuler);
         Vec3 DLocal = Rot.TransformVectorRowTransposed(DragStartPivot - DragStartPos);
         Comp(DLocal, i) *= Eff;
 
-        Rn.Transform.Scale    = NewScale;
-        Rn.Transform.Position = DragStartPivot - Rot.TransformVectorRow(DLocal);
+        R.GetScene().SetWorldTransform(
+            static_cast<u32>(DragIdx),
+            Smile::FTransform{ DragStartPivot - Rot.TransformVectorRow(DLocal), DragStartEuler, NewScale });
         CommitRenderableEdit(R, DragIdx, OldMin, OldMax);
     }
 
@@ -607,14 +615,15 @@ namespace SmileEditor {
             const Smile::FRenderable* Rn = R.GetScene().FindRenderable(R.GetDraggingRenderable());
             if (Rn && Rn->Mobility == Smile::EMobility::Static)
                 R.GetScene().BumpStaticCastersVersion();
+            const Smile::FTransform W = Rn ? Rn->WorldTransform() : Smile::FTransform{};
             // Clique sem deslocamento não deve sujar a camada autorada.
             auto Differs = [](const Vec3& A, const Vec3& B) {
                 return std::fabs(A.X-B.X) > 1e-6f || std::fabs(A.Y-B.Y) > 1e-6f
                     || std::fabs(A.Z-B.Z) > 1e-6f;
             };
-            Edited = Rn && (Differs(Rn->Transform.Position,      DragStartPos)
-                         || Differs(Rn->Transform.RotationEuler, DragStartEuler)
-                         || Differs(Rn->Transform.Scale,         DragStartScale));
+            Edited = Rn && (Differs(W.Position,      DragStartPos)
+                         || Differs(W.RotationEuler, DragStartEuler)
+                         || Differs(W.Scale,         DragStartScale));
         }
         R.SetDraggingRenderable(0);
 
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Smile {
+    // Pool fixo de workers para lacos de dados do frame (listas de draw, casters).
+    //
+    // Nao e um scheduler de tarefas: a unica operacao e o ParallelFor, que divide [0, Count) em
+    // faixas FIXAS de `Grain` itens (o chunk c cobre [c*Grain, min(Count, (c+1)*Grain))) e as
+    // distribui por quem estiver livre — os workers e a propria thread que chamou. A divisao nao
+    // depende de quantas threads existem nem de quem pegou cada faixa, entao um laco que escreve
+    // uma saida por chunk e junta as saidas na ordem dos chunks chega no MESMO resultado do laco
+    // serial. E isso que mantem a captura deterministica com o paralelismo ligado.
+    //
+    // Chamado de dentro de um job (ou num pool sem workers) roda inline, na mesma divisao. Um
+    // ParallelFor por vez: chamadas de threads diferentes se enfileiram. `Fn` nao pode lancar.
+    class FJobSystem {
+    public:
+        // 0 = DefaultWorkerCount().
+        explicit FJobSystem(u32 WorkerCount = 0);
+        ~FJobSystem();
+        FJobSystem(const FJobSystem&)            = delete;
+        FJobSystem& operator=(const FJobSystem&) = delete;
+
+        // hardware_concurrency - 1 (a thread que chama tambem trabalha), no maximo 15.
+        static u32 DefaultWorkerCount();
+        static u32 ChunkCount(u32 Count, u32 Grain) { return (Count + Grain - 1) / std::max(Grain, 1u); }
+
+        // Workers + a thread que chama.
+        u32 ThreadCount() const { return static_cast<u32>(Workers.size()) + 1u; }
+
+        // Fn(u32 Chunk, u32 Begin, u32 End). Volta quando todos os chunks terminaram.
+        template <typename F>
+        void ParallelFor(u32 Count, u32 Grain, F&& Fn) {
+            Grain = std::max(Grain, 1u);
+            const u32 Chunks = ChunkCount(Count, Grain);
+            if (Chunks == 0) return;
+            if (Chunks == 1 || Workers.empty() || InsideJob) {
+                for (u32 c = 0; c < Chunks; ++c) Fn(c, c * Grain, std::min(Count, (c + 1) * Grain));
+                return;
+            }
+            using FFn = std::remove_reference_t<F>;
+            Dispatch(Count, Grain, Chunks,
+                     [](void* Ctx, u32 Chunk, u32 Begin, u32 End) { (*static_cast<FFn*>(Ctx))(Chunk, Begin, End); },
+                     const_cast<void*>(static_cast<const void*>(&Fn)));
+        }
+
+    private:
+        using FInvoke = void (*)(void* Ctx, u32 Chunk, u32 Begin, u32 End);
+
+        void Dispatch(u32 Count, u32 Grain, u32 Chunks, FInvoke Invoke, void* Ctx);
+        void RunChunks();
+        void WorkerMain();
+
+        static thread_local bool InsideJob;
+
+        std::vector<std::thread> Workers;
+        std::mutex               DispatchMutex; // um ParallelFor por vez
+        std::mutex               Mutex;
+        std::condition_variable  WakeCv;
+        std::condition_variable  IdleCv;
+        u64                      Generation = 0;
+        u32                      Active     = 0; // workers dentro do RunChunks
+        bool                     Quit       = false;
+
+        // Job corrente. So muda com Active == 0 (sob Mutex); os workers leem depois de entrar.
+        FInvoke          Invoke = nullptr;
+        void*            Ctx    = nullptr;
+        u32              Count  = 0;
+        u32              Grain  = 1;
+        u32              Chunks = 0;
+        std::atomic<u32> NextChunk{ 0 };
+    };
+
+    // ParallelFor com o pool opcional: nullptr roda serial, na MESMA divisao em chunks. E o que o
+    // renderer chama — desligar o paralelismo vira um ponteiro nulo, nao um segundo laco.
+    template <typename F>
+    void ForEachChunk(FJobSystem* Jobs, u32 Count, u32 Grain, F&& Fn) {
+        if (Jobs) {
+            Jobs->ParallelFor(Count, Grain, Fn);
+            return;
+        }
+        Grain = std::max(Grain, 1u);
+        const u32 Chunks = FJobSystem::ChunkCount(Count, Grain);
+        for (u32 c = 0; c < Chunks; ++c) Fn(c, c * Grain, std::min(Count, (c + 1) * Grain));
+    }
+
+    // Filtra/transforma [0, Count) em paralelo preservando a ordem: Fn(Begin, End, ChunkOut)
+    // empurra os itens da faixa em ChunkOut, e `Out` e substituido pela concatenacao dos chunks
+    // em ordem — a mesma lista do laco serial. `Scratch` guarda os vetores por chunk entre frames.
+    template <typename T, typename F>
+    void ParallelGather(FJobSystem* Jobs, u32 Count, u32 Grain, std::vector<std::vector<T>>& Scratch,
+                        std::vector<T>& Out, F&& Fn) {
+        const u32 Chunks = FJobSystem::ChunkCount(Count, std::max(Grain, 1u));
+        if (Scratch.size() < Chunks) Scratch.resize(Chunks);
+        ForEachChunk(Jobs, Count, Grain, [&](u32 _Chunk, u32 _Begin, u32 _End) {
+            Scratch[_Chunk].clear();
+            Fn(_Begin, _End, Scratch[_Chunk]);
+        });
+        size_t Total = 0;
+        for (u32 c = 0; c < Chunks; ++c) Total += Scratch[c].size();
+        Out.clear();
+        Out.reserve(Total);
+        for (u32 c = 0; c < Chunks; ++c) Out.insert(Out.end(), Scratch[c].begin(), Scratch[c].end());
+    }
+
+    // Ordena em paralelo: cada faixa de `Grain` e ordenada por uma thread e as faixas sao
+    // intercaladas duas a duas (std::merge) ate sobrar uma. `Less` TEM de ser uma ordem total —
+    // nenhum empate entre itens distintos —, e entao so existe uma ordem possivel: a saida e
+    // identica a do std::sort serial, com qualquer numero de threads. Comparador com empate
+    // deixaria a ordem dos empatados a cargo de quem terminou primeiro.
+    template <typename T, typename FLess>
+    void ParallelSort(FJobSystem* Jobs, std::vector<T>& Items, std::vector<T>& Scratch, FLess Less,
+                      u32 Grain = 4096) {
+        const u32 N = static_cast<u32>(Items.size());
+        Grain = std::max(Grain, 1u);
+        if (!Jobs || N <= Grain) {
+            std::sort(Items.begin(), Items.end(), Less);
+            return;
+        }
+        Jobs->ParallelFor(N, Grain, [&](u32, u32 _Begin, u32 _End) {
+            std::sort(Items.begin() + _Begin, Items.begin() + _End, Less);
+        });
+        Scratch.resize(N);
+        for (u32 Width = Grain, Pair = 0; Width < N; Width = Pair) {
+            Pair = static_cast<u32>(std::min<u64>(static_cast<u64>(Width) * 2, N));
+            Jobs->ParallelFor(FJobSystem::ChunkCount(N, Pair), 1, [&](u32, u32 _P, u32) {
+                const u32 Begin = _P * Pair;
+                const u32 Mid   = std::min(N, Begin + Width);
+                const u32 End   = std::min(N, Begin + Pair);
+                std::merge(Items.begin() + Begin, Items.begin() + Mid, Items.begin() + Mid, Items.begin() + End,
+                           Scratch.begin() + Begin, Less);
+            });
+            Items.swap(Scratch);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Smile {
+    // Conteudo somente-leitura de um arquivo inteiro.
+    //
+    // Duas origens com a MESMA interface: `Map` projeta o arquivo no espaco de enderecos (as
+    // paginas sao do cache do sistema e podem ser descartadas sob pressao, sem contar como
+    // memoria privada do processo) e `Read` carrega tudo num buffer proprio. Quem consome so ve
+    // `Bytes()`, entao views sobre o conteudo valem igual nos dois casos — e valem ENQUANTO este
+    // objeto viver. Quem guarda um span tem de guardar tambem o FMappedFile.
+    class FMappedFile {
+    public:
+        // nullptr se o arquivo nao existe, esta vazio ou o mapeamento falhou.
+        static std::unique_ptr<FMappedFile> Map(const std::filesystem::path& Path);
+        static std::unique_ptr<FMappedFile> Read(const std::filesystem::path& Path);
+
+        ~FMappedFile();
+        FMappedFile(const FMappedFile&)            = delete;
+        FMappedFile& operator=(const FMappedFile&) = delete;
+
+        std::span<const u8> Bytes() const { return { Data, Size }; }
+        bool                IsMapped() const { return View != nullptr; }
+
+    private:
+        FMappedFile() = default;
+
+        const u8*       Data = nullptr;
+        size_t          Size = 0;
+        // Mapeado: HANDLEs do arquivo/mapping e o endereco do MapViewOfFile. Lido: o buffer.
+        void*           File    = nullptr;
+        void*           Mapping = nullptr;
+        const void*     View    = nullptr;
+        std::vector<u8> Owned;
+    };
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Smile {
+    // Pool de tarefas do LOAD (decode de textura, preparo e validacao de mesh) — o par do
+    // FJobSystem, que e do frame. La o trabalho e um laco de dados em faixas iguais; aqui e um lote
+    // de tarefas de custo muito desigual (um PNG 8K contra um DDS de 64 KB), e o tempo de parede e
+    // decidido por nao deixar a maior para o fim.
+    //
+    // Cada Run ordena o lote pelo custo estimado (maior primeiro, empate na ordem de entrada) e
+    // distribui em rodizio pelas filas de cada thread — quem chamou inclusive —, entao toda fila
+    // comeca pela maior tarefa que lhe coube. A thread tira da frente da propria fila; com ela
+    // vazia, rouba a frente da fila alheia cuja frente e a mais cara. O caminho comum so toca a
+    // fila propria, e o roubo mantem a aproximacao de LPT (a cauda do lote e de tarefas pequenas,
+    // que qualquer thread livre pega). O custo e unidade livre: so a ordem importa.
+    //
+    // Um Run por vez: chamadas de threads diferentes se enfileiram. Run chamado de dentro de uma
+    // tarefa (ou num pool sem workers) roda inline, na ordem do custo. `Fn` nao pode lancar.
+    enum class ELoadTaskKind : u8 { Texture, Mesh, Other };
+
+    const char* LoadTaskKindName(ELoadTaskKind Kind);
+
+    struct FLoadTask {
+        ELoadTaskKind         Kind = ELoadTaskKind::Other;
+        std::string           Name; // caminho da textura, "mesh 12"... so para o relatorio
+        u64                   Cost = 0;
+        std::function<void()> Fn;
+    };
+
+    struct FLoadTaskTiming {
+        ELoadTaskKind Kind = ELoadTaskKind::Other;
+        std::string   Name;
+        u64           Cost    = 0;
+        f64           StartMs = 0.0; // desde o inicio do Run
+        f64           Ms      = 0.0;
+        u32           Thread  = 0;   // 0 = quem chamou o Run, 1.. = workers
+        u32           Order   = 0;   // posicao em que comecou no lote
+    };
+
+    class FTaskPool {
+    public:
+        // 0 = DefaultWorkerCount().
+        explicit FTaskPool(u32 WorkerCount = 0);
+        ~FTaskPool();
+        FTaskPool(const FTaskPool&)            = delete;
+        FTaskPool& operator=(const FTaskPool&) = delete;
+
+        // hardware_concurrency - 2, no minimo 1: quem chama o Run tambem trabalha e um core fica
+        // para o event loop/render do Editor. Sem teto — o load escala com a maquina.
+        static u32 DefaultWorkerCount();
+        // Pool do processo para o trabalho de load, criado no primeiro uso.
+        static FTaskPool& Shared();
+
+        // Workers + a thread que chama.
+        u32 ThreadCount() const { return static_cast<u32>(Workers.size()) + 1u; }
+
+        // Roda o lote inteiro e volta com o tempo de cada tarefa, na ordem de `Tasks`.
+        std::vector<FLoadTaskTiming> Run(std::span<FLoadTask> Tasks);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct FQueue {
+            std::mutex      Mutex;
+            std::deque<u32> Items; // indices em Tasks, do mais caro para o mais barato
+        };
+
+        bool Next(u32 Self, u32& Task);
+        void Execute(u32 Task, u32 Self);
+        void Drain(u32 Self);
+        void WorkerMain(u32 Self);
+
+        static thread_local bool InsideTask;
+
+        std::vector<std::thread>  Workers;
+        std::unique_ptr<FQueue[]> Queues; // uma por thread; [0] e de quem chama
+        std::mutex                RunMutex; // um Run por vez
+        std::mutex                Mutex;
+        std::condition_variable   WakeCv;
+        std::condition_variable   IdleCv;
+        u64                       Generation = 0;
+        u32                       Active     = 0; // workers dentro do Drain
+        bool                      Quit       = false;
+
+        // Lote corrente. So muda com Active == 0 (sob Mutex).
+        FLoadTask*       Tasks   = nullptr;
+        FLoadTaskTiming* Timings = nullptr;
+        Clock::time_point Start;
+        std::atomic<u32> Started{ 0 };
+    };
+}
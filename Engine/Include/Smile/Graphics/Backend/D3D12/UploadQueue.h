@@ -53,6 +53,10 @@ namespace Smile {
 
         void WaitIdle();
 
+        // Ultimo batch que a GPU terminou de copiar: quem guardou o valor do Submit sabe, sem
+        // esperar, se ja pode consumir o recurso (streaming de texturas).
+        u64  CompletedFence() const { return Fence ? Fence->GetCompletedValue() : 0; }
+
         // Sub-aloca staging do ring em vez de criar um committed UPLOAD por upload.
         //
         // Existe porque o caminho antigo criava UM recurso committed POR TEXTURA: numa cena
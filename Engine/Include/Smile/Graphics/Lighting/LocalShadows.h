@@ -3,6 +3,7 @@
 #include "Smile/Core/Types.h"
 #include "Smile/Math/Math.h"
 #include "Smile/Graphics/Backend/D3D12/DescriptorHeap.h"
+#include "Smile/Scene/FrustumCull.h"
 #include <d3d12.h>
 #include <wrl/client.h>
 #include <functional>
@@ -260,9 +261,16 @@ namespace Smile {
 
         TShadowSlotCache<kMaxShadows>               SpotSlots;
         TShadowSlotCache<kMaxCubeShadows>           CubeSlots;
-        // Broad phase por luz: indices em Items dentro da esfera de influencia. Membro (e nao
-        // local) so pra nao realocar por slice — as 6 faces do point reusam a MESMA lista.
+        // Scratch do culling em lote (FrustumCull.h), membro so pra nao realocar por frame.
+        // CasterBounds: todos os casters do passe. SpotCasters[j]: o frustum do job j, todos os
+        // spots numa passada. CullScratch: a esfera do point atual (indices em Items), e
+        // NearBounds as caixas dela — as 6 faces cullam juntas em cima da lista curta, e
+        // FaceCasters[f] sai em indices de Items.
+        FCullBounds                                 CasterBounds;
+        FCullBounds                                 NearBounds;
+        std::vector<u32>                            SpotCasters[kMaxShadows];
         std::vector<u32>                            CullScratch;
+        std::vector<u32>                            FaceCasters[6];
 
         f32  DepthBias   = 0.02f; // bias constante em METROS (o shader converte pra NDC pelo
                                   // caminho linear; + termo relativo por distancia no shader).
@@ -4,6 +4,7 @@
 #include "Smile/Math/Math.h"
 #include "Smile/Graphics/Backend/D3D12/DescriptorHeap.h"
 #include "Smile/Graphics/Renderer/RenderPass.h"
+#include "Smile/Scene/FrustumCull.h"
 #include <d3d12.h>
 #include <functional>
 #include <wrl/client.h>
@@ -177,10 +178,12 @@ namespace Smile {
         void InvalidateCache() { for (u32 c = 0; c < kNumCascades; ++c) CacheValid[c] = false; }
 
         // Os dois filtros do passe de profundidade, no lugar unico onde as tres fases (mapa
-        // estatico, copia, dinamicos) precisam concordar. Ordem: tamanho e depois planos —
-        // e a ordem em que os contadores atribuem o corte.
-        bool CasterVisible(const FShadowDrawItem& It, u32 Cascade, f32 MinExtent,
-                           FCascadeStats* St) const;
+        // estatico, copia, dinamicos) precisam concordar. Ordem: planos e depois tamanho — e a
+        // ordem em que os contadores atribuem o corte. Os planos das 4 cascatas vao juntos, numa
+        // passada do kernel em lote sobre a lista inteira (CullCasters, uma vez por passe); o
+        // tamanho e um teste escalar so em quem sobrou.
+        void CullCasters(const FShadowDrawItem* Items, size_t Count);
+        bool CasterBigEnough(const FShadowDrawItem& It, f32 MinExtent) const;
         // Desenha [Begin, End) da lista na cascata; devolve quantos passaram. O DSV, o
         // viewport e a root signature ja tem de estar ligados pelo chamador.
         u32  DrawCasters(ID3D12GraphicsCommandList* CommandList, FTextureSRVHeap& SRVHeap,
@@ -226,6 +229,10 @@ namespace Smile {
         // near, por causa do pancaking). Retidos entre updates junto com a matriz, para que
         // cascata congelada pelo cache continue cullando contra o volume que gerou o mapa.
         Vec4                                        CullPlanes[kNumCascades][5]{};
+        // Saida do CullCasters: caixas dos casters em SoA e, por cascata, os indices (crescentes,
+        // na lista do RecordDepthPass) que nao estao fora da fatia.
+        FCullBounds                                 CasterBounds;
+        std::vector<u32>                            CascadeCasters[kNumCascades];
 
         u32  FrameSlot = 0;
         f32  ShadowMaxDistance   = 800.0f;
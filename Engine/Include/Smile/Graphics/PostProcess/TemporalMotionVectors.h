@@ -98,7 +98,6 @@ namespace Smile {
         Microsoft::WRL::ComPtr<ID3D12Resource> TransformBuffer;
         u8* MappedTransforms = nullptr;
         u32 TransformSRVSlot[kFrames] = { kInvalidSlot, kInvalidSlot };
-        std::vector<Mat44> PreviousModels;
         u32 InstanceCount_ = 0;
 
         Microsoft::WRL::ComPtr<ID3D12Resource> Surface[kFrames];
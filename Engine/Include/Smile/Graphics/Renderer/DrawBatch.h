@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <span>
+#include <vector>
+
+// Lotes instanciados sobre uma lista de draw ja ordenada.
+//
+// Desde o cooked v7 muitos renderaveis dividem o MESMO FGpuMesh (Emerald Square: 2479 partes sobre
+// 281 geometrias), e cada um ainda virava um draw com o seu root CBV. Aqui itens vizinhos com o
+// mesmo grupo (malha, material, PSO) e slots CONSECUTIVOS no ObjectCB viram um DrawIndexedInstanced
+// so: o root CBV aponta para o primeiro slot e o VS le o ObjectConstants da instancia pelo
+// SV_InstanceID (Triangle.vs.hlsl). O ObjectCB ja e o buffer por instancia — nada e copiado.
+//
+// Quem garante slots consecutivos e a ordem: o BuildDrawLists da os slots de Ctx.All agrupados por
+// material e malha, e o G-buffer ordena pelo slot dentro do grupo (DrawSortKey::Batch). Um buraco
+// (item cullado no meio do grupo) so corta o lote em dois.
+namespace Smile {
+    // 64 KiB de cbuffer / 256 B de ObjectConstants. O mesmo numero no Triangle.vs.hlsl.
+    constexpr u32 kMaxDrawInstances = 256;
+
+    // Itens [First, First + Count) da lista de entrada, no slot do primeiro em diante.
+    struct FDrawBatch {
+        u32 First = 0;
+        u32 Count = 0;
+    };
+
+    // `Out` e substituido pelos lotes de `Items`, na ordem da lista. `SameGroup(a, b)` diz se dois
+    // itens podem dividir um draw (mesma malha, material e PSO); `Slot(item)` e o indice no
+    // ObjectCB. Lote nenhum passa de `MaxInstances`.
+    template <typename T, typename FSameGroup, typename FSlot>
+    void BuildDrawBatches(std::span<const T> Items, std::vector<FDrawBatch>& Out, FSameGroup&& SameGroup,
+                          FSlot&& Slot, u32 MaxInstances = kMaxDrawInstances) {
+        Out.clear();
+        const u32 N = static_cast<u32>(Items.size());
+        if (MaxInstances == 0) MaxInstances = 1;
+        for (u32 i = 0; i < N;) {
+            const u32 Base = Slot(Items[i]);
+            u32 Count = 1;
+            while (i + Count < N && Count < MaxInstances &&
+                   Slot(Items[i + Count]) == Base + Count &&
+                   SameGroup(Items[i], Items[i + Count]))
+                ++Count;
+            Out.push_back({ i, Count });
+            i += Count;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <bit>
+#include <vector>
+
+// Ordenacao das listas de draw por chave de 64 bits + radix sort.
+//
+// As quatro ordens do frame — visiveis front-to-back, casters do CSM, casters locais e o G-buffer
+// agrupado por estado — eram std::sort com lambdas que comparavam PONTEIROS de material e malha.
+// Custo O(n log n) com comparador de varios ramos, e a ordem de agrupamento mudava de uma execucao
+// para outra conforme o alocador. Aqui cada item vira um par (chave, indice) e o radix LSD ordena
+// em O(n), estavel: itens de mesma chave ficam na ordem da lista de entrada, que ja e
+// deterministica (ordem de cena, ver JobSystem.h). Material e malha entram pelo SortId — a ordem
+// de carga, a mesma em toda execucao.
+namespace Smile {
+    // Layout da chave, do bit mais alto para o mais baixo. Balde (4) decide antes de tudo: a
+    // metade cacheada/dinamica do CSM, alpha-test, two-sided. Profundidade so no fim, para quem
+    // quer front-to-back dentro de um mesmo estado.
+    //
+    //   Estado:       [63..60] balde | [59..40] material | [39..20] malha | [19..0] profundidade
+    //   Lote:         [63..60] balde | [59..40] material | [39..20] malha | [19..0] item
+    //   Profundidade: [63..60] balde | [59..28] distancia (f32 inteira)   | [27..0] zero
+    //
+    // A chave de profundidade carrega os 32 bits da distancia: float >= 0 ordena igual ao seu
+    // padrao de bits, entao ela ordena EXATAMENTE como a comparacao de f32 — sem quantizar.
+    namespace DrawSortKey {
+        constexpr u32 kBucketBits   = 4;
+        constexpr u32 kMaterialBits = 20;
+        constexpr u32 kMeshBits     = 20;
+        constexpr u32 kDepthBits    = 20;
+
+        // Padrao de bits de um f32 >= 0, que cresce com o valor. Negativo vira 0; NaN vai pro fim.
+        inline u32 DepthBits(f32 Depth) {
+            if (Depth != Depth) return 0x7FFFFFFFu;
+            return Depth > 0.0f ? std::bit_cast<u32>(Depth) : 0u;
+        }
+
+        // Ids acima do campo saturam: continuam agrupados, so deixam de se separar entre si.
+        inline u64 State(u32 Bucket, u32 Material, u32 Mesh, f32 Depth = 0.0f) {
+            constexpr u32 MatMax  = (1u << kMaterialBits) - 1u;
+            constexpr u32 MeshMax = (1u << kMeshBits) - 1u;
+            return (static_cast<u64>(Bucket & 0xFu) << 60) |
+                   (static_cast<u64>(Material < MatMax ? Material : MatMax) << 40) |
+                   (static_cast<u64>(Mesh < MeshMax ? Mesh : MeshMax) << 20) |
+                   static_cast<u64>(DepthBits(Depth) >> (31 - kDepthBits));
+        }
+
+        // Estado com o indice do item no lugar da profundidade: dentro de um grupo os itens saem
+        // na ordem de slot, o que junta instancias em lote (DrawBatch.h). Indice alem do campo
+        // satura: o item continua no grupo, so pode nao entrar no lote.
+        inline u64 Batch(u32 Bucket, u32 Material, u32 Mesh, u32 Item) {
+            constexpr u32 ItemMax = (1u << kDepthBits) - 1u;
+            return (State(Bucket, Material, Mesh) & ~static_cast<u64>(ItemMax)) |
+                   static_cast<u64>(Item < ItemMax ? Item : ItemMax);
+        }
+
+        inline u64 Depth(u32 Bucket, f32 Depth) {
+            return (static_cast<u64>(Bucket & 0xFu) << 60) | (static_cast<u64>(DepthBits(Depth)) << 28);
+        }
+    }
+
+    struct FSortPair {
+        u64 Key   = 0;
+        u32 Index = 0;
+    };
+
+    // Radix LSD de 8 bits, estavel. Os 8 histogramas saem de uma passada; digito igual em todas as
+    // chaves nao gera passada (a chave de profundidade paga 4, nao 8). `Scratch` e so memoria.
+    void RadixSortPairs(std::vector<FSortPair>& Pairs, std::vector<FSortPair>& Scratch);
+
+    // Memoria das ordenacoes do frame. Membro do dono para nao realocar a cada frame.
+    struct FDrawSortScratch {
+        std::vector<FSortPair> Pairs;
+        std::vector<FSortPair> Temp;
+    };
+
+    // Reordena `Items` por Key(const T&) -> u64, estavel. `ItemScratch` recebe a lista ordenada e
+    // troca de lugar com `Items` (os dois ficam com capacidade para o proximo frame).
+    template <typename T, typename FKey>
+    void SortByKey(std::vector<T>& Items, std::vector<T>& ItemScratch, FDrawSortScratch& Scratch, FKey&& Key) {
+        const u32 N = static_cast<u32>(Items.size());
+        if (N < 2) return;
+        Scratch.Pairs.resize(N);
+        for (u32 i = 0; i < N; ++i) Scratch.Pairs[i] = { Key(Items[i]), i };
+        RadixSortPairs(Scratch.Pairs, Scratch.Temp);
+        ItemScratch.resize(N);
+        for (u32 i = 0; i < N; ++i) ItemScratch[i] = Items[Scratch.Pairs[i].Index];
+        Items.swap(ItemScratch);
+    }
+}
@@ -83,21 +83,9 @@ namespace Smile {
         // Mip bias global de textura no upscale (log2(render/display) - 1); 0 quando nativo.
         f32   MipBias = 0.0f;
 
-        // Planos nao normalizados: esquerda, direita, baixo, cima, perto e longe.
+        // Planos nao normalizados: esquerda, direita, baixo, cima, perto e longe. O teste de caixa
+        // contra eles e o FCullFrustum (Smile/Scene/FrustumCull.h), em lote.
         Vec4  FrustumPlanes[6]{};
-
-        // true quando a AABB esta INTEIRAMENTE fora de algum plano. Conservador na direcao certa:
-        // uma caixa que atravessa a fronteira conta como dentro.
-        bool AABBOutsideFrustum(const Vec3& Mn, const Vec3& Mx) const {
-            for (int i = 0; i < 6; ++i) {
-                const Vec4& p = FrustumPlanes[i];
-                const f32 px = (p.X >= 0.0f) ? Mx.X : Mn.X;
-                const f32 py = (p.Y >= 0.0f) ? Mx.Y : Mn.Y;
-                const f32 pz = (p.Z >= 0.0f) ? Mx.Z : Mn.Z;
-                if (p.X * px + p.Y * py + p.Z * pz + p.W < 0.0f) return true;
-            }
-            return false;
-        }
     };
 
     // Decisoes resolvidas antes da gravacao. Modos que dependem de trabalho do proprio frame
@@ -40,6 +40,7 @@ namespace Smile {
     struct FRadianceCacheStats;
     struct FRadianceCacheStatsMeta;
     struct FRadianceCacheSnapshot;
+    struct FResidencyStats;
 
     class FRenderSettings {
     public:
@@ -79,11 +80,27 @@ namespace Smile {
         bool GetFrustumCulling() const;
         void SetOcclusionCulling(bool Use);
         bool GetOcclusionCulling() const;
+        // Listas de draw/casters montadas nos workers. Mesma saida nos dois modos (so A/B de tempo).
+        void SetParallelDrawLists(bool Use);
+        bool GetParallelDrawLists() const;
+        // Listas de draw e ObjectCB reusados entre frames quando camera e cena nao mudaram.
+        // Mesma saida ligado ou desligado (so A/B de tempo).
+        void SetDrawListCache(bool Use);
+        bool GetDrawListCache() const;
         void SetDepthPrepass(bool Use);
         bool GetDepthPrepass() const;
         void SetUseAsyncCompute(bool V);
         bool GetUseAsyncCompute() const;
 
+        // === Streaming de texturas ======================================================
+        // DDS da cena sobem so com a cauda e as mips de cima vem sob demanda (TextureStreamer.h).
+        // Desligado, toda textura streamada pede a mip 0, ainda sob o budget.
+        void SetTextureStreaming(bool Use);
+        bool GetTextureStreaming() const;
+        void SetTextureStreamingBudgetMB(u32 MB);
+        u32  GetTextureStreamingBudgetMB() const;
+        const FResidencyStats& GetTextureStreamingStats() const;
+
         // === Iluminacao global ==========================================================
         void SetUseGI(bool V);
         bool GetUseGI() const;
@@ -2,6 +2,7 @@
 
 #include <Windows.h>
 #include <functional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -64,6 +65,11 @@
 #include "Smile/Graphics/Water/OceanFFT.h"
 #include "Smile/Graphics/Water/Water.h"
 #include "Smile/Graphics/Scene/Terrain.h"
+#include "Smile/Core/JobSystem.h"
+#include "Smile/Graphics/Renderer/DrawBatch.h"
+#include "Smile/Graphics/Renderer/DrawSort.h"
+#include "Smile/Graphics/Renderer/TextureStreamer.h"
+#include "Smile/Scene/FrustumCull.h"
 
 namespace Smile {
     struct CameraInput;
@@ -254,6 +260,8 @@ namespace Smile {
         // Telemetria de culling (os toggles moraram p/ o FRenderSettings).
         u32  GetOccludedCount() const    { return LastOccludedCount; }
         u32  GetVisibleCount() const     { return LastVisibleCount; }
+        // Draws do G-buffer depois do agrupamento em lotes instanciados (<= visiveis opacos).
+        u32  GetGBufferDrawCount() const { return LastGBufferDraws; }
         u32  GetDrawCount() const;
 
         // Telemetria do CSM por cascata (contagem + frequencia de atualizacao). Const, so
@@ -287,6 +295,7 @@ namespace Smile {
         void ClearSelection();
         // Alteram a cena e sincronizam os subsistemas indexados por renderable.
         bool RemoveRenderable(u64 Id);
+        u32  RemoveRenderables(std::span<const u64> Ids); // lote: uma compactacao, um re-setup
         u64  DuplicateRenderable(u64 Id);
 
         // Invalida apenas a regiao afetada do DDGI. Em mudancas espaciais, informe os bounds
@@ -541,6 +550,11 @@ namespace Smile {
         void PrepareIndirectLighting(FPassContext& Ctx);
         FLocalShadowJobs PackDirectLights(FPassContext& Ctx, FrameConstants* MappedCB);
         void       BuildDrawLists(FPassContext& Ctx);
+        // Devolve Ctx.All/Ctx.Visible ao cache do slot no fim do frame (BuildDrawLists os empresta).
+        void       ReclaimDrawLists(FPassContext& Ctx);
+        // Proximo BuildDrawLists de cada slot remonta tudo. Para o que o cache nao ve por versao:
+        // ObjectCB/HZB recriados, renderavel trocado no lugar, material editado ou trocado.
+        void       InvalidateDrawListCache();
         void       RecordShadows(FPassContext& Ctx, const FLocalShadowJobs& Jobs);
         void       RecordDepthPrepass(FPassContext& Ctx);
         void       RecordGBuffer(FPassContext& Ctx);
@@ -704,12 +718,84 @@ namespace Smile {
 
         std::vector<std::unique_ptr<FTexture>>  ImportedTextures;
         std::vector<std::unique_ptr<FMaterial>> ImportedMaterials;
+        // Mips de cima das DDS importadas, sob demanda (CommitCookedScene registra, RenderFrame
+        // pede pelos visiveis). Aponta para ImportedTextures: limpo antes de elas sairem.
+        FTextureStreamer                        TextureStreamer;
 
         bool UseFrustumCulling = true;
         bool UseDepthPrepass   = false;
         f32  RenderScale       = 1.0f; // SSAA: cena em swapchain*RenderScale; backbuffer nativo
         u32  LastVisibleCount  = 0;
 
+        // Listas do BuildDrawLists guardadas entre frames, UMA por frame em voo: o ObjectCB e os
+        // bounds do HZB sao por slot, e o FDrawItem::Slot ja carrega a base do slot. Com camera e
+        // cena paradas o frame reusa Ctx.All, Ctx.Visible e o ObjectCB escrito ha kFramesInFlight
+        // frames; objeto que andou reescreve so o proprio slot. Ver BuildDrawLists.
+        struct FDrawListSlotCache {
+            bool  Valid   = false;
+            bool  Lent    = false; // All/Visible estao no Ctx do frame (ReclaimDrawLists devolve)
+            // Chave das listas: o que muda quem vira draw ou o slot de cada um.
+            u64   StructureVersion = 0;
+            u32   SceneCount       = 0;
+            u32   MaxObjects       = 0;
+            bool  FrustumCulling   = false;
+            bool  OcclusionBounds  = false;
+            // Matrizes com que o ObjectCB deste slot foi escrito.
+            Mat44 ViewProj, ViewProjUnjittered, PrevViewProj;
+            // Indices de cena que mudaram desde a ultima escrita deste slot (com repeticao).
+            std::vector<u32> Pending;
+            bool             AllPending = false;
+
+            std::vector<FDrawItem>    All;
+            std::vector<FVisibleItem> Visible;
+            std::vector<u32>          ItemOf;     // indice de cena -> indice em All (kNoItem = nao e draw)
+            // Caixas de All em SoA para o frustum da camera (os sobreviventes ficam por chunk,
+            // em FDrawListChunk).
+            FCullBounds               CullBounds;
+
+            // Chave do Visible: frustum sem jitter, camera, selecao e o resultado do HZB.
+            bool             VisibleValid = false;
+            Mat44            CullViewProj;
+            Vec3             CullCamPos;
+            int              CullSelected = -1;
+            bool             CullOcclusion = false;
+            std::vector<u32> CullOcclusionVis;
+            u32              Occluded = 0;
+        };
+        static constexpr u32 kNoItem = 0xFFFFFFFFu;
+        bool                 UseDrawListCache = true;
+        FDrawListSlotCache   DrawListCache[FCommandQueue::kFramesInFlight];
+        u64                  DrawListHotVersion = 0; // ultima FScene::HotVersion repassada aos slots
+
+        // Montagem das listas (BuildDrawLists + casters) repartida em chunks fixos de cena
+        // (JobSystem.h). Desligado, os MESMOS chunks rodam em serie na thread de render: a saida
+        // e identica bit a bit nos dois modos, e o toggle so serve para A/B de tempo.
+        bool                        UseParallelDrawLists = true;
+        std::unique_ptr<FJobSystem> DrawListJobs; // criado no primeiro frame que o usa
+        FJobSystem*                 FrameJobs();
+        // Estado de um chunk da cena no BuildDrawLists. Membros para nao realocar a cada frame.
+        struct FDrawListChunk {
+            std::vector<u32> Accepted;     // indices de cena que viram draw
+            std::vector<u32> Survivors;    // indices em Ctx.All que passaram no frustum
+            u32              Occluded = 0;
+        };
+        std::vector<FDrawListChunk>                                DrawListChunks;
+        std::vector<std::vector<FVisibleItem>>                     VisibleChunks;
+        // Ordenacoes do frame por chave + radix (DrawSort.h); os *Scratch de item sao o destino
+        // da permutacao. Tudo na thread de render, em sequencia: um FDrawSortScratch basta.
+        FDrawSortScratch                                           DrawSortScratch;
+        std::vector<FVisibleItem>                                  VisibleSortScratch;
+        // Ordem de slot de Ctx.All (indices de cena agrupados por material/malha) e os lotes
+        // instanciados do G-buffer (DrawBatch.h).
+        std::vector<u32>                                           DrawOrder;
+        std::vector<u32>                                           DrawOrderScratch;
+        std::vector<FDrawBatch>                                    GBufferBatches;
+        u32                                                        LastGBufferDraws = 0;
+        std::vector<std::vector<FSunShadows::FShadowDrawItem>>     SunCasterChunks;
+        std::vector<FSunShadows::FShadowDrawItem>                  SunCasterScratch;
+        std::vector<std::vector<FLocalShadows::FShadowDrawItem>>   LocalCasterChunks;
+        std::vector<FLocalShadows::FShadowDrawItem>                LocalCasterScratch;
+
         FPostProcessor           PostProcessor;
 
         FObjectPicker            ObjectPicker;
@@ -12,7 +12,6 @@ namespace Smile {
 
         // O Id sobrevive a mudancas nas listas; o indice e apenas o cache do frame atual.
         FSceneObjectRef Selection;
-        std::vector<Mat44> PreviousModels;
 
         // Bounds definidos pelo loader e reutilizados por rebuilds que nao recarregam a cena.
         Vec3 BoundsMin{ 0.0f, 0.0f, 0.0f };
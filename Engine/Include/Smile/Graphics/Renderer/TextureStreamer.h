@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Graphics/Resources/Material.h"
+#include "Smile/Graphics/Resources/Texture.h"
+#include "Smile/Graphics/Resources/TextureResidency.h"
+#include "Smile/Math/Vec3.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Lado GPU do streaming de mips. A decisao e do FTextureResidency; aqui fica o que a executa:
+//   - Demanda: por frame, cada visivel da camera principal vira um pedido de mip para as texturas
+//     do seu material (DemandedMip: distancia ate a caixa de mundo, densidade de UV do mesh,
+//     escala da instancia, altura de render e MipBias da view). Sombra e RT nao puxam streaming:
+//     os hits de RT leem a cauda num LOD fixo contado da mip 0 do arquivo, que o InstanceGeo
+//     desconta pela FirstMip de cada mapa (RT_MapLOD); o loader segura a cauda ate esse LOD
+//     (FSceneLoadOptions::StreamedMaxTailMip).
+//   - IO: uma thread propria le da DDS so as mips da mudanca (LoadDDSCPU com MaxDimension), sem
+//     tocar a fila de upload — que e da thread de render.
+//   - Troca: o FTexture do loader (a cauda) nunca muda, nem a tabela estavel do material — e ela
+//     que o snapshot InstanceGeo do RT cacheia. O que o streaming sobe vira uma VERSAO da textura,
+//     com recurso e SRVSlot proprios; quando a fence da fila COPY passa, cada material que a usa
+//     ganha uma tabela de raster NOVA (CopyTable do staging: versao onde ha, estavel no resto) e o
+//     Bind passa a amarra-la. Nenhum descritor que um frame em voo possa ler e reescrito: a tabela
+//     e a versao anteriores ficam retidas por kFramesInFlight frames. Despejo ate a cauda nao le
+//     nada — solta a versao e o material volta para a tabela estavel.
+//   - Memoria: uma textura com versao tem a cauda duas vezes na VRAM (a do loader e a de dentro da
+//     versao). Fica fora do ResidentBytes; e no maximo 1/4 da versao, ja que a cauda comeca pelo
+//     menos uma mip abaixo dela.
+//
+// Por que recurso inteiro novo e nao tiled/reserved resource ou copia GPU->GPU das mips que
+// sobram: reserved exige tier de tiled resources e um heap de tiles por textura, e a copia GPU
+// leria o recurso velho na fila COPY enquanto a fila direta o amostra (estado COMMON nao cobre os
+// dois). Reler as mips de baixo custa no maximo 1/3 da mip nova.
+namespace Smile {
+    class FUploadQueue;
+    struct FRenderable;
+
+    class FTextureStreamer {
+    public:
+        FTextureStreamer();
+        ~FTextureStreamer();
+
+        FTextureStreamer(const FTextureStreamer&)            = delete;
+        FTextureStreamer& operator=(const FTextureStreamer&) = delete;
+
+        // Desligado, toda textura registrada pede a mip 0 — o comportamento de antes do streaming,
+        // ainda sob o budget.
+        void SetEnabled(bool Enabled) { Enabled_ = Enabled; }
+        bool IsEnabled() const { return Enabled_; }
+        void SetBudgetBytes(u64 Bytes);
+        u64  BudgetBytes() const { return Policy.Options().BudgetBytes; }
+
+        // Textura que o loader subiu so com a cauda (Data.FirstMip > 0); as outras ficam de fora.
+        // Path absoluto da DDS: e de onde as mips de cima vem depois.
+        void Register(FTexture* Texture, const std::filesystem::path& Path, const FTextureCPUData& Data);
+        // Esquece as texturas registradas (load nao aditivo, shutdown) e devolve os materiais para a
+        // tabela estavel — chame antes de solta-los. A fila direta ja tem de estar parada; espera o
+        // upload em voo e descarta o IO pendente.
+        void Clear(FUploadQueue& UploadQueue, FTextureSRVHeap& SRVHeap);
+
+        // Demanda do frame: BeginFrame, um Request por visivel e o Update no fim.
+        void BeginFrame(const FMipDemandView& View, const Vec3& CameraPosition);
+        void Request(const FRenderable& Renderable, const FMaterial* Material);
+        // Troca o que ficou pronto, grava os uploads do IO que chegou e decide as mudancas do frame.
+        // Materials: todos os que podem apontar para uma textura registrada (o editor troca mapas).
+        void Update(ID3D12Device* Device, FUploadQueue& UploadQueue, FTextureSRVHeap& SRVHeap,
+                    std::span<const std::unique_ptr<FMaterial>> Materials, u64 FrameIndex);
+
+        u32                    Count() const { return Policy.Count(); }
+        const FResidencyStats& Stats() const { return Policy.Stats(); }
+
+    private:
+        struct FEntry {
+            FTexture*             Texture = nullptr; // a do loader: cauda, tabela estavel e RT
+            std::filesystem::path Path;
+            bool                  SRGB = false;
+            FTexture              Version; // a do raster; invalida com so a cauda residente
+        };
+        struct FJob {
+            u32                   Texture    = 0;
+            u32                   Generation = 0;
+            std::filesystem::path Path;
+            bool                  SRGB         = false;
+            u32                   MaxDimension = 0;
+        };
+        struct FLoaded {
+            u32             Texture    = 0;
+            u32             Generation = 0;
+            FTextureCPUData Data;
+        };
+        struct FUpload {
+            u32      Texture = 0;
+            FTexture Fresh;
+            u64      Fence = 0;
+        };
+        // Tabela de raster de um material e de onde cada slot foi copiado: muda um mapa (o editor
+        // troca) ou uma versao, a tabela e refeita.
+        struct FRasterTable {
+            FTexture* Maps[kMaterialTextureSlots]    = {};
+            u32       Sources[kMaterialTextureSlots] = {};
+            u32       Table = FTextureSRVHeap::kInvalidSlot;
+        };
+        // Versao ou tabela que frames em voo ainda podem ler.
+        struct FRetired {
+            FTexture Version;
+            u32      Table = FTextureSRVHeap::kInvalidSlot;
+            u64      Frame = 0; // liberado quando FrameIndex chega aqui
+        };
+
+        void Retire(FTexture&& Version, u32 Table, u64 FrameIndex);
+        // Aponta o raster de cada material para as versoes atuais (ou de volta para a estavel).
+        void UpdateRasterTables(ID3D12Device* Device, FTextureSRVHeap& SRVHeap,
+                                std::span<const std::unique_ptr<FMaterial>> Materials, u64 FrameIndex);
+        void IoLoop(std::stop_token Stop);
+
+        FTextureResidency                            Policy;
+        std::vector<FEntry>                          Entries;
+        std::unordered_map<const FTexture*, u32>     ByTexture;
+        std::unordered_map<FMaterial*, FRasterTable> RasterTables;
+        bool                                         Enabled_ = true;
+
+        // Demanda do frame por material: o menor UvDensity * distancia / escala entre os visiveis
+        // que o usam (a mip pedida so depende desse produto e das dimensoes da textura).
+        FMipDemandView                                DemandView;
+        Vec3                                          DemandCamera{};
+        std::unordered_map<const FMaterial*, f32>     Demand;
+
+        std::vector<FUpload>  Uploads;
+        std::vector<FRetired> Retired;
+
+        // Fila do IO. Generation muda no Clear: resultado de antes dele e descartado.
+        std::mutex                  IoMutex;
+        std::condition_variable_any IoWake;
+        std::deque<FJob>            Jobs;
+        std::vector<FLoaded>        Loaded;
+        std::vector<FLoaded>        LoadedLocal;
+        u32                         Generation = 0;
+        std::jthread                IoThread;
+    };
+}
@@ -36,7 +36,16 @@ namespace Smile {
         // VB/IB sem Draw nem topology. O cache de submissao usa isto para pular
         // IASet* quando o mesh nao mudou; o topology fica a cargo do passe (uma vez).
         void BindIA(ID3D12GraphicsCommandList* CommandList) const;
-        void DrawIndexed(ID3D12GraphicsCommandList* CommandList) const;
+        // Instances > 1: o VS le o ObjectConstants de cada instancia pelo SV_InstanceID (DrawBatch.h).
+        void DrawIndexed(ID3D12GraphicsCommandList* CommandList, u32 Instances = 1) const;
+
+        // Ordem de carga na FScene (1, 2, ...; 0 = fora da biblioteca, ex.: malhas do preview). E
+        // o que as chaves de ordenacao usam no lugar do ponteiro: mesma cena, mesma ordem de
+        // agrupamento em toda execucao (DrawSort.h).
+        u32 SortId = 0;
+        // Unidades de UV por unidade local (MeshUvDensity), para a mip que o FTextureStreamer pede.
+        // 0 = desconhecida: o mesh nao puxa streaming.
+        f32 UvDensity = 0.0f;
 
         bool IsValid()       const { return IndexCount > 0; }
         u32  GetIndexCount() const { return IndexCount; }
@@ -94,6 +103,6 @@ namespace Smile {
 
         void BindMaterial(ID3D12GraphicsCommandList* CommandList,
                           FTextureSRVHeap& SRVHeap, const FMaterial* Mat);
-        void DrawMesh(ID3D12GraphicsCommandList* CommandList, const FGpuMesh* Mesh);
+        void DrawMesh(ID3D12GraphicsCommandList* CommandList, const FGpuMesh* Mesh, u32 Instances = 1);
     };
 }
@@ -86,6 +86,11 @@ namespace Smile {
         // nao custa bump de kCookedVersion nem recozinhar as cenas.
         u64 Id = 0;
 
+        // Posicao de importacao (1, 2, ...; 0 = material do renderer, ex.: o default). Denso e
+        // pequeno, cabe nos 20 bits da chave de ordenacao (DrawSort.h); o Id acima nao cabe, e
+        // homonimos identicos ali colapsam, o que aqui nao pode.
+        u32 SortId = 0;
+
         FTexture* Albedo            = nullptr;
         FTexture* Normal            = nullptr; 
         FTexture* MetallicRoughness = nullptr; 
@@ -123,8 +128,17 @@ namespace Smile {
 
         void Release(FTextureSRVHeap& SRVHeap);
 
+        // Amarra o CBV e a tabela do raster: a RasterTable quando ha uma, senao a estavel.
         void Bind(ID3D12GraphicsCommandList* CommandList, FTextureSRVHeap& SRVHeap) const;
 
+        // Tabela de 8 slots que o Bind usa no lugar da estavel (FTextureSRVHeap::kInvalidSlot volta para ela). E do
+        // FTextureStreamer, que aponta o raster para as versoes streamadas sem tocar a tabela
+        // estavel — a que o snapshot InstanceGeo do RT cacheia. O ponteiro so e lido na gravacao
+        // do Bind, entao trocar e seguro com frames em voo; devolve a anterior, que esses frames
+        // ainda leem: quem troca libera depois de kFramesInFlight.
+        u32 SetRasterTable(u32 Table);
+        u32 RasterTableStart() const { return RasterTable; }
+
         void UpdateConstants();
 
         void UpdateTextureSlot(ID3D12Device* Device, FTextureSRVHeap& SRVHeap,
@@ -146,5 +160,6 @@ namespace Smile {
         D3D12_GPU_VIRTUAL_ADDRESS CBGpuVA = 0;
         u32 CBSlot                   = kInvalidTable;
         u32 SRVTableStart            = kInvalidTable;
+        u32 RasterTable              = kInvalidTable;
     };
 } 
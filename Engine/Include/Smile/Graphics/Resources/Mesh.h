@@ -2,6 +2,7 @@
 
 #include "Smile/Core/Types.h"
 #include "Smile/Graphics/RayTracing/RTTriangle.h"
+#include <span>
 #include <vector>
 
 namespace Smile {
@@ -28,6 +29,20 @@ namespace Smile {
         static FMesh CreateCylinder(u32 Slices = 64, f32 Radius = 0.35f, f32 Height = 0.9f);
     };
 
+    // A mesma geometria sem posse: spans sobre bytes que moram em outro lugar — o .smesh mapeado
+    // (cena cozida) ou os vetores de um FMesh. E o que o FScene::AddMeshesBatch consome, para que
+    // o blob do disco va direto para o staging sem uma copia intermediaria por mesh. Quem cria a
+    // view garante que o dono dos bytes vive ate o upload terminar de ler.
+    struct FMeshView {
+        std::span<const Vertex>      Vertices;
+        std::span<const u32>         Indices;
+        std::span<const FRTTriangle> RTTriangles; // vazio = gerar no upload (ver ResolveRTTriangles)
+
+        static FMeshView Of(const FMesh& _Mesh) {
+            return { _Mesh.Vertices, _Mesh.Indices, _Mesh.RTTriangles };
+        }
+    };
+
     // Payload de RT do mesh, gerando em `_Scratch` quando ele NAO veio do cozido. E o ponto unico
     // que faz malha procedural e malha cozida seguirem o mesmo caminho a partir daqui: o
     // FGpuMesh::Upload (primitivas do editor, preview de material) e o FScene::AddMeshesBatch
@@ -45,4 +60,15 @@ namespace Smile {
                          _Mesh.Indices.data(), static_cast<u32>(_Mesh.Indices.size()), _Scratch);
         return _Scratch;
     }
-} 
+
+    // Mesmo contrato para a view: o payload cozido quando existe, senao gerado UMA vez no scratch.
+    inline std::span<const FRTTriangle> ResolveRTTriangles(const FMeshView& _Mesh,
+                                                           std::vector<FRTTriangle>& _Scratch) {
+        if (!_Mesh.RTTriangles.empty()) return _Mesh.RTTriangles;
+        if (!_Scratch.empty()) return _Scratch;
+        if (_Mesh.Indices.empty() || _Mesh.Vertices.empty()) return {};
+        BuildRTTriangles(_Mesh.Vertices.data(), static_cast<u32>(_Mesh.Vertices.size()),
+                         _Mesh.Indices.data(), static_cast<u32>(_Mesh.Indices.size()), _Scratch);
+        return _Scratch;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+
+// Filtros 2x2 da mip chain das texturas decodificadas em runtime (PNG/TGA/JPG via WIC).
+//
+// Os dois kernels eram lacos escalares por texel — LUT por canal e, em sRGB, um upper_bound de 8
+// comparacoes por canal de saida; o de normal, sqrt e divisao por texel de entrada. Nas 135 PNGs
+// do Sponza era o grosso do DecodeMs. Aqui ha tres vias: a escalar (o codigo que ja existia, e a
+// referencia), SSE4.1 (4 pixels de saida por vez) e AVX2 (8). As vias SIMD andam em SoA — cada
+// canal dos 4 cantos do 2x2 num registrador — com as MESMAS operacoes IEEE na mesma ordem (soma,
+// escala, sqrt, divisao; sem FMA nem reciproca aproximada), entao a saida e IDENTICA bit a bit a
+// escalar. Linear -> sRGB troca a busca binaria por uma tabela de baldes: 4096 baldes em [0, 1]
+// (multiplicar por potencia de 2 e exato), e nenhum balde contem mais de um ponto medio entre
+// niveis sRGB vizinhos (o menor espacamento e 1/(255 * 12,92) > 1/4096) — o nivel e o inicio do
+// balde mais uma comparacao, com o mesmo resultado do upper_bound.
+namespace Smile {
+    // Via do kernel. Pedir uma via que a CPU (ou o build) nao tem cai na melhor disponivel abaixo
+    // dela, entao o teste pode pedir as tres em qualquer maquina.
+    enum class EMipPath : u8 { Scalar, SSE41, AVX2 };
+
+    // Melhor via desta CPU: AVX2 se o processador E o SO o suportam, SSE4.1 se houver, escalar no
+    // resto. Resolvida uma vez.
+    EMipPath    DetectMipPath();
+    const char* MipPathName(EMipPath Path);
+
+    // sRGB -> linear, 256 entradas (o dominio de entrada e um u8, entao a tabela e exata).
+    const f32* SrgbToLinearLUT();
+    // Linear -> nivel sRGB mais proximo, com arredondamento exato. A referencia das vias SIMD.
+    u8 LinearToSrgbU8(f32 Linear);
+
+    // Box 2x2 RGBA8 de Src (SrcW x SrcH) para Dst (DstW x DstH, a metade arredondada para baixo,
+    // minimo 1). SrgbSpace = os bytes de ENTRADA estao em sRGB (albedo/emissivo): a media de RGB
+    // acontece em linear. O alfa e sempre media direta.
+    void DownsampleColor2x2(const u8* Src, u32 SrcW, u32 SrcH, u8* Dst, u32 DstW, u32 DstH,
+                            bool SrgbSpace, EMipPath Path = DetectMipPath());
+
+    // Box 2x2 de normal map: cada texel normalizado, a soma renormalizada em RGB e o comprimento
+    // medio (Toksvig) no alfa. Devolve a media desse comprimento no nivel.
+    f32 DownsampleNormal2x2(const u8* Src, u32 SrcW, u32 SrcH, u8* Dst, u32 DstW, u32 DstH,
+                            EMipPath Path = DetectMipPath());
+}
@@ -31,6 +31,9 @@ namespace Smile {
         u32         Height  = 0;
         DXGI_FORMAT Format  = DXGI_FORMAT_R8G8B8A8_UNORM;
         bool        IsNormalMap = false;
+        // Mip do arquivo que Mips[0] e. > 0 quando o LoadDDSCPU deixou as mips de cima no disco
+        // (streaming); Width/Height continuam sendo os da mip 0 do arquivo.
+        u32         FirstMip = 0;
         bool Valid() const { return !Mips.empty(); }
     };
 
@@ -58,7 +61,11 @@ namespace Smile {
         // fixo, ver Reflections::AlbedoLOD).
         static void GenerateColorMips(FTextureCPUData& Data, bool SrgbSpace);
 
-        static FTextureCPUData LoadDDSCPU(const std::wstring& Path, bool sRGB);
+        // MaxDimension > 0 le so a partir da primeira mip com o maior lado <= MaxDimension (ver
+        // FTextureCPUData::FirstMip): o cabecalho e as mips pedidas, com seek por cima do resto.
+        // MaxFirstMip limita o corte: a leitura nunca comeca depois desta mip do arquivo.
+        static FTextureCPUData LoadDDSCPU(const std::wstring& Path, bool sRGB, u32 MaxDimension = 0,
+                                          u32 MaxFirstMip = 0xFFFFFFFFu);
         static FTexture        LoadDDS(ID3D12Device* Device, FUploadQueue& UploadQueue,
                                        FTextureSRVHeap& SRVHeap,
                                        const std::wstring& Path, bool sRGB);
@@ -67,6 +74,12 @@ namespace Smile {
                                                         FTextureSRVHeap& SRVHeap,
                                                         const std::vector<FTextureCPUData>& Data);
 
+        // Grava o upload no batch ABERTO da fila (Begin ja chamado; o Submit e do chamador). Para
+        // quem precisa da fence do batch, como o FTextureStreamer.
+        static FTexture RecordFromCPU(ID3D12Device* Device, ID3D12GraphicsCommandList* CommandList,
+                                      FTextureSRVHeap& SRVHeap, const FTextureCPUData& Data,
+                                      FUploadQueue& UploadQueue);
+
         static FTexture CreateDefault(ID3D12Device* Device, FUploadQueue& UploadQueue,
                                       FTextureSRVHeap& SRVHeap,
                                       EDefaultTexture Type);
@@ -79,6 +92,8 @@ namespace Smile {
         u32             Width()     const { return TexWidth; }
         u32             Height()    const { return TexHeight; }
         u32             MipCount()  const { return TexMipCount; }
+        // Mip do arquivo que e a mip 0 do recurso (streaming); Width/Height sao as do recurso.
+        u32             FirstMip()  const { return TexFirstMip; }
         bool            IsValid()   const { return GpuResource != nullptr; }
 
     private:
@@ -104,6 +119,7 @@ namespace Smile {
         u32 TexWidth    = 0;
         u32 TexHeight   = 0;
         u32 TexMipCount = 1;
+        u32 TexFirstMip = 0;
         DXGI_FORMAT TexFormat = DXGI_FORMAT_R8G8B8A8_UNORM; 
     };
 }
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Graphics/Resources/Mesh.h"
+#include <span>
+#include <vector>
+
+// Politica de residencia do streaming de mips (o lado GPU e o FTextureStreamer).
+//
+// Toda textura streamada tem uma CAUDA — as mips com o maior lado <= TailDimension — que sobe no
+// load e nunca sai. Por frame, o renderer pede a mip que cada textura visivel precisa
+// (DemandedMip: tamanho na tela, densidade de UV do mesh e o MipBias da view); o Update compara
+// com o que esta residente e devolve as mudancas do frame:
+//   - Carga: uma mip por vez, em rodadas sobre as texturas com falta (maior falta primeiro), ate o
+//     teto de bytes por Update. Sob pressao todo mundo ganha as mips grossas antes de alguem ganhar
+//     a mip 0 — a imagem piora por igual em vez de uma textura nitida ao lado de uma borrada.
+//   - Despejo: so quando a carga nao cabe no budget. Primeiro as texturas fora da tela, da usada
+//     ha mais tempo para a mais recente (LRU), direto para a cauda; depois as que estao na tela com
+//     mips mais finas do que pedem, ate a mip pedida. O que o frame pede nunca e despejado para
+//     abrir espaco para outra textura: sem espaco, a carga espera (Starved nas estatisticas).
+//
+// Cada textura tem no maximo uma mudanca em voo: Target e o que foi decidido, Resident o que a GPU
+// ja tem; Complete fecha a mudanca. O budget conta Target — carga reserva na decisao, despejo libera
+// na decisao —, entao CommittedBytes <= BudgetBytes sempre que as caudas cabem nele.
+namespace Smile {
+    // So o que a politica precisa para contar bytes: BCn sao blocos 4x4 (o lado da mip arredonda
+    // para cima, minimo um bloco); formato sem bloco usa BlockDim 1 e BlockBytes = bytes por texel.
+    struct FStreamedTextureDesc {
+        u32 Width      = 0;
+        u32 Height     = 0;
+        u32 MipCount   = 1;
+        u32 BlockDim   = 4;
+        u32 BlockBytes = 16;
+    };
+
+    u64 StreamedMipBytes(const FStreamedTextureDesc& Desc, u32 Mip);
+    // Bytes das mips FirstMip..fim — o tamanho do recurso com FirstMip residente.
+    u64 StreamedChainBytes(const FStreamedTextureDesc& Desc, u32 FirstMip);
+    // Primeira mip cujo maior lado cabe em TailDimension (a ultima, se nenhuma couber).
+    u32 StreamedTailMip(const FStreamedTextureDesc& Desc, u32 TailDimension);
+
+    // Unidades de UV por unidade do espaco local do mesh: sqrt(area em UV / area no espaco local),
+    // somadas sobre os triangulos. Media ponderada por area, o que o amostrador ve na maior parte
+    // da superficie; 0 sem area (mesh degenerado ou sem UV).
+    f32 MeshUvDensity(std::span<const Vertex> Vertices, std::span<const u32> Indices);
+
+    struct FMipDemandView {
+        f32 ViewportHeight = 1080.0f; // pixels da resolucao de RENDER (a que amostra)
+        f32 FovYRadians    = 1.0f;
+        f32 MipBias        = 0.0f;    // FFrameView::MipBias
+    };
+
+    // Mip (fracionaria) que o amostrador usa numa superficie de frente para a camera a
+    // `_Distance`: log2(texels por pixel) + MipBias, em [0, inf). Superficie obliqua amostra mip
+    // mais grossa, entao a estimativa e conservadora. WorldScale leva a densidade local para o
+    // mundo (maior eixo da escala da instancia). Distance <= 0 (camera dentro da caixa) pede 0.
+    f32 DemandedMip(const FMipDemandView& View, u32 TexWidth, u32 TexHeight, f32 UvDensity,
+                    f32 WorldScale, f32 Distance);
+
+    struct FTextureResidencyOptions {
+        u64 BudgetBytes           = 1024ull * 1024 * 1024;
+        // Teto de bytes de mip novos decididos por Update (IO + upload do frame). A primeira carga
+        // do Update passa mesmo acima dele: uma mip 0 de 8K nao pode esperar para sempre.
+        u64 MaxLoadBytesPerUpdate = 64ull * 1024 * 1024;
+        u32 TailDimension         = 128;
+    };
+
+    // Mudanca de uma textura: ToMip < FromMip carrega, ToMip > FromMip despeja.
+    struct FResidencyChange {
+        u32 Texture = 0;
+        u32 FromMip = 0;
+        u32 ToMip   = 0;
+    };
+
+    struct FResidencyStats {
+        u64 ResidentBytes  = 0; // o que a GPU tem (Resident)
+        u64 CommittedBytes = 0; // o decidido (Target): <= budget
+        u64 TailBytes      = 0;
+        u64 BudgetBytes    = 0;
+        u32 Textures       = 0;
+        u32 InFlight       = 0;
+        // Do ultimo Update.
+        u32 Requested      = 0; // texturas pedidas no frame
+        u32 Starved        = 0; // com falta e sem budget (nem despejando)
+        u64 LoadBytes      = 0;
+        u64 EvictBytes     = 0;
+        u32 Loads          = 0;
+        u32 Evictions      = 0;
+    };
+
+    class FTextureResidency {
+    public:
+        explicit FTextureResidency(const FTextureResidencyOptions& Options = {});
+
+        // Budget menor vale no proximo Update (despeja o que for preciso para cargas novas, mas
+        // nao despeja so por despejar: o que ja esta residente fica ate alguem precisar do espaco).
+        void SetOptions(const FTextureResidencyOptions& Options);
+        const FTextureResidencyOptions& Options() const { return Opt; }
+
+        static constexpr u32 kAutoTail = 0xFFFFFFFFu;
+
+        // Entra com a cauda residente. Devolve o indice da textura (denso, na ordem do Add). Tail
+        // explicito: a cauda que de fato subiu (FTextureCPUData::FirstMip); kAutoTail conta pela
+        // TailDimension das opcoes.
+        u32  Add(const FStreamedTextureDesc& Desc, u32 Tail = kAutoTail);
+        void Clear();
+        u32  Count() const { return static_cast<u32>(Items.size()); }
+
+        // Mip que o frame corrente pede (a menor entre os pedidos do frame). Trilinear le a mip de
+        // baixo e a de cima: pede floor(Mip).
+        void Request(u32 Texture, f32 Mip);
+
+        // Fecha o frame e decide as mudancas (validas ate o proximo Update). Textura com mudanca em
+        // voo fica de fora ate o Complete.
+        const std::vector<FResidencyChange>& Update();
+
+        // A GPU tem o Target (Success) ou a mudanca falhou e a textura segue no Resident. Despejo que
+        // falha devolve os bytes ao Committed (continuam na GPU): o budget pode passar ate a proxima
+        // carga que precise de espaco.
+        void Complete(u32 Texture, bool Success = true);
+
+        u32  ResidentMip(u32 Texture) const { return Items[Texture].Resident; }
+        u32  TargetMip(u32 Texture)   const { return Items[Texture].Target; }
+        u32  TailMip(u32 Texture)     const { return Items[Texture].Tail; }
+        // Ultima mip pedida (a cauda se nunca foi pedida).
+        u32  WantedMip(u32 Texture)   const { return Items[Texture].Wanted; }
+        u64  LastUsedFrame(u32 Texture) const { return Items[Texture].LastUsed; }
+        u64  Frame() const { return CurrentFrame; }
+        const FStreamedTextureDesc& Desc(u32 Texture) const { return Items[Texture].Desc; }
+        const FResidencyStats&      Stats() const { return Stat; }
+
+    private:
+        struct FItem {
+            FStreamedTextureDesc Desc;
+            u32 Tail     = 0;
+            u32 Resident = 0;
+            u32 Target   = 0;
+            u32 Wanted   = 0;
+            u64 LastUsed = 0; // frame do ultimo pedido (0 = nunca; frames contam de 1)
+        };
+
+        // Libera `_Bytes` de budget despejando (LRU fora da tela, depois excesso na tela).
+        bool MakeRoom(u64 Bytes);
+        void Retarget(u32 Texture, u32 Mip);
+
+        FTextureResidencyOptions      Opt;
+        std::vector<FItem>            Items;
+        std::vector<FResidencyChange> Changes;
+        std::vector<u32>              Needy;
+        std::vector<u32>              Victims; // candidatos a despejo do Update corrente, ja em ordem
+        size_t                        VictimCursor = 0;
+        bool                          VictimsBuilt = false;
+        u64                           CurrentFrame = 1;
+        FResidencyStats               Stat;
+    };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include "Smile/Scene/CookedFormat.h"
+#include <span>
+#include <string>
+#include <vector>
+
+// Codificacao do bloco de mesh da v9 (kMeshEntryCoded). Compilado TAMBEM pelo SmileCooker, que
+// so usa headers da engine: nada aqui depende de D3D12, do Logger ou de estado global.
+//
+// Layout do bloco EXPANDIDO (RawBytes), streams em sequencia e sem padding:
+//   posicoes  u16[3*V] (kMeshEntryQuantizedPosition) ou f32[3*V] em planos de byte
+//   normais   f32[3*V] em planos de byte
+//   UVs       f32[2*V] em planos de byte
+//   RT        FRTTriangle[IndexCount/3], cru
+//   indices   o resto do bloco: delta zigzag/varint (kMeshEntryIndexVarint) ou u16[I]
+// "Planos de byte" = o byte 0 de todas as palavras, depois o byte 1, ... — expoente e sinal de
+// floats vizinhos se repetem, e e isso que o LZ enxerga como match.
+//
+// O LZ e da familia do LZ4 (sem estagio de entropia): o ponto do formato e decodificar mais rapido
+// do que o disco entrega bytes, entao o decoder e so copia de literal e de match.
+namespace Smile {
+    // Comprime `In` inteiro, anexando a `Out`.
+    void LzCompress(std::span<const u8> In, std::vector<u8>& Out);
+    // Expande EXATAMENTE Out.size() bytes. false se o payload estiver corrompido ou nao preencher
+    // a saida — nunca le nem escreve fora dos dois spans.
+    bool LzDecompress(std::span<const u8> In, std::span<u8> Out);
+
+    struct FMeshCodingOptions {
+        bool QuantizePositions = false; // com perda: passo de (AABBMax-AABBMin)/65535 por eixo
+    };
+
+    struct FCodedMeshBlock {
+        u32             Flags    = 0; // kMeshEntryCoded | variantes escolhidas
+        u32             RawBytes = 0;
+        std::vector<u8> Bytes;        // payload LZ
+    };
+
+    // `_Entry` fornece contagens e AABB (a da quantizacao). O indice e codificado nas duas formas
+    // possiveis e fica a que sair menor depois do LZ — o cooker paga isso uma vez.
+    FCodedMeshBlock EncodeMeshBlock(const SMeshEntry& Entry, const FMeshView& Mesh,
+                                    const FMeshCodingOptions& Options);
+
+    // Expande o bloco de `_Entry` (ja validado contra o arquivo) em `_Out`. false + `_Error` se o
+    // bloco nao bater com as contagens da entrada ou algum indice cair fora do VB.
+    bool DecodeMeshBlock(const SMeshEntry& Entry, std::span<const u8> Coded, FMesh& Out, std::string& Error);
+}
@@ -5,30 +5,43 @@
 namespace Smile {
     constexpr u32 kSMeshMagic    = 0x48534D53u; 
     constexpr u32 kSSceneMagic   = 0x4E435353u; 
-    constexpr u32 kCookedVersion = 8u; // v8: +payload de RT por triangulo (FRTTriangle, 32 B) numa terceira
-                                       //     regiao do blob, por mesh. O hit de RT deixa de percorrer
-                                       //     PrimitiveIndex -> IB -> 3 vertices (cadeia dependente, enderecos
-                                       //     espalhados) e le UM registro contiguo indexado direto pelo
-                                       //     PrimitiveIndex. Carrega normal de face E as 3 normais de vertice
-                                       //     (octaedricas SNORM16x2) + as 3 UVs (half2): a interpolada continua
-                                       //     mandando na BRDF, a de face continua governando facing/OffsetN/
-                                       //     SignedDist. VB/IB CONTINUAM no arquivo — BLAS, raster e
-                                       //     MeshLightExtract ainda os consomem.
-                                       // v7: o transform do no NAO e mais bakeado no vertice. A geometria
-                                       //     sai em espaco LOCAL (AABB da SMeshEntry idem) e cada renderavel
-                                       //     carrega nome do no, TRS de mundo e indice do pai. Com isso o
-                                       //     cooker passa a DEDUPLICAR mesh por (ufbx_mesh, parte): N nos que
-                                       //     compartilham a mesma malha viram N instancias de UMA geometria
-                                       //     (Emerald Square: 2479 -> 281 partes). Medido antes de escrever:
-                                       //     TRS reproduz geometry_to_world com erro <= 7e-12 nas 3 cenas
-                                       //     (nenhuma tem shear nem determinante negativo).
-                                       // v6: vidro por nome -> Blend translucido (alpha 0.4, two-sided) p/ o
-                                       //     passe forward; vidro emissivo segue opaco (glow no deferred)
-                                       // v5: normais pela inversa-transposta + winding por no espelhado; tambem
-                                       //     invalida cozidos anteriores a "fator neutro com textura" no emissivo
-                                       // v4: +fatores PBR lidos do material (Metallic/RoughnessFactor) + Blend (alpha translucido)
-                                       // v3: +Metalness/Roughness separados (PBR metal/rough nao-packed, ex.: Sponza PNG)
-                                       // v2: +SSceneMaterial::Foliage (shading model desacoplado de masked)
+    constexpr u32 kCookedVersion = 11u; // v11: SMeshEntry 96 -> 104 B. Reserved1 vira LodCount, +LodOffset: regiao
+                                        //     de LODs por mesh (SMeshLod, 16 B, + os IBs simplificados sobre
+                                        //     o mesmo VB), com o erro geometrico de cada nivel para a escolha
+                                        //     por erro de tela. Crua, como os clusters.
+                                        // v10: SMeshEntry 80 -> 96 B. +regiao de CLUSTERS por mesh (SMeshCluster,
+                                        //     64 B): o IB final fatiado em faixas contiguas de 64-128
+                                        //     triangulos, cada uma com AABB, esfera e cone de normais. Sempre
+                                        //     crua, mesmo em mesh codificado: o culling le antes de decodificar.
+                                        // v9: SMeshEntry 64 -> 80 B. Reserved0 vira Flags, +bloco CODIFICADO opcional
+                                        //     por mesh (--compress no cooker): VB em streams (posicao opcional-
+                                        //     mente quantizada em 16 bits na AABB local), IB em u16 ou delta
+                                        //     zigzag/varint, payload de RT cru — tudo sob um LZ. Mesh sem a flag
+                                        //     segue com as tres regioes cruas da v8 (zero-copia no load).
+                                        // v8: +payload de RT por triangulo (FRTTriangle, 32 B) numa terceira
+                                        //     regiao do blob, por mesh. O hit de RT deixa de percorrer
+                                        //     PrimitiveIndex -> IB -> 3 vertices (cadeia dependente, enderecos
+                                        //     espalhados) e le UM registro contiguo indexado direto pelo
+                                        //     PrimitiveIndex. Carrega normal de face E as 3 normais de vertice
+                                        //     (octaedricas SNORM16x2) + as 3 UVs (half2): a interpolada continua
+                                        //     mandando na BRDF, a de face continua governando facing/OffsetN/
+                                        //     SignedDist. VB/IB CONTINUAM no arquivo — BLAS, raster e
+                                        //     MeshLightExtract ainda os consomem.
+                                        // v7: o transform do no NAO e mais bakeado no vertice. A geometria
+                                        //     sai em espaco LOCAL (AABB da SMeshEntry idem) e cada renderavel
+                                        //     carrega nome do no, TRS de mundo e indice do pai. Com isso o
+                                        //     cooker passa a DEDUPLICAR mesh por (ufbx_mesh, parte): N nos que
+                                        //     compartilham a mesma malha viram N instancias de UMA geometria
+                                        //     (Emerald Square: 2479 -> 281 partes). Medido antes de escrever:
+                                        //     TRS reproduz geometry_to_world com erro <= 7e-12 nas 3 cenas
+                                        //     (nenhuma tem shear nem determinante negativo).
+                                        // v6: vidro por nome -> Blend translucido (alpha 0.4, two-sided) p/ o
+                                        //     passe forward; vidro emissivo segue opaco (glow no deferred)
+                                        // v5: normais pela inversa-transposta + winding por no espelhado; tambem
+                                        //     invalida cozidos anteriores a "fator neutro com textura" no emissivo
+                                        // v4: +fatores PBR lidos do material (Metallic/RoughnessFactor) + Blend (alpha translucido)
+                                        // v3: +Metalness/Roughness separados (PBR metal/rough nao-packed, ex.: Sponza PNG)
+                                        // v2: +SSceneMaterial::Foliage (shading model desacoplado de masked)
 
     constexpr u32 kCookedMaxPath = 256u;
     constexpr u32 kCookedMaxName = 128u;
@@ -55,9 +68,53 @@ namespace Smile {
         // cooker so gera esta regiao DEPOIS do weld e do winding finais.
         u64 RTTriangleOffset;
         u32 RTTriangleCount;
-        u32 Reserved0;    // mantem o struct multiplo de 8 (os u64 acima exigem alinhamento 8)
+        u32 Flags;        // kMeshEntry*; era Reserved0 (sempre 0) ate a v8
+        // v9: com kMeshEntryCoded, as tres regioes acima NAO existem (offsets 0) e o mesh inteiro
+        // mora em [CodedOffset, CodedOffset+CodedBytes) do blob: um payload LZ que expande para
+        // RawBytes bytes. Layout expandido e decodificacao: CookedCodec.h.
+        u64 CodedOffset;
+        u32 CodedBytes;
+        u32 RawBytes;
+        // v10: SMeshCluster[ClusterCount] em [ClusterOffset, ...) do blob, fora do bloco codificado.
+        // As faixas cobrem o IB em ordem e sem buraco; 0 clusters = sem granularidade fina (o mesh
+        // inteiro e a unidade de culling, como ate a v9).
+        u64 ClusterOffset;
+        u32 ClusterCount;
+        // v11: SMeshLod[LodCount] em [LodOffset, ...) do blob, seguidos dos indices de todos os
+        // niveis (u32, sobre o VB deste mesh). Fora do bloco codificado. 0 = so o LOD0.
+        u32 LodCount;     // era Reserved1 (sempre 0) ate a v10
+        u64 LodOffset;
     };
-    static_assert(sizeof(SMeshEntry) == 64, "SMeshEntry e formato persistido: 64 B na v8");
+    static_assert(sizeof(SMeshEntry) == 104, "SMeshEntry e formato persistido: 104 B na v11");
+
+    constexpr u32 kMeshEntryCoded             = 1u << 0; // mesh no bloco codificado, nao nas regioes cruas
+    constexpr u32 kMeshEntryQuantizedPosition = 1u << 1; // posicao u16x3 normalizada na AABBMin/Max da entrada
+    constexpr u32 kMeshEntryIndexVarint       = 1u << 2; // IB em delta zigzag/varint; sem a flag, u16 cru
+
+    // v10: faixa [FirstTriangle, FirstTriangle+TriangleCount) do IB com os limites em espaco LOCAL
+    // do mesh. Construcao e culling: MeshClusters.h.
+    struct SMeshCluster {
+        u32 FirstTriangle;
+        u32 TriangleCount;
+        f32 AABBMin[3];
+        f32 AABBMax[3];
+        f32 Center[3];   // esfera envolvente
+        f32 Radius;
+        f32 ConeAxis[3]; // media das normais de face (winding da engine), normalizada
+        f32 ConeCutoff;  // seno do meio-angulo do cone; 1 = abertura >= 90 graus, nunca descarta
+    };
+    static_assert(sizeof(SMeshCluster) == 64, "SMeshCluster e formato persistido: 64 B");
+
+    // v11: um nivel simplificado. Indices em [FirstIndex, FirstIndex+IndexCount) da lista que
+    // segue a tabela de niveis; os niveis vem do mais fino para o mais grosso. Construcao e
+    // escolha: MeshLod.h.
+    struct SMeshLod {
+        u32 FirstIndex;
+        u32 IndexCount;
+        f32 Error;    // desvio geometrico estimado em relacao ao LOD0, espaco LOCAL; nao decresce
+        u32 Reserved;
+    };
+    static_assert(sizeof(SMeshLod) == 16, "SMeshLod e formato persistido: 16 B");
 
     struct SSceneHeader {
         u32 Magic;   // kSSceneMagic
@@ -94,9 +151,9 @@ namespace Smile {
         u32 MaterialIndex; // indice em SSceneMaterial; 0xFFFFFFFF = sem material (usa default)
 
         // Transform de MUNDO do no, no formato do FTransform da engine (S * Rx*Ry*Rz * T,
-        // row-vector, rotacao em RADIANOS). Mundo e nao local porque na v7 o runtime ainda nao
-        // tem hierarquia — o transform vai direto como matriz de modelo. O ParentIndex abaixo ja
-        // e gravado para a fase da hierarquia converter mundo->local sem re-cozinhar.
+        // row-vector, rotacao em RADIANOS). Mundo e nao local porque a v7 nasceu antes da
+        // hierarquia do runtime; hoje o import converte mundo->local pelo ParentIndex abaixo
+        // (FScene, SceneHierarchy.h), sem re-cozinhar.
         f32 Position[3];
         f32 RotationEuler[3];
         f32 Scale[3];
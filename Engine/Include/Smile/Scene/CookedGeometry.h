@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include "Smile/Scene/CookedFormat.h"
+#include "Smile/Scene/MeshLod.h"
+#include <span>
+#include <string>
+#include <vector>
+
+// Leitura e validacao dos dois arquivos cozidos SEM device e sem decodificar textura. E a parte do
+// SceneLoader que decide se os bytes sao confiaveis; separada para que um teste CPU a exercite
+// sobre arquivos sinteticos (truncados, desalinhados, com payload de RT inconsistente).
+namespace Smile {
+    // Tabelas do .smesh. As views APONTAM para os bytes recebidos por ParseCookedMeshes: valem
+    // enquanto o dono desses bytes (FMappedFile) viver. Entrada com kMeshEntryCoded tem view
+    // VAZIA — o bloco dela e Geometry.subspan(CodedOffset, CodedBytes), e quem carrega decodifica
+    // (DecodeMeshBlock) para storage proprio e aponta a view para la.
+    struct FCookedMeshTable {
+        SMeshHeader             Header{};
+        std::vector<SMeshEntry> Entries;
+        std::vector<FMeshView>  Views;
+        // v10: clusters de cada entrada, tambem views sobre os bytes recebidos. Vazia = a entrada
+        // nao tem clusters (o mesh inteiro e a unidade de culling).
+        std::vector<std::span<const SMeshCluster>> Clusters;
+        // v11: niveis simplificados de cada entrada (views sobre os bytes recebidos). Vazio = so
+        // o LOD0.
+        std::vector<FMeshLodSet> Lods;
+        std::span<const u8>     Geometry;       // o blob inteiro, depois da tabela de entradas
+        u32                     CodedCount = 0; // entradas com kMeshEntryCoded
+    };
+
+    struct FCookedSceneTable {
+        SSceneHeader                  Header{};
+        std::vector<SSceneMaterial>   Materials;
+        std::vector<SSceneRenderable> Renderables;
+    };
+
+    // false + mensagem em `Error` para magic/versao errados, tabela ou regiao truncada, offset
+    // desalinhado para o tipo do elemento, flags desconhecidas, bloco codificado fora do arquivo,
+    // RTTriangleCount != IndexCount/3, clusters que nao cobrem o IB em faixas contiguas ou LODs
+    // fora de ordem (faixas nao contiguas, contagem que nao cai, erro que cai, indice fora do VB).
+    bool ParseCookedMeshes(std::span<const u8> Bytes, FCookedMeshTable& Out, std::string& Error);
+    // As duas metades do ParseCookedMeshes, para o loader validar as entradas em paralelo:
+    // a tabela (cabecalho, entradas, CodedCount; Views/Clusters/Lods dimensionados e vazios) e
+    // depois cada entrada, que so escreve os proprios slots. Entradas diferentes podem rodar ao
+    // mesmo tempo; o erro de uma e o mesmo que o ParseCookedMeshes daria parando nela.
+    bool ParseCookedMeshTable(std::span<const u8> Bytes, FCookedMeshTable& Out, std::string& Error);
+    bool ParseCookedMeshEntry(FCookedMeshTable& Out, u32 Index, std::string& Error);
+    bool ParseCookedScene(std::span<const u8> Bytes, FCookedSceneTable& Out, std::string& Error);
+
+    // [Offset, Offset + Count*Stride) cabe em Total, sem overflow em nenhuma das contas.
+    bool CookedArrayFits(u64 Offset, u64 Count, size_t Stride, size_t Total);
+}
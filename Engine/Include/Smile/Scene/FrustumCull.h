@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Math/Mat44.h"
+#include "Smile/Math/Vec3.h"
+#include "Smile/Math/Vec4.h"
+#include <span>
+#include <vector>
+
+// Culling de AABB contra frustum (e esfera) em lote, para as listas de draw e de casters.
+//
+// Os tres lugares que cullam caixas de mundo — o frustum da camera no BuildDrawLists, as fatias
+// do CSM no FSunShadows e a broad/narrow phase das sombras locais — faziam o mesmo teste escalar
+// de 6 planos, um objeto por vez. Aqui as caixas moram em SoA (MinX[], MinY[], ...) e o kernel
+// testa 4 (SSE) ou 8 (AVX) de uma vez contra VARIAS vistas na mesma passada: cada bloco de caixas
+// e carregado uma vez e atravessa a camera, as 4 cascatas ou os N spots. A saida e uma lista
+// compactada de indices por vista, em ordem crescente — quem consome continua andando na ordem da
+// lista de origem.
+//
+// O teste e o mesmo "vertice positivo" de sempre, com as mesmas operacoes na mesma ordem: as
+// tres vias (escalar, SSE, AVX) devolvem EXATAMENTE as mesmas listas, e o escalar e o teste que
+// ja existia. Conservador na direcao certa: caixa que atravessa um plano conta como dentro.
+namespace Smile {
+    constexpr u32 kCullMaxPlanes = 6;
+
+    // Volume convexo de ate 6 planos de mundo NAO normalizados (p.xyz . x + p.w >= 0 e dentro).
+    // Menos de 6 e legitimo: a cascata do CSM culla sem o near por causa do pancaking.
+    struct FCullFrustum {
+        Vec4 Planes[kCullMaxPlanes]{};
+        u32  PlaneCount = kCullMaxPlanes;
+
+        // Os 6 planos de um ViewProj row-vector (x' = x * M), na ordem do FFrameView::FrustumPlanes:
+        // esquerda, direita, baixo, cima, near (z' >= 0), far.
+        static FCullFrustum FromViewProj(const Mat44& ViewProj);
+        // Planos ja prontos (FFrameView::FrustumPlanes, os 5 de uma cascata). Count e limitado a 6.
+        static FCullFrustum FromPlanes(const Vec4* Planes, u32 Count);
+    };
+
+    // Caixas de mundo em SoA. O indice de uma caixa e a posicao em que ela foi empurrada.
+    struct FCullBounds {
+        std::vector<f32> MinX, MinY, MinZ;
+        std::vector<f32> MaxX, MaxY, MaxZ;
+
+        size_t Size() const { return MinX.size(); }
+
+        void Clear() {
+            MinX.clear(); MinY.clear(); MinZ.clear();
+            MaxX.clear(); MaxY.clear(); MaxZ.clear();
+        }
+
+        void Reserve(size_t Count) {
+            MinX.reserve(Count); MinY.reserve(Count); MinZ.reserve(Count);
+            MaxX.reserve(Count); MaxY.reserve(Count); MaxZ.reserve(Count);
+        }
+
+        // Tamanho fixo + Set por indice: quem preenche em paralelo escreve cada caixa no seu lugar.
+        void Resize(size_t Count) {
+            MinX.resize(Count); MinY.resize(Count); MinZ.resize(Count);
+            MaxX.resize(Count); MaxY.resize(Count); MaxZ.resize(Count);
+        }
+
+        void Set(size_t Index, const Vec3& Min, const Vec3& Max) {
+            MinX[Index] = Min.X; MinY[Index] = Min.Y; MinZ[Index] = Min.Z;
+            MaxX[Index] = Max.X; MaxY[Index] = Max.Y; MaxZ[Index] = Max.Z;
+        }
+
+        void Push(const Vec3& Min, const Vec3& Max) {
+            MinX.push_back(Min.X); MinY.push_back(Min.Y); MinZ.push_back(Min.Z);
+            MaxX.push_back(Max.X); MaxY.push_back(Max.Y); MaxZ.push_back(Max.Z);
+        }
+    };
+
+    // Via do kernel. Pedir uma via que a CPU (ou o build) nao tem cai na melhor disponivel abaixo
+    // dela, entao o teste pode pedir as tres em qualquer maquina.
+    enum class ECullPath : u8 { Scalar, SSE, AVX };
+
+    // Melhor via desta CPU: AVX se o processador E o SO o suportam, SSE em todo x64, escalar no
+    // resto. Resolvida uma vez.
+    ECullPath DetectCullPath();
+    const char* CullPathName(ECullPath Path);
+
+    // Testa as caixas contra todas as `Views` numa passada. `Out[v]` e SUBSTITUIDO pelos indices
+    // (crescentes) das caixas que nao estao inteiramente fora de `Views[v]`; precisa ter pelo
+    // menos Views.size() entradas.
+    void CullFrustums(const FCullBounds& Bounds, std::span<const FCullFrustum> Views,
+                      std::span<std::vector<u32>> Out, ECullPath Path = DetectCullPath());
+    // So as caixas [Begin, End) — a faixa de um job. Os indices de saida continuam absolutos.
+    void CullFrustums(const FCullBounds& Bounds, size_t Begin, size_t End, std::span<const FCullFrustum> Views,
+                      std::span<std::vector<u32>> Out, ECullPath Path = DetectCullPath());
+
+    // Caixas que tocam a esfera (distancia ponto-caixa <= Radius) — a broad phase das luzes
+    // locais. `Out` e substituido, indices crescentes.
+    void CullSphere(const FCullBounds& Bounds, const Vec3& Center, f32 Radius, std::vector<u32>& Out,
+                    ECullPath Path = DetectCullPath());
+
+    // Os testes escalares de uma caixa, a referencia das tres vias.
+    bool AABBOutsideFrustum(const FCullFrustum& View, const Vec3& Min, const Vec3& Max);
+    bool AABBTouchesSphere(const Vec3& Min, const Vec3& Max, const Vec3& Center, f32 Radius);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include <span>
+#include <vector>
+
+// Pipeline de geometria disco -> staging em chunks, SEM device. O FScene::AddMeshesBatch e um
+// cliente (sink D3D12); o teste dirige o mesmo caminho com um sink em memoria.
+//
+// Antes, ler o .smesh, copiar cada mesh e empacotar cada chunk eram tres passadas seriais. Aqui
+// um worker empacota o chunk N+1 (e e nele que as paginas do arquivo mapeado sao lidas pela
+// primeira vez, e o payload de RT de malha runtime e gerado) enquanto a thread chamadora
+// submete o chunk N.
+namespace Smile {
+    // Um chunk do pool: meshes [FirstMesh, FirstMesh+MeshCount) empacotados em
+    // [VB][IB][pad ate 32][RT]. Todo offset de fatia sai multiplo do stride da propria regiao.
+    struct FGeometryChunk {
+        u32 FirstMesh = 0;
+        u32 MeshCount = 0;
+        u64 VbBytes   = 0; // regiao de VB em [0, VbBytes)
+        u64 IbBytes   = 0; // regiao de IB em [VbBytes, VbBytes+IbBytes)
+        u64 RtBase    = 0; // VbBytes+IbBytes arredondado para sizeof(FRTTriangle)
+        u64 RtBytes   = 0;
+
+        u64 TotalBytes() const { return RtBase + RtBytes; }
+    };
+
+    // Onde cada mesh caiu dentro do chunk. Contagens zero = mesh sem geometria (VB ou IB vazio),
+    // que nao ocupa bytes e vira um FGpuMesh invalido.
+    struct FGeometrySlice {
+        u64 VbOffset = 0;
+        u64 IbOffset = 0;
+        u64 RtOffset = 0;
+        u32 VertexCount     = 0;
+        u32 IndexCount      = 0;
+        u32 RTTriangleCount = 0;
+    };
+
+    // Destino dos chunks. As tres chamadas tem thread FIXA, e e isso que deixa o sink D3D12 sem
+    // lock proprio:
+    //  - BeginStream: thread chamadora, uma vez, antes de qualquer outra.
+    //  - AcquireStaging: thread do worker (ou a chamadora, no modo serial). So aloca: devolve
+    //    memoria CPU-gravavel com TotalBytes() bytes que o pipeline preenche. Nao e chamada para
+    //    chunk de 0 bytes.
+    //  - SubmitChunk: thread chamadora, na ordem dos chunks, com o staging ja preenchido.
+    // A passagem de um chunk do worker para a chamadora e sincronizada pelo pipeline; o que
+    // AcquireStaging gravar no sink para o chunk i e visivel no SubmitChunk do chunk i.
+    class IGeometryUploadSink {
+    public:
+        virtual ~IGeometryUploadSink() = default;
+        virtual void BeginStream(std::span<const FGeometryChunk> Plan) { (void)Plan; }
+        virtual u8*  AcquireStaging(u32 ChunkIndex, const FGeometryChunk& Chunk) = 0;
+        virtual void SubmitChunk(u32 ChunkIndex, const FGeometryChunk& Chunk,
+                                 std::span<const FGeometrySlice> Slices) = 0;
+    };
+
+    struct FGeometryStreamOptions {
+        u64  ChunkBudget    = 256ull * 1024 * 1024;
+        // Teto de staging empacotado e ainda nao submetido. O worker espera antes de adquirir um
+        // chunk que estouraria o teto; com nada em voo ele segue mesmo assim (chunk maior que o
+        // teto nao trava o pipeline). Dois chunks e o minimo para haver sobreposicao.
+        u64  InFlightBudget = 512ull * 1024 * 1024;
+        bool Pipelined      = true; // false = empacota e submete na thread chamadora, em serie
+    };
+
+    struct FGeometryStreamStats {
+        u32    Chunks            = 0;
+        u64    Bytes             = 0;
+        u64    PeakInFlightBytes = 0;
+        double PackMs   = 0.0; // worker: AcquireStaging + copias + RT gerado
+        double SubmitMs = 0.0; // chamadora: SubmitChunk
+        double StallMs  = 0.0; // chamadora parada esperando o worker
+        double WallMs   = 0.0;
+    };
+
+    // Particiona os meshes em chunks de ate `ChunkBudget` bytes, na ordem recebida. Um mesh maior
+    // que o orcamento vira um chunk sozinho. O payload de RT ausente na view conta como
+    // IndexCount/3 registros — e o que ResolveRTTriangles vai gerar.
+    std::vector<FGeometryChunk> PlanGeometryChunks(std::span<const FMeshView> Meshes, u64 ChunkBudget);
+
+    // Empacota e entrega todos os meshes ao sink. Excecao de qualquer lado (sink ou empacotamento)
+    // para o worker e sai na thread chamadora; chunks ja submetidos continuam submetidos.
+    FGeometryStreamStats StreamGeometry(std::span<const FMeshView> Meshes, IGeometryUploadSink& Sink,
+                                        const FGeometryStreamOptions& Options = {});
+}
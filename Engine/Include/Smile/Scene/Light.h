@@ -14,8 +14,8 @@ namespace Smile {
     // superficie encostada na luz nao estoura a branco. Na F4 ele vira tambem o raio da fonte
     // p/ o especular de area (representative point).
     struct FLight {
-        // Identidade ESTAVEL da luz (0 = ainda nao atribuida; o renderer atribui no primeiro
-        // frame em que ve a luz). O indice na FScene::Lights() NAO serve: remover a luz 0
+        // Identidade ESTAVEL da luz (0 = ainda nao atribuida; o FScene::AddLight da uma, e o
+        // renderer garante a de quem entrou por fora). O indice na FScene::Lights() NAO serve: remover a luz 0
         // desloca todo mundo e duplicar copia o struct inteiro. Quem depende disso e o slot
         // persistente de shadow map — sem identidade, o slice era a posicao no ranking por
         // distancia e trocava sozinho quando a camera andava, o que impede cache do depth
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include "Smile/Math/Mat44.h"
+#include "Smile/Math/Vec3.h"
+#include "Smile/Math/Vec4.h"
+#include "Smile/Scene/CookedFormat.h"
+#include <span>
+#include <vector>
+
+// Clusters de triangulos da v10 (SMeshCluster): construcao no cooker e culling em CPU. Compilado
+// TAMBEM pelo SmileCooker, como o CookedCodec — so math e o formato, sem D3D12 nem estado global.
+//
+// Um cluster e uma faixa CONTIGUA do IB final. Nao reordena nada: o IB ja saiu do MeshOptimize
+// (triangulos vizinhos em sequencia, entao a faixa e espacialmente coesa) e o payload de RT e
+// posicional a ele. Quem desenha um subconjunto de clusters emite um draw por faixa
+// (StartIndex = FirstTriangle*3), e o BLAS continua o mesh inteiro.
+namespace Smile {
+    constexpr u32 kClusterMaxTriangles = 128u;
+    constexpr u32 kClusterMinTriangles = 64u; // so o unico cluster de um mesh pequeno fica abaixo
+
+    // Fatia `_Indices` (o IB FINAL, depois do weld, do winding e da reordenacao) em
+    // ceil(T/128) faixas de tamanho equilibrado — todas entre 64 e 128 triangulos quando T >= 64
+    // — e calcula os limites de cada uma. Substitui o conteudo de `_Out`.
+    void BuildMeshClusters(std::span<const Vertex> Vertices, std::span<const u32> Indices,
+                           std::vector<SMeshCluster>& Out);
+
+    // Vista de culling no espaco LOCAL do mesh: os clusters sao cozidos em local e sao
+    // compartilhados entre instancias, entao e a vista que vai ate eles, nao o contrario.
+    struct FClusterCullView {
+        Vec4 Planes[6]{}; // nao normalizados, mesma ordem do FFrameView::FrustumPlanes
+        Vec3 Eye{};
+        bool Backface = true; // false em material two-sided: o cone nao vale
+
+        // Planos extraidos de Model*ViewProj (row-vector) ja saem em espaco local; o olho vem da
+        // inversa do Model, que o chamador costuma ter em maos.
+        static FClusterCullView FromLocalToClip(const Mat44& LocalToClip, const Vec3& EyeLocal,
+                                                bool Backface = true);
+    };
+
+    struct FClusterCullStats {
+        u32 Tested        = 0;
+        u32 FrustumCulled = 0;
+        u32 ConeCulled    = 0;
+    };
+
+    // AABB inteiramente fora de algum plano. Conservador: a que atravessa conta como dentro.
+    bool ClusterOutsideFrustum(const SMeshCluster& Cluster, const Vec4 (&Planes)[6]);
+    // Todo triangulo do cluster esta de costas para `_Eye`, para qualquer ponto da esfera e
+    // qualquer normal do cone. ConeCutoff = 1 nunca passa.
+    bool ClusterBackfacing(const SMeshCluster& Cluster, const Vec3& Eye);
+
+    // Anexa a `_Visible` o indice (na span) de cada cluster que sobrevive; devolve quantos.
+    u32 CullMeshClusters(std::span<const SMeshCluster> Clusters, const FClusterCullView& View,
+                         std::vector<u32>& Visible, FClusterCullStats* Stats = nullptr);
+}
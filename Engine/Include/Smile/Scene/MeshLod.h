@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include "Smile/Scene/CookedFormat.h"
+#include <span>
+#include <vector>
+
+// Cadeia de LODs da v11 (SMeshLod): simplificacao no cooker e escolha do nivel em CPU. O cooker
+// compila este arquivo junto, entao nada aqui pode depender do renderer.
+//
+// Cada nivel e um IB proprio sobre o MESMO VB do mesh: o colapso de aresta leva um vertice para
+// cima de um vizinho que ja existe (half-edge collapse), entao nenhum vertice novo nasce e o VB,
+// o BLAS e o payload de RT continuam os do LOD0. O LOD0 e o proprio mesh e nao entra na regiao.
+namespace Smile {
+    constexpr u32 kMeshLodMaxLevels = 4u; // alem do LOD0
+    // Erro projetado aceito, em fracao da altura da tela (a unidade do Lod0ScreenSize do
+    // FTerrain): ~1 pixel a 1080p.
+    constexpr f32 kMeshLodDefaultScreenError = 1.0f / 1080.0f;
+
+    struct FMeshLodOptions {
+        u32 MaxLevels    = kMeshLodMaxLevels;
+        f32 Ratio        = 0.5f; // alvo de triangulos de cada nivel sobre o anterior
+        u32 MinTriangles = 64u;  // nao gera nivel a partir de um que ja esta abaixo disto
+        // Nivel que nao chega a MinReduction do anterior encerra a cadeia: a simplificacao
+        // empacou (vertices travados por costura/borda) e um nivel quase igual so gasta disco.
+        f32 MinReduction = 0.85f;
+    };
+
+    // Views dos niveis de um mesh sobre os bytes cozidos. Indices de Levels[k] =
+    // Indices.subspan(FirstIndex, IndexCount); o nivel k da span e o LOD k+1.
+    struct FMeshLodSet {
+        std::span<const SMeshLod> Levels;
+        std::span<const u32>      Indices;
+    };
+
+    // QEM (Garland e Heckbert 1997) com colapso para vertice existente. Vertices de COSTURA (mesma
+    // posicao que outro vertice do VB: UV, normal dura) e de BORDA aberta ficam travados — a
+    // silhueta e as ilhas de UV nao se mexem, ao preco de reduzir menos malhas muito recortadas.
+    // `_Indices` e o IB final (depois do MeshOptimize); Out* sao substituidos.
+    void BuildMeshLods(std::span<const Vertex> Vertices, std::span<const u32> Indices,
+                       std::vector<SMeshLod>& OutLevels, std::vector<u32>& OutIndices,
+                       const FMeshLodOptions& Options = {});
+
+    // Erro do nivel projetado na tela, em fracao da altura dela, a `_Distance` (espaco de mundo)
+    // com fov vertical `_FovYRadians`. `_Scale` leva o erro local do cozido para o mundo (maior
+    // eixo da escala da instancia).
+    f32 MeshLodScreenError(const SMeshLod& Level, f32 Distance, f32 FovYRadians, f32 Scale = 1.0f);
+
+    // LOD mais grosso cujo erro projetado cabe em `_MaxScreenError`: 0 = o mesh inteiro, k = os
+    // indices de `_Levels[k-1]`. Monotonico: mais longe, fov mais aberto ou escala menor nunca
+    // pedem nivel mais fino.
+    u32 SelectMeshLod(std::span<const SMeshLod> Levels, f32 Distance, f32 FovYRadians, f32 Scale = 1.0f,
+                      f32 MaxScreenError = kMeshLodDefaultScreenError);
+}
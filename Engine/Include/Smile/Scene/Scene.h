@@ -4,9 +4,14 @@
 #include "Smile/Graphics/Resources/GpuMesh.h"
 #include "Smile/Graphics/Resources/Material.h"
 #include "Smile/Scene/Light.h"
+#include "Smile/Scene/SceneBvh.h"
+#include "Smile/Scene/SceneHandles.h"
+#include "Smile/Scene/SceneHierarchy.h"
+#include "Smile/Scene/SceneHotData.h"
+#include "Smile/Scene/Transform.h"
 #include <memory>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace Smile {
@@ -32,36 +37,6 @@ namespace Smile {
         return RenderableCount + (Slack > 64u ? Slack : 64u);
     }
 
-    // Que TIPO de objeto um Id designa.
-    //
-    // O Id e unico em TODA a cena — mesh e luz saem do mesmo contador — mas as listas continuam
-    // separadas e densas, que e o que o renderer percorre por frame. Este enum e a ponte entre as
-    // duas coisas: o Id identifica, o Kind diz em qual lista procurar. Antes havia dois contadores
-    // independentes, entao o numero 5 existia nas duas listas e um Id sozinho nao identificava
-    // nada — quem quisesse guardar "este objeto" precisava carregar um par (tipo, indice) e todo
-    // consumidor precisava saber tratar os dois casos.
-    enum class ESceneObject : u8 { None = 0, Renderable, Light };
-
-    // Onde uma identidade mora AGORA. O Index e cache: vale ate a lista mudar, e depois disso so
-    // o Id continua valendo (e por isso que ele existe).
-    struct FSceneObjectRef {
-        u64          Id    = 0;
-        ESceneObject Kind  = ESceneObject::None;
-        u32          Index = 0;
-
-        bool IsValid()      const { return Id != 0 && Kind != ESceneObject::None; }
-        bool IsRenderable() const { return Kind == ESceneObject::Renderable; }
-        bool IsLight()      const { return Kind == ESceneObject::Light; }
-    };
-
-    struct FTransform {
-        Vec3 Position      = { 0.0f, 0.0f, 0.0f };
-        Vec3 RotationEuler = { 0.0f, 0.0f, 0.0f };
-        Vec3 Scale         = { 1.0f, 1.0f, 1.0f };
-
-        Mat44 Matrix() const;
-    };
-
     // Se o renderer pode assumir que este objeto estara no MESMO lugar no proximo frame.
     //
     // Nao e "ja foi movido alguma vez": um objeto arrastado no editor e depois solto volta a
@@ -86,7 +61,16 @@ namespace Smile {
         u64         Id = 0;
 
         std::string Name;
+        // Transform LOCAL, relativo ao Parent (raiz: e o de mundo). O editor edita e persiste em
+        // mundo (WorldTransform / FScene::SetWorldTransform), entao o .smap nao muda de sentido.
         FTransform  Transform;
+        // Indice do pai na lista viva (-1 = raiz). Do ParentIndex do cozido; a copia herda o da
+        // fonte (vira irma). Mudou? A cena precisa de um rebuild da hierarquia — hoje so o import
+        // e o RemoveRenderable escrevem aqui.
+        i32         Parent = -1;
+        // Matriz de MUNDO = local * mundo do pai. Cache mantido pela FScene (UpdateWorldTransforms):
+        // e o que TLAS, mesh lights e o cache SoA leem.
+        Mat44       World = Mat44::Identity();
         FGpuMesh*   Mesh     = nullptr;
         FMaterial*  Material = nullptr;
         bool        Visible  = true;
@@ -117,19 +101,33 @@ namespace Smile {
         // HiZ, sombras locais e chuva leem — por isso vive como cache aqui em vez de ser
         // recalculada por frame para milhares de objetos.
         //
-        // ⚠️ Quem muta o Transform TEM de chamar RefreshWorldBounds(). Antes da v7 dava para
-        // remendar (o gizmo so translada, e translacao desloca a caixa exatamente), mas com
-        // rotacao ou escala o remendo silenciosamente descreve outro volume.
+        // ⚠️ Quem muta o Transform TEM de avisar a cena (FScene::MarkTransformDirty): ela refaz o
+        // World e a caixa deste objeto e de toda a descendencia. Antes da v7 dava para remendar (o
+        // gizmo so translada, e translacao desloca a caixa exatamente), mas com rotacao ou escala
+        // o remendo silenciosamente descreve outro volume.
         Vec3        AABBMin  = { -1e9f, -1e9f, -1e9f };
         Vec3        AABBMax  = {  1e9f,  1e9f,  1e9f };
 
+        // Caixa de mundo a partir do World. Raiz recompoe o World do Transform antes (objeto
+        // avulso, fora de cena); filho usa o World em cache, que so a FScene sabe refazer.
         void RefreshWorldBounds();
+
+        // Transform de MUNDO em TRS: raiz devolve o proprio Transform (exato); filho decompoe o
+        // World em cache, valido depois do FScene::UpdateWorldTransforms.
+        FTransform WorldTransform() const {
+            return Parent < 0 ? Transform : FTransform::FromMatrix(World);
+        }
     };
 
     class FScene {
     public:
         FGpuMesh* AddMesh(ID3D12Device* Device, const FMesh& Mesh);
 
+        // Sobe os meshes em chunks de pool pelo pipeline de GeometryStream.h (um worker empacota o
+        // chunk seguinte enquanto este submete). A view pode apontar para um .smesh mapeado; os
+        // bytes so precisam viver ate o retorno (sao copiados para o staging aqui dentro).
+        std::vector<FGpuMesh*> AddMeshesBatch(ID3D12Device* Device, FUploadQueue& UploadQueue,
+                                              std::span<const FMeshView> Meshes);
         std::vector<FGpuMesh*> AddMeshesBatch(ID3D12Device* Device, FUploadQueue& UploadQueue,
                                               const std::vector<FMesh>& Meshes);
 
@@ -142,6 +140,9 @@ namespace Smile {
         // o caminho suportado com a cena carregada e Renderer::RemoveRenderable/DuplicateRenderable,
         // que fecham o ciclo do lado da GPU. A ordem dos sobreviventes e preservada.
         bool         RemoveRenderable(u64 Id);
+        // Remocao em massa: UMA compactacao da lista para o lote inteiro, em vez de um memmove da
+        // cauda por objeto. Id repetido, 0 ou que nao resolve e ignorado. Devolve quantos sairam.
+        u32          RemoveRenderables(std::span<const u64> Ids);
         FRenderable* DuplicateRenderable(u64 Id);
 
         FRenderable*       FindRenderable(u64 Id);
@@ -150,31 +151,44 @@ namespace Smile {
         u64                IdAt(u32 Index) const;           // 0 = fora da lista
 
         // ATENCAO: a referencia e mutavel para o renderer editar CAMPOS (transform, Visible) sem
-        // indirecao. push_back/erase por fora daqui deixa o mapa de Id podre — use os metodos
-        // acima. O que ainda faz push_back direto e a lista de LUZES, que tem indice proprio.
+        // indirecao. push_back/erase por fora daqui deixa a tabela de Id podre — use os metodos
+        // acima. Vale o mesmo para a lista de luzes.
         std::vector<FRenderable>&       Renderables()       { return RenderableList; }
         const std::vector<FRenderable>& Renderables() const { return RenderableList; }
 
+        // Mesmo contrato dos renderaveis: Id novo no add, erase estavel na remocao.
         FLight& AddLight(const FLight& Light);
+        bool    RemoveLight(u64 Id);
 
         std::vector<FLight>&       Lights()       { return LightList; }
         const std::vector<FLight>& Lights() const { return LightList; }
 
-        // Proxima identidade livre, COMUM a meshes e luzes. Nunca devolve 0 (0 = "sem
-        // identidade"). O editor faz push_back direto na lista de luzes, entao quem consome
-        // (renderer) atribui pra quem chegou com Id 0 — nao da pra centralizar tudo no AddLight.
-        u64 AllocObjectId() { return ++NextObjectId_; }
+        // Id da luz neste indice, registrando-a na tabela se chegou sem (Id 0). Rede de seguranca
+        // para luz que entrou na lista por fora do AddLight; o renderer chama antes de usar o Id.
+        u64 EnsureLightId(u32 Index);
 
         // Resolve uma identidade sem que o chamador precise saber de que tipo ela e. Devolve um
-        // ref invalido se o Id nao existe (inclusive para Id 0).
+        // ref invalido se o Id nao existe (inclusive para Id 0). O(1): ver SceneHandles.h.
         FSceneObjectRef FindObject(u64 Id) const;
 
         void Clear();
 
         // Versao dos transforms dos renderables — quem muta transform (gizmo do editor)
         // bumpa; o Renderer compara por frame p/ reconstruir SO a TLAS (BLAS intactos).
+        //
+        // O bump nao diz QUEM mudou, entao tambem marca o cache SoA inteiro como velho. Quem
+        // sabe o indice usa MarkTransformDirty, que bumpa igual e refaz so aquele objeto.
         u64  TransformsVersion() const { return TransformsVersion_; }
-        void BumpTransformsVersion()   { ++TransformsVersion_; }
+        void BumpTransformsVersion()   { ++TransformsVersion_; HotAllDirty_ = true; Hierarchy_.MarkAllDirty(); }
+
+        // Um renderavel mudou transform (e o chamador ja deu RefreshWorldBounds): bumpa a versao
+        // de transforms como o BumpTransformsVersion, mas o cache SoA refaz so este indice. E o
+        // caminho do gizmo, que roda a cada movimento do mouse durante o arraste.
+        // O World e a caixa dele e dos descendentes saem no proximo UpdateWorldTransforms.
+        void MarkTransformDirty(u32 Index) { Hierarchy_.MarkDirty(Index); ++TransformsVersion_; }
+        // So o cache SoA: para Visible/Mobility de UM objeto, quando o chamador cuida das
+        // versoes que a mudanca pede (mobilidade pede so a de casters estaticos).
+        void MarkHotDirty(u32 Index);
 
         // Versao da ESTRUTURA — muda quando a lista ganha ou perde um renderavel. Separada da
         // de transforms de proposito: aquela pede rebuild da TLAS (barato, por frame), esta pede
@@ -194,20 +208,81 @@ namespace Smile {
         u64  StaticCastersVersion() const { return StaticCastersVersion_; }
         void BumpStaticCastersVersion()   { ++StaticCastersVersion_; }
 
+        // Hierarquia de transforms (ver SceneHierarchy.h). Refaz a ordem se a estrutura mudou e
+        // recompoe World + caixa de quem foi marcado e da descendencia, marcando-os no cache SoA.
+        // O SyncHotData chama no topo; o editor chama direto quando precisa da caixa nova na hora
+        // (gizmo). Devolve se algum World mudou.
+        bool                    UpdateWorldTransforms();
+        const FSceneHierarchy&  Hierarchy() const { return Hierarchy_; }
+        // Poe o renderavel neste transform de MUNDO: converte para o local do pai e marca. Pai sob
+        // escala nao uniforme pode nao ter TRS local exato (ver FTransform::FromMatrix).
+        void                    SetWorldTransform(u32 Index, const FTransform& World);
+
+        // Cache SoA do que o laco de frame le (ver SceneHotData.h). SyncHotData refaz so os
+        // objetos marcados por MarkTransformDirty/MarkHotDirty; a lista inteira apenas quando a
+        // estrutura mudou ou alguem deu BumpTransformsVersion sem dizer quem. Tambem assenta o
+        // PrevWorld de quem se moveu no sync anterior — por isso o renderer chama UMA vez por
+        // frame, no topo, e o PrevWorld vale como "a matriz do frame anterior". Devolve se
+        // alguma entrada mudou. Hot() e valido ate a proxima mutacao.
+        bool                 SyncHotData();
+        const FSceneHotData& Hot() const { return Hot_; }
+        // BVH sobre Hot().BoundsMin/BoundsMax, para consultas pequenas fora das listas do frame:
+        // picking, luz pontual, vizinhos. O SyncHotData so anota o que mudou; a arvore e posta em
+        // dia na consulta (build se a estrutura mudou, refit de quem os syncs refizeram), entao
+        // frame sem consulta — o gizmo arrastando — nao paga por ela. Mesma validade do Hot().
+        const FSceneBvh&     Bvh();
+        // Picking de CPU pelo BVH, sem o readback do FObjectPicker: o renderavel desenhavel e
+        // visivel de caixa mais proxima ao longo do raio. Caixa, nao triangulo — serve para
+        // selecao grossa e ferramentas; ref invalido se nada acerta. Le o cache do ultimo sync.
+        FSceneObjectRef      PickRenderable(const Vec3& Origin, const Vec3& Dir);
+
+        // O que o ULTIMO sync com mudanca mexeu, para caches que vivem entre frames (as listas
+        // de draw do renderer). HotVersion sobe a cada SyncHotData que devolve true; quem viu a
+        // versao anterior aplica so o HotChanged (ou tudo, com HotChangedAll), quem pulou uma
+        // refaz tudo. Inclui quem so teve o PrevWorld assentado — o PrevMVP dele mudou.
+        u64                  HotVersion() const { return HotVersion_; }
+        bool                 HotChangedAll() const { return HotChangedAll_; }
+        std::span<const u32> HotChanged() const { return HotChanged_; }
+
     private:
-        void RebuildRenderableIndex();
+        // Re-ancora na tabela os indices [From, fim) da lista, depois de um deslocamento.
+        void ReanchorRenderables(u32 From);
+        void ReanchorLights(u32 From);
+        // Aplica no Bvh_ o que os syncs anotaram desde a ultima consulta.
+        void SyncBvh();
 
         std::vector<std::unique_ptr<FGpuMesh>> MeshLibrary;
         std::vector<FRenderable>               RenderableList;
         std::vector<FLight>                    LightList;
-        // Id -> indice em RenderableList. Reconstruido inteiro na remocao (a lista e densa e
-        // ordenada, entao remover desloca a cauda); no add so cresce. Custo O(n) so em acao de
-        // editor, nunca por frame — nada no caminho de frame consulta por Id.
-        std::unordered_map<u64, u32>           RenderableIndexById_;
+        // Id -> (tipo, indice denso) dos renderaveis E das luzes. Remover re-ancora so a cauda
+        // que andou; Clear solta tudo sem reciclar Id. Ver SceneHandles.h.
+        FSceneHandleTable                      Handles_;
         u64                                    TransformsVersion_ = 0;
         u64                                    StructureVersion_  = 0;
         u64                                    StaticCastersVersion_ = 0;
-        // UM contador para os dois tipos. Ver ESceneObject.
-        u64                                    NextObjectId_      = 0;
+        FSceneHotData                          Hot_;
+        FSceneBvh                              Bvh_;
+        FSceneHierarchy                        Hierarchy_;
+        // Estrutura com que a Hierarchy_ foi montada.
+        u64                                    HierarchyStructureVersion_ = 0;
+        // Estrutura com que o Hot_ foi montado. Comeca igual a da cena vazia, que e o que o
+        // Hot_ vazio descreve.
+        u64                                    HotStructureVersion_ = 0;
+        bool                                   HotAllDirty_         = false;
+        // Indices marcados desde o ultimo sync; o bit evita repetir o mesmo objeto quando o
+        // gizmo o marca varias vezes dentro de um frame.
+        std::vector<u32>                       HotDirty_;
+        std::vector<u8>                        HotDirtyBit_;
+        // Quem o sync anterior refez: no proximo, o PrevWorld deles alcanca o World.
+        std::vector<u32>                       HotMoved_;
+        bool                                   HotMovedAll_ = false;
+        // O que o Bvh_ deve desde a ultima consulta: build inteiro, refit inteiro ou so estes
+        // indices (com repeticao; passando de um quarto da cena vira refit inteiro).
+        bool                                   BvhBuildPending_ = false;
+        bool                                   BvhRefitAll_     = false;
+        std::vector<u32>                       BvhMoved_;
+        u64                                    HotVersion_    = 0;
+        std::vector<u32>                       HotChanged_;
+        bool                                   HotChangedAll_ = false;
     };
 }
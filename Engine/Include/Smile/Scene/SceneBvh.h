@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Math/Vec3.h"
+#include "Smile/Scene/FrustumCull.h"
+#include <functional>
+#include <span>
+#include <vector>
+
+// BVH de CPU sobre as caixas de mundo dos renderaveis, para as consultas espaciais fora do laco
+// de frame: frustum, esfera (raio de luz pontual), raio (picking sem o readback do FObjectPicker)
+// e k vizinhos mais proximos.
+//
+// O FrustumCull.h e a resposta para LISTAS do frame (passada linear em SIMD, que ja e o melhor que
+// da quando a maioria das caixas passa). Aqui e o caso oposto: a consulta e pequena perto da cena
+// — uma esfera de 10 m numa cidade de 100k objetos — e a varredura paga a cena inteira para achar
+// dezenas. O BVH desce so pelos nos que tocam a consulta.
+//
+// Primitiva = indice da caixa na lista de entrada (na FScene, o indice do renderavel). As caixas
+// sao COPIADAS no Build/Refit: a arvore nao aponta para o cache de ninguem. As folhas usam os
+// testes escalares do FrustumCull.h (AABBOutsideFrustum/AABBTouchesSphere), entao frustum e esfera
+// devolvem EXATAMENTE o que a varredura devolveria, na mesma ordem (indices crescentes).
+//
+// Quem mantem e a FScene, na primeira consulta depois do SyncHotData: Build quando a ESTRUTURA
+// muda (os indices andaram), Refit quando so transforms mudaram. O refit mantem a topologia — o
+// SAH vai se degradando se os objetos viajam longe, e o proximo rebuild estrutural o recompoe.
+namespace Smile {
+    struct FBvhNode {
+        Vec3 Min;
+        u32  First = 0; // folha: primeiro item em PrimIndices; interno: filho esquerdo (o direito e First + 1)
+        Vec3 Max;
+        u32  Count = 0; // itens na folha; 0 = no interno
+        bool IsLeaf() const { return Count > 0; }
+    };
+
+    struct FBvhRayHit {
+        static constexpr u32 kNone = 0xFFFFFFFFu;
+        u32 Index = kNone;
+        f32 T     = 0.0f; // distancia de entrada na caixa, em unidades de Dir (0 = origem dentro)
+        bool Hit() const { return Index != kNone; }
+    };
+
+    // Filtro opcional das consultas de raio e vizinhos: false descarta o indice (ex.: invisivel).
+    using FBvhFilter = std::function<bool(u32 Index)>;
+
+    class FSceneBvh {
+    public:
+        // Ate 4 caixas por folha; acima disso o split por SAH (16 baldes) sempre compensa.
+        static constexpr u32 kMaxLeafSize = 4;
+
+        // Arvore nova sobre as caixas [0, Min.size()). Caixa invertida (Min > Max) entra como esta:
+        // nenhum teste a aceita, igual a varredura.
+        void Build(std::span<const Vec3> Min, std::span<const Vec3> Max);
+
+        // Topologia mantida, caixas trocadas. Sem `Moved`, todas as caixas e todos os nos. Com ela,
+        // so os indices listados: cada um sobe da sua folha ate a raiz e para no primeiro no que
+        // nao mudou — lista vazia nao toca nada. Os spans tem de ter o MESMO tamanho do Build.
+        void Refit(std::span<const Vec3> Min, std::span<const Vec3> Max);
+        void Refit(std::span<const Vec3> Min, std::span<const Vec3> Max, std::span<const u32> Moved);
+
+        void Clear();
+
+        size_t Size() const { return PrimMin.size(); }
+        bool   Empty() const { return Nodes.empty(); }
+        std::span<const FBvhNode> NodeList() const { return Nodes; }
+        // Nos recalculados pelos Refit desde o ultimo Build: mede o quanto o refit parcial poupa.
+        u64 RefitNodeCount() const { return RefitNodes; }
+
+        // `Out` e substituido pelos indices crescentes que nao estao fora do frustum / que tocam a
+        // esfera — a mesma lista do CullFrustums/CullSphere sobre as mesmas caixas.
+        void QueryFrustum(const FCullFrustum& View, std::vector<u32>& Out) const;
+        void QuerySphere(const Vec3& Center, f32 Radius, std::vector<u32>& Out) const;
+
+        // Caixa mais proxima ao longo do raio (Dir nao precisa ser unitario), ate MaxT. Empate de T
+        // fica com o menor indice, como a varredura.
+        FBvhRayHit Raycast(const Vec3& Origin, const Vec3& Dir, f32 MaxT = 3.0e38f,
+                           const FBvhFilter& Filter = {}) const;
+
+        // Os K indices de caixa mais proxima do ponto (distancia ponto-caixa; 0 dentro), do mais
+        // perto para o mais longe; empate pelo indice. `Out` e substituido (menos de K se a cena,
+        // ou o filtro, nao tem K).
+        void KNearest(const Vec3& Point, u32 K, std::vector<u32>& Out, const FBvhFilter& Filter = {}) const;
+
+    private:
+        void RefitNode(u32 Node);
+
+        std::vector<FBvhNode> Nodes;       // raiz em 0; filhos sempre depois do pai
+        std::vector<u32>      PrimIndices; // folha -> [First, First + Count)
+        std::vector<u32>      Parent;      // por no; a raiz aponta para si
+        std::vector<u32>      LeafOf;      // por indice de caixa
+        std::vector<Vec3>     PrimMin;
+        std::vector<Vec3>     PrimMax;
+        u64                   RefitNodes = 0;
+    };
+}
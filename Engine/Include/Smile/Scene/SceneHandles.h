@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <vector>
+
+// Identidade dos objetos de cena: tabela de handles geracionais (slot map).
+//
+// O Id era um contador puro, e achar o objeto pedia um unordered_map<u64,u32> refeito inteiro a
+// cada remocao (e as luzes nem isso: varredura linear). Apagar 5k objetos de uma vez custava
+// O(n^2) so de mapa. Aqui o Id CARREGA o endereco: os 32 bits de baixo sao o slot na tabela, os
+// 32 de cima a geracao do slot. Resolver e um acesso ao vetor + comparar a geracao; remover
+// devolve o slot para a lista livre com a geracao avancada, entao o Id antigo deixa de resolver
+// e o proximo dono do slot nasce com Id diferente.
+//
+// As listas da cena continuam densas e na mesma ordem — o slot guarda o indice DENSO atual, e
+// quem desloca a lista re-ancora quem andou (SetIndex). A geracao comeca em 1, entao nenhum Id e
+// 0; slot cuja geracao daria a volta e aposentado, entao um Id nunca se repete na sessao.
+namespace Smile {
+    // Que TIPO de objeto um Id designa.
+    //
+    // O Id e unico em TODA a cena — mesh e luz saem da mesma tabela — mas as listas continuam
+    // separadas e densas, que e o que o renderer percorre por frame. Este enum e a ponte entre as
+    // duas coisas: o Id identifica, o Kind diz em qual lista procurar. Antes havia dois contadores
+    // independentes, entao o numero 5 existia nas duas listas e um Id sozinho nao identificava
+    // nada — quem quisesse guardar "este objeto" precisava carregar um par (tipo, indice) e todo
+    // consumidor precisava saber tratar os dois casos.
+    enum class ESceneObject : u8 { None = 0, Renderable, Light };
+
+    // Onde uma identidade mora AGORA. O Index e cache: vale ate a lista mudar, e depois disso so
+    // o Id continua valendo (e por isso que ele existe).
+    struct FSceneObjectRef {
+        u64          Id    = 0;
+        ESceneObject Kind  = ESceneObject::None;
+        u32          Index = 0;
+
+        bool IsValid()      const { return Id != 0 && Kind != ESceneObject::None; }
+        bool IsRenderable() const { return Kind == ESceneObject::Renderable; }
+        bool IsLight()      const { return Kind == ESceneObject::Light; }
+    };
+
+    class FSceneHandleTable {
+    public:
+        static u32 SlotOf(u64 Id)       { return static_cast<u32>(Id); }
+        static u32 GenerationOf(u64 Id) { return static_cast<u32>(Id >> 32); }
+
+        // Id novo para um objeto deste tipo no indice denso Index. Reusa o slot livre mais
+        // recente; nunca devolve 0.
+        u64  Allocate(ESceneObject Kind, u32 Index);
+        // O Id deixa de resolver. Falso se ja nao resolvia.
+        bool Release(u64 Id);
+        // Solta todos os vivos (Clear da cena). As geracoes avancam: nenhum Id de antes volta.
+        void ReleaseAll();
+
+        // Ref invalido para Id 0, de outro slot ou de geracao velha.
+        FSceneObjectRef Resolve(u64 Id) const {
+            const u32 Slot = SlotOf(Id);
+            if (Slot >= Slots_.size()) return {};
+            const FSlot& S = Slots_[Slot];
+            if (S.Kind == ESceneObject::None || S.Generation != GenerationOf(Id)) return {};
+            return { Id, S.Kind, S.Index };
+        }
+        // O objeto andou na lista densa. Id que nao resolve e ignorado.
+        void SetIndex(u64 Id, u32 Index) {
+            const u32 Slot = SlotOf(Id);
+            if (Slot < Slots_.size() && Slots_[Slot].Kind != ESceneObject::None &&
+                Slots_[Slot].Generation == GenerationOf(Id))
+                Slots_[Slot].Index = Index;
+        }
+
+        u32 LiveCount() const { return Live_; }
+        // Slots ja criados (vivos + livres + aposentados): o tamanho da tabela, nao da cena.
+        u32 SlotCount() const { return static_cast<u32>(Slots_.size()); }
+
+    private:
+        static constexpr u32 kNoSlot = 0xFFFFFFFFu;
+
+        struct FSlot {
+            u32          Generation = 1;
+            // Vivo: indice denso. Livre: proximo slot livre (kNoSlot = fim).
+            u32          Index      = 0;
+            ESceneObject Kind       = ESceneObject::None;
+        };
+
+        void Free(u32 Slot);
+
+        std::vector<FSlot> Slots_;
+        u32                FreeHead_ = kNoSlot;
+        u32                Live_     = 0;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Math/Math.h"
+#include <span>
+#include <vector>
+
+// Hierarquia de transforms dos renderaveis: pai por indice, matriz local, matriz de mundo em cache.
+//
+// O cozido grava o ParentIndex desde a v7, mas o runtime tratava todo transform como mundo — mover
+// um no no editor nao levava os filhos. Aqui os nos ficam em ORDEM DE LARGURA (raizes, depois os
+// filhos delas, depois os netos...): todo pai vem antes dos filhos, e os filhos de um no sao
+// vizinhos. Local e mundo moram nessa mesma ordem, entao o update e UM laco para a frente — o
+// mundo do pai ja esta pronto quando o filho chega, e le o pai de uma posicao anterior do mesmo
+// vetor.
+//
+// Incremental: so quem teve o local marcado (MarkDirty) recompoe o local; o filho de quem mudou
+// recompoe so o mundo, com o local em cache. O laco comeca na primeira posicao suja e para depois
+// do ultimo filho de quem mudou — mover um no anda pela subarvore dele, nao pela cena.
+//
+// Indexado pelo indice da lista viva (como o FSceneHotData). Quem mantem e a FScene: Build quando a
+// estrutura muda, Update no topo do frame e sempre que o editor precisa do mundo na hora.
+namespace Smile {
+    class FSceneHierarchy {
+    public:
+        static constexpr i32 kRoot = -1;
+
+        // Ordem nova sobre Parents (indice do pai; kRoot = raiz). Pai fora da lista, o proprio no
+        // ou um ciclo viram raiz — ParentOf devolve o pai saneado. Tudo fica sujo.
+        void Build(std::span<const i32> Parents);
+        void Clear();
+
+        u32 Size() const { return static_cast<u32>(Index_.size()); }
+        i32 ParentOf(u32 Index) const { return Parent_[Index]; }
+        // Indices de cena em ordem de largura.
+        std::span<const u32> Order() const { return Index_; }
+        // Profundidade do no (raiz = 0).
+        u32 DepthOf(u32 Index) const { return Depth_[PosOf_[Index]]; }
+
+        // O local deste indice mudou. Indice que a ordem nao conhece (a lista cresceu desde o
+        // Build) e ignorado: o proximo Build cobre.
+        void MarkDirty(u32 Index);
+        void MarkAllDirty();
+        bool HasDirty() const { return FirstDirty_ < Size(); }
+
+        // Recompoe o mundo de quem foi marcado e de toda a descendencia, em ordem de largura.
+        // `LocalOf(Index) -> Mat44` so e chamado para os marcados. Devolve os indices cujo mundo
+        // mudou, pais antes dos filhos; vale ate a proxima chamada.
+        template <typename FLocalOf>
+        std::span<const u32> Update(FLocalOf&& LocalOf);
+
+        const Mat44& World(u32 Index) const { return World_[PosOf_[Index]]; }
+        const Mat44& Local(u32 Index) const { return Local_[PosOf_[Index]]; }
+
+    private:
+        static constexpr u32 kNone = 0xFFFFFFFFu;
+
+        // Por posicao na ordem de largura.
+        std::vector<u32>   Index_;     // indice de cena
+        std::vector<i32>   ParentPos_; // posicao do pai; kRoot = raiz
+        std::vector<u32>   ChildEnd_;  // uma alem do ultimo filho (= a propria posicao + 1 sem filhos)
+        std::vector<u32>   Depth_;
+        std::vector<Mat44> Local_;
+        std::vector<Mat44> World_;
+        // 1 = local marcado; durante o Update vira "mundo mudou", que e o que os filhos consultam.
+        std::vector<u8>    Dirty_;
+        // Por indice de cena.
+        std::vector<u32>   PosOf_;
+        std::vector<i32>   Parent_;
+
+        u32                FirstDirty_ = kNone;
+        u32                EndDirty_   = 0; // uma alem da ultima posicao marcada
+        std::vector<u32>   Changed_;
+    };
+
+    template <typename FLocalOf>
+    std::span<const u32> FSceneHierarchy::Update(FLocalOf&& LocalOf) {
+        Changed_.clear();
+        if (!HasDirty()) return {};
+        // Ate onde alguem pode ter mudado: a ultima marcada, ou o ultimo filho de quem mudou.
+        u32 End = EndDirty_;
+        for (u32 p = FirstDirty_; p < End; ++p) {
+            const i32 Pp = ParentPos_[p];
+            if (Dirty_[p]) Local_[p] = LocalOf(Index_[p]);
+            else if (Pp == kRoot || !Dirty_[Pp]) continue;
+            World_[p] = Pp == kRoot ? Local_[p] : Local_[p] * World_[Pp];
+            Dirty_[p] = 1;
+            if (ChildEnd_[p] > End) End = ChildEnd_[p];
+            Changed_.push_back(Index_[p]);
+        }
+        for (const u32 i : Changed_) Dirty_[PosOf_[i]] = 0;
+        FirstDirty_ = kNone;
+        EndDirty_   = 0;
+        return Changed_;
+    }
+}
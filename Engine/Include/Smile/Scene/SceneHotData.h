@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Math/Math.h"
+#include <vector>
+
+// Dados QUENTES dos renderaveis em SoA: o que o laco de frame le de cada objeto, e nada mais.
+//
+// O FRenderable e um struct gordo (~160 B: nome em std::string, transform em Euler, ponteiros,
+// flags, duas caixas) e o BuildDrawLists varria um por um so para chamar Transform.Matrix() — tres
+// pares sin/cos e quatro produtos 4x4 por objeto por frame, com a camera parada e nada se mexendo.
+// Aqui a matriz de mundo ja vem pronta e cada campo mora num vetor proprio: o laco que so quer
+// bounds (HiZ, frustum) nao puxa matriz para o cache, e o que so quer flags nao puxa nenhum dos
+// dois.
+//
+// E um CACHE, e a fonte continua sendo o FRenderable. Quem o mantem e a FScene (SyncHotData), e o
+// contrato e o que ja valia para a TLAS: quem muta transform, Visible ou Mobility avisa a cena —
+// MarkTransformDirty/MarkHotDirty quando sabe o indice (so ele e refeito), BumpTransformsVersion
+// quando nao sabe (tudo e refeito). Cena importada e estatica: sem edicao, nenhuma matriz e
+// recalculada. Indexado pelo indice da lista viva, como tudo que o renderer usa por frame.
+namespace Smile {
+    constexpr u8 kHotVisible  = 1u << 0; // FRenderable::Visible
+    // Tem mesh e nao e RaytracingOnly. O FGpuMesh::IsValid() fica com quem desenha: a FScene nunca
+    // desreferencia o mesh.
+    constexpr u8 kHotDrawable = 1u << 1;
+    constexpr u8 kHotDynamic  = 1u << 2; // Mobility == Dynamic
+
+    struct FSceneHotData {
+        std::vector<Mat44> World;     // FRenderable::World (local * mundo do pai)
+        // World do frame anterior (do sync anterior): igual ao World em todo objeto que nao se
+        // moveu. E o "modelo anterior" do motion vector e do PrevMVP.
+        std::vector<Mat44> PrevWorld;
+        std::vector<Vec3>  BoundsMin; // FRenderable::AABBMin (mundo)
+        std::vector<Vec3>  BoundsMax; // FRenderable::AABBMax (mundo)
+        std::vector<u8>    Flags;     // kHot*
+
+        size_t Size() const { return Flags.size(); }
+
+        void Resize(size_t Count) {
+            World.resize(Count);
+            PrevWorld.resize(Count);
+            BoundsMin.resize(Count);
+            BoundsMax.resize(Count);
+            Flags.resize(Count);
+        }
+
+        // Objeto que entra nas listas de raster (visivel e desenhavel).
+        bool IsDrawCandidate(size_t Index) const {
+            constexpr u8 kWant = kHotVisible | kHotDrawable;
+            return (Flags[Index] & kWant) == kWant;
+        }
+    };
+}
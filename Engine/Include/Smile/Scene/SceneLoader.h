@@ -1,14 +1,38 @@
 #pragma once
 
+#include "Smile/Core/MappedFile.h"
+#include "Smile/Core/TaskPool.h"
 #include "Smile/Graphics/Resources/Mesh.h"
 #include "Smile/Graphics/Resources/Texture.h"
 #include "Smile/Scene/CookedFormat.h"
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace Smile {
+    // De onde vem a geometria que as views do FSceneImportResult apontam.
+    //
+    // Mapped e o default: o .smesh e mapeado e as views apontam direto para as paginas do arquivo,
+    // entao o blob so existe UMA vez em memoria antes do staging (e em paginas que o sistema pode
+    // descartar). Buffered le o arquivo inteiro num buffer proprio — mesmas views, mesma validacao;
+    // serve para midia onde mapear nao compensa (rede) e para comparar as duas medidas.
+    enum class ECookedGeometrySource : u8 { Mapped, Buffered };
+
+    struct FSceneLoadOptions {
+        ECookedGeometrySource Geometry = ECookedGeometrySource::Mapped;
+        // Texturas DDS sobem so com a cauda — as mips com o maior lado <= este valor — e o resto
+        // vem sob demanda pelo FTextureStreamer. 0 = DDS inteiras no load, sem streaming.
+        u32 StreamedTailDimension = 128;
+        // A cauda nunca comeca depois desta mip do arquivo. A cauda e a copia que o RT amostra (o
+        // streaming so troca a do raster), num LOD fixo contado da mip 0 do arquivo
+        // (Reflections/ReSTIRGI AlbedoLOD = 2); o InstanceGeo desconta a FirstMip de cada mapa, entao
+        // ate aqui o LOD sai exato. Mais alto economiza VRAM e os hits leem a mip de cima da cauda,
+        // mais grossa que a pedida (0xFFFFFFFF = so a StreamedTailDimension).
+        u32 StreamedMaxTailMip = 2;
+    };
+
     // Dados CPU prontos para o Renderer criar os recursos GPU da cena.
     struct FSceneImportResult {
         std::filesystem::path BasePath;
@@ -22,15 +46,35 @@ namespace Smile {
         std::vector<SMeshEntry>       MeshEntries;
         std::vector<std::string>      TexturePaths;
         std::vector<FTextureCPUData>  TextureData;
-        std::vector<FMesh>            Meshes;
 
+        // Uma view por SMeshEntry, sobre os bytes de GeometryFile. Nao ha copia por mesh: o
+        // AddMeshesBatch le daqui direto para o staging. O resultado e dono do arquivo, entao as
+        // views valem enquanto ele viver.
+        std::shared_ptr<const FMappedFile> GeometryFile;
+        std::vector<FMeshView>             Meshes;
+        // Storage dos meshes com bloco codificado (v9), indexado como MeshEntries; vazio se a cena
+        // nao tem nenhum. As views desses meshes apontam para ca, nao para o arquivo.
+        std::vector<FMesh>                 DecodedMeshes;
+        // v10: clusters de cada mesh (MeshClusters.h), sempre views sobre GeometryFile — mesmo
+        // os de mesh codificado, que ficam fora do bloco. Espaco local, como o mesh.
+        std::vector<std::span<const SMeshCluster>> MeshClusters;
+        // Unidades de UV por unidade local de cada mesh (MeshUvDensity), indexado como
+        // MeshEntries. So com streaming (FSceneLoadOptions::StreamedTailDimension); senao 0.
+        std::vector<f32>                           MeshUvDensity;
+
+        // ReadMs: abrir/mapear e o parse das tabelas. DecodeMs: parede do lote no FTaskPool
+        // (texturas + validacao/decode dos meshes). MeshMs: soma das tarefas de mesh, em todas as
+        // threads — maior que a parede quando paraleliza.
         double ReadMs    = 0.0;
         double DecodeMs  = 0.0;
         double MeshMs    = 0.0;
         double PrepareMs = 0.0;
+        // Uma por tarefa do lote (meshes, depois texturas), com custo estimado, thread e tempo.
+        std::vector<FLoadTaskTiming> TaskTimings;
     };
 
     using FSceneImportResultPtr = std::shared_ptr<FSceneImportResult>;
 
-    FSceneImportResultPtr LoadCookedSceneData(const std::wstring& ScenePath);
+    FSceneImportResultPtr LoadCookedSceneData(const std::wstring& ScenePath,
+                                              const FSceneLoadOptions& Options = {});
 }
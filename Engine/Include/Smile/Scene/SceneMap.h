@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Camada autorada da cena (<cena>.smap) em formato binario. O SceneDocument do editor e o dono do
+// arquivo e de quando ele e lido/gravado; aqui fica so o formato — sem Qt, sem FScene — para que
+// um teste CPU o exercite e meca com 1M de overrides.
+//
+// A v1 do .smap era um QJsonDocument: tanto o save quanto o Apply montavam um DOM com um objeto
+// por renderavel editado, e com milhares de copias/movimentos isso virava soluco visivel. A v2 e
+// um header e tres tabelas de registros fixos, chaveados por CookedIndex como antes; o parse so
+// valida tamanhos e devolve views sobre os bytes, e o Apply percorre os registros numa passada.
+// O JSON continua existindo como EXPORTACAO (SceneMapToJson), no schema da v1, para diff e
+// revisao — e o editor ainda le um .smap v1 antigo.
+namespace Smile {
+    constexpr u32 kSMapMagic   = 0x50414D53u; // "SMAP"
+    constexpr u32 kSMapVersion = 2u;          // v2: binario. v1 era o JSON (sem magic).
+
+    constexpr u32 kSMapHidden    = 1u << 0; // Visible = false
+    constexpr u32 kSMapDynamic   = 1u << 1; // Mobility = Dynamic
+    constexpr u32 kSMapTransform = 1u << 2; // Position/Rotation/Scale valem (senao, o cozido fica)
+
+    struct SSceneMapHeader {
+        u32 Magic;   // kSMapMagic
+        u32 Version; // kSMapVersion
+        u32 OverrideCount;
+        u32 SpawnCount;
+        u32 DeletedCount;
+        u32 NameBytes; // blob de nomes dos criados, UTF-8 sem terminador, no fim do arquivo
+    };
+    static_assert(sizeof(SSceneMapHeader) == 24, "SSceneMapHeader e formato persistido: 24 B");
+
+    // Edicao sobre um renderavel que veio do asset.
+    struct SSceneMapOverride {
+        i32 Cooked; // FRenderable::CookedIndex
+        u32 Flags;  // kSMap*
+        f32 Position[3];
+        f32 Rotation[3]; // Euler, radianos (FTransform::RotationEuler)
+        f32 Scale[3];
+    };
+    static_assert(sizeof(SSceneMapOverride) == 44, "SSceneMapOverride e formato persistido: 44 B");
+
+    // Objeto criado no editor: copia de `From`, com transform e nome proprios. O save do editor
+    // sempre grava o transform; sem kSMapTransform (mapa v1 sem "pos") a copia fica com o da
+    // fonte. Nome vazio idem.
+    struct SSceneMapSpawn {
+        i32 From;
+        u32 Flags;
+        f32 Position[3];
+        f32 Rotation[3];
+        f32 Scale[3];
+        u32 NameOffset; // em bytes, dentro do blob de nomes
+        u32 NameLength;
+    };
+    static_assert(sizeof(SSceneMapSpawn) == 52, "SSceneMapSpawn e formato persistido: 52 B");
+
+    // Views sobre os bytes recebidos por ParseSceneMap: valem enquanto eles viverem.
+    struct FSceneMapView {
+        std::span<const SSceneMapOverride> Overrides;
+        std::span<const SSceneMapSpawn>    Spawned;
+        std::span<const i32>               Deleted;
+        std::string_view                   Names;
+
+        std::string_view NameOf(const SSceneMapSpawn& Spawn) const {
+            return Names.substr(Spawn.NameOffset, Spawn.NameLength);
+        }
+    };
+
+    // Mapa em construcao (save do editor, conversao de um .smap v1, testes). View() aponta para
+    // os vetores daqui, com o mesmo formato que o parse de um arquivo devolveria.
+    struct FSceneMap {
+        std::vector<SSceneMapOverride> Overrides;
+        std::vector<SSceneMapSpawn>    Spawned;
+        std::vector<i32>               Deleted;
+        std::string                    Names;
+
+        // Preenche NameOffset/NameLength de `_Spawn` e anexa o nome ao blob.
+        void AddSpawn(SSceneMapSpawn Spawn, std::string_view Name);
+        FSceneMapView View() const { return { Overrides, Spawned, Deleted, Names }; }
+    };
+
+    std::vector<u8> EncodeSceneMap(const FSceneMapView& Map);
+
+    // O arquivo e um .smap v2 (o magic bate)? Quem nao for e tratado como o JSON da v1.
+    bool IsBinarySceneMap(std::span<const u8> Bytes);
+
+    // false + mensagem em `Error` para magic/versao errados, tabela truncada ou desalinhada, ou
+    // nome fora do blob. O CONTEUDO nao e validado aqui: CookedIndex que nao existe mais na cena e
+    // legitimo (o asset mudou) e quem aplica ignora.
+    bool ParseSceneMap(std::span<const u8> Bytes, FSceneMapView& Out, std::string& Error);
+
+    // JSON indentado no schema da v1 ("version": 1, overrides/spawned/deleted). Floats no menor
+    // texto que volta ao MESMO float: exportar e reimportar pela v1 nao perde nada.
+    std::string SceneMapToJson(const FSceneMapView& Map);
+
+    // CookedIndex -> posicao na lista viva, em tabela densa. O cozido numera os renderaveis de 0
+    // a N-1, entao um vetor substitui o hash da v1 — uma leitura por override, sem colisao nem
+    // alocacao por entrada.
+    class FCookedIndexMap {
+    public:
+        void Reset(u32 CookedCount) { Live.assign(CookedCount, -1); }
+        void Set(i32 Cooked, i32 LiveIndex) {
+            if (Cooked < 0) return;
+            if (static_cast<size_t>(Cooked) >= Live.size()) Live.resize(static_cast<size_t>(Cooked) + 1, -1);
+            Live[static_cast<size_t>(Cooked)] = LiveIndex;
+        }
+        // -1 = o asset nao tem (ou nao tem mais) este renderavel.
+        i32 Find(i32 Cooked) const {
+            return Cooked >= 0 && static_cast<size_t>(Cooked) < Live.size() ? Live[static_cast<size_t>(Cooked)] : -1;
+        }
+
+    private:
+        std::vector<i32> Live;
+    };
+}
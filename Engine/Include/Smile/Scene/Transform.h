@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Smile/Math/Math.h"
+
+namespace Smile {
+    // Fora do Scene.h para que o que so precisa do transform (o cache SoA da FScene, testes CPU)
+    // nao arraste o D3D12 junto.
+    struct FTransform {
+        Vec3 Position      = { 0.0f, 0.0f, 0.0f };
+        Vec3 RotationEuler = { 0.0f, 0.0f, 0.0f };
+        Vec3 Scale         = { 1.0f, 1.0f, 1.0f };
+
+        // Tres pares sin/cos e quatro produtos 4x4: caro o bastante para nao ser chamado por
+        // objeto por frame — o caminho de frame le FScene::Hot().World.
+        Mat44 Matrix() const {
+            const Mat44 S = Mat44::Scale(Scale);
+            const Mat44 R = Mat44::RotationEulerXYZ(RotationEuler);
+            const Mat44 T = Mat44::Translation(Position);
+            return S * R * T;
+        }
+
+        // Inverso do Matrix() para matriz S*R*T sem cisalhamento (escala por eixo, rotacao,
+        // translacao). Espelho vai para o sinal da escala X. Matriz com cisalhamento — escala nao
+        // uniforme de um pai sob rotacao do filho — nao tem TRS exato: sai a aproximacao, e quem
+        // precisa saber confere recompondo.
+        static FTransform FromMatrix(const Mat44& M) {
+            FTransform Out;
+            Out.Position = { M.M[3][0], M.M[3][1], M.M[3][2] };
+            Vec3 Rows[3] = { M.GetRow3(0), M.GetRow3(1), M.GetRow3(2) };
+            f32 S[3] = { Rows[0].Length(), Rows[1].Length(), Rows[2].Length() };
+            if (Rows[0].Dot(Rows[1].Cross(Rows[2])) < 0.0f) S[0] = -S[0];
+            Mat44 R = Mat44::Identity();
+            for (int i = 0; i < 3; ++i) {
+                const Vec3 Axis = std::fabs(S[i]) > 1e-12f ? Rows[i] / S[i] : Vec3{};
+                R.M[i][0] = Axis.X; R.M[i][1] = Axis.Y; R.M[i][2] = Axis.Z;
+            }
+            Out.RotationEuler = R.ToEulerXYZ();
+            Out.Scale = { S[0], S[1], S[2] };
+            return Out;
+        }
+    };
+}
@@ -0,0 +1,81 @@
+#include "Smile/Core/JobSystem.h"
+
+namespace Smile {
+    thread_local bool FJobSystem::InsideJob = false;
+
+    u32 FJobSystem::DefaultWorkerCount() {
+        const u32 Hw = std::thread::hardware_concurrency();
+        // Acima de 16 threads o laco de frame ja e dominado pela juncao serial e pela banda.
+        return Hw > 1 ? std::min(Hw - 1, 15u) : 0u;
+    }
+
+    FJobSystem::FJobSystem(u32 _WorkerCount) {
+        const u32 N = _WorkerCount ? _WorkerCount : DefaultWorkerCount();
+        Workers.reserve(N);
+        for (u32 i = 0; i < N; ++i) Workers.emplace_back([this] { WorkerMain(); });
+    }
+
+    FJobSystem::~FJobSystem() {
+        {
+            std::lock_guard Lock(Mutex);
+            Quit = true;
+        }
+        WakeCv.notify_all();
+        for (std::thread& T : Workers) T.join();
+    }
+
+    void FJobSystem::Dispatch(u32 _Count, u32 _Grain, u32 _Chunks, FInvoke _Invoke, void* _Ctx) {
+        std::lock_guard Serial(DispatchMutex);
+        {
+            // Worker atrasado do job anterior ainda pode estar lendo os campos: espera ele sair.
+            std::unique_lock Lock(Mutex);
+            IdleCv.wait(Lock, [this] { return Active == 0; });
+            Invoke = _Invoke;
+            Ctx    = _Ctx;
+            Count  = _Count;
+            Grain  = _Grain;
+            Chunks = _Chunks;
+            NextChunk.store(0, std::memory_order_relaxed);
+            ++Generation;
+        }
+        WakeCv.notify_all();
+
+        InsideJob = true;
+        RunChunks();
+        InsideJob = false;
+
+        // Quem chama so sai do RunChunks com todos os chunks PEGOS; os que estao com um worker
+        // terminam antes de ele decrementar Active.
+        std::unique_lock Lock(Mutex);
+        IdleCv.wait(Lock, [this] { return Active == 0; });
+    }
+
+    void FJobSystem::RunChunks() {
+        for (;;) {
+            const u32 C = NextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (C >= Chunks) return;
+            const u32 Begin = C * Grain;
+            Invoke(Ctx, C, Begin, std::min(Count, Begin + Grain));
+        }
+    }
+
+    void FJobSystem::WorkerMain() {
+        InsideJob = true;
+        u64 Seen = 0;
+        for (;;) {
+            {
+                std::unique_lock Lock(Mutex);
+                WakeCv.wait(Lock, [&] { return Quit || Generation != Seen; });
+                if (Quit) return;
+                Seen = Generation;
+                ++Active;
+            }
+            RunChunks();
+            {
+                std::lock_guard Lock(Mutex);
+                --Active;
+            }
+            IdleCv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include "Smile/Core/MappedFile.h"
+#include <cstdint>
+#include <fstream>
+#include <Windows.h>
+
+namespace Smile {
+    std::unique_ptr<FMappedFile> FMappedFile::Map(const std::filesystem::path& _Path) {
+        HANDLE File = CreateFileW(_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (File == INVALID_HANDLE_VALUE) return {};
+
+        LARGE_INTEGER Size{};
+        if (!GetFileSizeEx(File, &Size) || Size.QuadPart <= 0 ||
+            static_cast<u64>(Size.QuadPart) > static_cast<u64>(SIZE_MAX)) {
+            CloseHandle(File);
+            return {};
+        }
+        HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!Mapping) {
+            CloseHandle(File);
+            return {};
+        }
+        const void* View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!View) {
+            CloseHandle(Mapping);
+            CloseHandle(File);
+            return {};
+        }
+
+        std::unique_ptr<FMappedFile> Out(new FMappedFile());
+        Out->File    = File;
+        Out->Mapping = Mapping;
+        Out->View    = View;
+        Out->Data    = static_cast<const u8*>(View);
+        Out->Size    = static_cast<size_t>(Size.QuadPart);
+        return Out;
+    }
+
+    std::unique_ptr<FMappedFile> FMappedFile::Read(const std::filesystem::path& _Path) {
+        std::ifstream In(_Path, std::ios::binary);
+        if (!In) return {};
+        In.seekg(0, std::ios::end);
+        const std::streamoff Size = In.tellg();
+        In.seekg(0, std::ios::beg);
+        if (Size <= 0) return {};
+
+        std::unique_ptr<FMappedFile> Out(new FMappedFile());
+        Out->Owned.resize(static_cast<size_t>(Size));
+        In.read(reinterpret_cast<char*>(Out->Owned.data()), Size);
+        if (!In) return {};
+        Out->Data = Out->Owned.data();
+        Out->Size = Out->Owned.size();
+        return Out;
+    }
+
+    FMappedFile::~FMappedFile() {
+        if (View) UnmapViewOfFile(View);
+        if (Mapping) CloseHandle(static_cast<HANDLE>(Mapping));
+        if (File) CloseHandle(static_cast<HANDLE>(File));
+    }
+}
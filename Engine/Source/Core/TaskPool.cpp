@@ -0,0 +1,167 @@
+#include "Smile/Core/TaskPool.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Smile {
+    thread_local bool FTaskPool::InsideTask = false;
+
+    const char* LoadTaskKindName(ELoadTaskKind _Kind) {
+        switch (_Kind) {
+            case ELoadTaskKind::Texture: return "textura";
+            case ELoadTaskKind::Mesh:    return "mesh";
+            default:                     return "outra";
+        }
+    }
+
+    u32 FTaskPool::DefaultWorkerCount() {
+        const u32 Hw = std::thread::hardware_concurrency();
+        return Hw > 2 ? Hw - 2 : 1u;
+    }
+
+    FTaskPool& FTaskPool::Shared() {
+        static FTaskPool Pool;
+        return Pool;
+    }
+
+    FTaskPool::FTaskPool(u32 _WorkerCount) {
+        const u32 N = _WorkerCount ? _WorkerCount : DefaultWorkerCount();
+        Queues = std::make_unique<FQueue[]>(N + 1);
+        Workers.reserve(N);
+        for (u32 i = 0; i < N; ++i) Workers.emplace_back([this, i] { WorkerMain(i + 1); });
+    }
+
+    FTaskPool::~FTaskPool() {
+        {
+            std::lock_guard Lock(Mutex);
+            Quit = true;
+        }
+        WakeCv.notify_all();
+        for (std::thread& T : Workers) T.join();
+    }
+
+    std::vector<FLoadTaskTiming> FTaskPool::Run(std::span<FLoadTask> _Tasks) {
+        const u32 N = static_cast<u32>(_Tasks.size());
+        std::vector<FLoadTaskTiming> Result(N);
+        if (N == 0) return Result;
+        for (u32 i = 0; i < N; ++i) {
+            Result[i].Kind = _Tasks[i].Kind;
+            Result[i].Name = _Tasks[i].Name;
+            Result[i].Cost = _Tasks[i].Cost;
+        }
+        std::vector<u32> Order(N);
+        std::iota(Order.begin(), Order.end(), 0u);
+        std::stable_sort(Order.begin(), Order.end(),
+                         [&](u32 _A, u32 _B) { return _Tasks[_A].Cost > _Tasks[_B].Cost; });
+
+        // Inline: mesma ordem, uma thread. Um Run de dentro de uma tarefa cai aqui — esperar o
+        // pool de dentro dele travaria.
+        if (Workers.empty() || N == 1 || InsideTask) {
+            const Clock::time_point T0 = Clock::now();
+            for (u32 k = 0; k < N; ++k) {
+                FLoadTaskTiming& T = Result[Order[k]];
+                const Clock::time_point S = Clock::now();
+                _Tasks[Order[k]].Fn();
+                T.StartMs = std::chrono::duration<f64, std::milli>(S - T0).count();
+                T.Ms      = std::chrono::duration<f64, std::milli>(Clock::now() - S).count();
+                T.Order   = k;
+            }
+            return Result;
+        }
+
+        std::lock_guard Serial(RunMutex);
+        const u32 Threads = ThreadCount();
+        {
+            // Worker atrasado do lote anterior ainda pode estar saindo do Drain: espera ele.
+            std::unique_lock Lock(Mutex);
+            IdleCv.wait(Lock, [this] { return Active == 0; });
+            for (u32 k = 0; k < N; ++k) Queues[k % Threads].Items.push_back(Order[k]);
+            Tasks   = _Tasks.data();
+            Timings = Result.data();
+            Start   = Clock::now();
+            Started.store(0, std::memory_order_relaxed);
+            ++Generation;
+        }
+        WakeCv.notify_all();
+
+        InsideTask = true;
+        Drain(0);
+        InsideTask = false;
+
+        // Quem chama so sai do Drain com todas as filas vazias; as tarefas ainda com um worker
+        // terminam antes de ele decrementar Active.
+        std::unique_lock Lock(Mutex);
+        IdleCv.wait(Lock, [this] { return Active == 0; });
+        Tasks   = nullptr;
+        Timings = nullptr;
+        return Result;
+    }
+
+    bool FTaskPool::Next(u32 _Self, u32& _Task) {
+        {
+            FQueue& Own = Queues[_Self];
+            std::lock_guard Lock(Own.Mutex);
+            if (!Own.Items.empty()) {
+                _Task = Own.Items.front();
+                Own.Items.pop_front();
+                return true;
+            }
+        }
+        // Roubo: a frente mais cara entre as outras filas. A fila pode esvaziar entre olhar e
+        // pegar; entao olha de novo.
+        const u32 Threads = ThreadCount();
+        for (;;) {
+            u32 Victim = Threads;
+            u64 Best   = 0;
+            for (u32 v = 0; v < Threads; ++v) {
+                if (v == _Self) continue;
+                std::lock_guard Lock(Queues[v].Mutex);
+                if (Queues[v].Items.empty()) continue;
+                const u64 Cost = Tasks[Queues[v].Items.front()].Cost;
+                if (Victim == Threads || Cost > Best) { Victim = v; Best = Cost; }
+            }
+            if (Victim == Threads) return false;
+            std::lock_guard Lock(Queues[Victim].Mutex);
+            if (Queues[Victim].Items.empty()) continue;
+            _Task = Queues[Victim].Items.front();
+            Queues[Victim].Items.pop_front();
+            return true;
+        }
+    }
+
+    void FTaskPool::Execute(u32 _Task, u32 _Self) {
+        FLoadTaskTiming& T = Timings[_Task];
+        T.Order  = Started.fetch_add(1, std::memory_order_relaxed);
+        T.Thread = _Self;
+        const Clock::time_point S = Clock::now();
+        Tasks[_Task].Fn();
+        const Clock::time_point E = Clock::now();
+        T.StartMs = std::chrono::duration<f64, std::milli>(S - Start).count();
+        T.Ms      = std::chrono::duration<f64, std::milli>(E - S).count();
+    }
+
+    void FTaskPool::Drain(u32 _Self) {
+        u32 Task;
+        while (Next(_Self, Task)) Execute(Task, _Self);
+    }
+
+    void FTaskPool::WorkerMain(u32 _Self) {
+        InsideTask = true;
+        u64 Seen = 0;
+        for (;;) {
+            {
+                std::unique_lock Lock(Mutex);
+                WakeCv.wait(Lock, [&] { return Quit || Generation != Seen; });
+                if (Quit) return;
+                Seen = Generation;
+                ++Active;
+            }
+            Drain(_Self);
+            {
+                std::lock_guard Lock(Mutex);
+                --Active;
+            }
+            IdleCv.notify_all();
+        }
+    }
+}
@@ -235,34 +235,6 @@ namespace Smile {
         CubeState = _After;
     }
 
-    // Planos do frustum (espaco de mundo) de um ViewProj row-major com x' = x * M. Ao
-    // contrario do CSM, aqui INCLUI o near: a projecao e perspectiva com depth clip ligado,
-    // entao caster antes do near da luz nao rasteriza de jeito nenhum. No CSM o plano e
-    // omitido porque com pancaking (depth clip off) o caster ainda achata no near e projeta.
-    static void ExtractFrustumPlanes(const Mat44& _M, Vec4 _Out[6]) {
-        const Vec4 c0{ _M.M[0][0], _M.M[1][0], _M.M[2][0], _M.M[3][0] };
-        const Vec4 c1{ _M.M[0][1], _M.M[1][1], _M.M[2][1], _M.M[3][1] };
-        const Vec4 c2{ _M.M[0][2], _M.M[1][2], _M.M[2][2], _M.M[3][2] };
-        const Vec4 c3{ _M.M[0][3], _M.M[1][3], _M.M[2][3], _M.M[3][3] };
-        _Out[0] = { c3.X + c0.X, c3.Y + c0.Y, c3.Z + c0.Z, c3.W + c0.W }; // esquerda
-        _Out[1] = { c3.X - c0.X, c3.Y - c0.Y, c3.Z - c0.Z, c3.W - c0.W }; // direita
-        _Out[2] = { c3.X + c1.X, c3.Y + c1.Y, c3.Z + c1.Z, c3.W + c1.W }; // baixo
-        _Out[3] = { c3.X - c1.X, c3.Y - c1.Y, c3.Z - c1.Z, c3.W - c1.W }; // cima
-        _Out[4] = { c2.X,        c2.Y,        c2.Z,        c2.W        }; // near (z' >= 0)
-        _Out[5] = { c3.X - c2.X, c3.Y - c2.Y, c3.Z - c2.Z, c3.W - c2.W }; // far
-    }
-
-    static bool AABBOutsidePlanes(const Vec4 _Planes[6], const Vec3& _Mn, const Vec3& _Mx) {
-        for (int i = 0; i < 6; ++i) {
-            const Vec4& p = _Planes[i];
-            const f32 px = (p.X >= 0.0f) ? _Mx.X : _Mn.X;
-            const f32 py = (p.Y >= 0.0f) ? _Mx.Y : _Mn.Y;
-            const f32 pz = (p.Z >= 0.0f) ? _Mx.Z : _Mn.Z;
-            if (p.X * px + p.Y * py + p.Z * pz + p.W < 0.0f) return true;
-        }
-        return false;
-    }
-
     void FLocalShadows::RecordDepthPass(ID3D12GraphicsCommandList* _CommandList,
                                         FTextureSRVHeap& _SRVHeap, u32 _FrameSlot,
                                         const FShadowDrawItem* _Items, size_t _Count,
@@ -272,40 +244,25 @@ namespace Smile {
         if (!Initialized) return;
         if (_JobCount == 0 && _CubeJobCount == 0) { EnsureReadable(_CommandList); return; }
 
-        // Broad phase por LUZ (uma varredura da cena, AABB vs esfera de influencia). As views
-        // que vem depois — 1 slice do spot, 6 faces do point — refinam com o proprio frustum
-        // SO em cima desta lista curta. Antes cada face repetia o teste de esfera na cena
-        // inteira e mandava o resto pro clipper: ate 32*N testes de CPU por frame e draws que
-        // so morriam na GPU. Duas fases e o que Cry e Flax fazem (broad phase por luz, depois
-        // um contexto/frustum por face).
-        auto BroadPhase = [&](const Vec3& _LightPos, f32 _Radius) {
-            CullScratch.clear();
-            const f32 R2 = _Radius * _Radius;
-            const f32 P[3] = { _LightPos.X, _LightPos.Y, _LightPos.Z };
-            for (u32 k = 0; k < static_cast<u32>(_Count); ++k) {
-                const FShadowDrawItem& It = _Items[k];
-                if (!It.Mesh) continue;
-                const f32 Lo[3] = { It.AABBMin.X, It.AABBMin.Y, It.AABBMin.Z };
-                const f32 Hi[3] = { It.AABBMax.X, It.AABBMax.Y, It.AABBMax.Z };
-                f32 D2 = 0.0f;
-                for (int a = 0; a < 3; ++a) {
-                    if (P[a] < Lo[a])      { const f32 d = Lo[a] - P[a]; D2 += d * d; }
-                    else if (P[a] > Hi[a]) { const f32 d = P[a] - Hi[a]; D2 += d * d; }
-                }
-                if (D2 <= R2) CullScratch.push_back(k);
-            }
-        };
-
-        // Narrow phase + draws desta view (DSV/CB ja setados pelo chamador).
-        auto DrawView = [&](const Mat44& _ViewProj) {
-            Vec4 Planes[6];
-            ExtractFrustumPlanes(_ViewProj, Planes);
+        // Duas fases, como Cry e Flax: broad phase por LUZ (AABB vs esfera de influencia) e um
+        // frustum por view — 1 slice do spot, 6 faces do point. Os dois testes rodam no kernel em
+        // lote (FrustumCull.h) sobre as caixas em SoA: os frustums de TODOS os spots numa passada
+        // pela lista inteira, e a esfera refina a lista curta de cada um; no point a esfera vem
+        // primeiro e as 6 faces cullam juntas o que sobrou. Os frustums saem do ViewProj com o
+        // near: a projecao e perspectiva com depth clip ligado, entao caster antes do near da luz
+        // nao rasteriza de jeito nenhum (no CSM o plano e omitido por causa do pancaking).
+        CasterBounds.Clear();
+        CasterBounds.Reserve(_Count);
+        for (size_t k = 0; k < _Count; ++k) CasterBounds.Push(_Items[k].AABBMin, _Items[k].AABBMax);
+
+        // Draws de uma view (DSV/CB ja setados pelo chamador); `_Visible` indexa Items.
+        auto DrawView = [&](const std::vector<u32>& _Visible) {
             ID3D12PipelineState* Cur = nullptr; // local: o ExtraDraw da view anterior trocou o PSO
             FDrawSubmitCache Submit;
             _CommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-            for (u32 k : CullScratch) {
+            for (u32 k : _Visible) {
                 const FShadowDrawItem& It = _Items[k];
-                if (AABBOutsidePlanes(Planes, It.AABBMin, It.AABBMax)) continue;
+                if (!It.Mesh) continue;
                 const bool AlphaTested = It.Mat && (It.Mat->Constants.AlphaTest != 0);
                 ID3D12PipelineState* Want = AlphaTested ? MaskedPSO.Get() : OpaquePSO.Get();
                 if (Want != Cur) { _CommandList->SetPipelineState(Want); Cur = Want; }
@@ -329,7 +286,12 @@ namespace Smile {
             _CommandList->RSSetViewports(1, &VP);
             _CommandList->RSSetScissorRects(1, &SC);
 
-            for (u32 j = 0; j < _JobCount && j < kMaxShadows; ++j) {
+            const u32 SpotCount = std::min(_JobCount, kMaxShadows);
+            FCullFrustum SpotFrusta[kMaxShadows];
+            for (u32 j = 0; j < SpotCount; ++j) SpotFrusta[j] = FCullFrustum::FromViewProj(_Jobs[j].ViewProj);
+            CullFrustums(CasterBounds, std::span<const FCullFrustum>(SpotFrusta, SpotCount), SpotCasters);
+
+            for (u32 j = 0; j < SpotCount; ++j) {
                 const FShadowJob& Job = _Jobs[j];
                 const u32 Slice = Job.Slice < kMaxShadows ? Job.Slice : 0;
 
@@ -346,8 +308,12 @@ namespace Smile {
                 _CommandList->ClearDepthStencilView(DSV, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
                 _CommandList->SetGraphicsRootConstantBufferView(0, SliceCBAddr);
 
-                BroadPhase(Job.LightPos, Job.Radius);
-                DrawView(Job.ViewProj);
+                // Esfera de influencia sobre a lista curta do frustum: a ordem (crescente) fica.
+                std::vector<u32>& Visible = SpotCasters[j];
+                std::erase_if(Visible, [&](u32 _K) {
+                    return !AABBTouchesSphere(_Items[_K].AABBMin, _Items[_K].AABBMax, Job.LightPos, Job.Radius);
+                });
+                DrawView(Visible);
 
                 if (_ExtraDraw)
                     _ExtraDraw(_CommandList, SliceCBAddr, Job.ViewProj, Job.LightPos, Job.Radius);
@@ -386,12 +352,25 @@ namespace Smile {
 
                 const Mat44 Proj = Mat44::PerspectiveFovLH(kHalfPi, 1.0f, kPointNear, FarP);
 
-                // Uma broad phase para as SEIS faces: a esfera de influencia e a mesma.
-                BroadPhase(Job.LightPos, FarP);
+                // Uma broad phase para as SEIS faces: a esfera de influencia e a mesma. As faces
+                // cullam juntas, numa passada, em cima do que a esfera deixou.
+                CullSphere(CasterBounds, Job.LightPos, FarP, CullScratch);
+                NearBounds.Clear();
+                NearBounds.Reserve(CullScratch.size());
+                for (const u32 k : CullScratch) NearBounds.Push(_Items[k].AABBMin, _Items[k].AABBMax);
+
+                Mat44        FaceVPs[6];
+                FCullFrustum FaceFrusta[6];
+                for (u32 f = 0; f < 6; ++f) {
+                    FaceVPs[f] = Mat44::LookAtLH(Job.LightPos, Job.LightPos + kFaceFwd[f], kFaceUp[f]) * Proj;
+                    FaceFrusta[f] = FCullFrustum::FromViewProj(FaceVPs[f]);
+                }
+                CullFrustums(NearBounds, FaceFrusta, FaceCasters);
 
                 for (u32 f = 0; f < 6; ++f) {
-                    const Mat44 FaceVP =
-                        Mat44::LookAtLH(Job.LightPos, Job.LightPos + kFaceFwd[f], kFaceUp[f]) * Proj;
+                    const Mat44& FaceVP = FaceVPs[f];
+                    // Indice na lista curta -> indice em Items (crescente nos dois).
+                    for (u32& k : FaceCasters[f]) k = CullScratch[k];
 
                     const u32 CBSlot  = kMaxShadows + Cube * 6 + f;
                     const size_t CBOffset = FrameCBBase + static_cast<size_t>(CBSlot) * 256;
@@ -405,7 +384,7 @@ namespace Smile {
                     _CommandList->ClearDepthStencilView(DSV, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
                     _CommandList->SetGraphicsRootConstantBufferView(0, FaceCBAddr);
 
-                    DrawView(FaceVP);
+                    DrawView(FaceCasters[f]);
 
                     if (_ExtraDraw)
                         _ExtraDraw(_CommandList, FaceCBAddr, FaceVP, Job.LightPos, FarP);
@@ -299,7 +299,7 @@ namespace Smile {
             T.LightOffset   = Offset;
             // Transposta, igual ao que o RaytracingScene entrega ao TLAS: as 3 primeiras linhas
             // da Mat44 transposta sao a matriz 3x4 linha-maior.
-            const Mat44 M = R.Transform.Matrix().GetTransposed();
+            const Mat44 M = R.World.GetTransposed();
             T.Row0 = { M.M[0][0], M.M[0][1], M.M[0][2], M.M[0][3] };
             T.Row1 = { M.M[1][0], M.M[1][1], M.M[1][2], M.M[1][3] };
             T.Row2 = { M.M[2][0], M.M[2][1], M.M[2][2], M.M[2][3] };
@@ -456,7 +456,7 @@ namespace Smile {
 
             // So as 3 linhas mudam: InstanceIndex, TriangleCount e LightOffset descrevem o
             // PARTICIONAMENTO, e ele e justamente o que acabou de ser conferido como intacto.
-            const Mat44 M = R.Transform.Matrix().GetTransposed();
+            const Mat44 M = R.World.GetTransposed();
             const Vec4 Row0{ M.M[0][0], M.M[0][1], M.M[0][2], M.M[0][3] };
             const Vec4 Row1{ M.M[1][0], M.M[1][1], M.M[1][2], M.M[1][3] };
             const Vec4 Row2{ M.M[2][0], M.M[2][1], M.M[2][2], M.M[2][3] };
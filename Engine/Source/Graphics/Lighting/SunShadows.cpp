@@ -589,34 +589,31 @@ namespace Smile {
         StaticState = _After;
     }
 
-    bool FSunShadows::CasterVisible(const FShadowDrawItem& _It, u32 _Cascade, f32 _MinExtent,
-                                    FCascadeStats* _St) const {
+    void FSunShadows::CullCasters(const FShadowDrawItem* _Items, size_t _Count) {
+        CasterBounds.Clear();
+        CasterBounds.Reserve(_Count);
+        for (size_t k = 0; k < _Count; ++k) CasterBounds.Push(_Items[k].AABBMin, _Items[k].AABBMax);
+        // Planos da fatia, montados no UpdatePerFrame (ver a nota longa la). Nao saem da
+        // matriz do ortho: aquela e a caixa da esfera de fitting e nao corta nada nas cascatas
+        // distantes. Sem o plano near — com pancaking (depth clip off) casters atras do near
+        // ainda projetam sombra, achatados nele.
+        FCullFrustum Slices[kNumCascades];
+        for (u32 c = 0; c < kNumCascades; ++c) Slices[c] = FCullFrustum::FromPlanes(CullPlanes[c], 5);
+        CullFrustums(CasterBounds, Slices, CascadeCasters);
+    }
+
+    bool FSunShadows::CasterBigEnough(const FShadowDrawItem& _It, f32 _MinExtent) const {
         if (!_It.Mesh) return false;
         // Caster menor que N texels da cascata nao contribui sombra legivel (min caster size
-        // da Cry/UE). Vem antes dos planos porque e mais barato e, nas cascatas distantes, e o
-        // filtro que corta quase tudo — na 3 sao 669 de 1542 contra 0 dos planos.
+        // da Cry/UE). Nas cascatas distantes e o filtro que corta quase tudo — na 3 sao 669 de
+        // 1542 contra 0 dos planos.
         if (_MinExtent > 0.0f) {
             const f32 ExX = _It.AABBMax.X - _It.AABBMin.X;
             const f32 ExY = _It.AABBMax.Y - _It.AABBMin.Y;
             const f32 ExZ = _It.AABBMax.Z - _It.AABBMin.Z;
             f32 MaxExt = ExX > ExY ? ExX : ExY;
             if (ExZ > MaxExt) MaxExt = ExZ;
-            if (MaxExt < _MinExtent) { if (_St) ++_St->CulledSize; return false; }
-        }
-        // Planos da fatia, montados no UpdatePerFrame (ver a nota longa la). Nao saem da
-        // matriz do ortho: aquela e a caixa da esfera de fitting e nao corta nada nas cascatas
-        // distantes. Sem o plano near — com pancaking (depth clip off) casters atras do near
-        // ainda projetam sombra, achatados nele.
-        const Vec4* Planes = CullPlanes[_Cascade];
-        for (int i = 0; i < 5; ++i) {
-            const Vec4& p = Planes[i];
-            const f32 px = (p.X >= 0.0f) ? _It.AABBMax.X : _It.AABBMin.X;
-            const f32 py = (p.Y >= 0.0f) ? _It.AABBMax.Y : _It.AABBMin.Y;
-            const f32 pz = (p.Z >= 0.0f) ? _It.AABBMax.Z : _It.AABBMin.Z;
-            if (p.X*px + p.Y*py + p.Z*pz + p.W < 0.0f) {
-                if (_St) ++_St->CulledPlanes;
-                return false;
-            }
+            if (MaxExt < _MinExtent) return false;
         }
         return true;
     }
@@ -631,10 +628,18 @@ namespace Smile {
         ID3D12PipelineState* Cur     = nullptr;
         FDrawSubmitCache     Submit;
         u32 Drawn = 0;
+        // A lista da cascata e crescente: [_Begin, _End) e uma faixa contigua dela.
+        const std::vector<u32>& Visible = CascadeCasters[_Cascade];
+        const auto First = std::lower_bound(Visible.begin(), Visible.end(), static_cast<u32>(_Begin));
+        const auto Last  = std::lower_bound(First, Visible.end(), static_cast<u32>(_End));
+        if (_St) _St->CulledPlanes += static_cast<u32>((_End - _Begin) - static_cast<size_t>(Last - First));
         _CommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        for (size_t k = _Begin; k < _End; ++k) {
-            const FShadowDrawItem& It = _Items[k];
-            if (!CasterVisible(It, _Cascade, MinExtent, _St)) continue;
+        for (auto k = First; k != Last; ++k) {
+            const FShadowDrawItem& It = _Items[*k];
+            if (!CasterBigEnough(It, MinExtent)) {
+                if (_St) ++_St->CulledSize;
+                continue;
+            }
             ++Drawn;
             const bool AlphaTested = It.Mat && (It.Mat->Constants.AlphaTest != 0);
             ID3D12PipelineState* Want = AlphaTested ? MaskedPSO.Get() : OpaquePSO.Get();
@@ -659,6 +664,7 @@ namespace Smile {
         _CommandList->RSSetScissorRects(1, &SC);
 
         LastCasterCount = static_cast<u32>(_Count);
+        CullCasters(_Items, _Count);
 
         // Fronteira estatico/dinamico. A lista chega ordenada com mobilidade como chave
         // primaria, entao ela e um unico ponto de corte, achado por busca linear a partir do
@@ -717,8 +723,10 @@ namespace Smile {
         u32 DynVisible[kNumCascades] = {};
         for (u32 c = 0; c < kNumCascades; ++c) {
             const f32 MinExtent = MinCasterTexels * (&CPUConstants.CascadeTexelWorld.X)[c];
-            for (size_t k = FirstDynamic; k < _Count; ++k)
-                if (CasterVisible(_Items[k], c, MinExtent, nullptr)) ++DynVisible[c];
+            const std::vector<u32>& Visible = CascadeCasters[c];
+            for (auto k = std::lower_bound(Visible.begin(), Visible.end(), static_cast<u32>(FirstDynamic));
+                 k != Visible.end(); ++k)
+                if (CasterBigEnough(_Items[*k], MinExtent)) ++DynVisible[c];
         }
 
         u32 CopyMask = 0;
@@ -64,7 +64,6 @@ namespace Smile {
         }
         TransformBuffer.Reset();
         MappedTransforms = nullptr;
-        PreviousModels.clear();
         InstanceCount_ = 0;
         TlasSRVSlot = InstanceGeoSRVSlot = kInvalidSlot;
         SceneReady = false;
@@ -80,10 +79,8 @@ namespace Smile {
 
         // Capacidade com folga (SceneCapacityFor), nao o tamanho exato da cena: assim um objeto
         // criado no editor cabe sem refazer buffer e SRVs. InstanceCount_ passa a ser a
-        // CAPACIDADE — e ele que o UpdatePerFrame usa como stride do slice por frame e no gate
-        // `PreviousModels.size() == InstanceCount_`, entao o PreviousModels abaixo tem de ser
-        // dimensionado igual, senao o gate falha para sempre e o motion vector nunca reusa
-        // historico (todo frame sairia com movimento zero).
+        // CAPACIDADE — e ele que o UpdatePerFrame usa como stride do slice por frame. A matriz do
+        // frame anterior vem do FScene::Hot().PrevWorld, que a cena ja mantem por objeto.
         const u32 Capacity = SceneCapacityFor(Count);
         InstanceCount_ = Capacity;
         TlasSRVSlot = TlasSlot;
@@ -104,11 +101,6 @@ namespace Smile {
             SRVHeap.CreateSRV(Device, TransformBuffer.Get(), S, TransformSRVSlot[f]);
         }
 
-        // Dimensionado pela CAPACIDADE (ver acima); so os [0, Count) existem na cena, o resto
-        // fica identidade ate um objeto novo ocupar o slot.
-        PreviousModels.resize(Capacity, Mat44::Identity());
-        for (u32 i = 0; i < Count; ++i)
-            PreviousModels[i] = Scene.Renderables()[i].Transform.Matrix();
         SceneReady = true;
     }
 
@@ -182,16 +174,23 @@ namespace Smile {
         FrameSlot = NewFrameSlot % kFrames;
         if (!Ready || !MappedTransforms || !MappedCB) return;
 
-        const u32 Count = std::min(InstanceCount_, static_cast<u32>(Scene.Renderables().size()));
+        // Matrizes do cache SoA (sincronizado no topo do frame), nao Transform.Matrix() por
+        // objeto. Quem nao se moveu tem PrevWorld == World bit a bit e sai com identidade exata,
+        // sem as duas inversas — numa cena importada, que e estatica, isso e todo mundo.
+        const FSceneHotData& Hot = Scene.Hot();
+        const u32 Count = std::min(InstanceCount_, static_cast<u32>(Hot.Size()));
         auto* Dst = reinterpret_cast<FTemporalInstanceTransformGPU*>(MappedTransforms) +
                     static_cast<size_t>(FrameSlot) * InstanceCount_;
-        const bool CanReuseTransforms = HistoryValid && PreviousModels.size() == InstanceCount_;
         for (u32 i = 0; i < Count; ++i) {
-            const Mat44 Current = Scene.Renderables()[i].Transform.Matrix();
-            const Mat44 Previous = CanReuseTransforms ? PreviousModels[i] : Current;
+            const Mat44& Current  = Hot.World[i];
+            const Mat44& Previous = Hot.PrevWorld[i];
+            if (!HistoryValid || std::memcmp(&Current, &Previous, sizeof(Mat44)) == 0) {
+                Dst[i].CurrentToPrevious = Mat44::Identity();
+                Dst[i].PreviousToCurrent = Mat44::Identity();
+                continue;
+            }
             Dst[i].CurrentToPrevious = Current.Inverse() * Previous;
             Dst[i].PreviousToCurrent = Previous.Inverse() * Current;
-            PreviousModels[i] = Current;
         }
         for (u32 i = Count; i < InstanceCount_; ++i) {
             Dst[i].CurrentToPrevious = Mat44::Identity();
@@ -77,11 +77,16 @@ namespace Smile {
             u32  MrMapIndex       = 0;
             u32  MetalMapIndex    = 0; // mapa Metalness separado (slot +6)
             u32  RoughMapIndex    = 0; // mapa Roughness separado (slot +7)
+            // FirstMip de cada mapa, 4 bits por slot do material (slot s em [4s, 4s+4)). Com
+            // streaming a tabela estavel aponta para a cauda, que comeca nessa mip do arquivo; o
+            // LOD fixo dos hits e contado da mip 0 do arquivo e o shader desconta (RT_MapLOD).
+            u32  MapFirstMips     = 0;
         };
-        // 84 B na v8 (+TriangleSrv). Vec4 aqui e alinhado em 4, entao o struct nao ganha padding
-        // de cauda e o stride do StructuredBuffer casa byte a byte com o `InstanceGeo` do HLSL —
-        // que e o unico contrato que importa (StructuredBuffer nao exige stride multiplo de 16).
-        static_assert(sizeof(FRTInstanceGeo) == 84, "FRTInstanceGeo deve casar com o HLSL (84B)");
+        // 88 B (84 na v8 com o TriangleSrv, +MapFirstMips). Vec4 aqui e alinhado em 4, entao o
+        // struct nao ganha padding de cauda e o stride do StructuredBuffer casa byte a byte com o
+        // `InstanceGeo` do HLSL — que e o unico contrato que importa (StructuredBuffer nao exige
+        // stride multiplo de 16).
+        static_assert(sizeof(FRTInstanceGeo) == 88, "FRTInstanceGeo deve casar com o HLSL (88B)");
     }
 
     static_assert(FRaytracingScene::kInstanceSlots == FCommandQueue::kFramesInFlight,
@@ -128,7 +133,7 @@ namespace Smile {
 
             D3D12_RAYTRACING_INSTANCE_DESC Inst{};
 
-            const Mat44 T = R.Transform.Matrix().GetTransposed();
+            const Mat44 T = R.World.GetTransposed();
             for (int Row = 0; Row < 3; ++Row)
                 for (int Col = 0; Col < 4; ++Col)
                     Inst.Transform[Row][Col] = T.M[Row][Col];
@@ -237,6 +242,12 @@ namespace Smile {
                         g.RoughMapIndex = R.Material->AlbedoDescriptorIndex() + 7;
                         g.Flags |= 64u;
                     }
+                    const FTexture* Maps[kMaterialTextureSlots] = {
+                        R.Material->Albedo, R.Material->Normal, R.Material->MetallicRoughness, R.Material->AO,
+                        R.Material->Emissive, R.Material->Height, R.Material->Metalness, R.Material->Roughness };
+                    for (u32 s = 0; s < kMaterialTextureSlots; ++s)
+                        if (Maps[s] && Maps[s]->IsValid())
+                            g.MapFirstMips |= std::min(Maps[s]->FirstMip(), 15u) << (4 * s);
                 }
             }
             // Tres slots CONSECUTIVOS por malha unica: [VB][IB][RTTri]. O base vem do
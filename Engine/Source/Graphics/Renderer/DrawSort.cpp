@@ -0,0 +1,33 @@
+#include "Smile/Graphics/Renderer/DrawSort.h"
+
+#include <cstddef>
+#include <utility>
+
+namespace Smile {
+    void RadixSortPairs(std::vector<FSortPair>& _Pairs, std::vector<FSortPair>& _Scratch) {
+        const size_t N = _Pairs.size();
+        if (N < 2) return;
+
+        u32 Hist[8][256] = {};
+        for (const FSortPair& P : _Pairs)
+            for (u32 d = 0; d < 8; ++d) ++Hist[d][(P.Key >> (d * 8)) & 0xFFu];
+
+        _Scratch.resize(N);
+        FSortPair* Src = _Pairs.data();
+        FSortPair* Dst = _Scratch.data();
+        for (u32 d = 0; d < 8; ++d) {
+            // Digito constante: a passada so copiaria na mesma ordem.
+            if (Hist[d][(Src[0].Key >> (d * 8)) & 0xFFu] == N) continue;
+            u32 Offset[256];
+            u32 Sum = 0;
+            for (u32 b = 0; b < 256; ++b) {
+                Offset[b] = Sum;
+                Sum += Hist[d][b];
+            }
+            for (size_t i = 0; i < N; ++i) Dst[Offset[(Src[i].Key >> (d * 8)) & 0xFFu]++] = Src[i];
+            std::swap(Src, Dst);
+        }
+        // Numero impar de passadas: o resultado ficou no scratch.
+        if (Src != _Pairs.data()) _Pairs.swap(_Scratch);
+    }
+}
@@ -4,6 +4,7 @@
 #include "Smile/Graphics/Renderer/RendererFrameState.h"
 #include "Smile/Graphics/Renderer/RendererSceneState.h"
 #include "Smile/Graphics/Backend/RenderBackend.h"
+#include <algorithm>
 
 namespace Smile {
 
@@ -103,6 +104,14 @@ namespace Smile {
     void FRenderSettings::SetFrustumCulling(bool _Use) { R.UseFrustumCulling = _Use; }
     bool FRenderSettings::GetFrustumCulling() const    { return R.UseFrustumCulling; }
 
+    void FRenderSettings::SetParallelDrawLists(bool _Use) { R.UseParallelDrawLists = _Use; }
+    bool FRenderSettings::GetParallelDrawLists() const    { return R.UseParallelDrawLists; }
+    void FRenderSettings::SetDrawListCache(bool _Use) {
+        R.UseDrawListCache = _Use;
+        R.InvalidateDrawListCache();
+    }
+    bool FRenderSettings::GetDrawListCache() const { return R.UseDrawListCache; }
+
     void FRenderSettings::SetOcclusionCulling(bool _Use) {
         // Ao religar, descarta resultados velhos do readback ring — os proximos
         // kFramesInFlight frames desenham tudo ate ter teste fresco.
@@ -117,6 +126,20 @@ namespace Smile {
     void FRenderSettings::SetUseAsyncCompute(bool _V) { R.UseAsyncCompute = _V; }
     bool FRenderSettings::GetUseAsyncCompute() const  { return R.UseAsyncCompute; }
 
+    // === Streaming de texturas ==========================================================
+
+    void FRenderSettings::SetTextureStreaming(bool _Use) { R.TextureStreamer.SetEnabled(_Use); }
+    bool FRenderSettings::GetTextureStreaming() const    { return R.TextureStreamer.IsEnabled(); }
+    void FRenderSettings::SetTextureStreamingBudgetMB(u32 _MB) {
+        R.TextureStreamer.SetBudgetBytes(u64(std::max(_MB, 1u)) * 1024 * 1024);
+    }
+    u32 FRenderSettings::GetTextureStreamingBudgetMB() const {
+        return static_cast<u32>(R.TextureStreamer.BudgetBytes() / (1024 * 1024));
+    }
+    const FResidencyStats& FRenderSettings::GetTextureStreamingStats() const {
+        return R.TextureStreamer.Stats();
+    }
+
     // === Iluminacao global ==============================================================
 
     // O mapa de fonte e produzido DENTRO do RecordTrace do ReSTIR GI. Sem esse passe, ninguem
@@ -1210,6 +1233,7 @@ namespace Smile {
         R.Backend->ComputeQueue.WaitIdle();
         R.RaytracingScene.RefreshInstanceGeo(R.SceneState->Scene);
         R.SceneState->TlasFlagsDirty = true; // mask/FORCE_NON_OPAQUE/culling saem do material
+        R.InvalidateDrawListCache();          // o FDrawItem::Mat guardado pode ter mudado
         // E os historicos acumulados sobre a aparencia antiga.
         Invalidate(Dom::MaterialRTState);
     }
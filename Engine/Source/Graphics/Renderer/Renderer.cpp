@@ -601,6 +601,7 @@ namespace Smile {
         if (!Initialized) return;
         Backend->FlushDirect();
         CaptureState->Session.Release();
+        TextureStreamer.Clear(Backend->UploadQueue, Backend->SRVHeap);
         Backend->Shutdown();
         Nrd.Shutdown();
         NrdDirect.Shutdown();
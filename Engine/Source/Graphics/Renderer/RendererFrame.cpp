@@ -730,6 +730,11 @@ namespace Smile {
             Settings().NotifySceneContentChanged();
         }
 
+        // Cache SoA da cena (matriz de mundo, caixa, flags) ANTES de qualquer consumidor do
+        // frame: o TemporalMotion e o BuildDrawLists leem o Hot() em vez de recompor o transform
+        // de cada objeto. Sem edicao desde o frame anterior, e so a comparacao de tres versoes.
+        SceneState->Scene.SyncHotData();
+
         // Invalide quando o novo dominio for publicado, nao quando a reconstrucao for pedida.
         if (MeshLights.ConsumeDomainPublish()) Settings().NotifyMeshDomainChanged();
 
@@ -841,6 +846,13 @@ namespace Smile {
 
         BuildDrawLists(Ctx);
 
+        // Mips que os visiveis da camera pedem; as tabelas de raster das versoes que ja subiram
+        // trocam aqui, antes de qualquer passe que amostre material ser gravado.
+        TextureStreamer.BeginFrame({ static_cast<f32>(RenderHeight()), Vw.FovY, Vw.MipBias }, Vw.CameraPosition);
+        for (const FVisibleItem& Item : Ctx.Visible) TextureStreamer.Request(*Item.R, Item.Mat);
+        TextureStreamer.Update(Backend->Device.Native(), Backend->UploadQueue, Backend->SRVHeap,
+                               ImportedMaterials, FrameState->FrameIndex);
+
         RecordShadows(Ctx, ShadowJobs);
 
         RecordDepthPrepass(Ctx);
@@ -946,6 +958,7 @@ namespace Smile {
 
         AsyncGIRanLastFrame = (GIComputeFence != 0);
         Backend->DirectQueue.EndFrame(CommandLists, 1);
+        ReclaimDrawLists(Ctx);
 
         // Avanca o aquecimento e, no frame de captura, grava PNG + manifesto. ANTES do ++ dos
         // contadores logo abaixo: o manifesto grava o TemporalSampleIndex com que este frame
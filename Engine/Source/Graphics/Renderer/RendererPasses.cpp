@@ -123,10 +123,12 @@ namespace Smile {
         {
             FGPULightGI* Dst = reinterpret_cast<FGPULightGI*>(
                 MappedGILightBase + static_cast<size_t>(FrameSlot) * kMaxLights * sizeof(FGPULightGI));
-            for (FLight& L : SceneState->Scene.Lights()) {
-                // O caminho direto atribui a identidade mais adiante, mas o ReGIR e construido
-                // antes dele. Atribuir aqui garante que o historico nunca use indice como ID.
-                if (L.Id == 0) L.Id = SceneState->Scene.AllocObjectId();
+            auto& GILights = SceneState->Scene.Lights();
+            for (u32 li = 0; li < static_cast<u32>(GILights.size()); ++li) {
+                FLight& L = GILights[li];
+                // O caminho direto garante a identidade mais adiante, mas o ReGIR e construido
+                // antes dele. Garantir aqui evita que o historico use indice como ID.
+                SceneState->Scene.EnsureLightId(li);
                 if (!L.Enabled || L.Intensity <= 0.0f || L.AttenuationRadius <= 0.0f) continue;
                 // Peso de RT: com 0 a luz sai da lista do indireto por completo (nao so escurece —
                 // some do hit, economizando o shadow ray dela). E o caso da luz que so existia p/
@@ -1237,29 +1239,31 @@ namespace Smile {
                                       Vw.FovY, Vw.Aspect, Lt.KeyDir, Vw.NearZ, ShadowNoiseFrame,
                                       SceneState->Scene.StaticCastersVersion());
             if (UseSunShadows) {
+                // Montada e ordenada nos chunks do BuildDrawLists (JobSystem.h); a juncao em ordem
+                // e a ordem total do sort mantem a lista identica a serial.
                 std::vector<FSunShadows::FShadowDrawItem> Casters;
-                Casters.reserve(AllItems.size());
-                for (const FDrawItem& A : AllItems) {
-                    // Translucido nao projeta sombra opaca (vidro deixa o sol entrar).
-                    if (A.Mat && A.Mat->Blend) continue;
-                    // Durante o arraste, trate o objeto como dinamico para preservar o cache CSM.
-                    const bool Dyn = A.R->Mobility == EMobility::Dynamic ||
-                                     (SceneState->DraggingRenderableId != 0 &&
-                                      A.R->Id == SceneState->DraggingRenderableId);
-                    Casters.push_back({ A.R->Mesh, A.Mat,
-                                        ObjectCBBase + static_cast<u64>(A.Slot) * sizeof(ObjectConstants),
-                                        A.R->AABBMin, A.R->AABBMax, Dyn });
-                }
+                const u64 DraggingId = SceneState->DraggingRenderableId;
+                ParallelGather(FrameJobs(), static_cast<u32>(AllItems.size()), 1024, SunCasterChunks, Casters,
+                               [&](u32 _Begin, u32 _End, std::vector<FSunShadows::FShadowDrawItem>& _Out) {
+                    for (u32 k = _Begin; k < _End; ++k) {
+                        const FDrawItem& A = AllItems[k];
+                        // Translucido nao projeta sombra opaca (vidro deixa o sol entrar).
+                        if (A.Mat && A.Mat->Blend) continue;
+                        // Durante o arraste, trate o objeto como dinamico para preservar o cache CSM.
+                        const bool Dyn = A.R->Mobility == EMobility::Dynamic ||
+                                         (DraggingId != 0 && A.R->Id == DraggingId);
+                        _Out.push_back({ A.R->Mesh, A.Mat,
+                                         ObjectCBBase + static_cast<u64>(A.Slot) * sizeof(ObjectConstants),
+                                         A.R->AABBMin, A.R->AABBMax, Dyn });
+                    }
+                });
                 // Mobilidade separa as metades cacheada/dinamica; material reduz trocas de PSO.
-                std::sort(Casters.begin(), Casters.end(),
-                          [](const FSunShadows::FShadowDrawItem& a,
-                             const FSunShadows::FShadowDrawItem& b) {
-                              if (a.Dynamic != b.Dynamic) return !a.Dynamic;
-                              const bool am = a.Mat && a.Mat->Constants.AlphaTest != 0;
-                              const bool bm = b.Mat && b.Mat->Constants.AlphaTest != 0;
-                              if (am != bm) return !am;
-                              if (a.Mat != b.Mat) return a.Mat < b.Mat;
-                              return a.Mesh < b.Mesh;
+                // Empate de chave fica na ordem de cena (radix estavel, DrawSort.h).
+                SortByKey(Casters, SunCasterScratch, DrawSortScratch,
+                          [](const FSunShadows::FShadowDrawItem& _C) {
+                              const bool Masked = _C.Mat && _C.Mat->Constants.AlphaTest != 0;
+                              return DrawSortKey::State((_C.Dynamic ? 2u : 0u) | (Masked ? 1u : 0u),
+                                                        _C.Mat ? _C.Mat->SortId : 0u, _C.Mesh->SortId);
                           });
                 {
                     FGpuScope Scope(Backend->DirectProfiler, CommandList, "Sombras — sol (CSM)");
@@ -1291,23 +1295,23 @@ namespace Smile {
 
         if (!LocalShadowJobs.empty() || !LocalCubeJobs.empty()) {
             std::vector<FLocalShadows::FShadowDrawItem> LocalCasters;
-            LocalCasters.reserve(AllItems.size());
-            for (const FDrawItem& A : AllItems) {
-                if (A.Mat && A.Mat->Blend) continue; // vidro nao projeta sombra opaca
-                LocalCasters.push_back({ A.R->Mesh, A.Mat,
-                                         ObjectCBBase + static_cast<u64>(A.Slot) * sizeof(ObjectConstants),
-                                         A.R->AABBMin, A.R->AABBMax });
-            }
+            ParallelGather(FrameJobs(), static_cast<u32>(AllItems.size()), 1024, LocalCasterChunks, LocalCasters,
+                           [&](u32 _Begin, u32 _End, std::vector<FLocalShadows::FShadowDrawItem>& _Out) {
+                for (u32 k = _Begin; k < _End; ++k) {
+                    const FDrawItem& A = AllItems[k];
+                    if (A.Mat && A.Mat->Blend) continue; // vidro nao projeta sombra opaca
+                    _Out.push_back({ A.R->Mesh, A.Mat,
+                                     ObjectCBBase + static_cast<u64>(A.Slot) * sizeof(ObjectConstants),
+                                     A.R->AABBMin, A.R->AABBMax });
+                }
+            });
             // Mesma chave do CSM (sem mobilidade): alpha-test agrupado e Bind/IA
             // adjacentes. A broad-phase por luz nao depende da ordem.
-            std::sort(LocalCasters.begin(), LocalCasters.end(),
-                      [](const FLocalShadows::FShadowDrawItem& a,
-                         const FLocalShadows::FShadowDrawItem& b) {
-                          const bool am = a.Mat && a.Mat->Constants.AlphaTest != 0;
-                          const bool bm = b.Mat && b.Mat->Constants.AlphaTest != 0;
-                          if (am != bm) return !am;
-                          if (a.Mat != b.Mat) return a.Mat < b.Mat;
-                          return a.Mesh < b.Mesh;
+            SortByKey(LocalCasters, LocalCasterScratch, DrawSortScratch,
+                      [](const FLocalShadows::FShadowDrawItem& _C) {
+                          const bool Masked = _C.Mat && _C.Mat->Constants.AlphaTest != 0;
+                          return DrawSortKey::State(Masked ? 1u : 0u, _C.Mat ? _C.Mat->SortId : 0u,
+                                                    _C.Mesh->SortId);
                       });
             {
                 FGpuScope Scope(Backend->DirectProfiler, CommandList, "Sombras — locais");
@@ -1525,19 +1529,28 @@ namespace Smile {
                 for (const FVisibleItem& V : VisibleScratch) {
                     if (!V.Mat->Blend) GBufferOrder.push_back(&V);
                 }
-                std::sort(GBufferOrder.begin(), GBufferOrder.end(),
-                          [](const FVisibleItem* a, const FVisibleItem* b) {
-                              const bool at = a->Mat->IsTwoSidedForRT();
-                              const bool bt = b->Mat->IsTwoSidedForRT();
-                              if (at != bt) return !at;
-                              if (a->Mat != b->Mat) return a->Mat < b->Mat;
-                              return a->R->Mesh < b->R->Mesh;
-                          });
-
+                // Radix estavel (DrawSort.h): dentro de um mesmo mesh segue a ordem de slot, que o
+                // BuildDrawLists deu consecutiva por material/malha — vizinhos viram um lote.
+                const u32 FrameObjectBase = FrameSlot * MaxObjects;
+                std::vector<const FVisibleItem*> GBufferScratch;
+                SortByKey(GBufferOrder, GBufferScratch, DrawSortScratch, [&](const FVisibleItem* _V) {
+                    return DrawSortKey::Batch(_V->Mat->IsTwoSidedForRT() ? 1u : 0u, _V->Mat->SortId,
+                                              _V->R->Mesh->SortId, _V->Slot - FrameObjectBase);
+                });
+                BuildDrawBatches<const FVisibleItem*>(
+                    GBufferOrder, GBufferBatches,
+                    [](const FVisibleItem* _A, const FVisibleItem* _B) {
+                        return _A->R->Mesh == _B->R->Mesh && _A->Mat == _B->Mat;
+                    },
+                    [](const FVisibleItem* _V) { return _V->Slot; });
+
+                // Um draw por lote: o root CBV aponta para o slot da primeira instancia e o VS
+                // indexa o resto pelo SV_InstanceID.
                 CommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
                 ID3D12PipelineState* CurGeomPSO = nullptr;
                 FDrawSubmitCache Submit;
-                for (const FVisibleItem* V : GBufferOrder) {
+                for (const FDrawBatch& B : GBufferBatches) {
+                    const FVisibleItem* V = GBufferOrder[B.First];
                     FMaterial* Mat = V->Mat;
                     const bool TwoSided = Mat->IsTwoSidedForRT();
                     ID3D12PipelineState* Want = TwoSided ? PipelineState.PSOGBufferTwoSided()
@@ -1546,8 +1559,9 @@ namespace Smile {
                     CommandList->SetGraphicsRootConstantBufferView(
                         4, ObjectCBBase + static_cast<u64>(V->Slot) * sizeof(ObjectConstants));
                     Submit.BindMaterial(CommandList, Backend->SRVHeap, Mat);
-                    Submit.DrawMesh(CommandList, V->R->Mesh);
+                    Submit.DrawMesh(CommandList, V->R->Mesh, B.Count);
                 }
+                LastGBufferDraws = static_cast<u32>(GBufferBatches.size());
             }
 
             if (UseTerrain && Terrain.IsLoaded()) {
@@ -1667,9 +1681,8 @@ namespace Smile {
             auto& SceneLights = SceneState->Scene.Lights();
             for (u32 li = 0; li < static_cast<u32>(SceneLights.size()); ++li) {
                 FLight& L = SceneLights[li];
-                // Identidade estavel na primeira vez que vemos a luz. O editor faz push_back
-                // direto em Lights(), entao a atribuicao mora aqui e nao no AddLight.
-                if (L.Id == 0) L.Id = SceneState->Scene.AllocObjectId();
+                // Luz que entrou na lista por fora do AddLight ganha identidade aqui.
+                SceneState->Scene.EnsureLightId(li);
                 Vec3 PreviousLightPos = L.Position;
                 if (const auto It = FrameState->PreviousDirectLightPositions.find(L.Id);
                     It != FrameState->PreviousDirectLightPositions.end())
@@ -1865,9 +1878,25 @@ namespace Smile {
         return ShadowJobs;
     }
 
+    FJobSystem* Renderer::FrameJobs() {
+        if (!UseParallelDrawLists) return nullptr;
+        if (!DrawListJobs) DrawListJobs = std::make_unique<FJobSystem>();
+        return DrawListJobs.get();
+    }
+
     // Monta as listas de draw do frame: escreve o ObjectConstants de cada renderavel, resolve a
     // selecao, aplica frustum + oclusao HZB e ordena front-to-back. E a 2a etapa de preenchimento
     // do FPassContext — daqui em diante Ctx.All / Ctx.Visible / Ctx.Selection sao validos.
+    //
+    // Roda em chunks fixos de kDrawListGrain renderaveis (FJobSystem): cada chunk filtra, escreve
+    // e culla a sua faixa, e as saidas sao juntadas na ordem dos chunks. Os slots saem de uma soma
+    // de prefixos, entao Ctx.All, o ObjectCB e Ctx.Visible sao os mesmos do laco serial de antes.
+    //
+    // E incremental por frame slot (FDrawListSlotCache). Ctx.All so e remontado quando muda quem
+    // vira draw ou o slot de alguem (estrutura, Visible/Mobility, toggles). Fora disso o ObjectCB
+    // do slot e reescrito inteiro se a camera mudou, senao so nos objetos que andaram; Ctx.Visible
+    // e o sort so rodam de novo se frustum, camera, selecao, HZB ou alguma caixa mudou. Camera e
+    // cena paradas: nada e escrito nem ordenado, e a saida e a mesma do caminho sem cache.
     void Renderer::BuildDrawLists(FPassContext& _Ctx) {
         const FFrameView& Vw     = *_Ctx.View;
         const u32 FrameSlot      = _Ctx.FrameSlot;
@@ -1877,81 +1906,261 @@ namespace Smile {
 
         const u32 FrameObjectBase = FrameSlot * MaxObjects;
 
-        auto& AllItems = _Ctx.All;
+        FJobSystem* Jobs = FrameJobs();
+        // ~1000 objetos por chunk: o ObjectConstants custa ~100 ns, e chunk menor so paga a fila.
+        constexpr u32 kDrawListGrain = 1024;
 
-        u32             SelectedSlot  = kInvalidSlot;
-        const FGpuMesh* SelectedMesh  = nullptr;
-        Mat44           SelectedModel = Mat44::Identity();
         // Hasteado do loop: a selecao virou uma consulta (mesh OU luz), e o loop abaixo roda
         // por renderavel da cena.
         const int       SelectedRenderable = GetSelectedObject();
-        {
-            const std::vector<FRenderable>& RList = SceneState->Scene.Renderables();
-            AllItems.reserve(RList.size());
-            const size_t PrevCount = SceneState->PreviousModels.size();
-            SceneState->PreviousModels.resize(RList.size(), Mat44::Identity());
-            const bool WriteOcclusionBounds = UseOcclusionCulling && HiZ.ObjectsReady();
-            for (size_t si = 0; si < RList.size(); ++si) {
-                const FRenderable& R = RList[si];
-                if (WriteOcclusionBounds)
-                    HiZ.WriteBounds(FrameSlot, static_cast<u32>(si), R.AABBMin, R.AABBMax);
-                if (!R.Visible || R.RaytracingOnly || !R.Mesh || !R.Mesh->IsValid()) continue;
-                if (AllItems.size() >= MaxObjects) break;
-                FMaterial* Mat = (R.Material && R.Material->IsFinalized()) ? R.Material : ActiveMaterial;
-                const u32 Slot = FrameObjectBase + static_cast<u32>(AllItems.size());
-                const Mat44 Model = R.Transform.Matrix();
-                const Mat44 PrevModel = (si < PrevCount) ? SceneState->PreviousModels[si] : Model;
-                ObjectConstants OC;
-                OC.MVP            = Model * Vw.ViewProjection;
-                OC.ModelMatrix    = Model;
-                OC.CurMVPNoJitter = Model * Vw.ViewProjUnjittered;
-                OC.PrevMVP        = PrevModel * FrameState->PrevViewProj;
-                std::memcpy(MappedObjectCB + static_cast<size_t>(Slot) * sizeof(ObjectConstants),
-                            &OC, sizeof(ObjectConstants));
-                if (static_cast<int>(si) == SelectedRenderable) {
-                    SelectedSlot = Slot; SelectedMesh = R.Mesh; SelectedModel = Model;
+        // Le o cache SoA sincronizado no topo do RenderFrame: matriz pronta, caixa e flags em
+        // vetores proprios. O FRenderable so e tocado por quem vai virar draw (mesh e material).
+        const FScene&                   Scene = SceneState->Scene;
+        const FSceneHotData&            Hot   = Scene.Hot();
+        const std::vector<FRenderable>& RList = Scene.Renderables();
+        const u32  Count = static_cast<u32>(std::min(RList.size(), Hot.Size()));
+        const bool WriteOcclusionBounds = UseOcclusionCulling && HiZ.ObjectsReady();
+        auto IsDraw = [&](u32 _Si) { return Hot.IsDrawCandidate(_Si) && RList[_Si].Mesh->IsValid(); };
+
+        // 0) O que a cena mudou desde o frame anterior vira pendencia de TODOS os slots; cada um
+        // aplica na sua vez. Versao pulada (sync sem frame) nao diz quem mudou: slot inteiro.
+        if (Scene.HotVersion() != DrawListHotVersion) {
+            const bool Everything = Scene.HotChangedAll() || Scene.HotVersion() != DrawListHotVersion + 1;
+            const std::span<const u32> Changed = Scene.HotChanged();
+            for (FDrawListSlotCache& S : DrawListCache) {
+                if (!Everything) S.Pending.insert(S.Pending.end(), Changed.begin(), Changed.end());
+                // Pendencia demais acumulada: reescrever o slot inteiro sai mais barato.
+                if (Everything || S.Pending.size() > Count / 2) {
+                    S.AllPending = true;
+                    S.Pending.clear();
+                }
+            }
+            DrawListHotVersion = Scene.HotVersion();
+        }
+
+        FDrawListSlotCache& Cache = DrawListCache[FrameSlot];
+        auto& AllItems = Cache.All;
+
+        // Ctx.All e remontado quando muda quem vira draw ou o slot de alguem. Lent = o frame
+        // anterior deste slot nao devolveu as listas (saiu no meio).
+        bool Rebuild = !UseDrawListCache || !Cache.Valid || Cache.Lent || Cache.AllPending
+                    || Cache.StructureVersion != Scene.StructureVersion() || Cache.SceneCount != Count
+                    || Cache.MaxObjects != MaxObjects || Cache.FrustumCulling != UseFrustumCulling
+                    || Cache.OcclusionBounds != WriteOcclusionBounds;
+        // Visible/Mobility chegam como pendencia igual a transform: quem entrou ou saiu, remonta.
+        if (!Rebuild)
+            for (const u32 si : Cache.Pending)
+                if (si >= Count || IsDraw(si) != (Cache.ItemOf[si] != kNoItem)) { Rebuild = true; break; }
+
+        auto SameMat = [](const Mat44& _A, const Mat44& _B) { return std::memcmp(&_A, &_B, sizeof(Mat44)) == 0; };
+        // Com TAA/upscaler o jitter muda a MVP todo frame: a lista fica, o ObjectCB e reescrito.
+        const bool ViewChanged = !SameMat(Cache.ViewProj, Vw.ViewProjection)
+                              || !SameMat(Cache.ViewProjUnjittered, Vw.ViewProjUnjittered)
+                              || !SameMat(Cache.PrevViewProj, FrameState->PrevViewProj);
+
+        auto WriteObject = [&](u32 _K) {
+            const FDrawItem& A = AllItems[_K];
+            const Mat44& Model = Hot.World[A.SceneIndex];
+            // PrevWorld e mantido pela cena so para quem se moveu; o resto e o proprio World.
+            const Mat44& PrevModel = Hot.PrevWorld[A.SceneIndex];
+            ObjectConstants OC;
+            OC.MVP            = Model * Vw.ViewProjection;
+            OC.ModelMatrix    = Model;
+            OC.CurMVPNoJitter = Model * Vw.ViewProjUnjittered;
+            OC.PrevMVP        = PrevModel * FrameState->PrevViewProj;
+            std::memcpy(MappedObjectCB + static_cast<size_t>(A.Slot) * sizeof(ObjectConstants),
+                        &OC, sizeof(ObjectConstants));
+        };
+
+        if (Rebuild) {
+            const u32 Chunks = FJobSystem::ChunkCount(Count, kDrawListGrain);
+            if (DrawListChunks.size() < Chunks) DrawListChunks.resize(Chunks);
+
+            // 1) Por chunk: bounds do HZB (endereco fixo por indice de cena) e quem vira draw.
+            ForEachChunk(Jobs, Count, kDrawListGrain, [&](u32 _Chunk, u32 _Begin, u32 _End) {
+                FDrawListChunk& C = DrawListChunks[_Chunk];
+                C.Accepted.clear();
+                for (u32 si = _Begin; si < _End; ++si) {
+                    if (WriteOcclusionBounds)
+                        HiZ.WriteBounds(FrameSlot, si, Hot.BoundsMin[si], Hot.BoundsMax[si]);
+                    if (IsDraw(si)) C.Accepted.push_back(si);
+                }
+            });
+
+            // 2) Slots. O corte em MaxObjects e o mesmo `break` do laco serial — os primeiros
+            // MaxObjects aceitos, em ordem de cena. Depois, radix estavel por (material, malha):
+            // quem divide malha e material ganha slots CONSECUTIVOS, e o G-buffer desenha o grupo
+            // num draw instanciado (DrawBatch.h). Empate fica na ordem de cena.
+            DrawOrder.clear();
+            for (u32 c = 0; c < Chunks && DrawOrder.size() < MaxObjects; ++c) {
+                const std::vector<u32>& Acc = DrawListChunks[c].Accepted;
+                const size_t Take = std::min(Acc.size(), static_cast<size_t>(MaxObjects) - DrawOrder.size());
+                DrawOrder.insert(DrawOrder.end(), Acc.begin(), Acc.begin() + Take);
+            }
+            auto MatOf = [&](const FRenderable& _R) {
+                return (_R.Material && _R.Material->IsFinalized()) ? _R.Material : ActiveMaterial;
+            };
+            SortByKey(DrawOrder, DrawOrderScratch, DrawSortScratch, [&](u32 _Si) {
+                const FRenderable& R = RList[_Si];
+                return DrawSortKey::State(0, MatOf(R)->SortId, R.Mesh->SortId);
+            });
+            const u32 Total = static_cast<u32>(DrawOrder.size());
+            AllItems.resize(Total);
+            Cache.ItemOf.assign(Count, kNoItem);
+            Cache.CullBounds.Clear();
+            if (UseFrustumCulling) Cache.CullBounds.Resize(Total);
+
+            // 3) Item e ObjectConstants de cada draw no seu slot.
+            ForEachChunk(Jobs, Total, kDrawListGrain, [&](u32, u32 _Begin, u32 _End) {
+                for (u32 k = _Begin; k < _End; ++k) {
+                    const u32 si = DrawOrder[k];
+                    const FRenderable& R = RList[si];
+                    AllItems[k]      = { &R, MatOf(R), FrameObjectBase + k, si };
+                    Cache.ItemOf[si] = k;
+                    WriteObject(k);
+                    if (UseFrustumCulling) Cache.CullBounds.Set(k, Hot.BoundsMin[si], Hot.BoundsMax[si]);
                 }
-                AllItems.push_back({ &R, Mat, Slot, static_cast<u32>(si) });
-                SceneState->PreviousModels[si] = Model;
+            });
+
+            Cache.Valid            = true;
+            Cache.StructureVersion = Scene.StructureVersion();
+            Cache.SceneCount       = Count;
+            Cache.MaxObjects       = MaxObjects;
+            Cache.FrustumCulling   = UseFrustumCulling;
+            Cache.OcclusionBounds  = WriteOcclusionBounds;
+            Cache.VisibleValid     = false;
+        } else {
+            // Mesma lista: o ObjectCB inteiro se a camera mudou, senao so quem andou. A caixa de
+            // quem andou vai para o HZB e para o frustum.
+            if (ViewChanged)
+                ForEachChunk(Jobs, static_cast<u32>(AllItems.size()), kDrawListGrain, [&](u32, u32 _Begin, u32 _End) {
+                    for (u32 k = _Begin; k < _End; ++k) WriteObject(k);
+                });
+            for (const u32 si : Cache.Pending) {
+                if (WriteOcclusionBounds) HiZ.WriteBounds(FrameSlot, si, Hot.BoundsMin[si], Hot.BoundsMax[si]);
+                const u32 k = Cache.ItemOf[si];
+                if (k == kNoItem) continue;
+                if (!ViewChanged) WriteObject(k);
+                if (UseFrustumCulling) Cache.CullBounds.Set(k, Hot.BoundsMin[si], Hot.BoundsMax[si]);
+            }
+            if (!Cache.Pending.empty()) Cache.VisibleValid = false;
+        }
+        Cache.Pending.clear();
+        Cache.AllPending         = false;
+        Cache.ViewProj           = Vw.ViewProjection;
+        Cache.ViewProjUnjittered = Vw.ViewProjUnjittered;
+        Cache.PrevViewProj       = FrameState->PrevViewProj;
+
+        // A selecao entra no contexto AQUI, pelo indice de cena -> item que as listas ja tem: o
+        // contorno a consome ~1400 linhas abaixo, e recompor la exigiria varrer tudo de novo.
+        FSelectionDraw Selection{ kInvalidSlot, nullptr, Mat44::Identity(), SelectedRenderable };
+        if (SelectedRenderable >= 0 && static_cast<u32>(SelectedRenderable) < Count) {
+            const u32 k = Cache.ItemOf[SelectedRenderable];
+            if (k != kNoItem) {
+                Selection.Slot  = AllItems[k].Slot;
+                Selection.Mesh  = AllItems[k].R->Mesh;
+                Selection.Model = Hot.World[SelectedRenderable];
             }
         }
-        // A selecao entra no contexto AQUI, no unico laco que ja varre a cena: o contorno a
-        // consome ~1400 linhas abaixo, e recompor la exigiria varrer tudo de novo.
-        _Ctx.Selection = { SelectedSlot, SelectedMesh, SelectedModel, SelectedRenderable };
+        _Ctx.Selection = Selection;
 
         // Resultado do teste HZB gravado ha kFramesInFlight frames neste slot (a fence
         // ja foi esperada no BeginFrame). nullptr = sem teste valido -> tudo visivel.
         const u32* OcclusionVis = UseOcclusionCulling
-            ? HiZ.ResolveResults(FrameSlot, static_cast<u32>(SceneState->Scene.Renderables().size()))
+            ? HiZ.ResolveResults(FrameSlot, static_cast<u32>(RList.size()))
             : nullptr;
-        u32 OccludedCount = 0;
-
-        auto& VisibleScratch = _Ctx.Visible;
-        VisibleScratch.reserve(AllItems.size());
-        for (const FDrawItem& A : AllItems) {
-            if (UseFrustumCulling && Vw.AABBOutsideFrustum(A.R->AABBMin, A.R->AABBMax)) continue;
-            // Objeto selecionado nunca e cullado (gizmo/drag move mais rapido que a
-            // latencia do readback e o pop incomodaria bem aqui). O resultado so cobre
-            // [0, Capacity); indices alem disso (ex.: proxy RT do terreno) ficam visiveis.
-            if (OcclusionVis && A.SceneIndex < HiZ.Capacity() &&
-                !OcclusionVis[A.SceneIndex] &&
-                static_cast<int>(A.SceneIndex) != SelectedRenderable) {
-                ++OccludedCount;
-                continue;
-            }
-            const f32 cx = (A.R->AABBMin.X + A.R->AABBMax.X) * 0.5f - CamPos.X;
-            const f32 cy = (A.R->AABBMin.Y + A.R->AABBMax.Y) * 0.5f - CamPos.Y;
-            const f32 cz = (A.R->AABBMin.Z + A.R->AABBMax.Z) * 0.5f - CamPos.Z;
-            VisibleScratch.push_back({ A.R, A.Mat, cx*cx + cy*cy + cz*cz, A.Slot, A.SceneIndex });
+        const u32 OcclusionCount = OcclusionVis ? std::min(Count, HiZ.Capacity()) : 0u;
+
+        // O frustum e o da VP sem jitter, como o teste do HZB: o jitter de TAA desloca os planos
+        // menos de um pixel, e com ele a lista nunca se repetiria entre frames.
+        const Mat44& CullViewProj = Vw.ViewProjUnjittered;
+        const bool ReuseVisible = UseDrawListCache && Cache.VisibleValid
+            && SameMat(Cache.CullViewProj, CullViewProj)
+            && std::memcmp(&Cache.CullCamPos, &CamPos, sizeof(Vec3)) == 0
+            && Cache.CullSelected == SelectedRenderable
+            && Cache.CullOcclusion == (OcclusionVis != nullptr)
+            && Cache.CullOcclusionVis.size() == OcclusionCount
+            && std::equal(OcclusionVis, OcclusionVis + OcclusionCount, Cache.CullOcclusionVis.begin());
+
+        auto& VisibleScratch = Cache.Visible;
+        if (!ReuseVisible) {
+            // 4) Frustum da camera em lote (FrustumCull.h) + oclusao + distancia, por chunk de
+            // Ctx.All. O kernel devolve os sobreviventes da faixa em ordem, e os chunks sao
+            // juntados em ordem: Ctx.Visible chega ao sort igual ao do laco serial.
+            const u32 AllCount  = static_cast<u32>(AllItems.size());
+            const u32 AllChunks = FJobSystem::ChunkCount(AllCount, kDrawListGrain);
+            if (DrawListChunks.size() < AllChunks) DrawListChunks.resize(AllChunks);
+            const FCullFrustum CameraFrustum = FCullFrustum::FromViewProj(CullViewProj);
+            ParallelGather(Jobs, AllCount, kDrawListGrain, VisibleChunks, VisibleScratch,
+                           [&](u32 _Begin, u32 _End, std::vector<FVisibleItem>& _Out) {
+                FDrawListChunk& C = DrawListChunks[_Begin / kDrawListGrain];
+                C.Occluded = 0;
+                if (UseFrustumCulling) {
+                    CullFrustums(Cache.CullBounds, _Begin, _End, { &CameraFrustum, 1 }, { &C.Survivors, 1 });
+                } else {
+                    C.Survivors.resize(_End - _Begin);
+                    for (u32 k = _Begin; k < _End; ++k) C.Survivors[k - _Begin] = k;
+                }
+                for (const u32 k : C.Survivors) {
+                    const FDrawItem& A = AllItems[k];
+                    const Vec3& BMin = Hot.BoundsMin[A.SceneIndex];
+                    const Vec3& BMax = Hot.BoundsMax[A.SceneIndex];
+                    // Objeto selecionado nunca e cullado (gizmo/drag move mais rapido que a
+                    // latencia do readback e o pop incomodaria bem aqui). O resultado so cobre
+                    // [0, Capacity); indices alem disso (ex.: proxy RT do terreno) ficam visiveis.
+                    if (OcclusionVis && A.SceneIndex < HiZ.Capacity() &&
+                        !OcclusionVis[A.SceneIndex] &&
+                        static_cast<int>(A.SceneIndex) != SelectedRenderable) {
+                        ++C.Occluded;
+                        continue;
+                    }
+                    const f32 cx = (BMin.X + BMax.X) * 0.5f - CamPos.X;
+                    const f32 cy = (BMin.Y + BMax.Y) * 0.5f - CamPos.Y;
+                    const f32 cz = (BMin.Z + BMax.Z) * 0.5f - CamPos.Z;
+                    _Out.push_back({ A.R, A.Mat, cx*cx + cy*cy + cz*cz, A.Slot, A.SceneIndex });
+                }
+            });
+            Cache.Occluded = 0;
+            for (u32 c = 0; c < AllChunks; ++c) Cache.Occluded += DrawListChunks[c].Occluded;
+
+            // Radix estavel sobre a distancia inteira (DrawSort.h): empate fica na ordem de
+            // Ctx.All, que e a de slot — a mesma resposta do antigo sort por (Dist, Slot).
+            SortByKey(VisibleScratch, VisibleSortScratch, DrawSortScratch,
+                      [](const FVisibleItem& _V) { return DrawSortKey::Depth(0, _V.Dist); });
+
+            Cache.VisibleValid  = true;
+            Cache.CullViewProj  = CullViewProj;
+            Cache.CullCamPos    = CamPos;
+            Cache.CullSelected  = SelectedRenderable;
+            Cache.CullOcclusion = OcclusionVis != nullptr;
+            Cache.CullOcclusionVis.assign(OcclusionVis, OcclusionVis + OcclusionCount);
         }
-        std::sort(VisibleScratch.begin(), VisibleScratch.end(),
-                  [](const FVisibleItem& a, const FVisibleItem& b) { return a.Dist < b.Dist; });
         LastVisibleCount  = static_cast<u32>(VisibleScratch.size());
-        LastOccludedCount = OccludedCount;
+        LastOccludedCount = Cache.Occluded;
+
+        // As listas vao para o contexto sem copia e voltam no ReclaimDrawLists, no fim do frame.
+        _Ctx.All.swap(AllItems);
+        _Ctx.Visible.swap(VisibleScratch);
+        Cache.Lent = true;
 
         if (UseTerrain && Terrain.IsLoaded())
             Terrain.UpdatePerFrame(FrameSlot, Vw.ViewProjection, Vw.ViewProjUnjittered,
                                    FrameState->PrevViewProj,
                                    Vw.CameraPosition, Vw.FovY, Vw.MipBias);
     }
+
+    void Renderer::ReclaimDrawLists(FPassContext& _Ctx) {
+        FDrawListSlotCache& Cache = DrawListCache[_Ctx.FrameSlot];
+        if (!Cache.Lent) return;
+        Cache.All.swap(_Ctx.All);
+        Cache.Visible.swap(_Ctx.Visible);
+        Cache.Lent = false;
+    }
+
+    void Renderer::InvalidateDrawListCache() {
+        for (FDrawListSlotCache& S : DrawListCache) {
+            S.Valid        = false;
+            S.VisibleValid = false;
+        }
+    }
 }
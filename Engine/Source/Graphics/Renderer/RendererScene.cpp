@@ -125,12 +125,10 @@ namespace Smile {
             ClearLightSelection();
             return;
         }
-        // A luz pode nao ter identidade ainda: o editor faz push_back direto e quem atribui e o
-        // RenderFrame, no proximo frame. Selecionar e um bom momento para adiantar — sem isso a
-        // selecao ficaria com Id 0, ou seja, invalida, ate um frame passar.
-        FLight& L = SceneState->Scene.Lights()[static_cast<size_t>(_Index)];
-        if (L.Id == 0) L.Id = SceneState->Scene.AllocObjectId();
-        SceneState->Selection = { L.Id, ESceneObject::Light, static_cast<u32>(_Index) };
+        // Luz que entrou por fora do AddLight pode nao ter identidade ainda; sem ela a selecao
+        // ficaria com Id 0, ou seja, invalida.
+        const u64 Id = SceneState->Scene.EnsureLightId(static_cast<u32>(_Index));
+        SceneState->Selection = { Id, ESceneObject::Light, static_cast<u32>(_Index) };
     }
 
     int Renderer::GetSelectedLight() const {
@@ -148,6 +146,24 @@ namespace Smile {
         return true;
     }
 
+    u32 Renderer::RemoveRenderables(std::span<const u64> _Ids) {
+        // Mesmo caminho do RemoveRenderable, com UMA compactacao da lista e UM re-setup para o
+        // lote: a caixa do GI e a uniao das caixas de quem sai, capturada antes.
+        Vec3 Min = {  3.0e38f,  3.0e38f,  3.0e38f };
+        Vec3 Max = { -3.0e38f, -3.0e38f, -3.0e38f };
+        for (const u64 Id : _Ids) {
+            const FRenderable* Doomed = SceneState->Scene.FindRenderable(Id);
+            if (!Doomed) continue;
+            Min = { std::min(Min.X, Doomed->AABBMin.X), std::min(Min.Y, Doomed->AABBMin.Y),
+                    std::min(Min.Z, Doomed->AABBMin.Z) };
+            Max = { std::max(Max.X, Doomed->AABBMax.X), std::max(Max.Y, Doomed->AABBMax.Y),
+                    std::max(Max.Z, Doomed->AABBMax.Z) };
+        }
+        const u32 Removed = SceneState->Scene.RemoveRenderables(_Ids);
+        if (Removed > 0) OnSceneStructureChanged(&Min, &Max);
+        return Removed;
+    }
+
     u64 Renderer::DuplicateRenderable(u64 _Id) {
         const FRenderable* Added = SceneState->Scene.DuplicateRenderable(_Id);
         if (!Added) return 0;
@@ -174,9 +190,10 @@ namespace Smile {
 
         // Picks em voo carregam indices e nao sobrevivem a uma mudanca estrutural.
         ObjectPicker.CancelPending();
+        // Nem as listas guardadas: quem chega aqui pode ter trocado um renderavel no lugar, sem
+        // a lista mudar de tamanho.
+        InvalidateDrawListCache();
         SceneState->Selection = SceneState->Scene.FindObject(SceneState->Selection.Id);
-        // PreviousModels e indexado pela ordem da cena, que acabou de mudar.
-        SceneState->PreviousModels.clear();
 
         // Estruturas de GPU compartilham a folga de SceneCapacityFor; ao excede-la, todo o setup
         // de cena precisa ser refeito porque TLAS, InstanceGeo e SRVs possuem capacidade fixa.
@@ -316,6 +333,7 @@ namespace Smile {
 
     void Renderer::SetMaterial(FMaterial* _Material) {
         ActiveMaterial = (_Material && _Material->IsFinalized()) ? _Material : &DefaultMaterial;
+        InvalidateDrawListCache(); // e o material de quem nao tem um proprio
     }
 
     void Renderer::SetUseWater(bool _Use) {
@@ -608,7 +626,7 @@ namespace Smile {
                 f32 Radius = std::sqrt(Ext.X * Ext.X + Ext.Y * Ext.Y + Ext.Z * Ext.Z);
                 if (Radius < 1e-3f || Radius > 1e8f) Radius = 0.5f; // AABB ausente/degenerado
                 const f32 S = 0.5f / Radius;
-                SceneModel = Pick->Transform.Matrix()
+                SceneModel = Pick->World
                            * Mat44::Translation(-Center)
                            * Mat44::Scale({ S, S, S });
             }
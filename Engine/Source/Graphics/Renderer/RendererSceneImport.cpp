@@ -37,14 +37,18 @@ namespace Smile {
         static_assert(sizeof(ObjectConstants) % 256 == 0,
                       "o CB de objeto e indexado por sizeof(); root CBV exige 256-alinhado");
 
+        // + uma janela de lote no fim: o VS declara o cbuffer inteiro (kMaxDrawInstances slots), e
+        // o root CBV do ultimo slot nao pode apontar uma janela que sai do recurso.
         const GpuResources::FUploadBuffer Upload = GpuResources::CreateUploadBuffer(
             Backend->Device.Native(), sizeof(ObjectConstants),
-            FCommandQueue::kFramesInFlight * MaxObjects);
+            FCommandQueue::kFramesInFlight * MaxObjects + kMaxDrawInstances - 1);
         ObjectCB       = Upload.Resource;
         MappedObjectCB = Upload.Mapped;
 
         // ObjectCB e HiZ compartilham a mesma capacidade de objetos.
         HiZ.SetupObjects(Backend->Device.Native(), Backend->SRVHeap, MaxObjects);
+        // Buffers novos: nenhum slot tem mais o que o cache das listas acha que escreveu.
+        InvalidateDrawListCache();
     }
 
     bool Renderer::LoadCookedScene(const std::wstring& _ScenePath, bool _Additive) {
@@ -81,6 +85,7 @@ namespace Smile {
             Backend->DirectQueue.Flush();
 
             SceneState->Scene.Clear();
+            TextureStreamer.Clear(Backend->UploadQueue, Backend->SRVHeap);
             for (auto& m : ImportedMaterials) m->Release(Backend->SRVHeap);
             ImportedMaterials.clear();
             for (auto& t : ImportedTextures) t->Release(Backend->SRVHeap);
@@ -102,6 +107,8 @@ namespace Smile {
             if (!texs[i].IsValid()) { texByPath[relList[i]] = nullptr; continue; }
             auto up = std::make_unique<FTexture>(std::move(texs[i]));
             texByPath[relList[i]] = up.get();
+            // So as DDS que subiram so com a cauda (FirstMip > 0); o resto fica fora do streaming.
+            TextureStreamer.Register(up.get(), sceneDir / relList[i], Imported.TextureData[i]);
             ImportedTextures.push_back(std::move(up));
             ++uploaded;
         }
@@ -185,6 +192,7 @@ namespace Smile {
 
             mat->UpdateConstants();
             matPtrs[i] = mat.get();
+            mat->SortId = static_cast<u32>(ImportedMaterials.size()) + 1u;
             ImportedMaterials.push_back(std::move(mat));
         }
 
@@ -205,6 +213,20 @@ namespace Smile {
         const auto MeshCreationBase = GpuResources::CreationStats();
         std::vector<FGpuMesh*> meshPtrs = SceneState->Scene.AddMeshesBatch(
             Backend->Device.Native(), Backend->UploadQueue, Imported.Meshes);
+        for (size_t m = 0; m < meshPtrs.size() && m < Imported.MeshUvDensity.size(); ++m)
+            if (meshPtrs[m]) meshPtrs[m]->UvDensity = Imported.MeshUvDensity[m];
+        // O cozido grava MUNDO + ParentIndex; a cena guarda o local. liveOf: renderavel cozido ->
+        // indice vivo (quem ficou de fora por mesh invalido nao vira pai: o filho sobe para raiz).
+        std::vector<i32>   liveOf(sh.RenderableCount, -1);
+        std::vector<Mat44> worldOf(sh.RenderableCount);
+        u32 flattened = 0;
+        auto sameMatrix = [](const Mat44& a, const Mat44& b) {
+            for (int row = 0; row < 4; ++row)
+                for (int col = 0; col < 4; ++col)
+                    if (std::fabs(a.M[row][col] - b.M[row][col]) > 1e-4f * std::max(1.0f, std::fabs(a.M[row][col])))
+                        return false;
+            return true;
+        };
         for (u32 i = 0; i < sh.RenderableCount; ++i) {
             const SSceneRenderable& r = rnds[i];
             if (r.MeshIndex >= mh.MeshCount) continue;
@@ -216,15 +238,34 @@ namespace Smile {
             out.Transform.RotationEuler = Vec3{ r.RotationEuler[0], r.RotationEuler[1],
                                                 r.RotationEuler[2] };
             out.Transform.Scale         = Vec3{ r.Scale[0], r.Scale[1], r.Scale[2] };
-            // O arquivo armazena AABB local; os consumidores usam bounds de mundo.
+            worldOf[i] = out.Transform.Matrix();
+            // O cooker so aponta para tras (o pai sai antes do filho). Local sem TRS exato
+            // (cisalhamento de pai com escala nao uniforme) fica achatado: raiz com o mundo.
+            const i32 p = r.ParentIndex;
+            if (p >= 0 && static_cast<u32>(p) < i && liveOf[p] >= 0) {
+                const Mat44 local = worldOf[i] * worldOf[p].Inverse();
+                const FTransform t = FTransform::FromMatrix(local);
+                if (sameMatrix(t.Matrix(), local)) {
+                    out.Parent    = liveOf[p];
+                    out.Transform = t;
+                } else {
+                    ++flattened;
+                }
+            }
+            // O arquivo armazena AABB local; World e bounds de mundo saem do
+            // UpdateWorldTransforms abaixo, com a hierarquia inteira.
             const SMeshEntry& e = entries[r.MeshIndex];
             out.LocalAABBMin = Vec3{ e.AABBMin[0], e.AABBMin[1], e.AABBMin[2] };
             out.LocalAABBMax = Vec3{ e.AABBMax[0], e.AABBMax[1], e.AABBMax[2] };
-            out.RefreshWorldBounds();
             // CookedIndex preserva a identidade do asset quando a lista viva muda.
             out.CookedIndex = static_cast<i32>(i);
+            liveOf[i] = static_cast<i32>(SceneState->Scene.Renderables().size());
             SceneState->Scene.AddRenderable(out);
         }
+        SceneState->Scene.UpdateWorldTransforms();
+        if (flattened > 0)
+            LogDebug("Hierarquia: " + std::to_string(flattened) +
+                     " renderaveis sem TRS local exato ficaram como raiz");
 
         const double msMeshUpload = MsSince(tMeshUploadStart);
         GpuResources::AccumulatePhase(PhaseSum, "commit/meshes", MeshCreationBase);
@@ -251,7 +292,8 @@ namespace Smile {
         LogDebug("Assets da cena preparados: " + std::to_string(mh.MeshCount) + " meshes, " +
                  std::to_string(sh.MaterialCount) + " materiais, " +
                  std::to_string(sh.RenderableCount) + " renderaveis, " +
-                 std::to_string(uploaded) + " texturas DDS");
+                 std::to_string(uploaded) + " texturas DDS (" +
+                 std::to_string(TextureStreamer.Count()) + " em streaming)");
         // O volume de GI cobre tambem objetos preservados por uma carga aditiva.
         Vec3 sceneMin{  1e30f,  1e30f,  1e30f };
         Vec3 sceneMax{ -1e30f, -1e30f, -1e30f };
@@ -374,6 +416,7 @@ namespace Smile {
                             proxy.AABBMax = proxy.LocalAABBMax;
                             if (proxy.Mesh) {
                                 SceneState->Scene.AddRenderable(proxy);
+                                mat->SortId = static_cast<u32>(ImportedMaterials.size()) + 1u;
                                 ImportedMaterials.push_back(std::move(mat));
                             }
                         }
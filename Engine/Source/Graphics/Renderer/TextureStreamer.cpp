@@ -0,0 +1,276 @@
+#include "Smile/Graphics/Renderer/TextureStreamer.h"
+#include "Smile/Graphics/Backend/D3D12/CommandQueue.h"
+#include "Smile/Graphics/Backend/D3D12/UploadQueue.h"
+#include "Smile/Graphics/Resources/Material.h"
+#include "Smile/Scene/Scene.h"
+#include "Smile/Core/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+namespace Smile {
+    namespace {
+        // So BCn chega aqui (LoadDDSCPU recusa DDS sem FourCC): BC1/BC4 tem blocos de 8 bytes.
+        u32 BlockBytesOf(DXGI_FORMAT _Format) {
+            switch (_Format) {
+                case DXGI_FORMAT_BC1_TYPELESS: case DXGI_FORMAT_BC1_UNORM: case DXGI_FORMAT_BC1_UNORM_SRGB:
+                case DXGI_FORMAT_BC4_TYPELESS: case DXGI_FORMAT_BC4_UNORM: case DXGI_FORMAT_BC4_SNORM:
+                    return 8;
+                default:
+                    return 16;
+            }
+        }
+
+        bool IsSrgb(DXGI_FORMAT _Format) {
+            switch (_Format) {
+                case DXGI_FORMAT_BC1_UNORM_SRGB: case DXGI_FORMAT_BC2_UNORM_SRGB:
+                case DXGI_FORMAT_BC3_UNORM_SRGB: case DXGI_FORMAT_BC7_UNORM_SRGB:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // Os oito mapas do material, na ordem dos slots da tabela (FMaterial::Finalize).
+        void MaterialTextures(const FMaterial& _Material, FTexture* (&_Out)[kMaterialTextureSlots]) {
+            _Out[0] = _Material.Albedo;
+            _Out[1] = _Material.Normal;
+            _Out[2] = _Material.MetallicRoughness;
+            _Out[3] = _Material.AO;
+            _Out[4] = _Material.Emissive;
+            _Out[5] = _Material.Height;
+            _Out[6] = _Material.Metalness;
+            _Out[7] = _Material.Roughness;
+        }
+    }
+
+    FTextureStreamer::FTextureStreamer() {
+        IoThread = std::jthread([this](std::stop_token _Stop) { IoLoop(_Stop); });
+    }
+
+    FTextureStreamer::~FTextureStreamer() = default; // o jthread pede parada e junta
+
+    void FTextureStreamer::SetBudgetBytes(u64 _Bytes) {
+        FTextureResidencyOptions Options = Policy.Options();
+        Options.BudgetBytes = _Bytes;
+        Policy.SetOptions(Options);
+    }
+
+    void FTextureStreamer::Register(FTexture* _Texture, const std::filesystem::path& _Path,
+                                    const FTextureCPUData& _Data) {
+        if (!_Texture || !_Texture->IsValid() || _Data.FirstMip == 0) return;
+        FStreamedTextureDesc Desc;
+        Desc.Width      = _Data.Width;
+        Desc.Height     = _Data.Height;
+        Desc.MipCount   = _Data.FirstMip + static_cast<u32>(_Data.Mips.size());
+        Desc.BlockBytes = BlockBytesOf(_Data.Format);
+        const u32 Index = Policy.Add(Desc, _Data.FirstMip);
+        Entries.push_back({ _Texture, _Path, IsSrgb(_Data.Format) });
+        ByTexture[_Texture] = Index;
+    }
+
+    void FTextureStreamer::Clear(FUploadQueue& _UploadQueue, FTextureSRVHeap& _SRVHeap) {
+        {
+            std::lock_guard Lock(IoMutex);
+            ++Generation;
+            Jobs.clear();
+            Loaded.clear();
+        }
+        // O recurso novo ainda pode estar recebendo a copia: so solta depois dela.
+        if (!Uploads.empty()) _UploadQueue.WaitIdle();
+        for (FUpload& Up : Uploads) Up.Fresh.Release(_SRVHeap);
+        Uploads.clear();
+        // Fila direta parada: nada do que segue pode estar em uso.
+        for (auto& [Material, Raster] : RasterTables) {
+            Material->SetRasterTable(FTextureSRVHeap::kInvalidSlot);
+            _SRVHeap.Free(Raster.Table, kMaterialTextureSlots);
+        }
+        RasterTables.clear();
+        for (FRetired& R : Retired) {
+            R.Version.Release(_SRVHeap);
+            _SRVHeap.Release(R.Table, kMaterialTextureSlots);
+        }
+        Retired.clear();
+        for (FEntry& Entry : Entries) Entry.Version.Release(_SRVHeap);
+        Entries.clear();
+        ByTexture.clear();
+        Demand.clear();
+        Policy.Clear();
+    }
+
+    void FTextureStreamer::BeginFrame(const FMipDemandView& _View, const Vec3& _CameraPosition) {
+        DemandView   = _View;
+        DemandCamera = _CameraPosition;
+        Demand.clear();
+    }
+
+    void FTextureStreamer::Request(const FRenderable& _Renderable, const FMaterial* _Material) {
+        if (!_Material || !_Renderable.Mesh || _Renderable.Mesh->UvDensity <= 0.0f || Entries.empty()) return;
+        // Distancia ate a caixa de mundo (0 dentro dela): o ponto mais perto e o que pede a mip
+        // mais fina do objeto.
+        const Vec3& C  = DemandCamera;
+        const f32   Dx = std::max({ _Renderable.AABBMin.X - C.X, 0.0f, C.X - _Renderable.AABBMax.X });
+        const f32   Dy = std::max({ _Renderable.AABBMin.Y - C.Y, 0.0f, C.Y - _Renderable.AABBMax.Y });
+        const f32   Dz = std::max({ _Renderable.AABBMin.Z - C.Z, 0.0f, C.Z - _Renderable.AABBMax.Z });
+        const f32   Distance = std::sqrt(Dx * Dx + Dy * Dy + Dz * Dz);
+        // Maior eixo da escala da instancia (linhas da base, convencao vetor-linha do Mat44).
+        const Mat44& W = _Renderable.World;
+        f32 Scale = 0.0f;
+        for (int Row = 0; Row < 3; ++Row)
+            Scale = std::max(Scale, std::sqrt(W.M[Row][0] * W.M[Row][0] + W.M[Row][1] * W.M[Row][1] +
+                                              W.M[Row][2] * W.M[Row][2]));
+        if (!(Scale > 0.0f)) return;
+
+        const f32 Key = _Renderable.Mesh->UvDensity * Distance / Scale;
+        auto [It, Inserted] = Demand.try_emplace(_Material, Key);
+        if (!Inserted) It->second = std::min(It->second, Key);
+    }
+
+    void FTextureStreamer::Retire(FTexture&& _Version, u32 _Table, u64 _FrameIndex) {
+        if (!_Version.IsValid() && _Table == FTextureSRVHeap::kInvalidSlot) return;
+        Retired.push_back({ std::move(_Version), _Table, _FrameIndex + FCommandQueue::kFramesInFlight });
+    }
+
+    void FTextureStreamer::Update(ID3D12Device* _Device, FUploadQueue& _UploadQueue, FTextureSRVHeap& _SRVHeap,
+                                  std::span<const std::unique_ptr<FMaterial>> _Materials, u64 _FrameIndex) {
+        std::erase_if(Retired, [&](FRetired& _R) {
+            if (_R.Frame > _FrameIndex) return false;
+            _R.Version.Release(_SRVHeap);
+            _SRVHeap.Release(_R.Table, kMaterialTextureSlots);
+            return true;
+        });
+
+        // Uploads que a fila COPY ja terminou viram a versao da textura. A anterior ainda pode
+        // estar numa tabela de raster de um frame em voo: vai para o Retired, nao para o heap.
+        FTexture* Slots[kMaterialTextureSlots] = {};
+        const u64 Done = _UploadQueue.CompletedFence();
+        for (FUpload& Up : Uploads) {
+            if (Up.Fence > Done) continue;
+            FEntry& Entry = Entries[Up.Texture];
+            Retire(std::exchange(Entry.Version, std::move(Up.Fresh)), FTextureSRVHeap::kInvalidSlot, _FrameIndex);
+            Policy.Complete(Up.Texture);
+        }
+        std::erase_if(Uploads, [&](const FUpload& _Up) { return _Up.Fence <= Done; });
+
+        // IO que chegou vira um batch so na fila COPY.
+        {
+            std::lock_guard Lock(IoMutex);
+            LoadedLocal.swap(Loaded);
+        }
+        ID3D12GraphicsCommandList* CommandList = nullptr;
+        const size_t FirstNew = Uploads.size();
+        for (FLoaded& L : LoadedLocal) {
+            if (L.Generation != Generation) continue;
+            // Arquivo trocado no disco (outra cadeia) conta como falha: a textura fica como esta.
+            if (!L.Data.Valid() || L.Data.FirstMip != Policy.TargetMip(L.Texture)) {
+                LogWarning("TextureStreamer: falha ao ler mips de " + Entries[L.Texture].Path.string());
+                Policy.Complete(L.Texture, false);
+                continue;
+            }
+            if (!CommandList) CommandList = _UploadQueue.Begin();
+            Uploads.push_back({ L.Texture, FTexture::RecordFromCPU(_Device, CommandList, _SRVHeap, L.Data, _UploadQueue), 0 });
+        }
+        LoadedLocal.clear();
+        if (CommandList) {
+            const u64 Fence = _UploadQueue.Submit();
+            for (size_t i = FirstNew; i < Uploads.size(); ++i) Uploads[i].Fence = Fence;
+        }
+
+        // Demanda do frame. Chave 0 (camera dentro da caixa) cai no UvDensity <= 0 do DemandedMip,
+        // que devolve a mip 0 — o que a camera colada na superficie precisa mesmo.
+        if (!Enabled_) {
+            for (u32 t = 0; t < Policy.Count(); ++t) Policy.Request(t, 0.0f);
+        } else {
+            for (const auto& [Material, Key] : Demand) {
+                MaterialTextures(*Material, Slots);
+                for (FTexture* Texture : Slots) {
+                    const auto It = ByTexture.find(Texture);
+                    if (It == ByTexture.end()) continue;
+                    const FStreamedTextureDesc& Desc = Policy.Desc(It->second);
+                    Policy.Request(It->second, DemandedMip(DemandView, Desc.Width, Desc.Height, Key, 1.0f, 1.0f));
+                }
+            }
+        }
+
+        // Despejo ate a cauda fecha aqui mesmo (a cauda e o FTexture do loader); o resto vai ao IO.
+        bool Queued = false;
+        {
+            std::lock_guard Lock(IoMutex);
+            for (const FResidencyChange& Change : Policy.Update()) {
+                FEntry& Entry = Entries[Change.Texture];
+                if (Change.ToMip == Policy.TailMip(Change.Texture)) {
+                    Retire(std::exchange(Entry.Version, FTexture{}), FTextureSRVHeap::kInvalidSlot, _FrameIndex);
+                    Policy.Complete(Change.Texture);
+                    continue;
+                }
+                const FStreamedTextureDesc& Desc = Policy.Desc(Change.Texture);
+                Jobs.push_back({ Change.Texture, Generation, Entry.Path, Entry.SRGB,
+                                 std::max(1u, std::max(Desc.Width, Desc.Height) >> Change.ToMip) });
+                Queued = true;
+            }
+        }
+        if (Queued) IoWake.notify_one();
+
+        UpdateRasterTables(_Device, _SRVHeap, _Materials, _FrameIndex);
+    }
+
+    void FTextureStreamer::UpdateRasterTables(ID3D12Device* _Device, FTextureSRVHeap& _SRVHeap,
+                                              std::span<const std::unique_ptr<FMaterial>> _Materials,
+                                              u64 _FrameIndex) {
+        FRasterTable Want;
+        for (const std::unique_ptr<FMaterial>& Owned : _Materials) {
+            FMaterial* Material = Owned.get();
+            if (!Material->IsFinalized()) continue;
+            MaterialTextures(*Material, Want.Maps);
+            bool Streamed = false;
+            for (u32 s = 0; s < kMaterialTextureSlots; ++s) {
+                Want.Sources[s] = Material->AlbedoDescriptorIndex() + s;
+                const auto It = Want.Maps[s] ? ByTexture.find(Want.Maps[s]) : ByTexture.end();
+                if (It == ByTexture.end() || !Entries[It->second].Version.IsValid()) continue;
+                Want.Sources[s] = Entries[It->second].Version.SRVSlot();
+                Streamed = true;
+            }
+
+            const auto Found = RasterTables.find(Material);
+            if (!Streamed) {
+                if (Found == RasterTables.end()) continue;
+                Retire({}, Material->SetRasterTable(FTextureSRVHeap::kInvalidSlot), _FrameIndex);
+                RasterTables.erase(Found);
+                continue;
+            }
+            if (Found != RasterTables.end() &&
+                std::equal(std::begin(Want.Maps), std::end(Want.Maps), std::begin(Found->second.Maps)) &&
+                std::equal(std::begin(Want.Sources), std::end(Want.Sources), std::begin(Found->second.Sources)))
+                continue;
+
+            // Tabela nova, inteira: um slot da estavel que o editor reescreveu tambem tem de vir.
+            Want.Table = _SRVHeap.Allocate(kMaterialTextureSlots);
+            _SRVHeap.CopyTable(_Device, Want.Table, Want.Sources);
+            Retire({}, Material->SetRasterTable(Want.Table), _FrameIndex);
+            RasterTables[Material] = Want;
+        }
+    }
+
+    void FTextureStreamer::IoLoop(std::stop_token _Stop) {
+        for (;;) {
+            FJob Job;
+            {
+                std::unique_lock Lock(IoMutex);
+                if (!IoWake.wait(Lock, _Stop, [&] { return !Jobs.empty(); })) return;
+                Job = std::move(Jobs.front());
+                Jobs.pop_front();
+            }
+            FLoaded Out;
+            Out.Texture    = Job.Texture;
+            Out.Generation = Job.Generation;
+            try {
+                Out.Data = FTexture::LoadDDSCPU(Job.Path.wstring(), Job.SRGB, Job.MaxDimension);
+            } catch (const std::exception&) {
+                Out.Data = {}; // sem memoria: volta como falha e a politica desfaz a mudanca
+            }
+            std::lock_guard Lock(IoMutex);
+            Loaded.push_back(std::move(Out));
+        }
+    }
+}
@@ -83,8 +83,8 @@ namespace Smile {
         _CommandList->IASetIndexBuffer(&IndexBufferView);
     }
 
-    void FGpuMesh::DrawIndexed(ID3D12GraphicsCommandList* _CommandList) const {
-        _CommandList->DrawIndexedInstanced(IndexCount, 1, 0, 0, 0);
+    void FGpuMesh::DrawIndexed(ID3D12GraphicsCommandList* _CommandList, u32 _Instances) const {
+        _CommandList->DrawIndexedInstanced(IndexCount, _Instances, 0, 0, 0);
     }
 
     void FGpuMesh::Draw(ID3D12GraphicsCommandList* _CommandList) const {
@@ -102,12 +102,12 @@ namespace Smile {
     }
 
     void FDrawSubmitCache::DrawMesh(ID3D12GraphicsCommandList* _CommandList,
-                                    const FGpuMesh* _Mesh) {
+                                    const FGpuMesh* _Mesh, u32 _Instances) {
         if (!_Mesh || !_Mesh->IsValid()) return;
         if (_Mesh != LastMesh) {
             LastMesh = _Mesh;
             _Mesh->BindIA(_CommandList);
         }
-        _Mesh->DrawIndexed(_CommandList);
+        _Mesh->DrawIndexed(_CommandList, _Instances);
     }
 }
@@ -145,8 +145,15 @@ namespace Smile {
         _SRVHeap.CreateSRV(_Device, _Texture->Resource(), Desc, SRVTableStart + _LocalSlot);
     }
 
+    u32 FMaterial::SetRasterTable(u32 _Table) {
+        const u32 Previous = RasterTable;
+        RasterTable = _Table;
+        return Previous;
+    }
+
     void FMaterial::Bind(ID3D12GraphicsCommandList* _CommandList, FTextureSRVHeap& _SRVHeap) const {
         _CommandList->SetGraphicsRootConstantBufferView(1, CBGpuVA);
-        _CommandList->SetGraphicsRootDescriptorTable(2, _SRVHeap.GpuHandle(SRVTableStart));
+        _CommandList->SetGraphicsRootDescriptorTable(
+            2, _SRVHeap.GpuHandle(RasterTable != kInvalidTable ? RasterTable : SRVTableStart));
     }
 }
@@ -0,0 +1,509 @@
+#include "Smile/Graphics/Resources/MipChain.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define SMILE_MIP_X64 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// O MSVC aceita intrinsics SSE4.1/AVX2 sem /arch; quem decide se a via roda e o DetectMipPath.
+#define SMILE_MIP_SSE41_FN
+#define SMILE_MIP_AVX2_FN
+#else
+// GCC/Clang so geram SSE4.1/AVX2 dentro de uma funcao marcada. Sem "fma" de proposito: uma
+// contracao a*b+c mudaria o arredondamento e a via deixaria de bater com a escalar.
+#define SMILE_MIP_SSE41_FN __attribute__((target("sse4.1")))
+#define SMILE_MIP_AVX2_FN  __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Smile {
+    namespace {
+        constexpr u32 kSrgbBuckets = 4096;
+
+        // Tabelas do linear -> sRGB das vias SIMD. Mid[i] = ponto medio (em linear) entre os
+        // niveis i e i+1, com uma sentinela acima de 1 no fim; Start[b] = quantos pontos medios
+        // ficam <= b / kSrgbBuckets, ou seja, o nivel no inicio do balde b.
+        struct FSrgbEncodeTables {
+            std::array<f32, 256>              Mid{};
+            std::array<i32, kSrgbBuckets + 1> Start{};
+        };
+
+        const FSrgbEncodeTables& SrgbEncodeTables() {
+            static const FSrgbEncodeTables Tables = [] {
+                FSrgbEncodeTables T;
+                const f32* Lin = SrgbToLinearLUT();
+                for (int i = 0; i < 255; ++i) T.Mid[i] = 0.5f * (Lin[i] + Lin[i + 1]);
+                T.Mid[255] = 2.0f;
+                i32 Level = 0;
+                for (u32 b = 0; b <= kSrgbBuckets; ++b) {
+                    const f32 Edge = static_cast<f32>(b) / static_cast<f32>(kSrgbBuckets);
+                    while (Level < 255 && T.Mid[Level] <= Edge) ++Level;
+                    T.Start[b] = Level;
+                }
+                return T;
+            }();
+            return Tables;
+        }
+
+        // Um pixel de saida do box de cor, exatamente como o laco que ja existia.
+        void ColorPixel(const u8* _P00, const u8* _P01, const u8* _P10, const u8* _P11, u8* _D,
+                        const f32* _ToLin) {
+            for (u32 c = 0; c < 3; ++c) {
+                if (_ToLin) {
+                    const f32 L = 0.25f * (_ToLin[_P00[c]] + _ToLin[_P01[c]] +
+                                           _ToLin[_P10[c]] + _ToLin[_P11[c]]);
+                    _D[c] = LinearToSrgbU8(L);
+                } else {
+                    _D[c] = static_cast<u8>((u32(_P00[c]) + _P01[c] + _P10[c] + _P11[c] + 2) / 4);
+                }
+            }
+            _D[3] = static_cast<u8>((u32(_P00[3]) + _P01[3] + _P10[3] + _P11[3] + 2) / 4);
+        }
+
+        // Um pixel de saida do box de normal; devolve o T (comprimento medio) gravado no alfa.
+        f32 NormalPixel(const u8* const (&_P)[4], u8* _D) {
+            f32 nx = 0, ny = 0, nz = 0;
+            for (int i = 0; i < 4; ++i) {
+                f32 vx = _P[i][0] / 255.0f * 2.0f - 1.0f;
+                f32 vy = _P[i][1] / 255.0f * 2.0f - 1.0f;
+                f32 vz = _P[i][2] / 255.0f * 2.0f - 1.0f;
+                const f32 len = std::sqrt(vx * vx + vy * vy + vz * vz);
+                if (len > 1e-6f) { vx /= len; vy /= len; vz /= len; }
+                nx += vx; ny += vy; nz += vz;
+            }
+            const f32 sumLen = std::sqrt(nx * nx + ny * ny + nz * nz);
+            f32 T = sumLen / 4.0f;
+            if (T < 1e-4f) T = 1e-4f;
+
+            // Quatro normais que se anulam dao sumLen 0 e NaN aqui: o canal sai 0, o mesmo que a
+            // conversao de NaN da em x64 (e o que as vias SIMD reproduzem).
+            const f32 invLen = 1.0f / sumLen;
+            const f32 ox = nx * invLen;
+            const f32 oy = ny * invLen;
+            const f32 oz = nz * invLen;
+            _D[0] = static_cast<u8>(std::clamp((ox * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
+            _D[1] = static_cast<u8>(std::clamp((oy * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
+            _D[2] = static_cast<u8>(std::clamp((oz * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
+            _D[3] = static_cast<u8>(std::clamp(T * 255.0f + 0.5f, 0.0f, 255.0f));
+            return T;
+        }
+
+        // Linha y da saida: os dois ponteiros de linha da fonte, repetindo a ultima se SrcH e 1.
+        struct FRowPair {
+            const u8* R0;
+            const u8* R1;
+        };
+
+        FRowPair RowsOf(const u8* _Src, u32 _SrcW, u32 _SrcH, u32 _Y) {
+            const u32 sy0 = std::min(_Y * 2u,      _SrcH - 1);
+            const u32 sy1 = std::min(_Y * 2u + 1u, _SrcH - 1);
+            return { _Src + static_cast<size_t>(sy0) * _SrcW * 4, _Src + static_cast<size_t>(sy1) * _SrcW * 4 };
+        }
+
+        // Pixels [_X, _DstW) de uma linha pelo caminho escalar: a cauda das vias SIMD e a via
+        // escalar inteira.
+        void ColorTail(FRowPair _Rows, u32 _SrcW, u8* _DstRow, u32 _X, u32 _DstW, const f32* _ToLin) {
+            for (u32 x = _X; x < _DstW; ++x) {
+                const u32 sx0 = std::min(x * 2u,      _SrcW - 1) * 4;
+                const u32 sx1 = std::min(x * 2u + 1u, _SrcW - 1) * 4;
+                ColorPixel(_Rows.R0 + sx0, _Rows.R0 + sx1, _Rows.R1 + sx0, _Rows.R1 + sx1, _DstRow + x * 4, _ToLin);
+            }
+        }
+
+        void NormalTail(FRowPair _Rows, u32 _SrcW, u8* _DstRow, u32 _X, u32 _DstW, f32* _T) {
+            for (u32 x = _X; x < _DstW; ++x) {
+                const u32 sx0 = std::min(x * 2u,      _SrcW - 1) * 4;
+                const u32 sx1 = std::min(x * 2u + 1u, _SrcW - 1) * 4;
+                const u8* P[4] = { _Rows.R0 + sx0, _Rows.R0 + sx1, _Rows.R1 + sx0, _Rows.R1 + sx1 };
+                _T[x] = NormalPixel(P, _DstRow + x * 4);
+            }
+        }
+
+#if defined(SMILE_MIP_X64)
+        // ---- SSE4.1: 4 pixels de saida (8 texels por linha de fonte) ----
+        //
+        // Uma linha de 8 texels RGBA vira, por canal, os texels PARES (canto esquerdo do 2x2) e os
+        // IMPARES (canto direito), 4 i32 cada, na ordem dos pixels de saida.
+        SMILE_MIP_SSE41_FN void SplitRowSSE(const u8* _Row, __m128i (&_Even)[4], __m128i (&_Odd)[4]) {
+            // [R0 R2 G0 G2 B0 B2 A0 A2 R1 R3 G1 G3 B1 B3 A1 A3] de cada bloco de 4 texels.
+            const __m128i Group = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+            const __m128i A = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_Row)), Group);
+            const __m128i B = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_Row + 16)), Group);
+            // Pares de 16 bits intercalados: [R pares | G pares | B pares | A pares], 4 bytes cada.
+            const __m128i Lo = _mm_unpacklo_epi16(A, B);
+            const __m128i Hi = _mm_unpackhi_epi16(A, B);
+            _Even[0] = _mm_cvtepu8_epi32(Lo);
+            _Even[1] = _mm_cvtepu8_epi32(_mm_srli_si128(Lo, 4));
+            _Even[2] = _mm_cvtepu8_epi32(_mm_srli_si128(Lo, 8));
+            _Even[3] = _mm_cvtepu8_epi32(_mm_srli_si128(Lo, 12));
+            _Odd[0]  = _mm_cvtepu8_epi32(Hi);
+            _Odd[1]  = _mm_cvtepu8_epi32(_mm_srli_si128(Hi, 4));
+            _Odd[2]  = _mm_cvtepu8_epi32(_mm_srli_si128(Hi, 8));
+            _Odd[3]  = _mm_cvtepu8_epi32(_mm_srli_si128(Hi, 12));
+        }
+
+        // 4 i32 por canal (0..255) -> 4 pixels RGBA intercalados.
+        SMILE_MIP_SSE41_FN void StoreRGBA_SSE(u8* _Dst, __m128i _R, __m128i _G, __m128i _B, __m128i _A) {
+            const __m128i Planar = _mm_packus_epi16(_mm_packus_epi32(_R, _G), _mm_packus_epi32(_B, _A));
+            const __m128i Interleave = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(_Dst), _mm_shuffle_epi8(Planar, Interleave));
+        }
+
+        // Sem gather no SSE: as 4 leituras de tabela saem uma a uma, a conta em volta e vetorial.
+        SMILE_MIP_SSE41_FN __m128 LookupSSE(const f32* _Table, __m128i _Index) {
+            return _mm_setr_ps(_Table[_mm_extract_epi32(_Index, 0)], _Table[_mm_extract_epi32(_Index, 1)],
+                               _Table[_mm_extract_epi32(_Index, 2)], _Table[_mm_extract_epi32(_Index, 3)]);
+        }
+
+        SMILE_MIP_SSE41_FN __m128i LookupSSE(const i32* _Table, __m128i _Index) {
+            return _mm_setr_epi32(_Table[_mm_extract_epi32(_Index, 0)], _Table[_mm_extract_epi32(_Index, 1)],
+                                  _Table[_mm_extract_epi32(_Index, 2)], _Table[_mm_extract_epi32(_Index, 3)]);
+        }
+
+        SMILE_MIP_SSE41_FN __m128i AverageIntSSE(__m128i _A, __m128i _B, __m128i _C, __m128i _D) {
+            const __m128i Sum = _mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_A, _B), _C), _D);
+            return _mm_srli_epi32(_mm_add_epi32(Sum, _mm_set1_epi32(2)), 2);
+        }
+
+        SMILE_MIP_SSE41_FN void DownsampleColorSSE(const u8* _Src, u32 _SrcW, u32 _SrcH,
+                                                   u8* _Dst, u32 _DstW, u32 _DstH, bool _SrgbSpace) {
+            const f32* ToLin = _SrgbSpace ? SrgbToLinearLUT() : nullptr;
+            const FSrgbEncodeTables& Enc = SrgbEncodeTables();
+            const __m128  Quarter = _mm_set1_ps(0.25f);
+            const __m128  Scale   = _mm_set1_ps(static_cast<f32>(kSrgbBuckets));
+            const __m128i MaxB    = _mm_set1_epi32(static_cast<i32>(kSrgbBuckets));
+            const u32 Blocks = (_SrcW / 2) < _DstW ? (_SrcW / 2) / 4 : _DstW / 4;
+            for (u32 y = 0; y < _DstH; ++y) {
+                const FRowPair Rows = RowsOf(_Src, _SrcW, _SrcH, y);
+                u8* DstRow = _Dst + static_cast<size_t>(y) * _DstW * 4;
+                for (u32 b = 0; b < Blocks; ++b) {
+                    __m128i E0[4], O0[4], E1[4], O1[4];
+                    SplitRowSSE(Rows.R0 + b * 32, E0, O0);
+                    SplitRowSSE(Rows.R1 + b * 32, E1, O1);
+                    __m128i Out[4];
+                    for (int c = 0; c < 4; ++c) Out[c] = AverageIntSSE(E0[c], O0[c], E1[c], O1[c]);
+                    if (ToLin) {
+                        for (int c = 0; c < 3; ++c) {
+                            const __m128 Sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(LookupSSE(ToLin, E0[c]),
+                                                                                LookupSSE(ToLin, O0[c])),
+                                                                     LookupSSE(ToLin, E1[c])),
+                                                          LookupSSE(ToLin, O1[c]));
+                            const __m128  L     = _mm_mul_ps(Quarter, Sum);
+                            const __m128i Bkt   = _mm_min_epi32(_mm_cvttps_epi32(_mm_mul_ps(L, Scale)), MaxB);
+                            const __m128i Start = LookupSSE(Enc.Start.data(), Bkt);
+                            const __m128  Mid   = LookupSSE(Enc.Mid.data(), Start);
+                            // Comparacao verdadeira = -1: subtrair soma 1.
+                            Out[c] = _mm_sub_epi32(Start, _mm_castps_si128(_mm_cmple_ps(Mid, L)));
+                        }
+                    }
+                    StoreRGBA_SSE(DstRow + b * 16, Out[0], Out[1], Out[2], Out[3]);
+                }
+                ColorTail(Rows, _SrcW, DstRow, Blocks * 4, _DstW, ToLin);
+            }
+        }
+
+        // Um canto do 2x2 de normal: u8 -> [-1, 1], normalizado se tiver comprimento, somado.
+        SMILE_MIP_SSE41_FN void AccumulateNormalSSE(__m128i _X, __m128i _Y, __m128i _Z,
+                                                    __m128& _Nx, __m128& _Ny, __m128& _Nz) {
+            const __m128 K255 = _mm_set1_ps(255.0f), Two = _mm_set1_ps(2.0f), One = _mm_set1_ps(1.0f);
+            __m128 vx = _mm_sub_ps(_mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(_X), K255), Two), One);
+            __m128 vy = _mm_sub_ps(_mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(_Y), K255), Two), One);
+            __m128 vz = _mm_sub_ps(_mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(_Z), K255), Two), One);
+            const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)),
+                                                      _mm_mul_ps(vz, vz)));
+            const __m128 Has = _mm_cmpgt_ps(len, _mm_set1_ps(1e-6f));
+            vx = _mm_blendv_ps(vx, _mm_div_ps(vx, len), Has);
+            vy = _mm_blendv_ps(vy, _mm_div_ps(vy, len), Has);
+            vz = _mm_blendv_ps(vz, _mm_div_ps(vz, len), Has);
+            _Nx = _mm_add_ps(_Nx, vx);
+            _Ny = _mm_add_ps(_Ny, vy);
+            _Nz = _mm_add_ps(_Nz, vz);
+        }
+
+        // (v * 0.5 + 0.5) * 255 + 0.5, preso a [0, 255] e truncado. max(NaN, 0) = 0, como o escalar.
+        SMILE_MIP_SSE41_FN __m128i UnitToByteSSE(__m128 _V) {
+            const __m128 Half = _mm_set1_ps(0.5f);
+            const __m128 B = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_V, Half), Half), _mm_set1_ps(255.0f)), Half);
+            return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(B, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+        }
+
+        SMILE_MIP_SSE41_FN void DownsampleNormalSSE(const u8* _Src, u32 _SrcW, u32 _SrcH,
+                                                    u8* _Dst, u32 _DstW, u32 _DstH, f32* _RowT) {
+            const u32 Blocks = (_SrcW / 2) < _DstW ? (_SrcW / 2) / 4 : _DstW / 4;
+            for (u32 y = 0; y < _DstH; ++y) {
+                const FRowPair Rows = RowsOf(_Src, _SrcW, _SrcH, y);
+                u8* DstRow = _Dst + static_cast<size_t>(y) * _DstW * 4;
+                f32* T = _RowT + static_cast<size_t>(y) * _DstW;
+                for (u32 b = 0; b < Blocks; ++b) {
+                    __m128i E0[4], O0[4], E1[4], O1[4];
+                    SplitRowSSE(Rows.R0 + b * 32, E0, O0);
+                    SplitRowSSE(Rows.R1 + b * 32, E1, O1);
+                    __m128 nx = _mm_setzero_ps(), ny = _mm_setzero_ps(), nz = _mm_setzero_ps();
+                    AccumulateNormalSSE(E0[0], E0[1], E0[2], nx, ny, nz);
+                    AccumulateNormalSSE(O0[0], O0[1], O0[2], nx, ny, nz);
+                    AccumulateNormalSSE(E1[0], E1[1], E1[2], nx, ny, nz);
+                    AccumulateNormalSSE(O1[0], O1[1], O1[2], nx, ny, nz);
+                    const __m128 sumLen = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                                                                 _mm_mul_ps(nz, nz)));
+                    const __m128 Tv     = _mm_max_ps(_mm_div_ps(sumLen, _mm_set1_ps(4.0f)), _mm_set1_ps(1e-4f));
+                    const __m128 invLen = _mm_div_ps(_mm_set1_ps(1.0f), sumLen);
+                    const __m128 Tb     = _mm_add_ps(_mm_mul_ps(Tv, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+                    StoreRGBA_SSE(DstRow + b * 16, UnitToByteSSE(_mm_mul_ps(nx, invLen)),
+                                  UnitToByteSSE(_mm_mul_ps(ny, invLen)), UnitToByteSSE(_mm_mul_ps(nz, invLen)),
+                                  _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(Tb, _mm_setzero_ps()), _mm_set1_ps(255.0f))));
+                    _mm_storeu_ps(T + b * 4, Tv);
+                }
+                NormalTail(Rows, _SrcW, DstRow, Blocks * 4, _DstW, T);
+            }
+        }
+
+        // ---- AVX2: 8 pixels de saida (16 texels por linha de fonte) ----
+        //
+        // Mesmo arranjo do SSE em cada metade de 128 bits: a metade baixa fica com os pixels de
+        // saida 0..3, a alta com 4..7, e o empacotamento no fim e por metade tambem.
+        SMILE_MIP_AVX2_FN void SplitRowAVX2(const u8* _Row, __m256i (&_Even)[4], __m256i (&_Odd)[4]) {
+            const __m256i Lo16 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_Row));
+            const __m256i Hi16 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_Row + 32));
+            // A = texels [0..3 | 8..11], B = [4..7 | 12..15].
+            const __m256i Group = _mm256_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+                                                   0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+            const __m256i A = _mm256_shuffle_epi8(_mm256_permute2x128_si256(Lo16, Hi16, 0x20), Group);
+            const __m256i B = _mm256_shuffle_epi8(_mm256_permute2x128_si256(Lo16, Hi16, 0x31), Group);
+            const __m256i Lo = _mm256_unpacklo_epi16(A, B);
+            const __m256i Hi = _mm256_unpackhi_epi16(A, B);
+            for (int c = 0; c < 4; ++c) {
+                // Bytes 4c..4c+3 de cada metade estendidos a 4 i32.
+                const char k = static_cast<char>(4 * c);
+                const __m256i Expand = _mm256_setr_epi8(k, -1, -1, -1, k + 1, -1, -1, -1, k + 2, -1, -1, -1, k + 3, -1, -1, -1,
+                                                        k, -1, -1, -1, k + 1, -1, -1, -1, k + 2, -1, -1, -1, k + 3, -1, -1, -1);
+                _Even[c] = _mm256_shuffle_epi8(Lo, Expand);
+                _Odd[c]  = _mm256_shuffle_epi8(Hi, Expand);
+            }
+        }
+
+        SMILE_MIP_AVX2_FN void StoreRGBA_AVX2(u8* _Dst, __m256i _R, __m256i _G, __m256i _B, __m256i _A) {
+            const __m256i Planar = _mm256_packus_epi16(_mm256_packus_epi32(_R, _G), _mm256_packus_epi32(_B, _A));
+            const __m256i Interleave = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                                        0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(_Dst), _mm256_shuffle_epi8(Planar, Interleave));
+        }
+
+        SMILE_MIP_AVX2_FN __m256i AverageIntAVX2(__m256i _A, __m256i _B, __m256i _C, __m256i _D) {
+            const __m256i Sum = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(_A, _B), _C), _D);
+            return _mm256_srli_epi32(_mm256_add_epi32(Sum, _mm256_set1_epi32(2)), 2);
+        }
+
+        SMILE_MIP_AVX2_FN void DownsampleColorAVX2(const u8* _Src, u32 _SrcW, u32 _SrcH,
+                                                   u8* _Dst, u32 _DstW, u32 _DstH, bool _SrgbSpace) {
+            const f32* ToLin = _SrgbSpace ? SrgbToLinearLUT() : nullptr;
+            const FSrgbEncodeTables& Enc = SrgbEncodeTables();
+            const __m256  Quarter = _mm256_set1_ps(0.25f);
+            const __m256  Scale   = _mm256_set1_ps(static_cast<f32>(kSrgbBuckets));
+            const __m256i MaxB    = _mm256_set1_epi32(static_cast<i32>(kSrgbBuckets));
+            const u32 Blocks = (_SrcW / 2) < _DstW ? (_SrcW / 2) / 8 : _DstW / 8;
+            for (u32 y = 0; y < _DstH; ++y) {
+                const FRowPair Rows = RowsOf(_Src, _SrcW, _SrcH, y);
+                u8* DstRow = _Dst + static_cast<size_t>(y) * _DstW * 4;
+                for (u32 b = 0; b < Blocks; ++b) {
+                    __m256i E0[4], O0[4], E1[4], O1[4];
+                    SplitRowAVX2(Rows.R0 + b * 64, E0, O0);
+                    SplitRowAVX2(Rows.R1 + b * 64, E1, O1);
+                    __m256i Out[4];
+                    for (int c = 0; c < 4; ++c) Out[c] = AverageIntAVX2(E0[c], O0[c], E1[c], O1[c]);
+                    if (ToLin) {
+                        for (int c = 0; c < 3; ++c) {
+                            const __m256 Sum = _mm256_add_ps(
+                                _mm256_add_ps(_mm256_add_ps(_mm256_i32gather_ps(ToLin, E0[c], 4),
+                                                            _mm256_i32gather_ps(ToLin, O0[c], 4)),
+                                              _mm256_i32gather_ps(ToLin, E1[c], 4)),
+                                _mm256_i32gather_ps(ToLin, O1[c], 4));
+                            const __m256  L     = _mm256_mul_ps(Quarter, Sum);
+                            const __m256i Bkt   = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(L, Scale)), MaxB);
+                            const __m256i Start = _mm256_i32gather_epi32(Enc.Start.data(), Bkt, 4);
+                            const __m256  Mid   = _mm256_i32gather_ps(Enc.Mid.data(), Start, 4);
+                            Out[c] = _mm256_sub_epi32(Start, _mm256_castps_si256(_mm256_cmp_ps(Mid, L, _CMP_LE_OQ)));
+                        }
+                    }
+                    StoreRGBA_AVX2(DstRow + b * 32, Out[0], Out[1], Out[2], Out[3]);
+                }
+                ColorTail(Rows, _SrcW, DstRow, Blocks * 8, _DstW, ToLin);
+            }
+        }
+
+        SMILE_MIP_AVX2_FN void AccumulateNormalAVX2(__m256i _X, __m256i _Y, __m256i _Z,
+                                                    __m256& _Nx, __m256& _Ny, __m256& _Nz) {
+            const __m256 K255 = _mm256_set1_ps(255.0f), Two = _mm256_set1_ps(2.0f), One = _mm256_set1_ps(1.0f);
+            __m256 vx = _mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_X), K255), Two), One);
+            __m256 vy = _mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_Y), K255), Two), One);
+            __m256 vz = _mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_Z), K255), Two), One);
+            const __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)),
+                                                            _mm256_mul_ps(vz, vz)));
+            const __m256 Has = _mm256_cmp_ps(len, _mm256_set1_ps(1e-6f), _CMP_GT_OQ);
+            vx = _mm256_blendv_ps(vx, _mm256_div_ps(vx, len), Has);
+            vy = _mm256_blendv_ps(vy, _mm256_div_ps(vy, len), Has);
+            vz = _mm256_blendv_ps(vz, _mm256_div_ps(vz, len), Has);
+            _Nx = _mm256_add_ps(_Nx, vx);
+            _Ny = _mm256_add_ps(_Ny, vy);
+            _Nz = _mm256_add_ps(_Nz, vz);
+        }
+
+        SMILE_MIP_AVX2_FN __m256i UnitToByteAVX2(__m256 _V) {
+            const __m256 Half = _mm256_set1_ps(0.5f);
+            const __m256 B = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_V, Half), Half),
+                                                         _mm256_set1_ps(255.0f)), Half);
+            return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(B, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)));
+        }
+
+        SMILE_MIP_AVX2_FN void DownsampleNormalAVX2(const u8* _Src, u32 _SrcW, u32 _SrcH,
+                                                    u8* _Dst, u32 _DstW, u32 _DstH, f32* _RowT) {
+            const u32 Blocks = (_SrcW / 2) < _DstW ? (_SrcW / 2) / 8 : _DstW / 8;
+            for (u32 y = 0; y < _DstH; ++y) {
+                const FRowPair Rows = RowsOf(_Src, _SrcW, _SrcH, y);
+                u8* DstRow = _Dst + static_cast<size_t>(y) * _DstW * 4;
+                f32* T = _RowT + static_cast<size_t>(y) * _DstW;
+                for (u32 b = 0; b < Blocks; ++b) {
+                    __m256i E0[4], O0[4], E1[4], O1[4];
+                    SplitRowAVX2(Rows.R0 + b * 64, E0, O0);
+                    SplitRowAVX2(Rows.R1 + b * 64, E1, O1);
+                    __m256 nx = _mm256_setzero_ps(), ny = _mm256_setzero_ps(), nz = _mm256_setzero_ps();
+                    AccumulateNormalAVX2(E0[0], E0[1], E0[2], nx, ny, nz);
+                    AccumulateNormalAVX2(O0[0], O0[1], O0[2], nx, ny, nz);
+                    AccumulateNormalAVX2(E1[0], E1[1], E1[2], nx, ny, nz);
+                    AccumulateNormalAVX2(O1[0], O1[1], O1[2], nx, ny, nz);
+                    const __m256 sumLen = _mm256_sqrt_ps(_mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(nx, nx), _mm256_mul_ps(ny, ny)), _mm256_mul_ps(nz, nz)));
+                    const __m256 Tv     = _mm256_max_ps(_mm256_div_ps(sumLen, _mm256_set1_ps(4.0f)), _mm256_set1_ps(1e-4f));
+                    const __m256 invLen = _mm256_div_ps(_mm256_set1_ps(1.0f), sumLen);
+                    const __m256 Tb     = _mm256_add_ps(_mm256_mul_ps(Tv, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+                    StoreRGBA_AVX2(DstRow + b * 32, UnitToByteAVX2(_mm256_mul_ps(nx, invLen)),
+                                   UnitToByteAVX2(_mm256_mul_ps(ny, invLen)), UnitToByteAVX2(_mm256_mul_ps(nz, invLen)),
+                                   _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(Tb, _mm256_setzero_ps()),
+                                                                     _mm256_set1_ps(255.0f))));
+                    _mm256_storeu_ps(T + b * 8, Tv);
+                }
+                NormalTail(Rows, _SrcW, DstRow, Blocks * 8, _DstW, T);
+            }
+        }
+
+        bool CpuHasSSE41() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int Info[4];
+            __cpuid(Info, 1);
+            return (Info[2] & (1 << 19)) != 0;
+#else
+            return __builtin_cpu_supports("sse4.1");
+#endif
+        }
+
+        bool CpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int Info[4];
+            __cpuid(Info, 1);
+            const bool OsSaves = (Info[2] & (1 << 27)) != 0; // OSXSAVE
+            const bool Avx     = (Info[2] & (1 << 28)) != 0;
+            __cpuidex(Info, 7, 0);
+            const bool Avx2 = (Info[1] & (1 << 5)) != 0;
+            // O SO precisa salvar os registradores YMM na troca de contexto (XCR0 bits 1 e 2).
+            return OsSaves && Avx && Avx2 && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        EMipPath Resolve(EMipPath _Wanted) {
+            const EMipPath Best = DetectMipPath();
+            return static_cast<u8>(_Wanted) < static_cast<u8>(Best) ? _Wanted : Best;
+        }
+    }
+
+    EMipPath DetectMipPath() {
+#if defined(SMILE_MIP_X64)
+        static const EMipPath Best = CpuHasAVX2() ? EMipPath::AVX2 : CpuHasSSE41() ? EMipPath::SSE41 : EMipPath::Scalar;
+        return Best;
+#else
+        return EMipPath::Scalar;
+#endif
+    }
+
+    const char* MipPathName(EMipPath _Path) {
+        switch (_Path) {
+            case EMipPath::SSE41: return "SSE4.1";
+            case EMipPath::AVX2:  return "AVX2";
+            default:              return "escalar";
+        }
+    }
+
+    const f32* SrgbToLinearLUT() {
+        static const std::array<f32, 256> Lut = [] {
+            std::array<f32, 256> T{};
+            for (int i = 0; i < 256; ++i) {
+                const f32 c = f32(i) / 255.0f;
+                T[i] = (c <= 0.04045f) ? (c / 12.92f)
+                                       : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return T;
+        }();
+        return Lut.data();
+    }
+
+    // Sem pow no loop quente: a saida e u8, entao basta a tabela dos PONTOS MEDIOS (em linear)
+    // entre niveis sRGB consecutivos — o upper_bound devolve o nivel mais proximo em 8
+    // comparacoes, com arredondamento exato.
+    u8 LinearToSrgbU8(f32 _L) {
+        const auto& Mid = SrgbEncodeTables().Mid;
+        const auto It = std::upper_bound(Mid.begin(), Mid.begin() + 255, _L);
+        return static_cast<u8>(It - Mid.begin());
+    }
+
+    // _SrgbSpace = os bytes de ENTRADA estao codificados em sRGB (albedo/emissivo). Nesse caso
+    // a media tem que acontecer em LINEAR: media aritmetica de bytes gama escurece a mip. Um
+    // 2x2 de 0 e 255 dava 127 (que o hardware le como ~0.216 linear) quando o certo e 0.5
+    // linear = 188 em sRGB. O erro aparece em toda mip de toda textura nao-DDS, acumulando
+    // nivel a nivel — as DDS escapam porque trazem a mip chain pronta do disco.
+    //
+    // Mapas de dado (roughness/metal/AO/height) tem _SrgbSpace = false e seguem na media
+    // direta, que para eles ja e a correta: sao lidos como UNORM, nao ha gama envolvida.
+    //
+    // O ALFA nunca passa pela conversao, mesmo em textura sRGB: alfa e linear por definicao
+    // no formato, e e ele que alimenta o clip do alpha-test.
+    void DownsampleColor2x2(const u8* _Src, u32 _SrcW, u32 _SrcH, u8* _Dst, u32 _DstW, u32 _DstH,
+                            bool _SrgbSpace, EMipPath _Path) {
+        switch (Resolve(_Path)) {
+#if defined(SMILE_MIP_X64)
+            case EMipPath::AVX2:  DownsampleColorAVX2(_Src, _SrcW, _SrcH, _Dst, _DstW, _DstH, _SrgbSpace); return;
+            case EMipPath::SSE41: DownsampleColorSSE(_Src, _SrcW, _SrcH, _Dst, _DstW, _DstH, _SrgbSpace); return;
+#endif
+            default: break;
+        }
+        const f32* ToLin = _SrgbSpace ? SrgbToLinearLUT() : nullptr;
+        for (u32 y = 0; y < _DstH; ++y)
+            ColorTail(RowsOf(_Src, _SrcW, _SrcH, y), _SrcW, _Dst + static_cast<size_t>(y) * _DstW * 4, 0, _DstW, ToLin);
+    }
+
+    f32 DownsampleNormal2x2(const u8* _Src, u32 _SrcW, u32 _SrcH, u8* _Dst, u32 _DstW, u32 _DstH,
+                            EMipPath _Path) {
+        // T por pixel num buffer e a soma em double na ordem de varredura depois: a media sai a
+        // mesma em qualquer via.
+        std::vector<f32> T(static_cast<size_t>(_DstW) * _DstH);
+        switch (Resolve(_Path)) {
+#if defined(SMILE_MIP_X64)
+            case EMipPath::AVX2:  DownsampleNormalAVX2(_Src, _SrcW, _SrcH, _Dst, _DstW, _DstH, T.data()); break;
+            case EMipPath::SSE41: DownsampleNormalSSE(_Src, _SrcW, _SrcH, _Dst, _DstW, _DstH, T.data()); break;
+#endif
+            default:
+                for (u32 y = 0; y < _DstH; ++y)
+                    NormalTail(RowsOf(_Src, _SrcW, _SrcH, y), _SrcW, _Dst + static_cast<size_t>(y) * _DstW * 4, 0,
+                               _DstW, T.data() + static_cast<size_t>(y) * _DstW);
+                break;
+        }
+        double TSum = 0.0;
+        for (const f32 t : T) TSum += t;
+        return T.empty() ? 1.0f : static_cast<f32>(TSum / static_cast<double>(T.size()));
+    }
+}
@@ -1,4 +1,5 @@
 #include "Smile/Graphics/Resources/Texture.h"
+#include "Smile/Graphics/Resources/MipChain.h"
 #include "Smile/Graphics/Backend/D3D12/GpuResources.h"
 #include "Smile/Graphics/Backend/D3D12/UploadQueue.h"
 #include "Smile/Core/HResultCheck.h"
@@ -34,122 +35,6 @@ namespace Smile {
         return (Size + Align - 1) & ~(Align - 1);
     }
 
-    namespace {
-        // sRGB -> linear, 256 entradas (o dominio de entrada e um u8, entao a tabela e exata).
-        const float* SrgbToLinearLUT() {
-            static const std::array<float, 256> Lut = [] {
-                std::array<float, 256> T{};
-                for (int i = 0; i < 256; ++i) {
-                    const float c = float(i) / 255.0f;
-                    T[i] = (c <= 0.04045f) ? (c / 12.92f)
-                                           : std::pow((c + 0.055f) / 1.055f, 2.4f);
-                }
-                return T;
-            }();
-            return Lut.data();
-        }
-
-        // linear -> sRGB. Sem pow no loop quente: a saida e u8, entao basta a tabela dos PONTOS
-        // MEDIOS (em linear) entre niveis sRGB consecutivos — o upper_bound devolve o nivel mais
-        // proximo em 8 comparacoes, com arredondamento exato. Um pow por canal por texel custaria
-        // ~16M chamadas numa textura 2K (mip chain inteira), em 135 PNGs so no Sponza.
-        u8 LinearToSrgbU8(float _L) {
-            static const std::array<float, 255> Mid = [] {
-                const float* Lin = SrgbToLinearLUT();
-                std::array<float, 255> M{};
-                for (int i = 0; i < 255; ++i) M[i] = 0.5f * (Lin[i] + Lin[i + 1]);
-                return M;
-            }();
-            const auto It = std::upper_bound(Mid.begin(), Mid.end(), _L);
-            return static_cast<u8>(It - Mid.begin());
-        }
-
-        // _SrgbSpace = os bytes de ENTRADA estao codificados em sRGB (albedo/emissivo). Nesse caso
-        // a media tem que acontecer em LINEAR: media aritmetica de bytes gama escurece a mip. Um
-        // 2x2 de 0 e 255 dava 127 (que o hardware le como ~0.216 linear) quando o certo e 0.5
-        // linear = 188 em sRGB. O erro aparece em toda mip de toda textura nao-DDS, acumulando
-        // nivel a nivel — as DDS escapam porque trazem a mip chain pronta do disco.
-        //
-        // Mapas de dado (roughness/metal/AO/height) tem _SrgbSpace = false e seguem na media
-        // direta, que para eles ja e a correta: sao lidos como UNORM, nao ha gama envolvida.
-        //
-        // O ALFA nunca passa pela conversao, mesmo em textura sRGB: alfa e linear por definicao
-        // no formato, e e ele que alimenta o clip do alpha-test.
-        void DownsampleColor2x2(const u8* Src, u32 SrcW, u32 SrcH,
-                                u8* Dst, u32 DstW, u32 DstH, bool _SrgbSpace) {
-            const float* ToLin = _SrgbSpace ? SrgbToLinearLUT() : nullptr;
-            for (u32 y = 0; y < DstH; ++y) {
-                u32 sy0 = std::min(y * 2u,       SrcH - 1);
-                u32 sy1 = std::min(y * 2u + 1u,  SrcH - 1);
-                for (u32 x = 0; x < DstW; ++x) {
-                    u32 sx0 = std::min(x * 2u,       SrcW - 1);
-                    u32 sx1 = std::min(x * 2u + 1u,  SrcW - 1);
-                    const u8* p00 = Src + (sy0 * SrcW + sx0) * 4;
-                    const u8* p01 = Src + (sy0 * SrcW + sx1) * 4;
-                    const u8* p10 = Src + (sy1 * SrcW + sx0) * 4;
-                    const u8* p11 = Src + (sy1 * SrcW + sx1) * 4;
-                    u8* d = Dst + (y * DstW + x) * 4;
-                    for (u32 c = 0; c < 3; ++c) {
-                        if (ToLin) {
-                            const float L = 0.25f * (ToLin[p00[c]] + ToLin[p01[c]] +
-                                                     ToLin[p10[c]] + ToLin[p11[c]]);
-                            d[c] = LinearToSrgbU8(L);
-                        } else {
-                            d[c] = static_cast<u8>((u32(p00[c]) + p01[c] + p10[c] + p11[c] + 2) / 4);
-                        }
-                    }
-                    d[3] = static_cast<u8>((u32(p00[3]) + p01[3] + p10[3] + p11[3] + 2) / 4);
-                }
-            }
-        }
-
-        float DownsampleNormal2x2(const u8* Src, u32 SrcW, u32 SrcH,
-                                  u8* Dst, u32 DstW, u32 DstH) {
-            double TSum = 0.0;
-            u32    TCount = 0;
-            for (u32 y = 0; y < DstH; ++y) {
-                u32 sy0 = std::min(y * 2u,       SrcH - 1);
-                u32 sy1 = std::min(y * 2u + 1u,  SrcH - 1);
-                for (u32 x = 0; x < DstW; ++x) {
-                    u32 sx0 = std::min(x * 2u,       SrcW - 1);
-                    u32 sx1 = std::min(x * 2u + 1u,  SrcW - 1);
-                    const u8* P[4] = {
-                        Src + (sy0 * SrcW + sx0) * 4,
-                        Src + (sy0 * SrcW + sx1) * 4,
-                        Src + (sy1 * SrcW + sx0) * 4,
-                        Src + (sy1 * SrcW + sx1) * 4,
-                    };
-
-                    float nx = 0, ny = 0, nz = 0;
-                    for (int i = 0; i < 4; ++i) {
-                        float vx = P[i][0] / 255.0f * 2.0f - 1.0f;
-                        float vy = P[i][1] / 255.0f * 2.0f - 1.0f;
-                        float vz = P[i][2] / 255.0f * 2.0f - 1.0f;
-                        float len = std::sqrt(vx*vx + vy*vy + vz*vz);
-                        if (len > 1e-6f) { vx /= len; vy /= len; vz /= len; }
-                        nx += vx; ny += vy; nz += vz;
-                    }
-                    float sumLen = std::sqrt(nx*nx + ny*ny + nz*nz);
-                    float T = sumLen / 4.0f; 
-                    if (T < 1e-4f) T = 1e-4f;
-
-                    float invLen = 1.0f / sumLen;
-                    float ox = nx * invLen;
-                    float oy = ny * invLen;
-                    float oz = nz * invLen;
-                    u8* d = Dst + (y * DstW + x) * 4;
-                    d[0] = static_cast<u8>(std::clamp((ox * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
-                    d[1] = static_cast<u8>(std::clamp((oy * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
-                    d[2] = static_cast<u8>(std::clamp((oz * 0.5f + 0.5f) * 255.0f + 0.5f, 0.0f, 255.0f));
-                    d[3] = static_cast<u8>(std::clamp(T * 255.0f + 0.5f, 0.0f, 255.0f));
-                    TSum  += T;
-                    TCount += 1;
-                }
-            }
-            return TCount > 0 ? static_cast<float>(TSum / TCount) : 1.0f;
-        }
-    }
-
     FTexture FTexture::RecordUpload(ID3D12Device* _Device, ID3D12GraphicsCommandList* _CommandList,
                                     FTextureSRVHeap& _SRVHeap,
                                     const std::vector<FMipData>& _Mips, DXGI_FORMAT _Format,
@@ -251,8 +136,7 @@ namespace Smile {
 
             for (; i < _Data.size(); ++i) {
                 if (!_Data[i].Valid()) continue;
-                Out[i] = RecordUpload(_Device, CommandList, _SRVHeap,
-                                      _Data[i].Mips, _Data[i].Format, _UploadQueue);
+                Out[i] = RecordFromCPU(_Device, CommandList, _SRVHeap, _Data[i], _UploadQueue);
                 for (const auto& m : _Data[i].Mips) BatchBytes += m.Pixels.size();
                 if (BatchBytes >= kStagingBudget) { ++i; break; }
             }
@@ -262,6 +146,14 @@ namespace Smile {
         return Out;
     }
 
+    FTexture FTexture::RecordFromCPU(ID3D12Device* _Device, ID3D12GraphicsCommandList* _CommandList,
+                                     FTextureSRVHeap& _SRVHeap, const FTextureCPUData& _Data,
+                                     FUploadQueue& _UploadQueue) {
+        FTexture Result = RecordUpload(_Device, _CommandList, _SRVHeap, _Data.Mips, _Data.Format, _UploadQueue);
+        Result.TexFirstMip = _Data.FirstMip;
+        return Result;
+    }
+
     FTexture FTexture::Upload(ID3D12Device* _Device, FUploadQueue& _UploadQueue,
                                FTextureSRVHeap& _SRVHeap,
                                const std::vector<FMipData>& _Mips, DXGI_FORMAT _Format,
@@ -395,7 +287,9 @@ namespace Smile {
                                      FTextureSRVHeap& _SRVHeap, const FTextureCPUData& _Data,
                                      EVramCategory _Category) {
         if (!_Data.Valid()) return FTexture{};
-        return Upload(_Device, _UploadQueue, _SRVHeap, _Data.Mips, _Data.Format, _Category);
+        FTexture Result = Upload(_Device, _UploadQueue, _SRVHeap, _Data.Mips, _Data.Format, _Category);
+        Result.TexFirstMip = _Data.FirstMip;
+        return Result;
     }
 
     FTexture FTexture::LoadFromFile(ID3D12Device* _Device, FUploadQueue& _UploadQueue,
@@ -434,7 +328,8 @@ namespace Smile {
         }
     }
 
-    FTextureCPUData FTexture::LoadDDSCPU(const std::wstring& _Path, bool _sRGB) {
+    FTextureCPUData FTexture::LoadDDSCPU(const std::wstring& _Path, bool _sRGB, u32 _MaxDimension,
+                                         u32 _MaxFirstMip) {
         FTextureCPUData Data;
         Data.IsNormalMap = false; 
         try {
@@ -444,11 +339,13 @@ namespace Smile {
             const std::streamoff Size = File.tellg();
             if (Size < 128) throw std::runtime_error("arquivo curto demais");
             File.seekg(0, std::ios::beg);
-            std::vector<u8> Bytes(static_cast<size_t>(Size));
-            File.read(reinterpret_cast<char*>(Bytes.data()), Size);
+            // So o cabecalho (+ DX10) agora; as mips vem depois, a partir da primeira pedida —
+            // com streaming o grosso do arquivo (as mips de cima) nem e lido.
+            u8 Header[148] = {};
+            File.read(reinterpret_cast<char*>(Header), std::min<std::streamoff>(Size, sizeof(Header)));
             if (!File) throw std::runtime_error("falha na leitura");
 
-            const u8* P = Bytes.data();
+            const u8* P = Header;
             auto Rd32 = [&](size_t Off) -> u32 {
                 u32 V; std::memcpy(&V, P + Off, 4); return V;
             };
@@ -468,6 +365,7 @@ namespace Smile {
             if (!(PFFlags & DDPF_FOURCC)) throw std::runtime_error("DDS nao comprimido (sem FourCC) nao suportado");
 
             if (FourCC == MakeFourCC('D','X','1','0')) {
+                if (Size < 148) throw std::runtime_error("arquivo curto demais");
                 Fmt = static_cast<DXGI_FORMAT>(Rd32(128));
                 DataOffset = 148;
             } else if (FourCC == MakeFourCC('D','X','T','1')) {
@@ -487,28 +385,48 @@ namespace Smile {
             if (_sRGB) Fmt = ToSRGB(Fmt);
             const u32 BlockBytes = BlockBytesFor(Fmt);
 
-            std::vector<FMipData>& Mips = Data.Mips;
-            Mips.reserve(MipCount);
-            size_t Off = DataOffset;
-            for (u32 i = 0; i < MipCount; ++i) {
-                const u32 W = std::max(1u, Width  >> i);
-                const u32 H = std::max(1u, Height >> i);
-                const u32 BlocksW = std::max(1u, (W + 3) / 4);
-                const u32 BlocksH = std::max(1u, (H + 3) / 4);
-                const size_t Size = static_cast<size_t>(BlocksW) * BlocksH * BlockBytes;
-                if (Off + Size > Bytes.size()) throw std::runtime_error("dados de mip truncados");
+            // Primeira mip cujo maior lado cabe em MaxDimension (a ultima, se nenhuma couber) — a
+            // mesma regra do StreamedTailMip (TextureResidency.h) —, sem passar da MaxFirstMip.
+            u32    FirstMip = 0;
+            size_t Off      = DataOffset;
+            auto MipSize = [&](u32 _Mip) {
+                const u32 W = std::max(1u, Width  >> _Mip);
+                const u32 H = std::max(1u, Height >> _Mip);
+                return static_cast<size_t>(std::max(1u, (W + 3) / 4)) * std::max(1u, (H + 3) / 4) * BlockBytes;
+            };
+            if (_MaxDimension > 0) {
+                while (FirstMip + 1 < MipCount && FirstMip < _MaxFirstMip &&
+                       std::max(Width >> FirstMip, Height >> FirstMip) > _MaxDimension) {
+                    Off += MipSize(FirstMip);
+                    ++FirstMip;
+                }
+            }
+
+            size_t Total = 0;
+            for (u32 i = FirstMip; i < MipCount; ++i) Total += MipSize(i);
+            if (static_cast<std::streamoff>(Off + Total) > Size) throw std::runtime_error("dados de mip truncados");
+            std::vector<u8> Bytes(Total);
+            File.seekg(static_cast<std::streamoff>(Off), std::ios::beg);
+            File.read(reinterpret_cast<char*>(Bytes.data()), static_cast<std::streamsize>(Total));
+            if (!File) throw std::runtime_error("falha na leitura");
 
+            std::vector<FMipData>& Mips = Data.Mips;
+            Mips.reserve(MipCount - FirstMip);
+            size_t Cursor = 0;
+            for (u32 i = FirstMip; i < MipCount; ++i) {
+                const size_t MipBytes = MipSize(i);
                 FMipData Mip;
-                Mip.Width  = W;
-                Mip.Height = H;
-                Mip.Pixels.assign(P + Off, P + Off + Size);
+                Mip.Width  = std::max(1u, Width  >> i);
+                Mip.Height = std::max(1u, Height >> i);
+                Mip.Pixels.assign(Bytes.data() + Cursor, Bytes.data() + Cursor + MipBytes);
                 Mips.push_back(std::move(Mip));
-                Off += Size;
+                Cursor += MipBytes;
             }
 
-            Data.Width  = Width;
-            Data.Height = Height;
-            Data.Format = Fmt;
+            Data.Width    = Width;
+            Data.Height   = Height;
+            Data.Format   = Fmt;
+            Data.FirstMip = FirstMip;
         } catch (const std::exception& e) {
             LogError(std::string("Falha ao carregar DDS: ") + e.what());
             Data.Mips.clear();
@@ -0,0 +1,223 @@
+#include "Smile/Graphics/Resources/TextureResidency.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Smile {
+    u64 StreamedMipBytes(const FStreamedTextureDesc& _Desc, u32 _Mip) {
+        const u32 W   = std::max(1u, _Desc.Width  >> _Mip);
+        const u32 H   = std::max(1u, _Desc.Height >> _Mip);
+        const u32 Dim = std::max(1u, _Desc.BlockDim);
+        return u64((W + Dim - 1) / Dim) * ((H + Dim - 1) / Dim) * _Desc.BlockBytes;
+    }
+
+    u64 StreamedChainBytes(const FStreamedTextureDesc& _Desc, u32 _FirstMip) {
+        u64 Bytes = 0;
+        for (u32 m = _FirstMip; m < _Desc.MipCount; ++m) Bytes += StreamedMipBytes(_Desc, m);
+        return Bytes;
+    }
+
+    u32 StreamedTailMip(const FStreamedTextureDesc& _Desc, u32 _TailDimension) {
+        const u32 Last = _Desc.MipCount ? _Desc.MipCount - 1 : 0;
+        for (u32 m = 0; m < Last; ++m)
+            if (std::max(_Desc.Width >> m, _Desc.Height >> m) <= _TailDimension) return m;
+        return Last;
+    }
+
+    f32 MeshUvDensity(std::span<const Vertex> _Vertices, std::span<const u32> _Indices) {
+        f64 LocalArea = 0.0, UvArea = 0.0;
+        for (size_t t = 0; t + 2 < _Indices.size(); t += 3) {
+            const u32 I0 = _Indices[t], I1 = _Indices[t + 1], I2 = _Indices[t + 2];
+            if (I0 >= _Vertices.size() || I1 >= _Vertices.size() || I2 >= _Vertices.size()) continue;
+            const Vertex& A = _Vertices[I0];
+            const Vertex& B = _Vertices[I1];
+            const Vertex& C = _Vertices[I2];
+            const f64 E1[3] = { B.Position[0] - A.Position[0], B.Position[1] - A.Position[1],
+                                B.Position[2] - A.Position[2] };
+            const f64 E2[3] = { C.Position[0] - A.Position[0], C.Position[1] - A.Position[1],
+                                C.Position[2] - A.Position[2] };
+            const f64 Cx = E1[1] * E2[2] - E1[2] * E2[1];
+            const f64 Cy = E1[2] * E2[0] - E1[0] * E2[2];
+            const f64 Cz = E1[0] * E2[1] - E1[1] * E2[0];
+            LocalArea += 0.5 * std::sqrt(Cx * Cx + Cy * Cy + Cz * Cz);
+            const f64 U1 = B.TexCoord[0] - A.TexCoord[0], V1 = B.TexCoord[1] - A.TexCoord[1];
+            const f64 U2 = C.TexCoord[0] - A.TexCoord[0], V2 = C.TexCoord[1] - A.TexCoord[1];
+            UvArea += 0.5 * std::abs(U1 * V2 - U2 * V1);
+        }
+        return LocalArea > 0.0 ? static_cast<f32>(std::sqrt(UvArea / LocalArea)) : 0.0f;
+    }
+
+    f32 DemandedMip(const FMipDemandView& _View, u32 _TexWidth, u32 _TexHeight, f32 _UvDensity,
+                    f32 _WorldScale, f32 _Distance) {
+        if (_Distance <= 0.0f || _UvDensity <= 0.0f || _WorldScale <= 0.0f) return 0.0f;
+        // Maior lado: em textura nao quadrada o eixo mais denso e o que decide a mip.
+        const f32 TexelsPerUnit = static_cast<f32>(std::max(_TexWidth, _TexHeight)) * _UvDensity / _WorldScale;
+        const f32 PixelsPerUnit = _View.ViewportHeight / (2.0f * _Distance * std::tan(0.5f * _View.FovYRadians));
+        if (!(PixelsPerUnit > 0.0f)) return 0.0f;
+        return std::max(0.0f, std::log2(TexelsPerUnit / PixelsPerUnit) + _View.MipBias);
+    }
+
+    FTextureResidency::FTextureResidency(const FTextureResidencyOptions& _Options) : Opt(_Options) {
+        Stat.BudgetBytes = Opt.BudgetBytes;
+    }
+
+    void FTextureResidency::SetOptions(const FTextureResidencyOptions& _Options) {
+        // A cauda e fixada no Add: trocar TailDimension so vale para texturas novas.
+        Opt = _Options;
+        Stat.BudgetBytes = Opt.BudgetBytes;
+    }
+
+    u32 FTextureResidency::Add(const FStreamedTextureDesc& _Desc, u32 _Tail) {
+        FItem Item;
+        Item.Desc     = _Desc;
+        Item.Tail     = (_Tail == kAutoTail) ? StreamedTailMip(_Desc, Opt.TailDimension)
+                                             : std::min(_Tail, _Desc.MipCount ? _Desc.MipCount - 1 : 0);
+        Item.Resident = Item.Tail;
+        Item.Target   = Item.Tail;
+        Item.Wanted   = Item.Tail;
+        const u64 Bytes = StreamedChainBytes(_Desc, Item.Tail);
+        Stat.ResidentBytes  += Bytes;
+        Stat.CommittedBytes += Bytes;
+        Stat.TailBytes      += Bytes;
+        ++Stat.Textures;
+        Items.push_back(Item);
+        return static_cast<u32>(Items.size() - 1);
+    }
+
+    void FTextureResidency::Clear() {
+        Items.clear();
+        Changes.clear();
+        Stat = {};
+        Stat.BudgetBytes = Opt.BudgetBytes;
+    }
+
+    void FTextureResidency::Request(u32 _Texture, f32 _Mip) {
+        FItem& Item = Items[_Texture];
+        const u32 Mip = std::min(Item.Tail, static_cast<u32>(std::max(0.0f, std::floor(_Mip))));
+        if (Item.LastUsed != CurrentFrame) {
+            Item.LastUsed = CurrentFrame;
+            Item.Wanted   = Mip;
+        } else {
+            Item.Wanted = std::min(Item.Wanted, Mip);
+        }
+    }
+
+    void FTextureResidency::Retarget(u32 _Texture, u32 _Mip) {
+        FItem& Item = Items[_Texture];
+        Stat.CommittedBytes -= StreamedChainBytes(Item.Desc, Item.Target);
+        Stat.CommittedBytes += StreamedChainBytes(Item.Desc, _Mip);
+        Item.Target = _Mip;
+    }
+
+    bool FTextureResidency::MakeRoom(u64 _Bytes) {
+        if (Stat.CommittedBytes + _Bytes <= Opt.BudgetBytes) return true;
+        if (!VictimsBuilt) {
+            // Fora da tela primeiro (LRU; empate: mais bytes acima da cauda primeiro), depois as da
+            // tela com excesso (maior excesso primeiro). Com mudanca em voo nao entra.
+            VictimsBuilt = true;
+            Victims.clear();
+            VictimCursor = 0;
+            for (u32 t = 0; t < Items.size(); ++t) {
+                const FItem& Item = Items[t];
+                if (Item.Target != Item.Resident) continue;
+                const bool OnScreen = Item.LastUsed == CurrentFrame;
+                if (OnScreen ? Item.Target < Item.Wanted : Item.Target < Item.Tail) Victims.push_back(t);
+            }
+            std::sort(Victims.begin(), Victims.end(), [&](u32 _A, u32 _B) {
+                const FItem& A = Items[_A];
+                const FItem& B = Items[_B];
+                const bool AOn = A.LastUsed == CurrentFrame, BOn = B.LastUsed == CurrentFrame;
+                if (AOn != BOn) return BOn;
+                if (!AOn && A.LastUsed != B.LastUsed) return A.LastUsed < B.LastUsed;
+                const u64 AExtra = StreamedChainBytes(A.Desc, A.Target) -
+                                   StreamedChainBytes(A.Desc, AOn ? A.Wanted : A.Tail);
+                const u64 BExtra = StreamedChainBytes(B.Desc, B.Target) -
+                                   StreamedChainBytes(B.Desc, BOn ? B.Wanted : B.Tail);
+                if (AExtra != BExtra) return AExtra > BExtra;
+                return _A < _B;
+            });
+        }
+        while (Stat.CommittedBytes + _Bytes > Opt.BudgetBytes && VictimCursor < Victims.size()) {
+            const u32 t = Victims[VictimCursor++];
+            FItem& Item = Items[t];
+            const u32 Dest = (Item.LastUsed == CurrentFrame) ? Item.Wanted : Item.Tail;
+            if (Dest <= Item.Target) continue;
+            Stat.EvictBytes += StreamedChainBytes(Item.Desc, Item.Target) - StreamedChainBytes(Item.Desc, Dest);
+            ++Stat.Evictions;
+            Retarget(t, Dest);
+            Changes.push_back({ t, Item.Resident, Dest });
+        }
+        return Stat.CommittedBytes + _Bytes <= Opt.BudgetBytes;
+    }
+
+    const std::vector<FResidencyChange>& FTextureResidency::Update() {
+        Changes.clear();
+        Needy.clear();
+        VictimsBuilt = false;
+        Stat.Requested = Stat.Starved = Stat.Loads = Stat.Evictions = 0;
+        Stat.LoadBytes = Stat.EvictBytes = 0;
+
+        for (u32 t = 0; t < Items.size(); ++t) {
+            const FItem& Item = Items[t];
+            if (Item.LastUsed != CurrentFrame) continue;
+            ++Stat.Requested;
+            if (Item.Target == Item.Resident && Item.Wanted < Item.Target) Needy.push_back(t);
+        }
+        // Maior falta primeiro; empate na ordem do Add (deterministico).
+        std::stable_sort(Needy.begin(), Needy.end(), [&](u32 _A, u32 _B) {
+            return Items[_A].Target - Items[_A].Wanted > Items[_B].Target - Items[_B].Wanted;
+        });
+
+        // Rodadas de uma mip por textura. Quem nao cabe sai das rodadas (e conta como Starved se
+        // foi por budget); o teto por Update para tudo.
+        std::vector<u8> Done(Needy.size(), 0);
+        bool Progress = true, Capped = false;
+        while (Progress && !Capped) {
+            Progress = false;
+            for (size_t n = 0; n < Needy.size() && !Capped; ++n) {
+                if (Done[n]) continue;
+                const u32 t = Needy[n];
+                FItem& Item = Items[t];
+                if (Item.Target <= Item.Wanted) { Done[n] = 1; continue; }
+                const u64 Step = StreamedMipBytes(Item.Desc, Item.Target - 1);
+                if (Stat.LoadBytes > 0 && Stat.LoadBytes + Step > Opt.MaxLoadBytesPerUpdate) {
+                    Capped = true;
+                    break;
+                }
+                if (!MakeRoom(Step)) {
+                    Done[n] = 1;
+                    ++Stat.Starved;
+                    continue;
+                }
+                Retarget(t, Item.Target - 1);
+                Stat.LoadBytes += Step;
+                Progress = true;
+            }
+        }
+        for (const u32 t : Needy) {
+            const FItem& Item = Items[t];
+            if (Item.Target < Item.Resident) {
+                Changes.push_back({ t, Item.Resident, Item.Target });
+                ++Stat.Loads;
+            }
+        }
+
+        Stat.InFlight = 0;
+        for (const FItem& Item : Items) Stat.InFlight += (Item.Target != Item.Resident) ? 1u : 0u;
+        ++CurrentFrame;
+        return Changes;
+    }
+
+    void FTextureResidency::Complete(u32 _Texture, bool _Success) {
+        FItem& Item = Items[_Texture];
+        if (Item.Target == Item.Resident) return;
+        if (!_Success) {
+            Retarget(_Texture, Item.Resident);
+        } else {
+            Stat.ResidentBytes -= StreamedChainBytes(Item.Desc, Item.Resident);
+            Stat.ResidentBytes += StreamedChainBytes(Item.Desc, Item.Target);
+            Item.Resident = Item.Target;
+        }
+        --Stat.InFlight;
+    }
+}
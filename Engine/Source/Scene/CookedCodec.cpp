@@ -0,0 +1,303 @@
+#include "Smile/Scene/CookedCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Smile {
+    namespace {
+        constexpr size_t kLzMinMatch  = 4;
+        constexpr size_t kLzMaxOffset = 65535;
+        constexpr u32    kLzHashBits  = 16;
+        constexpr u32    kLzNoEntry   = std::numeric_limits<u32>::max();
+
+        u32 Load32(const u8* _P) {
+            u32 V;
+            std::memcpy(&V, _P, sizeof(V));
+            return V;
+        }
+
+        void PutLength(size_t _Extra, std::vector<u8>& _Out) {
+            for (; _Extra >= 255; _Extra -= 255) _Out.push_back(255);
+            _Out.push_back(static_cast<u8>(_Extra));
+        }
+
+        // Uma sequencia: token [lit estendido] literais [offset u16 + match estendido]. A ultima
+        // so tem literais; o decoder a reconhece por acabar exatamente no fim do payload.
+        void EmitSequence(const u8* _Literals, size_t _LiteralCount, size_t _Offset, size_t _MatchLength,
+                          std::vector<u8>& _Out) {
+            const size_t MatchCode = _MatchLength ? _MatchLength - kLzMinMatch : 0;
+            _Out.push_back(static_cast<u8>((std::min<size_t>(_LiteralCount, 15) << 4) |
+                                           std::min<size_t>(MatchCode, 15)));
+            if (_LiteralCount >= 15) PutLength(_LiteralCount - 15, _Out);
+            _Out.insert(_Out.end(), _Literals, _Literals + _LiteralCount);
+            if (_MatchLength == 0) return;
+            _Out.push_back(static_cast<u8>(_Offset & 0xFF));
+            _Out.push_back(static_cast<u8>(_Offset >> 8));
+            if (MatchCode >= 15) PutLength(MatchCode - 15, _Out);
+        }
+
+        bool ReadLength(std::span<const u8> _In, size_t& _Ip, size_t& _Length) {
+            u8 Byte;
+            do {
+                if (_Ip >= _In.size()) return false;
+                Byte = _In[_Ip++];
+                _Length += Byte;
+            } while (Byte == 255);
+            return true;
+        }
+
+        // Palavras de 4 bytes em planos: todos os bytes 0, depois todos os 1, ...
+        void PutPlanes(const f32* _Words, size_t _Count, std::vector<u8>& _Out) {
+            const size_t Base = _Out.size();
+            _Out.resize(Base + _Count * 4);
+            const u8* Src = reinterpret_cast<const u8*>(_Words);
+            for (size_t B = 0; B < 4; ++B)
+                for (size_t W = 0; W < _Count; ++W) _Out[Base + B * _Count + W] = Src[W * 4 + B];
+        }
+
+        void GetPlanes(const u8* _Planes, size_t _Count, f32* _Words) {
+            u8* Dst = reinterpret_cast<u8*>(_Words);
+            for (size_t B = 0; B < 4; ++B)
+                for (size_t W = 0; W < _Count; ++W) Dst[W * 4 + B] = _Planes[B * _Count + W];
+        }
+
+        u16 Quantize(f32 _Value, f32 _Min, f32 _Extent) {
+            if (!(_Extent > 0.0f)) return 0;
+            const f32 T = std::clamp((_Value - _Min) / _Extent, 0.0f, 1.0f);
+            return static_cast<u16>(std::lround(T * 65535.0f));
+        }
+
+        // Stream de vertices comum as variantes de indice: posicao, normal, UV e o payload de RT.
+        void EncodeVertexStreams(const SMeshEntry& _Entry, const FMeshView& _Mesh,
+                                 std::span<const FRTTriangle> _Rt, bool _Quantize, std::vector<u8>& _Out) {
+            const size_t V = _Mesh.Vertices.size();
+            std::vector<f32> Words;
+            if (_Quantize) {
+                const size_t Base = _Out.size();
+                _Out.resize(Base + V * 3 * sizeof(u16));
+                for (size_t I = 0; I < V; ++I)
+                    for (int C = 0; C < 3; ++C) {
+                        const u16 Q = Quantize(_Mesh.Vertices[I].Position[C], _Entry.AABBMin[C],
+                                               _Entry.AABBMax[C] - _Entry.AABBMin[C]);
+                        std::memcpy(&_Out[Base + (I * 3 + C) * sizeof(u16)], &Q, sizeof(Q));
+                    }
+            } else {
+                Words.resize(V * 3);
+                for (size_t I = 0; I < V; ++I) std::memcpy(&Words[I * 3], _Mesh.Vertices[I].Position, 12);
+                PutPlanes(Words.data(), Words.size(), _Out);
+            }
+            Words.resize(V * 3);
+            for (size_t I = 0; I < V; ++I) std::memcpy(&Words[I * 3], _Mesh.Vertices[I].Normal, 12);
+            PutPlanes(Words.data(), Words.size(), _Out);
+            Words.resize(V * 2);
+            for (size_t I = 0; I < V; ++I) std::memcpy(&Words[I * 2], _Mesh.Vertices[I].TexCoord, 8);
+            PutPlanes(Words.data(), Words.size(), _Out);
+
+            const u8* Rt = reinterpret_cast<const u8*>(_Rt.data());
+            _Out.insert(_Out.end(), Rt, Rt + _Rt.size_bytes());
+        }
+
+        // Delta com o indice anterior: malha com boa localidade (o que o reorder do cooker
+        // produz) tem deltas pequenos, e quase todo indice cabe em um byte.
+        void EncodeIndexVarint(std::span<const u32> _Indices, std::vector<u8>& _Out) {
+            i64 Previous = 0;
+            for (const u32 Index : _Indices) {
+                const i64 Delta = static_cast<i64>(Index) - Previous;
+                u64 ZigZag = (static_cast<u64>(Delta) << 1) ^ static_cast<u64>(Delta >> 63);
+                while (ZigZag >= 0x80) {
+                    _Out.push_back(static_cast<u8>(ZigZag | 0x80));
+                    ZigZag >>= 7;
+                }
+                _Out.push_back(static_cast<u8>(ZigZag));
+                Previous = Index;
+            }
+        }
+
+        void EncodeIndexU16(std::span<const u32> _Indices, std::vector<u8>& _Out) {
+            const size_t Base = _Out.size();
+            _Out.resize(Base + _Indices.size() * sizeof(u16));
+            for (size_t I = 0; I < _Indices.size(); ++I) {
+                const u16 Index = static_cast<u16>(_Indices[I]);
+                std::memcpy(&_Out[Base + I * sizeof(u16)], &Index, sizeof(Index));
+            }
+        }
+
+        bool DecodeIndexVarint(const u8* _Data, size_t _Bytes, std::vector<u32>& _Out) {
+            size_t P = 0;
+            i64 Previous = 0;
+            for (u32& Index : _Out) {
+                u64 ZigZag = 0;
+                for (u32 Shift = 0;; Shift += 7) {
+                    if (P >= _Bytes || Shift > 63) return false;
+                    const u8 Byte = _Data[P++];
+                    ZigZag |= static_cast<u64>(Byte & 0x7F) << Shift;
+                    if (!(Byte & 0x80)) break;
+                }
+                const i64 Delta = static_cast<i64>(ZigZag >> 1) ^ -static_cast<i64>(ZigZag & 1);
+                const i64 Value = Previous + Delta;
+                if (Value < 0 || Value > std::numeric_limits<u32>::max()) return false;
+                Index = static_cast<u32>(Value);
+                Previous = Value;
+            }
+            return P == _Bytes;
+        }
+
+        u64 VertexStreamBytes(u64 _VertexCount, bool _Quantized) {
+            return _VertexCount * ((_Quantized ? 3 * sizeof(u16) : 3 * sizeof(f32)) + 5 * sizeof(f32));
+        }
+    }
+
+    void LzCompress(std::span<const u8> _In, std::vector<u8>& _Out) {
+        const u8*    In = _In.data();
+        const size_t N  = _In.size();
+        std::vector<u32> Table(size_t(1) << kLzHashBits, kLzNoEntry);
+        size_t Anchor = 0, I = 0;
+        while (I + kLzMinMatch <= N) {
+            const u32 Sequence = Load32(In + I);
+            const u32 Hash     = (Sequence * 2654435761u) >> (32 - kLzHashBits);
+            const u32 Candidate = Table[Hash];
+            Table[Hash] = static_cast<u32>(I);
+            if (Candidate == kLzNoEntry || I - Candidate > kLzMaxOffset || Load32(In + Candidate) != Sequence) {
+                ++I;
+                continue;
+            }
+            size_t Length = kLzMinMatch;
+            while (I + Length < N && In[Candidate + Length] == In[I + Length]) ++Length;
+            EmitSequence(In + Anchor, I - Anchor, I - Candidate, Length, _Out);
+            I += Length;
+            Anchor = I;
+        }
+        if (Anchor < N) EmitSequence(In + Anchor, N - Anchor, 0, 0, _Out);
+    }
+
+    bool LzDecompress(std::span<const u8> _In, std::span<u8> _Out) {
+        size_t Ip = 0, Op = 0;
+        while (Ip < _In.size()) {
+            const u8 Token = _In[Ip++];
+            size_t Literals = Token >> 4;
+            if (Literals == 15 && !ReadLength(_In, Ip, Literals)) return false;
+            if (Literals > _In.size() - Ip || Literals > _Out.size() - Op) return false;
+            std::memcpy(_Out.data() + Op, _In.data() + Ip, Literals);
+            Ip += Literals;
+            Op += Literals;
+            if (Ip == _In.size()) break; // ultima sequencia: so literais
+
+            if (_In.size() - Ip < 2) return false;
+            const size_t Offset = size_t(_In[Ip]) | (size_t(_In[Ip + 1]) << 8);
+            Ip += 2;
+            size_t Length = (Token & 15u) + kLzMinMatch;
+            if ((Token & 15u) == 15 && !ReadLength(_In, Ip, Length)) return false;
+            if (Offset == 0 || Offset > Op || Length > _Out.size() - Op) return false;
+            u8* Dst = _Out.data() + Op;
+            const u8* Src = Dst - Offset;
+            // Match que se sobrepoe a si mesmo (offset < comprimento) e o RLE do LZ: a copia tem
+            // de ser byte a byte, na ordem, para reler o que acabou de escrever.
+            if (Offset >= Length) std::memcpy(Dst, Src, Length);
+            else for (size_t B = 0; B < Length; ++B) Dst[B] = Src[B];
+            Op += Length;
+        }
+        return Op == _Out.size();
+    }
+
+    FCodedMeshBlock EncodeMeshBlock(const SMeshEntry& _Entry, const FMeshView& _Mesh,
+                                    const FMeshCodingOptions& _Options) {
+        std::vector<FRTTriangle> Scratch;
+        const std::span<const FRTTriangle> Rt = ResolveRTTriangles(_Mesh, Scratch);
+
+        std::vector<u8> Prefix;
+        EncodeVertexStreams(_Entry, _Mesh, Rt, _Options.QuantizePositions, Prefix);
+        const u32 BaseFlags = kMeshEntryCoded | (_Options.QuantizePositions ? kMeshEntryQuantizedPosition : 0u);
+
+        auto Build = [&](bool _Varint) {
+            FCodedMeshBlock Block;
+            std::vector<u8> Raw = Prefix;
+            if (_Varint) EncodeIndexVarint(_Mesh.Indices, Raw);
+            else         EncodeIndexU16(_Mesh.Indices, Raw);
+            Block.Flags    = BaseFlags | (_Varint ? kMeshEntryIndexVarint : 0u);
+            Block.RawBytes = static_cast<u32>(Raw.size());
+            LzCompress(Raw, Block.Bytes);
+            return Block;
+        };
+        FCodedMeshBlock Best = Build(true);
+        if (_Mesh.Vertices.size() <= 65536) {
+            FCodedMeshBlock Narrow = Build(false);
+            if (Narrow.Bytes.size() < Best.Bytes.size()) Best = std::move(Narrow);
+        }
+        return Best;
+    }
+
+    bool DecodeMeshBlock(const SMeshEntry& _Entry, std::span<const u8> _Coded, FMesh& _Out, std::string& _Error) {
+        const bool Quantized = (_Entry.Flags & kMeshEntryQuantizedPosition) != 0;
+        const bool Varint    = (_Entry.Flags & kMeshEntryIndexVarint) != 0;
+        const u64  V         = _Entry.VertexCount;
+        const u64  Prefix    = VertexStreamBytes(V, Quantized) + u64(_Entry.RTTriangleCount) * sizeof(FRTTriangle);
+        const u64  IndexMin  = Varint ? _Entry.IndexCount : u64(_Entry.IndexCount) * sizeof(u16);
+        if (Prefix + IndexMin > _Entry.RawBytes || (!Varint && Prefix + IndexMin != _Entry.RawBytes) ||
+            (!Varint && V > 65536)) {
+            _Error = "bloco codificado nao bate com as contagens da entrada";
+            return false;
+        }
+
+        std::vector<u8> Raw(_Entry.RawBytes);
+        if (!LzDecompress(_Coded, Raw)) {
+            _Error = "payload LZ corrompido";
+            return false;
+        }
+
+        const u8* P = Raw.data();
+        _Out.Vertices.resize(V);
+        std::vector<f32> Words;
+        if (Quantized) {
+            f32 Step[3];
+            for (int C = 0; C < 3; ++C) Step[C] = (_Entry.AABBMax[C] - _Entry.AABBMin[C]) / 65535.0f;
+            for (u64 I = 0; I < V; ++I)
+                for (int C = 0; C < 3; ++C) {
+                    u16 Q;
+                    std::memcpy(&Q, P + (I * 3 + C) * sizeof(u16), sizeof(Q));
+                    _Out.Vertices[I].Position[C] = _Entry.AABBMin[C] + f32(Q) * Step[C];
+                }
+            P += V * 3 * sizeof(u16);
+        } else {
+            Words.resize(V * 3);
+            GetPlanes(P, Words.size(), Words.data());
+            for (u64 I = 0; I < V; ++I) std::memcpy(_Out.Vertices[I].Position, &Words[I * 3], 12);
+            P += Words.size() * 4;
+        }
+        Words.resize(V * 3);
+        GetPlanes(P, Words.size(), Words.data());
+        for (u64 I = 0; I < V; ++I) std::memcpy(_Out.Vertices[I].Normal, &Words[I * 3], 12);
+        P += Words.size() * 4;
+        Words.resize(V * 2);
+        GetPlanes(P, Words.size(), Words.data());
+        for (u64 I = 0; I < V; ++I) std::memcpy(_Out.Vertices[I].TexCoord, &Words[I * 2], 8);
+        P += Words.size() * 4;
+
+        _Out.RTTriangles.resize(_Entry.RTTriangleCount);
+        std::memcpy(_Out.RTTriangles.data(), P, _Out.RTTriangles.size() * sizeof(FRTTriangle));
+        P += _Out.RTTriangles.size() * sizeof(FRTTriangle);
+
+        _Out.Indices.resize(_Entry.IndexCount);
+        const size_t IndexBytes = static_cast<size_t>(Raw.data() + Raw.size() - P);
+        if (Varint) {
+            if (!DecodeIndexVarint(P, IndexBytes, _Out.Indices)) {
+                _Error = "stream de indices varint corrompido";
+                return false;
+            }
+        } else {
+            for (size_t I = 0; I < _Out.Indices.size(); ++I) {
+                u16 Index;
+                std::memcpy(&Index, P + I * sizeof(u16), sizeof(Index));
+                _Out.Indices[I] = Index;
+            }
+        }
+        // O zero-copia confiava no BLAS para nunca ler alem do VB; aqui o indice saiu de um
+        // decoder, entao e conferido — um fora da faixa viraria leitura fora do buffer na GPU.
+        for (const u32 Index : _Out.Indices)
+            if (Index >= V) {
+                _Error = "indice fora do VB no bloco codificado";
+                return false;
+            }
+        return true;
+    }
+}
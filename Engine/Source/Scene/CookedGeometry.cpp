@@ -0,0 +1,202 @@
+#include "Smile/Scene/CookedGeometry.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Smile {
+    namespace {
+        // A view reinterpreta os bytes do arquivo como T[]. Alem de caber, o inicio tem de
+        // respeitar o alinhamento de T: o cooker so produz offsets multiplos de 4, e um arquivo que
+        // viole isso e corrompido — ler Vertex desalinhado seria UB, nao so lento.
+        template <typename T>
+        bool ViewOf(const u8* _Base, size_t _Total, u64 _Offset, u64 _Count, std::span<const T>& _Out) {
+            if (!CookedArrayFits(_Offset, _Count, sizeof(T), _Total)) return false;
+            const u8* Start = _Base + static_cast<size_t>(_Offset);
+            if (reinterpret_cast<std::uintptr_t>(Start) % alignof(T) != 0) return false;
+            _Out = { reinterpret_cast<const T*>(Start), static_cast<size_t>(_Count) };
+            return true;
+        }
+
+        std::string VersionError(u32 _Found) {
+            return "cozido v" + std::to_string(_Found) + ", a engine exige v" +
+                   std::to_string(kCookedVersion) +
+                   ". Recozinhe a cena com o SmileCooker (a v11 adiciona a cadeia de LODs por mesh e"
+                   " muda a SMeshEntry para 104 B; a v10 adicionou os clusters, a v9 o bloco"
+                   " codificado e a v8 o payload de RT por triangulo, que o runtime nao sintetiza).";
+        }
+
+        // Regiao de LODs: SMeshLod[LodCount] e logo depois os indices de todos os niveis. Como os
+        // clusters, o draw confia nela sem checar por frame: faixas contiguas cobrindo a lista,
+        // cada nivel com menos triangulos e erro >= o do anterior (a escolha em SelectMeshLod
+        // depende disso) e todo indice dentro do VB do mesh.
+        bool ParseLods(const u8* _Geometry, size_t _GeometryBytes, const SMeshEntry& _Entry, FMeshLodSet& _Out) {
+            if (_Entry.LodCount == 0) return true;
+            if (!ViewOf(_Geometry, _GeometryBytes, _Entry.LodOffset, _Entry.LodCount, _Out.Levels)) return false;
+            const SMeshLod& Last = _Out.Levels.back();
+            const u64 IndexCount = u64(Last.FirstIndex) + Last.IndexCount;
+            const u64 IndexOffset = _Entry.LodOffset + u64(_Entry.LodCount) * sizeof(SMeshLod);
+            if (!ViewOf(_Geometry, _GeometryBytes, IndexOffset, IndexCount, _Out.Indices)) return false;
+            u64 Next = 0;
+            u32 PreviousCount = _Entry.IndexCount;
+            f32 PreviousError = 0.0f;
+            for (const SMeshLod& Level : _Out.Levels) {
+                if (Level.FirstIndex != Next || Level.IndexCount == 0 || Level.IndexCount % 3 != 0 ||
+                    Level.IndexCount >= PreviousCount || !(Level.Error >= PreviousError))
+                    return false;
+                Next += Level.IndexCount;
+                PreviousCount = Level.IndexCount;
+                PreviousError = Level.Error;
+            }
+            for (const u32 Index : _Out.Indices)
+                if (Index >= _Entry.VertexCount) return false;
+            return true;
+        }
+    }
+
+    bool CookedArrayFits(u64 _Offset, u64 _Count, size_t _Stride, size_t _Total) {
+        if (_Offset > _Total || _Count > std::numeric_limits<size_t>::max() / _Stride) return false;
+        const size_t Bytes = static_cast<size_t>(_Count) * _Stride;
+        return Bytes <= _Total - static_cast<size_t>(_Offset);
+    }
+
+    bool ParseCookedScene(std::span<const u8> _Bytes, FCookedSceneTable& _Out, std::string& _Error) {
+        if (_Bytes.size() < sizeof(SSceneHeader)) {
+            _Error = "arquivo .sscene truncado";
+            return false;
+        }
+        std::memcpy(&_Out.Header, _Bytes.data(), sizeof(SSceneHeader));
+        const SSceneHeader& Header = _Out.Header;
+        if (Header.Magic != kSSceneMagic) {
+            _Error = "magic invalido (o arquivo nao e um cozido da Smile)";
+            return false;
+        }
+        // O runtime nao sintetiza dados ausentes de versoes antigas; a cena deve ser recozida.
+        if (Header.Version != kCookedVersion) {
+            _Error = VersionError(Header.Version);
+            return false;
+        }
+
+        const size_t MaterialsOffset = sizeof(SSceneHeader);
+        if (!CookedArrayFits(MaterialsOffset, Header.MaterialCount, sizeof(SSceneMaterial), _Bytes.size())) {
+            _Error = "tabela de materiais truncada";
+            return false;
+        }
+        const size_t RenderablesOffset = MaterialsOffset + sizeof(SSceneMaterial) * Header.MaterialCount;
+        if (!CookedArrayFits(RenderablesOffset, Header.RenderableCount, sizeof(SSceneRenderable),
+                             _Bytes.size())) {
+            _Error = "tabela de renderaveis truncada";
+            return false;
+        }
+
+        // Copias e nao views: as duas tabelas sao pequenas e o commit as consulta depois que o
+        // arquivo ja pode ter sido fechado.
+        _Out.Materials.resize(Header.MaterialCount);
+        if (Header.MaterialCount > 0)
+            std::memcpy(_Out.Materials.data(), _Bytes.data() + MaterialsOffset,
+                        sizeof(SSceneMaterial) * Header.MaterialCount);
+        _Out.Renderables.resize(Header.RenderableCount);
+        if (Header.RenderableCount > 0)
+            std::memcpy(_Out.Renderables.data(), _Bytes.data() + RenderablesOffset,
+                        sizeof(SSceneRenderable) * Header.RenderableCount);
+        return true;
+    }
+
+    bool ParseCookedMeshTable(std::span<const u8> _Bytes, FCookedMeshTable& _Out, std::string& _Error) {
+        if (_Bytes.size() < sizeof(SMeshHeader)) {
+            _Error = "arquivo .smesh truncado";
+            return false;
+        }
+        std::memcpy(&_Out.Header, _Bytes.data(), sizeof(SMeshHeader));
+        const SMeshHeader& Header = _Out.Header;
+        if (Header.Magic != kSMeshMagic) {
+            _Error = "magic invalido (o arquivo nao e um cozido da Smile)";
+            return false;
+        }
+        if (Header.Version != kCookedVersion) {
+            _Error = VersionError(Header.Version);
+            return false;
+        }
+
+        const size_t EntriesOffset = sizeof(SMeshHeader);
+        if (!CookedArrayFits(EntriesOffset, Header.MeshCount, sizeof(SMeshEntry), _Bytes.size())) {
+            _Error = "tabela de meshes truncada";
+            return false;
+        }
+        _Out.Entries.resize(Header.MeshCount);
+        if (Header.MeshCount > 0)
+            std::memcpy(_Out.Entries.data(), _Bytes.data() + EntriesOffset,
+                        sizeof(SMeshEntry) * Header.MeshCount);
+
+        const size_t GeometryOffset = EntriesOffset + sizeof(SMeshEntry) * Header.MeshCount;
+        _Out.Geometry = { _Bytes.data() + GeometryOffset, _Bytes.size() - GeometryOffset };
+        _Out.Views.assign(Header.MeshCount, {});
+        _Out.Clusters.assign(Header.MeshCount, {});
+        _Out.Lods.assign(Header.MeshCount, {});
+        _Out.CodedCount = 0;
+        for (const SMeshEntry& Entry : _Out.Entries)
+            if (Entry.Flags & kMeshEntryCoded) ++_Out.CodedCount;
+        return true;
+    }
+
+    bool ParseCookedMeshEntry(FCookedMeshTable& _Out, u32 _Index, std::string& _Error) {
+        const u8*    Geometry      = _Out.Geometry.data();
+        const size_t GeometryBytes = _Out.Geometry.size();
+        constexpr u32 kKnownFlags = kMeshEntryCoded | kMeshEntryQuantizedPosition | kMeshEntryIndexVarint;
+        const SMeshEntry& Entry = _Out.Entries[_Index];
+        FMeshView& View = _Out.Views[_Index];
+        if ((Entry.Flags & ~kKnownFlags) != 0 ||
+            ((Entry.Flags & kMeshEntryCoded) == 0 && Entry.Flags != 0)) {
+            _Error = "flags desconhecidas na entrada (mesh " + std::to_string(_Index) + ")";
+            return false;
+        }
+        if (Entry.Flags & kMeshEntryCoded) {
+            // A view fica vazia: o mesh so existe depois do DecodeMeshBlock. Aqui so se
+            // garante que o bloco esta dentro do arquivo; o conteudo e do decoder.
+            if (!CookedArrayFits(Entry.CodedOffset, Entry.CodedBytes, 1, GeometryBytes)) {
+                _Error = "bloco codificado fora do arquivo (mesh " + std::to_string(_Index) + ")";
+                return false;
+            }
+        } else if (!ViewOf(Geometry, GeometryBytes, Entry.VertexOffset, Entry.VertexCount, View.Vertices) ||
+            !ViewOf(Geometry, GeometryBytes, Entry.IndexOffset, Entry.IndexCount, View.Indices) ||
+            !ViewOf(Geometry, GeometryBytes, Entry.RTTriangleOffset, Entry.RTTriangleCount,
+                    View.RTTriangles)) {
+            _Error = "blob de geometria truncado ou desalinhado (mesh " + std::to_string(_Index) + ")";
+            return false;
+        }
+        // RTTriangle[i] corresponde ao PrimitiveIndex i do BLAS.
+        if (Entry.RTTriangleCount != Entry.IndexCount / 3u) {
+            _Error = "payload de RT com " + std::to_string(Entry.RTTriangleCount) +
+                     " triangulos para " + std::to_string(Entry.IndexCount / 3u) +
+                     " do IB — cozido inconsistente, recozinhe a cena";
+            return false;
+        }
+        // Clusters: crus mesmo em mesh codificado. Quem desenha uma faixa confia que ela esta
+        // dentro do IB, entao a cobertura e validada aqui e nao por draw.
+        std::span<const SMeshCluster>& Clusters = _Out.Clusters[_Index];
+        if (!ViewOf(Geometry, GeometryBytes, Entry.ClusterOffset, Entry.ClusterCount, Clusters)) {
+            _Error = "clusters fora do arquivo ou desalinhados (mesh " + std::to_string(_Index) + ")";
+            return false;
+        }
+        u64 Covered = 0;
+        for (const SMeshCluster& Cluster : Clusters) {
+            if (Cluster.FirstTriangle != Covered || Cluster.TriangleCount == 0) break;
+            Covered += Cluster.TriangleCount;
+        }
+        if (!Clusters.empty() && Covered != Entry.IndexCount / 3u) {
+            _Error = "clusters nao cobrem o IB em faixas contiguas (mesh " + std::to_string(_Index) + ")";
+            return false;
+        }
+        if (!ParseLods(Geometry, GeometryBytes, Entry, _Out.Lods[_Index])) {
+            _Error = "cadeia de LODs truncada ou inconsistente (mesh " + std::to_string(_Index) + ")";
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseCookedMeshes(std::span<const u8> _Bytes, FCookedMeshTable& _Out, std::string& _Error) {
+        if (!ParseCookedMeshTable(_Bytes, _Out, _Error)) return false;
+        for (u32 I = 0; I < _Out.Header.MeshCount; ++I)
+            if (!ParseCookedMeshEntry(_Out, I, _Error)) return false;
+        return true;
+    }
+}
@@ -0,0 +1,298 @@
+#include "Smile/Scene/FrustumCull.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define SMILE_CULL_X64 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// O MSVC aceita intrinsics AVX sem /arch:AVX; quem decide se a via roda e o DetectCullPath.
+#define SMILE_CULL_AVX_FN
+#else
+// GCC/Clang so geram AVX dentro de uma funcao marcada; o resto do arquivo segue em SSE2.
+#define SMILE_CULL_AVX_FN __attribute__((target("avx")))
+#endif
+#endif
+
+namespace Smile {
+    namespace {
+        bool OutsideScalar(const FCullFrustum& _V, f32 _Lx, f32 _Ly, f32 _Lz, f32 _Hx, f32 _Hy, f32 _Hz) {
+            const u32 Planes = std::min(_V.PlaneCount, kCullMaxPlanes);
+            for (u32 p = 0; p < Planes; ++p) {
+                const Vec4& P = _V.Planes[p];
+                const f32 X = (P.X >= 0.0f) ? _Hx : _Lx;
+                const f32 Y = (P.Y >= 0.0f) ? _Hy : _Ly;
+                const f32 Z = (P.Z >= 0.0f) ? _Hz : _Lz;
+                if (P.X * X + P.Y * Y + P.Z * Z + P.W < 0.0f) return true;
+            }
+            return false;
+        }
+
+        // Mesmo teste do BroadPhase antigo das sombras locais: so soma o eixo em que o centro
+        // esta fora da caixa.
+        bool TouchesSphereScalar(const f32 (&_C)[3], f32 _R2, const f32 (&_Lo)[3], const f32 (&_Hi)[3]) {
+            f32 D2 = 0.0f;
+            for (int a = 0; a < 3; ++a) {
+                if (_C[a] < _Lo[a])      { const f32 d = _Lo[a] - _C[a]; D2 += d * d; }
+                else if (_C[a] > _Hi[a]) { const f32 d = _C[a] - _Hi[a]; D2 += d * d; }
+            }
+            return D2 <= _R2;
+        }
+
+        // Bit i de `_Mask` = caixa _Base + i passou. Sai em ordem crescente.
+        void EmitMask(std::vector<u32>& _Out, u32 _Base, u32 _Mask) {
+            while (_Mask) {
+                _Out.push_back(_Base + static_cast<u32>(std::countr_zero(_Mask)));
+                _Mask &= _Mask - 1u;
+            }
+        }
+
+#if defined(SMILE_CULL_X64)
+        // Os kernels vetoriais devolvem quantas caixas cobriram (multiplo da largura); o resto
+        // fica com o laco escalar do chamador. As contas sao as do OutsideScalar, na mesma ordem
+        // — ((X*x + Y*y) + Z*z) + W —, entao a via nao muda o resultado.
+        size_t FrustumsSSE(const FCullBounds& _B, size_t _Begin, size_t _End, std::span<const FCullFrustum> _Views,
+                           std::span<std::vector<u32>> _Out) {
+            const size_t Count = _Begin + ((_End - _Begin) & ~size_t(3));
+            const __m128 Zero  = _mm_setzero_ps();
+            for (size_t i = _Begin; i < Count; i += 4) {
+                const __m128 Lx = _mm_loadu_ps(_B.MinX.data() + i);
+                const __m128 Ly = _mm_loadu_ps(_B.MinY.data() + i);
+                const __m128 Lz = _mm_loadu_ps(_B.MinZ.data() + i);
+                const __m128 Hx = _mm_loadu_ps(_B.MaxX.data() + i);
+                const __m128 Hy = _mm_loadu_ps(_B.MaxY.data() + i);
+                const __m128 Hz = _mm_loadu_ps(_B.MaxZ.data() + i);
+                for (size_t v = 0; v < _Views.size(); ++v) {
+                    const FCullFrustum& V = _Views[v];
+                    const u32 Planes = std::min(V.PlaneCount, kCullMaxPlanes);
+                    __m128 Outside = Zero;
+                    for (u32 p = 0; p < Planes; ++p) {
+                        const Vec4& P = V.Planes[p];
+                        const __m128 X = (P.X >= 0.0f) ? Hx : Lx;
+                        const __m128 Y = (P.Y >= 0.0f) ? Hy : Ly;
+                        const __m128 Z = (P.Z >= 0.0f) ? Hz : Lz;
+                        __m128 D = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(P.X), X), _mm_mul_ps(_mm_set1_ps(P.Y), Y));
+                        D = _mm_add_ps(D, _mm_mul_ps(_mm_set1_ps(P.Z), Z));
+                        D = _mm_add_ps(D, _mm_set1_ps(P.W));
+                        Outside = _mm_or_ps(Outside, _mm_cmplt_ps(D, Zero));
+                        if (_mm_movemask_ps(Outside) == 0xF) break; // as 4 ja sairam
+                    }
+                    EmitMask(_Out[v], static_cast<u32>(i), ~static_cast<u32>(_mm_movemask_ps(Outside)) & 0xFu);
+                }
+            }
+            return Count;
+        }
+
+        SMILE_CULL_AVX_FN
+        size_t FrustumsAVX(const FCullBounds& _B, size_t _Begin, size_t _End, std::span<const FCullFrustum> _Views,
+                           std::span<std::vector<u32>> _Out) {
+            const size_t Count = _Begin + ((_End - _Begin) & ~size_t(7));
+            const __m256 Zero  = _mm256_setzero_ps();
+            for (size_t i = _Begin; i < Count; i += 8) {
+                const __m256 Lx = _mm256_loadu_ps(_B.MinX.data() + i);
+                const __m256 Ly = _mm256_loadu_ps(_B.MinY.data() + i);
+                const __m256 Lz = _mm256_loadu_ps(_B.MinZ.data() + i);
+                const __m256 Hx = _mm256_loadu_ps(_B.MaxX.data() + i);
+                const __m256 Hy = _mm256_loadu_ps(_B.MaxY.data() + i);
+                const __m256 Hz = _mm256_loadu_ps(_B.MaxZ.data() + i);
+                for (size_t v = 0; v < _Views.size(); ++v) {
+                    const FCullFrustum& V = _Views[v];
+                    const u32 Planes = std::min(V.PlaneCount, kCullMaxPlanes);
+                    __m256 Outside = Zero;
+                    for (u32 p = 0; p < Planes; ++p) {
+                        const Vec4& P = V.Planes[p];
+                        const __m256 X = (P.X >= 0.0f) ? Hx : Lx;
+                        const __m256 Y = (P.Y >= 0.0f) ? Hy : Ly;
+                        const __m256 Z = (P.Z >= 0.0f) ? Hz : Lz;
+                        __m256 D = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(P.X), X),
+                                                 _mm256_mul_ps(_mm256_set1_ps(P.Y), Y));
+                        D = _mm256_add_ps(D, _mm256_mul_ps(_mm256_set1_ps(P.Z), Z));
+                        D = _mm256_add_ps(D, _mm256_set1_ps(P.W));
+                        Outside = _mm256_or_ps(Outside, _mm256_cmp_ps(D, Zero, _CMP_LT_OQ));
+                        if (_mm256_movemask_ps(Outside) == 0xFF) break;
+                    }
+                    EmitMask(_Out[v], static_cast<u32>(i), ~static_cast<u32>(_mm256_movemask_ps(Outside)) & 0xFFu);
+                }
+            }
+            return Count;
+        }
+
+        // Distancia por eixo sem desvio: (c < lo) ? lo - c : (c > hi) ? c - hi : 0, como no escalar.
+        __m128 AxisGapSSE(__m128 _C, __m128 _Lo, __m128 _Hi) {
+            const __m128 Below = _mm_cmplt_ps(_C, _Lo);
+            const __m128 Above = _mm_andnot_ps(Below, _mm_cmpgt_ps(_C, _Hi));
+            return _mm_or_ps(_mm_and_ps(Below, _mm_sub_ps(_Lo, _C)), _mm_and_ps(Above, _mm_sub_ps(_C, _Hi)));
+        }
+
+        size_t SphereSSE(const FCullBounds& _B, const f32 (&_C)[3], f32 _R2, std::vector<u32>& _Out) {
+            const size_t Count = _B.Size() & ~size_t(3);
+            const __m128 Cx = _mm_set1_ps(_C[0]), Cy = _mm_set1_ps(_C[1]), Cz = _mm_set1_ps(_C[2]);
+            const __m128 R2 = _mm_set1_ps(_R2);
+            for (size_t i = 0; i < Count; i += 4) {
+                const __m128 Dx = AxisGapSSE(Cx, _mm_loadu_ps(_B.MinX.data() + i), _mm_loadu_ps(_B.MaxX.data() + i));
+                const __m128 Dy = AxisGapSSE(Cy, _mm_loadu_ps(_B.MinY.data() + i), _mm_loadu_ps(_B.MaxY.data() + i));
+                const __m128 Dz = AxisGapSSE(Cz, _mm_loadu_ps(_B.MinZ.data() + i), _mm_loadu_ps(_B.MaxZ.data() + i));
+                // O escalar parte de 0 e so soma o eixo de fora; somar 0*0 nos de dentro da o mesmo.
+                const __m128 D2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Dx, Dx), _mm_mul_ps(Dy, Dy)), _mm_mul_ps(Dz, Dz));
+                EmitMask(_Out, static_cast<u32>(i), static_cast<u32>(_mm_movemask_ps(_mm_cmple_ps(D2, R2))));
+            }
+            return Count;
+        }
+
+        SMILE_CULL_AVX_FN
+        __m256 AxisGapAVX(__m256 _C, __m256 _Lo, __m256 _Hi) {
+            const __m256 Below = _mm256_cmp_ps(_C, _Lo, _CMP_LT_OQ);
+            const __m256 Above = _mm256_andnot_ps(Below, _mm256_cmp_ps(_C, _Hi, _CMP_GT_OQ));
+            return _mm256_or_ps(_mm256_and_ps(Below, _mm256_sub_ps(_Lo, _C)),
+                                _mm256_and_ps(Above, _mm256_sub_ps(_C, _Hi)));
+        }
+
+        SMILE_CULL_AVX_FN
+        size_t SphereAVX(const FCullBounds& _B, const f32 (&_C)[3], f32 _R2, std::vector<u32>& _Out) {
+            const size_t Count = _B.Size() & ~size_t(7);
+            const __m256 Cx = _mm256_set1_ps(_C[0]), Cy = _mm256_set1_ps(_C[1]), Cz = _mm256_set1_ps(_C[2]);
+            const __m256 R2 = _mm256_set1_ps(_R2);
+            for (size_t i = 0; i < Count; i += 8) {
+                const __m256 Dx =
+                    AxisGapAVX(Cx, _mm256_loadu_ps(_B.MinX.data() + i), _mm256_loadu_ps(_B.MaxX.data() + i));
+                const __m256 Dy =
+                    AxisGapAVX(Cy, _mm256_loadu_ps(_B.MinY.data() + i), _mm256_loadu_ps(_B.MaxY.data() + i));
+                const __m256 Dz =
+                    AxisGapAVX(Cz, _mm256_loadu_ps(_B.MinZ.data() + i), _mm256_loadu_ps(_B.MaxZ.data() + i));
+                const __m256 D2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(Dx, Dx), _mm256_mul_ps(Dy, Dy)),
+                                                _mm256_mul_ps(Dz, Dz));
+                EmitMask(_Out, static_cast<u32>(i),
+                         static_cast<u32>(_mm256_movemask_ps(_mm256_cmp_ps(D2, R2, _CMP_LE_OQ))));
+            }
+            return Count;
+        }
+
+        bool CpuHasAVX() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int Info[4];
+            __cpuid(Info, 1);
+            const bool OsSaves = (Info[2] & (1 << 27)) != 0; // OSXSAVE
+            const bool Avx     = (Info[2] & (1 << 28)) != 0;
+            // O SO precisa salvar os registradores YMM na troca de contexto (XCR0 bits 1 e 2).
+            return OsSaves && Avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            return __builtin_cpu_supports("avx");
+#endif
+        }
+#endif
+
+        ECullPath Resolve(ECullPath _Wanted) {
+            const ECullPath Best = DetectCullPath();
+            return static_cast<u8>(_Wanted) < static_cast<u8>(Best) ? _Wanted : Best;
+        }
+    }
+
+    FCullFrustum FCullFrustum::FromViewProj(const Mat44& _ViewProj) {
+        FCullFrustum F;
+        const Mat44& M = _ViewProj;
+        const Vec4 C0{ M.M[0][0], M.M[1][0], M.M[2][0], M.M[3][0] };
+        const Vec4 C1{ M.M[0][1], M.M[1][1], M.M[2][1], M.M[3][1] };
+        const Vec4 C2{ M.M[0][2], M.M[1][2], M.M[2][2], M.M[3][2] };
+        const Vec4 C3{ M.M[0][3], M.M[1][3], M.M[2][3], M.M[3][3] };
+        F.Planes[0] = { C3.X + C0.X, C3.Y + C0.Y, C3.Z + C0.Z, C3.W + C0.W }; // esquerda
+        F.Planes[1] = { C3.X - C0.X, C3.Y - C0.Y, C3.Z - C0.Z, C3.W - C0.W }; // direita
+        F.Planes[2] = { C3.X + C1.X, C3.Y + C1.Y, C3.Z + C1.Z, C3.W + C1.W }; // baixo
+        F.Planes[3] = { C3.X - C1.X, C3.Y - C1.Y, C3.Z - C1.Z, C3.W - C1.W }; // cima
+        F.Planes[4] = { C2.X,        C2.Y,        C2.Z,        C2.W        }; // near (z' >= 0)
+        F.Planes[5] = { C3.X - C2.X, C3.Y - C2.Y, C3.Z - C2.Z, C3.W - C2.W }; // far
+        F.PlaneCount = 6;
+        return F;
+    }
+
+    FCullFrustum FCullFrustum::FromPlanes(const Vec4* _Planes, u32 _Count) {
+        FCullFrustum F;
+        F.PlaneCount = std::min(_Count, kCullMaxPlanes);
+        for (u32 p = 0; p < F.PlaneCount; ++p) F.Planes[p] = _Planes[p];
+        return F;
+    }
+
+    ECullPath DetectCullPath() {
+#if defined(SMILE_CULL_X64)
+        static const ECullPath Best = CpuHasAVX() ? ECullPath::AVX : ECullPath::SSE;
+        return Best;
+#else
+        return ECullPath::Scalar;
+#endif
+    }
+
+    const char* CullPathName(ECullPath _Path) {
+        switch (_Path) {
+            case ECullPath::SSE: return "SSE";
+            case ECullPath::AVX: return "AVX";
+            default:             return "escalar";
+        }
+    }
+
+    bool AABBOutsideFrustum(const FCullFrustum& _View, const Vec3& _Min, const Vec3& _Max) {
+        return OutsideScalar(_View, _Min.X, _Min.Y, _Min.Z, _Max.X, _Max.Y, _Max.Z);
+    }
+
+    bool AABBTouchesSphere(const Vec3& _Min, const Vec3& _Max, const Vec3& _Center, f32 _Radius) {
+        const f32 C[3]  = { _Center.X, _Center.Y, _Center.Z };
+        const f32 Lo[3] = { _Min.X, _Min.Y, _Min.Z };
+        const f32 Hi[3] = { _Max.X, _Max.Y, _Max.Z };
+        return TouchesSphereScalar(C, _Radius * _Radius, Lo, Hi);
+    }
+
+    void CullFrustums(const FCullBounds& _Bounds, std::span<const FCullFrustum> _Views,
+                      std::span<std::vector<u32>> _Out, ECullPath _Path) {
+        CullFrustums(_Bounds, 0, _Bounds.Size(), _Views, _Out, _Path);
+    }
+
+    void CullFrustums(const FCullBounds& _Bounds, size_t _Begin, size_t _End, std::span<const FCullFrustum> _Views,
+                      std::span<std::vector<u32>> _Out, ECullPath _Path) {
+        _End   = std::min(_End, _Bounds.Size());
+        _Begin = std::min(_Begin, _End);
+        const std::span<const FCullFrustum> Views = _Views.first(std::min(_Views.size(), _Out.size()));
+        for (size_t v = 0; v < Views.size(); ++v) _Out[v].clear();
+        if (Views.empty()) return;
+
+        size_t Done = _Begin;
+#if defined(SMILE_CULL_X64)
+        switch (Resolve(_Path)) {
+            case ECullPath::AVX: Done = FrustumsAVX(_Bounds, _Begin, _End, Views, _Out); break;
+            case ECullPath::SSE: Done = FrustumsSSE(_Bounds, _Begin, _End, Views, _Out); break;
+            default: break;
+        }
+#else
+        (void)_Path;
+#endif
+        for (size_t i = Done; i < _End; ++i) {
+            for (size_t v = 0; v < Views.size(); ++v) {
+                if (!OutsideScalar(Views[v], _Bounds.MinX[i], _Bounds.MinY[i], _Bounds.MinZ[i],
+                                   _Bounds.MaxX[i], _Bounds.MaxY[i], _Bounds.MaxZ[i]))
+                    _Out[v].push_back(static_cast<u32>(i));
+            }
+        }
+    }
+
+    void CullSphere(const FCullBounds& _Bounds, const Vec3& _Center, f32 _Radius, std::vector<u32>& _Out,
+                    ECullPath _Path) {
+        _Out.clear();
+        const f32 C[3] = { _Center.X, _Center.Y, _Center.Z };
+        const f32 R2   = _Radius * _Radius;
+
+        size_t Done = 0;
+#if defined(SMILE_CULL_X64)
+        switch (Resolve(_Path)) {
+            case ECullPath::AVX: Done = SphereAVX(_Bounds, C, R2, _Out); break;
+            case ECullPath::SSE: Done = SphereSSE(_Bounds, C, R2, _Out); break;
+            default: break;
+        }
+#else
+        (void)_Path;
+#endif
+        for (size_t i = Done; i < _Bounds.Size(); ++i) {
+            const f32 Lo[3] = { _Bounds.MinX[i], _Bounds.MinY[i], _Bounds.MinZ[i] };
+            const f32 Hi[3] = { _Bounds.MaxX[i], _Bounds.MaxY[i], _Bounds.MaxZ[i] };
+            if (TouchesSphereScalar(C, R2, Lo, Hi)) _Out.push_back(static_cast<u32>(i));
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#include "Smile/Scene/GeometryStream.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace Smile {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        double MsSince(Clock::time_point _Start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - _Start).count();
+        }
+
+        bool HasGeometry(const FMeshView& _Mesh) {
+            return !_Mesh.Vertices.empty() && !_Mesh.Indices.empty();
+        }
+
+        u64 RtCountOf(const FMeshView& _Mesh) {
+            if (!HasGeometry(_Mesh)) return 0;
+            return _Mesh.RTTriangles.empty() ? _Mesh.Indices.size() / 3u : _Mesh.RTTriangles.size();
+        }
+
+        struct FPackedChunk {
+            u32                         ChunkIndex = 0;
+            std::vector<FGeometrySlice> Slices;
+        };
+
+        // Copia os meshes do chunk para o staging, no layout que o plano fixou. O payload de RT
+        // de malha runtime e gerado aqui, no scratch local — nunca sobrevive ao chunk.
+        FPackedChunk PackChunk(std::span<const FMeshView> _Meshes, const FGeometryChunk& _Chunk,
+                               u32 _ChunkIndex, IGeometryUploadSink& _Sink) {
+            FPackedChunk Out;
+            Out.ChunkIndex = _ChunkIndex;
+            Out.Slices.resize(_Chunk.MeshCount);
+            if (_Chunk.TotalBytes() == 0) return Out;
+
+            u8* Staging = _Sink.AcquireStaging(_ChunkIndex, _Chunk);
+            if (!Staging) throw std::runtime_error("StreamGeometry: sink nao entregou staging");
+
+            std::vector<FRTTriangle> Scratch;
+            u64 VbCursor = 0, IbCursor = _Chunk.VbBytes, RtCursor = _Chunk.RtBase;
+            for (u32 M = 0; M < _Chunk.MeshCount; ++M) {
+                const FMeshView& Mesh = _Meshes[_Chunk.FirstMesh + M];
+                if (!HasGeometry(Mesh)) continue;
+                Scratch.clear();
+                const std::span<const FRTTriangle> Rt = ResolveRTTriangles(Mesh, Scratch);
+                if (Rt.size() != RtCountOf(Mesh))
+                    throw std::runtime_error("StreamGeometry: payload de RT diverge do plano");
+
+                FGeometrySlice& Slice = Out.Slices[M];
+                Slice.VbOffset = VbCursor;
+                Slice.IbOffset = IbCursor;
+                Slice.RtOffset = RtCursor;
+                Slice.VertexCount     = static_cast<u32>(Mesh.Vertices.size());
+                Slice.IndexCount      = static_cast<u32>(Mesh.Indices.size());
+                Slice.RTTriangleCount = static_cast<u32>(Rt.size());
+                std::memcpy(Staging + VbCursor, Mesh.Vertices.data(), Mesh.Vertices.size_bytes());
+                std::memcpy(Staging + IbCursor, Mesh.Indices.data(),  Mesh.Indices.size_bytes());
+                if (!Rt.empty()) std::memcpy(Staging + RtCursor, Rt.data(), Rt.size_bytes());
+                VbCursor += Mesh.Vertices.size_bytes();
+                IbCursor += Mesh.Indices.size_bytes();
+                RtCursor += Rt.size_bytes();
+            }
+            return Out;
+        }
+    }
+
+    std::vector<FGeometryChunk> PlanGeometryChunks(std::span<const FMeshView> _Meshes, u64 _ChunkBudget) {
+        std::vector<FGeometryChunk> Plan;
+        size_t I = 0;
+        while (I < _Meshes.size()) {
+            FGeometryChunk Chunk;
+            Chunk.FirstMesh = static_cast<u32>(I);
+            for (; I < _Meshes.size(); ++I) {
+                const FMeshView& Mesh = _Meshes[I];
+                const u64 Vb = HasGeometry(Mesh) ? Mesh.Vertices.size_bytes() : 0;
+                const u64 Ib = HasGeometry(Mesh) ? Mesh.Indices.size_bytes()  : 0;
+                const u64 Rt = RtCountOf(Mesh) * sizeof(FRTTriangle);
+                const u64 Used = Chunk.VbBytes + Chunk.IbBytes + Chunk.RtBytes;
+                if (I > Chunk.FirstMesh && Used + Vb + Ib + Rt > _ChunkBudget) break;
+                Chunk.VbBytes += Vb;
+                Chunk.IbBytes += Ib;
+                Chunk.RtBytes += Rt;
+            }
+            Chunk.MeshCount = static_cast<u32>(I - Chunk.FirstMesh);
+            // ⚠️ O inicio da regiao de RT tem de ser multiplo de sizeof(FRTTriangle)=32. VbBytes ja
+            // e (sizeof(Vertex)=32); IbBytes e multiplo de 4 e NAO de 32, entao a soma e alinhada
+            // explicitamente. Sem isso o FirstElement do SRV truncaria e o mesh leria triangulos
+            // de outro — desalinhamento silencioso, que so apareceria como facing errado.
+            Chunk.RtBase = ((Chunk.VbBytes + Chunk.IbBytes + sizeof(FRTTriangle) - 1) / sizeof(FRTTriangle)) *
+                           sizeof(FRTTriangle);
+            Plan.push_back(Chunk);
+        }
+        return Plan;
+    }
+
+    FGeometryStreamStats StreamGeometry(std::span<const FMeshView> _Meshes, IGeometryUploadSink& _Sink,
+                                        const FGeometryStreamOptions& _Options) {
+        const Clock::time_point Start = Clock::now();
+        const std::vector<FGeometryChunk> Plan = PlanGeometryChunks(_Meshes, _Options.ChunkBudget);
+        FGeometryStreamStats Stats;
+        Stats.Chunks = static_cast<u32>(Plan.size());
+        for (const FGeometryChunk& Chunk : Plan) Stats.Bytes += Chunk.TotalBytes();
+        _Sink.BeginStream(Plan);
+
+        auto Submit = [&](const FPackedChunk& _Packed) {
+            const Clock::time_point SubmitStart = Clock::now();
+            _Sink.SubmitChunk(_Packed.ChunkIndex, Plan[_Packed.ChunkIndex], _Packed.Slices);
+            Stats.SubmitMs += MsSince(SubmitStart);
+        };
+
+        // Um chunk so nao tem o que sobrepor; a thread extra seria so custo.
+        if (!_Options.Pipelined || Plan.size() <= 1) {
+            for (u32 C = 0; C < Plan.size(); ++C) {
+                const Clock::time_point PackStart = Clock::now();
+                const FPackedChunk Packed = PackChunk(_Meshes, Plan[C], C, _Sink);
+                Stats.PackMs += MsSince(PackStart);
+                Stats.PeakInFlightBytes = std::max(Stats.PeakInFlightBytes, Plan[C].TotalBytes());
+                Submit(Packed);
+            }
+            Stats.WallMs = MsSince(Start);
+            return Stats;
+        }
+
+        // Estado compartilhado. Tudo sob o mesmo mutex: a troca e por chunk (dezenas a centenas de
+        // MB cada), entao contencao aqui nao existe.
+        std::mutex                 Mutex;
+        std::condition_variable    Changed;
+        std::deque<FPackedChunk>   Ready;
+        u64                        InFlight = 0;
+        bool                       Abort    = false;
+        std::exception_ptr         WorkerError;
+        double                     PackMs   = 0.0;
+
+        std::jthread Worker([&] {
+            for (u32 C = 0; C < Plan.size(); ++C) {
+                const u64 Bytes = Plan[C].TotalBytes();
+                {
+                    std::unique_lock Lock(Mutex);
+                    Changed.wait(Lock, [&] {
+                        return Abort || InFlight == 0 || InFlight + Bytes <= _Options.InFlightBudget;
+                    });
+                    if (Abort) return;
+                    InFlight += Bytes;
+                    Stats.PeakInFlightBytes = std::max(Stats.PeakInFlightBytes, InFlight);
+                }
+                try {
+                    const Clock::time_point PackStart = Clock::now();
+                    FPackedChunk Packed = PackChunk(_Meshes, Plan[C], C, _Sink);
+                    const double Ms = MsSince(PackStart);
+                    std::lock_guard Lock(Mutex);
+                    PackMs += Ms;
+                    Ready.push_back(std::move(Packed));
+                } catch (...) {
+                    std::lock_guard Lock(Mutex);
+                    WorkerError = std::current_exception();
+                    Changed.notify_all();
+                    return;
+                }
+                Changed.notify_all();
+            }
+        });
+
+        // Se o SubmitChunk lancar, o worker tem de parar antes de o jthread ser destruido (o join
+        // do destrutor esperaria um worker bloqueado no teto de memoria para sempre).
+        auto StopWorker = [&] {
+            {
+                std::lock_guard Lock(Mutex);
+                Abort = true;
+            }
+            Changed.notify_all();
+        };
+
+        for (u32 C = 0; C < Plan.size(); ++C) {
+            FPackedChunk Packed;
+            {
+                const Clock::time_point WaitStart = Clock::now();
+                std::unique_lock Lock(Mutex);
+                Changed.wait(Lock, [&] { return !Ready.empty() || WorkerError; });
+                Stats.StallMs += MsSince(WaitStart);
+                // Chunks que o worker terminou antes de falhar ainda sao submetidos; o erro so
+                // sobe quando nao ha mais nada pronto.
+                if (Ready.empty()) {
+                    const std::exception_ptr Error = WorkerError;
+                    Lock.unlock();
+                    Worker.join();
+                    std::rethrow_exception(Error);
+                }
+                Packed = std::move(Ready.front());
+                Ready.pop_front();
+            }
+            try {
+                Submit(Packed);
+            } catch (...) {
+                StopWorker();
+                throw;
+            }
+            {
+                std::lock_guard Lock(Mutex);
+                InFlight -= Plan[C].TotalBytes();
+            }
+            Changed.notify_all();
+        }
+        Worker.join();
+        Stats.PackMs = PackMs;
+        Stats.WallMs = MsSince(Start);
+        return Stats;
+    }
+}
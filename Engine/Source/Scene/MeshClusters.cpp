@@ -0,0 +1,159 @@
+#include "Smile/Scene/MeshClusters.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Smile {
+    namespace {
+        void ComputeBounds(std::span<const Vertex> _Vertices, std::span<const u32> _Indices, SMeshCluster& _C) {
+            const u32 VertexCount = static_cast<u32>(_Vertices.size());
+            for (int A = 0; A < 3; ++A) {
+                _C.AABBMin[A] = 1e30f;
+                _C.AABBMax[A] = -1e30f;
+            }
+            const u32 Begin = _C.FirstTriangle * 3u, End = Begin + _C.TriangleCount * 3u;
+            for (u32 I = Begin; I < End; ++I) {
+                if (_Indices[I] >= VertexCount) continue;
+                const f32* P = _Vertices[_Indices[I]].Position;
+                for (int A = 0; A < 3; ++A) {
+                    _C.AABBMin[A] = std::min(_C.AABBMin[A], P[A]);
+                    _C.AABBMax[A] = std::max(_C.AABBMax[A], P[A]);
+                }
+            }
+            if (_C.AABBMin[0] > _C.AABBMax[0])
+                for (int A = 0; A < 3; ++A) _C.AABBMin[A] = _C.AABBMax[A] = 0.0f;
+
+            // Esfera centrada na AABB com o raio do vertice mais distante: nao e a minima, mas e
+            // exata sobre os vertices e custa uma passada.
+            double Radius2 = 0.0;
+            for (int A = 0; A < 3; ++A) _C.Center[A] = 0.5f * (_C.AABBMin[A] + _C.AABBMax[A]);
+            for (u32 I = Begin; I < End; ++I) {
+                if (_Indices[I] >= VertexCount) continue;
+                const f32* P = _Vertices[_Indices[I]].Position;
+                double D2 = 0.0;
+                for (int A = 0; A < 3; ++A) D2 += (double(P[A]) - _C.Center[A]) * (double(P[A]) - _C.Center[A]);
+                Radius2 = std::max(Radius2, D2);
+            }
+            _C.Radius = static_cast<f32>(std::sqrt(Radius2));
+
+            // Cone: eixo = media das normais de face unitarias (cross na mesma ordem do
+            // BuildRTTriangles, entao "frente" e a da engine). Meio-angulo = o da normal mais
+            // afastada do eixo. Passou de 90 graus (ou nao ha normal valida), o cone nao serve.
+            auto FaceNormal = [&](u32 _T, double (&_N)[3]) {
+                const u32 I0 = _Indices[_T * 3u], I1 = _Indices[_T * 3u + 1u], I2 = _Indices[_T * 3u + 2u];
+                if (I0 >= VertexCount || I1 >= VertexCount || I2 >= VertexCount) return false;
+                const f32* P0 = _Vertices[I0].Position;
+                const f32* P1 = _Vertices[I1].Position;
+                const f32* P2 = _Vertices[I2].Position;
+                const double E1[3] = { double(P1[0]) - P0[0], double(P1[1]) - P0[1], double(P1[2]) - P0[2] };
+                const double E2[3] = { double(P2[0]) - P0[0], double(P2[1]) - P0[1], double(P2[2]) - P0[2] };
+                _N[0] = E1[1] * E2[2] - E1[2] * E2[1];
+                _N[1] = E1[2] * E2[0] - E1[0] * E2[2];
+                _N[2] = E1[0] * E2[1] - E1[1] * E2[0];
+                const double Length = std::sqrt(_N[0] * _N[0] + _N[1] * _N[1] + _N[2] * _N[2]);
+                if (Length <= 0.0) return false;
+                for (double& X : _N) X /= Length;
+                return true;
+            };
+            const u32 TriangleEnd = _C.FirstTriangle + _C.TriangleCount;
+            double Axis[3] = { 0.0, 0.0, 0.0 }, N[3];
+            for (u32 T = _C.FirstTriangle; T < TriangleEnd; ++T)
+                if (FaceNormal(T, N))
+                    for (int A = 0; A < 3; ++A) Axis[A] += N[A];
+            const double AxisLength = std::sqrt(Axis[0] * Axis[0] + Axis[1] * Axis[1] + Axis[2] * Axis[2]);
+            _C.ConeCutoff = 1.0f;
+            for (int A = 0; A < 3; ++A) _C.ConeAxis[A] = 0.0f;
+            if (AxisLength <= 1e-8) return;
+            for (double& X : Axis) X /= AxisLength;
+            double MinDot = 1.0;
+            for (u32 T = _C.FirstTriangle; T < TriangleEnd; ++T)
+                if (FaceNormal(T, N)) MinDot = std::min(MinDot, N[0] * Axis[0] + N[1] * Axis[1] + N[2] * Axis[2]);
+            for (int A = 0; A < 3; ++A) _C.ConeAxis[A] = static_cast<f32>(Axis[A]);
+            if (MinDot <= 0.0) return;
+            // Arredonda o seno PARA CIMA: o teste fica um ulp mais conservador, nunca menos.
+            _C.ConeCutoff = std::min(1.0f, std::nextafter(static_cast<f32>(std::sqrt(1.0 - MinDot * MinDot)), 2.0f));
+        }
+    }
+
+    void BuildMeshClusters(std::span<const Vertex> _Vertices, std::span<const u32> _Indices,
+                           std::vector<SMeshCluster>& _Out) {
+        _Out.clear();
+        const u32 TriangleCount = static_cast<u32>(_Indices.size() / 3);
+        if (TriangleCount == 0) return;
+        const u32 ClusterCount = (TriangleCount + kClusterMaxTriangles - 1) / kClusterMaxTriangles;
+        _Out.resize(ClusterCount);
+        // Tamanhos equilibrados: os `Extra` primeiros levam um triangulo a mais. Com T >= 64 e
+        // n = ceil(T/128), T/n fica em (64, 128] — nunca sobra um cluster de 3 triangulos no fim.
+        const u32 Base = TriangleCount / ClusterCount, Extra = TriangleCount % ClusterCount;
+        u32 First = 0;
+        for (u32 K = 0; K < ClusterCount; ++K) {
+            SMeshCluster& C = _Out[K];
+            C = SMeshCluster{};
+            C.FirstTriangle = First;
+            C.TriangleCount = Base + (K < Extra ? 1u : 0u);
+            First += C.TriangleCount;
+            ComputeBounds(_Vertices, _Indices, C);
+        }
+    }
+
+    FClusterCullView FClusterCullView::FromLocalToClip(const Mat44& _LocalToClip, const Vec3& _EyeLocal,
+                                                       bool _Backface) {
+        FClusterCullView V;
+        const Mat44& M = _LocalToClip;
+        const Vec4 C0{ M.M[0][0], M.M[1][0], M.M[2][0], M.M[3][0] };
+        const Vec4 C1{ M.M[0][1], M.M[1][1], M.M[2][1], M.M[3][1] };
+        const Vec4 C2{ M.M[0][2], M.M[1][2], M.M[2][2], M.M[3][2] };
+        const Vec4 C3{ M.M[0][3], M.M[1][3], M.M[2][3], M.M[3][3] };
+        V.Planes[0] = { C3.X + C0.X, C3.Y + C0.Y, C3.Z + C0.Z, C3.W + C0.W }; // esquerda
+        V.Planes[1] = { C3.X - C0.X, C3.Y - C0.Y, C3.Z - C0.Z, C3.W - C0.W }; // direita
+        V.Planes[2] = { C3.X + C1.X, C3.Y + C1.Y, C3.Z + C1.Z, C3.W + C1.W }; // baixo
+        V.Planes[3] = { C3.X - C1.X, C3.Y - C1.Y, C3.Z - C1.Z, C3.W - C1.W }; // cima
+        V.Planes[4] = { C2.X,        C2.Y,        C2.Z,        C2.W        }; // near (z' >= 0)
+        V.Planes[5] = { C3.X - C2.X, C3.Y - C2.Y, C3.Z - C2.Z, C3.W - C2.W }; // far
+        V.Eye      = _EyeLocal;
+        V.Backface = _Backface;
+        return V;
+    }
+
+    bool ClusterOutsideFrustum(const SMeshCluster& _C, const Vec4 (&_Planes)[6]) {
+        for (const Vec4& P : _Planes) {
+            const f32 X = (P.X >= 0.0f) ? _C.AABBMax[0] : _C.AABBMin[0];
+            const f32 Y = (P.Y >= 0.0f) ? _C.AABBMax[1] : _C.AABBMin[1];
+            const f32 Z = (P.Z >= 0.0f) ? _C.AABBMax[2] : _C.AABBMin[2];
+            if (P.X * X + P.Y * Y + P.Z * Z + P.W < 0.0f) return true;
+        }
+        return false;
+    }
+
+    bool ClusterBackfacing(const SMeshCluster& _C, const Vec3& _Eye) {
+        // cos(angulo entre eixo e centro) >= sen(meio-angulo do cone) + sen(meio-angulo da
+        // esfera vista do olho): toda direcao olho->ponto fica a <= 90 - alfa do eixo, e toda
+        // normal a <= alfa dele, entao nenhum triangulo encara o olho.
+        const Vec3 D{ _C.Center[0] - _Eye.X, _C.Center[1] - _Eye.Y, _C.Center[2] - _Eye.Z };
+        const Vec3 Axis{ _C.ConeAxis[0], _C.ConeAxis[1], _C.ConeAxis[2] };
+        return D.Dot(Axis) >= _C.ConeCutoff * D.Length() + _C.Radius;
+    }
+
+    u32 CullMeshClusters(std::span<const SMeshCluster> _Clusters, const FClusterCullView& _View,
+                         std::vector<u32>& _Visible, FClusterCullStats* _Stats) {
+        u32 Passed = 0, FrustumCulled = 0, ConeCulled = 0;
+        for (u32 I = 0; I < _Clusters.size(); ++I) {
+            const SMeshCluster& C = _Clusters[I];
+            if (ClusterOutsideFrustum(C, _View.Planes)) {
+                ++FrustumCulled;
+                continue;
+            }
+            if (_View.Backface && ClusterBackfacing(C, _View.Eye)) {
+                ++ConeCulled;
+                continue;
+            }
+            _Visible.push_back(I);
+            ++Passed;
+        }
+        if (_Stats) {
+            _Stats->Tested        += static_cast<u32>(_Clusters.size());
+            _Stats->FrustumCulled += FrustumCulled;
+            _Stats->ConeCulled    += ConeCulled;
+        }
+        return Passed;
+    }
+}
@@ -0,0 +1,287 @@
+#include "Smile/Scene/MeshLod.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace Smile {
+    namespace {
+        // Quadrica simetrica 4x4 (10 termos) ponderada por area. Avaliada e dividida pelo peso, da
+        // a distancia QUADRATICA MEDIA aos planos acumulados — a raiz vira o erro em unidades do
+        // mesh, e nao cresce so porque o vertice juntou muitos planos.
+        struct FQuadric {
+            double A2 = 0, AB = 0, AC = 0, AD = 0, B2 = 0, BC = 0, BD = 0, C2 = 0, CD = 0, D2 = 0;
+            double Weight = 0;
+
+            void AddPlane(double _A, double _B, double _C, double _D, double _Weight) {
+                A2 += _Weight * _A * _A; AB += _Weight * _A * _B; AC += _Weight * _A * _C; AD += _Weight * _A * _D;
+                B2 += _Weight * _B * _B; BC += _Weight * _B * _C; BD += _Weight * _B * _D;
+                C2 += _Weight * _C * _C; CD += _Weight * _C * _D;
+                D2 += _Weight * _D * _D;
+                Weight += _Weight;
+            }
+            FQuadric& operator+=(const FQuadric& _O) {
+                A2 += _O.A2; AB += _O.AB; AC += _O.AC; AD += _O.AD; B2 += _O.B2; BC += _O.BC; BD += _O.BD;
+                C2 += _O.C2; CD += _O.CD; D2 += _O.D2; Weight += _O.Weight;
+                return *this;
+            }
+        };
+
+        // Erro medio (quadratico) de levar os planos de `_A` e `_B` para `_P`.
+        double CollapseCost(const FQuadric& _A, const FQuadric& _B, const f32* _P) {
+            const double X = _P[0], Y = _P[1], Z = _P[2];
+            auto Eval = [&](const FQuadric& _Q) {
+                return _Q.A2 * X * X + 2.0 * _Q.AB * X * Y + 2.0 * _Q.AC * X * Z + 2.0 * _Q.AD * X +
+                       _Q.B2 * Y * Y + 2.0 * _Q.BC * Y * Z + 2.0 * _Q.BD * Y +
+                       _Q.C2 * Z * Z + 2.0 * _Q.CD * Z + _Q.D2;
+            };
+            const double Weight = _A.Weight + _B.Weight;
+            if (Weight <= 0.0) return 0.0;
+            return std::max(0.0, (Eval(_A) + Eval(_B)) / Weight);
+        }
+
+        void Cross(const f32* _P0, const f32* _P1, const f32* _P2, double (&_N)[3]) {
+            const double E1[3] = { double(_P1[0]) - _P0[0], double(_P1[1]) - _P0[1], double(_P1[2]) - _P0[2] };
+            const double E2[3] = { double(_P2[0]) - _P0[0], double(_P2[1]) - _P0[1], double(_P2[2]) - _P0[2] };
+            _N[0] = E1[1] * E2[2] - E1[2] * E2[1];
+            _N[1] = E1[2] * E2[0] - E1[0] * E2[2];
+            _N[2] = E1[0] * E2[1] - E1[1] * E2[0];
+        }
+
+        struct FCandidate {
+            double Cost;
+            u32    From; // vertice que some
+            u32    To;   // vertice que fica (ja existe no VB)
+        };
+
+        class FSimplifier {
+        public:
+            FSimplifier(std::span<const Vertex> _Vertices, std::span<const u32> _Indices)
+                : Vertices(_Vertices), Current(_Indices.begin(), _Indices.end()) {
+                const u32 VertexCount = static_cast<u32>(Vertices.size());
+                BuildGroups(VertexCount);
+                LockBorders();
+                Quadrics.assign(VertexCount, {});
+                Normals.assign(Current.size() / 3, {});
+                for (size_t T = 0; T + 2 < Current.size(); T += 3) {
+                    const u32 I0 = Current[T], I1 = Current[T + 1], I2 = Current[T + 2];
+                    double N[3];
+                    Cross(Vertices[I0].Position, Vertices[I1].Position, Vertices[I2].Position, N);
+                    const double Length = std::sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]);
+                    if (Length <= 0.0) continue;
+                    const double A = N[0] / Length, B = N[1] / Length, C = N[2] / Length;
+                    Normals[T / 3] = { A, B, C };
+                    const f32* P = Vertices[I0].Position;
+                    const double D = -(A * P[0] + B * P[1] + C * P[2]);
+                    const double Area = 0.5 * Length;
+                    for (const u32 I : { I0, I1, I2 }) Quadrics[Group[I]].AddPlane(A, B, C, D, Area);
+                }
+                Collapse.resize(VertexCount);
+                Touched.resize(VertexCount);
+            }
+
+            size_t TriangleCount() const { return Current.size() / 3; }
+            const std::vector<u32>& Indices() const { return Current; }
+            double Error() const { return std::sqrt(MaxCost); }
+
+            // Uma rodada de colapsos independentes (nenhum vertice participa de dois), do mais
+            // barato para o mais caro, ate remover `_Budget` triangulos. Devolve quantos colapsou.
+            u32 Pass(size_t _Budget) {
+                const u32 VertexCount = static_cast<u32>(Vertices.size());
+                // Vertice -> triangulos, do IB atual.
+                Offsets.assign(VertexCount + 1, 0);
+                for (const u32 I : Current) ++Offsets[I + 1];
+                std::partial_sum(Offsets.begin(), Offsets.end(), Offsets.begin());
+                Adjacency.resize(Current.size());
+                std::vector<u32> Cursor(Offsets.begin(), Offsets.end() - 1);
+                for (size_t I = 0; I < Current.size(); ++I) Adjacency[Cursor[Current[I]]++] = u32(I / 3);
+
+                Candidates.clear();
+                for (size_t T = 0; T < Current.size(); T += 3)
+                    for (u32 E = 0; E < 3; ++E) {
+                        const u32 A = Current[T + E], B = Current[T + (E + 1) % 3];
+                        if (!Locked[Group[A]]) Candidates.push_back({ Cost(A, B), A, B });
+                        if (!Locked[Group[B]]) Candidates.push_back({ Cost(B, A), B, A });
+                    }
+                // Desempate total: a saida tem de ser a mesma em qualquer maquina e execucao.
+                std::sort(Candidates.begin(), Candidates.end(), [](const FCandidate& _L, const FCandidate& _R) {
+                    if (_L.Cost != _R.Cost) return _L.Cost < _R.Cost;
+                    if (_L.From != _R.From) return _L.From < _R.From;
+                    return _L.To < _R.To;
+                });
+
+                std::iota(Collapse.begin(), Collapse.end(), 0u);
+                std::fill(Touched.begin(), Touched.end(), u8(0));
+                size_t Removed = 0;
+                u32    Count   = 0;
+                for (const FCandidate& C : Candidates) {
+                    if (Removed >= _Budget) break;
+                    if (Touched[C.From] || Touched[C.To]) continue;
+                    size_t WouldRemove = 0;
+                    if (!CollapseKeepsOrientation(C.From, C.To, WouldRemove)) continue;
+
+                    Collapse[C.From] = C.To;
+                    // Os vizinhos tambem congelam: a adjacencia e as posicoes que o teste de
+                    // orientacao deles leria ficaram velhas com este colapso.
+                    for (u32 K = Offsets[C.From]; K < Offsets[C.From + 1]; ++K)
+                        for (u32 J = 0; J < 3; ++J) Touched[Current[Adjacency[K] * 3 + J]] = 1;
+                    Touched[C.To] = 1;
+                    Quadrics[Group[C.To]] += Quadrics[Group[C.From]];
+                    MaxCost = std::max(MaxCost, C.Cost);
+                    Removed += WouldRemove;
+                    ++Count;
+                }
+
+                size_t Out = 0;
+                for (size_t T = 0; T < Current.size(); T += 3) {
+                    const u32 A = Collapse[Current[T]], B = Collapse[Current[T + 1]], C = Collapse[Current[T + 2]];
+                    if (A == B || B == C || A == C) continue;
+                    Normals[Out / 3] = Normals[T / 3];
+                    Current[Out++] = A;
+                    Current[Out++] = B;
+                    Current[Out++] = C;
+                }
+                Current.resize(Out);
+                Normals.resize(Out / 3);
+                return Count;
+            }
+
+        private:
+            // Grupo = menor indice de vertice com os mesmos 12 bytes de posicao. Grupo com mais de
+            // um vertice e costura (UV, normal dura, ilha espelhada): travado.
+            void BuildGroups(u32 _VertexCount) {
+                std::vector<u32> Order(_VertexCount);
+                std::iota(Order.begin(), Order.end(), 0u);
+                auto Less = [&](u32 _A, u32 _B) {
+                    const int Cmp = std::memcmp(Vertices[_A].Position, Vertices[_B].Position, sizeof(f32) * 3);
+                    return Cmp != 0 ? Cmp < 0 : _A < _B;
+                };
+                std::sort(Order.begin(), Order.end(), Less);
+                Group.resize(_VertexCount);
+                Locked.assign(_VertexCount, 0);
+                for (size_t I = 0; I < Order.size();) {
+                    size_t J = I + 1;
+                    while (J < Order.size() &&
+                           std::memcmp(Vertices[Order[I]].Position, Vertices[Order[J]].Position, sizeof(f32) * 3) == 0)
+                        ++J;
+                    for (size_t K = I; K < J; ++K) Group[Order[K]] = Order[I];
+                    if (J - I > 1) Locked[Order[I]] = 1;
+                    I = J;
+                }
+            }
+
+            // Aresta (por grupo) sem a oposta = borda aberta: as duas pontas travam, ou a silhueta
+            // do recorte encolheria.
+            void LockBorders() {
+                std::vector<u64> Edges;
+                Edges.reserve(Current.size());
+                for (size_t T = 0; T + 2 < Current.size(); T += 3)
+                    for (u32 E = 0; E < 3; ++E) {
+                        const u32 A = Group[Current[T + E]], B = Group[Current[T + (E + 1) % 3]];
+                        if (A != B) Edges.push_back(u64(A) << 32 | B);
+                    }
+                std::sort(Edges.begin(), Edges.end());
+                for (const u64 Edge : Edges) {
+                    const u32 A = u32(Edge >> 32), B = u32(Edge);
+                    if (!std::binary_search(Edges.begin(), Edges.end(), u64(B) << 32 | A)) Locked[A] = Locked[B] = 1;
+                }
+            }
+
+            double Cost(u32 _From, u32 _To) const {
+                return CollapseCost(Quadrics[Group[_From]], Quadrics[Group[_To]], Vertices[_To].Position);
+            }
+
+            // Todo triangulo de `_From` que sobrevive ao colapso mantem a orientacao e area nao
+            // nula; os que tem `_To` somem e sao contados em `_Removed`. A referencia e a normal do
+            // triangulo ORIGINAL de que a posicao descende, nao a da rodada anterior: girar um
+            // pouco a cada colapso somaria ate virar uma aleta em pe na superficie (costura
+            // travada dos dois lados). Limite de ~75 graus sobre a original.
+            bool CollapseKeepsOrientation(u32 _From, u32 _To, size_t& _Removed) const {
+                for (u32 K = Offsets[_From]; K < Offsets[_From + 1]; ++K) {
+                    const u32* Tri = &Current[Adjacency[K] * 3];
+                    if (Tri[0] == _To || Tri[1] == _To || Tri[2] == _To) {
+                        ++_Removed;
+                        continue;
+                    }
+                    const f32* P[3];
+                    const f32* Q[3];
+                    for (u32 J = 0; J < 3; ++J) {
+                        P[J] = Vertices[Tri[J]].Position;
+                        Q[J] = Tri[J] == _From ? Vertices[_To].Position : P[J];
+                    }
+                    double Before[3], After[3];
+                    Cross(P[0], P[1], P[2], Before);
+                    Cross(Q[0], Q[1], Q[2], After);
+                    const std::array<double, 3>& Original = Normals[Adjacency[K]];
+                    const double* Reference = Original[0] != 0.0 || Original[1] != 0.0 || Original[2] != 0.0
+                                                  ? Original.data() : Before; // original de area nula
+                    const double Dot = Reference[0] * After[0] + Reference[1] * After[1] + Reference[2] * After[2];
+                    const double ReferenceLength2 =
+                        Reference[0] * Reference[0] + Reference[1] * Reference[1] + Reference[2] * Reference[2];
+                    const double AfterLength2 = After[0] * After[0] + After[1] * After[1] + After[2] * After[2];
+                    if (AfterLength2 <= 0.0 || Dot <= 0.25 * std::sqrt(ReferenceLength2 * AfterLength2)) return false;
+                }
+                return true;
+            }
+
+            std::span<const Vertex> Vertices;
+            std::vector<u32>        Current;
+            std::vector<u32>        Group;
+            std::vector<u8>         Locked; // por grupo
+            std::vector<FQuadric>   Quadrics; // por grupo
+            std::vector<std::array<double, 3>> Normals; // por triangulo de Current, a do original
+            std::vector<u32>        Offsets, Adjacency, Collapse;
+            std::vector<u8>         Touched;
+            std::vector<FCandidate> Candidates;
+            double                  MaxCost = 0.0;
+        };
+    }
+
+    void BuildMeshLods(std::span<const Vertex> _Vertices, std::span<const u32> _Indices,
+                       std::vector<SMeshLod>& _OutLevels, std::vector<u32>& _OutIndices,
+                       const FMeshLodOptions& _Options) {
+        _OutLevels.clear();
+        _OutIndices.clear();
+        if (_Indices.size() < 3 || _Indices.size() % 3 != 0 || _Options.MaxLevels == 0) return;
+        for (const u32 I : _Indices)
+            if (I >= _Vertices.size()) return;
+
+        FSimplifier Simplifier(_Vertices, _Indices);
+        size_t Previous = Simplifier.TriangleCount();
+        for (u32 Level = 0; Level < _Options.MaxLevels && Previous >= _Options.MinTriangles; ++Level) {
+            const size_t Target = std::max<size_t>(1, static_cast<size_t>(double(Previous) * _Options.Ratio));
+            while (Simplifier.TriangleCount() > Target)
+                if (Simplifier.Pass(Simplifier.TriangleCount() - Target) == 0) break;
+
+            const size_t Triangles = Simplifier.TriangleCount();
+            if (Triangles == 0 || double(Triangles) > double(Previous) * _Options.MinReduction) break;
+            SMeshLod Out{};
+            Out.FirstIndex = static_cast<u32>(_OutIndices.size());
+            Out.IndexCount = static_cast<u32>(Triangles * 3);
+            // Arredonda PARA CIMA: o erro guardado nunca promete menos do que foi medido.
+            Out.Error = std::nextafter(static_cast<f32>(Simplifier.Error()), 1e30f);
+            if (!_OutLevels.empty()) Out.Error = std::max(Out.Error, _OutLevels.back().Error);
+            _OutLevels.push_back(Out);
+            _OutIndices.insert(_OutIndices.end(), Simplifier.Indices().begin(), Simplifier.Indices().end());
+            Previous = Triangles;
+        }
+    }
+
+    f32 MeshLodScreenError(const SMeshLod& _Level, f32 _Distance, f32 _FovYRadians, f32 _Scale) {
+        // Mesma conta do screen-size do FTerrain (raio / (dist * tan(fov/2))), aqui com o erro no
+        // lugar do raio e sobre a altura INTEIRA da tela, dai o 2.
+        const f32 TanHalfFov = std::tan(0.5f * _FovYRadians);
+        const f32 Distance   = std::max(_Distance, 1e-3f);
+        return _Level.Error * _Scale / (2.0f * Distance * TanHalfFov);
+    }
+
+    u32 SelectMeshLod(std::span<const SMeshLod> _Levels, f32 _Distance, f32 _FovYRadians, f32 _Scale,
+                      f32 _MaxScreenError) {
+        // Erros nao decrescem com o nivel: o primeiro que cabe, vindo do mais grosso, e o mais
+        // grosso que cabe.
+        for (u32 K = static_cast<u32>(_Levels.size()); K > 0; --K)
+            if (MeshLodScreenError(_Levels[K - 1], _Distance, _FovYRadians, _Scale) <= _MaxScreenError) return K;
+        return 0;
+    }
+}
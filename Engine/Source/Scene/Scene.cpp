@@ -2,158 +2,149 @@
 #include "Smile/Graphics/Backend/D3D12/GpuResources.h"
 #include "Smile/Graphics/Backend/D3D12/UploadQueue.h"
 #include "Smile/Core/HResultCheck.h"
+#include "Smile/Core/Logger.h"
+#include "Smile/Scene/GeometryStream.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Smile {
-    Mat44 FTransform::Matrix() const {
-        const Mat44 S = Mat44::Scale(Scale);
-        const Mat44 R = Mat44::RotationEulerXYZ(RotationEuler);
-        const Mat44 T = Mat44::Translation(Position);
-        return S * R * T;
+    namespace {
+        // Caixa de mundo pelo World em cache. O laco da hierarquia chama direto: la o World acabou
+        // de sair do Update e recompor do Transform seria trabalho jogado fora.
+        void BoundsFromWorld(FRenderable& _R) {
+            const Mat44& Model = _R.World;
+            // Ponto x matriz a mao: o Mat44::operator*(Vec4) e da convencao COLUNA e o FTransform
+            // monta LINHA (translacao em M[3], igual ao mul(float4(pos,1), MVP) dos shaders).
+            auto ToWorld = [&Model](const Vec3& P) {
+                return Vec3{
+                    P.X*Model.M[0][0] + P.Y*Model.M[1][0] + P.Z*Model.M[2][0] + Model.M[3][0],
+                    P.X*Model.M[0][1] + P.Y*Model.M[1][1] + P.Z*Model.M[2][1] + Model.M[3][1],
+                    P.X*Model.M[0][2] + P.Y*Model.M[1][2] + P.Z*Model.M[2][2] + Model.M[3][2] };
+            };
+            // Os 8 CANTOS, nao os dois extremos: sob rotacao a caixa alinhada aos eixos do resultado
+            // nao e a imagem de min/max — projetar so os dois daria um volume menor que o objeto e o
+            // culling comeria pedaco de geometria.
+            Vec3 Min{  1e30f,  1e30f,  1e30f };
+            Vec3 Max{ -1e30f, -1e30f, -1e30f };
+            for (int Corner = 0; Corner < 8; ++Corner) {
+                const Vec3 W = ToWorld(Vec3{ (Corner & 1) ? _R.LocalAABBMax.X : _R.LocalAABBMin.X,
+                                             (Corner & 2) ? _R.LocalAABBMax.Y : _R.LocalAABBMin.Y,
+                                             (Corner & 4) ? _R.LocalAABBMax.Z : _R.LocalAABBMin.Z });
+                Min.X = std::min(Min.X, W.X); Max.X = std::max(Max.X, W.X);
+                Min.Y = std::min(Min.Y, W.Y); Max.Y = std::max(Max.Y, W.Y);
+                Min.Z = std::min(Min.Z, W.Z); Max.Z = std::max(Max.Z, W.Z);
+            }
+            _R.AABBMin = Min;
+            _R.AABBMax = Max;
+        }
     }
 
     void FRenderable::RefreshWorldBounds() {
-        const Mat44 Model = Transform.Matrix();
-        // Ponto x matriz a mao: o Mat44::operator*(Vec4) e da convencao COLUNA e o FTransform
-        // monta LINHA (translacao em M[3], igual ao mul(float4(pos,1), MVP) dos shaders).
-        auto ToWorld = [&Model](const Vec3& P) {
-            return Vec3{
-                P.X*Model.M[0][0] + P.Y*Model.M[1][0] + P.Z*Model.M[2][0] + Model.M[3][0],
-                P.X*Model.M[0][1] + P.Y*Model.M[1][1] + P.Z*Model.M[2][1] + Model.M[3][1],
-                P.X*Model.M[0][2] + P.Y*Model.M[1][2] + P.Z*Model.M[2][2] + Model.M[3][2] };
-        };
-        // Os 8 CANTOS, nao os dois extremos: sob rotacao a caixa alinhada aos eixos do resultado
-        // nao e a imagem de min/max — projetar so os dois daria um volume menor que o objeto e o
-        // culling comeria pedaco de geometria.
-        Vec3 Min{  1e30f,  1e30f,  1e30f };
-        Vec3 Max{ -1e30f, -1e30f, -1e30f };
-        for (int Corner = 0; Corner < 8; ++Corner) {
-            const Vec3 W = ToWorld(Vec3{ (Corner & 1) ? LocalAABBMax.X : LocalAABBMin.X,
-                                         (Corner & 2) ? LocalAABBMax.Y : LocalAABBMin.Y,
-                                         (Corner & 4) ? LocalAABBMax.Z : LocalAABBMin.Z });
-            Min.X = std::min(Min.X, W.X); Max.X = std::max(Max.X, W.X);
-            Min.Y = std::min(Min.Y, W.Y); Max.Y = std::max(Max.Y, W.Y);
-            Min.Z = std::min(Min.Z, W.Z); Max.Z = std::max(Max.Z, W.Z);
-        }
-        AABBMin = Min;
-        AABBMax = Max;
+        if (Parent < 0) World = Transform.Matrix();
+        BoundsFromWorld(*this);
     }
 
     FGpuMesh* FScene::AddMesh(ID3D12Device* _Device, const FMesh& _Mesh) {
         auto Gpu = std::make_unique<FGpuMesh>();
         Gpu->Upload(_Device, _Mesh);
         FGpuMesh* Ptr = Gpu.get();
+        Gpu->SortId = static_cast<u32>(MeshLibrary.size()) + 1u;
         MeshLibrary.push_back(std::move(Gpu));
         return Ptr;
     }
 
     std::vector<FGpuMesh*> FScene::AddMeshesBatch(ID3D12Device* _Device, FUploadQueue& _UploadQueue,
                                                   const std::vector<FMesh>& _Meshes) {
-        // Pool de geometria: cada chunk vira UM buffer default-heap ([VBs desde 0][IBs])
-        // + UM staging, com uma copia e uma barrier — em vez de 2 committed resources
-        // (heap >=64KB cada) + 2 stagings por mesh. Os meshes viram fatias (InitFromPool);
-        // o pool vive pelo refcount dos ComPtrs de cada mesh.
-        std::vector<FGpuMesh*> Out;
-        Out.reserve(_Meshes.size());
-        constexpr u64 kChunkBudget = 256ull * 1024 * 1024;
-
-        // Payload de RT por mesh. Da cena cozida ele ja vem no FMesh; do proxy do terreno (e de
-        // qualquer malha construida em runtime) nao vem, e o scratch abaixo o gera UMA vez —
-        // as duas passadas (dimensionar o chunk, copiar para o staging) leem o mesmo resultado.
-        std::vector<std::vector<FRTTriangle>> RtScratch(_Meshes.size());
-        auto RtOf = [&](size_t _M) -> const std::vector<FRTTriangle>& {
-            return ResolveRTTriangles(_Meshes[_M], RtScratch[_M]);
-        };
+        std::vector<FMeshView> Views;
+        Views.reserve(_Meshes.size());
+        for (const FMesh& Mesh : _Meshes) Views.push_back(FMeshView::Of(Mesh));
+        return AddMeshesBatch(_Device, _UploadQueue, Views);
+    }
+
+    namespace {
+        // Sink D3D12 do pipeline de geometria: cada chunk vira UM buffer default-heap (o pool,
+        // [VBs desde 0][IBs][RT]) + UM staging, com uma copia — em vez de 2 committed resources
+        // (heap >=64KB cada) + 2 stagings por mesh. Os meshes viram fatias (InitFromPool); o
+        // pool vive pelo refcount dos ComPtrs de cada mesh.
+        class FPoolUploadSink final : public IGeometryUploadSink {
+        public:
+            FPoolUploadSink(ID3D12Device* _Device, FUploadQueue& _UploadQueue,
+                            std::vector<std::unique_ptr<FGpuMesh>>& _Library, std::vector<FGpuMesh*>& _Out)
+                : Device(_Device), UploadQueue(_UploadQueue), Library(_Library), Out(_Out) {}
 
-        size_t i = 0;
-        while (i < _Meshes.size()) {
-            // Layout do chunk: [VB][IB][RTTri]. Slices empacotados sem padding dentro de cada
-            // regiao — cada tamanho e multiplo do stride da regiao, entao todo offset sai
-            // multiplo dele (FirstElement dos SRVs bindless e exato). A regiao de IB comeca em
-            // VbTotal (multiplo de 4, pois sizeof(Vertex)=32) e a de RT em VbTotal+IbTotal.
-            //
-            // ⚠️ O inicio da regiao de RT tem de ser multiplo de sizeof(FRTTriangle)=32. VbTotal
-            // ja e multiplo de 32; IbTotal e multiplo de 4 e NAO de 32, entao a soma e alinhada
-            // explicitamente. Sem isso o FirstElement truncaria e o mesh leria triangulos de
-            // outro — desalinhamento silencioso, que so apareceria como facing errado.
-            const size_t First = i;
-            u64 VbTotal = 0, IbTotal = 0, RtTotal = 0;
-            for (; i < _Meshes.size(); ++i) {
-                const u64 RtBytes = RtOf(i).size() * sizeof(FRTTriangle);
-                const u64 Add = _Meshes[i].Vertices.size() * sizeof(Vertex)
-                              + _Meshes[i].Indices.size()  * sizeof(u32) + RtBytes;
-                if (i > First && VbTotal + IbTotal + RtTotal + Add > kChunkBudget) break;
-                VbTotal += _Meshes[i].Vertices.size() * sizeof(Vertex);
-                IbTotal += _Meshes[i].Indices.size()  * sizeof(u32);
-                RtTotal += RtBytes;
+            void BeginStream(std::span<const FGeometryChunk> _Plan) override {
+                Staging.resize(_Plan.size());
             }
-            const u64 RtBase = ((VbTotal + IbTotal + sizeof(FRTTriangle) - 1)
-                                / sizeof(FRTTriangle)) * sizeof(FRTTriangle);
-            const u64 Total  = RtBase + RtTotal;
-            if (Total == 0) {
-                for (size_t m = First; m < i; ++m) {
-                    auto Gpu = std::make_unique<FGpuMesh>(); // invalido (IndexCount 0)
-                    Out.push_back(Gpu.get());
-                    MeshLibrary.push_back(std::move(Gpu));
-                }
-                continue;
+
+            // Thread do worker. So cria o upload buffer: criar recurso no device e free-threaded
+            // e os contadores do GpuResources sao atomicos. Staging do chunk INTEIRO (ate 256 MB)
+            // fora do ring da fila de upload de proposito: e uma alocacao grande e unica por
+            // chunk, nao o churn de uma por recurso que o ring existe para resolver.
+            u8* AcquireStaging(u32 _ChunkIndex, const FGeometryChunk& _Chunk) override {
+                Staging[_ChunkIndex] = GpuResources::CreateUploadBuffer(Device, _Chunk.TotalBytes(), 1, false);
+                return Staging[_ChunkIndex].Mapped;
             }
 
-            Microsoft::WRL::ComPtr<ID3D12Resource> Pool =
-                FGpuMesh::CreatePoolBuffer(_Device, Total);
-
-            // Staging do chunk INTEIRO (ate 256 MB). Fica fora do ring da fila de upload de
-            // proposito: e uma alocacao grande e unica por chunk, nao o churn de uma por
-            // recurso que o ring existe para resolver.
-            const GpuResources::FUploadBuffer StagingBuffer =
-                GpuResources::CreateUploadBuffer(_Device, Total, 1, false);
-            Microsoft::WRL::ComPtr<ID3D12Resource> Staging = StagingBuffer.Resource;
-            u8* Mapped = StagingBuffer.Mapped;
-
-            u64 VbCursor = 0, IbCursor = VbTotal, RtCursor = RtBase;
-            for (size_t m = First; m < i; ++m) {
-                const FMesh& Mesh = _Meshes[m];
-                const std::vector<FRTTriangle>& Rt = RtOf(m);
-                const u64 VbSize = Mesh.Vertices.size() * sizeof(Vertex);
-                const u64 IbSize = Mesh.Indices.size()  * sizeof(u32);
-                const u64 RtSize = Rt.size()            * sizeof(FRTTriangle);
-                auto Gpu = std::make_unique<FGpuMesh>();
-                if (VbSize > 0 && IbSize > 0) {
-                    std::memcpy(Mapped + VbCursor, Mesh.Vertices.data(), VbSize);
-                    std::memcpy(Mapped + IbCursor, Mesh.Indices.data(),  IbSize);
-                    if (RtSize > 0) std::memcpy(Mapped + RtCursor, Rt.data(), RtSize);
-                    Gpu->InitFromPool(Pool, VbCursor, IbCursor, RtCursor,
-                                      static_cast<u32>(Mesh.Vertices.size()),
-                                      static_cast<u32>(Mesh.Indices.size()),
-                                      static_cast<u32>(Rt.size()));
-                    VbCursor += VbSize;
-                    IbCursor += IbSize;
-                    RtCursor += RtSize;
+            // Thread chamadora: pool, fatias e a gravacao na fila COPY ficam onde sempre estiveram.
+            void SubmitChunk(u32 _ChunkIndex, const FGeometryChunk& _Chunk,
+                             std::span<const FGeometrySlice> _Slices) override {
+                ComPtr<ID3D12Resource> Pool;
+                if (_Chunk.TotalBytes() > 0) Pool = FGpuMesh::CreatePoolBuffer(Device, _Chunk.TotalBytes());
+                for (const FGeometrySlice& Slice : _Slices) {
+                    auto Gpu = std::make_unique<FGpuMesh>(); // sem geometria: invalido (IndexCount 0)
+                    if (Slice.IndexCount > 0)
+                        Gpu->InitFromPool(Pool, Slice.VbOffset, Slice.IbOffset, Slice.RtOffset,
+                                          Slice.VertexCount, Slice.IndexCount, Slice.RTTriangleCount);
+                    Gpu->SortId = static_cast<u32>(Library.size()) + 1u;
+                    Out.push_back(Gpu.get());
+                    Library.push_back(std::move(Gpu));
                 }
-                Out.push_back(Gpu.get());
-                MeshLibrary.push_back(std::move(Gpu));
+                if (!Pool) return;
+
+                // Fila COPY, sem bloquear e sem barrier: buffer promove/decai implicitamente
+                // (VB/IB/SRV de BLAS leem via promotion na fila direta). O staging fica retido
+                // pela fila; o SceneLoader da o WaitIdle antes do primeiro consumo. Sem Unmap: o
+                // staging da fabrica e mapeado de forma persistente e morre com o Keep.
+                ID3D12GraphicsCommandList* CommandList = UploadQueue.Begin();
+                CommandList->CopyBufferRegion(Pool.Get(), 0, Staging[_ChunkIndex].Resource.Get(), 0,
+                                              _Chunk.TotalBytes());
+                std::vector<ComPtr<ID3D12Resource>> Keep;
+                Keep.push_back(std::move(Staging[_ChunkIndex].Resource));
+                Staging[_ChunkIndex] = {};
+                UploadQueue.Submit(std::move(Keep));
             }
-            // Sem Unmap: o staging da fabrica e mapeado de forma persistente e morre com o
-            // Keep abaixo, quando a fence da copia passar.
-
-            // Fila COPY, sem bloquear e sem barrier: buffer promove/decai implicitamente
-            // (VB/IB/SRV de BLAS leem via promotion na fila direta). O staging fica retido
-            // pela fila; o SceneLoader da o WaitIdle antes do primeiro consumo.
-            ID3D12GraphicsCommandList* CommandList = _UploadQueue.Begin();
-            CommandList->CopyBufferRegion(Pool.Get(), 0, Staging.Get(), 0, Total);
-            std::vector<ComPtr<ID3D12Resource>> Keep;
-            Keep.push_back(std::move(Staging));
-            _UploadQueue.Submit(std::move(Keep));
-        }
+
+        private:
+            ID3D12Device*                             Device;
+            FUploadQueue&                             UploadQueue;
+            std::vector<std::unique_ptr<FGpuMesh>>&   Library;
+            std::vector<FGpuMesh*>&                   Out;
+            // Indexado pelo chunk: o worker escreve o i, a chamadora le o i depois da troca
+            // sincronizada pelo pipeline — nenhum indice e tocado pelas duas ao mesmo tempo.
+            std::vector<GpuResources::FUploadBuffer>  Staging;
+        };
+    }
+
+    std::vector<FGpuMesh*> FScene::AddMeshesBatch(ID3D12Device* _Device, FUploadQueue& _UploadQueue,
+                                                  std::span<const FMeshView> _Meshes) {
+        std::vector<FGpuMesh*> Out;
+        Out.reserve(_Meshes.size());
+        FPoolUploadSink Sink(_Device, _UploadQueue, MeshLibrary, Out);
+        const FGeometryStreamStats Stats = StreamGeometry(_Meshes, Sink);
+        if (Stats.Chunks > 1)
+            LogDebug("Geometria: " + std::to_string(Stats.Chunks) + " chunks, " +
+                     std::to_string(Stats.Bytes >> 20) + " MB | empacotar=" + std::to_string((int)Stats.PackMs) +
+                     " submeter=" + std::to_string((int)Stats.SubmitMs) +
+                     " espera=" + std::to_string((int)Stats.StallMs) +
+                     " total=" + std::to_string((int)Stats.WallMs) + " ms");
         return Out;
     }
 
     FRenderable& FScene::AddRenderable(const FRenderable& _Renderable) {
         RenderableList.push_back(_Renderable);
         FRenderable& Added = RenderableList.back();
-        Added.Id = AllocObjectId(); // identidade nova mesmo se veio de uma copia
-        RenderableIndexById_.emplace(Added.Id,
-                                     static_cast<u32>(RenderableList.size() - 1));
+        // Identidade nova mesmo se veio de uma copia.
+        Added.Id = Handles_.Allocate(ESceneObject::Renderable, static_cast<u32>(RenderableList.size() - 1));
         ++StructureVersion_;
         // Objeto que nasce ou morre muda o CONTEUDO do mapa estatico, nao so o indice: o
         // shadow map cacheado precisa ser re-rasterizado. Ver StaticCastersVersion.
@@ -167,20 +158,60 @@ namespace Smile {
     }
 
     bool FScene::RemoveRenderable(u64 _Id) {
-        const int Index = IndexOfRenderable(_Id);
-        if (Index < 0) return false;
-        // Erase ESTAVEL, nao swap-and-pop: as pastas do Scene Outliner sao ranges [begin,end)
-        // sobre esta lista, e trocar o removido com o ultimo jogaria uma mesh de outro asset
-        // para dentro de uma pasta alheia. O memmove de ~2,5k structs e irrelevante numa acao
-        // de editor.
-        RenderableList.erase(RenderableList.begin() + Index);
-        RebuildRenderableIndex();
+        return RemoveRenderables({ &_Id, 1 }) == 1;
+    }
+
+    u32 FScene::RemoveRenderables(std::span<const u64> _Ids) {
+        const u32 N = static_cast<u32>(RenderableList.size());
+        std::vector<u8> Doomed(N, 0);
+        u32 First = N, Count = 0;
+        for (const u64 Id : _Ids) {
+            const int Index = IndexOfRenderable(Id);
+            if (Index < 0 || Doomed[Index]) continue;
+            Doomed[Index] = 1;
+            First = std::min(First, static_cast<u32>(Index));
+            ++Count;
+        }
+        if (Count == 0) return 0;
+
+        // Os filhos sobem para o ancestral sobrevivente mais proximo sem sair do lugar: o local
+        // novo vem do World, em dia antes de tudo (e com os pais ja saneados, sem ciclo).
+        UpdateWorldTransforms();
+        for (u32 i = 0; i < N; ++i) {
+            FRenderable& R = RenderableList[i];
+            if (Doomed[i] || R.Parent < 0 || !Doomed[R.Parent]) continue;
+            i32 Up = R.Parent;
+            while (Up >= 0 && Doomed[Up]) Up = RenderableList[Up].Parent;
+            R.Parent    = Up;
+            R.Transform = FTransform::FromMatrix(Up < 0 ? R.World : R.World * RenderableList[Up].World.Inverse());
+        }
+
+        // Compactacao ESTAVEL, nao swap-and-pop: as pastas do Scene Outliner sao ranges
+        // [begin,end) sobre esta lista, e trocar o removido com o ultimo jogaria uma mesh de outro
+        // asset para dentro de uma pasta alheia. Uma passada para o lote inteiro: apagar k objetos
+        // custa O(n), nao k memmoves da cauda. NewIndex remapeia os pais na mesma passada.
+        std::vector<i32> NewIndex(N, -1);
+        u32 Write = First;
+        for (u32 i = First; i < N; ++i) {
+            if (Doomed[i]) {
+                Handles_.Release(RenderableList[i].Id);
+                continue;
+            }
+            NewIndex[i] = static_cast<i32>(Write);
+            if (Write != i) RenderableList[Write] = std::move(RenderableList[i]);
+            ++Write;
+        }
+        RenderableList.resize(Write);
+        for (FRenderable& R : RenderableList)
+            if (R.Parent >= static_cast<i32>(First)) R.Parent = NewIndex[R.Parent];
+        ReanchorRenderables(First);
+
         ++StructureVersion_;
         // Objeto que nasce ou morre muda o CONTEUDO do mapa estatico, nao so o indice: o
         // shadow map cacheado precisa ser re-rasterizado. Ver StaticCastersVersion.
         ++StaticCastersVersion_;
-        ++TransformsVersion_; // a TLAS tem uma instancia a menos
-        return true;
+        ++TransformsVersion_; // a TLAS tem instancias a menos
+        return Count;
     }
 
     FRenderable* FScene::DuplicateRenderable(u64 _Id) {
@@ -199,17 +230,19 @@ namespace Smile {
         return &AddRenderable(Copy); // Id novo + as duas versoes, como qualquer criacao
     }
 
-    void FScene::RebuildRenderableIndex() {
-        RenderableIndexById_.clear();
-        RenderableIndexById_.reserve(RenderableList.size());
-        for (u32 i = 0; i < static_cast<u32>(RenderableList.size()); ++i)
-            RenderableIndexById_.emplace(RenderableList[i].Id, i);
+    void FScene::ReanchorRenderables(u32 _From) {
+        for (u32 i = _From; i < static_cast<u32>(RenderableList.size()); ++i)
+            Handles_.SetIndex(RenderableList[i].Id, i);
+    }
+
+    void FScene::ReanchorLights(u32 _From) {
+        for (u32 i = _From; i < static_cast<u32>(LightList.size()); ++i)
+            Handles_.SetIndex(LightList[i].Id, i);
     }
 
     int FScene::IndexOfRenderable(u64 _Id) const {
-        if (_Id == 0) return -1;
-        const auto It = RenderableIndexById_.find(_Id);
-        return It == RenderableIndexById_.end() ? -1 : static_cast<int>(It->second);
+        const FSceneObjectRef Ref = Handles_.Resolve(_Id);
+        return Ref.IsRenderable() ? static_cast<int>(Ref.Index) : -1;
     }
 
     FRenderable* FScene::FindRenderable(u64 _Id) {
@@ -227,35 +260,195 @@ namespace Smile {
     }
 
     FSceneObjectRef FScene::FindObject(u64 _Id) const {
-        if (_Id == 0) return {};
-        if (const auto It = RenderableIndexById_.find(_Id); It != RenderableIndexById_.end())
-            return { _Id, ESceneObject::Renderable, It->second };
-        // Luz por varredura linear, e nao por mapa: sao dezenas, contra milhares de renderaveis,
-        // e — o que decide — o editor muta LightList com push_back/erase diretos (LightsBridge),
-        // entao um mapa aqui ficaria podre sem que nada avisasse. A varredura nao tem estado para
-        // apodrecer. Nada no caminho de frame chama isto.
-        for (u32 i = 0; i < static_cast<u32>(LightList.size()); ++i)
-            if (LightList[i].Id == _Id) return { _Id, ESceneObject::Light, i };
-        return {};
+        const FSceneObjectRef Ref = Handles_.Resolve(_Id);
+        // A lista de luzes e mutavel por fora (Lights()); um indice que nao confere com a lista
+        // e luz apagada sem RemoveLight, e nao resolve — melhor que apontar para a vizinha.
+        if (Ref.IsLight() && (Ref.Index >= LightList.size() || LightList[Ref.Index].Id != _Id)) return {};
+        return Ref;
+    }
+
+    const FSceneBvh& FScene::Bvh() {
+        SyncBvh();
+        return Bvh_;
+    }
+
+    void FScene::SyncBvh() {
+        if (BvhBuildPending_) Bvh_.Build(Hot_.BoundsMin, Hot_.BoundsMax);
+        else if (BvhRefitAll_) Bvh_.Refit(Hot_.BoundsMin, Hot_.BoundsMax);
+        else if (!BvhMoved_.empty()) Bvh_.Refit(Hot_.BoundsMin, Hot_.BoundsMax, BvhMoved_);
+        BvhBuildPending_ = false;
+        BvhRefitAll_     = false;
+        BvhMoved_.clear();
+    }
+
+    FSceneObjectRef FScene::PickRenderable(const Vec3& _Origin, const Vec3& _Dir) {
+        // O cache pode estar atras da lista (add/remove sem sync): indice fora dela nao existe.
+        const FBvhRayHit Hit = Bvh().Raycast(_Origin, _Dir, 3.0e38f, [this](u32 _I) {
+            return _I < RenderableList.size() && Hot_.IsDrawCandidate(_I);
+        });
+        if (!Hit.Hit() || Hit.Index >= RenderableList.size()) return {};
+        return { RenderableList[Hit.Index].Id, ESceneObject::Renderable, Hit.Index };
+    }
+
+    bool FScene::UpdateWorldTransforms() {
+        const u32 Count = static_cast<u32>(RenderableList.size());
+        const bool Rebuild = HierarchyStructureVersion_ != StructureVersion_ || Hierarchy_.Size() != Count;
+        if (Rebuild) {
+            std::vector<i32> Parents(Count);
+            for (u32 i = 0; i < Count; ++i) Parents[i] = RenderableList[i].Parent;
+            Hierarchy_.Build(Parents);
+            // Pai invalido ou ciclo virou raiz na ordem; a lista fica com o mesmo pai que ela.
+            for (u32 i = 0; i < Count; ++i) RenderableList[i].Parent = Hierarchy_.ParentOf(i);
+            HierarchyStructureVersion_ = StructureVersion_;
+        }
+        const std::span<const u32> Changed = Hierarchy_.Update([this](u32 _I) {
+            return RenderableList[_I].Transform.Matrix();
+        });
+        for (const u32 i : Changed) {
+            FRenderable& R = RenderableList[i];
+            R.World = Hierarchy_.World(i);
+            BoundsFromWorld(R);
+            // Depois de um rebuild o cache SoA tambem vai refazer tudo (a estrutura mudou):
+            // marcar um por um so encheria a lista.
+            if (!Rebuild) MarkHotDirty(i);
+        }
+        return !Changed.empty();
+    }
+
+    void FScene::SetWorldTransform(u32 _Index, const FTransform& _World) {
+        if (_Index >= RenderableList.size()) return;
+        UpdateWorldTransforms(); // o World do pai tem de estar em dia
+        FRenderable& R = RenderableList[_Index];
+        R.Transform = R.Parent < 0
+            ? _World
+            : FTransform::FromMatrix(_World.Matrix() * RenderableList[R.Parent].World.Inverse());
+        MarkTransformDirty(_Index);
+    }
+
+    void FScene::MarkHotDirty(u32 _Index) {
+        // Indice que o cache ainda nao conhece: a lista cresceu desde o ultimo sync, e a mudanca
+        // de estrutura ja vai refazer tudo.
+        if (_Index >= HotDirtyBit_.size() || HotDirtyBit_[_Index]) return;
+        HotDirtyBit_[_Index] = 1;
+        HotDirty_.push_back(_Index);
+    }
+
+    bool FScene::SyncHotData() {
+        // Hierarquia primeiro: quem ela refaz entra marcado no cache SoA logo abaixo.
+        UpdateWorldTransforms();
+        const size_t Count = RenderableList.size();
+        const bool Structural = HotStructureVersion_ != StructureVersion_ || Hot_.Size() != Count;
+        if (!Structural && !HotAllDirty_ && HotDirty_.empty() && HotMoved_.empty() && !HotMovedAll_)
+            return false;
+
+        auto Refresh = [this](size_t _I) {
+            const FRenderable& R = RenderableList[_I];
+            Hot_.World[_I]     = R.World;
+            Hot_.BoundsMin[_I] = R.AABBMin;
+            Hot_.BoundsMax[_I] = R.AABBMax;
+            u8 Flags = 0;
+            if (R.Visible) Flags |= kHotVisible;
+            if (R.Mesh && !R.RaytracingOnly) Flags |= kHotDrawable;
+            if (R.Mobility == EMobility::Dynamic) Flags |= kHotDynamic;
+            Hot_.Flags[_I] = Flags;
+        };
+
+        if (Structural) {
+            // Os indices andaram: nao existe "antes" por objeto, e o PrevWorld nasce igual ao
+            // World (sem vetor de movimento) — o mesmo que o renderer fazia descartando o
+            // PreviousModels a cada mudanca de estrutura.
+            Hot_.Resize(Count);
+            for (size_t i = 0; i < Count; ++i) Refresh(i);
+            Hot_.PrevWorld = Hot_.World;
+            HotDirtyBit_.assign(Count, 0);
+            HotMoved_.clear();
+            HotMovedAll_         = false;
+            HotStructureVersion_ = StructureVersion_;
+            HotChanged_.clear();
+            HotChangedAll_ = true;
+            BvhBuildPending_ = true;
+            BvhRefitAll_     = false;
+            BvhMoved_.clear();
+        } else {
+            // Invariante: PrevWorld == World em todo objeto fora do HotMoved_. Quem se moveu no
+            // sync anterior assenta primeiro; quem for refeito agora guarda o World de antes.
+            HotChangedAll_ = HotMovedAll_ || HotAllDirty_;
+            HotChanged_.clear();
+            if (!HotChangedAll_) HotChanged_.assign(HotMoved_.begin(), HotMoved_.end());
+            if (HotMovedAll_) Hot_.PrevWorld = Hot_.World;
+            else
+                for (const u32 i : HotMoved_) Hot_.PrevWorld[i] = Hot_.World[i];
+            HotMoved_.clear();
+            HotMovedAll_ = false;
+
+            if (HotAllDirty_) {
+                for (size_t i = 0; i < Count; ++i) Refresh(i);
+                HotMovedAll_ = true;
+            } else {
+                for (const u32 i : HotDirty_) Refresh(i);
+                HotMoved_.swap(HotDirty_);
+                HotChanged_.insert(HotChanged_.end(), HotMoved_.begin(), HotMoved_.end());
+            }
+            for (const u32 i : HotMoved_) HotDirtyBit_[i] = 0;
+            if (HotMovedAll_) std::fill(HotDirtyBit_.begin(), HotDirtyBit_.end(), u8(0));
+            // Mesmos indices, caixas novas: o BVH deve o refit de quem foi refeito agora (o sync
+            // que so assenta o PrevWorld nao refez caixa nenhuma e nao deve nada). A lista cresce
+            // a cada frame de gizmo sem consulta; passando de um quarto da cena, o refit inteiro
+            // ja sai mais barato que subir tantas folhas.
+            if (!BvhBuildPending_ && !BvhRefitAll_) {
+                if (HotMovedAll_ || BvhMoved_.size() + HotMoved_.size() > Count / 4) {
+                    BvhRefitAll_ = true;
+                    BvhMoved_.clear();
+                } else {
+                    BvhMoved_.insert(BvhMoved_.end(), HotMoved_.begin(), HotMoved_.end());
+                }
+            }
+        }
+        HotDirty_.clear();
+        HotAllDirty_ = false;
+        ++HotVersion_;
+        return true;
     }
 
     FLight& FScene::AddLight(const FLight& _Light) {
         LightList.push_back(_Light);
-        LightList.back().Id = AllocObjectId(); // identidade nova mesmo se veio de uma copia // identidade nova mesmo se veio de uma copia
+        // Identidade nova mesmo se veio de uma copia.
+        LightList.back().Id = Handles_.Allocate(ESceneObject::Light, static_cast<u32>(LightList.size() - 1));
         return LightList.back();
     }
 
+    bool FScene::RemoveLight(u64 _Id) {
+        const FSceneObjectRef Ref = FindObject(_Id);
+        if (!Ref.IsLight()) return false;
+        Handles_.Release(_Id);
+        LightList.erase(LightList.begin() + Ref.Index);
+        ReanchorLights(Ref.Index);
+        return true;
+    }
+
+    u64 FScene::EnsureLightId(u32 _Index) {
+        if (_Index >= LightList.size()) return 0;
+        FLight& L = LightList[_Index];
+        if (L.Id == 0) L.Id = Handles_.Allocate(ESceneObject::Light, _Index);
+        return L.Id;
+    }
+
     void FScene::Clear() {
         RenderableList.clear();
-        RenderableIndexById_.clear();
         MeshLibrary.clear();
         LightList.clear();
+        Bvh_.Clear();
+        BvhBuildPending_ = false;
+        BvhRefitAll_     = false;
+        BvhMoved_.clear();
+        Hierarchy_.Clear();
         ++StructureVersion_;
         // Objeto que nasce ou morre muda o CONTEUDO do mapa estatico, nao so o indice: o
         // shadow map cacheado precisa ser re-rasterizado. Ver StaticCastersVersion.
         ++StaticCastersVersion_;
-        // NextObjectId_ NAO volta a zero: um Id nunca pode ser reusado dentro
-        // da sessao, senao uma referencia velha (selecao, undo futuro) passaria a apontar em
-        // silencio para um objeto diferente da cena nova em vez de simplesmente nao resolver.
+        // Os Id sao SOLTOS, nao zerados: a geracao de cada slot avanca, e um Id nunca e reusado
+        // dentro da sessao — senao uma referencia velha (selecao, undo futuro) passaria a apontar
+        // em silencio para um objeto diferente da cena nova em vez de simplesmente nao resolver.
+        Handles_.ReleaseAll();
     }
 }
@@ -0,0 +1,386 @@
+#include "Smile/Scene/SceneBvh.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+namespace Smile {
+    namespace {
+        constexpr f32 kInf  = 3.402823466e38f;
+        constexpr u32 kBins = 16;
+
+        struct FBox {
+            Vec3 Min{ kInf, kInf, kInf };
+            Vec3 Max{ -kInf, -kInf, -kInf };
+
+            // Cresce pelos DOIS cantos: caixa invertida continua dentro do no, e os testes de no
+            // seguem conservadores em relacao ao teste da folha.
+            void Grow(const Vec3& _A, const Vec3& _B) {
+                Min.X = std::min({ Min.X, _A.X, _B.X }); Max.X = std::max({ Max.X, _A.X, _B.X });
+                Min.Y = std::min({ Min.Y, _A.Y, _B.Y }); Max.Y = std::max({ Max.Y, _A.Y, _B.Y });
+                Min.Z = std::min({ Min.Z, _A.Z, _B.Z }); Max.Z = std::max({ Max.Z, _A.Z, _B.Z });
+            }
+            // Uniao de caixas ja crescidas (vazia = neutra).
+            void Grow(const FBox& _B) {
+                Min.X = std::min(Min.X, _B.Min.X); Max.X = std::max(Max.X, _B.Max.X);
+                Min.Y = std::min(Min.Y, _B.Min.Y); Max.Y = std::max(Max.Y, _B.Max.Y);
+                Min.Z = std::min(Min.Z, _B.Min.Z); Max.Z = std::max(Max.Z, _B.Max.Z);
+            }
+
+            f32 HalfArea() const {
+                const f32 X = std::max(Max.X - Min.X, 0.0f);
+                const f32 Y = std::max(Max.Y - Min.Y, 0.0f);
+                const f32 Z = std::max(Max.Z - Min.Z, 0.0f);
+                return X * Y + Y * Z + Z * X;
+            }
+        };
+
+        f32 Axis(const Vec3& _V, u32 _A) { return _A == 0 ? _V.X : (_A == 1 ? _V.Y : _V.Z); }
+
+        // Mesmas contas do AABBTouchesSphere, sem a raiz: o k-vizinhos ordena por isto.
+        f32 DistSq(const Vec3& _P, const Vec3& _Lo, const Vec3& _Hi) {
+            f32 D2 = 0.0f;
+            for (u32 a = 0; a < 3; ++a) {
+                const f32 C = Axis(_P, a), Lo = Axis(_Lo, a), Hi = Axis(_Hi, a);
+                if (C < Lo)      { const f32 d = Lo - C; D2 += d * d; }
+                else if (C > Hi) { const f32 d = C - Hi; D2 += d * d; }
+            }
+            return D2;
+        }
+
+        // Slab com eixo paralelo tratado a parte (0 * inf daria NaN). Devolve a entrada em
+        // [0, MaxT] ou -1 se nao acerta.
+        f32 RaySlab(const Vec3& _O, const Vec3& _D, const Vec3& _InvD, f32 _MaxT, const Vec3& _Lo, const Vec3& _Hi) {
+            f32 T0 = 0.0f, T1 = _MaxT;
+            for (u32 a = 0; a < 3; ++a) {
+                const f32 O = Axis(_O, a), Lo = Axis(_Lo, a), Hi = Axis(_Hi, a);
+                if (Axis(_D, a) == 0.0f) {
+                    if (O < Lo || O > Hi) return -1.0f;
+                    continue;
+                }
+                const f32 Inv = Axis(_InvD, a);
+                f32 Ta = (Lo - O) * Inv, Tb = (Hi - O) * Inv;
+                if (Ta > Tb) std::swap(Ta, Tb);
+                T0 = std::max(T0, Ta);
+                T1 = std::min(T1, Tb);
+                if (T0 > T1) return -1.0f;
+            }
+            return T0;
+        }
+
+        // Frustum contra no: fora, dentro (nenhum plano corta) ou cruzando. Os dois vertices de
+        // cada plano usam a conta do AABBOutsideFrustum, que e monotona nas coordenadas: no
+        // "dentro" garante que toda caixa dele passa no teste da folha.
+        enum class ENodeCull : u8 { Outside, Inside, Partial };
+
+        ENodeCull CullNode(const FCullFrustum& _V, const Vec3& _Lo, const Vec3& _Hi) {
+            const u32 Planes = std::min(_V.PlaneCount, kCullMaxPlanes);
+            bool Inside = true;
+            for (u32 p = 0; p < Planes; ++p) {
+                const Vec4& P = _V.Planes[p];
+                const f32 Px = (P.X >= 0.0f) ? _Hi.X : _Lo.X, Nx = (P.X >= 0.0f) ? _Lo.X : _Hi.X;
+                const f32 Py = (P.Y >= 0.0f) ? _Hi.Y : _Lo.Y, Ny = (P.Y >= 0.0f) ? _Lo.Y : _Hi.Y;
+                const f32 Pz = (P.Z >= 0.0f) ? _Hi.Z : _Lo.Z, Nz = (P.Z >= 0.0f) ? _Lo.Z : _Hi.Z;
+                if (P.X * Px + P.Y * Py + P.Z * Pz + P.W < 0.0f) return ENodeCull::Outside;
+                if (P.X * Nx + P.Y * Ny + P.Z * Nz + P.W < 0.0f) Inside = false;
+            }
+            return Inside ? ENodeCull::Inside : ENodeCull::Partial;
+        }
+    }
+
+    void FSceneBvh::Clear() {
+        Nodes.clear();
+        PrimIndices.clear();
+        Parent.clear();
+        LeafOf.clear();
+        PrimMin.clear();
+        PrimMax.clear();
+        RefitNodes = 0;
+    }
+
+    void FSceneBvh::Build(std::span<const Vec3> _Min, std::span<const Vec3> _Max) {
+        Clear();
+        const u32 N = static_cast<u32>(std::min(_Min.size(), _Max.size()));
+        if (N == 0) return;
+        PrimMin.assign(_Min.begin(), _Min.begin() + N);
+        PrimMax.assign(_Max.begin(), _Max.begin() + N);
+        PrimIndices.resize(N);
+        std::iota(PrimIndices.begin(), PrimIndices.end(), 0u);
+        LeafOf.resize(N);
+
+        std::vector<Vec3> Centroid(N);
+        for (u32 i = 0; i < N; ++i) Centroid[i] = (PrimMin[i] + PrimMax[i]) * 0.5f;
+
+        Nodes.reserve(2 * static_cast<size_t>(N));
+        Parent.reserve(2 * static_cast<size_t>(N));
+        Nodes.emplace_back();
+        Parent.push_back(0);
+
+        struct FTask { u32 Node, Begin, Count; };
+        std::vector<FTask> Stack{ { 0, 0, N } };
+        while (!Stack.empty()) {
+            const FTask T = Stack.back();
+            Stack.pop_back();
+
+            FBox Bounds, CBounds;
+            for (u32 k = T.Begin; k < T.Begin + T.Count; ++k) {
+                const u32 i = PrimIndices[k];
+                Bounds.Grow(PrimMin[i], PrimMax[i]);
+                CBounds.Grow(Centroid[i], Centroid[i]);
+            }
+            Nodes[T.Node].Min = Bounds.Min;
+            Nodes[T.Node].Max = Bounds.Max;
+
+            if (T.Count <= kMaxLeafSize) {
+                Nodes[T.Node].First = T.Begin;
+                Nodes[T.Node].Count = T.Count;
+                for (u32 k = T.Begin; k < T.Begin + T.Count; ++k) LeafOf[PrimIndices[k]] = T.Node;
+                continue;
+            }
+
+            // SAH em baldes sobre os centroides, nos tres eixos.
+            u32 BestAxis = 3, BestSplit = 0;
+            f32 BestCost = kInf;
+            for (u32 a = 0; a < 3; ++a) {
+                const f32 Lo = Axis(CBounds.Min, a), Extent = Axis(CBounds.Max, a) - Lo;
+                if (!(Extent > 0.0f)) continue;
+                const f32 Scale = kBins / Extent;
+                FBox BinBox[kBins];
+                u32  BinCount[kBins] = {};
+                for (u32 k = T.Begin; k < T.Begin + T.Count; ++k) {
+                    const u32 i = PrimIndices[k];
+                    const u32 b = std::min(kBins - 1, static_cast<u32>((Axis(Centroid[i], a) - Lo) * Scale));
+                    ++BinCount[b];
+                    BinBox[b].Grow(PrimMin[i], PrimMax[i]);
+                }
+                f32 RightArea[kBins];
+                u32 RightCount[kBins];
+                FBox Acc;
+                u32  Cnt = 0;
+                for (u32 b = kBins - 1; b > 0; --b) {
+                    Acc.Grow(BinBox[b]);
+                    Cnt += BinCount[b];
+                    RightArea[b]  = Acc.HalfArea();
+                    RightCount[b] = Cnt;
+                }
+                Acc = {};
+                Cnt = 0;
+                for (u32 b = 0; b + 1 < kBins; ++b) {
+                    Acc.Grow(BinBox[b]);
+                    Cnt += BinCount[b];
+                    if (Cnt == 0 || RightCount[b + 1] == 0) continue;
+                    const f32 Cost = Cnt * Acc.HalfArea() + RightCount[b + 1] * RightArea[b + 1];
+                    if (Cost < BestCost) { BestCost = Cost; BestAxis = a; BestSplit = b; }
+                }
+            }
+
+            u32* Begin = PrimIndices.data() + T.Begin;
+            u32* End   = Begin + T.Count;
+            u32* Mid   = Begin + T.Count / 2;
+            if (BestAxis < 3) {
+                const f32 Lo    = Axis(CBounds.Min, BestAxis);
+                const f32 Scale = kBins / (Axis(CBounds.Max, BestAxis) - Lo);
+                Mid = std::partition(Begin, End, [&](u32 _I) {
+                    return std::min(kBins - 1, static_cast<u32>((Axis(Centroid[_I], BestAxis) - Lo) * Scale)) <= BestSplit;
+                });
+            }
+            // Centroides todos iguais (ou o corte nao separou): metade pelo indice, para a folha
+            // continuar limitada.
+            if (Mid == Begin || Mid == End) Mid = Begin + T.Count / 2;
+            const u32 LeftCount = static_cast<u32>(Mid - Begin);
+
+            const u32 Left = static_cast<u32>(Nodes.size());
+            Nodes[T.Node].First = Left;
+            Nodes[T.Node].Count = 0;
+            Nodes.emplace_back();
+            Nodes.emplace_back();
+            Parent.push_back(T.Node);
+            Parent.push_back(T.Node);
+            Stack.push_back({ Left + 1, T.Begin + LeftCount, T.Count - LeftCount });
+            Stack.push_back({ Left, T.Begin, LeftCount });
+        }
+    }
+
+    void FSceneBvh::RefitNode(u32 _Node) {
+        FBox B;
+        const FBvhNode& N = Nodes[_Node];
+        if (N.IsLeaf()) {
+            for (u32 k = N.First; k < N.First + N.Count; ++k) B.Grow(PrimMin[PrimIndices[k]], PrimMax[PrimIndices[k]]);
+        } else {
+            B.Grow(Nodes[N.First].Min, Nodes[N.First].Max);
+            B.Grow(Nodes[N.First + 1].Min, Nodes[N.First + 1].Max);
+        }
+        Nodes[_Node].Min = B.Min;
+        Nodes[_Node].Max = B.Max;
+        ++RefitNodes;
+    }
+
+    void FSceneBvh::Refit(std::span<const Vec3> _Min, std::span<const Vec3> _Max) {
+        if (_Min.size() != PrimMin.size() || _Max.size() != PrimMax.size()) {
+            Build(_Min, _Max);
+            return;
+        }
+        if (Nodes.empty()) return;
+        std::copy(_Min.begin(), _Min.end(), PrimMin.begin());
+        std::copy(_Max.begin(), _Max.end(), PrimMax.begin());
+        // Filhos vem depois do pai: de tras para frente, cada no ve os filhos prontos.
+        for (size_t n = Nodes.size(); n-- > 0;) RefitNode(static_cast<u32>(n));
+    }
+
+    void FSceneBvh::Refit(std::span<const Vec3> _Min, std::span<const Vec3> _Max, std::span<const u32> _Moved) {
+        if (_Min.size() != PrimMin.size() || _Max.size() != PrimMax.size()) {
+            Build(_Min, _Max);
+            return;
+        }
+        if (Nodes.empty()) return;
+
+        auto SameBox = [](const FBvhNode& _A, const Vec3& _Min, const Vec3& _Max) {
+            return _A.Min.X == _Min.X && _A.Min.Y == _Min.Y && _A.Min.Z == _Min.Z &&
+                   _A.Max.X == _Max.X && _A.Max.Y == _Max.Y && _A.Max.Z == _Max.Z;
+        };
+        for (const u32 i : _Moved) {
+            if (i >= PrimMin.size()) continue;
+            PrimMin[i] = _Min[i];
+            PrimMax[i] = _Max[i];
+            // Sobe ate o primeiro no que nao mudou: dali para cima a uniao e a mesma.
+            for (u32 n = LeafOf[i];;) {
+                const Vec3 OldMin = Nodes[n].Min, OldMax = Nodes[n].Max;
+                RefitNode(n);
+                if (n == 0 || SameBox(Nodes[n], OldMin, OldMax)) break;
+                n = Parent[n];
+            }
+        }
+    }
+
+    void FSceneBvh::QueryFrustum(const FCullFrustum& _View, std::vector<u32>& _Out) const {
+        _Out.clear();
+        if (Nodes.empty()) return;
+        struct FItem { u32 Node; bool Inside; };
+        std::vector<FItem> Stack{ { 0, false } };
+        while (!Stack.empty()) {
+            const FItem It = Stack.back();
+            Stack.pop_back();
+            const FBvhNode& N = Nodes[It.Node];
+            bool Inside = It.Inside;
+            if (!Inside) {
+                const ENodeCull C = CullNode(_View, N.Min, N.Max);
+                if (C == ENodeCull::Outside) continue;
+                Inside = C == ENodeCull::Inside;
+            }
+            if (N.IsLeaf()) {
+                for (u32 k = N.First; k < N.First + N.Count; ++k) {
+                    const u32 i = PrimIndices[k];
+                    if (Inside || !AABBOutsideFrustum(_View, PrimMin[i], PrimMax[i])) _Out.push_back(i);
+                }
+                continue;
+            }
+            Stack.push_back({ N.First + 1, Inside });
+            Stack.push_back({ N.First, Inside });
+        }
+        std::sort(_Out.begin(), _Out.end());
+    }
+
+    void FSceneBvh::QuerySphere(const Vec3& _Center, f32 _Radius, std::vector<u32>& _Out) const {
+        _Out.clear();
+        if (Nodes.empty()) return;
+        std::vector<u32> Stack{ 0u };
+        while (!Stack.empty()) {
+            const FBvhNode& N = Nodes[Stack.back()];
+            Stack.pop_back();
+            if (!AABBTouchesSphere(N.Min, N.Max, _Center, _Radius)) continue;
+            if (N.IsLeaf()) {
+                for (u32 k = N.First; k < N.First + N.Count; ++k) {
+                    const u32 i = PrimIndices[k];
+                    if (AABBTouchesSphere(PrimMin[i], PrimMax[i], _Center, _Radius)) _Out.push_back(i);
+                }
+                continue;
+            }
+            Stack.push_back(N.First + 1);
+            Stack.push_back(N.First);
+        }
+        std::sort(_Out.begin(), _Out.end());
+    }
+
+    FBvhRayHit FSceneBvh::Raycast(const Vec3& _Origin, const Vec3& _Dir, f32 _MaxT, const FBvhFilter& _Filter) const {
+        FBvhRayHit Best;
+        if (Nodes.empty()) return Best;
+        Best.T = _MaxT;
+        const Vec3 InvD{ _Dir.X != 0.0f ? 1.0f / _Dir.X : 0.0f, _Dir.Y != 0.0f ? 1.0f / _Dir.Y : 0.0f,
+                         _Dir.Z != 0.0f ? 1.0f / _Dir.Z : 0.0f };
+
+        struct FItem { u32 Node; f32 T; };
+        const f32 RootT = RaySlab(_Origin, _Dir, InvD, _MaxT, Nodes[0].Min, Nodes[0].Max);
+        if (RootT < 0.0f) return {};
+        std::vector<FItem> Stack{ { 0, RootT } };
+        while (!Stack.empty()) {
+            const FItem It = Stack.back();
+            Stack.pop_back();
+            // Empate de T ainda pode trocar o vencedor (menor indice): so poda o estritamente maior.
+            if (It.T > Best.T) continue;
+            const FBvhNode& N = Nodes[It.Node];
+            if (N.IsLeaf()) {
+                for (u32 k = N.First; k < N.First + N.Count; ++k) {
+                    const u32 i = PrimIndices[k];
+                    const f32 T = RaySlab(_Origin, _Dir, InvD, Best.T, PrimMin[i], PrimMax[i]);
+                    if (T < 0.0f) continue;
+                    if (T < Best.T || (T == Best.T && i < Best.Index)) {
+                        if (_Filter && !_Filter(i)) continue;
+                        Best = { i, T };
+                    }
+                }
+                continue;
+            }
+            // O filho mais perto sai primeiro da pilha: a poda comeca cedo.
+            const f32 TL = RaySlab(_Origin, _Dir, InvD, Best.T, Nodes[N.First].Min, Nodes[N.First].Max);
+            const f32 TR = RaySlab(_Origin, _Dir, InvD, Best.T, Nodes[N.First + 1].Min, Nodes[N.First + 1].Max);
+            const FItem L{ N.First, TL }, R{ N.First + 1, TR };
+            const bool LeftFirst = TL >= 0.0f && (TR < 0.0f || TL <= TR);
+            const FItem& Near = LeftFirst ? L : R;
+            const FItem& Far  = LeftFirst ? R : L;
+            if (Far.T >= 0.0f) Stack.push_back(Far);
+            if (Near.T >= 0.0f) Stack.push_back(Near);
+        }
+        if (!Best.Hit()) Best.T = 0.0f;
+        return Best;
+    }
+
+    void FSceneBvh::KNearest(const Vec3& _Point, u32 _K, std::vector<u32>& _Out, const FBvhFilter& _Filter) const {
+        _Out.clear();
+        if (Nodes.empty() || _K == 0) return;
+
+        using FEntry = std::pair<f32, u32>; // (distancia^2, no ou indice)
+        // Nos do mais perto para o mais longe; resultado como max-heap dos K melhores.
+        std::priority_queue<FEntry, std::vector<FEntry>, std::greater<FEntry>> Open;
+        std::vector<FEntry> Best;
+        Best.reserve(_K + 1);
+        Open.push({ DistSq(_Point, Nodes[0].Min, Nodes[0].Max), 0 });
+        while (!Open.empty()) {
+            const FEntry Top = Open.top();
+            Open.pop();
+            // Cheio e o no mais perto ja passa do pior: nada do que falta entra. Empate continua
+            // (pode trazer indice menor).
+            if (Best.size() == _K && Top.first > Best.front().first) break;
+            const FBvhNode& N = Nodes[Top.second];
+            if (!N.IsLeaf()) {
+                Open.push({ DistSq(_Point, Nodes[N.First].Min, Nodes[N.First].Max), N.First });
+                Open.push({ DistSq(_Point, Nodes[N.First + 1].Min, Nodes[N.First + 1].Max), N.First + 1 });
+                continue;
+            }
+            for (u32 k = N.First; k < N.First + N.Count; ++k) {
+                const u32 i = PrimIndices[k];
+                const FEntry E{ DistSq(_Point, PrimMin[i], PrimMax[i]), i };
+                if (Best.size() == _K && !(E < Best.front())) continue;
+                if (_Filter && !_Filter(i)) continue;
+                Best.push_back(E);
+                std::push_heap(Best.begin(), Best.end());
+                if (Best.size() > _K) {
+                    std::pop_heap(Best.begin(), Best.end());
+                    Best.pop_back();
+                }
+            }
+        }
+        std::sort(Best.begin(), Best.end());
+        _Out.reserve(Best.size());
+        for (const FEntry& E : Best) _Out.push_back(E.second);
+    }
+}
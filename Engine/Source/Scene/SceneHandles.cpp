@@ -0,0 +1,40 @@
+#include "Smile/Scene/SceneHandles.h"
+
+namespace Smile {
+    u64 FSceneHandleTable::Allocate(ESceneObject _Kind, u32 _Index) {
+        u32 Slot = FreeHead_;
+        if (Slot != kNoSlot) {
+            FreeHead_ = Slots_[Slot].Index;
+        } else {
+            Slot = static_cast<u32>(Slots_.size());
+            Slots_.emplace_back();
+        }
+        FSlot& S = Slots_[Slot];
+        S.Kind  = _Kind;
+        S.Index = _Index;
+        ++Live_;
+        return (static_cast<u64>(S.Generation) << 32) | Slot;
+    }
+
+    bool FSceneHandleTable::Release(u64 _Id) {
+        if (!Resolve(_Id).IsValid()) return false;
+        Free(SlotOf(_Id));
+        return true;
+    }
+
+    void FSceneHandleTable::ReleaseAll() {
+        for (u32 Slot = 0; Slot < static_cast<u32>(Slots_.size()); ++Slot)
+            if (Slots_[Slot].Kind != ESceneObject::None) Free(Slot);
+    }
+
+    void FSceneHandleTable::Free(u32 _Slot) {
+        FSlot& S = Slots_[_Slot];
+        S.Kind = ESceneObject::None;
+        --Live_;
+        // Geracao que daria a volta para 0 aposenta o slot: fora da lista livre, o par
+        // (slot, geracao) nunca se repete.
+        if (++S.Generation == 0) return;
+        S.Index   = FreeHead_;
+        FreeHead_ = _Slot;
+    }
+}
@@ -0,0 +1,105 @@
+#include "Smile/Scene/SceneHierarchy.h"
+
+#include <algorithm>
+
+namespace Smile {
+    void FSceneHierarchy::Build(std::span<const i32> _Parents) {
+        const u32 N = static_cast<u32>(_Parents.size());
+        Parent_.resize(N);
+        for (u32 i = 0; i < N; ++i) {
+            const i32 P = _Parents[i];
+            Parent_[i] = (P >= 0 && static_cast<u32>(P) < N && static_cast<u32>(P) != i) ? P : kRoot;
+        }
+
+        // Filhos de cada no contiguos (contagem + prefixo), em ordem de indice: a ordem de largura
+        // sai deterministica, igual em toda execucao.
+        std::vector<u32> ChildStart(N + 1, 0), Children(N);
+        for (u32 i = 0; i < N; ++i)
+            if (Parent_[i] != kRoot) ++ChildStart[Parent_[i] + 1];
+        for (u32 i = 0; i < N; ++i) ChildStart[i + 1] += ChildStart[i];
+        {
+            std::vector<u32> Fill(ChildStart.begin(), ChildStart.end() - 1);
+            for (u32 i = 0; i < N; ++i)
+                if (Parent_[i] != kRoot) Children[Fill[Parent_[i]]++] = i;
+        }
+
+        Index_.clear();
+        Index_.reserve(N);
+        ParentPos_.clear();
+        ParentPos_.reserve(N);
+        Depth_.clear();
+        Depth_.reserve(N);
+        PosOf_.assign(N, kNone);
+        auto Push = [&](u32 _Index, i32 _ParentPos) {
+            PosOf_[_Index] = static_cast<u32>(Index_.size());
+            Index_.push_back(_Index);
+            ParentPos_.push_back(_ParentPos);
+            Depth_.push_back(_ParentPos == kRoot ? 0u : Depth_[_ParentPos] + 1u);
+        };
+        // Largura a partir de uma fila que ja e o proprio Index_: cada posicao visitada empurra os
+        // filhos no fim.
+        auto Expand = [&](u32 _From) {
+            for (u32 p = _From; p < Index_.size(); ++p) {
+                const u32 i = Index_[p];
+                for (u32 c = ChildStart[i]; c < ChildStart[i + 1]; ++c)
+                    if (PosOf_[Children[c]] == kNone) Push(Children[c], static_cast<i32>(p));
+            }
+        };
+        for (u32 i = 0; i < N; ++i)
+            if (Parent_[i] == kRoot) Push(i, kRoot);
+        Expand(0);
+        // Sobrou quem nao desce de raiz nenhuma: ciclo. O primeiro de cada um vira raiz.
+        for (u32 i = 0; i < N; ++i) {
+            if (PosOf_[i] != kNone) continue;
+            Parent_[i] = kRoot;
+            const u32 From = static_cast<u32>(Index_.size());
+            Push(i, kRoot);
+            Expand(From);
+        }
+
+        // Fim do bloco de filhos de cada posicao: filhos de p vem depois de todos os filhos das
+        // posicoes anteriores, entao basta o maior filho ja visto.
+        ChildEnd_.resize(N);
+        for (u32 p = 0; p < N; ++p) ChildEnd_[p] = p + 1;
+        for (u32 p = 0; p < N; ++p)
+            if (ParentPos_[p] != kRoot) ChildEnd_[ParentPos_[p]] = std::max(ChildEnd_[ParentPos_[p]], p + 1);
+
+        Local_.assign(N, Mat44::Identity());
+        World_.assign(N, Mat44::Identity());
+        Dirty_.assign(N, 0);
+        Changed_.clear();
+        FirstDirty_ = kNone;
+        EndDirty_   = 0;
+        MarkAllDirty();
+    }
+
+    void FSceneHierarchy::Clear() {
+        Index_.clear();
+        ParentPos_.clear();
+        ChildEnd_.clear();
+        Depth_.clear();
+        Local_.clear();
+        World_.clear();
+        Dirty_.clear();
+        PosOf_.clear();
+        Parent_.clear();
+        Changed_.clear();
+        FirstDirty_ = kNone;
+        EndDirty_   = 0;
+    }
+
+    void FSceneHierarchy::MarkDirty(u32 _Index) {
+        if (_Index >= PosOf_.size()) return;
+        const u32 P = PosOf_[_Index];
+        Dirty_[P]   = 1;
+        FirstDirty_ = std::min(FirstDirty_, P);
+        EndDirty_   = std::max(EndDirty_, P + 1);
+    }
+
+    void FSceneHierarchy::MarkAllDirty() {
+        if (Index_.empty()) return;
+        std::fill(Dirty_.begin(), Dirty_.end(), u8(1));
+        FirstDirty_ = 0;
+        EndDirty_   = Size();
+    }
+}
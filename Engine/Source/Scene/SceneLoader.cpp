@@ -1,12 +1,14 @@
 #include "Smile/Scene/SceneLoader.h"
 #include "Smile/Core/Logger.h"
+#include "Smile/Core/TaskPool.h"
+#include "Smile/Graphics/Resources/TextureResidency.h"
+#include "Smile/Scene/CookedCodec.h"
+#include "Smile/Scene/CookedGeometry.h"
 #include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <exception>
 #include <fstream>
-#include <limits>
-#include <thread>
 #include <unordered_map>
 
 namespace fs = std::filesystem;
@@ -19,26 +21,88 @@ namespace Smile {
             return std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
         }
 
-        bool ReadFile(const fs::path& Path, std::vector<u8>& Out) {
-            std::ifstream f(Path, std::ios::binary);
-            if (!f) return false;
-            f.seekg(0, std::ios::end);
-            std::streamoff sz = f.tellg();
-            f.seekg(0, std::ios::beg);
-            if (sz <= 0) return false;
-            Out.resize(static_cast<size_t>(sz));
-            f.read(reinterpret_cast<char*>(Out.data()), sz);
-            return static_cast<bool>(f);
+        // Custo das tarefas do load em "bytes de trabalho", comparavel entre texturas e meshes. So
+        // a ordem importa (o pool comeca pelas mais caras), entao os fatores sao ordem de
+        // grandeza: ler/copiar um byte vale 1, decodificar um byte de RGBA8 de PNG/JPG e gerar a
+        // mip chain vale ~8, expandir um byte de mesh codificado (v9) vale ~4.
+        constexpr u64 kImageDecodeFactor = 8;
+        constexpr u64 kMeshDecodeFactor  = 4;
+
+        u32 ReadBE16(const u8* _P) { return (u32(_P[0]) << 8) | _P[1]; }
+        u32 ReadBE32(const u8* _P) { return (ReadBE16(_P) << 16) | ReadBE16(_P + 2); }
+        u32 ReadLE16(const u8* _P) { return u32(_P[0]) | (u32(_P[1]) << 8); }
+        u32 ReadLE32(const u8* _P) { return ReadLE16(_P) | (ReadLE16(_P + 2) << 16); }
+
+        // Dimensoes pelo cabecalho, sem decodificar: PNG (IHDR), BMP, TGA e JPEG (primeiro SOFn).
+        bool ProbeImageSize(std::ifstream& _File, const std::string& _Extension, u32& _Width, u32& _Height) {
+            u8 H[32] = {};
+            if (!_File.read(reinterpret_cast<char*>(H), sizeof(H))) return false;
+            if (H[0] == 0x89 && H[1] == 'P' && H[2] == 'N' && H[3] == 'G') {
+                _Width = ReadBE32(H + 16); _Height = ReadBE32(H + 20);
+                return true;
+            }
+            if (H[0] == 'B' && H[1] == 'M') {
+                _Width = ReadLE32(H + 18);
+                const i32 Height = static_cast<i32>(ReadLE32(H + 22)); // negativo = de cima para baixo
+                _Height = static_cast<u32>(Height < 0 ? -Height : Height);
+                return true;
+            }
+            if (_Extension == ".tga") {
+                _Width = ReadLE16(H + 12); _Height = ReadLE16(H + 14);
+                return true;
+            }
+            if (H[0] == 0xFF && H[1] == 0xD8) {
+                // Segmentos ate o SOFn (C0..CF menos DHT C4, JPG C8 e DAC CC).
+                std::streamoff Pos = 2;
+                for (int Segment = 0; Segment < 64; ++Segment) {
+                    u8 M[9];
+                    _File.clear();
+                    _File.seekg(Pos);
+                    if (!_File.read(reinterpret_cast<char*>(M), sizeof(M)) || M[0] != 0xFF) return false;
+                    const u8 Marker = M[1];
+                    if (Marker >= 0xC0 && Marker <= 0xCF && Marker != 0xC4 && Marker != 0xC8 && Marker != 0xCC) {
+                        _Height = ReadBE16(M + 5); _Width = ReadBE16(M + 7);
+                        return true;
+                    }
+                    Pos += 2 + ReadBE16(M + 2);
+                }
+            }
+            return false;
+        }
+
+        // DDS: a mip chain ja vem pronta, o load e ler o arquivo. O resto decodifica a mip 0 e gera
+        // as mips (~4/3 da mip 0). Cabecalho ilegivel: supoe compressao 4:1 sobre o tamanho do
+        // arquivo.
+        u64 EstimateTextureCost(const fs::path& _Path, const std::string& _Extension, u32 _TailDimension,
+                                u32 _MaxTailMip) {
+            std::error_code Ec;
+            const u64 FileBytes = fs::file_size(_Path, Ec);
+            if (Ec) return 0;
+            // Com streaming a DDS le so a cauda: ~1 byte por texel (BC7) ate TailDimension, mas pelo
+            // menos a cadeia da MaxTailMip (1/4 por mip pulada).
+            if (_Extension == ".dds") {
+                if (!_TailDimension) return FileBytes;
+                const u64 Floor = _MaxTailMip < 32 ? FileBytes >> (2 * _MaxTailMip) : 0;
+                return std::max(std::min(FileBytes, u64(_TailDimension) * _TailDimension * 4 / 3), Floor);
+            }
+            std::ifstream File(_Path, std::ios::binary);
+            u32 W = 0, H = 0;
+            if (File && ProbeImageSize(File, _Extension, W, H) && W > 0 && H > 0)
+                return u64(W) * H * 4 * 4 / 3 * kImageDecodeFactor;
+            return FileBytes * 4 * kImageDecodeFactor;
         }
 
-        bool ArrayFits(size_t Offset, u64 Count, size_t Stride, size_t Total) {
-            if (Offset > Total || Count > std::numeric_limits<size_t>::max() / Stride) return false;
-            const size_t Bytes = static_cast<size_t>(Count) * Stride;
-            return Bytes <= Total - Offset;
+        // Validacao le os clusters e os indices dos LODs (paginas do arquivo mapeado; a cadeia
+        // inteira e da ordem do IB); o mesh codificado ainda expande RawBytes.
+        u64 EstimateMeshCost(const SMeshEntry& _Entry) {
+            u64 Cost = u64(_Entry.ClusterCount) * sizeof(SMeshCluster) + u64(_Entry.IndexCount) * sizeof(u32);
+            if (_Entry.Flags & kMeshEntryCoded) Cost += u64(_Entry.RawBytes) * kMeshDecodeFactor;
+            return Cost;
         }
     }
 
-    FSceneImportResultPtr LoadCookedSceneData(const std::wstring& _ScenePath) {
+    FSceneImportResultPtr LoadCookedSceneData(const std::wstring& _ScenePath,
+                                              const FSceneLoadOptions& _Options) {
         const Clock::time_point t0 = Clock::now();
         const fs::path Input(_ScenePath);
         const fs::path Base = Input.parent_path() / Input.stem();
@@ -46,105 +110,47 @@ namespace Smile {
         fs::path MeshPath  = Base; MeshPath  += L".smesh";
 
         try {
-            std::vector<u8> SceneBytes;
-            std::vector<u8> MeshBytes;
-            if (!ReadFile(ScenePath, SceneBytes)) {
+            const bool Mapped = _Options.Geometry == ECookedGeometrySource::Mapped;
+            // O .sscene e pequeno e suas tabelas sao copiadas no parse: lido e descartado aqui.
+            const std::unique_ptr<FMappedFile> SceneFile = FMappedFile::Read(ScenePath);
+            if (!SceneFile) {
                 LogError("LoadCookedScene: nao abriu " + ScenePath.string());
                 return {};
             }
-            if (!ReadFile(MeshPath, MeshBytes)) {
+            std::shared_ptr<const FMappedFile> MeshFile;
+            if (Mapped) MeshFile = FMappedFile::Map(MeshPath);
+            // Mapear pode falhar onde ler funciona (compartilhamento de rede, handle negado): o
+            // conteudo e o mesmo, so muda quem paga a memoria.
+            if (!MeshFile) MeshFile = FMappedFile::Read(MeshPath);
+            if (!MeshFile) {
                 LogError("LoadCookedScene: nao abriu " + MeshPath.string());
                 return {};
             }
-            if (SceneBytes.size() < sizeof(SSceneHeader) || MeshBytes.size() < sizeof(SMeshHeader)) {
-                LogError("LoadCookedScene: arquivos truncados");
-                return {};
-            }
 
             auto Imported = std::make_shared<FSceneImportResult>();
             Imported->BasePath  = Base;
             Imported->ScenePath = ScenePath;
             Imported->SceneDir  = Base.parent_path();
-            std::memcpy(&Imported->SceneHeader, SceneBytes.data(), sizeof(SSceneHeader));
-            std::memcpy(&Imported->MeshHeader, MeshBytes.data(), sizeof(SMeshHeader));
-            const SSceneHeader& SceneHeader = Imported->SceneHeader;
-            const SMeshHeader& MeshHeader = Imported->MeshHeader;
-            if (SceneHeader.Magic != kSSceneMagic || MeshHeader.Magic != kSMeshMagic) {
-                LogError("LoadCookedScene: magic invalido (o arquivo nao e um cozido da Smile)");
-                return {};
-            }
-            // O runtime nao sintetiza dados ausentes de versoes antigas; a cena deve ser recozida.
-            if (SceneHeader.Version != kCookedVersion || MeshHeader.Version != kCookedVersion) {
-                LogError("LoadCookedScene: cozido v" +
-                         std::to_string(MeshHeader.Version != kCookedVersion ? MeshHeader.Version
-                                                                             : SceneHeader.Version) +
-                         ", a engine exige v" + std::to_string(kCookedVersion) +
-                         ". Recozinhe a cena com o SmileCooker (a v8 adiciona o payload de RT por"
-                         " triangulo, que o runtime nao sintetiza).");
-                return {};
-            }
 
-            const size_t MaterialsOffset = sizeof(SSceneHeader);
-            if (!ArrayFits(MaterialsOffset, SceneHeader.MaterialCount,
-                           sizeof(SSceneMaterial), SceneBytes.size())) {
-                LogError("LoadCookedScene: tabela de materiais truncada");
-                return {};
-            }
-            const size_t RenderablesOffset = MaterialsOffset +
-                sizeof(SSceneMaterial) * SceneHeader.MaterialCount;
-            if (!ArrayFits(RenderablesOffset, SceneHeader.RenderableCount,
-                           sizeof(SSceneRenderable), SceneBytes.size())) {
-                LogError("LoadCookedScene: tabela de renderaveis truncada");
+            std::string Error;
+            FCookedSceneTable SceneTable;
+            if (!ParseCookedScene(SceneFile->Bytes(), SceneTable, Error)) {
+                LogError("LoadCookedScene: " + ScenePath.string() + ": " + Error);
                 return {};
             }
-            const size_t EntriesOffset = sizeof(SMeshHeader);
-            if (!ArrayFits(EntriesOffset, MeshHeader.MeshCount,
-                           sizeof(SMeshEntry), MeshBytes.size())) {
-                LogError("LoadCookedScene: tabela de meshes truncada");
+            // So cabecalho e tabela de entradas aqui; a validacao de cada entrada (e o decode dos
+            // blocos codificados, v9) vira tarefa do pool, junto com as texturas.
+            FCookedMeshTable MeshTable;
+            if (!ParseCookedMeshTable(MeshFile->Bytes(), MeshTable, Error)) {
+                LogError("LoadCookedScene: " + MeshPath.string() + ": " + Error);
                 return {};
             }
-            const size_t GeometryOffset = EntriesOffset + sizeof(SMeshEntry) * MeshHeader.MeshCount;
-            const size_t GeometryBytes = MeshBytes.size() - GeometryOffset;
-
-            Imported->Materials.resize(SceneHeader.MaterialCount);
-            if (SceneHeader.MaterialCount > 0) {
-                std::memcpy(Imported->Materials.data(), SceneBytes.data() + MaterialsOffset,
-                            sizeof(SSceneMaterial) * SceneHeader.MaterialCount);
-            }
-            Imported->Renderables.resize(SceneHeader.RenderableCount);
-            if (SceneHeader.RenderableCount > 0) {
-                std::memcpy(Imported->Renderables.data(), SceneBytes.data() + RenderablesOffset,
-                            sizeof(SSceneRenderable) * SceneHeader.RenderableCount);
-            }
-            Imported->MeshEntries.resize(MeshHeader.MeshCount);
-            if (MeshHeader.MeshCount > 0) {
-                std::memcpy(Imported->MeshEntries.data(), MeshBytes.data() + EntriesOffset,
-                            sizeof(SMeshEntry) * MeshHeader.MeshCount);
-            }
-
-            for (const SMeshEntry& Entry : Imported->MeshEntries) {
-                if (Entry.VertexOffset > std::numeric_limits<size_t>::max() ||
-                    Entry.IndexOffset > std::numeric_limits<size_t>::max() ||
-                    Entry.RTTriangleOffset > std::numeric_limits<size_t>::max() ||
-                    !ArrayFits(static_cast<size_t>(Entry.VertexOffset), Entry.VertexCount,
-                               sizeof(Vertex), GeometryBytes) ||
-                    !ArrayFits(static_cast<size_t>(Entry.IndexOffset), Entry.IndexCount,
-                               sizeof(u32), GeometryBytes) ||
-                    !ArrayFits(static_cast<size_t>(Entry.RTTriangleOffset), Entry.RTTriangleCount,
-                               sizeof(FRTTriangle), GeometryBytes)) {
-                    LogError("LoadCookedScene: blob de geometria truncado");
-                    return {};
-                }
-                // RTTriangle[i] corresponde ao PrimitiveIndex i do BLAS.
-                if (Entry.RTTriangleCount != Entry.IndexCount / 3u) {
-                    LogError("LoadCookedScene: payload de RT com " +
-                             std::to_string(Entry.RTTriangleCount) + " triangulos para " +
-                             std::to_string(Entry.IndexCount / 3u) +
-                             " do IB — cozido inconsistente, recozinhe a cena");
-                    return {};
-                }
-            }
+            Imported->SceneHeader  = SceneTable.Header;
+            Imported->Materials    = std::move(SceneTable.Materials);
+            Imported->Renderables  = std::move(SceneTable.Renderables);
+            Imported->MeshHeader   = MeshTable.Header;
             Imported->ReadMs = MsSince(t0);
+            if (MeshTable.CodedCount > 0) Imported->DecodedMeshes.resize(MeshTable.Entries.size());
 
             struct FTextureFlags { bool SRGB; bool IsNormal; };
             std::unordered_map<std::string, FTextureFlags> UniquePaths;
@@ -172,63 +178,100 @@ namespace Smile {
             }
             Imported->TextureData.resize(Imported->TexturePaths.size());
 
+            // Um lote so no pool de load: uma tarefa por mesh (validar a entrada e, se codificada,
+            // expandir o bloco) e uma por textura, cada uma com o custo estimado. O pool comeca
+            // pelas mais caras — um PNG 8K nao fica para o fim com as outras threads ociosas — e
+            // usa todos os cores menos o do Editor, sem o teto de 8 workers de antes.
             const Clock::time_point DecodeStart = Clock::now();
-            const unsigned HardwareThreads = std::max(1u, std::thread::hardware_concurrency());
-            // Reserva um core para o loader e outro para o event loop/render do Editor.
-            const unsigned WorkerBudget = HardwareThreads > 2 ? HardwareThreads - 2 : 1;
-            const unsigned WorkerCount = std::min<unsigned>(
-                std::min(WorkerBudget, 8u), static_cast<unsigned>(Imported->TexturePaths.size()));
-            auto DecodeWorker = [&](unsigned WorkerIndex) {
-                for (size_t I = WorkerIndex; I < Imported->TexturePaths.size(); I += WorkerCount) {
+            const u32 MeshCount = static_cast<u32>(MeshTable.Entries.size());
+            std::vector<std::string> MeshErrors(MeshCount);
+            // Com streaming, as DDS sobem so com a cauda e o FTextureStreamer pede o resto pela
+            // densidade de UV de cada mesh — calculada aqui, ja que a tarefa do mesh passa pelos
+            // indices de qualquer jeito.
+            const bool Streaming = _Options.StreamedTailDimension > 0;
+            Imported->MeshUvDensity.assign(MeshCount, 0.0f);
+            std::vector<FLoadTask> Tasks;
+            Tasks.reserve(MeshCount + Imported->TexturePaths.size());
+            for (u32 M = 0; M < MeshCount; ++M) {
+                const bool Coded = (MeshTable.Entries[M].Flags & kMeshEntryCoded) != 0;
+                Tasks.push_back({ ELoadTaskKind::Mesh, "mesh " + std::to_string(M) + (Coded ? " (codificado)" : ""),
+                                  EstimateMeshCost(MeshTable.Entries[M]), [&, M, Coded] {
+                    std::string& MeshError = MeshErrors[M];
+                    if (!ParseCookedMeshEntry(MeshTable, M, MeshError)) return;
+                    if (Coded) {
+                        const SMeshEntry& Entry = MeshTable.Entries[M];
+                        FMesh& Mesh = Imported->DecodedMeshes[M];
+                        bool Decoded = false;
+                        try {
+                            Decoded = DecodeMeshBlock(
+                                Entry, MeshTable.Geometry.subspan(Entry.CodedOffset, Entry.CodedBytes), Mesh, MeshError);
+                        } catch (const std::exception& Exception) {
+                            MeshError = Exception.what();
+                        }
+                        if (!Decoded) {
+                            MeshError = "mesh " + std::to_string(M) + ": " + MeshError;
+                            return;
+                        }
+                        MeshTable.Views[M] = FMeshView::Of(Mesh);
+                    }
+                    if (Streaming)
+                        Imported->MeshUvDensity[M] = MeshUvDensity(MeshTable.Views[M].Vertices, MeshTable.Views[M].Indices);
+                } });
+            }
+            for (size_t I = 0; I < Imported->TexturePaths.size(); ++I) {
+                const fs::path Relative(Imported->TexturePaths[I]);
+                const fs::path FullPath = Imported->SceneDir / Relative;
+                std::string Extension = Relative.extension().string();
+                for (char& C : Extension) if (C >= 'A' && C <= 'Z') C += 32;
+                Tasks.push_back({ ELoadTaskKind::Texture, Imported->TexturePaths[I],
+                                  EstimateTextureCost(FullPath, Extension, _Options.StreamedTailDimension,
+                                                      _Options.StreamedMaxTailMip),
+                                  [&, I, FullPath, Extension] {
                     try {
-                        const fs::path Relative(Imported->TexturePaths[I]);
-                        const std::wstring FullPath = (Imported->SceneDir / Relative).wstring();
-                        std::string Extension = Relative.extension().string();
-                        for (char& C : Extension) if (C >= 'A' && C <= 'Z') C += 32;
                         Imported->TextureData[I] = (Extension == ".dds")
-                            ? FTexture::LoadDDSCPU(FullPath, TextureFlags[I].SRGB)
+                            ? FTexture::LoadDDSCPU(FullPath.wstring(), TextureFlags[I].SRGB,
+                                                   _Options.StreamedTailDimension, _Options.StreamedMaxTailMip)
                             : FTexture::LoadCPU(
-                                FullPath, TextureFlags[I].IsNormal, TextureFlags[I].SRGB);
+                                FullPath.wstring(), TextureFlags[I].IsNormal, TextureFlags[I].SRGB);
                     } catch (const std::exception& Error) {
                         LogError("LoadCookedScene: falha ao preparar textura " +
                                  Imported->TexturePaths[I] + ": " + Error.what());
                     }
-                }
-            };
-            std::vector<std::jthread> Workers;
-            for (unsigned I = 0; I < WorkerCount; ++I) Workers.emplace_back(DecodeWorker, I);
-
-            const Clock::time_point MeshStart = Clock::now();
-            Imported->Meshes.resize(MeshHeader.MeshCount);
-            const u8* GeometryBase = MeshBytes.data() + GeometryOffset;
-            for (u32 I = 0; I < MeshHeader.MeshCount; ++I) {
-                const SMeshEntry& Entry = Imported->MeshEntries[I];
-                FMesh& Mesh = Imported->Meshes[I];
-                Mesh.Vertices.resize(Entry.VertexCount);
-                if (Entry.VertexCount > 0) {
-                    std::memcpy(Mesh.Vertices.data(), GeometryBase + Entry.VertexOffset,
-                                Entry.VertexCount * sizeof(Vertex));
-                }
-                Mesh.Indices.resize(Entry.IndexCount);
-                if (Entry.IndexCount > 0) {
-                    std::memcpy(Mesh.Indices.data(), GeometryBase + Entry.IndexOffset,
-                                Entry.IndexCount * sizeof(u32));
-                }
-                // A ordem cozida ja corresponde ao PrimitiveIndex do BLAS.
-                Mesh.RTTriangles.resize(Entry.RTTriangleCount);
-                if (Entry.RTTriangleCount > 0) {
-                    std::memcpy(Mesh.RTTriangles.data(), GeometryBase + Entry.RTTriangleOffset,
-                                Entry.RTTriangleCount * sizeof(FRTTriangle));
-                }
+                } });
             }
-            Imported->MeshMs = MsSince(MeshStart);
-
-            for (std::jthread& Worker : Workers) Worker.join();
+            FTaskPool& Pool = FTaskPool::Shared();
+            Imported->TaskTimings = Pool.Run(Tasks);
             Imported->DecodeMs = MsSince(DecodeStart);
+
+            // O primeiro mesh invalido em ordem de indice: a mesma mensagem do parse serial.
+            for (u32 M = 0; M < MeshCount; ++M)
+                if (!MeshErrors[M].empty()) {
+                    LogError("LoadCookedScene: " + MeshPath.string() + ": " + MeshErrors[M]);
+                    return {};
+                }
+            Imported->MeshEntries  = std::move(MeshTable.Entries);
+            Imported->Meshes       = std::move(MeshTable.Views);
+            Imported->MeshClusters = std::move(MeshTable.Clusters);
+            Imported->GeometryFile = std::move(MeshFile);
+
+            double TextureMs = 0.0;
+            size_t Longest = 0;
+            for (size_t T = 0; T < Imported->TaskTimings.size(); ++T) {
+                const FLoadTaskTiming& Timing = Imported->TaskTimings[T];
+                (Timing.Kind == ELoadTaskKind::Mesh ? Imported->MeshMs : TextureMs) += Timing.Ms;
+                if (Timing.Ms > Imported->TaskTimings[Longest].Ms) Longest = T;
+            }
             Imported->PrepareMs = MsSince(t0);
             LogDebug("Prepare scene CPU (ms): leitura=" + std::to_string((int)Imported->ReadMs) +
                      " decode=" + std::to_string((int)Imported->DecodeMs) +
-                     " meshes=" + std::to_string((int)Imported->MeshMs) +
+                     " (" + std::to_string(Imported->TaskTimings.size()) + " tarefas em " +
+                     std::to_string(Pool.ThreadCount()) + " threads; soma meshes=" +
+                     std::to_string((int)Imported->MeshMs) + " texturas=" + std::to_string((int)TextureMs) +
+                     (Imported->TaskTimings.empty() ? std::string()
+                                                    : "; maior " + Imported->TaskTimings[Longest].Name + " " +
+                                                          std::to_string((int)Imported->TaskTimings[Longest].Ms)) +
+                     ")" + (Imported->GeometryFile->IsMapped() ? " mapeado" : " lido") +
+                     (MeshTable.CodedCount ? ", " + std::to_string(MeshTable.CodedCount) + " codificados" : "") +
                      " | total=" + std::to_string((int)Imported->PrepareMs));
             return Imported;
         } catch (const std::exception& Error) {
@@ -0,0 +1,194 @@
+#include "Smile/Scene/SceneMap.h"
+#include "Smile/Scene/CookedGeometry.h" // CookedArrayFits
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Smile {
+    namespace {
+        template <typename T>
+        void AppendArray(std::vector<u8>& _Out, std::span<const T> _Items) {
+            const auto* Begin = reinterpret_cast<const u8*>(_Items.data());
+            _Out.insert(_Out.end(), Begin, Begin + _Items.size_bytes());
+        }
+
+        // Mesma regra do ViewOf do .smesh: cabe e esta alinhado ao tipo. As tabelas vem em
+        // sequencia depois de um header de 24 B e todos os registros sao multiplos de 4, entao o
+        // encoder nunca desalinha; um arquivo que desalinhe e corrompido.
+        template <typename T>
+        bool ViewOf(std::span<const u8> _Bytes, u64 _Offset, u64 _Count, std::span<const T>& _Out) {
+            if (!CookedArrayFits(_Offset, _Count, sizeof(T), _Bytes.size())) return false;
+            const u8* Start = _Bytes.data() + static_cast<size_t>(_Offset);
+            if (reinterpret_cast<std::uintptr_t>(Start) % alignof(T) != 0) return false;
+            _Out = { reinterpret_cast<const T*>(Start), static_cast<size_t>(_Count) };
+            return true;
+        }
+
+        void AppendFloat(std::string& _Out, f32 _V) {
+            if (!std::isfinite(_V)) _V = 0.0f; // JSON nao tem inf/NaN; transform assim ja e lixo
+            char Buffer[32];
+            const auto Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), _V);
+            _Out.append(Buffer, Result.ptr);
+        }
+
+        void AppendVec3(std::string& _Out, const char* _Key, const f32 (&_V)[3]) {
+            _Out += "\"";
+            _Out += _Key;
+            _Out += "\": [";
+            for (int I = 0; I < 3; ++I) {
+                if (I) _Out += ", ";
+                AppendFloat(_Out, _V[I]);
+            }
+            _Out += "]";
+        }
+
+        void AppendString(std::string& _Out, std::string_view _S) {
+            _Out += '"';
+            for (const char C : _S) {
+                switch (C) {
+                    case '"':  _Out += "\\\""; break;
+                    case '\\': _Out += "\\\\"; break;
+                    case '\n': _Out += "\\n"; break;
+                    case '\r': _Out += "\\r"; break;
+                    case '\t': _Out += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(C) < 0x20) {
+                            char Escaped[8];
+                            std::snprintf(Escaped, sizeof(Escaped), "\\u%04x", static_cast<unsigned>(C));
+                            _Out += Escaped;
+                        } else {
+                            _Out += C; // UTF-8 passa direto
+                        }
+                }
+            }
+            _Out += '"';
+        }
+    }
+
+    void FSceneMap::AddSpawn(SSceneMapSpawn _Spawn, std::string_view _Name) {
+        _Spawn.NameOffset = static_cast<u32>(Names.size());
+        _Spawn.NameLength = static_cast<u32>(_Name.size());
+        Names.append(_Name);
+        Spawned.push_back(_Spawn);
+    }
+
+    std::vector<u8> EncodeSceneMap(const FSceneMapView& _Map) {
+        const SSceneMapHeader Header{ kSMapMagic, kSMapVersion, static_cast<u32>(_Map.Overrides.size()),
+                                      static_cast<u32>(_Map.Spawned.size()), static_cast<u32>(_Map.Deleted.size()),
+                                      static_cast<u32>(_Map.Names.size()) };
+        std::vector<u8> Out;
+        Out.reserve(sizeof(Header) + _Map.Overrides.size_bytes() + _Map.Spawned.size_bytes() +
+                    _Map.Deleted.size_bytes() + _Map.Names.size());
+        AppendArray(Out, std::span<const SSceneMapHeader>(&Header, 1));
+        AppendArray(Out, _Map.Overrides);
+        AppendArray(Out, _Map.Spawned);
+        AppendArray(Out, _Map.Deleted);
+        Out.insert(Out.end(), _Map.Names.begin(), _Map.Names.end());
+        return Out;
+    }
+
+    bool IsBinarySceneMap(std::span<const u8> _Bytes) {
+        u32 Magic = 0;
+        if (_Bytes.size() < sizeof(Magic)) return false;
+        std::memcpy(&Magic, _Bytes.data(), sizeof(Magic));
+        return Magic == kSMapMagic;
+    }
+
+    bool ParseSceneMap(std::span<const u8> _Bytes, FSceneMapView& _Out, std::string& _Error) {
+        if (_Bytes.size() < sizeof(SSceneMapHeader)) {
+            _Error = "arquivo .smap truncado";
+            return false;
+        }
+        SSceneMapHeader Header;
+        std::memcpy(&Header, _Bytes.data(), sizeof(Header));
+        if (Header.Magic != kSMapMagic) {
+            _Error = "magic invalido (nao e um .smap binario)";
+            return false;
+        }
+        if (Header.Version != kSMapVersion) {
+            _Error = ".smap v" + std::to_string(Header.Version) + ", o editor le a v" +
+                     std::to_string(kSMapVersion) + " (binaria) e a v1 (JSON)";
+            return false;
+        }
+
+        u64 Offset = sizeof(Header);
+        if (!ViewOf(_Bytes, Offset, Header.OverrideCount, _Out.Overrides)) {
+            _Error = "tabela de overrides truncada";
+            return false;
+        }
+        Offset += u64(Header.OverrideCount) * sizeof(SSceneMapOverride);
+        if (!ViewOf(_Bytes, Offset, Header.SpawnCount, _Out.Spawned)) {
+            _Error = "tabela de criados truncada";
+            return false;
+        }
+        Offset += u64(Header.SpawnCount) * sizeof(SSceneMapSpawn);
+        if (!ViewOf(_Bytes, Offset, Header.DeletedCount, _Out.Deleted)) {
+            _Error = "tabela de apagados truncada";
+            return false;
+        }
+        Offset += u64(Header.DeletedCount) * sizeof(i32);
+        // Exatamente o que o header anuncia: byte sobrando e arquivo que nao foi este encoder
+        // quem escreveu.
+        if (Offset + Header.NameBytes != _Bytes.size()) {
+            _Error = "blob de nomes com tamanho diferente do header";
+            return false;
+        }
+        _Out.Names = { reinterpret_cast<const char*>(_Bytes.data() + Offset), Header.NameBytes };
+        for (const SSceneMapSpawn& Spawn : _Out.Spawned) {
+            if (u64(Spawn.NameOffset) + Spawn.NameLength > Header.NameBytes) {
+                _Error = "nome de objeto criado fora do blob";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string SceneMapToJson(const FSceneMapView& _Map) {
+        std::string Out;
+        // ~120 B por override com transform: reserva uma vez em vez de crescer em dobro ate 100+ MB.
+        Out.reserve(64 + _Map.Overrides.size() * 128 + _Map.Spawned.size() * 160 + _Map.Deleted.size() * 12 +
+                    _Map.Names.size());
+        Out += "{\n    \"version\": 1,\n    \"overrides\": [";
+        for (size_t I = 0; I < _Map.Overrides.size(); ++I) {
+            const SSceneMapOverride& O = _Map.Overrides[I];
+            Out += I ? ",\n        { " : "\n        { ";
+            Out += "\"cooked\": " + std::to_string(O.Cooked);
+            if (O.Flags & kSMapTransform) {
+                Out += ", ";
+                AppendVec3(Out, "pos", O.Position);
+                Out += ", ";
+                AppendVec3(Out, "rot", O.Rotation);
+                Out += ", ";
+                AppendVec3(Out, "scale", O.Scale);
+            }
+            if (O.Flags & kSMapHidden) Out += ", \"visible\": false";
+            if (O.Flags & kSMapDynamic) Out += ", \"dynamic\": true";
+            Out += " }";
+        }
+        Out += _Map.Overrides.empty() ? "],\n    \"spawned\": [" : "\n    ],\n    \"spawned\": [";
+        for (size_t I = 0; I < _Map.Spawned.size(); ++I) {
+            const SSceneMapSpawn& S = _Map.Spawned[I];
+            Out += I ? ",\n        { " : "\n        { ";
+            Out += "\"from\": " + std::to_string(S.From) + ", \"name\": ";
+            AppendString(Out, _Map.NameOf(S));
+            Out += ", ";
+            AppendVec3(Out, "pos", S.Position);
+            Out += ", ";
+            AppendVec3(Out, "rot", S.Rotation);
+            Out += ", ";
+            AppendVec3(Out, "scale", S.Scale);
+            if (S.Flags & kSMapHidden) Out += ", \"visible\": false";
+            if (S.Flags & kSMapDynamic) Out += ", \"dynamic\": true";
+            Out += " }";
+        }
+        Out += _Map.Spawned.empty() ? "],\n    \"deleted\": [" : "\n    ],\n    \"deleted\": [";
+        for (size_t I = 0; I < _Map.Deleted.size(); ++I) {
+            if (I) Out += ", ";
+            Out += std::to_string(_Map.Deleted[I]);
+        }
+        Out += "]\n}\n";
+        return Out;
+    }
+}
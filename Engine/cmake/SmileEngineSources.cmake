@@ -61,10 +61,16 @@ endfunction()
 
 smile_engine_group("Core"
     Include/Smile/Core/HResultCheck.h
+    Include/Smile/Core/JobSystem.h
     Include/Smile/Core/Logger.h
+    Include/Smile/Core/MappedFile.h
+    Include/Smile/Core/TaskPool.h
     Include/Smile/Core/Types.h
     Include/Smile/Core/VersionInfo.h.in
+    Source/Core/JobSystem.cpp
     Source/Core/Logger.cpp
+    Source/Core/MappedFile.cpp
+    Source/Core/TaskPool.cpp
 )
 
 smile_engine_group("Input"
@@ -82,16 +88,40 @@ smile_engine_group("Math"
 )
 
 smile_engine_group("Scene"
+    Include/Smile/Scene/CookedCodec.h
     Include/Smile/Scene/CookedFormat.h
+    Include/Smile/Scene/CookedGeometry.h
+    Include/Smile/Scene/FrustumCull.h
+    Include/Smile/Scene/GeometryStream.h
     Include/Smile/Scene/Light.h
+    Include/Smile/Scene/MeshClusters.h
+    Include/Smile/Scene/MeshLod.h
     Include/Smile/Scene/Scene.h
+    Include/Smile/Scene/SceneBvh.h
+    Include/Smile/Scene/SceneHierarchy.h
+    Include/Smile/Scene/SceneHandles.h
+    Include/Smile/Scene/SceneHotData.h
     Include/Smile/Scene/SceneLoader.h
+    Include/Smile/Scene/SceneMap.h
+    Include/Smile/Scene/Transform.h
+    Source/Scene/CookedCodec.cpp
+    Source/Scene/CookedGeometry.cpp
+    Source/Scene/FrustumCull.cpp
+    Source/Scene/GeometryStream.cpp
+    Source/Scene/MeshClusters.cpp
+    Source/Scene/MeshLod.cpp
     Source/Scene/Scene.cpp
+    Source/Scene/SceneBvh.cpp
+    Source/Scene/SceneHierarchy.cpp
+    Source/Scene/SceneHandles.cpp
     Source/Scene/SceneLoader.cpp
+    Source/Scene/SceneMap.cpp
 )
 
 smile_graphics_domain(Renderer
     DepthConfig
+    DrawBatch
+    DrawSort
     FrameContext
     HistoryDomain
     PassContext
@@ -107,6 +137,7 @@ smile_graphics_domain(Renderer
     RenderPass
     RenderSettings
     SceneTargets
+    TextureStreamer
 )
 
 smile_graphics_domain(Backend
@@ -134,7 +165,9 @@ smile_graphics_domain(Resources
     GpuMesh
     Material
     Mesh
+    MipChain
     Texture
+    TextureResidency
     VolumeTexture
 )
 
@@ -27,7 +27,7 @@
 #define INSTGEO_FLAG_ROUGHMAP  64u // tem mapa Roughness separado (RoughMapIndex valido; R=rough)
 #define INSTGEO_FLAG_TRANSLUCENT 128u // material Blend; usado pelo BvhDebug
 
-// Layout de 84 bytes espelhado por FRTInstanceGeo.
+// Layout de 88 bytes espelhado por FRTInstanceGeo.
 struct InstanceGeo {
     float4 BaseColor;
     uint   VertexSrv;
@@ -44,8 +44,16 @@ struct InstanceGeo {
     uint   MrMapIndex;
     uint   MetalMapIndex; // mapa Metalness separado (slot +6); valido sob INSTGEO_FLAG_METALMAP
     uint   RoughMapIndex; // mapa Roughness separado (slot +7); valido sob INSTGEO_FLAG_ROUGHMAP
+    uint   MapFirstMips;  // FirstMip de cada mapa, 4 bits por slot do material (ver RT_MapLOD)
 };
 
+// LOD de hit contado da mip 0 do ARQUIVO -> LOD no recurso. Com streaming a tabela estavel aponta
+// para a cauda, que comeca na FirstMip do mapa: sem o desconto o "LOD 2" cairia duas mips abaixo
+// da cauda. Cauda que comeca depois do LOD pedido le a mip de cima dela.
+float RT_MapLOD(InstanceGeo geo, uint slot, float lod) {
+    return max(lod - (float)((geo.MapFirstMips >> (4u * slot)) & 0xFu), 0.0f);
+}
+
 struct DDGIVertex {
     float3 Position;
     float3 Normal;
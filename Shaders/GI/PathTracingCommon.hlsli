@@ -190,7 +190,7 @@ FHitMaterial PT_LoadHitMaterial(InstanceGeo geo, float2 uv, float albedoLOD, flo
     float3 albedo = geo.BaseColor.rgb;
     if (geo.HasAlbedo != 0) {
         Texture2D<float4> albedoTex = ResourceDescriptorHeap[geo.AlbedoIndex];
-        albedo *= albedoTex.SampleLevel(LinearWrap, uv, albedoLOD).rgb;
+        albedo *= albedoTex.SampleLevel(LinearWrap, uv, RT_MapLOD(geo, 0u, albedoLOD)).rgb;
     }
 
     // Metallic/roughness seguem o mesmo workflow do G-buffer. O MR e amostrado uma vez para os
@@ -199,17 +199,17 @@ FHitMaterial PT_LoadHitMaterial(InstanceGeo geo, float2 uv, float albedoLOD, flo
     float roughness = geo.RoughnessFactor;
     if ((geo.Flags & INSTGEO_FLAG_MRMAP) != 0u) {
         Texture2D<float4> mrTex = ResourceDescriptorHeap[geo.MrMapIndex];
-        const float4 mr = mrTex.SampleLevel(LinearWrap, uv, albedoLOD);
+        const float4 mr = mrTex.SampleLevel(LinearWrap, uv, RT_MapLOD(geo, 2u, albedoLOD));
         metallic  *= ((geo.Flags & INSTGEO_FLAG_SPECPACK) != 0u) ? mr.b : mr.r;
         roughness *= mr.g;
     }
     if ((geo.Flags & INSTGEO_FLAG_METALMAP) != 0u) {
         Texture2D<float4> metalTex = ResourceDescriptorHeap[geo.MetalMapIndex];
-        metallic *= metalTex.SampleLevel(LinearWrap, uv, albedoLOD).r;
+        metallic *= metalTex.SampleLevel(LinearWrap, uv, RT_MapLOD(geo, 6u, albedoLOD)).r;
     }
     if ((geo.Flags & INSTGEO_FLAG_ROUGHMAP) != 0u) {
         Texture2D<float4> roughTex = ResourceDescriptorHeap[geo.RoughMapIndex];
-        roughness *= roughTex.SampleLevel(LinearWrap, uv, albedoLOD).r;
+        roughness *= roughTex.SampleLevel(LinearWrap, uv, RT_MapLOD(geo, 7u, albedoLOD)).r;
     }
     metallic = saturate(metallic);
     // Piso de roughness do SECUNDARIO (RTXDI `minSecondaryRoughness`, default 0.5 no sample
@@ -246,7 +246,7 @@ float3 PT_LoadHitEmissive(InstanceGeo geo, float2 uv, float albedoLOD) {
     float3 emissive = geo.EmissiveFactor.rgb;
     if ((geo.Flags & INSTGEO_FLAG_EMISSIVE) != 0u) {
         Texture2D<float4> emissiveTex = ResourceDescriptorHeap[geo.EmissiveMapIndex];
-        emissive *= emissiveTex.SampleLevel(LinearWrap, uv, albedoLOD).rgb;
+        emissive *= emissiveTex.SampleLevel(LinearWrap, uv, RT_MapLOD(geo, 4u, albedoLOD)).rgb;
     }
     return emissive;
 }
@@ -1,8 +1,15 @@
-cbuffer ObjectCB : register(b2) {
-    row_major float4x4 MVP;            
+struct ObjectConstants {
+    row_major float4x4 MVP;
     row_major float4x4 ModelMatrix;
-    row_major float4x4 CurMVPNoJitter; 
-    row_major float4x4 PrevMVP;       
+    row_major float4x4 CurMVPNoJitter;
+    row_major float4x4 PrevMVP;
+};
+
+// O root CBV aponta para o slot da PRIMEIRA instancia; as seguintes sao os slots consecutivos do
+// ObjectCB (256 B cada = um elemento daqui). Draw nao instanciado le so Objects[0]. 256 = 64 KiB,
+// o teto de um cbuffer (kMaxDrawInstances em DrawBatch.h).
+cbuffer ObjectCB : register(b2) {
+    ObjectConstants Objects[256];
 };
 
 struct VSInput {
@@ -20,7 +27,12 @@ struct VSOutput {
     float4 prevClip    : TEXCOORD4; 
 };
 
-VSOutput main(VSInput input) {
+VSOutput main(VSInput input, uint instance : SV_InstanceID) {
+    const float4x4 MVP            = Objects[instance].MVP;
+    const float4x4 ModelMatrix    = Objects[instance].ModelMatrix;
+    const float4x4 CurMVPNoJitter = Objects[instance].CurMVPNoJitter;
+    const float4x4 PrevMVP        = Objects[instance].PrevMVP;
+
     VSOutput o;
     o.pos         = mul(float4(input.pos, 1.0f), MVP);
     o.worldPos    = mul(float4(input.pos, 1.0f), ModelMatrix).xyz;
@@ -0,0 +1,329 @@
+// Compressao em blocos do cooker (Tools/Cooker/BlockCompress.h).
+//
+// O contrato: bloco solido e bloco de dois niveis saem exatos onde o formato consegue (BC4/BC5;
+// BC1 e BC7 ate o passo de quantizacao), BC1 fica sempre no modo de 4 cores (nada de preto
+// transparente num BaseColor opaco), e uma imagem suave passa de um piso de PSNR por formato —
+// o que pega endpoint trocado, indice fora de ordem ou bit empacotado no lugar errado. Tamanhos
+// que nao fecham 4x4 replicam a borda.
+//
+// Tiers e vias: os bytes nao mudam com via (escalar/SSE4.1/AVX2) nem com numero de threads, e o
+// PSNR nunca cai de Fast para Normal para Slow. `SmileBlockCompressTests --bench` mede MPix/s por
+// formato e tier numa textura 2048x2048 e estima o cook do Bistro.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BlockCompress.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::u8;
+    using Smile::u32;
+    using Smile::EMipPath;
+    using Smile::Cooker::EBlockFormat;
+    using Smile::Cooker::EBlockQuality;
+    using Smile::Cooker::FBlockEncodeOptions;
+
+    constexpr EMipPath      kPaths[]     = { EMipPath::Scalar, EMipPath::SSE41, EMipPath::AVX2 };
+    constexpr EBlockQuality kQualities[] = { EBlockQuality::Fast, EBlockQuality::Normal, EBlockQuality::Slow };
+
+    constexpr EBlockFormat kFormats[] = { EBlockFormat::BC1, EBlockFormat::BC3, EBlockFormat::BC4,
+                                          EBlockFormat::BC5, EBlockFormat::BC7 };
+
+    // Canais que o formato guarda: BC1 so RGB, BC4 so R, BC5 RG.
+    u32 ChannelMask(EBlockFormat _Format) {
+        switch (_Format) {
+            case EBlockFormat::BC1: return 0x7;
+            case EBlockFormat::BC4: return 0x1;
+            case EBlockFormat::BC5: return 0x3;
+            default:                return 0xF;
+        }
+    }
+
+    int MaxError(EBlockFormat _Format, const u8* _A, const u8* _B, size_t _Texels) {
+        int Worst = 0;
+        const u32 Mask = ChannelMask(_Format);
+        for (size_t i = 0; i < _Texels; ++i)
+            for (u32 c = 0; c < 4; ++c)
+                if (Mask & (1u << c)) Worst = std::max(Worst, std::abs(_A[i * 4 + c] - _B[i * 4 + c]));
+        return Worst;
+    }
+
+    double Psnr(EBlockFormat _Format, const std::vector<u8>& _A, const std::vector<u8>& _B) {
+        double Sum = 0.0;
+        size_t Count = 0;
+        const u32 Mask = ChannelMask(_Format);
+        for (size_t i = 0; i < _A.size(); ++i) {
+            if (!(Mask & (1u << (i % 4)))) continue;
+            const double D = double(_A[i]) - double(_B[i]);
+            Sum += D * D;
+            ++Count;
+        }
+        const double Mse = Sum / double(Count);
+        return Mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / Mse);
+    }
+
+    // Textura "de verdade" o bastante para separar os tiers: base suave, ruido de grao fino, bordas
+    // duras a cada 64 texels e alfa de cutout em parte dos ladrilhos.
+    std::vector<u8> Textured(u32 _W, u32 _H, std::mt19937& _Rng) {
+        std::vector<u8> Img(size_t(_W) * _H * 4);
+        for (u32 y = 0; y < _H; ++y)
+            for (u32 x = 0; x < _W; ++x) {
+                u8* P = &Img[(size_t(y) * _W + x) * 4];
+                const bool Edge = ((x / 64) + (y / 64)) % 2 == 0;
+                P[0] = u8(std::clamp(127.0 + 100.0 * std::sin(x * 0.05 + y * 0.03) + int(_Rng() % 21) - 10, 0.0, 255.0));
+                P[1] = u8((x * 255 / std::max(1u, _W - 1) + (_Rng() % 8)) & 255);
+                P[2] = Edge ? u8(40 + y % 32) : u8(200 - x % 48);
+                P[3] = ((x / 64 + y / 64) % 3) ? 255 : u8(x * 7);
+            }
+        return Img;
+    }
+
+    std::vector<u8> RoundTrip(EBlockFormat _Format, const std::vector<u8>& _Rgba, u32 _W, u32 _H,
+                              const FBlockEncodeOptions& _Options = {}) {
+        const std::vector<u8> Blocks = Smile::Cooker::CompressSurface(_Format, _Rgba.data(), _W, _H, _Options);
+        Check(Blocks.size() == size_t((_W + 3) / 4) * ((_H + 3) / 4) * Smile::Cooker::BlockBytes(_Format),
+              std::string("tamanho do blob ") + Smile::Cooker::BlockFormatName(_Format));
+        return Smile::Cooker::DecompressSurface(_Format, Blocks.data(), _W, _H);
+    }
+
+    void TestBlocosSimples() {
+        std::mt19937 Rng(2);
+        for (int Round = 0; Round < 200; ++Round) {
+            u8 Solid[64], TwoLevel[64];
+            u8 C[4], D[4];
+            for (u32 c = 0; c < 4; ++c) { C[c] = u8(Rng()); D[c] = u8(Rng()); }
+            for (u32 i = 0; i < 16; ++i)
+                for (u32 c = 0; c < 4; ++c) {
+                    Solid[i * 4 + c]    = C[c];
+                    TwoLevel[i * 4 + c] = (Rng() & 1) ? C[c] : D[c];
+                }
+            for (const EBlockFormat F : kFormats) {
+                u8 Enc[16], Dec[64];
+                Smile::Cooker::EncodeBlock(F, Solid, Enc);
+                Smile::Cooker::DecodeBlock(F, Enc, Dec);
+                // BC1: passo do 565 (8 niveis em R/B); BC7 modo 6: p-bit compartilhado por extremo.
+                const int Tol = F == EBlockFormat::BC1 ? 4 : F == EBlockFormat::BC7 ? 1 : 0;
+                const int Err = MaxError(F, Solid, Dec, 16);
+                Check(Err <= Tol || (F == EBlockFormat::BC3 && MaxError(EBlockFormat::BC1, Solid, Dec, 16) <= 4 &&
+                                     Solid[3] == Dec[3]),
+                      std::string("bloco solido em ") + Smile::Cooker::BlockFormatName(F) + " erro " + std::to_string(Err));
+            }
+            // BC4/BC5: dois niveis sao os dois extremos, exatos.
+            for (const EBlockFormat F : { EBlockFormat::BC4, EBlockFormat::BC5 }) {
+                u8 Enc[16], Dec[64];
+                Smile::Cooker::EncodeBlock(F, TwoLevel, Enc);
+                Smile::Cooker::DecodeBlock(F, Enc, Dec);
+                Check(MaxError(F, TwoLevel, Dec, 16) == 0, std::string("dois niveis em ") + Smile::Cooker::BlockFormatName(F));
+            }
+        }
+
+        // 0 e 255 no mesmo canal: o modo de 6 valores do BC4 guarda os dois exatos junto com o meio.
+        u8 Mixed[64] = {};
+        for (u32 i = 0; i < 16; ++i) Mixed[i * 4] = i < 4 ? 0 : i < 8 ? 255 : u8(100 + i);
+        u8 Enc[8], Dec[64];
+        Smile::Cooker::EncodeBlock(EBlockFormat::BC4, Mixed, Enc);
+        Smile::Cooker::DecodeBlock(EBlockFormat::BC4, Enc, Dec);
+        Check(Dec[0] == 0 && Dec[16] == 255 && MaxError(EBlockFormat::BC4, Mixed, Dec, 16) <= 2, "BC4 com 0 e 255");
+    }
+
+    // BC1 de um BaseColor opaco nunca pode cair no modo de 3 cores + transparente.
+    void TestBc1Opaco() {
+        std::mt19937 Rng(8);
+        bool Opaque = true;
+        for (int Round = 0; Round < 2000; ++Round) {
+            u8 Block[64], Enc[8], Dec[64];
+            for (u8& b : Block) b = u8(Rng() % 4 == 0 ? 0 : Rng());
+            Smile::Cooker::EncodeBlock(EBlockFormat::BC1, Block, Enc);
+            Smile::Cooker::DecodeBlock(EBlockFormat::BC1, Enc, Dec);
+            for (u32 i = 0; i < 16; ++i) Opaque = Opaque && Dec[i * 4 + 3] == 255;
+        }
+        Check(Opaque, "BC1: bloco caiu no modo com transparente");
+    }
+
+    // Imagem suave (gradientes + senoides) e um piso de PSNR por formato. Os pisos ficam uns 2 dB
+    // abaixo do medido: pegam regressao grosseira, nao variacao de arredondamento. Os canais variam
+    // em direcoes diferentes dentro do bloco (plano, nao reta), o pior caso de um extremo por par.
+    void TestQualidade() {
+        const u32 W = 61, H = 37;
+        std::vector<u8> Img(size_t(W) * H * 4);
+        for (u32 y = 0; y < H; ++y)
+            for (u32 x = 0; x < W; ++x) {
+                u8* P = &Img[(size_t(y) * W + x) * 4];
+                P[0] = u8(127.5 + 127.0 * std::sin(x * 0.11 + y * 0.05));
+                P[1] = u8(x * 255 / (W - 1));
+                P[2] = u8(127.5 + 127.0 * std::cos(y * 0.17));
+                P[3] = u8(y * 255 / (H - 1));
+            }
+        const double Floor[] = { 30.0, 31.0, 42.0, 44.0, 32.0 };
+        for (u32 f = 0; f < 5; ++f) {
+            const std::vector<u8> Out = RoundTrip(kFormats[f], Img, W, H);
+            const double P = Psnr(kFormats[f], Img, Out);
+            Check(P >= Floor[f], std::string("PSNR de ") + Smile::Cooker::BlockFormatName(kFormats[f]) + " = " +
+                                     std::to_string(P) + " dB");
+        }
+
+        // BaseColor opaco em BC7: o alfa continua 255 em todo texel (alfa 254 vira cutout/blend
+        // espurio em quem testa alfa < 1).
+        for (size_t i = 3; i < Img.size(); i += 4) Img[i] = 255;
+        const std::vector<u8> Out = RoundTrip(EBlockFormat::BC7, Img, W, H);
+        bool Opaque = true;
+        for (size_t i = 3; i < Out.size(); i += 4) Opaque = Opaque && Out[i] == 255;
+        Check(Opaque, "BC7 opaco perdeu alfa 255");
+    }
+
+    // Mips pequenas: 1x1 e 2x1 replicam o texel para fechar o bloco e voltam iguais (a menos da
+    // quantizacao).
+    void TestBordas() {
+        const u32 Sizes[][2] = { { 1, 1 }, { 2, 1 }, { 1, 3 }, { 5, 3 }, { 4, 4 } };
+        for (const auto& S : Sizes) {
+            std::vector<u8> Img(size_t(S[0]) * S[1] * 4, 0);
+            for (size_t i = 0; i < Img.size(); i += 4) { Img[i] = 200; Img[i + 1] = 40; Img[i + 2] = 90; Img[i + 3] = 255; }
+            for (const EBlockFormat F : kFormats) {
+                const std::vector<u8> Out = RoundTrip(F, Img, S[0], S[1]);
+                Check(Out.size() == Img.size() && MaxError(F, Img.data(), Out.data(), Img.size() / 4) <= 4,
+                      std::string("borda ") + std::to_string(S[0]) + "x" + std::to_string(S[1]) + " em " +
+                          Smile::Cooker::BlockFormatName(F));
+            }
+        }
+    }
+
+    // Mesmos bytes em toda via e todo numero de threads, em cada tier: e o que deixa o DDS cozido
+    // reproduzivel entre a maquina do artista e a do CI.
+    void TestDeterminismo() {
+        std::mt19937 Rng(4);
+        const u32 W = 97, H = 53;
+        const std::vector<u8> Img = Textured(W, H, Rng);
+        for (const EBlockQuality Q : kQualities)
+            for (const EBlockFormat F : kFormats) {
+                FBlockEncodeOptions Ref;
+                Ref.Quality = Q;
+                Ref.Path    = EMipPath::Scalar;
+                const std::vector<u8> Expected = Smile::Cooker::CompressSurface(F, Img.data(), W, H, Ref);
+                for (const EMipPath Path : kPaths)
+                    for (const u32 Threads : { 1u, 2u, 3u, 8u, 0u }) {
+                        FBlockEncodeOptions O = Ref;
+                        O.Path    = Path;
+                        O.Threads = Threads;
+                        Check(Smile::Cooker::CompressSurface(F, Img.data(), W, H, O) == Expected,
+                              std::string(Smile::Cooker::BlockFormatName(F)) + " " + Smile::Cooker::BlockQualityName(Q) +
+                                  " mudou com via " + Smile::MipPathName(Path) + " / " + std::to_string(Threads) + " threads");
+                    }
+            }
+    }
+
+    // Cada tier testa um superconjunto dos candidatos do anterior, bloco a bloco: o erro total nao
+    // pode subir de Fast para Normal para Slow.
+    void TestTiers() {
+        std::mt19937 Rng(6);
+        const u32 W = 128, H = 64;
+        const std::vector<u8> Img = Textured(W, H, Rng);
+        for (const EBlockFormat F : kFormats) {
+            double Prev = 0.0;
+            for (const EBlockQuality Q : kQualities) {
+                FBlockEncodeOptions O;
+                O.Quality = Q;
+                const std::vector<u8> Out = RoundTrip(F, Img, W, H, O);
+                const double P = Smile::Cooker::MeasureBlockQuality(F, Img.data(), Out.data(), W, H).Psnr();
+                Check(P >= Prev, std::string(Smile::Cooker::BlockFormatName(F)) + " " +
+                                     Smile::Cooker::BlockQualityName(Q) + " piorou: " + std::to_string(P) + " dB");
+                Prev = P;
+            }
+        }
+    }
+
+    // O relatorio: so os canais guardados entram, imagem igual da PSNR 99 e SSIM 1, e o Merge soma
+    // como se as duas superficies fossem uma.
+    void TestRelatorio() {
+        std::mt19937 Rng(12);
+        const u32 W = 20, H = 6;
+        const std::vector<u8> Img = Textured(W, H, Rng);
+        const auto Same = Smile::Cooker::MeasureBlockQuality(EBlockFormat::BC5, Img.data(), Img.data(), W, H);
+        Check(Same.Psnr() == 99.0 && std::fabs(Same.Ssim() - 1.0) < 1e-12, "imagem igual: PSNR 99 e SSIM 1");
+        Check(Same.Samples == size_t(W) * H * 2, "BC5 mede so R e G");
+        // Janela 8x6 (altura menor que 8) com passo 4 em X: 4 por canal.
+        Check(Same.SsimWindows == 4 * 2, "janelas do SSIM: " + std::to_string(Same.SsimWindows));
+
+        std::vector<u8> Off = Img;
+        for (size_t i = 0; i < Off.size(); i += 4) Off[i + 2] = u8(Off[i + 2] ^ 0x80); // B: BC5 nao ve
+        Off[0] = u8(Off[0] ^ 1);
+        const auto One = Smile::Cooker::MeasureBlockQuality(EBlockFormat::BC5, Img.data(), Off.data(), W, H);
+        Check(One.SquaredError == 1.0, "BC5 contou canal que nao guarda");
+        const auto Rgba = Smile::Cooker::MeasureBlockQuality(EBlockFormat::BC7, Img.data(), Off.data(), W, H);
+        Check(Rgba.Psnr() < One.Psnr() && Rgba.Ssim() < 1.0, "BC7 mede os quatro canais");
+
+        Smile::Cooker::FBlockQualityReport Sum = One;
+        Sum.Merge(Rgba);
+        Check(Sum.Samples == One.Samples + Rgba.Samples && Sum.SquaredError == One.SquaredError + Rgba.SquaredError &&
+                  Sum.SsimWindows == One.SsimWindows + Rgba.SsimWindows,
+              "Merge");
+    }
+
+    // MPix/s de mip 0 por formato e tier, numa thread (escalar e a melhor via) e em todos os cores,
+    // com PSNR/SSIM; no fim, o tempo estimado do set do Bistro (~400 texturas 2048^2 com mips,
+    // ~2,2 GPix) no tier de CI (Fast) e no default (Normal), todos os cores.
+    void Bench() {
+        using Clock = std::chrono::steady_clock;
+        const u32 Size = 2048;
+        std::mt19937 Rng(9);
+        const std::vector<u8> Img = Textured(Size, Size, Rng);
+        const double MPix = double(Size) * Size / 1e6, BistroMPix = 400.0 * 2048.0 * 2048.0 * 4.0 / 3.0 / 1e6;
+        std::cout << "  melhor via desta CPU: " << Smile::MipPathName(Smile::DetectMipPath()) << ", "
+                  << std::max(1u, std::thread::hardware_concurrency()) << " threads\n";
+        for (const EBlockFormat F : { EBlockFormat::BC7, EBlockFormat::BC5, EBlockFormat::BC1, EBlockFormat::BC4 })
+            for (const EBlockQuality Q : kQualities) {
+                double Rate[3] = {};
+                std::vector<u8> Blocks;
+                const FBlockEncodeOptions Runs[3] = { { Q, 1, EMipPath::Scalar }, { Q, 1, Smile::DetectMipPath() },
+                                                      { Q, 0, Smile::DetectMipPath() } };
+                for (int r = 0; r < 3; ++r) {
+                    const auto T0 = Clock::now();
+                    Blocks = Smile::Cooker::CompressSurface(F, Img.data(), Size, Size, Runs[r]);
+                    Rate[r] = MPix / std::chrono::duration<double>(Clock::now() - T0).count();
+                }
+                const std::vector<u8> Out = Smile::Cooker::DecompressSurface(F, Blocks.data(), Size, Size);
+                const auto Report = Smile::Cooker::MeasureBlockQuality(F, Img.data(), Out.data(), Size, Size);
+                std::cout << "  " << Smile::Cooker::BlockFormatName(F) << " " << Smile::Cooker::BlockQualityName(Q)
+                          << ": escalar " << Rate[0] << " | " << Smile::MipPathName(Smile::DetectMipPath()) << " "
+                          << Rate[1] << " | todos os cores " << Rate[2] << " MPix/s | PSNR " << Report.Psnr()
+                          << " dB, SSIM " << Report.Ssim();
+                if (F == EBlockFormat::BC7 && Q != EBlockQuality::Slow)
+                    std::cout << " | Bistro ~" << BistroMPix / Rate[2] << " s";
+                std::cout << '\n';
+            }
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.BlockCompress\n";
+    TestBlocosSimples();
+    TestBc1Opaco();
+    TestQualidade();
+    TestBordas();
+    TestDeterminismo();
+    TestTiers();
+    TestRelatorio();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,510 @@
+// Validacao do .smesh cozido, o contrato de zero-copia do load (FMappedFile + FMeshView), o
+// bloco codificado da v9 (CookedCodec.h), a regiao de clusters da v10 e a de LODs da v11.
+//
+// O SceneLoader deixou de copiar cada mesh para um FMesh: as views apontam para os bytes do
+// arquivo mapeado, e o AddMeshesBatch le delas direto para o staging. Isso desloca o risco — um
+// offset ruim no cozido agora vira leitura fora do mapeamento em vez de um vector curto —, entao
+// o que este teste fixa e que o parse rejeita todo arquivo em que uma view sairia do buffer ou
+// ficaria desalinhada, e que as views aceitas apontam de fato para DENTRO dele.
+//
+// CPU pura: arquivos sinteticos num diretorio temporario, sem device.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Core/MappedFile.h"
+#include "Smile/Scene/CookedCodec.h"
+#include "Smile/Scene/CookedGeometry.h"
+#include "Smile/Scene/MeshClusters.h"
+#include "Smile/Scene/MeshLod.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FSyntheticMesh {
+        std::vector<Smile::Vertex>      Vertices;
+        std::vector<Smile::u32>         Indices;
+        std::vector<Smile::FRTTriangle> RTTriangles;
+    };
+
+    FSyntheticMesh MakeQuad(float _Offset) {
+        FSyntheticMesh M;
+        for (int I = 0; I < 4; ++I) {
+            Smile::Vertex V{};
+            V.Position[0] = _Offset + float(I & 1);
+            V.Position[1] = float(I >> 1);
+            V.Normal[2]   = 1.0f;
+            M.Vertices.push_back(V);
+        }
+        M.Indices = { 0, 1, 2, 2, 1, 3 };
+        M.RTTriangles.resize(M.Indices.size() / 3);
+        for (size_t T = 0; T < M.RTTriangles.size(); ++T) M.RTTriangles[T].UV[0] = Smile::u32(T + 1);
+        return M;
+    }
+
+    // Mesmo layout que o cooker escreve: header, entradas e o blob [VB][IB][RT][clusters][LODs]
+    // por mesh, cada regiao alinhada ao proprio stride.
+    std::vector<Smile::u8> BuildSMesh(const std::vector<FSyntheticMesh>& _Meshes) {
+        using namespace Smile;
+        SMeshHeader Header{ kSMeshMagic, kCookedVersion, u32(_Meshes.size()), 0 };
+        std::vector<SMeshEntry> Entries(_Meshes.size());
+        std::vector<u8> Geometry;
+        auto Append = [&](const void* _Data, size_t _Bytes, size_t _Align) {
+            while (Geometry.size() % _Align) Geometry.push_back(0);
+            const u64 Offset = Geometry.size();
+            Geometry.insert(Geometry.end(), static_cast<const u8*>(_Data), static_cast<const u8*>(_Data) + _Bytes);
+            return Offset;
+        };
+        for (size_t I = 0; I < _Meshes.size(); ++I) {
+            const FSyntheticMesh& M = _Meshes[I];
+            SMeshEntry& E = Entries[I];
+            E.VertexCount = u32(M.Vertices.size());
+            E.IndexCount  = u32(M.Indices.size());
+            E.VertexOffset = Append(M.Vertices.data(), M.Vertices.size() * sizeof(Vertex), alignof(Vertex));
+            E.IndexOffset  = Append(M.Indices.data(), M.Indices.size() * sizeof(u32), alignof(u32));
+            E.RTTriangleOffset = Append(M.RTTriangles.data(), M.RTTriangles.size() * sizeof(FRTTriangle),
+                                        sizeof(FRTTriangle));
+            E.RTTriangleCount  = u32(M.RTTriangles.size());
+            std::vector<SMeshCluster> Clusters;
+            BuildMeshClusters(M.Vertices, M.Indices, Clusters);
+            E.ClusterOffset = Append(Clusters.data(), Clusters.size() * sizeof(SMeshCluster), alignof(SMeshCluster));
+            E.ClusterCount  = u32(Clusters.size());
+            std::vector<SMeshLod> Lods;
+            std::vector<u32>      LodIndices;
+            BuildMeshLods(M.Vertices, M.Indices, Lods, LodIndices);
+            E.LodOffset = Append(Lods.data(), Lods.size() * sizeof(SMeshLod), alignof(SMeshLod));
+            Append(LodIndices.data(), LodIndices.size() * sizeof(u32), alignof(u32));
+            E.LodCount = u32(Lods.size());
+        }
+        std::vector<u8> Out(sizeof(Header) + sizeof(SMeshEntry) * Entries.size());
+        std::memcpy(Out.data(), &Header, sizeof(Header));
+        if (!Entries.empty())
+            std::memcpy(Out.data() + sizeof(Header), Entries.data(), sizeof(SMeshEntry) * Entries.size());
+        Out.insert(Out.end(), Geometry.begin(), Geometry.end());
+        return Out;
+    }
+
+    Smile::SMeshEntry* EntryAt(std::vector<Smile::u8>& _File, size_t _Index) {
+        return reinterpret_cast<Smile::SMeshEntry*>(_File.data() + sizeof(Smile::SMeshHeader) +
+                                                    _Index * sizeof(Smile::SMeshEntry));
+    }
+
+    std::filesystem::path WriteTemp(const std::vector<Smile::u8>& _Bytes, const char* _Name) {
+        const std::filesystem::path Path = std::filesystem::temp_directory_path() / _Name;
+        std::ofstream Out(Path, std::ios::binary | std::ios::trunc);
+        Out.write(reinterpret_cast<const char*>(_Bytes.data()), std::streamsize(_Bytes.size()));
+        return Path;
+    }
+
+    bool Parses(const std::vector<Smile::u8>& _Bytes) {
+        Smile::FCookedMeshTable Table;
+        std::string Error;
+        const bool Ok = Smile::ParseCookedMeshes(_Bytes, Table, Error);
+        Check(Ok == Error.empty(), "ParseCookedMeshes: retorno e mensagem de erro discordam");
+        return Ok;
+    }
+
+    // Caminho feliz nas duas origens: views dentro do buffer do FMappedFile, conteudo identico ao
+    // que foi escrito, e NENHUMA copia (o ponteiro da view cai dentro de Bytes()).
+    void TestViewsApontamParaOArquivo() {
+        const std::vector<FSyntheticMesh> Meshes = { MakeQuad(0.0f), MakeQuad(10.0f) };
+        const std::vector<Smile::u8> File = BuildSMesh(Meshes);
+        const std::filesystem::path Path = WriteTemp(File, "smile_cooked_geometry_ok.smesh");
+
+        for (const bool UseMap : { true, false }) {
+            const std::string Where = UseMap ? "mapeado" : "lido";
+            const auto Source = UseMap ? Smile::FMappedFile::Map(Path) : Smile::FMappedFile::Read(Path);
+            Check(Source != nullptr, Where + ": arquivo nao abriu");
+            if (!Source) continue;
+            Check(Source->IsMapped() == UseMap, Where + ": IsMapped nao reflete a origem");
+            Check(Source->Bytes().size() == File.size(), Where + ": tamanho diferente do escrito");
+
+            Smile::FCookedMeshTable Table;
+            std::string Error;
+            Check(Smile::ParseCookedMeshes(Source->Bytes(), Table, Error), Where + ": parse falhou: " + Error);
+            Check(Table.Views.size() == Meshes.size(), Where + ": numero de views errado");
+
+            const Smile::u8* Begin = Source->Bytes().data();
+            const Smile::u8* End   = Begin + Source->Bytes().size();
+            for (size_t I = 0; I < Table.Views.size() && I < Meshes.size(); ++I) {
+                const Smile::FMeshView& View = Table.Views[I];
+                const auto* VB = reinterpret_cast<const Smile::u8*>(View.Vertices.data());
+                const auto* RT = reinterpret_cast<const Smile::u8*>(View.RTTriangles.data());
+                Check(VB >= Begin && VB + View.Vertices.size_bytes() <= End, Where + ": VB fora do arquivo");
+                Check(RT >= Begin && RT + View.RTTriangles.size_bytes() <= End, Where + ": RT fora do arquivo");
+                Check(View.Vertices.size() == Meshes[I].Vertices.size() &&
+                      std::memcmp(View.Vertices.data(), Meshes[I].Vertices.data(),
+                                  View.Vertices.size_bytes()) == 0,
+                      Where + ": VB difere do escrito");
+                Check(View.Indices.size() == Meshes[I].Indices.size() &&
+                      std::memcmp(View.Indices.data(), Meshes[I].Indices.data(), View.Indices.size_bytes()) == 0,
+                      Where + ": IB difere do escrito");
+                Check(View.RTTriangles.size() == Meshes[I].RTTriangles.size() &&
+                      View.RTTriangles[1].UV[0] == 2u,
+                      Where + ": payload de RT difere do escrito");
+            }
+        }
+        std::filesystem::remove(Path);
+    }
+
+    void TestRejeitaCabecalhoInvalido() {
+        std::vector<Smile::u8> File = BuildSMesh({ MakeQuad(0.0f) });
+        Check(!Parses({ File.begin(), File.begin() + 8 }), "header truncado aceito");
+
+        std::vector<Smile::u8> BadMagic = File;
+        BadMagic[0] ^= 0xFF;
+        Check(!Parses(BadMagic), "magic invalido aceito");
+
+        std::vector<Smile::u8> OldVersion = File;
+        const Smile::u32 Previous = Smile::kCookedVersion - 1;
+        std::memcpy(OldVersion.data() + 4, &Previous, sizeof(Previous));
+        Check(!Parses(OldVersion), "versao anterior aceita (o runtime nao sintetiza dados antigos)");
+    }
+
+    // Cada forma de uma view sair do buffer: a tabela, uma regiao do blob, e um offset perto do
+    // limite de u64 que so nao estoura se a conta for feita com cuidado.
+    void TestRejeitaRegiaoForaDoArquivo() {
+        const std::vector<Smile::u8> File = BuildSMesh({ MakeQuad(0.0f), MakeQuad(1.0f) });
+        Check(Parses(File), "arquivo de referencia rejeitado");
+
+        Check(!Parses({ File.begin(), File.begin() + sizeof(Smile::SMeshHeader) + 10 }),
+              "tabela de meshes truncada aceita");
+        Check(!Parses({ File.begin(), File.end() - 4 }), "blob truncado aceito");
+
+        std::vector<Smile::u8> Far = File;
+        EntryAt(Far, 1)->VertexOffset = ~Smile::u64(0) - 16;
+        Check(!Parses(Far), "offset perto de 2^64 aceito");
+
+        std::vector<Smile::u8> Huge = File;
+        EntryAt(Huge, 0)->IndexCount = 0xFFFFFFF0u;
+        EntryAt(Huge, 0)->RTTriangleCount = 0xFFFFFFF0u / 3u;
+        Check(!Parses(Huge), "contagem maior que o arquivo aceita");
+    }
+
+    // Uma view de Vertex/u32/FRTTriangle em endereco desalinhado e UB, nao so lenta.
+    void TestRejeitaOffsetDesalinhado() {
+        std::vector<Smile::u8> File = BuildSMesh({ MakeQuad(0.0f) });
+        EntryAt(File, 0)->IndexOffset += 2;
+        EntryAt(File, 0)->IndexCount  -= 3;
+        EntryAt(File, 0)->RTTriangleCount -= 1;
+        Check(!Parses(File), "IB desalinhado aceito");
+    }
+
+    void TestRejeitaPayloadDeRTInconsistente() {
+        std::vector<Smile::u8> File = BuildSMesh({ MakeQuad(0.0f) });
+        EntryAt(File, 0)->RTTriangleCount = 1;
+        Check(!Parses(File), "RTTriangleCount != IndexCount/3 aceito");
+    }
+
+    // Quem desenha uma faixa de cluster confia nela: faixa com buraco, sobreposta ou alem do IB e
+    // cozido corrompido. Zero clusters continua valido (granularidade de mesh).
+    void TestRejeitaClustersInconsistentes() {
+        FSyntheticMesh Strip;
+        for (Smile::u32 I = 0; I < 402; ++I) {
+            Smile::Vertex V{};
+            V.Position[0] = float(I / 2);
+            V.Position[1] = float(I % 2);
+            Strip.Vertices.push_back(V);
+        }
+        for (Smile::u32 I = 0; I + 3 < 402; I += 2)
+            Strip.Indices.insert(Strip.Indices.end(), { I, I + 2, I + 1, I + 1, I + 2, I + 3 });
+        Strip.RTTriangles.resize(Strip.Indices.size() / 3);
+        const std::vector<Smile::u8> File = BuildSMesh({ Strip });
+
+        Smile::FCookedMeshTable Table;
+        std::string Error;
+        Check(Smile::ParseCookedMeshes(File, Table, Error), "arquivo com clusters rejeitado: " + Error);
+        Check(Table.Clusters.size() == 1 && Table.Clusters[0].size() == 4, "400 triangulos deveriam dar 4 clusters");
+
+        std::vector<Smile::u8> Gap = File;
+        const size_t GeometryStart = sizeof(Smile::SMeshHeader) + sizeof(Smile::SMeshEntry);
+        auto* First =
+            reinterpret_cast<Smile::SMeshCluster*>(Gap.data() + GeometryStart + EntryAt(Gap, 0)->ClusterOffset);
+        First[1].FirstTriangle += 1;
+        Check(!Parses(Gap), "faixa de cluster com buraco aceita");
+
+        std::vector<Smile::u8> Short = File;
+        EntryAt(Short, 0)->ClusterCount -= 1;
+        Check(!Parses(Short), "clusters cobrindo so parte do IB aceitos");
+
+        std::vector<Smile::u8> Outside = File;
+        EntryAt(Outside, 0)->ClusterCount += 1;
+        Check(!Parses(Outside), "clusters alem do fim do arquivo aceitos");
+
+        std::vector<Smile::u8> None = File;
+        EntryAt(None, 0)->ClusterCount = 0;
+        Check(Parses(None), "mesh sem clusters rejeitado");
+    }
+
+    // A escolha de LOD confia na ordem da cadeia e o draw, nas faixas: nivel fora de ordem, que
+    // nao reduz, com erro caindo ou indice fora do VB e cozido corrompido. Sem LODs e valido.
+    void TestRejeitaLodsInconsistentes() {
+        FSyntheticMesh Grid;
+        constexpr Smile::u32 N = 16;
+        for (Smile::u32 I = 0; I < (N + 1) * (N + 1); ++I) {
+            Smile::Vertex V{};
+            V.Position[0] = float(I % (N + 1));
+            V.Position[2] = float(I / (N + 1));
+            V.Normal[1]   = 1.0f;
+            Grid.Vertices.push_back(V);
+        }
+        for (Smile::u32 Y = 0; Y < N; ++Y)
+            for (Smile::u32 X = 0; X < N; ++X) {
+                const Smile::u32 A = Y * (N + 1) + X, B = A + 1, C = A + N + 1, D = C + 1;
+                Grid.Indices.insert(Grid.Indices.end(), { A, C, B, B, C, D });
+            }
+        Grid.RTTriangles.resize(Grid.Indices.size() / 3);
+        const std::vector<Smile::u8> File = BuildSMesh({ Grid });
+
+        Smile::FCookedMeshTable Table;
+        std::string Error;
+        Check(Smile::ParseCookedMeshes(File, Table, Error), "arquivo com LODs rejeitado: " + Error);
+        Check(Table.Lods.size() == 1 && Table.Lods[0].Levels.size() >= 2, "grade 16x16 deveria ter 2+ LODs");
+        if (Table.Lods.empty() || Table.Lods[0].Levels.size() < 2) return;
+        const Smile::u8* Begin = File.data();
+        const auto* Indices = reinterpret_cast<const Smile::u8*>(Table.Lods[0].Indices.data());
+        Check(Indices > Begin && Indices + Table.Lods[0].Indices.size_bytes() <= Begin + File.size(),
+              "indices dos LODs fora do arquivo");
+
+        const size_t GeometryStart = sizeof(Smile::SMeshHeader) + sizeof(Smile::SMeshEntry);
+        auto LevelsOf = [&](std::vector<Smile::u8>& _File) {
+            return reinterpret_cast<Smile::SMeshLod*>(_File.data() + GeometryStart + EntryAt(_File, 0)->LodOffset);
+        };
+        std::vector<Smile::u8> Gap = File;
+        LevelsOf(Gap)[1].FirstIndex += 3;
+        Check(!Parses(Gap), "faixa de LOD com buraco aceita");
+
+        std::vector<Smile::u8> Grows = File;
+        LevelsOf(Grows)[0].IndexCount = EntryAt(Grows, 0)->IndexCount;
+        Check(!Parses(Grows), "LOD sem reducao aceito");
+
+        std::vector<Smile::u8> Falling = File;
+        LevelsOf(Falling)[1].Error = LevelsOf(Falling)[0].Error - 1.0f;
+        Check(!Parses(Falling), "erro decrescente aceito");
+
+        std::vector<Smile::u8> BadIndex = File;
+        reinterpret_cast<Smile::u32*>(LevelsOf(BadIndex) + EntryAt(BadIndex, 0)->LodCount)[4] =
+            EntryAt(BadIndex, 0)->VertexCount;
+        Check(!Parses(BadIndex), "indice de LOD fora do VB aceito");
+
+        std::vector<Smile::u8> Outside = File;
+        EntryAt(Outside, 0)->LodOffset = File.size();
+        Check(!Parses(Outside), "LODs alem do fim do arquivo aceitos");
+
+        std::vector<Smile::u8> None = File;
+        EntryAt(None, 0)->LodCount = 0;
+        Check(Parses(None), "mesh sem LODs rejeitado");
+    }
+
+    void TestArquivoAusente() {
+        const std::filesystem::path Missing =
+            std::filesystem::temp_directory_path() / "smile_cooked_geometry_nao_existe.smesh";
+        Check(Smile::FMappedFile::Map(Missing) == nullptr, "Map de arquivo ausente nao devolveu nullptr");
+        Check(Smile::FMappedFile::Read(Missing) == nullptr, "Read de arquivo ausente nao devolveu nullptr");
+    }
+
+    // --- Bloco codificado (v9) ---
+
+    void TestLzIdaEVolta() {
+        std::vector<std::vector<Smile::u8>> Inputs;
+        Inputs.push_back({});
+        Inputs.push_back({ 7 });
+        Inputs.push_back(std::vector<Smile::u8>(100000, 0xAB)); // match sobreposto (RLE) e longo
+        std::vector<Smile::u8> Mixed;
+        Smile::u32 State = 12345;
+        for (int I = 0; I < 200000; ++I) {
+            State = State * 1664525u + 1013904223u;
+            // Trechos aleatorios intercalados com repeticao a distancias variadas.
+            Mixed.push_back((I / 64) % 3 == 0 ? Smile::u8(State >> 24) : Mixed.empty() ? 0 : Mixed[I / 2]);
+        }
+        Inputs.push_back(Mixed);
+
+        for (const auto& In : Inputs) {
+            std::vector<Smile::u8> Packed;
+            Smile::LzCompress(In, Packed);
+            std::vector<Smile::u8> Out(In.size(), 0);
+            Check(Smile::LzDecompress(Packed, Out), "LZ: payload valido rejeitado");
+            Check(Out == In, "LZ: ida e volta alterou os bytes");
+            if (In.size() == 100000) Check(Packed.size() < In.size() / 50, "LZ: entrada constante nao comprimiu");
+        }
+    }
+
+    // Payload truncado, com offset antes do inicio ou expandindo para mais/menos que a saida:
+    // todos tem de falhar sem ler nem escrever fora dos spans.
+    void TestLzRejeitaCorrompido() {
+        std::vector<Smile::u8> In(5000);
+        for (size_t I = 0; I < In.size(); ++I) In[I] = Smile::u8((I * 7) % 13);
+        std::vector<Smile::u8> Packed;
+        Smile::LzCompress(In, Packed);
+
+        std::vector<Smile::u8> Out(In.size());
+        Check(!Smile::LzDecompress({ Packed.data(), Packed.size() - 1 }, Out), "LZ: payload truncado aceito");
+        std::vector<Smile::u8> Short(In.size() - 1), Long(In.size() + 1);
+        Check(!Smile::LzDecompress(Packed, Short), "LZ: saida menor que o payload aceita");
+        Check(!Smile::LzDecompress(Packed, Long), "LZ: saida maior que o payload aceita");
+        const std::vector<Smile::u8> BadOffset = { 0x10, 'a', 0x09, 0x00 }; // 1 literal, offset 9
+        std::vector<Smile::u8> Four(5);
+        Check(!Smile::LzDecompress(BadOffset, Four), "LZ: offset antes do inicio aceito");
+    }
+
+    Smile::SMeshEntry EntryFor(const FSyntheticMesh& _Mesh) {
+        Smile::SMeshEntry E{};
+        E.VertexCount = Smile::u32(_Mesh.Vertices.size());
+        E.IndexCount  = Smile::u32(_Mesh.Indices.size());
+        E.RTTriangleCount = Smile::u32(_Mesh.RTTriangles.size());
+        for (int C = 0; C < 3; ++C) { E.AABBMin[C] = 1e30f; E.AABBMax[C] = -1e30f; }
+        for (const Smile::Vertex& V : _Mesh.Vertices)
+            for (int C = 0; C < 3; ++C) {
+                E.AABBMin[C] = std::min(E.AABBMin[C], V.Position[C]);
+                E.AABBMax[C] = std::max(E.AABBMax[C], V.Position[C]);
+            }
+        return E;
+    }
+
+    // Sem quantizacao o bloco e sem perda; com ela, cada posicao erra no maximo meio passo e o
+    // resto (normal, UV, IB, RT) continua exato. As duas formas de indice sao exercitadas: o quad
+    // pequeno cabe em u16, o de 70k vertices obriga o varint.
+    void TestBlocoDeMeshIdaEVolta() {
+        FSyntheticMesh Big;
+        for (Smile::u32 I = 0; I < 70000; ++I) {
+            Smile::Vertex V{};
+            V.Position[0] = float(I % 300) * 0.25f;
+            V.Position[1] = float(I / 300) * 0.5f;
+            V.Position[2] = float((I * 37) % 101) * 0.01f;
+            V.Normal[1] = 1.0f;
+            V.TexCoord[0] = float(I) / 70000.0f;
+            Big.Vertices.push_back(V);
+        }
+        for (Smile::u32 I = 0; I + 301 < 70000; I += 7) Big.Indices.insert(Big.Indices.end(), { I, I + 1, I + 300 });
+        Smile::BuildRTTriangles(Big.Vertices.data(), Smile::u32(Big.Vertices.size()), Big.Indices.data(),
+                                Smile::u32(Big.Indices.size()), Big.RTTriangles);
+
+        const std::vector<FSyntheticMesh> Meshes = { MakeQuad(3.0f), Big };
+        for (const FSyntheticMesh& M : Meshes) {
+            const Smile::FMeshView View{ M.Vertices, M.Indices, M.RTTriangles };
+            for (const bool Quantize : { false, true }) {
+                Smile::SMeshEntry Entry = EntryFor(M);
+                const Smile::FCodedMeshBlock Block = Smile::EncodeMeshBlock(Entry, View, { Quantize });
+                Entry.Flags    = Block.Flags;
+                Entry.RawBytes = Block.RawBytes;
+                Entry.CodedBytes = Smile::u32(Block.Bytes.size());
+                const std::string Where = std::string(M.Vertices.size() > 65536 ? "malha grande" : "quad") +
+                                          (Quantize ? " quantizada" : " sem perda");
+                Check((Block.Flags & Smile::kMeshEntryCoded) != 0, Where + ": bloco sem a flag Coded");
+                Check(M.Vertices.size() <= 65536 || (Block.Flags & Smile::kMeshEntryIndexVarint),
+                      Where + ": u16 escolhido com mais de 65536 vertices");
+
+                Smile::FMesh Out;
+                std::string Error;
+                Check(Smile::DecodeMeshBlock(Entry, Block.Bytes, Out, Error), Where + ": decode falhou: " + Error);
+                Check(Out.Indices == M.Indices, Where + ": IB mudou");
+                Check(Out.RTTriangles.size() == M.RTTriangles.size() &&
+                      std::memcmp(Out.RTTriangles.data(), M.RTTriangles.data(),
+                                  M.RTTriangles.size() * sizeof(Smile::FRTTriangle)) == 0,
+                      Where + ": payload de RT mudou");
+                bool AttributesExact = Out.Vertices.size() == M.Vertices.size();
+                float WorstError = 0.0f, WorstStep = 0.0f;
+                for (int C = 0; C < 3; ++C)
+                    WorstStep = std::max(WorstStep, (Entry.AABBMax[C] - Entry.AABBMin[C]) / 65535.0f);
+                for (size_t I = 0; AttributesExact && I < M.Vertices.size(); ++I) {
+                    AttributesExact = std::memcmp(Out.Vertices[I].Normal, M.Vertices[I].Normal, 20) == 0;
+                    for (int C = 0; C < 3; ++C)
+                        WorstError = std::max(WorstError,
+                                              std::abs(Out.Vertices[I].Position[C] - M.Vertices[I].Position[C]));
+                }
+                Check(AttributesExact, Where + ": normal/UV mudou");
+                if (Quantize)
+                    Check(WorstError <= WorstStep * 0.5f + 1e-5f, Where + ": erro de quantizacao > meio passo");
+                else
+                    Check(WorstError == 0.0f, Where + ": posicao mudou sem quantizacao");
+            }
+        }
+    }
+
+    // Arquivo com uma parte crua e uma codificada: o parse aceita, a view da codificada fica
+    // vazia, e um bloco corrompido e pego no decode (nao vira geometria lixo).
+    void TestArquivoComBlocoCodificado() {
+        const FSyntheticMesh Raw = MakeQuad(0.0f), Coded = MakeQuad(5.0f);
+        std::vector<Smile::u8> File = BuildSMesh({ Raw });
+        Smile::SMeshHeader Header{};
+        std::memcpy(&Header, File.data(), sizeof(Header));
+        Header.MeshCount = 2;
+        std::memcpy(File.data(), &Header, sizeof(Header));
+
+        Smile::SMeshEntry Entry = EntryFor(Coded);
+        const Smile::FCodedMeshBlock Block =
+            Smile::EncodeMeshBlock(Entry, { Coded.Vertices, Coded.Indices, Coded.RTTriangles }, {});
+        const size_t GeometryStart = sizeof(Smile::SMeshHeader) + 2 * sizeof(Smile::SMeshEntry);
+        Entry.Flags       = Block.Flags;
+        Entry.RawBytes    = Block.RawBytes;
+        Entry.CodedBytes  = Smile::u32(Block.Bytes.size());
+        Entry.CodedOffset = File.size() + sizeof(Smile::SMeshEntry) - GeometryStart;
+        const Smile::u8* EntryBytes = reinterpret_cast<const Smile::u8*>(&Entry);
+        File.insert(File.begin() + sizeof(Smile::SMeshHeader) + sizeof(Smile::SMeshEntry), EntryBytes,
+                    EntryBytes + sizeof(Entry));
+        File.insert(File.end(), Block.Bytes.begin(), Block.Bytes.end());
+
+        Smile::FCookedMeshTable Table;
+        std::string Error;
+        Check(Smile::ParseCookedMeshes(File, Table, Error), "arquivo misto rejeitado: " + Error);
+        Check(Table.CodedCount == 1, "CodedCount errado");
+        Check(Table.Views.size() == 2 && !Table.Views[0].Vertices.empty() && Table.Views[1].Vertices.empty(),
+              "views do arquivo misto erradas");
+        if (Table.Entries.size() == 2) {
+            const Smile::SMeshEntry& E = Table.Entries[1];
+            Smile::FMesh Out;
+            Check(Smile::DecodeMeshBlock(E, Table.Geometry.subspan(E.CodedOffset, E.CodedBytes), Out, Error),
+                  "bloco do arquivo nao decodificou: " + Error);
+            Check(Out.Indices == Coded.Indices, "IB do bloco do arquivo difere");
+
+            std::vector<Smile::u8> Corrupt(Block.Bytes);
+            Corrupt[Corrupt.size() / 2] ^= 0x5A;
+            Corrupt.pop_back();
+            Check(!Smile::DecodeMeshBlock(E, Corrupt, Out, Error), "bloco corrompido decodificou");
+        }
+
+        std::vector<Smile::u8> Outside = File;
+        EntryAt(Outside, 1)->CodedBytes += 64;
+        Check(!Parses(Outside), "bloco codificado alem do fim do arquivo aceito");
+        std::vector<Smile::u8> Unknown = File;
+        EntryAt(Unknown, 0)->Flags = Smile::kMeshEntryQuantizedPosition; // variante sem Coded
+        Check(!Parses(Unknown), "flag de variante sem kMeshEntryCoded aceita");
+    }
+}
+
+int main() {
+    std::cout << "Smile.CookedGeometry\n";
+    TestViewsApontamParaOArquivo();
+    TestRejeitaCabecalhoInvalido();
+    TestRejeitaRegiaoForaDoArquivo();
+    TestRejeitaOffsetDesalinhado();
+    TestRejeitaPayloadDeRTInconsistente();
+    TestRejeitaClustersInconsistentes();
+    TestRejeitaLodsInconsistentes();
+    TestArquivoAusente();
+    TestLzIdaEVolta();
+    TestLzRejeitaCorrompido();
+    TestBlocoDeMeshIdaEVolta();
+    TestArquivoComBlocoCodificado();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
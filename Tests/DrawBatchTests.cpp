@@ -0,0 +1,170 @@
+// Lotes instanciados do G-buffer (Smile/Graphics/Renderer/DrawBatch.h).
+//
+// O contrato: um lote so junta vizinhos do mesmo grupo com slots CONSECUTIVOS no ObjectCB (o VS le
+// a instancia i no slot do primeiro + i), nunca passa de kMaxDrawInstances, e cobre a lista inteira
+// na ordem de entrada. De quebra, o caminho do renderer — slots agrupados por material/malha, cull,
+// ordem por DrawSortKey::Batch — tem que cair de um draw por item para um por grupo.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Graphics/Renderer/DrawBatch.h"
+#include "Smile/Graphics/Renderer/DrawSort.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::u32;
+    using Smile::u64;
+    using Smile::FDrawBatch;
+    namespace Key = Smile::DrawSortKey;
+
+    struct FItem {
+        u32 Material = 0;
+        u32 Mesh     = 0;
+        u32 Slot     = 0;
+    };
+
+    void Build(const std::vector<FItem>& _Items, std::vector<FDrawBatch>& _Out, u32 _Max = Smile::kMaxDrawInstances) {
+        Smile::BuildDrawBatches<FItem>(
+            _Items, _Out,
+            [](const FItem& _A, const FItem& _B) { return _A.Material == _B.Material && _A.Mesh == _B.Mesh; },
+            [](const FItem& _I) { return _I.Slot; }, _Max);
+    }
+
+    // Lotes cobrem [0, N) em ordem, sem buraco, e cada um e valido.
+    bool Valid(const std::vector<FItem>& _Items, const std::vector<FDrawBatch>& _Batches, u32 _Max) {
+        u32 Next = 0;
+        for (const FDrawBatch& B : _Batches) {
+            if (B.First != Next || B.Count == 0 || B.Count > _Max) return false;
+            for (u32 i = 1; i < B.Count; ++i) {
+                const FItem& A = _Items[B.First];
+                const FItem& I = _Items[B.First + i];
+                if (I.Material != A.Material || I.Mesh != A.Mesh || I.Slot != A.Slot + i) return false;
+            }
+            Next += B.Count;
+        }
+        return Next == _Items.size();
+    }
+
+    void TestAgrupamento() {
+        std::vector<FDrawBatch> Batches;
+        Build({}, Batches);
+        Check(Batches.empty(), "lista vazia gera lote");
+
+        // Tres da mesma malha, dois de outra, um de outro material.
+        const std::vector<FItem> Items = {
+            { 0, 0, 10 }, { 0, 0, 11 }, { 0, 0, 12 }, { 0, 1, 13 }, { 0, 1, 14 }, { 1, 1, 15 } };
+        Build(Items, Batches);
+        Check(Batches.size() == 3, "grupos vizinhos nao viraram 3 lotes");
+        Check(Valid(Items, Batches, Smile::kMaxDrawInstances), "lotes invalidos no agrupamento simples");
+        Check(Batches.size() == 3 && Batches[0].Count == 3 && Batches[1].Count == 2 && Batches[2].Count == 1,
+              "contagem por lote errada");
+    }
+
+    void TestSlotNaoConsecutivoCorta() {
+        // Item cullado no meio (slot 12 sumiu) e slot fora de ordem: mesmo grupo, lotes separados.
+        const std::vector<FItem> Items = { { 0, 0, 10 }, { 0, 0, 11 }, { 0, 0, 13 }, { 0, 0, 14 }, { 0, 0, 9 } };
+        std::vector<FDrawBatch> Batches;
+        Build(Items, Batches);
+        Check(Batches.size() == 3, "buraco de slot nao cortou o lote");
+        Check(Valid(Items, Batches, Smile::kMaxDrawInstances), "lotes invalidos com buraco");
+    }
+
+    void TestTeto() {
+        for (const u32 Max : { 1u, 7u, Smile::kMaxDrawInstances }) {
+            std::vector<FItem> Items(1000);
+            for (u32 i = 0; i < Items.size(); ++i) Items[i] = { 3, 5, 100 + i };
+            std::vector<FDrawBatch> Batches;
+            Build(Items, Batches, Max);
+            Check(Batches.size() == (1000 + Max - 1) / Max, "teto de instancias nao respeitado: " + std::to_string(Max));
+            Check(Valid(Items, Batches, Max), "lotes invalidos com teto " + std::to_string(Max));
+        }
+    }
+
+    void TestChaveDeLote() {
+        // Mesmo grupo: ordena pelo item. Grupo manda antes do item.
+        Check(Key::Batch(0, 1, 1, 5) < Key::Batch(0, 1, 1, 6), "item nao ordena dentro do grupo");
+        Check(Key::Batch(0, 1, 1, 900000) < Key::Batch(0, 1, 2, 0), "item vazou para o campo da malha");
+        Check(Key::Batch(0, 1, 9, 0) < Key::Batch(0, 2, 0, 0), "malha passou na frente do material");
+        Check(Key::Batch(0, 9, 9, 0) < Key::Batch(1, 0, 0, 0), "balde nao decide primeiro");
+        Check(Key::Batch(0, 1, 1, 0xFFFFFFFFu) == Key::Batch(0, 1, 1, 0xFFFFFu), "item alem do campo nao satura");
+        Check((Key::Batch(2, 3, 4, 0) >> 20) == (Key::State(2, 3, 4) >> 20), "prefixo difere da chave de estado");
+    }
+
+    // O caminho do renderer: cena com poucas geometrias repetidas, slots por (material, malha),
+    // frustum tira uma parte, G-buffer ordena por Batch e junta em lotes.
+    void TestCaminhoDoRenderer() {
+        constexpr u32 SceneCount = 2479, Meshes = 281, Materials = 40;
+        std::mt19937 Rng(7);
+        std::vector<FItem> Scene(SceneCount);
+        for (FItem& I : Scene) {
+            const u32 Mesh = static_cast<u32>(Rng() % Meshes);
+            I = { Mesh % Materials, Mesh, 0 }; // geometria cozida com o seu material
+        }
+
+        // BuildDrawLists: ordem de slot = ordem de cena, estavel por (material, malha).
+        std::vector<u32> Order(SceneCount), OrderScratch;
+        for (u32 i = 0; i < SceneCount; ++i) Order[i] = i;
+        Smile::FDrawSortScratch Scratch;
+        Smile::SortByKey(Order, OrderScratch, Scratch,
+                         [&](u32 _Si) { return Key::State(0, Scene[_Si].Material, Scene[_Si].Mesh); });
+        std::vector<FItem> All(SceneCount);
+        for (u32 k = 0; k < SceneCount; ++k) All[k] = { Scene[Order[k]].Material, Scene[Order[k]].Mesh, k };
+
+        // Visiveis em ordem qualquer (front-to-back), ~1/4 cullado.
+        std::vector<FItem> Visible;
+        for (const FItem& I : All)
+            if (Rng() % 4 != 0) Visible.push_back(I);
+        std::shuffle(Visible.begin(), Visible.end(), Rng);
+        const u32 VisibleCount = static_cast<u32>(Visible.size());
+
+        std::vector<FItem> VisibleScratch;
+        Smile::SortByKey(Visible, VisibleScratch, Scratch,
+                         [](const FItem& _I) { return Key::Batch(0, _I.Material, _I.Mesh, _I.Slot); });
+        std::vector<FDrawBatch> Batches;
+        Build(Visible, Batches);
+        Check(Valid(Visible, Batches, Smile::kMaxDrawInstances), "lotes invalidos no caminho do renderer");
+
+        // Cada grupo so pode ter mais de um lote onde o cull abriu buraco nos slots.
+        u32 Groups = 0, Holes = 0;
+        for (u32 i = 0; i < VisibleCount; ++i) {
+            const bool NewGroup = i == 0 || Visible[i].Material != Visible[i - 1].Material ||
+                                  Visible[i].Mesh != Visible[i - 1].Mesh;
+            if (NewGroup) ++Groups;
+            else if (Visible[i].Slot != Visible[i - 1].Slot + 1) ++Holes;
+        }
+        Check(Batches.size() == Groups + Holes, "lote cortado sem buraco de slot");
+        Check(Batches.size() < VisibleCount, "nenhum draw economizado");
+        std::cout << "  " << VisibleCount << " visiveis -> " << Batches.size() << " draws (" << Groups
+                  << " grupos)\n";
+    }
+}
+
+int main() {
+    std::cout << "Smile.DrawBatch\n";
+    TestAgrupamento();
+    TestSlotNaoConsecutivoCorta();
+    TestTeto();
+    TestChaveDeLote();
+    TestCaminhoDoRenderer();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,142 @@
+// Chaves de ordenacao + radix sort das listas de draw (Smile/Graphics/Renderer/DrawSort.h).
+//
+// O contrato: o RadixSortPairs e um sort ESTAVEL por chave (igual ao std::stable_sort); a chave de
+// profundidade ordena como a comparacao de f32; a de estado ordena por balde, depois material,
+// depois malha. E o que as listas do renderer precisam para sair iguais em toda execucao.
+//
+// `SmileDrawSortTests --bench` mede 10k/100k/1M itens: std::sort com o comparador antigo contra
+// chave + radix.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Graphics/Renderer/DrawSort.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::u64;
+    using Smile::FSortPair;
+    namespace Key = Smile::DrawSortKey;
+
+    // Um visivel: distancia ao quadrado e slot crescente, como sai do gather.
+    struct FItem {
+        f32 Dist = 0.0f;
+        u32 Slot = 0;
+        bool operator==(const FItem&) const = default;
+    };
+
+    void TestRadixEstavel() {
+        for (const u32 Count : { 0u, 1u, 2u, 255u, 256u, 4099u, 70001u }) {
+            for (const u64 Mask : { 0xFFull, 0xFFFF0000ull, ~0ull, 0xF000000000000000ull }) {
+                std::mt19937_64 Rng(Count * 31 + static_cast<u32>(Mask));
+                std::vector<FSortPair> Pairs(Count);
+                for (u32 i = 0; i < Count; ++i) Pairs[i] = { Rng() & Mask, i };
+                std::vector<FSortPair> Expected = Pairs, Scratch;
+                std::stable_sort(Expected.begin(), Expected.end(),
+                                 [](const FSortPair& a, const FSortPair& b) { return a.Key < b.Key; });
+                Smile::RadixSortPairs(Pairs, Scratch);
+                bool Same = true;
+                for (u32 i = 0; i < Count; ++i)
+                    Same = Same && Pairs[i].Key == Expected[i].Key && Pairs[i].Index == Expected[i].Index;
+                Check(Same, "radix difere do stable_sort com " + std::to_string(Count) + " pares");
+            }
+        }
+    }
+
+    void TestChaveDeProfundidade() {
+        // Ordena como f32, inclusive subnormais e 0; negativo cola no 0, NaN vai pro fim.
+        const f32 Ordered[] = { 0.0f, 1e-40f, 1e-30f, 0.5f, 1.0f, 1.0000001f, 3.0f, 1e20f, 3.0e38f };
+        for (size_t i = 1; i < std::size(Ordered); ++i)
+            Check(Key::Depth(0, Ordered[i - 1]) < Key::Depth(0, Ordered[i]), "profundidade fora de ordem");
+        Check(Key::Depth(0, -2.0f) == Key::Depth(0, 0.0f), "negativo deveria valer 0");
+        Check(Key::Depth(0, std::numeric_limits<f32>::quiet_NaN()) > Key::Depth(0, 3.0e38f), "NaN deveria ir pro fim");
+        Check(Key::Depth(1, 0.0f) > Key::Depth(0, 3.0e38f), "balde deveria vir antes da distancia");
+    }
+
+    void TestChaveDeEstado() {
+        // Balde > material > malha > profundidade, e ids alem do campo saturam sem invadir o vizinho.
+        Check(Key::State(1, 0, 0) > Key::State(0, 0xFFFFFu, 0xFFFFFu, 1e30f), "balde");
+        Check(Key::State(0, 2, 0) > Key::State(0, 1, 0xFFFFFu, 1e30f), "material");
+        Check(Key::State(0, 1, 2) > Key::State(0, 1, 1, 1e30f), "malha");
+        Check(Key::State(0, 1, 1, 2.0f) > Key::State(0, 1, 1, 1.0f), "profundidade");
+        Check(Key::State(0, 5u << 20, 0) == Key::State(0, 0xFFFFFu, 0), "material saturado");
+        Check(Key::State(0, 0, 7u << 20) == Key::State(0, 0, 0xFFFFFu), "malha saturada");
+    }
+
+    // Distancias com empates de proposito: o sort antigo era por (Dist, Slot).
+    std::vector<FItem> MakeVisible(u32 _Count, u32 _Seed) {
+        std::mt19937 Rng(_Seed);
+        std::uniform_real_distribution<f32> D(0.0f, 250000.0f);
+        std::vector<FItem> Out(_Count);
+        for (u32 i = 0; i < _Count; ++i) Out[i] = { i % 5 == 0 ? 100.0f : D(Rng), 4096u + i };
+        return Out;
+    }
+
+    bool OldLess(const FItem& a, const FItem& b) { return a.Dist != b.Dist ? a.Dist < b.Dist : a.Slot < b.Slot; }
+
+    void TestVisiveisComoAntes() {
+        for (const u32 Count : { 0u, 3u, 1000u, 50001u }) {
+            std::vector<FItem> Got = MakeVisible(Count, Count + 1), Expected = Got, ItemScratch;
+            std::sort(Expected.begin(), Expected.end(), OldLess);
+            Smile::FDrawSortScratch Scratch;
+            Smile::SortByKey(Got, ItemScratch, Scratch, [](const FItem& _I) { return Key::Depth(0, _I.Dist); });
+            Check(Got == Expected, "visiveis: radix difere do sort (Dist, Slot) com " + std::to_string(Count));
+        }
+    }
+
+    void Bench(u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        const std::vector<FItem> Src = MakeVisible(_Count, 42);
+        constexpr int kReps = 10;
+        std::vector<FItem> A, B, ItemScratch;
+        Smile::FDrawSortScratch Scratch;
+        double SortMs = 0.0, RadixMs = 0.0;
+        for (int r = 0; r < kReps; ++r) {
+            A = Src;
+            auto T0 = Clock::now();
+            std::sort(A.begin(), A.end(), OldLess);
+            SortMs += std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+            B = Src;
+            T0 = Clock::now();
+            Smile::SortByKey(B, ItemScratch, Scratch, [](const FItem& _I) { return Key::Depth(0, _I.Dist); });
+            RadixMs += std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+        }
+        Check(A == B, "bench: ordens diferentes");
+        std::cout << "  bench " << _Count << " visiveis: std::sort " << SortMs / kReps << " ms | radix "
+                  << RadixMs / kReps << " ms (" << SortMs / RadixMs << "x)\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.DrawSort\n";
+    TestRadixEstavel();
+    TestChaveDeProfundidade();
+    TestChaveDeEstado();
+    TestVisiveisComoAntes();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench")
+        for (const u32 Count : { 10000u, 100000u, 1000000u }) Bench(Count);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
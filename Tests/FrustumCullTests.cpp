@@ -0,0 +1,263 @@
+// Culling em lote (Smile/Scene/FrustumCull.h) contra o teste escalar de sempre.
+//
+// As vistas sao as do frame de verdade: a camera (6 planos), as 4 cascatas do CSM (5 planos,
+// sem near) e N spots (6 planos, perspectiva). O contrato: as tres vias — escalar, SSE e AVX —
+// devolvem por vista EXATAMENTE a lista que o laco antigo, objeto por objeto, devolveria, na
+// mesma ordem. O tamanho das cenas nao e multiplo de 8 de proposito (a cauda escalar).
+//
+// `SmileFrustumCullTests --bench` mede 10k e 100k caixas contra camera + 4 cascatas + 8 spots:
+// o laco escalar por vista (o que o renderer fazia) contra o kernel multi-vista em cada via.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Scene/FrustumCull.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::Vec3;
+    using Smile::Vec4;
+    using Smile::Mat44;
+    using Smile::FCullBounds;
+    using Smile::FCullFrustum;
+    using Smile::ECullPath;
+
+    constexpr ECullPath kPaths[] = { ECullPath::Scalar, ECullPath::SSE, ECullPath::AVX };
+
+    FCullBounds MakeBounds(u32 _Count, u32 _Seed) {
+        std::mt19937 Rng(_Seed);
+        std::uniform_real_distribution<f32> Pos(-400.0f, 400.0f), Half(0.0f, 6.0f);
+        FCullBounds B;
+        B.Reserve(_Count);
+        for (u32 i = 0; i < _Count; ++i) {
+            const Vec3 C{ Pos(Rng), Pos(Rng) * 0.1f, Pos(Rng) };
+            // Algumas caixas degeneradas (ponto) e algumas enormes, que atravessam tudo.
+            const f32 H = i % 50 == 7 ? 0.0f : (i % 211 == 3 ? 300.0f : Half(Rng));
+            B.Push({ C.X - H, C.Y - H, C.Z - H }, { C.X + H, C.Y + H * 0.5f, C.Z + H });
+        }
+        return B;
+    }
+
+    // Camera + 4 cascatas + N spots, como no frame.
+    std::vector<FCullFrustum> MakeViews(u32 _Spots) {
+        std::vector<FCullFrustum> Views;
+        const Mat44 View = Mat44::LookAtLH({ 10.0f, 30.0f, -50.0f }, { 40.0f, 0.0f, 100.0f }, { 0.0f, 1.0f, 0.0f });
+        Views.push_back(FCullFrustum::FromViewProj(View * Mat44::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, 2000.0f)));
+
+        // Cascatas: ortho de tamanho crescente; o near sai, como no FSunShadows.
+        const Mat44 Sun = Mat44::LookAtLH({ 0.0f, 300.0f, 0.0f }, { 60.0f, 0.0f, 30.0f }, { 0.0f, 0.0f, 1.0f });
+        for (int c = 0; c < 4; ++c) {
+            const f32 Size = 20.0f * std::pow(3.0f, f32(c));
+            const FCullFrustum Full = FCullFrustum::FromViewProj(Sun * Mat44::OrthographicLH(Size, Size, 1.0f, 800.0f));
+            const Vec4 NoNear[5] = { Full.Planes[0], Full.Planes[1], Full.Planes[2], Full.Planes[3], Full.Planes[5] };
+            Views.push_back(FCullFrustum::FromPlanes(NoNear, 5));
+        }
+
+        std::mt19937 Rng(11);
+        std::uniform_real_distribution<f32> Pos(-300.0f, 300.0f);
+        for (u32 s = 0; s < _Spots; ++s) {
+            const Vec3 Eye{ Pos(Rng), 8.0f, Pos(Rng) };
+            const Vec3 At{ Eye.X + 1.0f, 0.0f, Eye.Z + 0.5f };
+            const Mat44 SpotView = Mat44::LookAtLH(Eye, At, { 0.0f, 1.0f, 0.0f });
+            Views.push_back(FCullFrustum::FromViewProj(SpotView * Mat44::PerspectiveFovLH(1.2f, 1.0f, 0.05f, 40.0f)));
+        }
+        return Views;
+    }
+
+    // O laco que o renderer tinha: uma vista por vez, objeto por objeto.
+    std::vector<std::vector<u32>> Reference(const FCullBounds& _B, const std::vector<FCullFrustum>& _Views) {
+        std::vector<std::vector<u32>> Out(_Views.size());
+        for (size_t v = 0; v < _Views.size(); ++v)
+            for (u32 i = 0; i < _B.Size(); ++i)
+                if (!Smile::AABBOutsideFrustum(_Views[v], { _B.MinX[i], _B.MinY[i], _B.MinZ[i] },
+                                               { _B.MaxX[i], _B.MaxY[i], _B.MaxZ[i] }))
+                    Out[v].push_back(i);
+        return Out;
+    }
+
+    std::vector<u32> ReferenceSphere(const FCullBounds& _B, const Vec3& _C, f32 _R) {
+        std::vector<u32> Out;
+        const f32 P[3] = { _C.X, _C.Y, _C.Z };
+        for (u32 i = 0; i < _B.Size(); ++i) {
+            const f32 Lo[3] = { _B.MinX[i], _B.MinY[i], _B.MinZ[i] };
+            const f32 Hi[3] = { _B.MaxX[i], _B.MaxY[i], _B.MaxZ[i] };
+            f32 D2 = 0.0f;
+            for (int a = 0; a < 3; ++a) {
+                if (P[a] < Lo[a])      { const f32 d = Lo[a] - P[a]; D2 += d * d; }
+                else if (P[a] > Hi[a]) { const f32 d = P[a] - Hi[a]; D2 += d * d; }
+            }
+            if (D2 <= _R * _R) Out.push_back(i);
+        }
+        return Out;
+    }
+
+    void TestViasIguaisAoEscalar() {
+        for (const u32 Count : { 0u, 1u, 7u, 9u, 4099u }) {
+            const FCullBounds B = MakeBounds(Count, Count + 1);
+            const std::vector<FCullFrustum> Views = MakeViews(6);
+            const auto Expected = Reference(B, Views);
+            for (const ECullPath Path : kPaths) {
+                std::vector<std::vector<u32>> Got(Views.size(), std::vector<u32>{ 12345u }); // lixo: tem de sumir
+                Smile::CullFrustums(B, Views, Got, Path);
+                Check(Got == Expected, std::to_string(Count) + " caixas, via " + Smile::CullPathName(Path) +
+                                           ": lista difere do laco escalar");
+            }
+        }
+    }
+
+    void TestFaixas() {
+        // A forma por faixa (um chunk de job): juntar as faixas em ordem da a lista da cena toda,
+        // com inicio e fim fora do alinhamento de 4/8.
+        const FCullBounds B = MakeBounds(4099, 17);
+        const std::vector<FCullFrustum> Views = MakeViews(3);
+        const auto Expected = Reference(B, Views);
+        for (const ECullPath Path : kPaths) {
+            for (const u32 Grain : { 1u, 5u, 1000u, 1024u, 5000u }) {
+                std::vector<std::vector<u32>> Joined(Views.size()), Part(Views.size());
+                for (u32 Begin = 0; Begin < B.Size(); Begin += Grain) {
+                    Smile::CullFrustums(B, Begin, Begin + Grain, Views, Part, Path);
+                    for (size_t v = 0; v < Views.size(); ++v)
+                        Joined[v].insert(Joined[v].end(), Part[v].begin(), Part[v].end());
+                }
+                Check(Joined == Expected, "faixas de " + std::to_string(Grain) + ", via " +
+                                              Smile::CullPathName(Path) + ": juncao difere da cena toda");
+            }
+            std::vector<std::vector<u32>> Empty(Views.size(), std::vector<u32>{ 1u });
+            Smile::CullFrustums(B, 10, 10, Views, Empty, Path);
+            Check(Empty[0].empty(), "faixa vazia devolveu indice");
+        }
+    }
+
+    void TestVistasCortamAlgo() {
+        // Guarda contra um teste que passa porque nada e cullado (ou tudo e).
+        const FCullBounds B = MakeBounds(4099, 5);
+        const std::vector<FCullFrustum> Views = MakeViews(6);
+        std::vector<std::vector<u32>> Got(Views.size());
+        Smile::CullFrustums(B, Views, Got);
+        for (size_t v = 0; v < Views.size(); ++v)
+            Check(!Got[v].empty() && Got[v].size() < B.Size(),
+                  "vista " + std::to_string(v) + " nao corta nada (ou tudo)");
+        Check(Got[4].size() > Got[1].size(), "cascata 3 deveria ver mais que a 0");
+    }
+
+    void TestPlanosDeBorda() {
+        // Caixa encostada no plano (d == 0) fica dentro; um epsilon alem sai. Plano com
+        // componente zero escolhe o Max, como no escalar.
+        FCullBounds B;
+        B.Push({ -1.0f, -1.0f, -1.0f }, { 0.0f, 1.0f, 1.0f });        // toca x = 0
+        B.Push({ -2.0f, -1.0f, -1.0f }, { -0.001f, 1.0f, 1.0f });     // fora
+        B.Push({ 3.0f, 3.0f, 3.0f }, { 3.0f, 3.0f, 3.0f });           // ponto dentro
+        B.Push({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f });        // atravessa
+        B.Push({ -1.0f, -1.0f, -1.0f }, { -0.5f, 1.0f, 1.0f });       // fora
+        FCullFrustum HalfSpace;
+        HalfSpace.PlaneCount = 1;
+        HalfSpace.Planes[0]  = { 1.0f, 0.0f, 0.0f, 0.0f }; // x >= 0
+        const std::vector<FCullFrustum> Views{ HalfSpace };
+        for (const ECullPath Path : kPaths) {
+            std::vector<std::vector<u32>> Got(1);
+            Smile::CullFrustums(B, Views, Got, Path);
+            Check(Got[0] == std::vector<u32>({ 0u, 2u, 3u }),
+                  std::string("borda do plano, via ") + Smile::CullPathName(Path));
+        }
+
+        FCullFrustum NoPlanes;
+        NoPlanes.PlaneCount = 0; // vista vazia: tudo passa
+        std::vector<std::vector<u32>> All(1);
+        Smile::CullFrustums(B, std::vector<FCullFrustum>{ NoPlanes }, All);
+        Check(All[0].size() == B.Size(), "vista sem planos cortou caixa");
+    }
+
+    void TestEsfera() {
+        for (const u32 Count : { 0u, 5u, 13u, 4099u }) {
+            const FCullBounds B = MakeBounds(Count, Count + 3);
+            for (const f32 Radius : { 0.0f, 25.0f, 120.0f }) {
+                const Vec3 C{ 15.0f, 2.0f, -40.0f };
+                const std::vector<u32> Expected = ReferenceSphere(B, C, Radius);
+                for (const ECullPath Path : kPaths) {
+                    std::vector<u32> Got{ 7u };
+                    Smile::CullSphere(B, C, Radius, Got, Path);
+                    Check(Got == Expected, "esfera r=" + std::to_string(Radius) + " em " + std::to_string(Count) +
+                                               " caixas, via " + Smile::CullPathName(Path));
+                }
+            }
+        }
+        // Centro dentro da caixa: distancia 0, passa mesmo com raio 0.
+        FCullBounds One;
+        One.Push({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f });
+        std::vector<u32> Got;
+        Smile::CullSphere(One, { 0.0f, 0.0f, 0.0f }, 0.0f, Got);
+        Check(Got.size() == 1, "centro dentro da caixa");
+    }
+
+    void Bench(u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        const FCullBounds B = MakeBounds(_Count, 99);
+        const std::vector<FCullFrustum> Views = MakeViews(8);
+        constexpr int kReps = 20;
+        auto Ms = [](Clock::time_point _A, Clock::time_point _B) {
+            return std::chrono::duration<double, std::milli>(_B - _A).count() / kReps;
+        };
+
+        // Baseline: uma varredura da cena por vista, caixa por caixa, com as caixas em AoS como
+        // nos itens de draw/caster.
+        std::vector<Vec3> Min(_Count), Max(_Count);
+        for (u32 i = 0; i < _Count; ++i) {
+            Min[i] = { B.MinX[i], B.MinY[i], B.MinZ[i] };
+            Max[i] = { B.MaxX[i], B.MaxY[i], B.MaxZ[i] };
+        }
+        std::vector<std::vector<u32>> Ref(Views.size());
+        const auto T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r)
+            for (size_t v = 0; v < Views.size(); ++v) {
+                Ref[v].clear();
+                for (u32 i = 0; i < _Count; ++i)
+                    if (!Smile::AABBOutsideFrustum(Views[v], Min[i], Max[i])) Ref[v].push_back(i);
+            }
+        const double ScalarMs = Ms(T0, Clock::now());
+        std::cout << "  bench " << _Count << " caixas x " << Views.size() << " vistas: laco por vista " << ScalarMs
+                  << " ms";
+
+        for (const ECullPath Path : kPaths) {
+            std::vector<std::vector<u32>> Got(Views.size());
+            const auto T1 = Clock::now();
+            for (int r = 0; r < kReps; ++r) Smile::CullFrustums(B, Views, Got, Path);
+            const double PathMs = Ms(T1, Clock::now());
+            std::cout << " | " << Smile::CullPathName(Path) << " " << PathMs << " ms (" << ScalarMs / PathMs << "x)";
+            Check(Got == Ref, "bench: listas diferentes");
+        }
+        std::cout << " [melhor via nesta CPU: " << Smile::CullPathName(Smile::DetectCullPath()) << "]\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.FrustumCull\n";
+    TestViasIguaisAoEscalar();
+    TestFaixas();
+    TestVistasCortamAlgo();
+    TestPlanosDeBorda();
+    TestEsfera();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench")
+        for (const u32 Count : { 10000u, 100000u }) Bench(Count);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
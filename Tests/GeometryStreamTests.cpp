@@ -0,0 +1,281 @@
+// Contrato do pipeline de geometria em chunks (GeometryStream.h).
+//
+// O AddMeshesBatch passou a empacotar o chunk N+1 num worker enquanto submete o chunk N. O que
+// nao pode mudar com isso e o que chega a GPU: o layout [VB][IB][RT alinhado a 32] de cada pool,
+// a fatia de cada mesh e a ordem dos chunks. E o que pode dar errado so com duas threads e
+// travar (teto de memoria, erro no meio) ou entregar fora de ordem. Um sink em memoria
+// substitui o device; o conteudo do staging e comparado byte a byte com o modo serial.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Smile/Scene/GeometryStream.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    // Grade de Quads x 1 quads. Geometria com tamanho variavel para os chunks nao sairem todos
+    // iguais; o conteudo so precisa ser distinto por mesh.
+    Smile::FMesh MakeStrip(Smile::u32 _Quads, float _Seed) {
+        Smile::FMesh M;
+        for (Smile::u32 I = 0; I <= _Quads; ++I)
+            for (Smile::u32 J = 0; J < 2; ++J) {
+                Smile::Vertex V{};
+                V.Position[0] = _Seed + float(I);
+                V.Position[1] = float(J);
+                V.Normal[2]   = 1.0f;
+                V.TexCoord[0] = float(I) / float(_Quads);
+                M.Vertices.push_back(V);
+            }
+        for (Smile::u32 I = 0; I < _Quads; ++I) {
+            const Smile::u32 A = I * 2, B = A + 1, C = A + 2, D = A + 3;
+            M.Indices.insert(M.Indices.end(), { A, C, B, B, C, D });
+        }
+        return M;
+    }
+
+    // Mistura o que o AddMeshesBatch recebe de verdade: mesh com payload de RT pronto (cena
+    // cozida), sem payload (malha runtime, gerado no empacotamento) e sem geometria.
+    std::vector<Smile::FMesh> MakeScene() {
+        std::vector<Smile::FMesh> Meshes;
+        for (Smile::u32 I = 0; I < 40; ++I) {
+            if (I % 13 == 5) {
+                Meshes.emplace_back(); // vazio: fatia de contagem zero
+                continue;
+            }
+            Smile::FMesh M = MakeStrip(1 + (I * 7) % 23, float(I) * 100.0f);
+            if (I % 2 == 0)
+                Smile::BuildRTTriangles(M.Vertices.data(), Smile::u32(M.Vertices.size()), M.Indices.data(),
+                                        Smile::u32(M.Indices.size()), M.RTTriangles);
+            Meshes.push_back(std::move(M));
+        }
+        return Meshes;
+    }
+
+    std::vector<Smile::FMeshView> ViewsOf(const std::vector<Smile::FMesh>& _Meshes) {
+        std::vector<Smile::FMeshView> Views;
+        for (const Smile::FMesh& M : _Meshes) Views.push_back(Smile::FMeshView::Of(M));
+        return Views;
+    }
+
+    class FMemorySink final : public Smile::IGeometryUploadSink {
+    public:
+        struct FSubmitted {
+            Smile::u32                         ChunkIndex = 0;
+            Smile::FGeometryChunk              Chunk;
+            std::vector<Smile::FGeometrySlice> Slices;
+            std::vector<Smile::u8>             Bytes;
+        };
+
+        std::vector<Smile::FGeometryChunk> Plan;
+        std::vector<std::vector<Smile::u8>> Staging;
+        std::vector<FSubmitted>            Submitted;
+        std::thread::id                    CallerThread = std::this_thread::get_id();
+        bool                               SubmitOffCaller = false;
+        std::atomic<Smile::u64>            Outstanding{ 0 };
+        std::atomic<Smile::u64>            PeakOutstanding{ 0 };
+        int                                ThrowOnAcquire = -1;
+        int                                ThrowOnSubmit  = -1;
+        std::chrono::milliseconds          SubmitDelay{ 0 };
+
+        void BeginStream(std::span<const Smile::FGeometryChunk> _Plan) override {
+            Plan.assign(_Plan.begin(), _Plan.end());
+            Staging.resize(_Plan.size());
+        }
+
+        Smile::u8* AcquireStaging(Smile::u32 _ChunkIndex, const Smile::FGeometryChunk& _Chunk) override {
+            if (int(_ChunkIndex) == ThrowOnAcquire) throw std::runtime_error("acquire");
+            const Smile::u64 Now = Outstanding += _Chunk.TotalBytes();
+            Smile::u64 Peak = PeakOutstanding.load();
+            while (Now > Peak && !PeakOutstanding.compare_exchange_weak(Peak, Now)) {}
+            // Lixo conhecido no staging: padding que o pipeline nao escreve fica visivel igual nos
+            // dois modos, e byte que ele esquecer de escrever aparece na comparacao.
+            Staging[_ChunkIndex].assign(size_t(_Chunk.TotalBytes()), Smile::u8(0xCD));
+            return Staging[_ChunkIndex].data();
+        }
+
+        void SubmitChunk(Smile::u32 _ChunkIndex, const Smile::FGeometryChunk& _Chunk,
+                         std::span<const Smile::FGeometrySlice> _Slices) override {
+            if (std::this_thread::get_id() != CallerThread) SubmitOffCaller = true;
+            if (int(_ChunkIndex) == ThrowOnSubmit) throw std::runtime_error("submit");
+            if (SubmitDelay.count() > 0) std::this_thread::sleep_for(SubmitDelay);
+            Submitted.push_back({ _ChunkIndex, _Chunk, { _Slices.begin(), _Slices.end() },
+                                  std::move(Staging[_ChunkIndex]) });
+            Outstanding -= _Chunk.TotalBytes();
+        }
+    };
+
+    void TestPlanoCobreTudoEAlinhaRT() {
+        const std::vector<Smile::FMesh> Meshes = MakeScene();
+        const std::vector<Smile::FMeshView> Views = ViewsOf(Meshes);
+        const Smile::u64 Budget = 4096;
+        const auto Plan = Smile::PlanGeometryChunks(Views, Budget);
+
+        Check(Plan.size() > 3, "orcamento pequeno deveria gerar varios chunks");
+        Smile::u32 Next = 0;
+        for (const Smile::FGeometryChunk& Chunk : Plan) {
+            Check(Chunk.FirstMesh == Next, "chunks nao sao contiguos na ordem dos meshes");
+            Check(Chunk.MeshCount > 0, "chunk vazio no plano");
+            Check(Chunk.RtBase % sizeof(Smile::FRTTriangle) == 0, "regiao de RT desalinhada");
+            Check(Chunk.RtBase >= Chunk.VbBytes + Chunk.IbBytes, "regiao de RT sobrepoe o IB");
+            Check(Chunk.MeshCount == 1 || Chunk.VbBytes + Chunk.IbBytes + Chunk.RtBytes <= Budget,
+                  "chunk de varios meshes estourou o orcamento");
+            Next = Chunk.FirstMesh + Chunk.MeshCount;
+        }
+        Check(Next == Views.size(), "plano nao cobre todos os meshes");
+        Check(Smile::PlanGeometryChunks({}, Budget).empty(), "lista vazia gerou chunk");
+    }
+
+    // Cada fatia entregue tem de ler de volta exatamente o mesh de origem, com o payload de RT
+    // cozido ou gerado.
+    void CheckSlicesMatch(const FMemorySink& _Sink, const std::vector<Smile::FMesh>& _Meshes,
+                          std::string_view _Where) {
+        const std::string Where(_Where);
+        Smile::u32 Next = 0;
+        for (size_t S = 0; S < _Sink.Submitted.size(); ++S) {
+            const auto& Sub = _Sink.Submitted[S];
+            Check(Sub.ChunkIndex == S, Where + ": chunk submetido fora de ordem");
+            Check(Sub.Chunk.FirstMesh == Next, Where + ": chunk pulou meshes");
+            Check(Sub.Slices.size() == Sub.Chunk.MeshCount, Where + ": numero de fatias errado");
+            for (Smile::u32 I = 0; I < Sub.Slices.size(); ++I) {
+                const Smile::FMesh& M = _Meshes[Sub.Chunk.FirstMesh + I];
+                const Smile::FGeometrySlice& Slice = Sub.Slices[I];
+                if (M.Vertices.empty() || M.Indices.empty()) {
+                    Check(Slice.IndexCount == 0 && Slice.VertexCount == 0, Where + ": mesh vazio ganhou fatia");
+                    continue;
+                }
+                Check(Slice.VbOffset % sizeof(Smile::Vertex) == 0, Where + ": VB desalinhado");
+                Check(Slice.IbOffset % sizeof(Smile::u32) == 0, Where + ": IB desalinhado");
+                Check(Slice.RtOffset % sizeof(Smile::FRTTriangle) == 0, Where + ": RT desalinhado");
+                std::vector<Smile::FRTTriangle> Expected = M.RTTriangles;
+                if (Expected.empty())
+                    Smile::BuildRTTriangles(M.Vertices.data(), Smile::u32(M.Vertices.size()), M.Indices.data(),
+                                            Smile::u32(M.Indices.size()), Expected);
+                Check(Slice.VertexCount == M.Vertices.size() && Slice.IndexCount == M.Indices.size() &&
+                      Slice.RTTriangleCount == Expected.size(),
+                      Where + ": contagens da fatia erradas");
+                const Smile::u8* Base = Sub.Bytes.data();
+                const size_t VbBytes = M.Vertices.size() * sizeof(Smile::Vertex);
+                const size_t IbBytes = M.Indices.size() * sizeof(Smile::u32);
+                const size_t RtBytes = Expected.size() * sizeof(Smile::FRTTriangle);
+                Check(std::memcmp(Base + Slice.VbOffset, M.Vertices.data(), VbBytes) == 0,
+                      Where + ": VB empacotado difere");
+                Check(std::memcmp(Base + Slice.IbOffset, M.Indices.data(), IbBytes) == 0,
+                      Where + ": IB empacotado difere");
+                Check(std::memcmp(Base + Slice.RtOffset, Expected.data(), RtBytes) == 0,
+                      Where + ": RT empacotado difere");
+            }
+            Next = Sub.Chunk.FirstMesh + Sub.Chunk.MeshCount;
+        }
+        Check(Next == _Meshes.size(), Where + ": nem todos os meshes foram entregues");
+    }
+
+    void TestPipelineIgualAoSerial() {
+        const std::vector<Smile::FMesh> Meshes = MakeScene();
+        const std::vector<Smile::FMeshView> Views = ViewsOf(Meshes);
+
+        Smile::FGeometryStreamOptions Serial;
+        Serial.ChunkBudget = 4096;
+        Serial.Pipelined   = false;
+        FMemorySink A;
+        const auto StatsA = Smile::StreamGeometry(Views, A, Serial);
+
+        Smile::FGeometryStreamOptions Piped = Serial;
+        Piped.Pipelined = true;
+        FMemorySink B;
+        const auto StatsB = Smile::StreamGeometry(Views, B, Piped);
+
+        CheckSlicesMatch(A, Meshes, "serial");
+        CheckSlicesMatch(B, Meshes, "pipeline");
+        Check(!B.SubmitOffCaller, "SubmitChunk chamado fora da thread chamadora");
+        Check(StatsA.Chunks == StatsB.Chunks && StatsA.Bytes == StatsB.Bytes, "estatisticas divergem");
+        Check(A.Submitted.size() == B.Submitted.size(), "numero de chunks diverge");
+        for (size_t I = 0; I < A.Submitted.size() && I < B.Submitted.size(); ++I)
+            Check(A.Submitted[I].Bytes == B.Submitted[I].Bytes, "staging do pipeline difere do serial");
+    }
+
+    // Submit lento deixa o worker correr na frente; o teto tem de segura-lo.
+    void TestTetoDeMemoriaEmVoo() {
+        const std::vector<Smile::FMesh> Meshes = MakeScene();
+        const std::vector<Smile::FMeshView> Views = ViewsOf(Meshes);
+        Smile::FGeometryStreamOptions Options;
+        Options.ChunkBudget    = 2048;
+        Options.InFlightBudget = 5000;
+        FMemorySink Sink;
+        Sink.SubmitDelay = std::chrono::milliseconds(2);
+        const auto Stats = Smile::StreamGeometry(Views, Sink, Options);
+
+        Smile::u64 Largest = 0;
+        for (const auto& Chunk : Sink.Plan) Largest = std::max(Largest, Chunk.TotalBytes());
+        Check(Sink.PeakOutstanding <= std::max(Options.InFlightBudget, Largest),
+              "staging adquirido e nao submetido passou do teto");
+        Check(Stats.PeakInFlightBytes <= std::max(Options.InFlightBudget, Largest),
+              "pico reportado passou do teto");
+        CheckSlicesMatch(Sink, Meshes, "teto");
+
+        // Teto menor que um chunk nao pode travar: com nada em voo, o worker segue.
+        Options.InFlightBudget = 1;
+        FMemorySink Tight;
+        Smile::StreamGeometry(Views, Tight, Options);
+        CheckSlicesMatch(Tight, Meshes, "teto minimo");
+    }
+
+    void TestErroSobeSemTravar() {
+        const std::vector<Smile::FMesh> Meshes = MakeScene();
+        const std::vector<Smile::FMeshView> Views = ViewsOf(Meshes);
+        Smile::FGeometryStreamOptions Options;
+        Options.ChunkBudget    = 2048;
+        Options.InFlightBudget = 4096;
+
+        FMemorySink OnAcquire;
+        OnAcquire.ThrowOnAcquire = 3;
+        bool Threw = false;
+        try {
+            Smile::StreamGeometry(Views, OnAcquire, Options);
+        } catch (const std::runtime_error&) {
+            Threw = true;
+        }
+        Check(Threw, "erro no worker nao subiu para a chamadora");
+        Check(OnAcquire.Submitted.size() == 3, "chunks prontos antes do erro nao foram submetidos");
+
+        FMemorySink OnSubmit;
+        OnSubmit.ThrowOnSubmit = 2;
+        Threw = false;
+        try {
+            Smile::StreamGeometry(Views, OnSubmit, Options);
+        } catch (const std::runtime_error&) {
+            Threw = true;
+        }
+        Check(Threw, "erro no SubmitChunk nao subiu");
+        Check(OnSubmit.Submitted.size() == 2, "submit continuou depois do erro");
+    }
+}
+
+int main() {
+    std::cout << "Smile.GeometryStream\n";
+    TestPlanoCobreTudoEAlinhaRT();
+    TestPipelineIgualAoSerial();
+    TestTetoDeMemoriaEmVoo();
+    TestErroSobeSemTravar();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,168 @@
+// Pool de workers do frame (Smile/Core/JobSystem.h).
+//
+// O contrato que o renderer usa: o ParallelFor cobre [0, Count) com chunks FIXOS de `Grain`, cada
+// chunk exatamente uma vez; o ParallelGather junta as saidas por chunk na ordem do laco serial; e o
+// ParallelSort com uma ordem total devolve o mesmo vetor do std::sort. Tudo comparado contra o
+// caminho serial (Jobs == nullptr) com 0, 1, 3 e 15 workers.
+//
+// `SmileJobSystemTests --bench` mede o gather+sort das listas de draw com 100k/1M itens.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Core/JobSystem.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::FJobSystem;
+
+    // Item parecido com o FVisibleItem: distancia com muitos empates, slot unico.
+    struct FItem {
+        f32 Dist;
+        u32 Slot;
+        bool operator==(const FItem&) const = default;
+    };
+
+    bool ItemLess(const FItem& a, const FItem& b) { return a.Dist != b.Dist ? a.Dist < b.Dist : a.Slot < b.Slot; }
+
+    std::vector<FItem> MakeItems(u32 _Count, u32 _Seed) {
+        std::mt19937 Rng(_Seed);
+        std::uniform_int_distribution<int> D(0, 63); // poucas distancias: empates por todo lado
+        std::vector<FItem> Out(_Count);
+        for (u32 i = 0; i < _Count; ++i) Out[i] = { static_cast<f32>(D(Rng)) * 0.5f, i * 7u % (_Count + 1) };
+        return Out;
+    }
+
+    void TestCobertura(FJobSystem* _Jobs, const std::string& _Tag) {
+        for (const u32 Count : { 0u, 1u, 1023u, 1024u, 1025u, 70001u }) {
+            for (const u32 Grain : { 1u, 64u, 1024u }) {
+                std::vector<std::atomic<u32>> Hits(Count);
+                std::vector<u32> ChunkOf(Count, ~0u);
+                std::atomic<u32>  Calls{ 0 };
+                std::atomic<bool> BadRange{ false }; // Check nao e thread-safe: junta aqui
+                Smile::ForEachChunk(_Jobs, Count, Grain, [&](u32 _Chunk, u32 _Begin, u32 _End) {
+                    ++Calls;
+                    if (_Begin != _Chunk * Grain || _End != std::min(Count, _Begin + Grain)) BadRange = true;
+                    for (u32 i = _Begin; i < _End; ++i) {
+                        Hits[i].fetch_add(1, std::memory_order_relaxed);
+                        ChunkOf[i] = _Chunk;
+                    }
+                });
+                bool Once = true;
+                for (u32 i = 0; i < Count; ++i) Once = Once && Hits[i].load() == 1 && ChunkOf[i] == i / Grain;
+                Check(Once, _Tag + ": item fora de exatamente um chunk (" + std::to_string(Count) + "/" +
+                                std::to_string(Grain) + ")");
+                Check(!BadRange.load(), _Tag + ": faixa fora da divisao fixa");
+                Check(Calls.load() == FJobSystem::ChunkCount(Count, Grain), _Tag + ": numero de chunks");
+            }
+        }
+    }
+
+    void TestGather(FJobSystem* _Jobs, const std::string& _Tag) {
+        const std::vector<FItem> Items = MakeItems(50003, 3);
+        std::vector<FItem> Expected;
+        for (const FItem& It : Items)
+            if (It.Dist < 20.0f) Expected.push_back(It);
+
+        std::vector<std::vector<FItem>> Scratch;
+        std::vector<FItem> Got{ { -1.0f, 0u } }; // lixo: tem de sumir
+        for (int Rep = 0; Rep < 3; ++Rep) { // reusa o scratch como o renderer entre frames
+            Smile::ParallelGather(_Jobs, static_cast<u32>(Items.size()), 1024, Scratch, Got,
+                                  [&](u32 _Begin, u32 _End, std::vector<FItem>& _Out) {
+                for (u32 i = _Begin; i < _End; ++i)
+                    if (Items[i].Dist < 20.0f) _Out.push_back(Items[i]);
+            });
+            Check(Got == Expected, _Tag + ": gather fora da ordem serial");
+        }
+    }
+
+    void TestSort(FJobSystem* _Jobs, const std::string& _Tag) {
+        for (const u32 Count : { 0u, 5u, 4096u, 4097u, 40000u, 100003u }) {
+            std::vector<FItem> Expected = MakeItems(Count, Count + 9);
+            std::vector<FItem> Got = Expected, Scratch;
+            std::sort(Expected.begin(), Expected.end(), ItemLess);
+            Smile::ParallelSort(_Jobs, Got, Scratch, ItemLess);
+            Check(Got == Expected, _Tag + ": sort difere do std::sort com " + std::to_string(Count) + " itens");
+            // Grao pequeno: muitas rodadas de merge, numero impar de faixas.
+            Got = MakeItems(Count, Count + 9);
+            Smile::ParallelSort(_Jobs, Got, Scratch, ItemLess, 333);
+            Check(Got == Expected, _Tag + ": sort com grao 333 difere com " + std::to_string(Count) + " itens");
+        }
+    }
+
+    void TestAninhado(FJobSystem& _Jobs) {
+        // ParallelFor dentro de um job roda inline na mesma divisao; nao pode travar o pool.
+        std::vector<u32> Sums(8, 0);
+        _Jobs.ParallelFor(8, 1, [&](u32 _Chunk, u32, u32) {
+            _Jobs.ParallelFor(100, 7, [&](u32, u32 _Begin, u32 _End) {
+                for (u32 i = _Begin; i < _End; ++i) Sums[_Chunk] += i;
+            });
+        });
+        Check(std::all_of(Sums.begin(), Sums.end(), [](u32 s) { return s == 4950u; }), "ParallelFor aninhado");
+    }
+
+    void Bench(FJobSystem& _Jobs, u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        const std::vector<FItem> Items = MakeItems(_Count, 77);
+        constexpr int kReps = 10;
+        auto Run = [&](FJobSystem* _J) {
+            std::vector<std::vector<FItem>> Chunks;
+            std::vector<FItem> Out, Scratch;
+            const auto T0 = Clock::now();
+            for (int r = 0; r < kReps; ++r) {
+                Smile::ParallelGather(_J, _Count, 1024, Chunks, Out, [&](u32 _Begin, u32 _End, std::vector<FItem>& _O) {
+                    for (u32 i = _Begin; i < _End; ++i)
+                        if (Items[i].Dist < 24.0f) _O.push_back(Items[i]);
+                });
+                Smile::ParallelSort(_J, Out, Scratch, ItemLess);
+            }
+            return std::chrono::duration<double, std::milli>(Clock::now() - T0).count() / kReps;
+        };
+        const double Serial = Run(nullptr);
+        const double Par    = Run(&_Jobs);
+        std::cout << "  bench " << _Count << " itens: serial " << Serial << " ms | " << _Jobs.ThreadCount()
+                  << " threads " << Par << " ms (" << Serial / Par << "x)\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.JobSystem\n";
+    TestCobertura(nullptr, "serial");
+    TestGather(nullptr, "serial");
+    TestSort(nullptr, "serial");
+    for (const u32 Workers : { 1u, 3u, 15u }) {
+        FJobSystem Jobs(Workers);
+        const std::string Tag = std::to_string(Workers) + " workers";
+        TestCobertura(&Jobs, Tag);
+        TestGather(&Jobs, Tag);
+        TestSort(&Jobs, Tag);
+        TestAninhado(Jobs);
+    }
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") {
+        FJobSystem Jobs;
+        for (const u32 Count : { 100000u, 1000000u }) Bench(Jobs, Count);
+    }
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
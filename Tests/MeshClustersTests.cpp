@@ -0,0 +1,204 @@
+// Contrato dos clusters da v10 (MeshClusters.h).
+//
+// Construcao: as faixas cobrem o IB em ordem, com 64-128 triangulos, e os limites contem de fato
+// cada vertice. Culling: descartar e uma PROMESSA — todo cluster rejeitado pelo frustum tem de
+// estar inteiro fora dele, e todo rejeitado pelo cone tem de ter so triangulos de costas para o
+// olho. Isso e conferido por forca bruta, triangulo a triangulo, numa esfera vista de varios
+// pontos e com transform de modelo (os clusters sao locais). E o culling tem de descartar algo.
+
+#include <cmath>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Scene/MeshClusters.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FTestMesh {
+        std::vector<Smile::Vertex> Vertices;
+        std::vector<Smile::u32>    Indices;
+    };
+
+    // Esfera UV com os quads emitidos em blocos de 8x8 (128 triangulos): a coesao espacial que o
+    // MeshOptimize da ao IB real, sem depender do cooker.
+    FTestMesh MakeSphere(Smile::u32 _Rings, Smile::u32 _Segments) {
+        FTestMesh M;
+        for (Smile::u32 R = 0; R <= _Rings; ++R)
+            for (Smile::u32 S = 0; S <= _Segments; ++S) {
+                const float Theta = 3.14159265f * float(R) / float(_Rings);
+                const float Phi   = 6.28318531f * float(S) / float(_Segments);
+                Smile::Vertex V{};
+                V.Position[0] = std::sin(Theta) * std::cos(Phi);
+                V.Position[1] = std::cos(Theta);
+                V.Position[2] = std::sin(Theta) * std::sin(Phi);
+                for (int A = 0; A < 3; ++A) V.Normal[A] = V.Position[A];
+                M.Vertices.push_back(V);
+            }
+        for (Smile::u32 BR = 0; BR < _Rings; BR += 8)
+            for (Smile::u32 BS = 0; BS < _Segments; BS += 8)
+                for (Smile::u32 R = BR; R < BR + 8 && R < _Rings; ++R)
+                    for (Smile::u32 S = BS; S < BS + 8 && S < _Segments; ++S) {
+                        const Smile::u32 A = R * (_Segments + 1) + S, B = A + 1, C = A + _Segments + 1, D = C + 1;
+                        M.Indices.insert(M.Indices.end(), { A, B, C, B, D, C });
+                    }
+        return M;
+    }
+
+    Smile::Vec4 Clip(const Smile::Mat44& _M, const float* _P) {
+        Smile::Vec4 Out{};
+        float* O = &Out.X;
+        for (int J = 0; J < 4; ++J)
+            O[J] = _P[0] * _M.M[0][J] + _P[1] * _M.M[1][J] + _P[2] * _M.M[2][J] + _M.M[3][J];
+        return Out;
+    }
+
+    bool InsideClip(const Smile::Vec4& _C) {
+        return _C.X >= -_C.W && _C.X <= _C.W && _C.Y >= -_C.W && _C.Y <= _C.W && _C.Z >= 0.0f && _C.Z <= _C.W;
+    }
+
+    void TestFaixasELimites() {
+        for (const Smile::u32 Segments : { 4u, 24u, 64u, 100u }) {
+            const FTestMesh M = MakeSphere(Segments / 2 + 1, Segments);
+            std::vector<Smile::SMeshCluster> Clusters;
+            Smile::BuildMeshClusters(M.Vertices, M.Indices, Clusters);
+
+            const Smile::u32 Triangles = Smile::u32(M.Indices.size() / 3);
+            Smile::u32 Next = 0;
+            bool Sizes = true, Bounds = true;
+            for (const Smile::SMeshCluster& C : Clusters) {
+                Check(C.FirstTriangle == Next, "faixa fora de ordem ou com buraco");
+                Next = C.FirstTriangle + C.TriangleCount;
+                Sizes &= C.TriangleCount <= Smile::kClusterMaxTriangles &&
+                         (Triangles < Smile::kClusterMinTriangles || C.TriangleCount >= Smile::kClusterMinTriangles);
+                for (Smile::u32 I = C.FirstTriangle * 3; I < Next * 3; ++I) {
+                    const float* P = M.Vertices[M.Indices[I]].Position;
+                    float D2 = 0.0f;
+                    for (int A = 0; A < 3; ++A) {
+                        Bounds &= P[A] >= C.AABBMin[A] && P[A] <= C.AABBMax[A];
+                        D2 += (P[A] - C.Center[A]) * (P[A] - C.Center[A]);
+                    }
+                    Bounds &= std::sqrt(D2) <= C.Radius * (1.0f + 1e-6f);
+                }
+            }
+            Check(Next == Triangles, "clusters nao cobrem o IB inteiro");
+            Check(Sizes, "cluster fora de 64-128 triangulos");
+            Check(Bounds, "vertice fora da AABB ou da esfera do proprio cluster");
+        }
+
+        std::vector<Smile::SMeshCluster> Empty(3);
+        Smile::BuildMeshClusters({}, {}, Empty);
+        Check(Empty.empty(), "mesh sem triangulos gerou clusters");
+    }
+
+    void TestCullingConservador() {
+        const FTestMesh M = MakeSphere(48, 96);
+        std::vector<Smile::SMeshCluster> Clusters;
+        Smile::BuildMeshClusters(M.Vertices, M.Indices, Clusters);
+
+        // Modelo com escala uniforme, rotacao e translacao; as cameras olham de fora, de dentro
+        // e de raspao (fov estreito) para exercitar os dois testes.
+        const Smile::Mat44 Model = Smile::Mat44::Scale({ 2.0f, 2.0f, 2.0f }) *
+                                   Smile::Mat44::RotationEulerXYZ({ 0.3f, 1.1f, -0.4f }) *
+                                   Smile::Mat44::Translation({ 10.0f, -3.0f, 4.0f });
+        const Smile::Mat44 ModelInverse = Model.Inverse();
+        struct FCamera {
+            Smile::Vec3 Eye, Target;
+            float       Fov;
+        };
+        const FCamera Cameras[] = {
+            { { 10.0f, -3.0f, -6.0f }, { 10.0f, -3.0f, 4.0f }, 1.0f },  // de frente, esfera inteira no quadro
+            { { 10.0f, -3.0f, -6.0f }, { 12.0f, -3.0f, 4.0f }, 0.25f }, // de raspao: metade fora
+            { { 20.0f, 5.0f, 4.0f }, { 10.0f, -3.0f, 4.0f }, 0.6f },
+            { { 10.2f, -3.0f, 4.1f }, { 10.0f, 5.0f, 4.0f }, 1.2f },    // dentro da esfera
+        };
+
+        Smile::FClusterCullStats Total;
+        for (const FCamera& Camera : Cameras) {
+            const Smile::Mat44 View = Smile::Mat44::LookAtLH(Camera.Eye, Camera.Target, { 0.0f, 1.0f, 0.0f });
+            const Smile::Mat44 Proj = Smile::Mat44::PerspectiveFovLH(Camera.Fov, 16.0f / 9.0f, 0.1f, 100.0f);
+            const Smile::Mat44 LocalToClip = Model * View * Proj;
+            const float EyeWorld[3] = { Camera.Eye.X, Camera.Eye.Y, Camera.Eye.Z };
+            const Smile::Vec4 EyeH = Clip(ModelInverse, EyeWorld);
+            const Smile::Vec3 EyeLocal{ EyeH.X / EyeH.W, EyeH.Y / EyeH.W, EyeH.Z / EyeH.W };
+            const Smile::FClusterCullView CullView = Smile::FClusterCullView::FromLocalToClip(LocalToClip, EyeLocal);
+
+            std::vector<Smile::u32> Visible;
+            Smile::FClusterCullStats Stats;
+            const Smile::u32 Passed = Smile::CullMeshClusters(Clusters, CullView, Visible, &Stats);
+            Check(Passed == Visible.size(), "contagem devolvida difere da lista");
+            Check(Stats.Tested == Clusters.size() && Stats.FrustumCulled + Stats.ConeCulled + Passed == Stats.Tested,
+                  "estatisticas nao fecham");
+
+            for (const Smile::SMeshCluster& C : Clusters) {
+                const bool Frustum = Smile::ClusterOutsideFrustum(C, CullView.Planes);
+                const bool Cone    = !Frustum && Smile::ClusterBackfacing(C, EyeLocal);
+                if (!Frustum && !Cone) continue;
+                for (Smile::u32 T = C.FirstTriangle; T < C.FirstTriangle + C.TriangleCount; ++T) {
+                    const float* P[3] = { M.Vertices[M.Indices[T * 3]].Position,
+                                          M.Vertices[M.Indices[T * 3 + 1]].Position,
+                                          M.Vertices[M.Indices[T * 3 + 2]].Position };
+                    if (Frustum) {
+                        // Vertices, pontos medios e centroide: nenhum ponto do triangulo no frustum.
+                        bool AnyInside = false;
+                        for (int A = 0; A < 3; ++A) {
+                            const float* Q = P[(A + 1) % 3];
+                            const float Mid[3] = { 0.5f * (P[A][0] + Q[0]), 0.5f * (P[A][1] + Q[1]),
+                                                   0.5f * (P[A][2] + Q[2]) };
+                            AnyInside |= InsideClip(Clip(LocalToClip, P[A])) || InsideClip(Clip(LocalToClip, Mid));
+                        }
+                        const float Centroid[3] = { (P[0][0] + P[1][0] + P[2][0]) / 3.0f,
+                                                    (P[0][1] + P[1][1] + P[2][1]) / 3.0f,
+                                                    (P[0][2] + P[1][2] + P[2][2]) / 3.0f };
+                        AnyInside |= InsideClip(Clip(LocalToClip, Centroid));
+                        Check(!AnyInside, "cluster descartado pelo frustum tem ponto dentro dele");
+                    } else {
+                        const Smile::Vec3 A{ P[0][0], P[0][1], P[0][2] };
+                        const Smile::Vec3 E1 = Smile::Vec3{ P[1][0], P[1][1], P[1][2] } - A;
+                        const Smile::Vec3 E2 = Smile::Vec3{ P[2][0], P[2][1], P[2][2] } - A;
+                        const Smile::Vec3 N = E1.Cross(E2);
+                        const Smile::Vec3 ToTriangle = A - EyeLocal;
+                        Check(N.Dot(ToTriangle) >= -1e-5f * N.Length() * ToTriangle.Length(),
+                              "cluster descartado pelo cone tem triangulo de frente para o olho");
+                    }
+                }
+            }
+            Total.Tested += Stats.Tested;
+            Total.FrustumCulled += Stats.FrustumCulled;
+            Total.ConeCulled += Stats.ConeCulled;
+        }
+        Check(Total.FrustumCulled > 0, "nenhum cluster descartado pelo frustum");
+        Check(Total.ConeCulled > 0, "nenhum cluster descartado pelo cone");
+
+        // Material two-sided: o cone nao vale.
+        const Smile::Mat44 LocalToClip = Smile::Mat44::LookAtLH({ 0.0f, 0.0f, -5.0f }, {}, { 0.0f, 1.0f, 0.0f }) *
+                                         Smile::Mat44::PerspectiveFovLH(1.0f, 1.0f, 0.1f, 100.0f);
+        std::vector<Smile::u32> Visible;
+        Smile::FClusterCullStats Stats;
+        Smile::CullMeshClusters(Clusters, Smile::FClusterCullView::FromLocalToClip(LocalToClip, { 0.0f, 0.0f, -5.0f },
+                                                                                    false),
+                                Visible, &Stats);
+        Check(Stats.ConeCulled == 0 && Visible.size() == Clusters.size(), "two-sided descartou pelo cone");
+    }
+}
+
+int main() {
+    std::cout << "Smile.MeshClusters\n";
+    TestFaixasELimites();
+    TestCullingConservador();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
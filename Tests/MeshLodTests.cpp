@@ -0,0 +1,249 @@
+// Contrato da cadeia de LODs da v11 (MeshLod.h).
+//
+// Construcao: cada nivel reduz de fato, aponta so para vertices do VB original, nao tem triangulo
+// degenerado nem virado, e o erro nao decresce. Vertices de costura e de borda sobrevivem a todos
+// os niveis (a silhueta e as ilhas de UV nao se mexem). Plano subdividido simplifica com erro
+// zero; esfera, com erro positivo. A saida e deterministica.
+//
+// Escolha: LOD0 de perto, o mais grosso de longe, e nunca mais fino ao afastar, abrir o fov ou
+// encolher a instancia.
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Math/Vec3.h"
+#include "Smile/Scene/MeshLod.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FTestMesh {
+        std::vector<Smile::Vertex> Vertices;
+        std::vector<Smile::u32>    Indices;
+    };
+
+    // Esfera UV: a coluna S = 0 e a S = Segments tem a mesma posicao com U diferente (costura), e
+    // cada polo e um anel de vertices na mesma posicao (o triangulo que seria degenerado la nao entra).
+    FTestMesh MakeSphere(Smile::u32 _Rings, Smile::u32 _Segments) {
+        FTestMesh M;
+        for (Smile::u32 R = 0; R <= _Rings; ++R)
+            for (Smile::u32 S = 0; S <= _Segments; ++S) {
+                const float Theta = 3.14159265f * float(R) / float(_Rings);
+                const float Phi   = 6.28318531f * float(S) / float(_Segments);
+                Smile::Vertex V{};
+                V.Position[0] = std::sin(Theta) * std::cos(Phi);
+                V.Position[1] = std::cos(Theta);
+                V.Position[2] = std::sin(Theta) * std::sin(Phi);
+                if (S == _Segments) V.Position[0] = std::sin(Theta), V.Position[2] = 0.0f; // fecha a costura
+                if (R == 0 || R == _Rings) V.Position[0] = V.Position[2] = 0.0f;           // polo unico
+                for (int A = 0; A < 3; ++A) V.Normal[A] = V.Position[A];
+                V.TexCoord[0] = float(S) / float(_Segments);
+                V.TexCoord[1] = float(R) / float(_Rings);
+                M.Vertices.push_back(V);
+            }
+        for (Smile::u32 R = 0; R < _Rings; ++R)
+            for (Smile::u32 S = 0; S < _Segments; ++S) {
+                const Smile::u32 A = R * (_Segments + 1) + S, B = A + 1, C = A + _Segments + 1, D = C + 1;
+                if (R > 0) M.Indices.insert(M.Indices.end(), { A, B, C });
+                if (R + 1 < _Rings) M.Indices.insert(M.Indices.end(), { B, D, C });
+            }
+        return M;
+    }
+
+    FTestMesh MakePlane(Smile::u32 _N) {
+        FTestMesh M;
+        for (Smile::u32 Y = 0; Y <= _N; ++Y)
+            for (Smile::u32 X = 0; X <= _N; ++X) {
+                Smile::Vertex V{};
+                V.Position[0] = float(X);
+                V.Position[2] = float(Y);
+                V.Normal[1]   = 1.0f;
+                M.Vertices.push_back(V);
+            }
+        for (Smile::u32 Y = 0; Y < _N; ++Y)
+            for (Smile::u32 X = 0; X < _N; ++X) {
+                const Smile::u32 A = Y * (_N + 1) + X, B = A + 1, C = A + _N + 1, D = C + 1;
+                M.Indices.insert(M.Indices.end(), { A, C, B, B, C, D });
+            }
+        return M;
+    }
+
+    Smile::Vec3 At(const FTestMesh& _M, Smile::u32 _I) {
+        const float* P = _M.Vertices[_I].Position;
+        return { P[0], P[1], P[2] };
+    }
+
+    Smile::Vec3 NormalAt(const FTestMesh& _M, Smile::u32 _I) {
+        const float* N = _M.Vertices[_I].Normal;
+        return { N[0], N[1], N[2] };
+    }
+
+    // Sinal da face contra a media das normais de vertice (as duas malhas de teste as tem
+    // apontando para fora); 0 = area nula.
+    int FaceSign(const FTestMesh& _M, Smile::u32 _A, Smile::u32 _B, Smile::u32 _C) {
+        const Smile::Vec3 N = (At(_M, _B) - At(_M, _A)).Cross(At(_M, _C) - At(_M, _A));
+        const float D = N.Dot(NormalAt(_M, _A) + NormalAt(_M, _B) + NormalAt(_M, _C));
+        return D > 0.0f ? 1 : D < 0.0f ? -1 : 0;
+    }
+
+    // Vertices que nao podem sumir: posicao repetida no VB (costura) ou ponta de aresta sem a
+    // oposta (borda). As arestas sao comparadas por POSICAO, como no simplificador: o leque do polo
+    // usa um indice por triangulo e nem por isso e borda.
+    std::vector<bool> PinnedVertices(const FTestMesh& _M) {
+        std::vector<bool>       Pinned(_M.Vertices.size(), false);
+        std::vector<Smile::u32> Canonical(_M.Vertices.size());
+        for (size_t A = 0; A < _M.Vertices.size(); ++A) {
+            Canonical[A] = Smile::u32(A);
+            for (size_t B = 0; B < A; ++B)
+                if (std::memcmp(_M.Vertices[A].Position, _M.Vertices[B].Position, sizeof(float) * 3) == 0) {
+                    Canonical[A] = Canonical[B];
+                    Pinned[A] = Pinned[B] = true;
+                    break;
+                }
+        }
+        std::set<std::pair<Smile::u32, Smile::u32>> Edges;
+        for (size_t T = 0; T < _M.Indices.size(); T += 3)
+            for (size_t E = 0; E < 3; ++E)
+                Edges.insert({ Canonical[_M.Indices[T + E]], Canonical[_M.Indices[T + (E + 1) % 3]] });
+        for (const auto& [A, B] : Edges)
+            if (!Edges.count({ B, A })) Pinned[A] = Pinned[B] = true;
+        return Pinned;
+    }
+
+    void CheckChain(const FTestMesh& _M, const std::vector<Smile::SMeshLod>& _Levels,
+                    const std::vector<Smile::u32>& _Indices, std::string_view _Name) {
+        const std::vector<bool> Pinned = PinnedVertices(_M);
+        const int Sign = FaceSign(_M, _M.Indices[0], _M.Indices[1], _M.Indices[2]);
+        Smile::u32 PreviousTriangles = Smile::u32(_M.Indices.size() / 3);
+        float      PreviousError     = 0.0f;
+        Smile::u32 Next              = 0;
+        for (const Smile::SMeshLod& L : _Levels) {
+            const std::string Name = std::string(_Name) + " LOD" + std::to_string(&L - _Levels.data() + 1);
+            const Smile::u32 Triangles = L.IndexCount / 3;
+            Check(L.FirstIndex == Next && L.IndexCount % 3 == 0, Name + ": faixa de indices fora de ordem");
+            Check(Triangles > 0 && Triangles <= PreviousTriangles * 0.85f, Name + ": nivel nao reduziu");
+            Check(L.Error >= PreviousError, Name + ": erro decresceu");
+            Next              = L.FirstIndex + L.IndexCount;
+            PreviousTriangles = Triangles;
+            PreviousError     = L.Error;
+            if (Next > _Indices.size()) break;
+
+            bool InRange = true, Oriented = true;
+            std::vector<bool> Used(_M.Vertices.size(), false);
+            for (Smile::u32 I = L.FirstIndex; I < Next && InRange; I += 3) {
+                const Smile::u32 A = _Indices[I], B = _Indices[I + 1], C = _Indices[I + 2];
+                InRange = A < _M.Vertices.size() && B < _M.Vertices.size() && C < _M.Vertices.size();
+                if (!InRange) break;
+                Used[A] = Used[B] = Used[C] = true;
+                Oriented &= FaceSign(_M, A, B, C) == Sign;
+            }
+            Check(InRange, Name + ": indice fora do VB");
+            Check(Oriented, Name + ": triangulo degenerado ou virado");
+            // Um vertice travado pode sair do IB quando todos os triangulos dele colapsam (o anel
+            // do polo), mas a POSICAO dele continua la: quem chega nela e um vizinho que colapsou.
+            auto Key = [&](size_t _V) { return std::array<float, 3>{ At(_M, Smile::u32(_V)).X, At(_M, Smile::u32(_V)).Y,
+                                                                     At(_M, Smile::u32(_V)).Z }; };
+            std::set<std::array<float, 3>> UsedPositions;
+            for (size_t V = 0; V < _M.Vertices.size(); ++V)
+                if (Used[V]) UsedPositions.insert(Key(V));
+            bool PinnedKept = true;
+            for (size_t V = 0; V < _M.Vertices.size(); ++V) PinnedKept &= !Pinned[V] || UsedPositions.count(Key(V));
+            Check(PinnedKept, Name + ": vertice de costura/borda sumiu");
+        }
+        Check(Next == _Indices.size(), std::string(_Name) + ": indices sobrando ou faltando");
+    }
+
+    void TestEsfera() {
+        const FTestMesh M = MakeSphere(24, 48);
+        std::vector<Smile::SMeshLod> Levels;
+        std::vector<Smile::u32>      Indices;
+        Smile::BuildMeshLods(M.Vertices, M.Indices, Levels, Indices);
+        Check(Levels.size() >= 2, "esfera gerou menos de 2 niveis");
+        Check(!Levels.empty() && Levels[0].IndexCount / 3 <= M.Indices.size() / 3 / 2 + 16,
+              "LOD1 longe do alvo de 1/2");
+        Check(!Levels.empty() && Levels[0].Error > 1e-4f && Levels.back().Error < 0.5f, "erro da esfera implausivel");
+        CheckChain(M, Levels, Indices, "esfera");
+
+        std::vector<Smile::SMeshLod> Again;
+        std::vector<Smile::u32>      AgainIndices;
+        Smile::BuildMeshLods(M.Vertices, M.Indices, Again, AgainIndices);
+        bool Same = Again.size() == Levels.size() && AgainIndices == Indices;
+        for (size_t I = 0; Same && I < Levels.size(); ++I) Same = Again[I].Error == Levels[I].Error;
+        Check(Same, "construcao nao deterministica");
+    }
+
+    void TestPlano() {
+        const FTestMesh M = MakePlane(32);
+        std::vector<Smile::SMeshLod> Levels;
+        std::vector<Smile::u32>      Indices;
+        Smile::BuildMeshLods(M.Vertices, M.Indices, Levels, Indices);
+        Check(!Levels.empty(), "plano nao simplificou");
+        bool Flat = true;
+        for (const Smile::SMeshLod& L : Levels) Flat &= L.Error < 1e-6f;
+        Check(Flat, "plano simplificou com erro");
+        CheckChain(M, Levels, Indices, "plano");
+
+        // Mesh pequeno demais e IB invalido nao geram nada.
+        const FTestMesh Small = MakePlane(4);
+        Smile::BuildMeshLods(Small.Vertices, Small.Indices, Levels, Indices);
+        Check(Levels.empty() && Indices.empty(), "mesh abaixo de MinTriangles gerou niveis");
+        std::vector<Smile::u32> Broken = M.Indices;
+        Broken[7] = Smile::u32(M.Vertices.size());
+        Smile::BuildMeshLods(M.Vertices, Broken, Levels, Indices);
+        Check(Levels.empty(), "IB com indice fora do VB gerou niveis");
+    }
+
+    void TestEscolha() {
+        const std::vector<Smile::SMeshLod> Levels = {
+            { 0, 300, 0.01f, 0 }, { 300, 150, 0.05f, 0 }, { 450, 60, 0.2f, 0 },
+        };
+        const float Fov = 1.0f;
+        Check(Smile::SelectMeshLod(Levels, 0.5f, Fov) == 0, "de perto nao escolheu o LOD0");
+        Check(Smile::SelectMeshLod(Levels, 1e5f, Fov) == 3, "de longe nao escolheu o mais grosso");
+        Check(Smile::SelectMeshLod({}, 1e5f, Fov) == 0, "sem niveis escolheu algo alem do LOD0");
+
+        // Exatamente no limiar do LOD2: erro projetado == maximo.
+        const float Threshold = 0.05f / (2.0f * std::tan(0.5f * Fov) * Smile::kMeshLodDefaultScreenError);
+        Check(Smile::SelectMeshLod(Levels, Threshold * 1.001f, Fov) == 2, "limiar do LOD2 errado");
+        Check(Smile::SelectMeshLod(Levels, Threshold * 0.999f, Fov) == 1, "abaixo do limiar do LOD2 errado");
+
+        bool Monotonic = true;
+        Smile::u32 Previous = 0;
+        for (float D = 0.1f; D < 1e4f; D *= 1.1f) {
+            const Smile::u32 Lod = Smile::SelectMeshLod(Levels, D, Fov);
+            Monotonic &= Lod >= Previous;
+            Monotonic &= Smile::SelectMeshLod(Levels, D, Fov * 1.5f) >= Lod;      // fov aberto
+            Monotonic &= Smile::SelectMeshLod(Levels, D, Fov, 0.5f) >= Lod;       // instancia menor
+            Monotonic &= Smile::SelectMeshLod(Levels, D, Fov, 1.0f, 1e-2f) >= Lod; // tolerancia maior
+            Previous = Lod;
+        }
+        Check(Monotonic, "escolha nao e monotonica");
+    }
+}
+
+int main() {
+    std::cout << "Smile.MeshLod\n";
+    TestEsfera();
+    TestPlano();
+    TestEscolha();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
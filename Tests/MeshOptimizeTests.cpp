@@ -0,0 +1,158 @@
+// Contrato da otimizacao pos-weld do cooker (Tools/Cooker/MeshOptimize.h).
+//
+// O passo so pode REORDENAR: o conjunto de triangulos (com o winding de cada um), os vertices e
+// o que cada indice aponta tem de sair iguais, so em outra ordem. E tem de valer a pena: numa
+// grade embaralhada o ACMR cai perto do limite de 1/2 e o VB sai na ordem do primeiro uso.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "MeshOptimize.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FGrid {
+        std::vector<Smile::Vertex> Vertices;
+        std::vector<Smile::u32>    Indices;
+    };
+
+    // Grade N x N de quads com o triangulo e o VB embaralhados: a ordem que um FBX real costuma
+    // entregar depois do weld nao e tao ruim, mas assim o ganho e inequivoco.
+    FGrid MakeShuffledGrid(Smile::u32 _N, Smile::u32 _Seed) {
+        FGrid G;
+        for (Smile::u32 Y = 0; Y <= _N; ++Y)
+            for (Smile::u32 X = 0; X <= _N; ++X) {
+                Smile::Vertex V{};
+                V.Position[0] = float(X);
+                V.Position[2] = float(Y);
+                V.Normal[1]   = 1.0f;
+                V.TexCoord[0] = float(X) / float(_N);
+                V.TexCoord[1] = float(Y) / float(_N);
+                G.Vertices.push_back(V);
+            }
+        std::vector<std::array<Smile::u32, 3>> Tris;
+        for (Smile::u32 Y = 0; Y < _N; ++Y)
+            for (Smile::u32 X = 0; X < _N; ++X) {
+                const Smile::u32 A = Y * (_N + 1) + X, B = A + 1, C = A + _N + 1, D = C + 1;
+                Tris.push_back({ A, C, B });
+                Tris.push_back({ B, C, D });
+            }
+        std::mt19937 Rng(_Seed);
+        std::shuffle(Tris.begin(), Tris.end(), Rng);
+
+        std::vector<Smile::u32> Perm(G.Vertices.size());
+        for (Smile::u32 I = 0; I < Perm.size(); ++I) Perm[I] = I;
+        std::shuffle(Perm.begin(), Perm.end(), Rng);
+        std::vector<Smile::Vertex> Shuffled(G.Vertices.size());
+        for (Smile::u32 I = 0; I < Perm.size(); ++I) Shuffled[Perm[I]] = G.Vertices[I];
+        G.Vertices.swap(Shuffled);
+        for (const auto& T : Tris)
+            for (const Smile::u32 V : T) G.Indices.push_back(Perm[V]);
+        return G;
+    }
+
+    // Triangulo como tres vertices (por valor), rotacionado para comecar no menor: mesma chave
+    // para a mesma face com o mesmo winding, qualquer que seja o canto inicial ou o indice.
+    using FTriKey = std::array<std::array<float, 8>, 3>;
+
+    std::vector<FTriKey> TriangleSet(const FGrid& _G) {
+        std::vector<FTriKey> Keys;
+        for (size_t T = 0; T + 2 < _G.Indices.size(); T += 3) {
+            FTriKey K;
+            for (Smile::u32 C = 0; C < 3; ++C)
+                std::memcpy(K[C].data(), &_G.Vertices[_G.Indices[T + C]], sizeof(Smile::Vertex));
+            const auto Min = std::min_element(K.begin(), K.end());
+            std::rotate(K.begin(), Min, K.end());
+            Keys.push_back(K);
+        }
+        std::sort(Keys.begin(), Keys.end());
+        return Keys;
+    }
+
+    void TestSoReordena() {
+        const FGrid Original = MakeShuffledGrid(24, 7);
+        FGrid G = Original;
+        const Smile::Cooker::FMeshOptimizeStats Stats = Smile::Cooker::OptimizeMesh(G.Vertices, G.Indices);
+
+        Check(G.Vertices.size() == Original.Vertices.size(), "contagem de vertices mudou");
+        Check(G.Indices.size() == Original.Indices.size(), "contagem de indices mudou");
+        Check(TriangleSet(G) == TriangleSet(Original), "conjunto de triangulos (ou winding) mudou");
+        Check(Stats.Clusters >= 1, "nenhum cluster registrado");
+
+        auto SortedBytes = [](const std::vector<Smile::Vertex>& _V) {
+            std::vector<std::array<float, 8>> Out(_V.size());
+            for (size_t I = 0; I < _V.size(); ++I) std::memcpy(Out[I].data(), &_V[I], sizeof(Smile::Vertex));
+            std::sort(Out.begin(), Out.end());
+            return Out;
+        };
+        Check(SortedBytes(G.Vertices) == SortedBytes(Original.Vertices), "VB nao e permutacao do original");
+    }
+
+    void TestCacheMelhora() {
+        FGrid G = MakeShuffledGrid(64, 11);
+        const Smile::Cooker::FMeshOptimizeStats Stats = Smile::Cooker::OptimizeMesh(G.Vertices, G.Indices);
+
+        Check(Stats.Before.Triangles == 64u * 64u * 2u, "relatorio contou triangulos errado");
+        Check(Stats.Before.ACMR() > 2.0, "grade embaralhada deveria comecar quase sem reuso");
+        Check(Stats.After.ACMR() < 0.8, "ACMR depois do Tipsify longe do limite de 1/2");
+        Check(Stats.After.ATVR() < 1.5, "ATVR depois do Tipsify alto demais");
+
+        const Smile::Cooker::FVertexCacheStats Again =
+            Smile::Cooker::AnalyzeVertexCache(G.Indices, static_cast<Smile::u32>(G.Vertices.size()));
+        Check(Again.Misses == Stats.After.Misses, "relatorio After nao bate com o IB devolvido");
+
+        // Fetch: o primeiro uso de cada vertice aparece em ordem crescente.
+        Smile::u32 Next = 0;
+        bool Sequential = true;
+        for (const Smile::u32 V : G.Indices) {
+            if (V > Next) Sequential = false;
+            if (V == Next) ++Next;
+        }
+        Check(Sequential, "VB fora da ordem de primeiro uso");
+    }
+
+    void TestCasosDegenerados() {
+        std::vector<Smile::Vertex> Vertices(3);
+        std::vector<Smile::u32>    Indices;
+        Smile::Cooker::OptimizeMesh(Vertices, Indices);
+        Check(Indices.empty() && Vertices.size() == 3, "malha sem triangulos foi alterada");
+
+        // Vertice solto (nenhum triangulo o usa) vai para o fim; triangulo degenerado sobrevive.
+        Vertices.resize(5);
+        for (Smile::u32 I = 0; I < 5; ++I) Vertices[I].Position[0] = float(I);
+        Indices = { 4, 2, 1, 2, 2, 4 };
+        Smile::Cooker::OptimizeMesh(Vertices, Indices);
+        Check(Indices.size() == 6, "triangulo degenerado sumiu");
+        Check(Vertices.size() == 5, "vertice solto sumiu");
+        Check(Vertices[3].Position[0] == 0.0f && Vertices[4].Position[0] == 3.0f,
+              "vertices soltos nao foram para o fim na ordem original");
+        for (const Smile::u32 V : Indices) Check(V < 3, "indice aponta para vertice solto");
+    }
+}
+
+int main() {
+    std::cout << "Smile.MeshOptimize\n";
+    TestSoReordena();
+    TestCacheMelhora();
+    TestCasosDegenerados();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
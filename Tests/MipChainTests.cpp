@@ -0,0 +1,214 @@
+// Kernels da mip chain (Smile/Graphics/Resources/MipChain.h).
+//
+// O contrato: as vias SSE4.1 e AVX2 dao a MESMA saida, byte a byte, que a escalar — em cor sRGB e
+// linear, em normal map (incluindo o alfa Toksvig e a media devolvida), em qualquer tamanho
+// (impar, 1xN, Nx1, com cauda que nao fecha um bloco). Mais alguns valores fixos da escalar, para
+// que ela mesma nao mude sem ninguem ver. Numa CPU sem AVX2 a via pedida cai na melhor abaixo, e
+// o teste continua valido (so compara menos).
+//
+// `SmileMipChainTests --bench` mede a mip chain inteira de uma textura 2048x2048 em cada via.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Graphics/Resources/MipChain.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::u8;
+    using Smile::EMipPath;
+
+    constexpr EMipPath kPaths[] = { EMipPath::Scalar, EMipPath::SSE41, EMipPath::AVX2 };
+
+    std::vector<u8> Noise(u32 _W, u32 _H, std::mt19937& _Rng) {
+        std::vector<u8> P(static_cast<size_t>(_W) * _H * 4);
+        for (u8& b : P) b = static_cast<u8>(_Rng());
+        return P;
+    }
+
+    // Normais de verdade (z para fora), com um punhado de pares opostos e texels nulos: o caso
+    // que se anula no 2x2 e o caso sem comprimento.
+    std::vector<u8> NormalNoise(u32 _W, u32 _H, std::mt19937& _Rng) {
+        std::vector<u8> P(static_cast<size_t>(_W) * _H * 4);
+        std::uniform_real_distribution<f32> U(-1.0f, 1.0f);
+        for (size_t i = 0; i < P.size(); i += 4) {
+            const u32 Kind = _Rng() % 16;
+            if (Kind == 0) {
+                P[i] = P[i + 1] = P[i + 2] = 128; // quase zero depois do remap
+            } else if (Kind == 1) {
+                P[i] = P[i + 1] = P[i + 2] = 255;
+            } else if (Kind == 2) {
+                P[i] = P[i + 1] = P[i + 2] = 0;
+            } else {
+                f32 x = U(_Rng) * 0.7f, y = U(_Rng) * 0.7f;
+                const f32 z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+                P[i]     = static_cast<u8>((x * 0.5f + 0.5f) * 255.0f + 0.5f);
+                P[i + 1] = static_cast<u8>((y * 0.5f + 0.5f) * 255.0f + 0.5f);
+                P[i + 2] = static_cast<u8>((z * 0.5f + 0.5f) * 255.0f + 0.5f);
+            }
+            P[i + 3] = static_cast<u8>(_Rng());
+        }
+        return P;
+    }
+
+    std::string SizeName(u32 _W, u32 _H) { return std::to_string(_W) + "x" + std::to_string(_H); }
+
+    // Valores fixos da via escalar.
+    void TestValoresFixos() {
+        // 2x2 de preto e branco em sRGB: 0.5 linear = 188, nao os 127 da media de bytes.
+        const u8 Src[16] = { 0, 0, 0, 0,   255, 255, 255, 255,   0, 0, 0, 0,   255, 255, 255, 255 };
+        for (const EMipPath Path : kPaths) {
+            u8 D[4] = {};
+            Smile::DownsampleColor2x2(Src, 2, 2, D, 1, 1, true, Path);
+            Check(D[0] == 188 && D[1] == 188 && D[2] == 188, std::string("fixo: sRGB 0/255 em ") + Smile::MipPathName(Path));
+            Check(D[3] == 128, "fixo: alfa passou por conversao");
+            Smile::DownsampleColor2x2(Src, 2, 2, D, 1, 1, false, Path);
+            Check(D[0] == 128 && D[3] == 128, "fixo: media linear de 0/255");
+        }
+
+        // Normal reta (0, 0, 1) = (128, 128, 255): mantem, comprimento medio ~1.
+        const u8 N[16] = { 128, 128, 255, 0,  128, 128, 255, 0,  128, 128, 255, 0,  128, 128, 255, 0 };
+        u8 D[4] = {};
+        const f32 T = Smile::DownsampleNormal2x2(N, 2, 2, D, 1, 1, EMipPath::Scalar);
+        Check(D[0] == 128 && D[1] == 128 && D[2] == 255 && D[3] == 255, "fixo: normal reta mudou");
+        Check(std::fabs(T - 1.0f) < 1e-3f, "fixo: Toksvig da normal reta");
+
+        // (1, 1, 1) e (-1, -1, -1) se anulam: sumLen 0, RGB do NaN = 0 e alfa no piso.
+        const u8 C[16] = { 255, 255, 255, 0,  0, 0, 0, 0,  255, 255, 255, 0,  0, 0, 0, 0 };
+        for (const EMipPath Path : kPaths) {
+            Smile::DownsampleNormal2x2(C, 2, 2, D, 1, 1, Path);
+            Check(D[0] == 0 && D[1] == 0 && D[2] == 0 && D[3] == 0,
+                  std::string("fixo: par oposto em ") + Smile::MipPathName(Path));
+        }
+    }
+
+    // O linear -> sRGB por baldes das vias SIMD contra a busca binaria, em torno de cada ponto
+    // medio (onde um erro de balde apareceria) e no intervalo todo.
+    void TestCodificacaoSrgb() {
+        const f32* Lin = Smile::SrgbToLinearLUT();
+        bool Ok = true;
+        for (int i = 0; i < 255; ++i) {
+            const f32 Mid = 0.5f * (Lin[i] + Lin[i + 1]);
+            Ok = Ok && Smile::LinearToSrgbU8(std::nextafter(Mid, 0.0f)) == i;
+            Ok = Ok && Smile::LinearToSrgbU8(Mid) == i + 1;
+            Ok = Ok && Smile::LinearToSrgbU8(Lin[i]) == i;
+        }
+        Ok = Ok && Smile::LinearToSrgbU8(0.0f) == 0 && Smile::LinearToSrgbU8(1.0f) == 255;
+        Check(Ok, "sRGB: referencia escalar fora do ponto medio");
+
+        // Ruido em sRGB exercita o codificador SIMD em valores L arbitrarios; a via escalar e a
+        // referencia.
+        std::mt19937 Rng(11);
+        const u32 W = 64, H = 2;
+        std::vector<u8> Src(W * H * 4), Ref(W / 2 * 4), Out(W / 2 * 4);
+        bool Same = true;
+        for (int Round = 0; Round < 2000; ++Round) {
+            for (u8& b : Src) b = static_cast<u8>(Rng());
+            Smile::DownsampleColor2x2(Src.data(), W, H, Ref.data(), W / 2, 1, true, EMipPath::Scalar);
+            for (const EMipPath Path : { EMipPath::SSE41, EMipPath::AVX2 }) {
+                Smile::DownsampleColor2x2(Src.data(), W, H, Out.data(), W / 2, 1, true, Path);
+                Same = Same && Out == Ref;
+            }
+        }
+        Check(Same, "sRGB: codificador por baldes diverge da busca binaria");
+    }
+
+    void TestVias() {
+        std::mt19937 Rng(5);
+        const u32 Sizes[][2] = { { 1, 1 }, { 1, 37 }, { 53, 1 }, { 2, 2 }, { 3, 5 }, { 16, 16 }, { 17, 9 },
+                                 { 33, 33 }, { 64, 7 }, { 257, 129 }, { 100, 61 } };
+        for (const auto& S : Sizes) {
+            const u32 W = S[0], H = S[1];
+            const u32 DW = std::max(1u, W / 2), DH = std::max(1u, H / 2);
+            const std::vector<u8> Color  = Noise(W, H, Rng);
+            const std::vector<u8> Normal = NormalNoise(W, H, Rng);
+            for (const bool Srgb : { true, false }) {
+                std::vector<u8> Ref(static_cast<size_t>(DW) * DH * 4);
+                Smile::DownsampleColor2x2(Color.data(), W, H, Ref.data(), DW, DH, Srgb, EMipPath::Scalar);
+                for (const EMipPath Path : kPaths) {
+                    std::vector<u8> Out(Ref.size(), 0xCD);
+                    Smile::DownsampleColor2x2(Color.data(), W, H, Out.data(), DW, DH, Srgb, Path);
+                    Check(Out == Ref, std::string("cor ") + (Srgb ? "sRGB " : "linear ") + SizeName(W, H) +
+                                          " em " + Smile::MipPathName(Path));
+                }
+            }
+            std::vector<u8> Ref(static_cast<size_t>(DW) * DH * 4);
+            const f32 RefT = Smile::DownsampleNormal2x2(Normal.data(), W, H, Ref.data(), DW, DH, EMipPath::Scalar);
+            for (const EMipPath Path : kPaths) {
+                std::vector<u8> Out(Ref.size(), 0xCD);
+                const f32 T = Smile::DownsampleNormal2x2(Normal.data(), W, H, Out.data(), DW, DH, Path);
+                Check(Out == Ref, "normal " + SizeName(W, H) + " em " + Smile::MipPathName(Path));
+                Check(std::memcmp(&T, &RefT, sizeof(f32)) == 0,
+                      "normal: media Toksvig " + SizeName(W, H) + " em " + Smile::MipPathName(Path));
+            }
+        }
+    }
+
+    void Bench() {
+        using Clock = std::chrono::steady_clock;
+        const u32 Size = 2048;
+        std::mt19937 Rng(9);
+        const std::vector<u8> Color  = Noise(Size, Size, Rng);
+        const std::vector<u8> Normal = NormalNoise(Size, Size, Rng);
+        std::vector<u8> A(Color.size()), B(Color.size());
+        std::cout << "  melhor via desta CPU: " << Smile::MipPathName(Smile::DetectMipPath()) << '\n';
+
+        for (const EMipPath Path : kPaths) {
+            for (int Kind = 0; Kind < 3; ++Kind) { // 0 = sRGB, 1 = linear, 2 = normal
+                double Best = 1e30;
+                u32 Pixels = 0;
+                for (int Rep = 0; Rep < 5; ++Rep) {
+                    std::memcpy(A.data(), Kind == 2 ? Normal.data() : Color.data(), A.size());
+                    u32 W = Size, H = Size;
+                    Pixels = 0;
+                    const auto T0 = Clock::now();
+                    while (W > 1 || H > 1) {
+                        const u32 NW = std::max(1u, W / 2), NH = std::max(1u, H / 2);
+                        if (Kind == 2) Smile::DownsampleNormal2x2(A.data(), W, H, B.data(), NW, NH, Path);
+                        else           Smile::DownsampleColor2x2(A.data(), W, H, B.data(), NW, NH, Kind == 0, Path);
+                        Pixels += W * H;
+                        std::swap(A, B);
+                        W = NW;
+                        H = NH;
+                    }
+                    Best = std::min(Best, std::chrono::duration<double, std::milli>(Clock::now() - T0).count());
+                }
+                static const char* Names[] = { "cor sRGB", "cor linear", "normal" };
+                std::cout << "  " << Smile::MipPathName(Path) << " " << Names[Kind] << ": " << Best << " ms ("
+                          << Pixels / (Best * 1000.0) << " MPix/s de fonte)\n";
+            }
+        }
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.MipChain\n";
+    TestValoresFixos();
+    TestCodificacaoSrgb();
+    TestVias();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
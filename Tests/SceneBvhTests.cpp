@@ -0,0 +1,306 @@
+// BVH de CPU da cena (Smile/Scene/SceneBvh.h) contra as varreduras lineares.
+//
+// O contrato: frustum e esfera devolvem EXATAMENTE a lista do CullFrustums/CullSphere sobre as
+// mesmas caixas; o raio devolve a caixa de menor entrada (empate pelo menor indice); o k-vizinhos
+// devolve os K de menor distancia ponto-caixa, empate pelo indice. Vale depois do Build, depois do
+// refit parcial (so os indices que andaram) e depois do refit inteiro.
+//
+// `SmileSceneBvhTests --bench` mede 100k caixas: build, refit e cada consulta contra a varredura.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Smile/Scene/SceneBvh.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::Vec3;
+    using Smile::Mat44;
+    using Smile::FCullBounds;
+    using Smile::FCullFrustum;
+    using Smile::FSceneBvh;
+
+    struct FBoxes {
+        std::vector<Vec3> Min, Max;
+        FCullBounds       Soa;
+
+        void SyncSoa() {
+            Soa.Clear();
+            for (size_t i = 0; i < Min.size(); ++i) Soa.Push(Min[i], Max[i]);
+        }
+    };
+
+    // Cidade: muitos objetos pequenos, alguns enormes (terreno, predio) e alguns pontos.
+    FBoxes MakeBoxes(u32 _Count, u32 _Seed) {
+        std::mt19937 Rng(_Seed);
+        std::uniform_real_distribution<f32> Pos(-800.0f, 800.0f), Half(0.05f, 4.0f);
+        FBoxes B;
+        B.Min.resize(_Count);
+        B.Max.resize(_Count);
+        for (u32 i = 0; i < _Count; ++i) {
+            const Vec3 C{ Pos(Rng), Pos(Rng) * 0.05f, Pos(Rng) };
+            const f32 H = i % 97 == 5 ? 0.0f : (i % 1009 == 3 ? 400.0f : Half(Rng));
+            B.Min[i] = { C.X - H, C.Y - H, C.Z - H };
+            B.Max[i] = { C.X + H, C.Y + H, C.Z + H };
+        }
+        if (_Count > 10) B.Min[10] = B.Max[10] = B.Min[9]; // duplicata exata (empates)
+        B.SyncSoa();
+        return B;
+    }
+
+    FCullFrustum MakeFrustum(const Vec3& _Eye, const Vec3& _At, f32 _Far) {
+        const Mat44 View = Mat44::LookAtLH(_Eye, _At, { 0.0f, 1.0f, 0.0f });
+        return FCullFrustum::FromViewProj(View * Mat44::PerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, _Far));
+    }
+
+    // Mesmo slab do BVH: a referencia do raio.
+    f32 RaySlab(const Vec3& _O, const Vec3& _D, f32 _MaxT, const Vec3& _Lo, const Vec3& _Hi) {
+        f32 T0 = 0.0f, T1 = _MaxT;
+        const f32 O[3] = { _O.X, _O.Y, _O.Z }, D[3] = { _D.X, _D.Y, _D.Z };
+        const f32 Lo[3] = { _Lo.X, _Lo.Y, _Lo.Z }, Hi[3] = { _Hi.X, _Hi.Y, _Hi.Z };
+        for (int a = 0; a < 3; ++a) {
+            if (D[a] == 0.0f) {
+                if (O[a] < Lo[a] || O[a] > Hi[a]) return -1.0f;
+                continue;
+            }
+            const f32 Inv = 1.0f / D[a];
+            f32 Ta = (Lo[a] - O[a]) * Inv, Tb = (Hi[a] - O[a]) * Inv;
+            if (Ta > Tb) std::swap(Ta, Tb);
+            T0 = std::max(T0, Ta);
+            T1 = std::min(T1, Tb);
+            if (T0 > T1) return -1.0f;
+        }
+        return T0;
+    }
+
+    Smile::FBvhRayHit LinearRay(const FBoxes& _B, const Vec3& _O, const Vec3& _D, f32 _MaxT, bool _OddOnly) {
+        Smile::FBvhRayHit Best;
+        Best.T = _MaxT;
+        for (u32 i = 0; i < _B.Min.size(); ++i) {
+            if (_OddOnly && i % 2 == 0) continue;
+            const f32 T = RaySlab(_O, _D, _MaxT, _B.Min[i], _B.Max[i]);
+            if (T >= 0.0f && (T < Best.T || !Best.Hit())) Best = { i, T };
+        }
+        if (!Best.Hit()) Best.T = 0.0f;
+        return Best;
+    }
+
+    f32 DistSq(const Vec3& _P, const Vec3& _Lo, const Vec3& _Hi) {
+        f32 D2 = 0.0f;
+        const f32 C[3] = { _P.X, _P.Y, _P.Z }, Lo[3] = { _Lo.X, _Lo.Y, _Lo.Z }, Hi[3] = { _Hi.X, _Hi.Y, _Hi.Z };
+        for (int a = 0; a < 3; ++a) {
+            if (C[a] < Lo[a])      { const f32 d = Lo[a] - C[a]; D2 += d * d; }
+            else if (C[a] > Hi[a]) { const f32 d = C[a] - Hi[a]; D2 += d * d; }
+        }
+        return D2;
+    }
+
+    std::vector<u32> LinearKNearest(const FBoxes& _B, const Vec3& _P, u32 _K, bool _OddOnly) {
+        std::vector<std::pair<f32, u32>> All;
+        for (u32 i = 0; i < _B.Min.size(); ++i)
+            if (!_OddOnly || i % 2 == 1) All.push_back({ DistSq(_P, _B.Min[i], _B.Max[i]), i });
+        const size_t K = std::min<size_t>(_K, All.size());
+        std::partial_sort(All.begin(), All.begin() + K, All.end());
+        std::vector<u32> Out;
+        for (size_t k = 0; k < K; ++k) Out.push_back(All[k].second);
+        return Out;
+    }
+
+    // Todas as consultas contra a varredura, com a arvore no estado atual.
+    void CheckQueries(const FSceneBvh& _Bvh, const FBoxes& _B, const std::string& _Tag) {
+        std::mt19937 Rng(123);
+        std::uniform_real_distribution<f32> Pos(-700.0f, 700.0f), Dir(-1.0f, 1.0f);
+        const Smile::FBvhFilter Odd = [](u32 _I) { return _I % 2 == 1; };
+        for (int q = 0; q < 24; ++q) {
+            const Vec3 Eye{ Pos(Rng), 20.0f, Pos(Rng) };
+            const Vec3 At{ Eye.X + Dir(Rng), Eye.Y + Dir(Rng) * 0.2f, Eye.Z + Dir(Rng) };
+            const FCullFrustum View = MakeFrustum(Eye, At, q % 2 ? 150.0f : 2000.0f);
+
+            std::vector<std::vector<u32>> Expected(1);
+            Smile::CullFrustums(_B.Soa, { &View, 1 }, Expected, Smile::ECullPath::Scalar);
+            std::vector<u32> Got{ 99u };
+            _Bvh.QueryFrustum(View, Got);
+            Check(Got == Expected[0], _Tag + ": frustum " + std::to_string(q));
+
+            const f32 Radius = q % 3 == 0 ? 0.0f : (q % 3 == 1 ? 12.0f : 150.0f);
+            std::vector<u32> SphereExp;
+            Smile::CullSphere(_B.Soa, Eye, Radius, SphereExp, Smile::ECullPath::Scalar);
+            _Bvh.QuerySphere(Eye, Radius, Got);
+            Check(Got == SphereExp, _Tag + ": esfera " + std::to_string(q));
+
+            // Raio com eixo paralelo de vez em quando (o caminho 0 * inf).
+            Vec3 D{ Dir(Rng), q % 4 == 0 ? 0.0f : Dir(Rng) * 0.1f, Dir(Rng) };
+            if (q % 5 == 0) D = { 1.0f, 0.0f, 0.0f };
+            for (const bool OddOnly : { false, true }) {
+                const Smile::FBvhRayHit Ref = LinearRay(_B, Eye, D, 5000.0f, OddOnly);
+                const Smile::FBvhRayHit Hit = _Bvh.Raycast(Eye, D, 5000.0f, OddOnly ? Odd : Smile::FBvhFilter{});
+                Check(Hit.Index == Ref.Index && Hit.T == Ref.T, _Tag + ": raio " + std::to_string(q));
+
+                const u32 K = q % 3 == 0 ? 1u : 17u;
+                std::vector<u32> Knn;
+                _Bvh.KNearest(Eye, K, Knn, OddOnly ? Odd : Smile::FBvhFilter{});
+                Check(Knn == LinearKNearest(_B, Eye, K, OddOnly), _Tag + ": k-vizinhos " + std::to_string(q));
+            }
+        }
+    }
+
+    void TestBuild() {
+        for (const u32 Count : { 0u, 1u, 4u, 5u, 333u, 20011u }) {
+            const FBoxes B = MakeBoxes(Count, Count + 7);
+            FSceneBvh Bvh;
+            Bvh.Build(B.Min, B.Max);
+            Check(Bvh.Size() == Count, "tamanho");
+            CheckQueries(Bvh, B, std::to_string(Count) + " caixas");
+        }
+        // Todas no mesmo lugar: sem eixo para cortar, a folha tem de continuar limitada.
+        FBoxes Same;
+        Same.Min.assign(100, Vec3{ 1.0f, 2.0f, 3.0f });
+        Same.Max.assign(100, Vec3{ 2.0f, 3.0f, 4.0f });
+        Same.SyncSoa();
+        FSceneBvh Bvh;
+        Bvh.Build(Same.Min, Same.Max);
+        bool Bounded = true;
+        for (const Smile::FBvhNode& N : Bvh.NodeList()) Bounded = Bounded && N.Count <= FSceneBvh::kMaxLeafSize;
+        Check(Bounded, "folha acima do limite com centroides iguais");
+        CheckQueries(Bvh, Same, "caixas coincidentes");
+    }
+
+    void TestRefit() {
+        FBoxes B = MakeBoxes(20011, 3);
+        FSceneBvh Bvh;
+        Bvh.Build(B.Min, B.Max);
+        const Smile::u64 NodeCount = Bvh.NodeList().size();
+        Check(Bvh.RefitNodeCount() == 0, "build contou nos de refit");
+
+        // Poucos andam (o gizmo): refit so deles.
+        std::mt19937 Rng(9);
+        std::uniform_int_distribution<u32> Pick(0, 20010);
+        std::uniform_real_distribution<f32> Step(-300.0f, 300.0f);
+        std::vector<u32> Moved;
+        for (int m = 0; m < 200; ++m) {
+            const u32 i = Pick(Rng);
+            const Vec3 D{ Step(Rng), Step(Rng) * 0.1f, Step(Rng) };
+            B.Min[i] += D;
+            B.Max[i] += D;
+            Moved.push_back(i);
+        }
+        B.SyncSoa();
+        Bvh.Refit(B.Min, B.Max, Moved);
+        CheckQueries(Bvh, B, "refit parcial");
+        const Smile::u64 Partial = Bvh.RefitNodeCount();
+        Check(Partial > 0 && Partial < NodeCount / 2, "refit parcial recalculou a arvore quase inteira");
+
+        // Sync que so assenta o PrevWorld: lista vazia nao toca no nenhum.
+        Bvh.Refit(B.Min, B.Max, std::span<const u32>{});
+        Check(Bvh.RefitNodeCount() == Partial, "refit com lista vazia recalculou nos");
+        CheckQueries(Bvh, B, "refit com lista vazia");
+
+        // Todos andam (BumpTransformsVersion sem indice): refit inteiro.
+        for (size_t i = 0; i < B.Min.size(); ++i) {
+            B.Min[i].X += 11.0f;
+            B.Max[i].X += 13.0f;
+        }
+        B.SyncSoa();
+        Bvh.Refit(B.Min, B.Max);
+        CheckQueries(Bvh, B, "refit inteiro");
+        Check(Bvh.RefitNodeCount() == Partial + NodeCount, "refit inteiro nao passou por todos os nos");
+
+        // Tamanho novo no refit vira rebuild.
+        B.Min.resize(5000);
+        B.Max.resize(5000);
+        B.SyncSoa();
+        Bvh.Refit(B.Min, B.Max);
+        Check(Bvh.Size() == 5000, "refit com tamanho novo nao reconstruiu");
+        CheckQueries(Bvh, B, "refit com tamanho novo");
+    }
+
+    void Bench(u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        auto Ms = [](Clock::time_point _A, Clock::time_point _B, int _Reps) {
+            return std::chrono::duration<double, std::milli>(_B - _A).count() / _Reps;
+        };
+        FBoxes B = MakeBoxes(_Count, 77);
+        FSceneBvh Bvh;
+        auto T0 = Clock::now();
+        Bvh.Build(B.Min, B.Max);
+        std::cout << "  bench " << _Count << " caixas: build " << Ms(T0, Clock::now(), 1) << " ms";
+        T0 = Clock::now();
+        Bvh.Refit(B.Min, B.Max);
+        std::cout << " | refit inteiro " << Ms(T0, Clock::now(), 1) << " ms\n";
+
+        constexpr int kReps = 200;
+        const Vec3 Eye{ 100.0f, 10.0f, -50.0f };
+        std::vector<u32> Out;
+        std::vector<std::vector<u32>> OutV(1);
+
+        const FCullFrustum Narrow = MakeFrustum(Eye, { 130.0f, 10.0f, -20.0f }, 120.0f);
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Smile::CullFrustums(B.Soa, { &Narrow, 1 }, OutV);
+        const double LinF = Ms(T0, Clock::now(), kReps);
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Bvh.QueryFrustum(Narrow, Out);
+        const double BvhF = Ms(T0, Clock::now(), kReps);
+        std::cout << "    frustum (120 m, " << Out.size() << " itens): varredura SIMD " << LinF << " ms | bvh " << BvhF
+                  << " ms (" << LinF / BvhF << "x)\n";
+
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Smile::CullSphere(B.Soa, Eye, 15.0f, Out);
+        const double LinS = Ms(T0, Clock::now(), kReps);
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Bvh.QuerySphere(Eye, 15.0f, Out);
+        const double BvhS = Ms(T0, Clock::now(), kReps);
+        std::cout << "    esfera (15 m, " << Out.size() << " itens): varredura SIMD " << LinS << " ms | bvh " << BvhS
+                  << " ms (" << LinS / BvhS << "x)\n";
+
+        const Vec3 Dir{ 0.7f, -0.05f, 0.71f };
+        u32 Sink = 0; // sem isto o laco linear some no otimizador
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Sink += LinearRay(B, Eye, Dir, 5000.0f, false).Index;
+        const double LinR = Ms(T0, Clock::now(), kReps);
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Sink -= Bvh.Raycast(Eye, Dir, 5000.0f).Index;
+        const double BvhR = Ms(T0, Clock::now(), kReps);
+        Check(Sink == 0, "bench: raio difere da varredura");
+        std::cout << "    raio: varredura " << LinR << " ms | bvh " << BvhR << " ms (" << LinR / BvhR << "x)\n";
+
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) (void)LinearKNearest(B, Eye, 16, false);
+        const double LinK = Ms(T0, Clock::now(), kReps);
+        T0 = Clock::now();
+        for (int r = 0; r < kReps; ++r) Bvh.KNearest(Eye, 16, Out);
+        const double BvhK = Ms(T0, Clock::now(), kReps);
+        std::cout << "    16 vizinhos: varredura " << LinK << " ms | bvh " << BvhK << " ms (" << LinK / BvhK << "x)\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.SceneBvh\n";
+    TestBuild();
+    TestRefit();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench(100000);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,226 @@
+// Tabela de handles geracionais da cena (Smile/Scene/SceneHandles.h).
+//
+// O contrato: Id nunca e 0 nem se repete na sessao (nem com slot reusado, nem depois do
+// ReleaseAll), Id solto deixa de resolver, e uma lista densa que re-ancora quem andou resolve
+// todo Id vivo para a posicao em que ele de fato esta — o mesmo que o mapa Id->indice antigo.
+//
+// `SmileSceneHandlesTests --bench` apaga 5k de 20k objetos: mapa refeito por remocao contra
+// compactacao unica + re-ancorar a cauda.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Smile/Scene/SceneHandles.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::u32;
+    using Smile::u64;
+    using Smile::ESceneObject;
+    using Smile::FSceneHandleTable;
+
+    // Lista densa como a da FScene: Ids em ordem, remocao estavel em lote.
+    struct FDenseList {
+        FSceneHandleTable Table;
+        std::vector<u64>  Ids;
+
+        u64 Add(ESceneObject _Kind) {
+            Ids.push_back(Table.Allocate(_Kind, static_cast<u32>(Ids.size())));
+            return Ids.back();
+        }
+
+        u32 Remove(const std::vector<u64>& _Doomed) {
+            std::vector<unsigned char> Mark(Ids.size(), 0);
+            u32 First = static_cast<u32>(Ids.size()), Count = 0;
+            for (const u64 Id : _Doomed) {
+                const auto Ref = Table.Resolve(Id);
+                if (!Ref.IsValid() || Mark[Ref.Index]) continue;
+                Mark[Ref.Index] = 1;
+                First = std::min(First, Ref.Index);
+                ++Count;
+            }
+            u32 Write = First;
+            for (u32 i = First; i < Ids.size(); ++i) {
+                if (Mark[i]) { Table.Release(Ids[i]); continue; }
+                Ids[Write++] = Ids[i];
+            }
+            Ids.resize(Write);
+            for (u32 i = First; i < Ids.size(); ++i) Table.SetIndex(Ids[i], i);
+            return Count;
+        }
+
+        bool Coherent() const {
+            for (u32 i = 0; i < Ids.size(); ++i) {
+                const auto Ref = Table.Resolve(Ids[i]);
+                if (!Ref.IsValid() || Ref.Index != i || Ref.Id != Ids[i]) return false;
+            }
+            return Table.LiveCount() == Ids.size();
+        }
+    };
+
+    void TestBasico() {
+        FSceneHandleTable T;
+        const u64 A = T.Allocate(ESceneObject::Renderable, 0);
+        const u64 B = T.Allocate(ESceneObject::Light, 0);
+        Check(A != 0 && B != 0 && A != B, "basico: Id zero ou repetido");
+        Check(T.Resolve(A).IsRenderable() && T.Resolve(B).IsLight(), "basico: tipo errado");
+        Check(!T.Resolve(0).IsValid(), "basico: Id 0 resolveu");
+        Check(!T.Resolve(A + 1000).IsValid(), "basico: slot inexistente resolveu");
+        Check(!T.Resolve(A ^ (1ull << 32)).IsValid(), "basico: geracao errada resolveu");
+
+        T.SetIndex(B, 7);
+        Check(T.Resolve(B).Index == 7, "basico: SetIndex nao re-ancorou");
+
+        Check(T.Release(A), "basico: soltar Id vivo falhou");
+        Check(!T.Release(A), "basico: soltar duas vezes deu certo");
+        Check(!T.Resolve(A).IsValid(), "basico: Id solto ainda resolve");
+        T.SetIndex(A, 3); // ignorado
+        const u64 C = T.Allocate(ESceneObject::Light, 1);
+        Check(FSceneHandleTable::SlotOf(C) == FSceneHandleTable::SlotOf(A), "basico: slot livre nao foi reusado");
+        Check(C != A && !T.Resolve(A).IsValid(), "basico: slot reusado ressuscitou o Id velho");
+        Check(T.Resolve(C).IsLight() && T.Resolve(C).Index == 1, "basico: dono novo do slot errado");
+        Check(T.LiveCount() == 2, "basico: contagem de vivos");
+    }
+
+    // Todo Id ja emitido e diferente de todos os outros, com muito reuso de slot e ReleaseAll no
+    // meio (o Clear da cena).
+    void TestNuncaRepete() {
+        std::mt19937 Rng(3);
+        FSceneHandleTable T;
+        std::unordered_set<u64> Issued;
+        std::vector<u64> Live;
+        bool Unique = true, StaleDead = true;
+        std::vector<u64> Dead;
+        for (int Step = 0; Step < 50000; ++Step) {
+            const u32 Op = Rng() % 100;
+            if (Op < 55 || Live.empty()) {
+                const u64 Id = T.Allocate(ESceneObject::Renderable, 0);
+                Unique = Unique && Id != 0 && Issued.insert(Id).second;
+                Live.push_back(Id);
+            } else if (Op < 99) {
+                const u32 k = Rng() % Live.size();
+                T.Release(Live[k]);
+                Dead.push_back(Live[k]);
+                Live[k] = Live.back();
+                Live.pop_back();
+            } else {
+                T.ReleaseAll();
+                Dead.insert(Dead.end(), Live.begin(), Live.end());
+                Live.clear();
+            }
+        }
+        for (const u64 Id : Dead) StaleDead = StaleDead && !T.Resolve(Id).IsValid();
+        Check(Unique, "nunca repete: Id emitido duas vezes");
+        Check(StaleDead, "nunca repete: Id solto voltou a resolver");
+        Check(T.LiveCount() == Live.size(), "nunca repete: contagem de vivos");
+        Check(T.SlotCount() < Issued.size(), "nunca repete: nenhum slot reusado");
+    }
+
+    // Contra a referencia: a lista de antes filtrada pelo conjunto removido, mesma ordem.
+    void TestListaDensa() {
+        std::mt19937 Rng(17);
+        FDenseList L;
+        for (int i = 0; i < 3000; ++i) L.Add(i % 5 == 0 ? ESceneObject::Light : ESceneObject::Renderable);
+        Check(L.Coherent(), "densa: montagem incoerente");
+        std::vector<u64> Gone;
+        for (int Round = 0; Round < 40; ++Round) {
+            std::vector<u64> Doomed;
+            const u32 k = 1 + Rng() % 50;
+            for (u32 j = 0; j < k && !L.Ids.empty(); ++j) Doomed.push_back(L.Ids[Rng() % L.Ids.size()]);
+            Doomed.push_back(0);
+            if (!Gone.empty()) Doomed.push_back(Gone[Rng() % Gone.size()]); // ja solto: ignorado
+            std::vector<u64> Before = L.Ids;
+            const u32 Removed = L.Remove(Doomed);
+            std::unordered_set<u64> Set(Doomed.begin(), Doomed.end());
+            std::vector<u64> Expected;
+            for (const u64 Id : Before)
+                if (!Set.count(Id)) Expected.push_back(Id);
+            Check(L.Ids == Expected, "densa: ordem dos sobreviventes (rodada " + std::to_string(Round) + ")");
+            Check(Removed == Before.size() - Expected.size(), "densa: contagem removida");
+            for (const u64 Id : Before)
+                if (Set.count(Id)) Gone.push_back(Id);
+            for (int j = 0; j < 20; ++j) L.Add(ESceneObject::Renderable);
+            Check(L.Coherent(), "densa: Id vivo fora do lugar (rodada " + std::to_string(Round) + ")");
+        }
+        bool GoneDead = true;
+        for (const u64 Id : Gone) GoneDead = GoneDead && !L.Table.Resolve(Id).IsValid();
+        Check(GoneDead, "densa: removido ainda resolve");
+    }
+
+    void Bench() {
+        using Clock = std::chrono::steady_clock;
+        const u32 Count = 20000, Delete = 5000;
+        std::mt19937 Rng(1);
+        std::vector<u32> Pick(Count);
+        for (u32 i = 0; i < Count; ++i) Pick[i] = i;
+        std::shuffle(Pick.begin(), Pick.end(), Rng);
+        Pick.resize(Delete);
+
+        // Antes: contador + unordered_map refeito inteiro depois de cada erase.
+        double OldMs = 0.0;
+        {
+            std::vector<u64> Ids(Count);
+            for (u32 i = 0; i < Count; ++i) Ids[i] = i + 1;
+            std::vector<u64> Doomed;
+            for (const u32 i : Pick) Doomed.push_back(Ids[i]);
+            std::unordered_map<u64, u32> Map;
+            for (u32 i = 0; i < Count; ++i) Map.emplace(Ids[i], i);
+            const auto T0 = Clock::now();
+            for (const u64 Id : Doomed) {
+                const auto It = Map.find(Id);
+                Ids.erase(Ids.begin() + It->second);
+                Map.clear();
+                Map.reserve(Ids.size());
+                for (u32 i = 0; i < Ids.size(); ++i) Map.emplace(Ids[i], i);
+            }
+            OldMs = std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+        }
+
+        FDenseList L;
+        for (u32 i = 0; i < Count; ++i) L.Add(ESceneObject::Renderable);
+        std::vector<u64> Doomed;
+        for (const u32 i : Pick) Doomed.push_back(L.Ids[i]);
+        auto T0 = Clock::now();
+        L.Remove(Doomed);
+        const double NewMs = std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+
+        u64 Sum = 0;
+        T0 = Clock::now();
+        for (int Pass = 0; Pass < 10; ++Pass)
+            for (const u64 Id : L.Ids) Sum += L.Table.Resolve(Id).Index;
+        const double LookupNs = std::chrono::duration<double, std::nano>(Clock::now() - T0).count() /
+                                (10.0 * L.Ids.size());
+        std::cout << "  apagar " << Delete << " de " << Count << ": mapa refeito " << OldMs << " ms | lote "
+                  << NewMs << " ms | resolve " << LookupNs << " ns (" << (Sum & 1) << ")\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.SceneHandles\n";
+    TestBasico();
+    TestNuncaRepete();
+    TestListaDensa();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,208 @@
+// Hierarquia de transforms da cena (Smile/Scene/SceneHierarchy.h).
+//
+// O contrato: a ordem e de largura (pai antes do filho, filhos de um no vizinhos), pai invalido ou
+// ciclo vira raiz, e o Update incremental da o MESMO mundo que recompor a arvore inteira — mexendo
+// so no marcado e na descendencia dele. De quebra, o FTransform::FromMatrix desfaz o Matrix().
+//
+// `SmileSceneHierarchyTests --bench` mede 100k nos: update inteiro contra mover um no.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Scene/SceneHierarchy.h"
+#include "Smile/Scene/Transform.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::i32;
+    using Smile::u32;
+    using Smile::Mat44;
+    using Smile::Vec3;
+    using Smile::FTransform;
+    using Smile::FSceneHierarchy;
+
+    bool Near(const Mat44& A, const Mat44& B, f32 Tol = 1e-4f) {
+        for (int r = 0; r < 4; ++r)
+            for (int c = 0; c < 4; ++c)
+                if (std::fabs(A.M[r][c] - B.M[r][c]) > Tol * std::max(1.0f, std::fabs(A.M[r][c]))) return false;
+        return true;
+    }
+
+    // Floresta aleatoria em que o pai sempre vem antes (como o cooker grava), com TRS local.
+    struct FForest {
+        std::vector<i32>        Parents;
+        std::vector<FTransform> Locals;
+    };
+
+    FForest MakeForest(u32 Count, u32 Seed) {
+        std::mt19937 Rng(Seed);
+        std::uniform_real_distribution<f32> Pos(-10.0f, 10.0f), Ang(-3.0f, 3.0f), Scl(0.5f, 1.5f);
+        FForest F;
+        F.Parents.resize(Count);
+        F.Locals.resize(Count);
+        for (u32 i = 0; i < Count; ++i) {
+            F.Parents[i] = (i == 0 || Rng() % 5 == 0) ? -1 : static_cast<i32>(Rng() % i);
+            const f32 S = Scl(Rng); // uniforme: sem cisalhamento na composicao
+            F.Locals[i] = { { Pos(Rng), Pos(Rng), Pos(Rng) }, { Ang(Rng), Ang(Rng), Ang(Rng) }, { S, S, S } };
+        }
+        return F;
+    }
+
+    // Mundo de referencia: subir ate a raiz compondo, sem ordem nenhuma.
+    Mat44 Reference(const FForest& F, u32 i) {
+        Mat44 W = F.Locals[i].Matrix();
+        for (i32 p = F.Parents[i]; p >= 0; p = F.Parents[p]) W = W * F.Locals[p].Matrix();
+        return W;
+    }
+
+    void TestOrdemDeLargura() {
+        const FForest F = MakeForest(2000, 3);
+        FSceneHierarchy H;
+        H.Build(F.Parents);
+        Check(H.Size() == 2000, "ordem: tamanho");
+        std::vector<u32> Pos(2000);
+        const auto Order = H.Order();
+        for (u32 p = 0; p < Order.size(); ++p) Pos[Order[p]] = p;
+        bool ParentFirst = true, DepthMonotone = true;
+        for (u32 p = 0; p < Order.size(); ++p) {
+            const u32 i = Order[p];
+            if (F.Parents[i] >= 0 && Pos[F.Parents[i]] >= p) ParentFirst = false;
+            if (p > 0 && H.DepthOf(Order[p - 1]) > H.DepthOf(i) && F.Parents[i] >= 0) DepthMonotone = false;
+            if (F.Parents[i] >= 0 && H.DepthOf(i) != H.DepthOf(F.Parents[i]) + 1) DepthMonotone = false;
+        }
+        Check(ParentFirst, "ordem: filho antes do pai");
+        Check(DepthMonotone, "ordem: profundidade fora de largura");
+        // Filhos de um mesmo no sao vizinhos.
+        bool Contiguous = true;
+        for (u32 p = 1; p + 1 < Order.size(); ++p) {
+            const i32 A = F.Parents[Order[p - 1]], B = F.Parents[Order[p]], C = F.Parents[Order[p + 1]];
+            if (A >= 0 && A == C && B != A) Contiguous = false;
+        }
+        Check(Contiguous, "ordem: irmaos separados");
+    }
+
+    void TestPaiInvalidoECiclo() {
+        // 0 raiz; 1 aponta para fora; 2 para si; 3<->4 ciclo; 5 filho do 4.
+        const std::vector<i32> Parents = { -1, 99, 2, 4, 3, 4 };
+        FSceneHierarchy H;
+        H.Build(Parents);
+        Check(H.ParentOf(0) == -1 && H.ParentOf(1) == -1 && H.ParentOf(2) == -1, "saneamento: pai invalido ficou");
+        Check((H.ParentOf(3) == -1) != (H.ParentOf(4) == -1), "saneamento: ciclo nao foi quebrado em um ponto");
+        Check(H.ParentOf(5) == 4, "saneamento: filho do ciclo perdeu o pai");
+        Check(H.Size() == 6 && H.Order().size() == 6, "saneamento: no perdido na ordem");
+    }
+
+    void TestUpdateIgualAReferencia() {
+        FForest F = MakeForest(3000, 11);
+        FSceneHierarchy H;
+        H.Build(F.Parents);
+        auto LocalOf = [&](u32 i) { return F.Locals[i].Matrix(); };
+        Check(H.Update(LocalOf).size() == 3000, "update: montagem nao refez todos");
+        bool Same = true;
+        for (u32 i = 0; i < 3000; ++i) Same = Same && Near(H.World(i), Reference(F, i));
+        Check(Same, "update: mundo da montagem difere da referencia");
+        Check(H.Update(LocalOf).empty(), "update: sem marca refez algo");
+
+        // Marca alguns: muda exatamente a uniao das subarvores, e bate com a referencia.
+        std::mt19937 Rng(5);
+        for (int Round = 0; Round < 20; ++Round) {
+            std::vector<bool> Expected(3000, false);
+            for (int k = 0; k < 3; ++k) {
+                const u32 i = Rng() % 3000;
+                F.Locals[i].Position.X += 1.0f;
+                H.MarkDirty(i);
+                Expected[i] = true;
+            }
+            for (const u32 i : H.Order())
+                if (F.Parents[i] >= 0 && Expected[F.Parents[i]]) Expected[i] = true;
+            const auto Changed = H.Update(LocalOf);
+            std::vector<bool> Got(3000, false);
+            for (const u32 i : Changed) Got[i] = true;
+            Check(Got == Expected, "update: mudou fora da subarvore marcada (rodada " + std::to_string(Round) + ")");
+            bool Ok = true;
+            for (u32 i = 0; i < 3000; ++i) Ok = Ok && Near(H.World(i), Reference(F, i));
+            Check(Ok, "update: mundo incremental difere da referencia (rodada " + std::to_string(Round) + ")");
+        }
+
+        H.MarkDirty(5000); // fora: ignorado
+        Check(H.Update(LocalOf).empty(), "update: indice fora marcou algo");
+        H.MarkAllDirty();
+        Check(H.Update(LocalOf).size() == 3000, "update: MarkAllDirty nao refez todos");
+    }
+
+    void TestFromMatrix() {
+        std::mt19937 Rng(9);
+        std::uniform_real_distribution<f32> Pos(-50.0f, 50.0f), Ang(-1.5f, 1.5f), Scl(0.2f, 3.0f);
+        bool Ok = true;
+        for (int k = 0; k < 500; ++k) {
+            const FTransform T{ { Pos(Rng), Pos(Rng), Pos(Rng) }, { Ang(Rng), Ang(Rng), Ang(Rng) },
+                                { (k % 7 == 0 ? -1.0f : 1.0f) * Scl(Rng), Scl(Rng), Scl(Rng) } };
+            Ok = Ok && Near(FTransform::FromMatrix(T.Matrix()).Matrix(), T.Matrix());
+        }
+        Check(Ok, "FromMatrix: recompor nao devolve a matriz");
+        // Pai com escala nao uniforme sob filho rodado: cisalhamento, sem TRS exato.
+        const FTransform Child{ {}, { 0.0f, 0.0f, 0.7f }, { 1.0f, 1.0f, 1.0f } };
+        const FTransform Parent{ {}, {}, { 3.0f, 1.0f, 1.0f } };
+        const Mat44 Shear = Child.Matrix() * Parent.Matrix();
+        Check(!Near(FTransform::FromMatrix(Shear).Matrix(), Shear), "FromMatrix: cisalhamento passou por exato");
+    }
+
+    void Bench() {
+        using Clock = std::chrono::steady_clock;
+        const u32 Count = 100000;
+        const FForest F = MakeForest(Count, 1);
+        FSceneHierarchy H;
+        auto T0 = Clock::now();
+        H.Build(F.Parents);
+        const double BuildMs = std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+        auto LocalOf = [&](u32 i) { return F.Locals[i].Matrix(); };
+        T0 = Clock::now();
+        H.Update(LocalOf);
+        const double FullMs = std::chrono::duration<double, std::milli>(Clock::now() - T0).count();
+        // Um no de profundidade 1 (o caso do gizmo num objeto com filhos).
+        u32 Node = 0;
+        for (const u32 i : H.Order())
+            if (H.DepthOf(i) == 1) { Node = i; break; }
+        const int Iters = 1000;
+        size_t Touched = 0;
+        T0 = Clock::now();
+        for (int k = 0; k < Iters; ++k) {
+            H.MarkDirty(Node);
+            Touched = H.Update(LocalOf).size();
+        }
+        const double MoveUs = std::chrono::duration<double, std::micro>(Clock::now() - T0).count() / Iters;
+        std::cout << "  " << Count << " nos: build " << BuildMs << " ms | update inteiro " << FullMs
+                  << " ms | mover 1 no (" << Touched << " na subarvore) " << MoveUs << " us\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.SceneHierarchy\n";
+    TestOrdemDeLargura();
+    TestPaiInvalidoECiclo();
+    TestUpdateIgualAReferencia();
+    TestFromMatrix();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,254 @@
+// Cache SoA dos renderaveis (Smile/Scene/SceneHotData.h) contra o laco antigo do BuildDrawLists.
+//
+// Os dois lacos abaixo reproduzem o trabalho de CPU do BuildDrawLists por objeto — filtro de
+// visibilidade, matriz de mundo, os tres produtos com as view-projections, a copia para o
+// ObjectCB, o modelo anterior do PrevMVP e a distancia para a ordenacao — um lendo o struct gordo,
+// chamando Transform.Matrix() e guardando o PreviousModels, o outro lendo World/PrevWorld do
+// FSceneHotData. O contrato: as duas saidas sao IGUAIS bit a bit, e o SoA so entrega quem e
+// visivel E desenhavel.
+//
+// O FFatRenderable espelha os campos do FRenderable (o Scene.h arrasta o D3D12, e a forma do
+// struct e o que o bench mede). `SmileSceneHotDataTests --bench` imprime 2,5k, 25k e 250k
+// renderaveis: ms por frame de cada laco, o custo de montar o cache inteiro (mudanca de estrutura)
+// e o de refazer so o objeto arrastado pelo gizmo.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Scene/SceneHotData.h"
+#include "Smile/Scene/Transform.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FFatRenderable {
+        Smile::u64        Id = 0;
+        std::string       Name;
+        Smile::FTransform Transform;
+        const void*       Mesh     = nullptr;
+        const void*       Material = nullptr;
+        bool              Visible  = true;
+        Smile::i32        CookedIndex = -1;
+        bool              Spawned = false;
+        bool              RaytracingOnly = false;
+        Smile::u8         Mobility = 0;
+        Smile::Vec3       LocalAABBMin, LocalAABBMax, AABBMin, AABBMax;
+    };
+
+    // Mesmo layout do ObjectConstants do renderer: o que o laco escreve por objeto.
+    struct FObjectConstants {
+        Smile::Mat44 MVP, ModelMatrix, CurMVPNoJitter, PrevMVP;
+    };
+
+    struct FDrawOut {
+        std::vector<FObjectConstants> Constants;
+        std::vector<Smile::u32>       SceneIndex;
+        std::vector<float>            Dist;
+        std::vector<Smile::Mat44>     PreviousModels;
+    };
+
+    struct FFrame {
+        Smile::Mat44 ViewProj, ViewProjUnjittered, PrevViewProj;
+        Smile::Vec3  CamPos;
+    };
+
+    std::vector<FFatRenderable> MakeScene(Smile::u32 _Count) {
+        std::mt19937 Rng(7);
+        std::uniform_real_distribution<float> Pos(-500.0f, 500.0f), Angle(-3.14f, 3.14f), Size(0.5f, 4.0f);
+        std::vector<FFatRenderable> Scene(_Count);
+        for (Smile::u32 I = 0; I < _Count; ++I) {
+            FFatRenderable& R = Scene[I];
+            R.Id   = I + 1;
+            R.Name = "SM_Bistro_Prop_" + std::to_string(I);
+            R.Transform.Position      = { Pos(Rng), Pos(Rng) * 0.1f, Pos(Rng) };
+            R.Transform.RotationEuler = { Angle(Rng), Angle(Rng), Angle(Rng) };
+            R.Transform.Scale         = { Size(Rng), Size(Rng), Size(Rng) };
+            R.Mesh           = &Scene; // qualquer endereco: ninguem desreferencia
+            R.Visible        = I % 10 != 3;
+            R.RaytracingOnly = I % 97 == 5;
+            R.Mobility       = I % 13 == 0 ? 1 : 0;
+            const float Half = Size(Rng);
+            R.AABBMin = { R.Transform.Position.X - Half, R.Transform.Position.Y - Half, R.Transform.Position.Z - Half };
+            R.AABBMax = { R.Transform.Position.X + Half, R.Transform.Position.Y + Half, R.Transform.Position.Z + Half };
+        }
+        return Scene;
+    }
+
+    // O que FScene::SyncHotData faz com a lista.
+    void BuildHot(const std::vector<FFatRenderable>& _Scene, Smile::FSceneHotData& _Hot) {
+        _Hot.Resize(_Scene.size());
+        for (size_t I = 0; I < _Scene.size(); ++I) {
+            const FFatRenderable& R = _Scene[I];
+            _Hot.World[I]     = R.Transform.Matrix();
+            _Hot.BoundsMin[I] = R.AABBMin;
+            _Hot.BoundsMax[I] = R.AABBMax;
+            Smile::u8 Flags = 0;
+            if (R.Visible) Flags |= Smile::kHotVisible;
+            if (R.Mesh && !R.RaytracingOnly) Flags |= Smile::kHotDrawable;
+            if (R.Mobility) Flags |= Smile::kHotDynamic;
+            _Hot.Flags[I] = Flags;
+        }
+        _Hot.PrevWorld = _Hot.World;
+    }
+
+    // O sync com um objeto marcado: assenta o PrevWorld e refaz so a matriz dele.
+    void MoveHot(const FFatRenderable& _R, Smile::u32 _Index, Smile::FSceneHotData& _Hot) {
+        _Hot.PrevWorld[_Index] = _Hot.World[_Index];
+        _Hot.World[_Index]     = _R.Transform.Matrix();
+    }
+
+    void Emit(FDrawOut& _Out, const FFrame& _F, Smile::u32 _Index, const Smile::Mat44& _Model,
+              const Smile::Mat44& _PrevModel, const Smile::Vec3& _Min, const Smile::Vec3& _Max) {
+        FObjectConstants OC;
+        OC.MVP            = _Model * _F.ViewProj;
+        OC.ModelMatrix    = _Model;
+        OC.CurMVPNoJitter = _Model * _F.ViewProjUnjittered;
+        OC.PrevMVP        = _PrevModel * _F.PrevViewProj;
+        _Out.Constants.push_back(OC);
+        _Out.SceneIndex.push_back(_Index);
+        const float X = (_Min.X + _Max.X) * 0.5f - _F.CamPos.X;
+        const float Y = (_Min.Y + _Max.Y) * 0.5f - _F.CamPos.Y;
+        const float Z = (_Min.Z + _Max.Z) * 0.5f - _F.CamPos.Z;
+        _Out.Dist.push_back(X * X + Y * Y + Z * Z);
+    }
+
+    void FrameAoS(const std::vector<FFatRenderable>& _Scene, const FFrame& _F, FDrawOut& _Out) {
+        _Out.Constants.clear();
+        _Out.SceneIndex.clear();
+        _Out.Dist.clear();
+        for (size_t I = 0; I < _Scene.size(); ++I) {
+            const FFatRenderable& R = _Scene[I];
+            if (!R.Visible || R.RaytracingOnly || !R.Mesh) continue;
+            const Smile::Mat44 Model = R.Transform.Matrix();
+            Emit(_Out, _F, Smile::u32(I), Model, _Out.PreviousModels[I], R.AABBMin, R.AABBMax);
+            _Out.PreviousModels[I] = Model;
+        }
+    }
+
+    void FrameSoA(const Smile::FSceneHotData& _Hot, const FFrame& _F, FDrawOut& _Out) {
+        _Out.Constants.clear();
+        _Out.SceneIndex.clear();
+        _Out.Dist.clear();
+        for (size_t I = 0; I < _Hot.Size(); ++I) {
+            if (!_Hot.IsDrawCandidate(I)) continue;
+            Emit(_Out, _F, Smile::u32(I), _Hot.World[I], _Hot.PrevWorld[I], _Hot.BoundsMin[I], _Hot.BoundsMax[I]);
+        }
+    }
+
+    FFrame MakeFrame(int _Index) {
+        FFrame F;
+        const Smile::Vec3 Eye{ 10.0f * float(_Index), 20.0f, -30.0f };
+        F.CamPos             = Eye;
+        F.ViewProj           = Smile::Mat44::Translation(Eye) * Smile::Mat44::RotationY(0.01f * float(_Index));
+        F.ViewProjUnjittered = Smile::Mat44::Translation(Eye);
+        F.PrevViewProj       = Smile::Mat44::RotationX(0.02f * float(_Index));
+        return F;
+    }
+
+    bool SameOutput(const FDrawOut& _A, const FDrawOut& _B) {
+        return _A.Constants.size() == _B.Constants.size() && _A.SceneIndex == _B.SceneIndex &&
+               std::memcmp(_A.Constants.data(), _B.Constants.data(), _A.Constants.size() * sizeof(FObjectConstants)) ==
+                   0 &&
+               std::memcmp(_A.Dist.data(), _B.Dist.data(), _A.Dist.size() * sizeof(float)) == 0;
+    }
+
+    // Cena estatica em regime: o PreviousModels do laco antigo ja alcancou a matriz de cada objeto.
+    std::vector<Smile::Mat44> SettledModels(const std::vector<FFatRenderable>& _Scene) {
+        std::vector<Smile::Mat44> Models(_Scene.size());
+        for (size_t I = 0; I < _Scene.size(); ++I) Models[I] = _Scene[I].Transform.Matrix();
+        return Models;
+    }
+
+    void TestMesmaSaida() {
+        std::vector<FFatRenderable> Scene = MakeScene(2000);
+        Smile::FSceneHotData Hot;
+        BuildHot(Scene, Hot);
+        Check(Hot.Size() == Scene.size(), "cache com tamanho diferente da lista");
+
+        FDrawOut AoS, SoA;
+        AoS.PreviousModels = SettledModels(Scene);
+        for (int Frame = 0; Frame < 3; ++Frame) {
+            FrameAoS(Scene, MakeFrame(Frame), AoS);
+            FrameSoA(Hot, MakeFrame(Frame), SoA);
+            Check(SameOutput(AoS, SoA), "frame " + std::to_string(Frame) + ": SoA difere do laco antigo");
+        }
+
+        // Gizmo arrasta o objeto 0 por dois frames e solta: o PrevMVP dele segue o laco antigo.
+        for (int Frame = 3; Frame < 6; ++Frame) {
+            if (Frame < 5) {
+                Scene[0].Transform.Position.X += 1.5f;
+                MoveHot(Scene[0], 0, Hot);
+            } else {
+                Hot.PrevWorld[0] = Hot.World[0];
+            }
+            FrameAoS(Scene, MakeFrame(Frame), AoS);
+            FrameSoA(Hot, MakeFrame(Frame), SoA);
+            Check(SameOutput(AoS, SoA), "frame " + std::to_string(Frame) + ": objeto movido difere do laco antigo");
+        }
+
+        size_t Expected = 0;
+        for (const FFatRenderable& R : Scene) Expected += R.Visible && !R.RaytracingOnly;
+        Check(SoA.SceneIndex.size() == Expected, "SoA entregou objeto oculto ou so de RT");
+        Check(!Hot.IsDrawCandidate(3) && !Hot.IsDrawCandidate(5), "oculto/RT-only marcado como candidato");
+        Check((Hot.Flags[0] & Smile::kHotDynamic) != 0 && (Hot.Flags[1] & Smile::kHotDynamic) == 0,
+              "bit de mobilidade");
+    }
+
+    void Bench(Smile::u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        const std::vector<FFatRenderable> Scene = MakeScene(_Count);
+        constexpr int kFrames = 20;
+
+        FDrawOut AoS, SoA;
+        AoS.PreviousModels = SettledModels(Scene);
+        AoS.Constants.reserve(_Count);
+        SoA.Constants.reserve(_Count);
+
+        const auto T0 = Clock::now();
+        for (int Frame = 0; Frame < kFrames; ++Frame) FrameAoS(Scene, MakeFrame(Frame), AoS);
+        const auto T1 = Clock::now();
+        Smile::FSceneHotData Hot;
+        BuildHot(Scene, Hot);
+        const auto T2 = Clock::now();
+        for (int Frame = 0; Frame < kFrames; ++Frame) FrameSoA(Hot, MakeFrame(Frame), SoA);
+        const auto T3 = Clock::now();
+        for (int Frame = 0; Frame < kFrames; ++Frame) MoveHot(Scene[Frame], Smile::u32(Frame), Hot);
+        const auto T4 = Clock::now();
+
+        auto Ms = [](Clock::time_point _A, Clock::time_point _B) {
+            return std::chrono::duration<double, std::milli>(_B - _A).count();
+        };
+        const double AoSMs = Ms(T0, T1) / kFrames, SoAMs = Ms(T2, T3) / kFrames;
+        std::cout << "  bench " << _Count << " renderaveis: AoS + Matrix() " << AoSMs << " ms/frame | SoA " << SoAMs
+                  << " ms/frame (" << AoSMs / SoAMs << "x) | montar o cache " << Ms(T1, T2) << " ms | 1 objeto marcado "
+                  << Ms(T3, T4) * 1000.0 / kFrames << " us\n";
+        Check(SameOutput(AoS, SoA), "bench: saidas diferentes");
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.SceneHotData\n";
+    TestMesmaSaida();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench")
+        for (const Smile::u32 Count : { 2500u, 25000u, 250000u }) Bench(Count);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
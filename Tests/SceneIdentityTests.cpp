@@ -10,6 +10,7 @@
 // Tudo abaixo e CPU pura: nao ha device, nao ha mesh de verdade (ponteiros sinteticos servem —
 // a FScene nunca os desreferencia), e por isso roda no CI sem GPU.
 
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -225,6 +226,244 @@ namespace {
                   "ciclo: remover a copia derrubou o original");
         }
     }
+
+    // Remocao em lote: o mesmo resultado de remover um a um — sobreviventes na ordem, Id que
+    // nao resolve ignorado — e filho de removido sobe para o ancestral que ficou.
+    void TestRemocaoEmLote() {
+        Smile::FScene Scene;
+        std::vector<Smile::u64> Ids;
+        for (int i = 0; i < 200; ++i) {
+            Smile::FRenderable R = Make(("M" + std::to_string(i)).c_str(), i + 1);
+            R.Parent = (i % 10 == 0) ? -1 : i - 1; // correntes de 10
+            R.Transform.Position = { 1.0f, 0.0f, 0.0f };
+            Ids.push_back(Scene.AddRenderable(R).Id);
+        }
+        Scene.UpdateWorldTransforms();
+        const Smile::f32 WorldX15 = Scene.Renderables()[15].World.M[3][0];
+
+        std::vector<Smile::u64> Doomed;
+        for (int i = 0; i < 200; i += 3) Doomed.push_back(Ids[i]);
+        Doomed.push_back(Ids[0]); // repetido
+        Doomed.push_back(0);
+        Doomed.push_back(999999);
+        const Smile::u64 VersaoEstrutura = Scene.StructureVersion();
+        Check(Scene.RemoveRenderables(Doomed) == 67, "lote: contagem removida");
+        Check(Scene.StructureVersion() != VersaoEstrutura, "lote: nao bumpou StructureVersion");
+        CheckIndexIsCoherent(Scene, "apos remover em lote");
+
+        bool Order = true, Gone = true;
+        std::size_t k = 0;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 3 == 0) { Gone = Gone && Scene.IndexOfRenderable(Ids[i]) == -1; continue; }
+            Order = Order && k < Scene.Renderables().size() && Scene.Renderables()[k++].Id == Ids[i];
+        }
+        Check(Order && k == Scene.Renderables().size(), "lote: ordem dos sobreviventes");
+        Check(Gone, "lote: removido ainda resolve");
+
+        // O 16 era filho do 15 (removido) e neto do 14: sobe para o 14 sem sair do lugar.
+        const int I14 = Scene.IndexOfRenderable(Ids[14]);
+        const int I16 = Scene.IndexOfRenderable(Ids[16]);
+        Check(I14 >= 0 && I16 >= 0 && Scene.Renderables()[I16].Parent == I14, "lote: neto nao subiu para o avo");
+        Scene.UpdateWorldTransforms();
+        Check(I16 >= 0 && std::fabs(Scene.Renderables()[I16].World.M[3][0] - (WorldX15 + 1.0f)) < 1e-4f,
+              "lote: neto saiu do lugar");
+        Check(Scene.RemoveRenderables(Doomed) == 0, "lote: remover de novo tirou algo");
+    }
+
+    // Luzes na mesma tabela: remover do meio re-ancora a cauda, e o Id da luz removida nao
+    // resolve como nada.
+    void TestRemocaoDeLuz() {
+        Smile::FScene Scene;
+        std::vector<Smile::u64> Ids;
+        for (int i = 0; i < 5; ++i) {
+            Smile::FLight L;
+            L.Name = "L" + std::to_string(i);
+            Ids.push_back(Scene.AddLight(L).Id);
+        }
+        Check(Scene.RemoveLight(Ids[1]), "luz: remover falhou");
+        Check(!Scene.RemoveLight(Ids[1]), "luz: remover duas vezes deu certo");
+        Check(!Scene.RemoveRenderable(Ids[2]), "luz: RemoveRenderable tirou uma luz");
+        Check(!Scene.FindObject(Ids[1]).IsValid(), "luz: Id removido ainda resolve");
+        for (std::size_t i = 0; i < Scene.Lights().size(); ++i) {
+            const Smile::FSceneObjectRef Ref = Scene.FindObject(Scene.Lights()[i].Id);
+            Check(Ref.IsLight() && Ref.Index == i, "luz: cauda nao re-ancorou");
+        }
+
+        // Luz que entrou por fora do AddLight: sem Id ate alguem garantir.
+        Smile::FLight Avulsa;
+        Scene.Lights().push_back(Avulsa);
+        const Smile::u32 Last = static_cast<Smile::u32>(Scene.Lights().size() - 1);
+        const Smile::u64 IdAvulsa = Scene.EnsureLightId(Last);
+        Check(IdAvulsa != 0 && Scene.EnsureLightId(Last) == IdAvulsa, "luz: EnsureLightId instavel");
+        Check(Scene.FindObject(IdAvulsa).IsLight() && Scene.FindObject(IdAvulsa).Index == Last,
+              "luz: avulsa nao resolve");
+        // Erase por fora: o Id nao pode passar a apontar para a vizinha.
+        Scene.Lights().erase(Scene.Lights().begin());
+        Check(!Scene.FindObject(Ids[0]).IsValid(), "luz: apagada por fora ainda resolve");
+    }
+
+    // O cache SoA acompanha a lista: montado no primeiro sync, intocado quando nada mudou, refeito
+    // por inteiro num bump sem indice e so no objeto marcado por MarkTransformDirty/MarkHotDirty.
+    // O PrevWorld guarda a matriz de antes por UM sync e depois alcanca o World.
+    void TestCacheSoaSegueAsMarcas() {
+        Smile::FScene Scene;
+        Smile::FRenderable A = Make("A", 1);
+        A.Transform.Position = { 1.0f, 2.0f, 3.0f };
+        Scene.AddRenderable(A);
+        Smile::FRenderable Rt = Make("Proxy", 2);
+        Rt.RaytracingOnly = true;
+        Scene.AddRenderable(Rt);
+
+        Check(Scene.SyncHotData(), "soa: primeiro sync nao montou o cache");
+        const Smile::FSceneHotData& Hot = Scene.Hot();
+        Check(Hot.Size() == 2, "soa: tamanho diferente da lista");
+        Check(Hot.World[0].M[3][0] == 1.0f && Hot.World[0].M[3][2] == 3.0f, "soa: matriz sem a translacao");
+        Check(Hot.PrevWorld[0].M[3][0] == 1.0f, "soa: objeto recem-montado com PrevWorld diferente");
+        Check(Hot.IsDrawCandidate(0) && !Hot.IsDrawCandidate(1), "soa: RaytracingOnly entrou como candidato");
+        Check(!Scene.SyncHotData(), "soa: sync sem mudanca refez o cache");
+
+        auto& List = Scene.Renderables();
+        // Os dois mudam, so o 0 e marcado: o 1 continua com a matriz velha no cache.
+        List[0].Transform.Position = { 5.0f, 0.0f, 0.0f };
+        List[1].Transform.Position = { 9.0f, 0.0f, 0.0f };
+        const Smile::u64 Version = Scene.TransformsVersion();
+        Scene.MarkTransformDirty(0);
+        Scene.MarkTransformDirty(0);
+        Check(Scene.TransformsVersion() > Version, "soa: MarkTransformDirty nao bumpou a versao");
+        Check(Scene.SyncHotData(), "soa: marca nao refez");
+        Check(Hot.World[0].M[3][0] == 5.0f && Hot.PrevWorld[0].M[3][0] == 1.0f, "soa: World/PrevWorld do marcado");
+        Check(Hot.World[1].M[3][0] == 0.0f, "soa: objeto nao marcado foi refeito");
+        Check(Scene.SyncHotData() && Hot.PrevWorld[0].M[3][0] == 5.0f, "soa: PrevWorld nao alcancou o World");
+        Check(!Scene.SyncHotData(), "soa: sync depois de assentar ainda refez");
+
+        // Bump sem indice: tudo.
+        List[0].Visible = false;
+        Scene.BumpTransformsVersion();
+        Check(Scene.SyncHotData(), "soa: bump de transform nao refez");
+        Check(Hot.World[1].M[3][0] == 9.0f && !Hot.IsDrawCandidate(0), "soa: bump nao refez a lista inteira");
+
+        List[0].Mobility = Smile::EMobility::Dynamic;
+        Scene.MarkHotDirty(0);
+        Check(Scene.SyncHotData() && (Hot.Flags[0] & Smile::kHotDynamic) != 0, "soa: mobilidade velha");
+
+        Check(Scene.RemoveRenderable(List[0].Id), "soa: remover falhou");
+        Check(Scene.SyncHotData() && Hot.Size() == 1 && !Hot.IsDrawCandidate(0),
+              "soa: remocao nao reindexou o cache");
+        Scene.MarkTransformDirty(7); // fora da lista: ignorado
+        Check(!Scene.SyncHotData(), "soa: indice fora da lista marcou algo");
+    }
+
+    // O BVH da cena so e posto em dia na consulta: syncs sem consulta (o gizmo arrastando) so
+    // anotam quem se moveu, a consulta seguinte ve as caixas novas, e o sync que so assenta o
+    // PrevWorld nao deixa refit nenhum para tras.
+    void TestBvhNaConsulta() {
+        Smile::FScene Scene;
+        for (int i = 0; i < 8; ++i) {
+            Smile::FRenderable R = Make("B", static_cast<std::uintptr_t>(i + 1));
+            R.LocalAABBMin       = { -0.5f, -0.5f, -0.5f };
+            R.LocalAABBMax       = { 0.5f, 0.5f, 0.5f };
+            R.Transform.Position = { 4.0f * static_cast<Smile::f32>(i), 0.0f, 0.0f };
+            Scene.AddRenderable(R);
+        }
+        Check(Scene.SyncHotData(), "bvh: primeiro sync nao montou o cache");
+        Check(Scene.Bvh().Size() == 8 && Scene.Bvh().RefitNodeCount() == 0, "bvh: consulta nao montou a arvore");
+
+        auto& List = Scene.Renderables();
+        for (int f = 1; f <= 3; ++f) {
+            List[0].Transform.Position = { -10.0f * static_cast<Smile::f32>(f), 0.0f, 0.0f };
+            Scene.MarkTransformDirty(0);
+            Check(Scene.SyncHotData(), "bvh: marca nao refez");
+        }
+        const Smile::u64 Refits = Scene.Bvh().RefitNodeCount();
+        Check(Refits > 0, "bvh: consulta nao aplicou os movimentos anotados");
+        Check(Scene.Bvh().NodeList()[0].Min.X == -30.5f, "bvh: raiz sem a caixa nova");
+        const Smile::FSceneObjectRef Hit = Scene.PickRenderable({ -30.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 1.0f });
+        Check(Hit.IsRenderable() && Hit.Id == List[0].Id, "bvh: picking nao achou o objeto na posicao nova");
+
+        Check(Scene.SyncHotData(), "bvh: sync de assentamento nao refez");
+        Check(Scene.Bvh().RefitNodeCount() == Refits, "bvh: sync que so assenta deixou refit");
+    }
+
+    // O que as listas de draw do renderer leem entre frames: HotVersion sobe so em sync que mudou
+    // algo, e o HotChanged diz quem — o marcado, e no sync seguinte ele de novo (PrevWorld).
+    void TestVersaoDoCacheSoa() {
+        Smile::FScene Scene;
+        Scene.AddRenderable(Make("A", 1));
+        Scene.AddRenderable(Make("B", 2));
+        Scene.AddRenderable(Make("C", 3));
+
+        Check(Scene.SyncHotData() && Scene.HotChangedAll(), "versao: montagem nao marcou tudo");
+        const Smile::u64 Built = Scene.HotVersion();
+        Check(!Scene.SyncHotData() && Scene.HotVersion() == Built, "versao: sync sem mudanca subiu a versao");
+
+        auto& List = Scene.Renderables();
+        List[1].Transform.Position = { 4.0f, 0.0f, 0.0f };
+        Scene.MarkTransformDirty(1);
+        Check(Scene.SyncHotData() && Scene.HotVersion() == Built + 1, "versao: marca nao subiu uma");
+        Check(!Scene.HotChangedAll() && Scene.HotChanged().size() == 1 && Scene.HotChanged()[0] == 1,
+              "versao: marca nao listou so o 1");
+        Check(Scene.SyncHotData() && !Scene.HotChangedAll() && Scene.HotChanged().size() == 1 &&
+              Scene.HotChanged()[0] == 1, "versao: assentar o PrevWorld nao listou o 1");
+        Check(!Scene.SyncHotData() && Scene.HotVersion() == Built + 2, "versao: depois de assentar ainda mudou");
+
+        List[2].Visible = false;
+        Scene.MarkHotDirty(2);
+        Check(Scene.SyncHotData() && Scene.HotChanged().size() == 1 && Scene.HotChanged()[0] == 2,
+              "versao: flag nao listou o 2");
+
+        Scene.BumpTransformsVersion();
+        Check(Scene.SyncHotData() && Scene.HotChangedAll(), "versao: bump sem indice nao marcou tudo");
+        Check(Scene.SyncHotData() && Scene.HotChangedAll(), "versao: assentar depois do bump nao marcou tudo");
+    }
+
+    // Hierarquia: mover o pai leva o filho (e so ele), o editor fala em mundo, e remover o pai
+    // sobe o filho para o avo sem tira-lo do lugar.
+    void TestHierarquia() {
+        Smile::FScene Scene;
+        Smile::FRenderable Root = Make("Raiz", 1);
+        Root.Transform.Position = { 1.0f, 0.0f, 0.0f };
+        Scene.AddRenderable(Root);
+        Smile::FRenderable Child = Make("Filho", 2);
+        Child.Parent = 0;
+        Child.Transform.Position = { 0.0f, 2.0f, 0.0f };
+        Scene.AddRenderable(Child);
+        Smile::FRenderable Grand = Make("Neto", 3);
+        Grand.Parent = 1;
+        Grand.Transform.Position = { 0.0f, 0.0f, 3.0f };
+        Grand.LocalAABBMin = { -1.0f, -1.0f, -1.0f };
+        Grand.LocalAABBMax = {  1.0f,  1.0f,  1.0f };
+        Scene.AddRenderable(Grand);
+        Scene.AddRenderable(Make("Solto", 4));
+
+        Check(Scene.SyncHotData(), "hierarquia: montagem");
+        const auto& List = Scene.Renderables();
+        const Smile::FSceneHotData& Hot = Scene.Hot();
+        Check(Hot.World[2].M[3][0] == 1.0f && Hot.World[2].M[3][1] == 2.0f && Hot.World[2].M[3][2] == 3.0f,
+              "hierarquia: neto sem o mundo composto");
+
+        Scene.Renderables()[0].Transform.Position = { 5.0f, 0.0f, 0.0f };
+        Scene.MarkTransformDirty(0);
+        Check(Scene.SyncHotData(), "hierarquia: mover o pai nao refez");
+        Check(!Scene.HotChangedAll() && Scene.HotChanged().size() == 3, "hierarquia: mover o pai nao listou so a subarvore");
+        Check(Hot.World[2].M[3][0] == 5.0f && List[2].AABBMin.X == 4.0f, "hierarquia: neto nao acompanhou o pai");
+        Check(Hot.World[3].M[3][0] == 0.0f, "hierarquia: objeto solto foi refeito");
+
+        // Mundo -> local do pai.
+        Scene.SetWorldTransform(1, { { 0.0f, 0.0f, 0.0f }, {}, { 1.0f, 1.0f, 1.0f } });
+        Check(List[1].Transform.Position.X == -5.0f, "hierarquia: SetWorldTransform nao converteu para local");
+        Scene.UpdateWorldTransforms();
+        Check(List[2].World.M[3][0] == 0.0f && List[1].WorldTransform().Position.X == 0.0f,
+              "hierarquia: mundo pedido nao bateu");
+
+        // Remove o filho do meio: o neto sobe para a raiz 0 e fica onde estava.
+        const Smile::Mat44 Before = List[2].World;
+        Check(Scene.RemoveRenderable(List[1].Id), "hierarquia: remover falhou");
+        Check(List[1].Parent == 0, "hierarquia: neto nao subiu para o avo");
+        Scene.SyncHotData();
+        Check(std::fabs(List[1].World.M[3][0] - Before.M[3][0]) < 1e-4f &&
+              std::fabs(List[1].World.M[3][2] - Before.M[3][2]) < 1e-4f, "hierarquia: neto saiu do lugar");
+        Check(List[2].Parent == -1, "hierarquia: raiz ganhou pai na remocao");
+    }
 }
 
 int main() {
@@ -235,6 +474,12 @@ int main() {
     TestClearNaoReciclaIds();
     TestIdentidadeUnicaEntreMeshELuz();
     TestCicloDeEdicao();
+    TestRemocaoEmLote();
+    TestRemocaoDeLuz();
+    TestCacheSoaSegueAsMarcas();
+    TestBvhNaConsulta();
+    TestVersaoDoCacheSoa();
+    TestHierarquia();
 
     if (Failures == 0) {
         std::cout << "  OK\n";
@@ -0,0 +1,292 @@
+// Contrato do .smap v2 (Smile/Scene/SceneMap.h).
+//
+// Round trip: encode -> parse devolve os mesmos registros, nomes inclusive, sobre os bytes do
+// arquivo. Parse rejeita magic/versao errados, tabela truncada ou desalinhada, bytes sobrando e
+// nome fora do blob. A exportacao JSON segue o schema da v1 (transform so com kSMapTransform,
+// chaves de default omitidas) e os floats voltam ao MESMO bit por strtof. FCookedIndexMap
+// devolve -1 para o que nao existe.
+//
+// `SmileSceneMapTests --bench` mede 10k, 100k e 1M overrides: encode + parse + apply pela tabela
+// densa contra a exportacao JSON e um apply indexado por std::unordered_map (o papel do QHash da
+// v1). O DOM do QJsonDocument so existe no editor; o texto JSON e o proxy CPU dele.
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Smile/Scene/SceneMap.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    Smile::SSceneMapOverride MakeOverride(Smile::i32 _Cooked, Smile::u32 _Flags) {
+        Smile::SSceneMapOverride O{};
+        O.Cooked = _Cooked;
+        O.Flags  = _Flags;
+        for (int A = 0; A < 3; ++A) {
+            O.Position[A] = 0.1f * float(_Cooked) + float(A);
+            O.Rotation[A] = 0.3f * float(A + 1);
+            O.Scale[A]    = 1.0f + 0.25f * float(A);
+        }
+        return O;
+    }
+
+    Smile::FSceneMap MakeMap() {
+        Smile::FSceneMap Map;
+        Map.Overrides.push_back(MakeOverride(0, Smile::kSMapTransform));
+        Map.Overrides.push_back(MakeOverride(3, Smile::kSMapHidden));
+        Map.Overrides.push_back(MakeOverride(7, Smile::kSMapDynamic | Smile::kSMapTransform));
+        Smile::SSceneMapSpawn S{};
+        S.From  = 2;
+        S.Flags = Smile::kSMapTransform;
+        S.Position[0] = 1.0f / 3.0f;
+        S.Scale[0] = S.Scale[1] = S.Scale[2] = 1.0f;
+        Map.AddSpawn(S, "Cadeira \"copia\"");
+        S.From  = 5;
+        S.Flags = Smile::kSMapHidden;
+        Map.AddSpawn(S, "");
+        Map.Deleted = { 4, 9 };
+        return Map;
+    }
+
+    bool SameBytes(const void* _A, const void* _B, size_t _Size) { return std::memcmp(_A, _B, _Size) == 0; }
+
+    // Copia para um buffer de u32: o vector<u8> do encoder so garante alinhamento de 1, e o parse
+    // exige o do registro.
+    std::vector<Smile::u32> Aligned(const std::vector<Smile::u8>& _Bytes) {
+        std::vector<Smile::u32> Out((_Bytes.size() + 3) / 4 + 1, 0u);
+        std::memcpy(Out.data(), _Bytes.data(), _Bytes.size());
+        return Out;
+    }
+
+    std::span<const Smile::u8> AsBytes(const std::vector<Smile::u32>& _Storage, size_t _Size, size_t _Shift = 0) {
+        return { reinterpret_cast<const Smile::u8*>(_Storage.data()) + _Shift, _Size };
+    }
+
+    void TestRoundTrip() {
+        const Smile::FSceneMap Map = MakeMap();
+        const std::vector<Smile::u8> Bytes = Smile::EncodeSceneMap(Map.View());
+        Check(Bytes.size() == sizeof(Smile::SSceneMapHeader) + 3 * sizeof(Smile::SSceneMapOverride) +
+                                  2 * sizeof(Smile::SSceneMapSpawn) + 2 * sizeof(Smile::i32) + Map.Names.size(),
+              "tamanho do arquivo difere da soma das tabelas");
+
+        const std::vector<Smile::u32> Storage = Aligned(Bytes);
+        const std::span<const Smile::u8> File = AsBytes(Storage, Bytes.size());
+        Check(Smile::IsBinarySceneMap(File), "magic nao reconhecido");
+
+        Smile::FSceneMapView View;
+        std::string Error;
+        Check(Smile::ParseSceneMap(File, View, Error), "parse falhou: " + Error);
+        Check(View.Overrides.size() == 3 && View.Spawned.size() == 2 && View.Deleted.size() == 2,
+              "contagens do parse");
+        if (View.Overrides.size() == 3)
+            Check(SameBytes(View.Overrides.data(), Map.Overrides.data(), View.Overrides.size_bytes()),
+                  "overrides diferentes");
+        if (View.Spawned.size() == 2) {
+            Check(SameBytes(View.Spawned.data(), Map.Spawned.data(), View.Spawned.size_bytes()), "criados diferentes");
+            Check(View.NameOf(View.Spawned[0]) == "Cadeira \"copia\"", "nome do criado");
+            Check(View.NameOf(View.Spawned[1]).empty(), "nome vazio virou outra coisa");
+        }
+        if (View.Deleted.size() == 2) Check(View.Deleted[0] == 4 && View.Deleted[1] == 9, "apagados");
+        // Zero-copy: as views apontam para dentro dos bytes recebidos.
+        Check(reinterpret_cast<const Smile::u8*>(View.Overrides.data()) == File.data() + sizeof(Smile::SSceneMapHeader),
+              "overrides nao sao uma view sobre o arquivo");
+
+        // Mapa vazio: so o header, e parse valido.
+        const std::vector<Smile::u8> Empty = Smile::EncodeSceneMap(Smile::FSceneMap{}.View());
+        const std::vector<Smile::u32> EmptyStorage = Aligned(Empty);
+        Check(Empty.size() == sizeof(Smile::SSceneMapHeader), "mapa vazio maior que o header");
+        Check(Smile::ParseSceneMap(AsBytes(EmptyStorage, Empty.size()), View, Error) && View.Overrides.empty(),
+              "mapa vazio rejeitado");
+    }
+
+    void TestRejeita() {
+        const Smile::FSceneMap Map = MakeMap();
+        const std::vector<Smile::u8> Good = Smile::EncodeSceneMap(Map.View());
+        Smile::FSceneMapView View;
+        std::string Error;
+
+        auto Parse = [&](std::vector<Smile::u8> _Bytes, size_t _Shift = 0) {
+            std::vector<Smile::u32> Storage((_Bytes.size() + _Shift + 3) / 4 + 1, 0u);
+            std::memcpy(reinterpret_cast<Smile::u8*>(Storage.data()) + _Shift, _Bytes.data(), _Bytes.size());
+            Error.clear();
+            return Smile::ParseSceneMap(AsBytes(Storage, _Bytes.size(), _Shift), View, Error);
+        };
+        auto Patch = [&](size_t _Offset, Smile::u32 _Value) {
+            std::vector<Smile::u8> Bytes = Good;
+            std::memcpy(Bytes.data() + _Offset, &_Value, sizeof(_Value));
+            return Bytes;
+        };
+
+        Check(Parse(Good), "controle: arquivo bom rejeitado");
+        Check(!Parse({ Good.begin(), Good.begin() + 10 }), "header truncado aceito");
+        Check(!Parse(Patch(0, 0x7B0A2020u)), "magic errado aceito");
+        Check(!Parse(Patch(4, 1u)) && Error.find("v1") != std::string::npos, "versao errada aceita ou sem mensagem");
+        Check(!Parse(Patch(8, 1000u)), "contagem de overrides alem do arquivo aceita");
+        Check(!Parse(Patch(12, 0xFFFFFFFFu)), "contagem de criados gigante aceita");
+        Check(!Parse({ Good.begin(), Good.end() - 1 }), "blob de nomes truncado aceito");
+        std::vector<Smile::u8> Extra = Good;
+        Extra.push_back(0);
+        Check(!Parse(Extra), "byte sobrando aceito");
+        Check(!Parse(Good, 2), "arquivo desalinhado aceito");
+        // NameOffset do primeiro criado para fora do blob.
+        const size_t Spawn0 = sizeof(Smile::SSceneMapHeader) + 3 * sizeof(Smile::SSceneMapOverride);
+        Check(!Parse(Patch(Spawn0 + offsetof(Smile::SSceneMapSpawn, NameOffset), 1000u)), "nome fora do blob aceito");
+        Check(!Smile::IsBinarySceneMap(std::span<const Smile::u8>(
+                  reinterpret_cast<const Smile::u8*>("{\n  \"version\": 1"), 16)),
+              "JSON da v1 tomado por binario");
+    }
+
+    // Proximo numero de `_Json` a partir de `_From`; avanca `_From` para depois dele.
+    float NextFloat(const std::string& _Json, size_t& _From) {
+        const size_t Start = _Json.find_first_of("-0123456789", _From);
+        char* End = nullptr;
+        const float V = std::strtof(_Json.c_str() + Start, &End);
+        _From = size_t(End - _Json.c_str());
+        return V;
+    }
+
+    void TestJson() {
+        Smile::FSceneMap Map = MakeMap();
+        Map.Overrides[0].Position[1] = 0.1f + 1e-7f; // sem representacao curta em decimal
+        Map.Overrides[0].Rotation[2] = -3.4028235e38f;
+        const std::string Json = Smile::SceneMapToJson(Map.View());
+
+        Check(Json.find("\"version\": 1") != std::string::npos, "JSON sem version 1");
+        Check(Json.find("{ \"cooked\": 3, \"visible\": false }") != std::string::npos,
+              "override so de visibilidade nao e minimo");
+        Check(Json.find("\"cooked\": 7, \"pos\"") != std::string::npos &&
+                  Json.find("\"dynamic\": true") != std::string::npos,
+              "override dinamico com transform");
+        Check(Json.find("\"name\": \"Cadeira \\\"copia\\\"\"") != std::string::npos, "nome sem escape");
+        Check(Json.find("\"deleted\": [4, 9]") != std::string::npos, "apagados");
+
+        // Floats: o texto volta ao mesmo bit.
+        size_t At = Json.find("\"pos\"");
+        bool Same = At != std::string::npos;
+        const Smile::SSceneMapOverride& O = Map.Overrides[0];
+        for (const Smile::f32* Field : { O.Position, O.Rotation, O.Scale })
+            for (int A = 0; A < 3 && Same; ++A) {
+                const float V = NextFloat(Json, At);
+                Same = SameBytes(&V, &Field[A], sizeof(V));
+            }
+        Check(Same, "float do JSON nao volta ao mesmo bit");
+
+        const std::string EmptyJson = Smile::SceneMapToJson(Smile::FSceneMap{}.View());
+        Check(EmptyJson.find("\"overrides\": []") != std::string::npos &&
+                  EmptyJson.find("\"spawned\": []") != std::string::npos,
+              "mapa vazio nao gera listas vazias");
+    }
+
+    void TestIndexMap() {
+        Smile::FCookedIndexMap Map;
+        Map.Reset(4);
+        Map.Set(0, 10);
+        Map.Set(3, 7);
+        Map.Set(6, 2); // alem do Reset: cresce
+        Map.Set(-1, 5); // ignorado
+        Check(Map.Find(0) == 10 && Map.Find(3) == 7 && Map.Find(6) == 2, "Find devolve o que Set gravou");
+        Check(Map.Find(1) == -1 && Map.Find(5) == -1, "buraco nao e -1");
+        Check(Map.Find(-1) == -1 && Map.Find(100) == -1, "fora da faixa nao e -1");
+    }
+
+    // Cena minima do bench: so o que o passo 1 do Apply toca.
+    struct FBenchObject {
+        float Position[3], Rotation[3], Scale[3];
+        bool  Visible = true, Dynamic = false;
+    };
+
+    template <typename FindFn>
+    void ApplyOverrides(std::span<const Smile::SSceneMapOverride> _Overrides, std::vector<FBenchObject>& _Scene,
+                        FindFn&& _Find) {
+        for (const Smile::SSceneMapOverride& O : _Overrides) {
+            const Smile::i32 Live = _Find(O.Cooked);
+            if (Live < 0) continue;
+            FBenchObject& R = _Scene[size_t(Live)];
+            R.Visible = (O.Flags & Smile::kSMapHidden) == 0;
+            if (O.Flags & Smile::kSMapTransform) {
+                std::memcpy(R.Position, O.Position, sizeof(R.Position));
+                std::memcpy(R.Rotation, O.Rotation, sizeof(R.Rotation));
+                std::memcpy(R.Scale, O.Scale, sizeof(R.Scale));
+            }
+            if (O.Flags & Smile::kSMapDynamic) R.Dynamic = true;
+        }
+    }
+
+    void Bench(Smile::u32 _Count) {
+        using Clock = std::chrono::steady_clock;
+        auto Ms = [](Clock::time_point _A, Clock::time_point _B) {
+            return std::chrono::duration<double, std::milli>(_B - _A).count();
+        };
+
+        Smile::FSceneMap Map;
+        Map.Overrides.reserve(_Count);
+        for (Smile::u32 I = 0; I < _Count; ++I)
+            Map.Overrides.push_back(
+                MakeOverride(Smile::i32(I), Smile::kSMapTransform | (I % 7 ? 0u : Smile::kSMapHidden)));
+
+        auto T0 = Clock::now();
+        const std::vector<Smile::u8> Bytes = Smile::EncodeSceneMap(Map.View());
+        auto T1 = Clock::now();
+        const std::string Json = Smile::SceneMapToJson(Map.View());
+        auto T2 = Clock::now();
+
+        const std::vector<Smile::u32> Storage = Aligned(Bytes);
+        std::vector<FBenchObject> Scene(_Count), HashScene(_Count);
+        auto T3 = Clock::now();
+        Smile::FSceneMapView View;
+        std::string Error;
+        const bool Parsed = Smile::ParseSceneMap(AsBytes(Storage, Bytes.size()), View, Error);
+        Smile::FCookedIndexMap Dense;
+        Dense.Reset(_Count);
+        for (Smile::u32 I = 0; I < _Count; ++I) Dense.Set(Smile::i32(I), Smile::i32(I));
+        ApplyOverrides(View.Overrides, Scene, [&](Smile::i32 _C) { return Dense.Find(_C); });
+        auto T4 = Clock::now();
+
+        std::unordered_map<Smile::i32, Smile::i32> Hash;
+        for (Smile::u32 I = 0; I < _Count; ++I) Hash.emplace(Smile::i32(I), Smile::i32(I));
+        ApplyOverrides(Map.Overrides, HashScene, [&](Smile::i32 _C) {
+            const auto It = Hash.find(_C);
+            return It == Hash.end() ? -1 : It->second;
+        });
+        auto T5 = Clock::now();
+
+        std::cout << "  bench " << _Count << " overrides: binario " << Bytes.size() / 1024 << " KB (encode "
+                  << Ms(T0, T1) << " ms, parse+apply denso " << Ms(T3, T4) << " ms) | JSON " << Json.size() / 1024
+                  << " KB (export " << Ms(T1, T2) << " ms) | apply via hash " << Ms(T4, T5) << " ms\n";
+        Check(Parsed, "bench: parse falhou");
+        Check(SameBytes(Scene.data(), HashScene.data(), Scene.size() * sizeof(FBenchObject)),
+              "bench: apply denso e via hash divergem");
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.SceneMap\n";
+    TestRoundTrip();
+    TestRejeita();
+    TestJson();
+    TestIndexMap();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench")
+        for (const Smile::u32 Count : { 10000u, 100000u, 1000000u }) Bench(Count);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
@@ -0,0 +1,256 @@
+// Pool de tarefas do load (Smile/Core/TaskPool.h).
+//
+// O contrato que o LoadCookedSceneData usa: toda tarefa do lote roda exatamente uma vez e o Run so
+// volta depois da ultima; os tempos voltam na ordem do lote; cada thread comeca pela maior tarefa
+// que lhe coube (a maior de todas com quem chamou); uma thread que trava na sua tarefa tem a fila
+// esvaziada pelas outras (roubo); e o Run aninhado roda inline na ordem do custo (LPT exato).
+//
+// `SmileTaskPoolTests --bench` simula o load de uma cena num build box de 32 threads (tarefas de
+// sleep com custo muito desigual): a fila antiga de ate 8 workers na ordem de entrada contra o pool.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Smile/Core/TaskPool.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::u32;
+    using Smile::u64;
+    using Smile::FLoadTask;
+    using Smile::FLoadTaskTiming;
+    using Smile::FTaskPool;
+    using Smile::ELoadTaskKind;
+    using Clock = std::chrono::steady_clock;
+
+    // Custos com muitos empates, fora de ordem.
+    std::vector<u64> MakeCosts(u32 _Count, u32 _Seed) {
+        std::mt19937 Rng(_Seed);
+        std::uniform_int_distribution<int> D(0, 15);
+        std::vector<u64> Out(_Count);
+        for (u64& C : Out) C = static_cast<u64>(D(Rng)) * 1000u;
+        return Out;
+    }
+
+    // Indices do lote na ordem LPT: custo decrescente, empate na ordem de entrada.
+    std::vector<u32> LptOrder(const std::vector<u64>& _Costs) {
+        std::vector<u32> Order(_Costs.size());
+        std::iota(Order.begin(), Order.end(), 0u);
+        std::stable_sort(Order.begin(), Order.end(), [&](u32 _A, u32 _B) { return _Costs[_A] > _Costs[_B]; });
+        return Order;
+    }
+
+    void TestCobertura(FTaskPool& _Pool, const std::string& _Tag) {
+        for (const u32 Count : { 0u, 1u, 2u, 7u, 64u, 1001u }) {
+            const std::vector<u64> Costs = MakeCosts(Count, Count + 1);
+            std::vector<std::atomic<u32>> Hits(Count);
+            std::vector<FLoadTask> Tasks(Count);
+            for (u32 i = 0; i < Count; ++i) {
+                Tasks[i].Kind = (i % 3 == 0) ? ELoadTaskKind::Mesh : ELoadTaskKind::Texture;
+                Tasks[i].Name = "t" + std::to_string(i);
+                Tasks[i].Cost = Costs[i];
+                Tasks[i].Fn   = [&Hits, i] { Hits[i].fetch_add(1, std::memory_order_relaxed); };
+            }
+            const std::vector<FLoadTaskTiming> Timings = _Pool.Run(Tasks);
+            bool Once = true, Labels = true, Threads = true;
+            std::vector<u32> Orders;
+            for (u32 i = 0; i < Count; ++i) {
+                Once = Once && Hits[i].load() == 1;
+                Labels = Labels && Timings[i].Name == Tasks[i].Name && Timings[i].Kind == Tasks[i].Kind &&
+                         Timings[i].Cost == Costs[i];
+                Threads = Threads && Timings[i].Thread < _Pool.ThreadCount() && Timings[i].Ms >= 0.0;
+                Orders.push_back(Timings[i].Order);
+            }
+            std::sort(Orders.begin(), Orders.end());
+            bool Permutation = true;
+            for (u32 i = 0; i < Count; ++i) Permutation = Permutation && Orders[i] == i;
+            const std::string Where = " (" + std::to_string(Count) + " tarefas)";
+            Check(Timings.size() == Count, _Tag + ": um tempo por tarefa" + Where);
+            Check(Once, _Tag + ": tarefa fora de exatamente uma execucao" + Where);
+            Check(Labels, _Tag + ": tempos fora da ordem do lote" + Where);
+            Check(Threads, _Tag + ": thread/tempo invalido" + Where);
+            Check(Permutation, _Tag + ": Order nao e uma permutacao do lote" + Where);
+        }
+    }
+
+    void TestInlineLpt(FTaskPool& _Pool, const std::string& _Tag) {
+        // Run de dentro de uma tarefa: inline, na ordem exata do LPT, tudo na mesma thread.
+        const std::vector<u64> Costs = MakeCosts(200, 11);
+        std::vector<u32> Ran;
+        std::vector<FLoadTaskTiming> Inner;
+        std::vector<FLoadTask> Outer(1);
+        Outer[0].Fn = [&] {
+            std::vector<FLoadTask> Tasks(Costs.size());
+            for (u32 i = 0; i < Tasks.size(); ++i) {
+                Tasks[i].Cost = Costs[i];
+                Tasks[i].Fn   = [&Ran, i] { Ran.push_back(i); };
+            }
+            Inner = _Pool.Run(Tasks);
+        };
+        // Lote de uma tarefa tambem roda inline: da a volta pelos workers com um segundo Run.
+        std::vector<FLoadTask> Batch(3);
+        Batch[0] = std::move(Outer[0]);
+        Batch[0].Cost = 10;
+        for (u32 i = 1; i < 3; ++i) Batch[i].Fn = [] {};
+        _Pool.Run(Batch);
+
+        Check(Ran == LptOrder(Costs), _Tag + ": Run aninhado fora da ordem LPT");
+        bool SameThread = true, OrderMatches = true;
+        for (u32 i = 0; i < Ran.size(); ++i) OrderMatches = OrderMatches && Inner[Ran[i]].Order == i;
+        for (const FLoadTaskTiming& T : Inner) SameThread = SameThread && T.Thread == 0;
+        Check(OrderMatches, _Tag + ": Order do Run aninhado difere da execucao");
+        Check(SameThread, _Tag + ": Run aninhado saiu da thread");
+    }
+
+    void TestMaioresPrimeiro(FTaskPool& _Pool, const std::string& _Tag) {
+        // Lote de 4 tarefas por thread, todas com sleep: ninguem esvazia a propria fila antes de
+        // as outras comecarem, entao a k-esima maior abre a fila da thread k — a maior, com quem
+        // chamou.
+        const u32 Threads = _Pool.ThreadCount();
+        const u32 Count = Threads * 4;
+        std::vector<FLoadTask> Tasks(Count);
+        for (u32 i = 0; i < Count; ++i) {
+            Tasks[i].Cost = (i * 37u) % Count + 1; // permutacao de 1..Count, sem empate
+            Tasks[i].Fn   = [] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); };
+        }
+        const std::vector<FLoadTaskTiming> Timings = _Pool.Run(Tasks);
+        bool Fronts = true;
+        for (u32 i = 0; i < Count; ++i) {
+            const u64 Rank = Count - Timings[i].Cost; // 0 = a maior
+            if (Rank < Threads) Fronts = Fronts && Timings[i].Thread == Rank;
+        }
+        Check(Fronts, _Tag + ": as " + std::to_string(Threads) + " maiores nao abriram uma fila cada");
+    }
+
+    void TestRoubo(FTaskPool& _Pool, const std::string& _Tag) {
+        // A maior tarefa espera todas as outras terminarem: so acaba se as threads livres roubarem
+        // o resto da fila de quem a pegou. Timeout para falhar em vez de travar.
+        if (_Pool.ThreadCount() < 2) return;
+        const u32 Count = 64;
+        std::atomic<u32> Done{ 0 };
+        bool TimedOut = false;
+        std::vector<FLoadTask> Tasks(Count);
+        Tasks[0].Cost = 1000;
+        Tasks[0].Fn = [&] {
+            const Clock::time_point T0 = Clock::now();
+            while (Done.load() != Count - 1) {
+                if (Clock::now() - T0 > std::chrono::seconds(10)) { TimedOut = true; return; }
+                std::this_thread::yield();
+            }
+        };
+        for (u32 i = 1; i < Count; ++i) {
+            Tasks[i].Cost = i;
+            Tasks[i].Fn   = [&] { Done.fetch_add(1); };
+        }
+        const std::vector<FLoadTaskTiming> Timings = _Pool.Run(Tasks);
+        // Um worker que esvaziou a propria fila antes de quem chama acordar pode ter roubado a
+        // maior: vale a thread que a rodou, e nada pode ter comecado nela depois.
+        Check(!TimedOut, _Tag + ": fila da thread ocupada nao foi roubada");
+        bool Stolen = true;
+        for (u32 i = 1; i < Count; ++i)
+            Stolen = Stolen && (Timings[i].Thread != Timings[0].Thread || Timings[i].Order < Timings[0].Order);
+        Check(Stolen, _Tag + ": tarefa rodou na thread travada");
+    }
+
+    void TestRepetido(FTaskPool& _Pool, const std::string& _Tag) {
+        // Muitos lotes pequenos seguidos (worker atrasado do lote anterior) e dois chamadores ao
+        // mesmo tempo (Run serializado).
+        std::atomic<u32> Sum{ 0 };
+        auto Caller = [&] {
+            for (u32 r = 0; r < 300; ++r) {
+                std::vector<FLoadTask> Tasks(r % 5 + 2);
+                for (u32 i = 0; i < Tasks.size(); ++i) {
+                    Tasks[i].Cost = i;
+                    Tasks[i].Fn   = [&Sum] { Sum.fetch_add(1, std::memory_order_relaxed); };
+                }
+                _Pool.Run(Tasks);
+            }
+        };
+        u32 Expected = 0;
+        for (u32 r = 0; r < 300; ++r) Expected += r % 5 + 2;
+        {
+            std::jthread Other(Caller);
+            Caller();
+        }
+        Check(Sum.load() == 2 * Expected, _Tag + ": lotes repetidos perderam tarefas");
+    }
+
+    void Bench() {
+        // Build box de 32 threads: o loader antigo usava min(32 - 2, 8) workers tirando de uma
+        // fila atomica na ordem de entrada (meshes, depois texturas na ordem do mapa); o pool usa
+        // 30 workers + quem chama, maior primeiro. Tarefas de sleep: o resultado independe dos
+        // cores desta maquina. Cena tipo Bistro: 400 meshes de 0,2-2 ms e 150 texturas, 12 delas
+        // 4K (~60 ms) espalhadas.
+        std::mt19937 Rng(5);
+        std::vector<u32> Micros;
+        for (u32 i = 0; i < 400; ++i) Micros.push_back(200 + Rng() % 1800);
+        for (u32 i = 0; i < 150; ++i) Micros.push_back(i % 12 == 5 ? 60000 : 3000 + Rng() % 12000);
+        auto Sleep = [](u32 _Us) { std::this_thread::sleep_for(std::chrono::microseconds(_Us)); };
+        double SumMs = 0.0;
+        for (const u32 Us : Micros) SumMs += Us / 1000.0;
+
+        const Clock::time_point S0 = Clock::now();
+        {
+            std::atomic<size_t> Next{ 0 };
+            std::vector<std::jthread> Workers;
+            for (u32 w = 0; w < 8; ++w)
+                Workers.emplace_back([&] {
+                    for (size_t j = Next++; j < Micros.size(); j = Next++) Sleep(Micros[j]);
+                });
+        }
+        const double Stripes = std::chrono::duration<double, std::milli>(Clock::now() - S0).count();
+
+        FTaskPool Pool(30);
+        std::vector<FLoadTask> Tasks(Micros.size());
+        for (u32 i = 0; i < Micros.size(); ++i) {
+            Tasks[i].Cost = Micros[i];
+            Tasks[i].Fn   = [&, i] { Sleep(Micros[i]); };
+        }
+        const Clock::time_point P0 = Clock::now();
+        Pool.Run(Tasks);
+        const double Pooled = std::chrono::duration<double, std::milli>(Clock::now() - P0).count();
+
+        std::cout << "  bench " << Micros.size() << " tarefas (soma " << SumMs << " ms, maior 60 ms): "
+                  << "fila de 8 na ordem " << Stripes << " ms | pool de " << Pool.ThreadCount()
+                  << " threads, maior primeiro " << Pooled << " ms (" << Stripes / Pooled << "x)\n";
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.TaskPool\n";
+    Check(FTaskPool::DefaultWorkerCount() >= 1, "DefaultWorkerCount sem worker");
+    for (const u32 Workers : { 1u, 3u, 7u, 0u }) {
+        FTaskPool Pool(Workers);
+        const std::string Tag = std::to_string(Pool.ThreadCount()) + " threads";
+        Check(Workers == 0 || Pool.ThreadCount() == Workers + 1, Tag + ": ThreadCount");
+        TestCobertura(Pool, Tag);
+        TestInlineLpt(Pool, Tag);
+        TestMaioresPrimeiro(Pool, Tag);
+        TestRoubo(Pool, Tag);
+        TestRepetido(Pool, Tag);
+    }
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench") Bench();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
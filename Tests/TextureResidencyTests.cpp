@@ -0,0 +1,308 @@
+// Politica de residencia do streaming de mips (Smile/Graphics/Resources/TextureResidency.h).
+//
+// O que o FTextureStreamer assume dela: as contas de bytes batem com o layout BCn; a demanda
+// anda uma mip por dobra de distancia/densidade e soma o MipBias; carga vai da mip grossa para a
+// fina com todas as texturas com falta progredindo juntas; o budget nunca estoura (quando as
+// caudas cabem); o despejo segue LRU e nao tira o que o frame pediu; e cada textura tem no maximo
+// uma mudanca em voo. O ultimo teste roda uma camera aleatoria por centenas de frames checando os
+// invariantes a cada Update.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Smile/Graphics/Resources/TextureResidency.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    using Smile::f32;
+    using Smile::u32;
+    using Smile::u64;
+    using Smile::FResidencyChange;
+    using Smile::FStreamedTextureDesc;
+    using Smile::FTextureResidency;
+    using Smile::FTextureResidencyOptions;
+
+    constexpr u64 kMiB = 1024ull * 1024;
+
+    FStreamedTextureDesc Bc7(u32 _Size) {
+        FStreamedTextureDesc D;
+        D.Width = D.Height = _Size;
+        D.MipCount = static_cast<u32>(std::log2(_Size)) + 1;
+        return D;
+    }
+
+    // Aplica as mudancas do Update como o streamer (todas terminam antes do proximo frame).
+    void CompleteAll(FTextureResidency& _R, const std::vector<FResidencyChange>& _Changes) {
+        for (const FResidencyChange& C : _Changes) _R.Complete(C.Texture);
+    }
+
+    void TestBytes() {
+        const FStreamedTextureDesc D = Bc7(4096);
+        Check(Smile::StreamedMipBytes(D, 0) == 16 * kMiB, "BC7 4096: mip 0 de 16 MiB");
+        Check(Smile::StreamedMipBytes(D, 11) == 16 && Smile::StreamedMipBytes(D, 12) == 16,
+              "mips 2x2 e 1x1 ocupam um bloco");
+        u64 Sum = 0;
+        for (u32 m = 3; m < D.MipCount; ++m) Sum += Smile::StreamedMipBytes(D, m);
+        Check(Smile::StreamedChainBytes(D, 3) == Sum, "cadeia = soma das mips");
+        Check(Smile::StreamedTailMip(D, 128) == 5, "cauda de 128 numa 4096 comeca na mip 5");
+        Check(Smile::StreamedTailMip(Bc7(64), 128) == 0, "textura pequena e toda cauda");
+
+        FStreamedTextureDesc Bc1 = Bc7(256);
+        Bc1.BlockBytes = 8;
+        FStreamedTextureDesc Rgba = Bc7(256);
+        Rgba.BlockDim = 1;
+        Rgba.BlockBytes = 4;
+        Check(Smile::StreamedMipBytes(Bc1, 0) == 256 * 256 / 2, "BC1: meio byte por texel");
+        Check(Smile::StreamedMipBytes(Rgba, 1) == 128 * 128 * 4, "RGBA8: 4 bytes por texel");
+
+        FStreamedTextureDesc Wide = Bc7(512);
+        Wide.Height = 64;
+        Check(Smile::StreamedTailMip(Wide, 128) == 2, "cauda pelo MAIOR lado");
+        Check(Smile::StreamedMipBytes(Wide, 5) == 4 * 1 * 16, "lado de 2 texels ainda e um bloco");
+    }
+
+    void TestDemanda() {
+        Smile::FMipDemandView View;
+        View.ViewportHeight = 1080.0f;
+        View.FovYRadians    = 1.0f;
+        const f32 M = Smile::DemandedMip(View, 2048, 2048, 1.0f, 1.0f, 10.0f);
+        Check(std::abs(Smile::DemandedMip(View, 2048, 2048, 1.0f, 1.0f, 20.0f) - (M + 1.0f)) < 1e-4f,
+              "dobrar a distancia sobe uma mip");
+        Check(std::abs(Smile::DemandedMip(View, 2048, 2048, 2.0f, 1.0f, 20.0f) - (M + 2.0f)) < 1e-4f,
+              "dobrar a densidade de UV sobe uma mip");
+        Check(std::abs(Smile::DemandedMip(View, 2048, 2048, 1.0f, 2.0f, 10.0f) - (M - 1.0f)) < 1e-4f,
+              "instancia com o dobro da escala desce uma mip");
+        Check(std::abs(Smile::DemandedMip(View, 4096, 1024, 1.0f, 1.0f, 10.0f) - (M + 1.0f)) < 1e-4f,
+              "textura retangular usa o maior lado");
+        View.MipBias = -1.0f;
+        Check(std::abs(Smile::DemandedMip(View, 2048, 2048, 1.0f, 1.0f, 20.0f) - M) < 1e-4f,
+              "MipBias -1 (upscale 2x) pede a mip de baixo");
+        Check(Smile::DemandedMip(View, 2048, 2048, 1.0f, 1.0f, 0.0f) == 0.0f, "camera na caixa pede 0");
+        Check(Smile::DemandedMip(View, 2048, 2048, 1.0f, 1.0f, 1e-4f) == 0.0f, "nunca abaixo de 0");
+
+        // Quad 2x2 com UV [0,1]: 0,5 unidade de UV por unidade local.
+        std::vector<Smile::Vertex> Quad(4);
+        const f32 P[4][2] = { { 0, 0 }, { 2, 0 }, { 2, 2 }, { 0, 2 } };
+        for (u32 i = 0; i < 4; ++i) {
+            Quad[i].Position[0] = P[i][0];
+            Quad[i].Position[1] = 0.0f;
+            Quad[i].Position[2] = P[i][1];
+            Quad[i].TexCoord[0] = P[i][0] * 0.5f;
+            Quad[i].TexCoord[1] = P[i][1] * 0.5f;
+        }
+        const std::vector<u32> Ib = { 0, 1, 2, 0, 2, 3 };
+        Check(std::abs(Smile::MeshUvDensity(Quad, Ib) - 0.5f) < 1e-6f, "densidade de UV do quad");
+        for (Smile::Vertex& V : Quad) V.TexCoord[0] = V.TexCoord[1] = 0.0f;
+        Check(Smile::MeshUvDensity(Quad, Ib) == 0.0f, "mesh sem UV tem densidade 0");
+    }
+
+    void TestCarga() {
+        FTextureResidencyOptions Opt;
+        Opt.BudgetBytes = 1024 * kMiB;
+        Opt.MaxLoadBytesPerUpdate = 1024 * kMiB;
+        FTextureResidency R(Opt);
+        const u32 A = R.Add(Bc7(2048));
+        const u32 B = R.Add(Bc7(2048));
+        Check(R.ResidentMip(A) == 4 && R.TargetMip(A) == 4, "entra com a cauda residente");
+        FTextureResidency Explicit(Opt);
+        Check(Explicit.TailMip(Explicit.Add(Bc7(2048), 6)) == 6, "cauda explicita (a que o loader subiu)");
+        Check(Explicit.TailMip(Explicit.Add(Bc7(2048), 40)) == 11, "cauda explicita limitada a ultima mip");
+        Check(R.Stats().CommittedBytes == 2 * Smile::StreamedChainBytes(Bc7(2048), 4), "cauda no budget");
+
+        // Sem pedido: nada muda.
+        Check(R.Update().empty(), "frame sem pedido nao muda nada");
+
+        R.Request(A, 1.7f);
+        R.Request(A, 2.5f); // o menor pedido do frame vale
+        const std::vector<FResidencyChange> Changes = R.Update();
+        Check(Changes.size() == 1 && Changes[0].Texture == A && Changes[0].FromMip == 4 &&
+              Changes[0].ToMip == 1, "carga ate floor da mip pedida");
+        Check(R.ResidentMip(A) == 4 && R.TargetMip(A) == 1, "carga fica em voo ate o Complete");
+        R.Request(A, 0.0f);
+        Check(R.Update().empty(), "textura em voo nao recebe outra mudanca");
+        R.Complete(A);
+        Check(R.ResidentMip(A) == 1, "Complete fecha a carga");
+        Check(R.Stats().ResidentBytes == R.Stats().CommittedBytes, "residente = decidido sem nada em voo");
+
+        // Falha de IO: volta para o residente e devolve o budget.
+        R.Request(B, 0.0f);
+        R.Update();
+        const u64 Reserved = R.Stats().CommittedBytes;
+        R.Complete(B, false);
+        Check(R.ResidentMip(B) == 4 && R.TargetMip(B) == 4, "falha mantem a textura no residente");
+        Check(R.Stats().CommittedBytes < Reserved, "falha devolve o budget reservado");
+    }
+
+    void TestRodadas() {
+        // BC7 2048: mip 0 de 4 MiB, mip 1 de 1 MiB. Teto de 3 MiB: as duas texturas ganham as mips
+        // grossas antes de qualquer uma ganhar a mip 0.
+        FTextureResidencyOptions Opt;
+        Opt.MaxLoadBytesPerUpdate = 3 * kMiB;
+        FTextureResidency R(Opt);
+        const u32 A = R.Add(Bc7(2048));
+        const u32 B = R.Add(Bc7(2048));
+        R.Request(A, 0.0f);
+        R.Request(B, 0.0f);
+        CompleteAll(R, R.Update());
+        Check(R.ResidentMip(A) == 1 && R.ResidentMip(B) == 1, "rodadas: mips grossas para as duas antes da mip 0");
+        R.Request(A, 0.0f);
+        R.Request(B, 0.0f);
+        CompleteAll(R, R.Update());
+        Check(R.ResidentMip(A) == 0 && R.ResidentMip(B) == 1,
+              "mip 0 (4 MiB) passa sozinha acima do teto, uma por Update");
+        Check(R.Stats().LoadBytes == 4 * kMiB, "teto: so a primeira carga passa acima");
+
+        // Maior falta primeiro.
+        FTextureResidency Q(Opt);
+        const u32 Near = Q.Add(Bc7(2048));
+        const u32 Far  = Q.Add(Bc7(2048));
+        Q.Request(Far, 3.0f);
+        Q.Request(Near, 0.0f);
+        const std::vector<FResidencyChange> C = Q.Update();
+        Check(!C.empty() && Q.TargetMip(Near) < Q.TargetMip(Far) + 1 && Q.TargetMip(Far) == 3,
+              "a textura com mais falta nao espera a de menos falta");
+    }
+
+    void TestBudgetLru() {
+        const FStreamedTextureDesc D = Bc7(2048);
+        const u64 Tail = Smile::StreamedChainBytes(D, 4);
+        const u64 Full = Smile::StreamedChainBytes(D, 0);
+        // Cabem 4 caudas e UMA textura inteira.
+        FTextureResidencyOptions Opt;
+        Opt.BudgetBytes = 3 * Tail + Full;
+        Opt.MaxLoadBytesPerUpdate = 1024 * kMiB;
+        FTextureResidency R(Opt);
+        u32 T[4];
+        for (u32& t : T) t = R.Add(D);
+
+        // Frames 1..3: T0, T1 e T2 pedem tudo, uma de cada vez; a anterior sai de cena.
+        for (u32 i = 0; i < 3; ++i) {
+            R.Request(T[i], 0.0f);
+            CompleteAll(R, R.Update());
+            Check(R.ResidentMip(T[i]) == 0, "textura pedida sobe inteira (" + std::to_string(i) + ")");
+            Check(R.Stats().CommittedBytes <= Opt.BudgetBytes, "budget respeitado");
+            if (i > 0) Check(R.ResidentMip(T[i - 1]) == 4, "a anterior, fora da tela, voltou para a cauda");
+        }
+
+        // LRU: T0 e T1 fora ha tempos, T2 inteira e na tela. T3 pede tudo com T2 ainda pedindo
+        // mip 0: nao cabe e T2 nao e despejada — T3 fica com o que couber e conta como Starved.
+        R.Request(T[2], 0.0f);
+        R.Request(T[3], 0.0f);
+        CompleteAll(R, R.Update());
+        Check(R.ResidentMip(T[2]) == 0, "o que o frame pede nao e despejado");
+        Check(R.ResidentMip(T[3]) == 4, "sem budget, a carga espera");
+        Check(R.Stats().Starved == 1, "Starved conta a textura sem espaco");
+
+        // T2 passa a pedir so a cauda (camera se afastou): o excesso dela na tela e despejado para
+        // T3 subir.
+        R.Request(T[2], 4.0f);
+        R.Request(T[3], 0.0f);
+        const std::vector<FResidencyChange> C = R.Update();
+        CompleteAll(R, C);
+        Check(R.ResidentMip(T[2]) == 4 && R.ResidentMip(T[3]) == 0, "excesso na tela cede para a falta");
+        Check(C.size() == 2 && C[0].Texture == T[2] && C[0].ToMip == 4, "despejo antes da carga, na mesma lista");
+
+        // Despejo de quem saiu ha mais tempo primeiro: T3 e T2 saem de cena; T2 fica por ultimo usada.
+        FTextureResidencyOptions Two = Opt;
+        Two.BudgetBytes = 2 * Tail + 2 * Full;
+        FTextureResidency L(Two);
+        const u32 A = L.Add(D), B = L.Add(D), C2 = L.Add(D);
+        L.Request(A, 0.0f);
+        CompleteAll(L, L.Update());
+        L.Request(B, 0.0f);
+        CompleteAll(L, L.Update());
+        L.Request(C2, 0.0f);
+        CompleteAll(L, L.Update());
+        Check(L.ResidentMip(A) == 4 && L.ResidentMip(B) == 0 && L.ResidentMip(C2) == 0,
+              "LRU: a textura usada ha mais tempo sai primeiro");
+    }
+
+    void TestSimulacao() {
+        // 60 texturas de 256 a 4096, camera aleatoria pedindo um subconjunto por frame; IO que
+        // termina em 0..3 frames e as vezes falha (so carga: despejo que
+        // falha devolve bytes de verdade e pode passar do budget, ver Complete). Invariantes a cada Update.
+        std::mt19937 Rng(7);
+        FTextureResidencyOptions Opt;
+        Opt.BudgetBytes = 96 * kMiB;
+        Opt.MaxLoadBytesPerUpdate = 24 * kMiB;
+        FTextureResidency R(Opt);
+        std::vector<u32> Ids;
+        for (u32 i = 0; i < 60; ++i) {
+            FStreamedTextureDesc D = Bc7(256u << (Rng() % 5));
+            if (i % 4 == 0) D.BlockBytes = 8;
+            Ids.push_back(R.Add(D));
+        }
+        Check(R.Stats().TailBytes <= Opt.BudgetBytes, "caudas cabem no budget da simulacao");
+
+        struct FPending { u32 Texture; u32 Frames; bool Load; };
+        std::vector<FPending> InFlight;
+        bool BudgetOk = true, OneInFlight = true, Accounting = true, Monotone = true;
+        for (u32 Frame = 0; Frame < 600; ++Frame) {
+            const u32 Center = (Frame / 20) % 60;
+            for (u32 k = 0; k < 12; ++k) {
+                const u32 t = (Center + k * 5) % 60;
+                R.Request(Ids[t], static_cast<f32>(Rng() % 6) + 0.5f);
+            }
+            std::vector<u32> Before(60);
+            for (u32 t = 0; t < 60; ++t) Before[t] = R.TargetMip(t);
+            const std::vector<FResidencyChange> Changes = R.Update();
+            for (const FResidencyChange& C : Changes) {
+                for (const FPending& P : InFlight) OneInFlight = OneInFlight && P.Texture != C.Texture;
+                Monotone = Monotone && C.FromMip == R.ResidentMip(C.Texture) && C.FromMip == Before[C.Texture];
+                InFlight.push_back({ C.Texture, static_cast<u32>(Rng() % 4), C.ToMip < C.FromMip });
+            }
+            BudgetOk = BudgetOk && R.Stats().CommittedBytes <= Opt.BudgetBytes;
+
+            for (size_t i = 0; i < InFlight.size();) {
+                if (InFlight[i].Frames-- == 0) {
+                    R.Complete(InFlight[i].Texture, !InFlight[i].Load || Rng() % 20 != 0);
+                    InFlight[i] = InFlight.back();
+                    InFlight.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+            u64 Committed = 0, Resident = 0;
+            for (u32 t = 0; t < 60; ++t) {
+                Committed += Smile::StreamedChainBytes(R.Desc(t), R.TargetMip(t));
+                Resident  += Smile::StreamedChainBytes(R.Desc(t), R.ResidentMip(t));
+            }
+            Accounting = Accounting && Committed == R.Stats().CommittedBytes &&
+                         Resident == R.Stats().ResidentBytes && R.Stats().InFlight <= InFlight.size();
+        }
+        Check(BudgetOk, "simulacao: budget estourado");
+        Check(OneInFlight, "simulacao: duas mudancas em voo na mesma textura");
+        Check(Monotone, "simulacao: mudanca nao parte do residente");
+        Check(Accounting, "simulacao: contas de bytes divergem das mips");
+    }
+}
+
+int main() {
+    std::cout << "Smile.TextureResidency\n";
+    TestBytes();
+    TestDemanda();
+    TestCarga();
+    TestRodadas();
+    TestBudgetLru();
+    TestSimulacao();
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
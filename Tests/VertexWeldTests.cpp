@@ -0,0 +1,220 @@
+// Contrato do weld do cooker (Tools/Cooker/VertexWeld.h).
+//
+// Exato: os indices e o VB saem IGUAIS aos do weld antigo (std::unordered_map com FNV-1a sobre os
+// 32 bytes), inclusive nos casos de bits — 0.0 vs -0.0 e NaN. Epsilon: vertices perturbados
+// dentro da celula soldam, vizinhos a mais de um passo nao, e o vertice emitido e o primeiro.
+//
+// `SmileVertexWeldTests --bench [triangulos]` compara os dois welds numa grade sintetica (default
+// 1M triangulos, com costura de UV a cada 16 colunas) e imprime os tempos; sem o argumento, o
+// ctest so roda o contrato.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "VertexWeld.h"
+
+namespace {
+    int Failures = 0;
+
+    void Check(bool Condition, std::string_view Message) {
+        if (!Condition) {
+            ++Failures;
+            std::cerr << "  FAIL: " << Message << '\n';
+        }
+    }
+
+    struct FWelded {
+        std::vector<Smile::Vertex> Vertices;
+        std::vector<Smile::u32>    Indices;
+    };
+
+    // O weld que o cooker usava ate aqui, copiado como referencia.
+    struct FReferenceKey {
+        Smile::Vertex V;
+        bool operator==(const FReferenceKey& _Other) const {
+            return std::memcmp(&V, &_Other.V, sizeof(Smile::Vertex)) == 0;
+        }
+    };
+    struct FReferenceHash {
+        size_t operator()(const FReferenceKey& _K) const {
+            const auto* P = reinterpret_cast<const unsigned char*>(&_K.V);
+            size_t H = 1469598103934665603ull;
+            for (size_t I = 0; I < sizeof(Smile::Vertex); ++I) {
+                H ^= P[I];
+                H *= 1099511628211ull;
+            }
+            return H;
+        }
+    };
+
+    FWelded WeldReference(const std::vector<Smile::Vertex>& _Corners) {
+        FWelded Out;
+        std::unordered_map<FReferenceKey, Smile::u32, FReferenceHash> Map;
+        for (const Smile::Vertex& V : _Corners) {
+            const auto [It, Inserted] = Map.emplace(FReferenceKey{ V }, Smile::u32(Out.Vertices.size()));
+            if (Inserted) Out.Vertices.push_back(V);
+            Out.Indices.push_back(It->second);
+        }
+        return Out;
+    }
+
+    FWelded WeldFlat(const std::vector<Smile::Vertex>& _Corners, const Smile::Cooker::FWeldOptions& _Options = {},
+                     size_t _Reserve = 0) {
+        FWelded Out;
+        Smile::Cooker::FVertexWelder Welder(_Options);
+        Welder.Reserve(_Reserve);
+        for (const Smile::Vertex& V : _Corners) {
+            bool Inserted = false;
+            const Smile::u32 Index = Welder.Add(V, Inserted);
+            if (Inserted) Out.Vertices.push_back(V);
+            Out.Indices.push_back(Index);
+        }
+        return Out;
+    }
+
+    bool SameBytes(const FWelded& _A, const FWelded& _B) {
+        return _A.Indices == _B.Indices && _A.Vertices.size() == _B.Vertices.size() &&
+               std::memcmp(_A.Vertices.data(), _B.Vertices.data(), _A.Vertices.size() * sizeof(Smile::Vertex)) == 0;
+    }
+
+    // Fluxo de cantos de uma grade N x N de quads (como o CookPart entrega ao weld): cada vertice
+    // interno aparece em 6 cantos; a cada 16 colunas o UV salta, o que duplica a coluna (costura).
+    std::vector<Smile::Vertex> MakeGridCorners(Smile::u32 _N) {
+        auto At = [&](Smile::u32 _X, Smile::u32 _Y, bool _Right) {
+            Smile::Vertex V{};
+            V.Position[0] = float(_X) * 0.01f;
+            V.Position[1] = std::sin(float(_X) * 0.1f) * std::cos(float(_Y) * 0.07f);
+            V.Position[2] = float(_Y) * 0.01f;
+            V.Normal[1]   = 1.0f;
+            // Ilha de UV do quad que usa o canto: nas colunas multiplas de 16 o quad a esquerda e o
+            // a direita discordam, e a coluna duplica (costura).
+            const Smile::u32 Island = _Right ? _X / 16 : (_X - 1) / 16;
+            V.TexCoord[0] = float(_X) / 16.0f - float(Island);
+            V.TexCoord[1] = float(_Y) / float(_N);
+            return V;
+        };
+        std::vector<Smile::Vertex> Corners;
+        Corners.reserve(size_t(_N) * _N * 6);
+        for (Smile::u32 Y = 0; Y < _N; ++Y)
+            for (Smile::u32 X = 0; X < _N; ++X) {
+                const Smile::Vertex A = At(X, Y, true), B = At(X + 1, Y, false);
+                const Smile::Vertex C = At(X, Y + 1, true), D = At(X + 1, Y + 1, false);
+                Corners.insert(Corners.end(), { A, C, B, B, C, D });
+            }
+        return Corners;
+    }
+
+    void TestExatoIgualAoAntigo() {
+        std::vector<Smile::Vertex> Corners = MakeGridCorners(64);
+        // Casos de bits: 0.0 e -0.0 sao vertices distintos; NaN com os mesmos bits solda.
+        Smile::Vertex Zero{}, NegZero{}, NaN{};
+        NegZero.Position[0] = -0.0f;
+        NaN.Normal[2]       = std::numeric_limits<float>::quiet_NaN();
+        Corners.insert(Corners.end(), { Zero, NegZero, NaN, Zero, NaN, NegZero });
+        std::shuffle(Corners.begin(), Corners.end(), std::mt19937(7));
+
+        const FWelded Reference = WeldReference(Corners);
+        Check(SameBytes(Reference, WeldFlat(Corners)), "weld exato difere do antigo (sem reserva)");
+        Check(SameBytes(Reference, WeldFlat(Corners, {}, Corners.size())), "weld exato difere do antigo (reservado)");
+        // A grade tem (N+1)^2 vertices mais uma coluna por costura, mais os 3 casos de bits.
+        Check(Reference.Vertices.size() == 65u * 65u + 3u * 65u + 3u, "contagem de referencia inesperada");
+    }
+
+    void TestEpsilon() {
+        constexpr float Epsilon = 1e-3f;
+        std::mt19937 Rng(11);
+        std::uniform_real_distribution<float> Jitter(-0.2f * Epsilon, 0.2f * Epsilon);
+        std::vector<Smile::Vertex> Corners;
+        std::vector<Smile::u32>    Cluster; // a que vertice-base cada canto pertence
+        for (Smile::u32 I = 0; I < 200; ++I) {
+            Smile::Vertex Base{};
+            // Centros de celula: o jitter de 0.2 passo nunca cruza a borda.
+            Base.Position[0] = float(I) * 10.0f * Epsilon;
+            Base.Position[1] = float(I % 7) * Epsilon;
+            Base.Normal[1]   = 1.0f;
+            Base.TexCoord[0] = float(I % 13) * 4.0f * Epsilon;
+            for (Smile::u32 Copy = 0; Copy < 4; ++Copy) {
+                Smile::Vertex V = Base;
+                if (Copy > 0)
+                    for (float* F : { &V.Position[0], &V.Position[1], &V.Position[2], &V.Normal[1], &V.TexCoord[0] })
+                        *F += Jitter(Rng);
+                Corners.push_back(V);
+                Cluster.push_back(I);
+            }
+        }
+        const FWelded Welded = WeldFlat(Corners, { Epsilon });
+        Check(Welded.Vertices.size() == 200, "copias perturbadas dentro da celula nao soldaram");
+        bool Consistent = true;
+        for (size_t I = 0; I < Corners.size(); ++I) Consistent &= Welded.Indices[I] == Cluster[I];
+        Check(Consistent, "canto soldado ao vertice errado");
+        Check(std::memcmp(&Welded.Vertices[5], &Corners[20], sizeof(Smile::Vertex)) == 0,
+              "vertice emitido nao e o primeiro da celula");
+
+        // Um passo inteiro de distancia: celulas diferentes, nao solda. -0.0 e 0.0 viram a mesma.
+        Smile::Vertex A{}, B{}, C{};
+        B.Position[0] = 1.5f * Epsilon;
+        C.Position[0] = -0.0f;
+        const FWelded Apart = WeldFlat({ A, B, C }, { Epsilon });
+        Check(Apart.Vertices.size() == 2 && Apart.Indices[2] == 0, "grade soldou longe demais ou separou -0.0");
+    }
+
+    void TestHashEspalha() {
+        // Vertices de grade diferem em poucos bits; os 16 bits baixos (o indice da tabela ate 64k
+        // slots) nao podem concentrar: nenhum balde com mais de 4x a media.
+        const std::vector<Smile::Vertex> Corners = MakeGridCorners(128);
+        const FWelded Unique = WeldReference(Corners);
+        std::vector<Smile::u32> Buckets(1u << 12, 0);
+        for (const Smile::Vertex& V : Unique.Vertices) ++Buckets[Smile::Cooker::HashWeldKey(&V) & 0xFFFu];
+        Smile::u32 Max = 0;
+        for (const Smile::u32 B : Buckets) Max = std::max(Max, B);
+        Check(Max <= 4u * Smile::u32(Unique.Vertices.size() >> 12) + 8u, "hash concentra nos bits baixos");
+    }
+
+    void Bench(Smile::u32 _Triangles) {
+        const Smile::u32 N = Smile::u32(std::sqrt(double(_Triangles) / 2.0));
+        std::vector<Smile::Vertex> Corners = MakeGridCorners(N);
+        std::shuffle(Corners.begin(), Corners.end(), std::mt19937(3)); // FBX real nao vem em ordem
+        std::cout << "  bench: " << Corners.size() / 3 << " triangulos, " << Corners.size() << " cantos\n";
+
+        auto Time = [](auto&& _Fn) {
+            const auto Start = std::chrono::steady_clock::now();
+            FWelded Result = _Fn();
+            const std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+            return std::make_pair(std::move(Result), Elapsed.count());
+        };
+        const auto [Reference, ReferenceMs] = Time([&] { return WeldReference(Corners); });
+        const auto [Flat, FlatMs]           = Time([&] { return WeldFlat(Corners); });
+        const auto [Reserved, ReservedMs]   = Time([&] { return WeldFlat(Corners, {}, Corners.size() / 3); });
+        const auto [Eps, EpsMs]             = Time([&] { return WeldFlat(Corners, { 1e-4f }, Corners.size() / 3); });
+        std::cout << "  unordered_map+FNV " << ReferenceMs << " ms | flat " << FlatMs << " ms | flat reservado "
+                  << ReservedMs << " ms | flat epsilon " << EpsMs << " ms (" << Reference.Vertices.size()
+                  << " unicos, " << ReferenceMs / ReservedMs << "x)\n";
+        Check(SameBytes(Reference, Flat) && SameBytes(Reference, Reserved), "bench: saidas diferentes");
+        Check(Eps.Vertices.size() <= Reference.Vertices.size(), "bench: epsilon gerou mais vertices");
+    }
+}
+
+int main(int _Argc, char** _Argv) {
+    std::cout << "Smile.VertexWeld\n";
+    TestExatoIgualAoAntigo();
+    TestEpsilon();
+    TestHashEspalha();
+    if (_Argc >= 2 && std::string_view(_Argv[1]) == "--bench")
+        Bench(_Argc >= 3 ? Smile::u32(std::strtoul(_Argv[2], nullptr, 10)) : 1000000u);
+
+    if (Failures == 0) {
+        std::cout << "  OK\n";
+        return 0;
+    }
+    std::cerr << "  " << Failures << " falha(s)\n";
+    return 1;
+}
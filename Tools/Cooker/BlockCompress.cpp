@@ -0,0 +1,769 @@
+#include "BlockCompress.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define SMILE_BC_X64 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SMILE_BC_SSE41_FN
+#define SMILE_BC_AVX2_FN
+#else
+// Mesmo esquema do MipChain.cpp: so as funcoes marcadas geram SSE4.1/AVX2, e quem escolhe a via
+// em runtime e o DetectMipPath.
+#define SMILE_BC_SSE41_FN __attribute__((target("sse4.1")))
+#define SMILE_BC_AVX2_FN  __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Smile::Cooker {
+    namespace {
+        using FBlock = f32[16][4];
+
+        void LoadBlock(const u8* _Rgba, FBlock& _Px) {
+            for (u32 i = 0; i < 16; ++i)
+                for (u32 c = 0; c < 4; ++c) _Px[i][c] = _Rgba[i * 4 + c];
+        }
+
+        int RoundClamp(f32 _V, int _Max) {
+            return std::clamp(static_cast<int>(std::lround(_V)), 0, _Max);
+        }
+
+        // Eixo principal dos N primeiros canais: iteracao de potencia sobre a covariancia, partindo
+        // da diagonal do bbox (converge em poucas rodadas em blocos de textura real). Bloco sem
+        // variacao devolve o eixo cinza.
+        template <u32 N>
+        void PrincipalAxis(const FBlock& _Px, f32 (&_Mean)[4], f32 (&_Axis)[4]) {
+            f32 Lo[4] = { 255, 255, 255, 255 }, Hi[4] = { 0, 0, 0, 0 };
+            for (u32 c = 0; c < 4; ++c) _Mean[c] = _Axis[c] = 0.0f;
+            for (u32 i = 0; i < 16; ++i)
+                for (u32 c = 0; c < N; ++c) {
+                    _Mean[c] += _Px[i][c];
+                    Lo[c] = std::min(Lo[c], _Px[i][c]);
+                    Hi[c] = std::max(Hi[c], _Px[i][c]);
+                }
+            for (u32 c = 0; c < N; ++c) _Mean[c] /= 16.0f;
+
+            f32 Cov[N][N] = {};
+            for (u32 i = 0; i < 16; ++i)
+                for (u32 a = 0; a < N; ++a)
+                    for (u32 b = 0; b < N; ++b)
+                        Cov[a][b] += (_Px[i][a] - _Mean[a]) * (_Px[i][b] - _Mean[b]);
+
+            f32 V[N];
+            bool Flat = true;
+            for (u32 c = 0; c < N; ++c) {
+                V[c] = Hi[c] - Lo[c];
+                Flat = Flat && V[c] == 0.0f;
+            }
+            if (Flat) {
+                for (u32 c = 0; c < N; ++c) _Axis[c] = 1.0f / std::sqrt(static_cast<f32>(N));
+                return;
+            }
+            for (int Iter = 0; Iter < 8; ++Iter) {
+                f32 W[N] = {};
+                f32 Norm = 0.0f;
+                for (u32 a = 0; a < N; ++a) {
+                    for (u32 b = 0; b < N; ++b) W[a] += Cov[a][b] * V[b];
+                    Norm = std::max(Norm, std::fabs(W[a]));
+                }
+                if (Norm < 1e-12f) break;
+                for (u32 c = 0; c < N; ++c) V[c] = W[c] / Norm;
+            }
+            f32 Len = 0.0f;
+            for (u32 c = 0; c < N; ++c) Len += V[c] * V[c];
+            Len = std::sqrt(Len);
+            for (u32 c = 0; c < N; ++c) _Axis[c] = V[c] / Len;
+        }
+
+        // Extremos da projecao no eixo: Hi = ponta positiva, Lo = negativa.
+        template <u32 N>
+        void AxisExtremes(const FBlock& _Px, f32 (&_Hi)[4], f32 (&_Lo)[4]) {
+            f32 Mean[4], Axis[4];
+            PrincipalAxis<N>(_Px, Mean, Axis);
+            f32 TMin = 1e30f, TMax = -1e30f;
+            for (u32 i = 0; i < 16; ++i) {
+                f32 T = 0.0f;
+                for (u32 c = 0; c < N; ++c) T += (_Px[i][c] - Mean[c]) * Axis[c];
+                TMin = std::min(TMin, T);
+                TMax = std::max(TMax, T);
+            }
+            for (u32 c = 0; c < 4; ++c) {
+                _Hi[c] = c < N ? std::clamp(Mean[c] + Axis[c] * TMax, 0.0f, 255.0f) : 255.0f;
+                _Lo[c] = c < N ? std::clamp(Mean[c] + Axis[c] * TMin, 0.0f, 255.0f) : 255.0f;
+            }
+        }
+
+        // Minimos quadrados dos dois extremos dado o peso (fracao de B) de cada texel. Falso se o
+        // sistema degenera (todos os texels no mesmo peso).
+        template <u32 N>
+        bool SolveEndpoints(const FBlock& _Px, const f32 (&_Weight)[16], f32 (&_A)[4], f32 (&_B)[4]) {
+            f32 AA = 0, AB = 0, BB = 0, XA[4] = {}, XB[4] = {};
+            for (u32 i = 0; i < 16; ++i) {
+                const f32 w = _Weight[i], u = 1.0f - w;
+                AA += u * u;
+                AB += u * w;
+                BB += w * w;
+                for (u32 c = 0; c < N; ++c) {
+                    XA[c] += u * _Px[i][c];
+                    XB[c] += w * _Px[i][c];
+                }
+            }
+            const f32 Det = AA * BB - AB * AB;
+            if (std::fabs(Det) < 1e-6f) return false;
+            const f32 Inv = 1.0f / Det;
+            for (u32 c = 0; c < N; ++c) {
+                _A[c] = std::clamp((XA[c] * BB - XB[c] * AB) * Inv, 0.0f, 255.0f);
+                _B[c] = std::clamp((XB[c] * AA - XA[c] * AB) * Inv, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        struct FBitWriter {
+            u8* Out;
+            u32 Pos = 0;
+            void Put(u32 _Value, u32 _Bits) {
+                for (u32 b = 0; b < _Bits; ++b, ++Pos)
+                    if ((_Value >> b) & 1u) Out[Pos >> 3] |= static_cast<u8>(1u << (Pos & 7));
+            }
+        };
+
+        struct FBitReader {
+            const u8* In;
+            u32 Pos = 0;
+            u32 Get(u32 _Bits) {
+                u32 V = 0;
+                for (u32 b = 0; b < _Bits; ++b, ++Pos) V |= ((In[Pos >> 3] >> (Pos & 7)) & 1u) << b;
+                return V;
+            }
+        };
+
+        // ---- BC1 ----
+        u16 To565(const f32 (&_C)[4]) {
+            const int R = RoundClamp(_C[0] * 31.0f / 255.0f, 31);
+            const int G = RoundClamp(_C[1] * 63.0f / 255.0f, 63);
+            const int B = RoundClamp(_C[2] * 31.0f / 255.0f, 31);
+            return static_cast<u16>((R << 11) | (G << 5) | B);
+        }
+
+        void From565(u16 _C, int (&_Out)[3]) {
+            const int R = (_C >> 11) & 31, G = (_C >> 5) & 63, B = _C & 31;
+            _Out[0] = (R << 3) | (R >> 2);
+            _Out[1] = (G << 2) | (G >> 4);
+            _Out[2] = (B << 3) | (B >> 2);
+        }
+
+        // Paleta como o decoder le: 4 cores com C0 > C1 (ou sempre, no bloco de cor do BC3);
+        // senao 3 cores + preto transparente.
+        void Bc1Palette(u16 _C0, u16 _C1, bool _Force4, int (&_P)[4][3]) {
+            From565(_C0, _P[0]);
+            From565(_C1, _P[1]);
+            for (u32 c = 0; c < 3; ++c) {
+                if (_Force4 || _C0 > _C1) {
+                    _P[2][c] = (2 * _P[0][c] + _P[1][c] + 1) / 3;
+                    _P[3][c] = (_P[0][c] + 2 * _P[1][c] + 1) / 3;
+                } else {
+                    _P[2][c] = (_P[0][c] + _P[1][c] + 1) / 2;
+                    _P[3][c] = 0;
+                }
+            }
+        }
+
+        void EncodeBC1(const u8* _Rgba, u8* _Out, int _Rounds) {
+            FBlock Px;
+            LoadBlock(_Rgba, Px);
+            f32 A[4], B[4];
+            AxisExtremes<3>(Px, A, B);
+
+            // Peso (fracao de C1) de cada indice da paleta de 4 cores.
+            static constexpr f32 kWeight[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            f32 BestErr = 1e30f;
+            u16 BestC0 = 0, BestC1 = 0;
+            u32 BestBits = 0;
+            for (int Round = 0; Round < _Rounds; ++Round) {
+                u16 C0 = To565(A), C1 = To565(B);
+                if (C0 < C1) {
+                    std::swap(C0, C1);
+                    std::swap(A, B);
+                }
+                int P[4][3];
+                Bc1Palette(C0, C1, true, P);
+                f32 Err = 0.0f, W[16];
+                u32 Bits = 0;
+                for (u32 i = 0; i < 16; ++i) {
+                    f32 Best = 1e30f;
+                    u32 Index = 0;
+                    // C0 == C1: so o indice 0 (as quatro entradas sao iguais de qualquer jeito, e
+                    // o decoder le esse bloco em modo de 3 cores).
+                    for (u32 k = 0; k < (C0 == C1 ? 1u : 4u); ++k) {
+                        f32 D = 0.0f;
+                        for (u32 c = 0; c < 3; ++c) D += (Px[i][c] - P[k][c]) * (Px[i][c] - P[k][c]);
+                        if (D < Best) { Best = D; Index = k; }
+                    }
+                    Err += Best;
+                    W[i] = kWeight[Index];
+                    Bits |= Index << (2 * i);
+                }
+                if (Err < BestErr) {
+                    BestErr = Err; BestC0 = C0; BestC1 = C1; BestBits = Bits;
+                }
+                if (Err == 0.0f || !SolveEndpoints<3>(Px, W, A, B)) break;
+            }
+            std::memcpy(_Out, &BestC0, 2);
+            std::memcpy(_Out + 2, &BestC1, 2);
+            std::memcpy(_Out + 4, &BestBits, 4);
+        }
+
+        void DecodeBC1(const u8* _In, u8* _Rgba, bool _Force4) {
+            u16 C0, C1;
+            u32 Bits;
+            std::memcpy(&C0, _In, 2);
+            std::memcpy(&C1, _In + 2, 2);
+            std::memcpy(&Bits, _In + 4, 4);
+            int P[4][3];
+            Bc1Palette(C0, C1, _Force4, P);
+            for (u32 i = 0; i < 16; ++i) {
+                const u32 k = (Bits >> (2 * i)) & 3u;
+                for (u32 c = 0; c < 3; ++c) _Rgba[i * 4 + c] = static_cast<u8>(P[k][c]);
+                _Rgba[i * 4 + 3] = (!_Force4 && C0 <= C1 && k == 3) ? 0 : 255;
+            }
+        }
+
+        // ---- BC4 (tambem o alfa do BC3 e cada canal do BC5) ----
+        void Bc4Palette(int _A0, int _A1, int (&_P)[8]) {
+            _P[0] = _A0;
+            _P[1] = _A1;
+            if (_A0 > _A1) {
+                for (int k = 1; k <= 6; ++k) _P[k + 1] = ((7 - k) * _A0 + k * _A1 + 3) / 7;
+            } else {
+                for (int k = 1; k <= 4; ++k) _P[k + 1] = ((5 - k) * _A0 + k * _A1 + 2) / 5;
+                _P[6] = 0;
+                _P[7] = 255;
+            }
+        }
+
+        u32 Bc4FitScalar(const u8 (&_V)[16], const int (&_P)[8], u64& _Bits) {
+            u32 Err = 0;
+            _Bits = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                int Best = 1 << 30;
+                u32 Index = 0;
+                for (u32 k = 0; k < 8; ++k) {
+                    const int D = (_V[i] - _P[k]) * (_V[i] - _P[k]);
+                    if (D < Best) { Best = D; Index = k; }
+                }
+                Err += static_cast<u32>(Best);
+                _Bits |= static_cast<u64>(Index) << (3 * i);
+            }
+            return Err;
+        }
+
+#if defined(SMILE_BC_X64)
+        // As 8 entradas num registrador de u16; o quadrado da diferenca cabe em u16 (255^2 < 2^16)
+        // e o PHMINPOSUW devolve o menor valor e o MENOR indice que o tem — o empate da escalar.
+        SMILE_BC_SSE41_FN u32 Bc4FitSSE(const u8 (&_V)[16], const int (&_P)[8], u64& _Bits) {
+            const __m128i P = _mm_setr_epi16(static_cast<i16>(_P[0]), static_cast<i16>(_P[1]), static_cast<i16>(_P[2]),
+                                             static_cast<i16>(_P[3]), static_cast<i16>(_P[4]), static_cast<i16>(_P[5]),
+                                             static_cast<i16>(_P[6]), static_cast<i16>(_P[7]));
+            u32 Err = 0;
+            _Bits = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                const __m128i D  = _mm_abs_epi16(_mm_sub_epi16(_mm_set1_epi16(static_cast<i16>(_V[i])), P));
+                const u32     Mp = static_cast<u32>(_mm_cvtsi128_si32(_mm_minpos_epu16(_mm_mullo_epi16(D, D))));
+                Err += Mp & 0xFFFFu;
+                _Bits |= static_cast<u64>((Mp >> 16) & 7u) << (3 * i);
+            }
+            return Err;
+        }
+#endif
+
+        // BC4 nao tem via AVX2: 8 entradas ja enchem um registrador de 128 bits.
+        u32 Bc4Fit(const u8 (&_V)[16], int _A0, int _A1, u64& _Bits, EMipPath _Path) {
+            int P[8];
+            Bc4Palette(_A0, _A1, P);
+#if defined(SMILE_BC_X64)
+            if (_Path != EMipPath::Scalar) return Bc4FitSSE(_V, P, _Bits);
+#else
+            (void)_Path;
+#endif
+            return Bc4FitScalar(_V, P, _Bits);
+        }
+
+        void EncodeBC4Channel(const u8* _Rgba, u32 _Channel, u8* _Out, EBlockQuality _Quality, EMipPath _Path) {
+            u8 V[16];
+            int Lo = 255, Hi = 0, Lo6 = 255, Hi6 = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                V[i] = _Rgba[i * 4 + _Channel];
+                Lo = std::min<int>(Lo, V[i]);
+                Hi = std::max<int>(Hi, V[i]);
+                if (V[i] != 0 && V[i] != 255) {
+                    Lo6 = std::min<int>(Lo6, V[i]);
+                    Hi6 = std::max<int>(Hi6, V[i]);
+                }
+            }
+            int BestA0 = Hi, BestA1 = Lo;
+            u64 BestBits = 0;
+            u32 BestErr = 0xFFFFFFFFu;
+            auto Try = [&](int _A0, int _A1) {
+                u64 Bits;
+                const u32 Err = Bc4Fit(V, _A0, _A1, Bits, _Path);
+                if (Err < BestErr) { BestErr = Err; BestA0 = _A0; BestA1 = _A1; BestBits = Bits; }
+            };
+            if (Lo == Hi) {
+                Try(Hi, Lo);
+            } else {
+                // Modo de 8 valores (A0 > A1), com os extremos recuados ate Reach passos: o extremo
+                // exato quase nunca e o otimo quando ha texels no meio.
+                const int Reach = _Quality == EBlockQuality::Fast ? 0 : _Quality == EBlockQuality::Normal ? 2 : 4;
+                for (int d0 = 0; d0 <= Reach; ++d0)
+                    for (int d1 = 0; d1 <= Reach; ++d1)
+                        if (Hi - d0 > Lo + d1) Try(Hi - d0, Lo + d1);
+                // Modo de 6 valores + 0 e 255 exatos: ganha quando o bloco encosta nos extremos.
+                // O Slow testa sempre, com a faixa inteira tambem.
+                if (Lo == 0 || Hi == 255 || _Quality == EBlockQuality::Slow) {
+                    Try(Lo6 <= Hi6 ? Lo6 : 0, Lo6 <= Hi6 ? Hi6 : 0);
+                    if (_Quality == EBlockQuality::Slow) Try(Lo, Hi);
+                }
+            }
+            _Out[0] = static_cast<u8>(BestA0);
+            _Out[1] = static_cast<u8>(BestA1);
+            for (u32 b = 0; b < 6; ++b) _Out[2 + b] = static_cast<u8>(BestBits >> (8 * b));
+        }
+
+        void DecodeBC4Channel(const u8* _In, u8* _Rgba, u32 _Channel) {
+            int P[8];
+            Bc4Palette(_In[0], _In[1], P);
+            u64 Bits = 0;
+            for (u32 b = 0; b < 6; ++b) Bits |= static_cast<u64>(_In[2 + b]) << (8 * b);
+            for (u32 i = 0; i < 16; ++i) _Rgba[i * 4 + _Channel] = static_cast<u8>(P[(Bits >> (3 * i)) & 7u]);
+        }
+
+        // ---- BC7 modo 6 ----
+        constexpr int kBc7Weight4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        // Extremo de 7 bits por canal + p-bit compartilhado: o valor de 8 bits e (v << 1) | p.
+        struct FBc7Endpoint {
+            int V[4];
+            int P;
+            int Expanded(u32 _C) const { return (V[_C] << 1) | P; }
+        };
+
+        FBc7Endpoint QuantizeBc7(const f32 (&_E)[4], int _P) {
+            FBc7Endpoint Q{};
+            Q.P = _P;
+            for (u32 c = 0; c < 4; ++c) Q.V[c] = RoundClamp((_E[c] - static_cast<f32>(_P)) * 0.5f, 127);
+            return Q;
+        }
+
+        void Bc7Palette(const FBc7Endpoint& _E0, const FBc7Endpoint& _E1, int (&_P)[16][4]) {
+            for (u32 k = 0; k < 16; ++k)
+                for (u32 c = 0; c < 4; ++c)
+                    _P[k][c] = ((64 - kBc7Weight4[k]) * _E0.Expanded(c) + kBc7Weight4[k] * _E1.Expanded(c) + 32) >> 6;
+        }
+
+        // Indice de cada texel contra a paleta de 16 cores, e o erro quadratico total. Distancias
+        // inteiras (cabem com folga em i32): a escalar e as SIMD escolhem igual, menor indice no
+        // empate.
+        u32 Bc7FitScalar(const u8* _Rgba, const int (&_P)[16][4], u8 (&_Idx)[16]) {
+            u32 Err = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                int Best = 1 << 30;
+                u32 Index = 0;
+                for (u32 k = 0; k < 16; ++k) {
+                    int D = 0;
+                    for (u32 c = 0; c < 4; ++c) D += (_Rgba[i * 4 + c] - _P[k][c]) * (_Rgba[i * 4 + c] - _P[k][c]);
+                    if (D < Best) { Best = D; Index = k; }
+                }
+                Err += static_cast<u32>(Best);
+                _Idx[i] = static_cast<u8>(Index);
+            }
+            return Err;
+        }
+
+#if defined(SMILE_BC_X64)
+        // Paleta em pares i16 intercalados (R,G) e (B,A): PMADDWD da dR^2 + dG^2 por entrada numa
+        // lane de i32. A chave (distancia << 4) | k no minimo sem sinal escolhe a menor distancia e,
+        // no empate, o menor k. Distancia <= 4 * 255^2, entao a chave cabe em 23 bits.
+        struct alignas(32) FBc7PaletteSoA {
+            i16 RG[32];
+            i16 BA[32];
+        };
+
+        void SplitBc7Palette(const int (&_P)[16][4], FBc7PaletteSoA& _Out) {
+            for (u32 k = 0; k < 16; ++k) {
+                _Out.RG[2 * k]     = static_cast<i16>(_P[k][0]);
+                _Out.RG[2 * k + 1] = static_cast<i16>(_P[k][1]);
+                _Out.BA[2 * k]     = static_cast<i16>(_P[k][2]);
+                _Out.BA[2 * k + 1] = static_cast<i16>(_P[k][3]);
+            }
+        }
+
+        SMILE_BC_SSE41_FN u32 HorizontalMinSSE(__m128i _V) {
+            _V = _mm_min_epu32(_V, _mm_shuffle_epi32(_V, _MM_SHUFFLE(1, 0, 3, 2)));
+            _V = _mm_min_epu32(_V, _mm_shuffle_epi32(_V, _MM_SHUFFLE(2, 3, 0, 1)));
+            return static_cast<u32>(_mm_cvtsi128_si32(_V));
+        }
+
+        SMILE_BC_SSE41_FN u32 Bc7FitSSE(const u8* _Rgba, const int (&_P)[16][4], u8 (&_Idx)[16]) {
+            FBc7PaletteSoA S;
+            SplitBc7Palette(_P, S);
+            __m128i RG[4], BA[4], Lane[4];
+            for (u32 q = 0; q < 4; ++q) {
+                RG[q]   = _mm_load_si128(reinterpret_cast<const __m128i*>(S.RG + 8 * q));
+                BA[q]   = _mm_load_si128(reinterpret_cast<const __m128i*>(S.BA + 8 * q));
+                Lane[q] = _mm_setr_epi32(static_cast<int>(4 * q), static_cast<int>(4 * q + 1),
+                                         static_cast<int>(4 * q + 2), static_cast<int>(4 * q + 3));
+            }
+            u32 Err = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                const u8* T = _Rgba + i * 4;
+                const __m128i PxRG = _mm_set1_epi32(static_cast<int>(T[0] | (static_cast<u32>(T[1]) << 16)));
+                const __m128i PxBA = _mm_set1_epi32(static_cast<int>(T[2] | (static_cast<u32>(T[3]) << 16)));
+                __m128i Min = _mm_set1_epi32(-1);
+                for (u32 q = 0; q < 4; ++q) {
+                    const __m128i D0 = _mm_sub_epi16(PxRG, RG[q]);
+                    const __m128i D1 = _mm_sub_epi16(PxBA, BA[q]);
+                    const __m128i D  = _mm_add_epi32(_mm_madd_epi16(D0, D0), _mm_madd_epi16(D1, D1));
+                    Min = _mm_min_epu32(Min, _mm_or_si128(_mm_slli_epi32(D, 4), Lane[q]));
+                }
+                const u32 Key = HorizontalMinSSE(Min);
+                Err += Key >> 4;
+                _Idx[i] = static_cast<u8>(Key & 15u);
+            }
+            return Err;
+        }
+
+        SMILE_BC_AVX2_FN u32 Bc7FitAVX2(const u8* _Rgba, const int (&_P)[16][4], u8 (&_Idx)[16]) {
+            FBc7PaletteSoA S;
+            SplitBc7Palette(_P, S);
+            const __m256i RG0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(S.RG));
+            const __m256i RG1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(S.RG + 16));
+            const __m256i BA0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(S.BA));
+            const __m256i BA1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(S.BA + 16));
+            const __m256i Lane0 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i Lane1 = _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15);
+            u32 Err = 0;
+            for (u32 i = 0; i < 16; ++i) {
+                const u8* T = _Rgba + i * 4;
+                const __m256i PxRG = _mm256_set1_epi32(static_cast<int>(T[0] | (static_cast<u32>(T[1]) << 16)));
+                const __m256i PxBA = _mm256_set1_epi32(static_cast<int>(T[2] | (static_cast<u32>(T[3]) << 16)));
+                const __m256i A0 = _mm256_sub_epi16(PxRG, RG0), B0 = _mm256_sub_epi16(PxBA, BA0);
+                const __m256i A1 = _mm256_sub_epi16(PxRG, RG1), B1 = _mm256_sub_epi16(PxBA, BA1);
+                const __m256i D0 = _mm256_add_epi32(_mm256_madd_epi16(A0, A0), _mm256_madd_epi16(B0, B0));
+                const __m256i D1 = _mm256_add_epi32(_mm256_madd_epi16(A1, A1), _mm256_madd_epi16(B1, B1));
+                const __m256i Min = _mm256_min_epu32(_mm256_or_si256(_mm256_slli_epi32(D0, 4), Lane0),
+                                                     _mm256_or_si256(_mm256_slli_epi32(D1, 4), Lane1));
+                const u32 Key = HorizontalMinSSE(_mm_min_epu32(_mm256_castsi256_si128(Min),
+                                                               _mm256_extracti128_si256(Min, 1)));
+                Err += Key >> 4;
+                _Idx[i] = static_cast<u8>(Key & 15u);
+            }
+            return Err;
+        }
+#endif
+
+        u32 Bc7Fit(const u8* _Rgba, const FBc7Endpoint& _E0, const FBc7Endpoint& _E1, u8 (&_Idx)[16], EMipPath _Path) {
+            int P[16][4];
+            Bc7Palette(_E0, _E1, P);
+            switch (_Path) {
+#if defined(SMILE_BC_X64)
+                case EMipPath::AVX2:  return Bc7FitAVX2(_Rgba, P, _Idx);
+                case EMipPath::SSE41: return Bc7FitSSE(_Rgba, P, _Idx);
+#endif
+                default:              return Bc7FitScalar(_Rgba, P, _Idx);
+            }
+        }
+
+        void EncodeBC7(const u8* _Rgba, u8* _Out, EBlockQuality _Quality, EMipPath _Path) {
+            FBlock Px;
+            LoadBlock(_Rgba, Px);
+            f32 A[4], B[4];
+            AxisExtremes<4>(Px, A, B);
+
+            // Bloco opaco so tem alfa 255 exato com os dois p-bits em 1; fora isso, os pares de
+            // p-bit contra o erro do bloco inteiro (o Fast so os iguais, 00 e 11).
+            bool Opaque = true;
+            for (u32 i = 0; i < 16; ++i) Opaque = Opaque && _Rgba[i * 4 + 3] == 255;
+            const int Rounds = _Quality == EBlockQuality::Fast ? 1 : 3;
+            const int PbStep = _Quality == EBlockQuality::Fast ? 3 : 1;
+
+            u32 BestErr = 0xFFFFFFFFu;
+            FBc7Endpoint BestE0{}, BestE1{};
+            u8 BestIdx[16] = {};
+            for (int Round = 0; Round < Rounds; ++Round) {
+                u32 RoundErr = 0xFFFFFFFFu;
+                f32 W[16];
+                for (int Pb = Opaque ? 3 : 0; Pb < 4; Pb += PbStep) {
+                    const FBc7Endpoint E0 = QuantizeBc7(A, Pb & 1), E1 = QuantizeBc7(B, Pb >> 1);
+                    u8 Idx[16];
+                    const u32 Err = Bc7Fit(_Rgba, E0, E1, Idx, _Path);
+                    if (Err < RoundErr) {
+                        RoundErr = Err;
+                        for (u32 i = 0; i < 16; ++i) W[i] = kBc7Weight4[Idx[i]] / 64.0f;
+                    }
+                    if (Err < BestErr) {
+                        BestErr = Err; BestE0 = E0; BestE1 = E1;
+                        std::memcpy(BestIdx, Idx, sizeof(Idx));
+                    }
+                }
+                if (RoundErr == 0 || Round + 1 == Rounds || !SolveEndpoints<4>(Px, W, A, B)) break;
+            }
+
+            // Slow: descida coordenada nos 8 canais de 7 bits (+-1) e nos p-bits, aceitando so
+            // melhora estrita — termina, e a ordem fixa dos candidatos mantem o resultado
+            // deterministico.
+            if (_Quality == EBlockQuality::Slow) {
+                for (int Pass = 0; Pass < 8 && BestErr > 0; ++Pass) {
+                    bool Improved = false;
+                    auto Try = [&](const FBc7Endpoint& _E0, const FBc7Endpoint& _E1) {
+                        u8 Idx[16];
+                        const u32 Err = Bc7Fit(_Rgba, _E0, _E1, Idx, _Path);
+                        if (Err >= BestErr) return;
+                        BestErr = Err; BestE0 = _E0; BestE1 = _E1;
+                        std::memcpy(BestIdx, Idx, sizeof(Idx));
+                        Improved = true;
+                    };
+                    for (u32 e = 0; e < 2; ++e) {
+                        for (u32 c = 0; c < 4; ++c)
+                            for (int d = -1; d <= 1; d += 2) {
+                                FBc7Endpoint E[2] = { BestE0, BestE1 };
+                                E[e].V[c] += d;
+                                if (E[e].V[c] >= 0 && E[e].V[c] <= 127) Try(E[0], E[1]);
+                            }
+                        if (!Opaque) {
+                            FBc7Endpoint E[2] = { BestE0, BestE1 };
+                            E[e].P ^= 1;
+                            Try(E[0], E[1]);
+                        }
+                    }
+                    if (!Improved) break;
+                }
+            }
+
+            // Indice ancora (texel 0) perde o bit alto: se ele cair na metade de cima, troca os
+            // extremos e espelha os indices — mesma paleta, lida ao contrario.
+            if (BestIdx[0] & 8u) {
+                std::swap(BestE0, BestE1);
+                for (u8& i : BestIdx) i = static_cast<u8>(15u - i);
+            }
+            std::memset(_Out, 0, 16);
+            FBitWriter W{ _Out };
+            W.Put(1u << 6, 7);
+            for (u32 c = 0; c < 4; ++c) {
+                W.Put(static_cast<u32>(BestE0.V[c]), 7);
+                W.Put(static_cast<u32>(BestE1.V[c]), 7);
+            }
+            W.Put(static_cast<u32>(BestE0.P), 1);
+            W.Put(static_cast<u32>(BestE1.P), 1);
+            W.Put(BestIdx[0], 3);
+            for (u32 i = 1; i < 16; ++i) W.Put(BestIdx[i], 4);
+        }
+
+        // So o modo 6, que e o que o encoder emite; outro modo sai zerado.
+        void DecodeBC7(const u8* _In, u8* _Rgba) {
+            std::memset(_Rgba, 0, 64);
+            FBitReader R{ _In };
+            if (R.Get(7) != (1u << 6)) return;
+            FBc7Endpoint E0{}, E1{};
+            for (u32 c = 0; c < 4; ++c) {
+                E0.V[c] = static_cast<int>(R.Get(7));
+                E1.V[c] = static_cast<int>(R.Get(7));
+            }
+            E0.P = static_cast<int>(R.Get(1));
+            E1.P = static_cast<int>(R.Get(1));
+            int P[16][4];
+            Bc7Palette(E0, E1, P);
+            for (u32 i = 0; i < 16; ++i) {
+                const u32 k = R.Get(i == 0 ? 3 : 4);
+                for (u32 c = 0; c < 4; ++c) _Rgba[i * 4 + c] = static_cast<u8>(P[k][c]);
+            }
+        }
+
+        EMipPath ResolvePath(EMipPath _Wanted) {
+            const EMipPath Best = DetectMipPath();
+            return static_cast<u8>(_Wanted) < static_cast<u8>(Best) ? _Wanted : Best;
+        }
+
+        // Canais guardados por formato, em mascara RGBA.
+        u32 StoredChannels(EBlockFormat _Format) {
+            switch (_Format) {
+                case EBlockFormat::BC1: return 0x7u;
+                case EBlockFormat::BC4: return 0x1u;
+                case EBlockFormat::BC5: return 0x3u;
+                default:                return 0xFu;
+            }
+        }
+
+        // SSIM de uma janela de um canal, com as constantes do artigo original (K1 0.01, K2 0.03,
+        // faixa 255).
+        f64 WindowSsim(const u8* _A, const u8* _B, u32 _Width, u32 _X0, u32 _Y0, u32 _W, u32 _H, u32 _Channel) {
+            constexpr f64 C1 = (0.01 * 255.0) * (0.01 * 255.0), C2 = (0.03 * 255.0) * (0.03 * 255.0);
+            f64 Sa = 0, Sb = 0, Saa = 0, Sbb = 0, Sab = 0;
+            for (u32 y = _Y0; y < _Y0 + _H; ++y)
+                for (u32 x = _X0; x < _X0 + _W; ++x) {
+                    const size_t o = (static_cast<size_t>(y) * _Width + x) * 4 + _Channel;
+                    const f64 a = _A[o], b = _B[o];
+                    Sa += a; Sb += b; Saa += a * a; Sbb += b * b; Sab += a * b;
+                }
+            const f64 N = static_cast<f64>(_W) * _H;
+            const f64 Ma = Sa / N, Mb = Sb / N;
+            const f64 Va = Saa / N - Ma * Ma, Vb = Sbb / N - Mb * Mb, Cab = Sab / N - Ma * Mb;
+            return ((2.0 * Ma * Mb + C1) * (2.0 * Cab + C2)) / ((Ma * Ma + Mb * Mb + C1) * (Va + Vb + C2));
+        }
+    }
+
+    u32 BlockBytes(EBlockFormat _Format) {
+        return (_Format == EBlockFormat::BC1 || _Format == EBlockFormat::BC4) ? 8u : 16u;
+    }
+
+    const char* BlockFormatName(EBlockFormat _Format) {
+        switch (_Format) {
+            case EBlockFormat::BC1: return "BC1";
+            case EBlockFormat::BC3: return "BC3";
+            case EBlockFormat::BC4: return "BC4";
+            case EBlockFormat::BC5: return "BC5";
+            case EBlockFormat::BC7: return "BC7";
+        }
+        return "?";
+    }
+
+    const char* BlockQualityName(EBlockQuality _Quality) {
+        switch (_Quality) {
+            case EBlockQuality::Fast:   return "fast";
+            case EBlockQuality::Normal: return "normal";
+            case EBlockQuality::Slow:   return "slow";
+        }
+        return "?";
+    }
+
+    void EncodeBlock(EBlockFormat _Format, const u8* _Rgba, u8* _Out, const FBlockEncodeOptions& _Options) {
+        const EMipPath Path = ResolvePath(_Options.Path);
+        const EBlockQuality Q = _Options.Quality;
+        const int Bc1Rounds = Q == EBlockQuality::Fast ? 1 : 3;
+        switch (_Format) {
+            case EBlockFormat::BC1: EncodeBC1(_Rgba, _Out, Bc1Rounds); break;
+            case EBlockFormat::BC3:
+                EncodeBC4Channel(_Rgba, 3, _Out, Q, Path);
+                EncodeBC1(_Rgba, _Out + 8, Bc1Rounds);
+                break;
+            case EBlockFormat::BC4: EncodeBC4Channel(_Rgba, 0, _Out, Q, Path); break;
+            case EBlockFormat::BC5:
+                EncodeBC4Channel(_Rgba, 0, _Out, Q, Path);
+                EncodeBC4Channel(_Rgba, 1, _Out + 8, Q, Path);
+                break;
+            case EBlockFormat::BC7: EncodeBC7(_Rgba, _Out, Q, Path); break;
+        }
+    }
+
+    void DecodeBlock(EBlockFormat _Format, const u8* _In, u8* _Rgba) {
+        switch (_Format) {
+            case EBlockFormat::BC1: DecodeBC1(_In, _Rgba, false); break;
+            case EBlockFormat::BC3: DecodeBC1(_In + 8, _Rgba, true); DecodeBC4Channel(_In, _Rgba, 3); break;
+            case EBlockFormat::BC4:
+            case EBlockFormat::BC5:
+                for (u32 i = 0; i < 16; ++i) {
+                    _Rgba[i * 4 + 0] = _Rgba[i * 4 + 1] = _Rgba[i * 4 + 2] = 0;
+                    _Rgba[i * 4 + 3] = 255;
+                }
+                DecodeBC4Channel(_In, _Rgba, 0);
+                if (_Format == EBlockFormat::BC5) DecodeBC4Channel(_In + 8, _Rgba, 1);
+                break;
+            case EBlockFormat::BC7: DecodeBC7(_In, _Rgba); break;
+        }
+    }
+
+    std::vector<u8> CompressSurface(EBlockFormat _Format, const u8* _Rgba, u32 _Width, u32 _Height,
+                                    const FBlockEncodeOptions& _Options) {
+        const u32 BlocksW = std::max(1u, (_Width + 3) / 4), BlocksH = std::max(1u, (_Height + 3) / 4);
+        const u32 Bytes = BlockBytes(_Format);
+        std::vector<u8> Out(static_cast<size_t>(BlocksW) * BlocksH * Bytes);
+        FBlockEncodeOptions Options = _Options;
+        Options.Path = ResolvePath(_Options.Path);
+
+        // Uma linha de blocos por vez, pega de um contador atomico: cada bloco escreve so a sua
+        // posicao, entao a ordem em que as linhas terminam nao aparece na saida.
+        std::atomic<u32> NextRow{ 0 };
+        auto Worker = [&] {
+            u8 Block[64];
+            for (u32 by = NextRow++; by < BlocksH; by = NextRow++)
+                for (u32 bx = 0; bx < BlocksW; ++bx) {
+                    for (u32 y = 0; y < 4; ++y)
+                        for (u32 x = 0; x < 4; ++x) {
+                            const u32 sx = std::min(bx * 4 + x, _Width - 1), sy = std::min(by * 4 + y, _Height - 1);
+                            std::memcpy(Block + (y * 4 + x) * 4, _Rgba + (static_cast<size_t>(sy) * _Width + sx) * 4, 4);
+                        }
+                    EncodeBlock(_Format, Block, Out.data() + (static_cast<size_t>(by) * BlocksW + bx) * Bytes, Options);
+                }
+        };
+        const u32 Threads = _Options.Threads ? _Options.Threads : std::max(1u, std::thread::hardware_concurrency());
+        const u32 WorkerCount = std::min(Threads, BlocksH);
+        if (WorkerCount <= 1) {
+            Worker();
+        } else {
+            std::vector<std::jthread> Workers;
+            Workers.reserve(WorkerCount);
+            for (u32 i = 0; i < WorkerCount; ++i) Workers.emplace_back(Worker);
+        }
+        return Out;
+    }
+
+    std::vector<u8> DecompressSurface(EBlockFormat _Format, const u8* _Blocks, u32 _Width, u32 _Height) {
+        const u32 BlocksW = std::max(1u, (_Width + 3) / 4), BlocksH = std::max(1u, (_Height + 3) / 4);
+        const u32 Bytes = BlockBytes(_Format);
+        std::vector<u8> Out(static_cast<size_t>(_Width) * _Height * 4);
+        u8 Block[64];
+        for (u32 by = 0; by < BlocksH; ++by)
+            for (u32 bx = 0; bx < BlocksW; ++bx) {
+                DecodeBlock(_Format, _Blocks + (static_cast<size_t>(by) * BlocksW + bx) * Bytes, Block);
+                for (u32 y = 0; y < 4 && by * 4 + y < _Height; ++y)
+                    for (u32 x = 0; x < 4 && bx * 4 + x < _Width; ++x)
+                        std::memcpy(Out.data() + ((static_cast<size_t>(by) * 4 + y) * _Width + bx * 4 + x) * 4,
+                                    Block + (y * 4 + x) * 4, 4);
+            }
+        return Out;
+    }
+
+    f64 FBlockQualityReport::Psnr() const {
+        if (Samples == 0 || SquaredError == 0.0) return 99.0;
+        return std::min(99.0, 10.0 * std::log10(255.0 * 255.0 * static_cast<f64>(Samples) / SquaredError));
+    }
+
+    f64 FBlockQualityReport::Ssim() const {
+        return SsimWindows ? SsimSum / static_cast<f64>(SsimWindows) : 1.0;
+    }
+
+    void FBlockQualityReport::Merge(const FBlockQualityReport& _Other) {
+        SquaredError += _Other.SquaredError;
+        Samples      += _Other.Samples;
+        SsimSum      += _Other.SsimSum;
+        SsimWindows  += _Other.SsimWindows;
+    }
+
+    FBlockQualityReport MeasureBlockQuality(EBlockFormat _Format, const u8* _Source, const u8* _Decoded,
+                                            u32 _Width, u32 _Height) {
+        FBlockQualityReport R;
+        const u32 Mask = StoredChannels(_Format);
+        const size_t Texels = static_cast<size_t>(_Width) * _Height;
+        for (u32 c = 0; c < 4; ++c) {
+            if (!(Mask & (1u << c))) continue;
+            for (size_t i = 0; i < Texels; ++i) {
+                const f64 D = static_cast<f64>(_Source[i * 4 + c]) - static_cast<f64>(_Decoded[i * 4 + c]);
+                R.SquaredError += D * D;
+            }
+            R.Samples += Texels;
+
+            const u32 WinW = std::min(8u, _Width), WinH = std::min(8u, _Height);
+            for (u32 y = 0; y + WinH <= _Height; y += 4) {
+                for (u32 x = 0; x + WinW <= _Width; x += 4) {
+                    R.SsimSum += WindowSsim(_Source, _Decoded, _Width, x, y, WinW, WinH, c);
+                    ++R.SsimWindows;
+                }
+            }
+        }
+        return R;
+    }
+}
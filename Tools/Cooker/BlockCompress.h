@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Smile/Core/Types.h"
+#include "Smile/Graphics/Resources/MipChain.h"
+#include <vector>
+
+// Compressao em blocos 4x4 (BC1/BC3/BC4/BC5/BC7) do estagio de texturas do cooker, sem
+// dependencia externa.
+//
+// Cada encoder parte do eixo principal do bloco (iteracao de potencia sobre a covariancia),
+// quantiza os extremos da projecao e refina por minimos quadrados sobre os indices escolhidos —
+// ate tres rodadas, ficando com a de menor erro. O BC7 emite so o modo 6 (um subconjunto, RGBA
+// 7.7.7.7 + p-bit, indices de 4 bits): cobre cor e alfa no mesmo bloco, que e o que o BaseColor
+// com cutout precisa.
+//
+// A busca de indices (o laco quente de toda rodada: 16 texels contra a paleta inteira) tem vias
+// SSE4.1 e AVX2 em inteiro, com a mesma escolha de indice da escalar (menor erro, menor indice
+// no empate) — a saida e identica byte a byte em qualquer via. O CompressSurface divide as
+// linhas de blocos entre threads; cada bloco so depende dos seus 16 texels, entao os bytes nao
+// dependem do numero de threads (cook reproduzivel).
+namespace Smile::Cooker {
+    enum class EBlockFormat : u8 { BC1, BC3, BC4, BC5, BC7 };
+
+    // Tiers do encoder. Cada tier testa um superconjunto dos candidatos do anterior, entao o erro
+    // de um bloco nunca piora subindo de tier:
+    //   Fast   — uma rodada; BC7 so com os p-bits iguais, BC4 sem recuar os extremos. Para CI.
+    //   Normal — tres rodadas; BC7 com os 4 pares de p-bit, BC4 recuando ate 2 passos.
+    //   Slow   — Normal + descida coordenada de +-1 em cada canal/p-bit dos extremos do BC7 ate
+    //            parar de melhorar; BC4 recuando ate 4 passos e sempre testando o modo de 6 valores.
+    enum class EBlockQuality : u8 { Fast, Normal, Slow };
+
+    struct FBlockEncodeOptions {
+        EBlockQuality Quality = EBlockQuality::Normal;
+        // Threads do CompressSurface (0 = todos os cores). Os bytes nao mudam com isso.
+        u32 Threads = 1;
+        // Via da busca de indices (a do EMipPath: mesma deteccao de CPU). Idem.
+        EMipPath Path = DetectMipPath();
+    };
+
+    // 8 (BC1/BC4) ou 16 bytes por bloco.
+    u32         BlockBytes(EBlockFormat Format);
+    const char* BlockFormatName(EBlockFormat Format);
+    const char* BlockQualityName(EBlockQuality Quality);
+
+    // Um bloco: Rgba = 16 texels RGBA8 em ordem de linha. BC4 le so o canal R; BC5, R e G; BC1
+    // ignora o alfa.
+    void EncodeBlock(EBlockFormat Format, const u8* Rgba, u8* Out, const FBlockEncodeOptions& Options = {});
+    // Inverso, para teste e relatorio. Canais que o formato nao guarda saem 0 (GB do BC4, B do
+    // BC5) e o alfa 255.
+    void DecodeBlock(EBlockFormat Format, const u8* In, u8* Rgba);
+
+    // Superficie Width x Height RGBA8 -> blocos em ordem de linha. Borda que nao fecha 4x4 replica
+    // o ultimo texel da linha/coluna (mips 2x2 e 1x1 inclusive).
+    std::vector<u8> CompressSurface(EBlockFormat Format, const u8* Rgba, u32 Width, u32 Height,
+                                    const FBlockEncodeOptions& Options = {});
+    std::vector<u8> DecompressSurface(EBlockFormat Format, const u8* Blocks, u32 Width, u32 Height);
+
+    // Erro da compressao contra a fonte RGBA8, so nos canais que o formato guarda (BC1 RGB, BC4 R,
+    // BC5 RG, o resto RGBA). Acumulavel: o cooker soma as mips de uma textura e as texturas de uma
+    // cena, e PSNR/SSIM saem do total.
+    struct FBlockQualityReport {
+        f64 SquaredError = 0.0;
+        u64 Samples      = 0;
+        f64 SsimSum      = 0.0; // soma do SSIM de cada janela 8x8 (passo 4) de cada canal
+        u64 SsimWindows  = 0;
+
+        // 99 dB sem erro nenhum (e sem amostra).
+        f64  Psnr() const;
+        f64  Ssim() const;
+        void Merge(const FBlockQualityReport& Other);
+    };
+
+    // Decoded = DecompressSurface da saida; Source = a superficie que entrou no CompressSurface
+    // (no cooker, a mip RGBA8 do gerador do FTexture::LoadCPU). Superficie menor que 8 em um eixo
+    // vira uma janela so nesse eixo.
+    FBlockQualityReport MeasureBlockQuality(EBlockFormat Format, const u8* Source, const u8* Decoded,
+                                            u32 Width, u32 Height);
+}
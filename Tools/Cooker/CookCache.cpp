@@ -0,0 +1,259 @@
+#include "CookCache.h"
+
+#include "ufbx.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+namespace Smile::Cooker {
+    namespace {
+        constexpr u32    kCookCacheMagic = 0x434B4353u; // 'SCKC'
+        constexpr size_t kCompareChunk   = 64u * 1024u;
+
+        struct SCookCacheHeader {
+            u32 Magic;
+            u32 Revision;      // kCookCacheRevision
+            u32 CookedVersion; // kCookedVersion
+            u32 RecordCount;
+        };
+
+        // Registro em disco, seguido de ByteCount bytes (FCookedPart::Bytes).
+        struct SCookCacheRecord {
+            u64               Key;
+            SMeshEntry        Entry;
+            u64               Triangles;
+            u64               RawBytes;
+            FVertexCacheStats Before;
+            FVertexCacheStats After;
+            u32               Clusters;
+            u32               Empty;
+            u64               ByteCount;
+        };
+
+        u64 Mix(u64 _X) {
+            _X ^= _X >> 33;
+            _X *= 0xFF51AFD7ED558CCDull;
+            _X ^= _X >> 33;
+            _X *= 0xC4CEB9FE1A85EC53ull;
+            _X ^= _X >> 33;
+            return _X;
+        }
+
+        int SeekTo(FILE* _File, u64 _Offset) {
+#if defined(_WIN32)
+            return _fseeki64(_File, static_cast<i64>(_Offset), SEEK_SET);
+#else
+            return fseeko(_File, static_cast<off_t>(_Offset), SEEK_SET);
+#endif
+        }
+    }
+
+    void FHasher::Add(u64 _Value) {
+        State = Mix(State ^ Mix(_Value + 0x9E3779B97F4A7C15ull)) * 5u + 0x52DCE729u;
+    }
+
+    void FHasher::Add(double _Value) {
+        // -0.0 e 0.0 cozinham igual, mas sao bits diferentes: melhor um miss raro que normalizar
+        // e arriscar um acerto falso.
+        Add(std::bit_cast<u64>(_Value));
+    }
+
+    void FHasher::Add(const void* _Data, size_t _Bytes) {
+        const auto* P = static_cast<const u8*>(_Data);
+        Add(static_cast<u64>(_Bytes));
+        for (; _Bytes >= 8; P += 8, _Bytes -= 8) {
+            u64 Word;
+            std::memcpy(&Word, P, 8);
+            Add(Word);
+        }
+        if (_Bytes) {
+            u64 Tail = 0;
+            std::memcpy(&Tail, P, _Bytes);
+            Add(Tail);
+        }
+    }
+
+    u64 FHasher::Value() const { return Mix(State); }
+
+    u64 HashPartSource(const ufbx_mesh& _Mesh, const ufbx_mesh_part& _Part, u64 _Seed) {
+        // Tudo o que o CookPart consulta, na mesma ordem: a lista de faces da parte e, por canto,
+        // posicao, normal e UV (os ausentes entram como marcador, nao como o default que o cook
+        // usaria — ligar um atributo que vale o default ainda muda a chave). A triangulacao do
+        // ufbx so depende das posicoes dos cantos, entao ja esta coberta.
+        FHasher H(_Seed);
+        const bool HasNormal = _Mesh.vertex_normal.exists;
+        const bool HasUV     = _Mesh.vertex_uv.exists;
+        H.Add(static_cast<u64>(_Part.face_indices.count));
+        H.Add(static_cast<u64>((HasNormal ? 1u : 0u) | (HasUV ? 2u : 0u)));
+        for (size_t FI = 0; FI < _Part.face_indices.count; ++FI) {
+            const ufbx_face Face = _Mesh.faces.data[_Part.face_indices.data[FI]];
+            H.Add(static_cast<u64>(Face.num_indices));
+            for (u32 C = Face.index_begin; C < Face.index_begin + Face.num_indices; ++C) {
+                const ufbx_vec3 P = ufbx_get_vertex_vec3(&_Mesh.vertex_position, C);
+                H.Add(P.x);
+                H.Add(P.y);
+                H.Add(P.z);
+                if (HasNormal) {
+                    const ufbx_vec3 N = ufbx_get_vertex_vec3(&_Mesh.vertex_normal, C);
+                    H.Add(N.x);
+                    H.Add(N.y);
+                    H.Add(N.z);
+                }
+                if (HasUV) {
+                    const ufbx_vec2 UV = ufbx_get_vertex_vec2(&_Mesh.vertex_uv, C);
+                    H.Add(UV.x);
+                    H.Add(UV.y);
+                }
+            }
+        }
+        return H.Value();
+    }
+
+    void FCookCache::Load(const std::filesystem::path& _Path, std::string& _Error) {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Records.clear();
+        FILE* F = std::fopen(_Path.string().c_str(), "rb");
+        if (!F) return; // primeira execucao: nada a dizer
+
+        std::vector<u8> Bytes;
+        u8 Buffer[kCompareChunk];
+        for (size_t Read; (Read = std::fread(Buffer, 1, sizeof(Buffer), F)) > 0;)
+            Bytes.insert(Bytes.end(), Buffer, Buffer + Read);
+        std::fclose(F);
+
+        SCookCacheHeader Header{};
+        if (Bytes.size() < sizeof(Header)) {
+            _Error = "arquivo truncado";
+            return;
+        }
+        std::memcpy(&Header, Bytes.data(), sizeof(Header));
+        if (Header.Magic != kCookCacheMagic) {
+            _Error = "magic invalido";
+            return;
+        }
+        if (Header.Revision != kCookCacheRevision || Header.CookedVersion != kCookedVersion) {
+            _Error = "de outra versao do cooker (descartado)";
+            return;
+        }
+
+        size_t Cursor = sizeof(Header);
+        for (u32 I = 0; I < Header.RecordCount; ++I) {
+            SCookCacheRecord Record{};
+            if (Bytes.size() - Cursor < sizeof(Record)) break;
+            std::memcpy(&Record, Bytes.data() + Cursor, sizeof(Record));
+            Cursor += sizeof(Record);
+            if (Bytes.size() - Cursor < Record.ByteCount) break;
+
+            FRecord& Out = Records[Record.Key];
+            Out.Part.Entry     = Record.Entry;
+            Out.Part.Triangles = Record.Triangles;
+            Out.Part.RawBytes  = Record.RawBytes;
+            Out.Part.Cache     = { Record.Before, Record.After, Record.Clusters };
+            Out.Part.Empty     = Record.Empty != 0;
+            Out.Part.Bytes.assign(Bytes.begin() + Cursor, Bytes.begin() + Cursor + Record.ByteCount);
+            Cursor += Record.ByteCount;
+        }
+        if (Records.size() != Header.RecordCount) {
+            // Um registro cortado no meio invalida so o que vem depois dele; o resto e bom.
+            _Error = "truncado: " + std::to_string(Records.size()) + " de " +
+                     std::to_string(Header.RecordCount) + " entradas aproveitadas";
+        }
+    }
+
+    bool FCookCache::Find(u64 _Key, FCookedPart& _Out) {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        auto It = Records.find(_Key);
+        if (It == Records.end()) {
+            ++MissCount;
+            return false;
+        }
+        ++HitCount;
+        It->second.Used = true;
+        _Out = It->second.Part;
+        return true;
+    }
+
+    void FCookCache::Store(u64 _Key, const FCookedPart& _Part) {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        FRecord& Record = Records[_Key];
+        Record.Part = _Part;
+        Record.Used = true;
+    }
+
+    bool FCookCache::Save(const std::filesystem::path& _Path) const {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        FILE* F = std::fopen(_Path.string().c_str(), "wb");
+        if (!F) return false;
+
+        u32 Count = 0;
+        for (const auto& [Key, Record] : Records) Count += Record.Used ? 1u : 0u;
+        const SCookCacheHeader Header{ kCookCacheMagic, kCookCacheRevision, kCookedVersion, Count };
+        bool Ok = std::fwrite(&Header, sizeof(Header), 1, F) == 1;
+        for (const auto& [Key, Record] : Records) {
+            if (!Record.Used || !Ok) continue;
+            SCookCacheRecord Out{};
+            Out.Key       = Key;
+            Out.Entry     = Record.Part.Entry;
+            Out.Triangles = Record.Part.Triangles;
+            Out.RawBytes  = Record.Part.RawBytes;
+            Out.Before    = Record.Part.Cache.Before;
+            Out.After     = Record.Part.Cache.After;
+            Out.Clusters  = Record.Part.Cache.Clusters;
+            Out.Empty     = Record.Part.Empty ? 1u : 0u;
+            Out.ByteCount = Record.Part.Bytes.size();
+            Ok = std::fwrite(&Out, sizeof(Out), 1, F) == 1 &&
+                 std::fwrite(Record.Part.Bytes.data(), 1, Record.Part.Bytes.size(), F) == Record.Part.Bytes.size();
+        }
+        return (std::fclose(F) == 0) && Ok;
+    }
+
+    i64 WriteFileIncremental(const std::filesystem::path& _Path, std::span<const std::span<const u8>> _Pieces) {
+        u64 Total = 0;
+        for (const std::span<const u8> Piece : _Pieces) Total += Piece.size();
+
+        std::error_code Ec;
+        const u64 Existing = std::filesystem::file_size(_Path, Ec);
+        if (!Ec && Existing == Total) {
+            FILE* F = std::fopen(_Path.string().c_str(), "r+b");
+            if (F) {
+                // Mesmo tamanho: o caso comum de um recook com poucas partes mudadas (o layout
+                // so desloca quando alguma parte muda de TAMANHO). Compara por bloco e reescreve
+                // so os blocos diferentes — a saida e identica a de um "wb", com menos escrita.
+                std::vector<u8> Expected(kCompareChunk), Current(kCompareChunk);
+                size_t PieceIndex = 0, PieceCursor = 0;
+                i64 Written = 0;
+                bool Ok = true;
+                for (u64 Offset = 0; Offset < Total && Ok; Offset += kCompareChunk) {
+                    const size_t Size = static_cast<size_t>(std::min<u64>(kCompareChunk, Total - Offset));
+                    for (size_t Filled = 0; Filled < Size;) {
+                        const std::span<const u8> Piece = _Pieces[PieceIndex];
+                        const size_t Take = std::min(Size - Filled, Piece.size() - PieceCursor);
+                        std::memcpy(Expected.data() + Filled, Piece.data() + PieceCursor, Take);
+                        Filled += Take;
+                        PieceCursor += Take;
+                        if (PieceCursor == Piece.size()) {
+                            ++PieceIndex;
+                            PieceCursor = 0;
+                        }
+                    }
+                    Ok = SeekTo(F, Offset) == 0 && std::fread(Current.data(), 1, Size, F) == Size;
+                    if (!Ok || std::memcmp(Expected.data(), Current.data(), Size) == 0) continue;
+                    // Leitura -> escrita no mesmo FILE exige reposicionar entre as duas.
+                    Ok = SeekTo(F, Offset) == 0 && std::fwrite(Expected.data(), 1, Size, F) == Size;
+                    Written += static_cast<i64>(Size);
+                }
+                if (std::fclose(F) == 0 && Ok) return Written;
+            }
+        }
+
+        FILE* F = std::fopen(_Path.string().c_str(), "wb");
+        if (!F) return -1;
+        bool Ok = true;
+        for (const std::span<const u8> Piece : _Pieces)
+            Ok = Ok && std::fwrite(Piece.data(), 1, Piece.size(), F) == Piece.size();
+        if (std::fclose(F) != 0 || !Ok) return -1;
+        return static_cast<i64>(Total);
+    }
+}
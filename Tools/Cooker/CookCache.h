@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MeshOptimize.h"
+#include "Smile/Scene/CookedFormat.h"
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ufbx_mesh;
+struct ufbx_mesh_part;
+
+// Cache persistente do cook por (malha, parte): `<saida>.cookcache` ao lado do .smesh.
+//
+// A chave e um hash do que a parte LE do FBX (faces, posicoes, normais e UVs de cada canto) com
+// o "sal" do cook (opcoes, kCookedVersion, kCookCacheRevision). Acerto devolve a parte pronta —
+// exatamente os bytes que o CookPart produziria —, entao mexer so em heuristica de material
+// (ClassifySuffix, LooksGlass, LooksFoliage) recozinha zero geometria.
+//
+// ⚠️ Mudou o que o CookPart produz sem mudar o formato (weld, otimizador, clusters, codec)?
+// Suba kCookCacheRevision — o cache nao tem como enxergar codigo.
+namespace Smile::Cooker {
+    constexpr u32 kCookCacheRevision = 1u;
+
+    // Resultado do cook de uma parte. Offsets da Entry sao RELATIVOS a Bytes; a montagem do blob
+    // desloca pelo tamanho do blob no ponto em que a parte entra.
+    struct FCookedPart {
+        SMeshEntry        Entry{};
+        std::vector<u8>   Bytes;           // [VB][IB][RT] ou bloco codificado (+pad a 4), clusters, LODs
+        bool              Empty     = true; // a triangulacao nao gerou nada: nem mesh nem renderavel
+        u64               Triangles = 0;    // emitidos pela triangulacao (relatorio)
+        u64               RawBytes  = 0;    // o que as regioes teriam sem --compress (relatorio)
+        FMeshOptimizeStats Cache;
+        double            Ms = 0.0;         // nao persiste: e o custo desta execucao
+    };
+
+    // Mistura 64 bits por palavra (finalizador do MurmurHash3). Nao criptografico: colisao de
+    // 64 bits entre partes de UMA cena e desprezivel, e o custo importa — hashear a parte tem de
+    // sair bem mais barato que cozinha-la.
+    class FHasher {
+    public:
+        explicit FHasher(u64 _Seed = 0x9E3779B97F4A7C15ull) : State(_Seed) {}
+        void Add(u64 _Value);
+        void Add(double _Value);
+        void Add(const void* _Data, size_t _Bytes);
+        u64  Value() const;
+
+    private:
+        u64 State;
+    };
+
+    // Hash do que a parte le do FBX: a mesma travessia do CookPart, sem triangular nem soldar.
+    // `_Seed` e o sal do cook (opcoes e versoes); o mesmo FBX com outras opcoes da outra chave.
+    u64 HashPartSource(const ufbx_mesh& Mesh, const ufbx_mesh_part& Part, u64 Seed);
+
+    // Thread-safe: a fase paralela do cooker consulta e grava de varios workers.
+    class FCookCache {
+    public:
+        // Arquivo ausente, de outra revisao ou corrompido = cache vazio (e `_Error` diz por que,
+        // quando ha o que dizer). Nunca falha o cook.
+        void Load(const std::filesystem::path& Path, std::string& Error);
+        bool Find(u64 Key, FCookedPart& Out);
+        void Store(u64 Key, const FCookedPart& Part);
+        // Grava SO as entradas usadas nesta execucao (achadas ou gravadas): parte que saiu da
+        // cena sai do cache junto.
+        bool Save(const std::filesystem::path& Path) const;
+
+        u64 Hits() const { return HitCount; }
+        u64 Misses() const { return MissCount; }
+
+    private:
+        struct FRecord {
+            FCookedPart Part;
+            bool        Used = false;
+        };
+        mutable std::mutex                  Mutex;
+        std::unordered_map<u64, FRecord>    Records;
+        u64                                 HitCount  = 0;
+        u64                                 MissCount = 0;
+    };
+
+    // Grava `_Pieces` em sequencia como o conteudo de `_Path`. Se o arquivo existente tem o mesmo
+    // tamanho, compara por blocos e reescreve so os blocos que mudaram; senao reescreve inteiro.
+    // Devolve os bytes efetivamente escritos, ou -1 em erro de E/S.
+    i64 WriteFileIncremental(const std::filesystem::path& Path, std::span<const std::span<const u8>> Pieces);
+}
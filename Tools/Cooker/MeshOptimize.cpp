@@ -0,0 +1,253 @@
+#include "MeshOptimize.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Smile::Cooker {
+    namespace {
+        constexpr u32 kNone = ~0u;
+
+        // FIFO por carimbo: o vertice esta no cache se foi inserido ha menos de CacheSize
+        // insercoes. Comecar o relogio em CacheSize+1 faz todo vertice nascer fora.
+        struct FFifoCache {
+            std::vector<u32> Stamp;
+            u32              Clock;
+            u32              Size;
+
+            FFifoCache(u32 _VertexCount, u32 _Size) : Stamp(_VertexCount, 0), Clock(_Size + 1), Size(_Size) {}
+
+            bool Touch(u32 _Vertex) {
+                if (Clock - Stamp[_Vertex] <= Size) return true;
+                Stamp[_Vertex] = Clock++;
+                return false;
+            }
+            void Flush() { Clock += Size + 1; }
+        };
+
+        // Tipsify: anda em leque ao redor de um vertice, emitindo todos os triangulos vivos dele,
+        // e escolhe o proximo leque entre os vertices recem-emitidos que ainda estarao no cache
+        // quando seus triangulos restantes forem emitidos. `_Boundaries` recebe o primeiro
+        // triangulo de cada trecho que comecou por um salto (pilha de dead-end ou varredura) —
+        // as fronteiras "duras" onde a localidade de cache quebra.
+        std::vector<u32> Tipsify(std::span<const u32> _Indices, u32 _VertexCount, u32 _CacheSize,
+                                 std::vector<u32>& _Boundaries) {
+            const u32 TriangleCount = static_cast<u32>(_Indices.size() / 3);
+            std::vector<u32> Live(_VertexCount, 0);
+            for (const u32 V : _Indices) ++Live[V];
+            std::vector<u32> Offsets(_VertexCount + 1, 0);
+            for (u32 V = 0; V < _VertexCount; ++V) Offsets[V + 1] = Offsets[V] + Live[V];
+            std::vector<u32> Adjacency(_Indices.size());
+            {
+                std::vector<u32> Fill(Offsets.begin(), Offsets.end() - 1);
+                for (u32 T = 0; T < TriangleCount; ++T)
+                    for (u32 C = 0; C < 3; ++C) Adjacency[Fill[_Indices[T * 3 + C]]++] = T;
+            }
+
+            std::vector<u32> Stamp(_VertexCount, 0);
+            u32 Time = _CacheSize + 1;
+            std::vector<u8>  Emitted(TriangleCount, 0);
+            std::vector<u32> DeadEnd, Candidates;
+            std::vector<u32> Out;
+            Out.reserve(_Indices.size());
+            _Boundaries.clear();
+
+            u32 Cursor = 0;
+            u32 Fan = TriangleCount ? _Indices[0] : kNone;
+            if (Fan != kNone) _Boundaries.push_back(0);
+            while (Fan != kNone) {
+                Candidates.clear();
+                for (u32 A = Offsets[Fan]; A < Offsets[Fan + 1]; ++A) {
+                    const u32 T = Adjacency[A];
+                    if (Emitted[T]) continue;
+                    Emitted[T] = 1;
+                    for (u32 C = 0; C < 3; ++C) {
+                        const u32 V = _Indices[T * 3 + C];
+                        Out.push_back(V);
+                        DeadEnd.push_back(V);
+                        Candidates.push_back(V);
+                        --Live[V];
+                        if (Time - Stamp[V] > _CacheSize) Stamp[V] = Time++;
+                    }
+                }
+
+                // Prioridade = idade no cache, desde que os triangulos restantes (2 vertices
+                // novos cada, no pior caso) caibam antes dele sair. Fora disso, 0: ainda serve,
+                // mas perde para qualquer um que caiba.
+                u32 Next = kNone;
+                i64 BestPriority = -1;
+                for (const u32 V : Candidates) {
+                    if (Live[V] == 0) continue;
+                    i64 Priority = 0;
+                    if (Time - Stamp[V] + 2 * Live[V] <= _CacheSize) Priority = Time - Stamp[V];
+                    if (Priority > BestPriority) {
+                        BestPriority = Priority;
+                        Next = V;
+                    }
+                }
+                if (Next == kNone) {
+                    while (!DeadEnd.empty() && Next == kNone) {
+                        const u32 V = DeadEnd.back();
+                        DeadEnd.pop_back();
+                        if (Live[V] > 0) Next = V;
+                    }
+                    for (; Next == kNone && Cursor < _VertexCount; ++Cursor)
+                        if (Live[Cursor] > 0) Next = Cursor;
+                    if (Next != kNone) _Boundaries.push_back(static_cast<u32>(Out.size() / 3));
+                }
+                Fan = Next;
+            }
+            return Out;
+        }
+
+        // Parte cada cluster duro onde o ACMR acumulado desde o ultimo corte ja esta dentro da
+        // tolerancia do ACMR do cluster inteiro: o corte sai barato para o cache e da ao
+        // ordenamento de overdraw pecas menores para mover.
+        std::vector<u32> SoftBoundaries(std::span<const u32> _Indices, u32 _VertexCount,
+                                        const std::vector<u32>& _Hard, u32 _CacheSize, f32 _Threshold) {
+            const u32 TriangleCount = static_cast<u32>(_Indices.size() / 3);
+            std::vector<u32> Out;
+            FFifoCache Cache(_VertexCount, _CacheSize);
+            for (size_t H = 0; H < _Hard.size(); ++H) {
+                const u32 Begin = _Hard[H];
+                const u32 End   = H + 1 < _Hard.size() ? _Hard[H + 1] : TriangleCount;
+                Cache.Flush();
+                u32 ClusterMisses = 0;
+                for (u32 I = Begin * 3; I < End * 3; ++I) ClusterMisses += !Cache.Touch(_Indices[I]);
+                const f32 ClusterACMR = f32(ClusterMisses) / f32(End - Begin);
+
+                Out.push_back(Begin);
+                Cache.Flush();
+                u32 Misses = 0, Start = Begin;
+                for (u32 T = Begin; T < End; ++T) {
+                    for (u32 C = 0; C < 3; ++C) Misses += !Cache.Touch(_Indices[T * 3 + C]);
+                    const u32 Count = T + 1 - Start;
+                    if (T + 1 < End && f32(Misses) / f32(Count) <= ClusterACMR * _Threshold) {
+                        Out.push_back(T + 1);
+                        Start = T + 1;
+                        Misses = 0;
+                        Cache.Flush();
+                    }
+                }
+            }
+            return Out;
+        }
+
+        struct FCross {
+            double X, Y, Z;
+        };
+
+        FCross TriangleCross(const std::vector<Vertex>& _Vertices, const u32* _Tri) {
+            const f32* A = _Vertices[_Tri[0]].Position;
+            const f32* B = _Vertices[_Tri[1]].Position;
+            const f32* C = _Vertices[_Tri[2]].Position;
+            const double E1[3] = { double(B[0]) - A[0], double(B[1]) - A[1], double(B[2]) - A[2] };
+            const double E2[3] = { double(C[0]) - A[0], double(C[1]) - A[1], double(C[2]) - A[2] };
+            return { E1[1] * E2[2] - E1[2] * E2[1], E1[2] * E2[0] - E1[0] * E2[2], E1[0] * E2[1] - E1[1] * E2[0] };
+        }
+
+        // Ordem de overdraw independente de vista: cluster cujo centroide esta "para fora" do
+        // centro da malha, na direcao da propria normal, tende a ocluir os demais de qualquer
+        // ponto de vista em que esteja visivel — vai primeiro.
+        std::vector<u32> SortClustersForOverdraw(const std::vector<Vertex>& _Vertices, std::span<const u32> _Indices,
+                                                 const std::vector<u32>& _Clusters) {
+            const u32 TriangleCount = static_cast<u32>(_Indices.size() / 3);
+            double MeshCenter[3] = { 0, 0, 0 }, MeshArea = 0;
+            std::vector<double> Keys(_Clusters.size(), 0.0);
+            std::vector<double> Centers(_Clusters.size() * 3, 0.0), Normals(_Clusters.size() * 3, 0.0);
+            for (size_t K = 0; K < _Clusters.size(); ++K) {
+                const u32 End = K + 1 < _Clusters.size() ? _Clusters[K + 1] : TriangleCount;
+                double Area = 0;
+                for (u32 T = _Clusters[K]; T < End; ++T) {
+                    const u32* Tri = &_Indices[T * 3];
+                    const FCross N = TriangleCross(_Vertices, Tri);
+                    const double A = 0.5 * std::sqrt(N.X * N.X + N.Y * N.Y + N.Z * N.Z);
+                    for (u32 C = 0; C < 3; ++C) {
+                        double Centroid = 0;
+                        for (u32 P = 0; P < 3; ++P) Centroid += _Vertices[Tri[P]].Position[C];
+                        Centers[K * 3 + C] += Centroid / 3.0 * A;
+                    }
+                    Normals[K * 3 + 0] += N.X;
+                    Normals[K * 3 + 1] += N.Y;
+                    Normals[K * 3 + 2] += N.Z;
+                    Area += A;
+                }
+                for (u32 C = 0; C < 3; ++C) {
+                    MeshCenter[C] += Centers[K * 3 + C];
+                    if (Area > 0) Centers[K * 3 + C] /= Area;
+                }
+                MeshArea += Area;
+            }
+            if (MeshArea > 0)
+                for (double& C : MeshCenter) C /= MeshArea;
+
+            for (size_t K = 0; K < _Clusters.size(); ++K) {
+                const double* N = &Normals[K * 3];
+                const double Length = std::sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]);
+                if (Length <= 0) continue;
+                for (u32 C = 0; C < 3; ++C) Keys[K] += (Centers[K * 3 + C] - MeshCenter[C]) * N[C] / Length;
+            }
+            std::vector<u32> Order(_Clusters.size());
+            std::iota(Order.begin(), Order.end(), 0u);
+            std::stable_sort(Order.begin(), Order.end(), [&](u32 _A, u32 _B) { return Keys[_A] > Keys[_B]; });
+            return Order;
+        }
+    }
+
+    FVertexCacheStats& FVertexCacheStats::operator+=(const FVertexCacheStats& _Other) {
+        Misses    += _Other.Misses;
+        Triangles += _Other.Triangles;
+        Vertices  += _Other.Vertices;
+        return *this;
+    }
+
+    FVertexCacheStats AnalyzeVertexCache(std::span<const u32> _Indices, u32 _VertexCount, u32 _CacheSize) {
+        FVertexCacheStats Stats;
+        Stats.Triangles = _Indices.size() / 3;
+        Stats.Vertices  = _VertexCount;
+        FFifoCache Cache(_VertexCount, _CacheSize);
+        for (const u32 V : _Indices) Stats.Misses += !Cache.Touch(V);
+        return Stats;
+    }
+
+    FMeshOptimizeStats OptimizeMesh(std::vector<Vertex>& _Vertices, std::vector<u32>& _Indices,
+                                    const FMeshOptimizeOptions& _Options) {
+        FMeshOptimizeStats Stats;
+        const u32 VertexCount = static_cast<u32>(_Vertices.size());
+        Stats.Before = AnalyzeVertexCache(_Indices, VertexCount, _Options.CacheSize);
+        if (_Indices.size() < 3) {
+            Stats.After = Stats.Before;
+            return Stats;
+        }
+
+        std::vector<u32> Hard;
+        const std::vector<u32> Tipsified = Tipsify(_Indices, VertexCount, _Options.CacheSize, Hard);
+        const std::vector<u32> Clusters =
+            SoftBoundaries(Tipsified, VertexCount, Hard, _Options.CacheSize, _Options.OverdrawThreshold);
+        const std::vector<u32> Order = SortClustersForOverdraw(_Vertices, Tipsified, Clusters);
+        Stats.Clusters = static_cast<u32>(Clusters.size());
+
+        const u32 TriangleCount = static_cast<u32>(Tipsified.size() / 3);
+        _Indices.clear();
+        for (const u32 K : Order) {
+            const u32 End = K + 1 < Clusters.size() ? Clusters[K + 1] : TriangleCount;
+            _Indices.insert(_Indices.end(), Tipsified.begin() + Clusters[K] * 3, Tipsified.begin() + End * 3);
+        }
+
+        // Fetch: VB na ordem do primeiro uso pelo IB final. Vertice que nenhum triangulo usa (o
+        // weld nao gera, mas nada o proibe) vai para o fim, preservando a contagem e a AABB.
+        std::vector<u32> Remap(VertexCount, kNone);
+        u32 Next = 0;
+        for (u32& V : _Indices) {
+            if (Remap[V] == kNone) Remap[V] = Next++;
+            V = Remap[V];
+        }
+        for (u32& R : Remap)
+            if (R == kNone) R = Next++;
+        std::vector<Vertex> Reordered(VertexCount);
+        for (u32 V = 0; V < VertexCount; ++V) Reordered[Remap[V]] = _Vertices[V];
+        _Vertices.swap(Reordered);
+
+        Stats.After = AnalyzeVertexCache(_Indices, VertexCount, _Options.CacheSize);
+        return Stats;
+    }
+}
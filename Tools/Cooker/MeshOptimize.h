@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include <span>
+#include <vector>
+
+// Otimizacao pos-weld de uma parte cozida: ordem de triangulos para o cache pos-transform,
+// ordem de clusters para overdraw e ordem do VB para o fetch. So reordena — a geometria, o
+// winding de cada triangulo e o conjunto de vertices nao mudam.
+//
+// ⚠️ Roda ANTES do BuildRTTriangles: o payload de RT e posicional ao IB final (PrimitiveIndex i
+// = i-esimo triangulo), entao qualquer reordenacao depois dele descasaria os dois.
+namespace Smile::Cooker {
+    // Cache FIFO simulado. ACMR = misses/triangulo (1/2 e o limite de uma grade regular, 3 e
+    // nenhum reuso); ATVR = misses/vertice (1 e o otimo: cada vertice transformado uma vez).
+    struct FVertexCacheStats {
+        u64 Misses    = 0;
+        u64 Triangles = 0;
+        u64 Vertices  = 0;
+
+        double ACMR() const { return Triangles ? double(Misses) / double(Triangles) : 0.0; }
+        double ATVR() const { return Vertices ? double(Misses) / double(Vertices) : 0.0; }
+        FVertexCacheStats& operator+=(const FVertexCacheStats& Other);
+    };
+
+    FVertexCacheStats AnalyzeVertexCache(std::span<const u32> Indices, u32 VertexCount, u32 CacheSize = 16);
+
+    struct FMeshOptimizeOptions {
+        u32 CacheSize = 16; // alvo do Tipsify e tamanho do FIFO do relatorio
+        // Tolerancia de ACMR ao partir clusters para o overdraw: cluster menor = ordenacao mais
+        // fina, mas cada corte custa misses. 1.05 = aceita ate 5% de ACMR a mais.
+        f32 OverdrawThreshold = 1.05f;
+    };
+
+    struct FMeshOptimizeStats {
+        FVertexCacheStats Before;
+        FVertexCacheStats After;
+        u32               Clusters = 0;
+    };
+
+    // Tipsify (Sander, Nehab e Barczak 2007) -> clusters ordenados pela metrica de overdraw
+    // independente de vista do mesmo artigo -> VB em ordem de primeiro uso. Indices e vertices
+    // sao reescritos no lugar.
+    FMeshOptimizeStats OptimizeMesh(std::vector<Vertex>& Vertices, std::vector<u32>& Indices,
+                                    const FMeshOptimizeOptions& Options = {});
+}
@@ -0,0 +1,234 @@
+#include "TextureCook.h"
+#include "CookCache.h"
+#include "Smile/Graphics/Resources/MipChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+// Decoder da fonte: o stb_image ja vendorizado (o HDREnvironment usa o mesmo) em vez do WIC do
+// runtime — o cooker nao depende de COM. PNG/TGA/BMP dao os mesmos bytes; JPEG pode diferir no
+// ultimo bit do IDCT, abaixo do erro da compressao em blocos.
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_TGA
+#define STBI_ONLY_BMP
+#include <stb/stb_image.h>
+
+namespace fs = std::filesystem;
+
+namespace Smile::Cooker {
+    namespace {
+        constexpr u32 MakeFourCC(char _A, char _B, char _C, char _D) {
+            return static_cast<u32>(static_cast<u8>(_A)) | (static_cast<u32>(static_cast<u8>(_B)) << 8) |
+                   (static_cast<u32>(static_cast<u8>(_C)) << 16) | (static_cast<u32>(static_cast<u8>(_D)) << 24);
+        }
+
+        constexpr u32 kDDSMagic     = MakeFourCC('D', 'D', 'S', ' ');
+        constexpr u32 kCookTag      = MakeFourCC('S', 'M', 'T', 'C'); // dwReserved1[0] dos DDS cozidos aqui
+        constexpr u32 kHeaderBytes  = 128;                            // magic + DDS_HEADER
+        constexpr u32 kDX10Bytes    = 20;
+
+        // Valores de DXGI_FORMAT: o cooker nao inclui dxgiformat.h (e console app portavel).
+        u32 DxgiFormatOf(EBlockFormat _Format, bool _Srgb) {
+            switch (_Format) {
+                case EBlockFormat::BC1: return _Srgb ? 72u : 71u;
+                case EBlockFormat::BC3: return _Srgb ? 78u : 77u;
+                case EBlockFormat::BC4: return 80u;
+                case EBlockFormat::BC5: return 83u;
+                case EBlockFormat::BC7: return _Srgb ? 99u : 98u;
+            }
+            return 0u;
+        }
+
+        void Put32(std::vector<u8>& _Out, size_t _Offset, u32 _Value) {
+            std::memcpy(_Out.data() + _Offset, &_Value, 4);
+        }
+
+        double MsSince(std::chrono::steady_clock::time_point _Start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _Start).count();
+        }
+    }
+
+    EBlockFormat TextureSlotFormat(ETextureSlot _Slot, bool _HasAlpha, const FTextureCookOptions& _Options) {
+        switch (_Slot) {
+            case ETextureSlot::Normal:    return EBlockFormat::BC5;
+            case ETextureSlot::Metalness:
+            case ETextureSlot::Roughness: return EBlockFormat::BC4;
+            case ETextureSlot::Emissive:  return EBlockFormat::BC1;
+            case ETextureSlot::BaseColor:
+            case ETextureSlot::Specular:
+                if (!_Options.Compat) return EBlockFormat::BC7;
+                return _HasAlpha ? EBlockFormat::BC3 : EBlockFormat::BC1;
+        }
+        return EBlockFormat::BC7;
+    }
+
+    bool TextureSlotIsSrgb(ETextureSlot _Slot) {
+        return _Slot == ETextureSlot::BaseColor || _Slot == ETextureSlot::Emissive;
+    }
+
+    const char* TextureSlotName(ETextureSlot _Slot) {
+        switch (_Slot) {
+            case ETextureSlot::BaseColor: return "basecolor";
+            case ETextureSlot::Specular:  return "specular";
+            case ETextureSlot::Normal:    return "normal";
+            case ETextureSlot::Emissive:  return "emissive";
+            case ETextureSlot::Metalness: return "metalness";
+            case ETextureSlot::Roughness: return "roughness";
+        }
+        return "?";
+    }
+
+    std::vector<FMipImage> BuildMipChain(FMipImage _Mip0, bool _IsNormalMap, bool _SrgbSpace) {
+        if (_IsNormalMap)
+            for (size_t i = 3; i < _Mip0.Pixels.size(); i += 4) _Mip0.Pixels[i] = 255;
+        std::vector<FMipImage> Mips;
+        Mips.push_back(std::move(_Mip0));
+        while (Mips.back().Width > 1 || Mips.back().Height > 1) {
+            const FMipImage& Prev = Mips.back();
+            FMipImage Next;
+            Next.Width  = std::max(1u, Prev.Width / 2);
+            Next.Height = std::max(1u, Prev.Height / 2);
+            Next.Pixels.resize(static_cast<size_t>(Next.Width) * Next.Height * 4);
+            if (_IsNormalMap)
+                DownsampleNormal2x2(Prev.Pixels.data(), Prev.Width, Prev.Height, Next.Pixels.data(), Next.Width, Next.Height);
+            else
+                DownsampleColor2x2(Prev.Pixels.data(), Prev.Width, Prev.Height, Next.Pixels.data(), Next.Width,
+                                   Next.Height, _SrgbSpace);
+            Mips.push_back(std::move(Next));
+        }
+        return Mips;
+    }
+
+    std::vector<u8> BuildDDS(EBlockFormat _Format, bool _Srgb, u32 _Width, u32 _Height,
+                             std::span<const std::vector<u8>> _Mips, u64 _CookHash) {
+        size_t DataBytes = 0;
+        for (const std::vector<u8>& Mip : _Mips) DataBytes += Mip.size();
+        std::vector<u8> Out(kHeaderBytes + kDX10Bytes, 0);
+        Out.reserve(Out.size() + DataBytes);
+
+        constexpr u32 DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000,
+                      DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+        constexpr u32 DDPF_FOURCC = 0x4;
+        constexpr u32 DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+        Put32(Out, 0, kDDSMagic);
+        Put32(Out, 4, 124);
+        Put32(Out, 8, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+        Put32(Out, 12, _Height);
+        Put32(Out, 16, _Width);
+        Put32(Out, 20, _Mips.empty() ? 0u : static_cast<u32>(_Mips[0].size()));
+        Put32(Out, 28, static_cast<u32>(_Mips.size()));
+        Put32(Out, 32, kCookTag);
+        Put32(Out, 36, static_cast<u32>(_CookHash));
+        Put32(Out, 40, static_cast<u32>(_CookHash >> 32));
+        Put32(Out, 44, kTextureCookRevision);
+        Put32(Out, 76, 32);
+        Put32(Out, 80, DDPF_FOURCC);
+        Put32(Out, 84, MakeFourCC('D', 'X', '1', '0'));
+        Put32(Out, 108, DDSCAPS_TEXTURE | (_Mips.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0u));
+        // DDS_HEADER_DXT10: formato, TEXTURE2D, sem flags, 1 fatia.
+        Put32(Out, 128, DxgiFormatOf(_Format, _Srgb));
+        Put32(Out, 132, 3);
+        Put32(Out, 140, 1);
+        for (const std::vector<u8>& Mip : _Mips) Out.insert(Out.end(), Mip.begin(), Mip.end());
+        return Out;
+    }
+
+    u64 ReadDDSCookHash(const fs::path& _Path) {
+        std::ifstream File(_Path, std::ios::binary);
+        u8 Header[kHeaderBytes];
+        if (!File || !File.read(reinterpret_cast<char*>(Header), sizeof(Header))) return 0;
+        u32 Magic, Tag, Lo, Hi;
+        std::memcpy(&Magic, Header, 4);
+        std::memcpy(&Tag, Header + 32, 4);
+        std::memcpy(&Lo, Header + 36, 4);
+        std::memcpy(&Hi, Header + 40, 4);
+        if (Magic != kDDSMagic || Tag != kCookTag) return 0;
+        return (static_cast<u64>(Hi) << 32) | Lo;
+    }
+
+    FTextureCookResult CookTexture(const fs::path& _SceneDir, const std::string& _SourceRelative,
+                                   const std::string& _OutputRelative, ETextureSlot _Slot,
+                                   const FTextureCookOptions& _Options) {
+        const auto Start = std::chrono::steady_clock::now();
+        FTextureCookResult Result;
+        Result.OutputRelative = _OutputRelative;
+        auto Fail = [&](std::string _Error) {
+            Result.Failed = true;
+            Result.Error  = std::move(_Error);
+            Result.Ms     = MsSince(Start);
+            return Result;
+        };
+
+        std::vector<u8> Source;
+        {
+            std::ifstream File(_SceneDir / _SourceRelative, std::ios::binary | std::ios::ate);
+            if (!File) return Fail("nao abriu a fonte");
+            Source.resize(static_cast<size_t>(File.tellg()));
+            File.seekg(0, std::ios::beg);
+            if (!File.read(reinterpret_cast<char*>(Source.data()), static_cast<std::streamsize>(Source.size())))
+                return Fail("falha na leitura da fonte");
+        }
+        Result.SourceBytes = Source.size();
+
+        FHasher Hasher;
+        Hasher.Add(static_cast<u64>(kTextureCookRevision));
+        Hasher.Add(static_cast<u64>(_Slot));
+        Hasher.Add(static_cast<u64>(_Options.Compat ? 1u : 0u));
+        Hasher.Add(static_cast<u64>(_Options.Quality));
+        Hasher.Add(Source.data(), Source.size());
+        const u64 CookHash = std::max<u64>(Hasher.Value(), 1u); // 0 = "nao e nosso" no ReadDDSCookHash
+
+        const fs::path Output = _SceneDir / _OutputRelative;
+        if (ReadDDSCookHash(Output) == CookHash) {
+            std::error_code Ec;
+            Result.Reused      = true;
+            Result.OutputBytes = fs::file_size(Output, Ec);
+            Result.Ms          = MsSince(Start);
+            return Result;
+        }
+
+        int Width = 0, Height = 0, Channels = 0;
+        stbi_uc* Decoded = stbi_load_from_memory(Source.data(), static_cast<int>(Source.size()),
+                                                 &Width, &Height, &Channels, 4);
+        if (!Decoded) return Fail(std::string("decode: ") + stbi_failure_reason());
+        FMipImage Mip0;
+        Mip0.Width  = static_cast<u32>(Width);
+        Mip0.Height = static_cast<u32>(Height);
+        Mip0.Pixels.assign(Decoded, Decoded + static_cast<size_t>(Width) * Height * 4);
+        stbi_image_free(Decoded);
+        Source = {};
+
+        bool HasAlpha = false;
+        for (size_t i = 3; i < Mip0.Pixels.size() && !HasAlpha; i += 4) HasAlpha = Mip0.Pixels[i] != 255;
+        const bool Srgb = TextureSlotIsSrgb(_Slot);
+        Result.Format   = TextureSlotFormat(_Slot, HasAlpha, _Options);
+        Result.Width    = Mip0.Width;
+        Result.Height   = Mip0.Height;
+
+        const std::vector<FMipImage> Mips = BuildMipChain(std::move(Mip0), _Slot == ETextureSlot::Normal, Srgb);
+        std::vector<std::vector<u8>> Blocks;
+        Blocks.reserve(Mips.size());
+        FBlockEncodeOptions Encode;
+        Encode.Quality = _Options.Quality;
+        Encode.Threads = _Options.Threads;
+        for (const FMipImage& Mip : Mips) {
+            Blocks.push_back(CompressSurface(Result.Format, Mip.Pixels.data(), Mip.Width, Mip.Height, Encode));
+            const std::vector<u8> Decoded = DecompressSurface(Result.Format, Blocks.back().data(), Mip.Width, Mip.Height);
+            Result.Quality.Merge(MeasureBlockQuality(Result.Format, Mip.Pixels.data(), Decoded.data(), Mip.Width, Mip.Height));
+        }
+        Result.MipCount = static_cast<u32>(Mips.size());
+
+        const std::vector<u8> DDS = BuildDDS(Result.Format, Srgb, Result.Width, Result.Height, Blocks, CookHash);
+        std::error_code Ec;
+        fs::create_directories(Output.parent_path(), Ec);
+        const std::span<const u8> Pieces[] = { DDS };
+        if (WriteFileIncremental(Output, Pieces) < 0) return Fail("falha ao gravar " + Output.string());
+        Result.OutputBytes = DDS.size();
+        Result.Ms          = MsSince(Start);
+        return Result;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "BlockCompress.h"
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+// Estagio de texturas do cooker: PNG/TGA/JPG/BMP referenciados pelos materiais viram DDS com a
+// mip chain pronta e comprimida em blocos, e o caminho no SSceneMaterial passa a apontar para o
+// DDS. O runtime escolhe o loader pela extensao, entao a textura cozida cai direto no
+// FTexture::LoadDDSCPU — sem WIC, sem filtro de mip e com 1/4 a 1/8 da VRAM do RGBA8.
+//
+// A mip chain sai dos MESMOS kernels do FTexture::LoadCPU (MipChain.h): box em linear para os
+// slots sRGB, normal renormalizada para o Normal. DDS ja existente no disco nao passa por aqui.
+//
+// Recook incremental: o DDS gravado leva no dwReserved1 do cabecalho um hash da fonte + slot +
+// opcoes + kTextureCookRevision. DDS no destino com o mesmo hash e reaproveitado sem decodificar.
+//
+// ⚠️ Mudou encoder, filtro de mip ou a tabela de formatos por slot? Suba kTextureCookRevision.
+namespace Smile::Cooker {
+    constexpr u32 kTextureCookRevision = 1u;
+
+    // Slot do SSceneMaterial que referencia a textura: decide formato e espaco de cor.
+    enum class ETextureSlot : u8 { BaseColor, Specular, Normal, Emissive, Metalness, Roughness };
+
+    struct FTextureCookOptions {
+        // --tex-compat: BC1/BC3 no lugar do BC7 (encode bem mais rapido, cor e alfa piores).
+        bool Compat = false;
+        // --tex-quality: tier do encoder (entra no hash; Fast e o do CI).
+        EBlockQuality Quality = EBlockQuality::Normal;
+        // Threads de cada CookTexture, nas linhas de blocos. Nao entra no hash: os bytes sao os
+        // mesmos para qualquer valor.
+        u32 Threads = 1;
+    };
+
+    // BaseColor BC7 (alfa do cutout incluso), Specular (ORM packed) BC7, Emissive BC1, Normal BC5
+    // (o runtime reconstroi Z), Metalness/Roughness BC4. Com Compat, os slots BC7 viram BC3 se a
+    // fonte tem alfa e BC1 se nao tem.
+    EBlockFormat TextureSlotFormat(ETextureSlot Slot, bool HasAlpha, const FTextureCookOptions& Options);
+    bool         TextureSlotIsSrgb(ETextureSlot Slot);
+    const char*  TextureSlotName(ETextureSlot Slot);
+
+    struct FMipImage {
+        std::vector<u8> Pixels; // RGBA8
+        u32             Width  = 0;
+        u32             Height = 0;
+    };
+
+    // Mip chain completa (ate 1x1) a partir da mip 0, com o filtro do FTexture::LoadCPU. Normal
+    // map tem o alfa forcado a 255 na mip 0, como la.
+    std::vector<FMipImage> BuildMipChain(FMipImage Mip0, bool IsNormalMap, bool SrgbSpace);
+
+    // DDS com cabecalho DX10 (o LoadDDSCPU aceita qualquer formato BC por ele). `_Mips` ja
+    // comprimidos, da mip 0 em diante. CookHash vai no dwReserved1.
+    std::vector<u8> BuildDDS(EBlockFormat Format, bool Srgb, u32 Width, u32 Height,
+                             std::span<const std::vector<u8>> Mips, u64 CookHash);
+    // Hash gravado por BuildDDS; 0 se o arquivo nao existe ou nao saiu deste cooker.
+    u64 ReadDDSCookHash(const std::filesystem::path& Path);
+
+    struct FTextureCookResult {
+        std::string  OutputRelative; // relativo a cena, como vai no SSceneMaterial
+        EBlockFormat Format  = EBlockFormat::BC7;
+        bool         Failed  = false;
+        bool         Reused  = false; // DDS no destino ja tinha o mesmo hash
+        std::string  Error;
+        u32          Width = 0, Height = 0, MipCount = 0;
+        u64          SourceBytes = 0;
+        u64          OutputBytes = 0;
+        double       Ms = 0.0;
+        // Erro do BC contra as mips RGBA8 do gerador do LoadCPU, a chain inteira. Vazio se Reused.
+        FBlockQualityReport Quality;
+    };
+
+    // Cozinha `_SourceRelative` (relativo a `_SceneDir`) para `_OutputRelative`. Nunca lanca: erro
+    // sai em Failed/Error e o chamador mantem o caminho original no material.
+    FTextureCookResult CookTexture(const std::filesystem::path& SceneDir, const std::string& SourceRelative,
+                                   const std::string& OutputRelative, ETextureSlot Slot,
+                                   const FTextureCookOptions& Options);
+}
@@ -0,0 +1,128 @@
+#include "VertexWeld.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SMILE_WELD_SSE2 1
+#endif
+
+namespace Smile::Cooker {
+    namespace {
+        constexpr u64 kPrime1 = 0x9E3779B185EBCA87ull;
+        constexpr u64 kPrime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr u64 kPrime3 = 0x165667B19E3779F9ull;
+        constexpr u64 kPrime4 = 0x85EBCA77C2B2AE63ull;
+
+        u64 Round(u64 _Acc, u64 _Lane) {
+            return std::rotl(_Acc + _Lane * kPrime2, 31) * kPrime1;
+        }
+
+        bool KeysEqual(const void* _A, const void* _B) {
+#if defined(SMILE_WELD_SSE2)
+            // Duas comparacoes de 16 bytes e um movemask: sem laco nem desvio por byte.
+            const __m128i A0 = _mm_load_si128(static_cast<const __m128i*>(_A));
+            const __m128i A1 = _mm_load_si128(static_cast<const __m128i*>(_A) + 1);
+            const __m128i B0 = _mm_load_si128(static_cast<const __m128i*>(_B));
+            const __m128i B1 = _mm_load_si128(static_cast<const __m128i*>(_B) + 1);
+            const __m128i Eq = _mm_and_si128(_mm_cmpeq_epi32(A0, B0), _mm_cmpeq_epi32(A1, B1));
+            return _mm_movemask_epi8(Eq) == 0xFFFF;
+#else
+            return std::memcmp(_A, _B, 32) == 0;
+#endif
+        }
+    }
+
+    u64 HashWeldKey(const void* _Key32) {
+        u64 Lanes[4];
+        std::memcpy(Lanes, _Key32, sizeof(Lanes));
+        // As 4 lanes nao dependem umas das outras: o compilador as intercala (ou vetoriza), e a
+        // latencia do multiply nao se acumula como no FNV byte a byte.
+        const u64 V0 = Round(kPrime1 + kPrime2, Lanes[0]);
+        const u64 V1 = Round(kPrime2, Lanes[1]);
+        const u64 V2 = Round(0, Lanes[2]);
+        const u64 V3 = Round(0 - kPrime1, Lanes[3]);
+        u64 H = std::rotl(V0, 1) + std::rotl(V1, 7) + std::rotl(V2, 12) + std::rotl(V3, 18);
+        H += 32;
+        H ^= H >> 33;
+        H *= kPrime2;
+        H ^= H >> 29;
+        H *= kPrime3;
+        H ^= H >> 32;
+        return H ^ kPrime4;
+    }
+
+    FVertexWelder::FVertexWelder(const FWeldOptions& _Options)
+        : Epsilon(_Options.Epsilon > 0.0f ? _Options.Epsilon : 0.0f),
+          InvEpsilon(_Options.Epsilon > 0.0f ? 1.0 / double(_Options.Epsilon) : 0.0) {
+        static_assert(sizeof(Vertex) == sizeof(FKey), "a chave e o vertice inteiro (8 floats)");
+    }
+
+    void FVertexWelder::Reserve(size_t _UniqueVertices) {
+        Keys.reserve(_UniqueVertices);
+        // Carga <= 1/2: com sondagem linear, o comprimento medio da busca fica abaixo de 2.5.
+        size_t Capacity = 16;
+        while (Capacity < _UniqueVertices * 2) Capacity *= 2;
+        if (Capacity <= Slots.size()) return;
+        std::vector<u64> Old = std::move(Slots);
+        Slots.assign(Capacity, 0);
+        Mask = Capacity - 1;
+        for (const u64 Slot : Old) {
+            if (!Slot) continue;
+            size_t I = static_cast<size_t>(HashWeldKey(&Keys[static_cast<u32>(Slot) - 1u]) & Mask);
+            while (Slots[I]) I = (I + 1) & Mask;
+            Slots[I] = Slot;
+        }
+    }
+
+    void FVertexWelder::Grow() {
+        Reserve(std::max<size_t>(Slots.size(), 16));
+    }
+
+    FVertexWelder::FKey FVertexWelder::MakeKey(const Vertex& _V) const {
+        FKey Key;
+        std::memcpy(Key.Words, &_V, sizeof(Key.Words));
+        if (Epsilon > 0.0f) {
+            // Celula = x / Epsilon arredondado para o inteiro mais proximo, de volta para float: o
+            // valor ajustado e canonico (-0.0 vira 0.0) e ocupa os mesmos 32 bits, entao hash e
+            // comparacao nao mudam. O arredondamento e o da soma com 1.5 * 2^52 (par no empate):
+            // sem conversao para inteiro nem std::floor, que sem SSE4.1 vira chamada de biblioteca
+            // e alonga a cadeia antes do acesso a tabela.
+            constexpr double kRoundMagic = 6755399441055744.0;
+            for (u32& Word : Key.Words) {
+                const double T = double(std::bit_cast<f32>(Word)) * InvEpsilon;
+                if (!(std::fabs(T) < 0x1p51)) continue; // inf/NaN, ou longe demais da grade: exato
+                const double Cell = (T + kRoundMagic) - kRoundMagic;
+                Word = std::bit_cast<u32>(static_cast<f32>(Cell * double(Epsilon)) + 0.0f);
+            }
+        }
+        return Key;
+    }
+
+    u32 FVertexWelder::Add(const Vertex& _V, bool& _Inserted) {
+        if ((Keys.size() + 1) * 2 > Slots.size()) Grow();
+        const FKey Key  = MakeKey(_V);
+        const u64  Hash = HashWeldKey(&Key);
+        const u64  Tag  = Hash & 0xFFFFFFFF00000000ull;
+        for (size_t I = static_cast<size_t>(Hash & Mask);; I = (I + 1) & Mask) {
+            const u64 Slot = Slots[I];
+            if (!Slot) {
+                const u32 Index = static_cast<u32>(Keys.size());
+                Keys.push_back(Key);
+                Slots[I] = Tag | (u64(Index) + 1u);
+                _Inserted = true;
+                return Index;
+            }
+            if ((Slot & 0xFFFFFFFF00000000ull) == Tag) {
+                const u32 Index = static_cast<u32>(Slot) - 1u;
+                if (KeysEqual(&Keys[Index], &Key)) {
+                    _Inserted = false;
+                    return Index;
+                }
+            }
+        }
+    }
+}
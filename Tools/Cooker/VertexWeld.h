@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Smile/Graphics/Resources/Mesh.h"
+#include <vector>
+
+// Weld de vertices do cooker: tabela de enderecamento aberto (sondagem linear, potencia de 2)
+// com as chaves em vetores contiguos, no lugar do std::unordered_map de no por vertice.
+//
+// A saida e a mesma do weld antigo: indices na ordem do primeiro aparecimento, e dois vertices
+// soldam se e so se os 32 bytes forem iguais (0.0 e -0.0 NAO soldam; NaN com os mesmos bits sim).
+// Com Epsilon > 0 os 8 floats sao arredondados para uma grade antes de hashear e comparar — o
+// vertice emitido e o PRIMEIRO da celula, sem media.
+namespace Smile::Cooker {
+    struct FWeldOptions {
+        // 0 = weld exato. > 0: passo da grade, igual para posicao, normal e UV. Dois componentes
+        // na mesma celula distam menos que Epsilon (ou que um ulp do float, se for maior); dois
+        // vertices a menos de Epsilon mas em celulas vizinhas NAO soldam — a grade e conservadora.
+        f32 Epsilon = 0.0f;
+    };
+
+    class FVertexWelder {
+    public:
+        explicit FVertexWelder(const FWeldOptions& Options = {});
+
+        // Dimensiona a tabela para `_UniqueVertices` sem rehash; estimativa errada so custa um
+        // crescimento.
+        void Reserve(size_t UniqueVertices);
+        // Indice do vertice soldado. `_Inserted` = o vertice e inedito e o chamador deve anexa-lo
+        // ao seu VB (o indice devolvido e a posicao dele la).
+        u32  Add(const Vertex& V, bool& Inserted);
+        u32  Size() const { return static_cast<u32>(Keys.size()); }
+
+    private:
+        struct alignas(16) FKey {
+            u32 Words[8];
+        };
+
+        FKey MakeKey(const Vertex& V) const;
+        void Grow();
+
+        // Slot = 32 bits altos do hash | (indice + 1) nos 32 baixos; 0 = vazio. A posicao vem dos
+        // bits baixos, entao os altos sao independentes dela e rejeitam quase toda colisao de
+        // sondagem sem tocar a chave.
+        std::vector<u64>  Slots;
+        std::vector<FKey> Keys; // por vertice unico, na ordem dos indices
+        u64               Mask = 0;
+        f32               Epsilon = 0.0f;
+        double            InvEpsilon = 0.0;
+    };
+
+    // Hash de 64 bits de 32 bytes: a rodada do xxHash64 em 4 lanes independentes (uma por
+    // palavra de 64 bits) e a avalanche final. Exposto para o teste medir a distribuicao.
+    u64 HashWeldKey(const void* Key32);
+}
@@ -1,7 +1,9 @@
 // SmileCooker — converte um arquivo FBX (via ufbx) no formato binario proprio da
 // engine (.smesh + .sscene). Roda offline; o runtime nunca le FBX direto.
 //
-// Uso:  SmileCooker <entrada.fbx> [saida_sem_extensao]
+// Uso:  SmileCooker <entrada.fbx> [saida_sem_extensao] [--opaque-glass] [--compress] [--quantize-positions]
+//                   [--no-optimize] [--jobs N] [--no-cache] [--weld-epsilon E] [--no-lods]
+//                   [--no-textures] [--tex-compat] [--tex-quality fast|normal|slow]
 //   ex: SmileCooker Assets/Scenes/Bistro/BistroExterior.fbx
 //       -> gera BistroExterior.smesh e BistroExterior.sscene ao lado do .fbx
 //
@@ -10,12 +12,31 @@
 //   2. Por no com mesh, por parte-de-material: triangula em espaco LOCAL, converte RH->LH
 //      (nega Z + inverte winding), funde vertices (weld). O transform do no NAO entra no
 //      vertice — vira TRS do renderavel (v7). Com isso (malha, parte) e DEDUPLICADA: N nos
-//      que compartilham a malha viram N instancias de UMA geometria.
-//   3. Resolve as texturas pela convencao Bistro (nome_Sufixo.dds) + fallback ufbx.
-//   4. Escreve .smesh (geometria) e .sscene (materiais + renderaveis).
+//      que compartilham a malha viram N instancias de UMA geometria. Depois do weld, cada parte
+//      e reordenada para cache pos-transform, overdraw e fetch (MeshOptimize.h). As partes
+//      ineditas cozinham em paralelo (--jobs); a montagem e serial e na ordem dos nos, entao a
+//      saida e byte a byte a mesma para qualquer numero de threads.
+//   3. Resolve as texturas pela convencao Bistro (nome_Sufixo.dds) + fallback ufbx. As que nao
+//      sao DDS cozinham para DDS BC com mips em Textures/Cooked/ (TextureCook.h), e o material
+//      passa a apontar para elas; --no-textures deixa os caminhos originais. O relatorio traz o
+//      PSNR/SSIM do BC contra as mips RGBA8 que o runtime geraria; --tex-quality fast e o do CI.
+//   4. Escreve .smesh (geometria) e .sscene (materiais + renderaveis). Com --compress, cada
+//      mesh vai num bloco codificado (v9, CookedCodec.h) em vez das tres regioes cruas. Os
+//      clusters de cada mesh (v10, MeshClusters.h) vao sempre crus, depois da geometria, e a
+//      cadeia de LODs (v11, MeshLod.h) crua depois deles.
+//   5. Recook incremental (CookCache.h): `<saida>.cookcache` guarda cada parte cozida pelo hash
+//      da fonte + opcoes; parte inalterada sai do cache em vez de cozinhar, e os dois arquivos so
+//      regravam os blocos que mudaram. --no-cache ignora e nao toca o cache.
 
 #include "Smile/Scene/CookedFormat.h"
+#include "Smile/Scene/CookedCodec.h"
+#include "Smile/Scene/MeshClusters.h"
+#include "Smile/Scene/MeshLod.h"
 #include "Smile/Graphics/Resources/Mesh.h" // Smile::Vertex (stride 32)
+#include "MeshOptimize.h"
+#include "CookCache.h"
+#include "VertexWeld.h"
+#include "TextureCook.h"
 
 #include "ufbx.h"
 
@@ -28,8 +49,16 @@
 #include <map>
 #include <filesystem>
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
 
 namespace fs = std::filesystem;
 using Smile::Vertex;
@@ -96,38 +125,22 @@ static NodeTRS DecomposeToEngineTRS(const ufbx_matrix& G) {
 }
 
 // ----------------------------------------------------------------------------
-// Weld de vertices: chave = 8 floats (pos3, normal3, uv2), igualdade por bytes.
-struct VertKey {
-    Vertex V;
-    bool operator==(const VertKey& O) const {
-        return std::memcmp(&V, &O.V, sizeof(Vertex)) == 0;
-    }
-};
-struct VertKeyHash {
-    size_t operator()(const VertKey& K) const {
-        // FNV-1a sobre os bytes do vertice.
-        const auto* p = reinterpret_cast<const unsigned char*>(&K.V);
-        size_t h = 1469598103934665603ull;
-        for (size_t i = 0; i < sizeof(Vertex); ++i) { h ^= p[i]; h *= 1099511628211ull; }
-        return h;
-    }
-};
-
-// Sub-mesh acumulado durante o cook.
+// Sub-mesh acumulado durante o cook. Weld: chave = 8 floats (pos3, normal3, uv2), igualdade por
+// bytes — ou por celula de grade com --weld-epsilon (VertexWeld.h).
 struct SubMesh {
     std::vector<Vertex>   Vertices;
     std::vector<uint32_t> Indices;
-    std::unordered_map<VertKey, uint32_t, VertKeyHash> Weld;
+    Smile::Cooker::FVertexWelder Weld;
     float Min[3] = {  1e30f,  1e30f,  1e30f };
     float Max[3] = { -1e30f, -1e30f, -1e30f };
 
+    explicit SubMesh(const Smile::Cooker::FWeldOptions& options) : Weld(options) {}
+
     uint32_t Add(const Vertex& v) {
-        VertKey k{ v };
-        auto it = Weld.find(k);
-        if (it != Weld.end()) return it->second;
-        uint32_t idx = static_cast<uint32_t>(Vertices.size());
+        bool inserted = false;
+        const uint32_t idx = Weld.Add(v, inserted);
+        if (!inserted) return idx;
         Vertices.push_back(v);
-        Weld.emplace(k, idx);
         for (int c = 0; c < 3; ++c) {
             Min[c] = std::min(Min[c], v.Position[c]);
             Max[c] = std::max(Max[c], v.Position[c]);
@@ -291,25 +304,259 @@ static bool LooksGlass(const std::vector<std::string>& toks) {
     return HasToken(toks, { "glass" });
 }
 
+// ----------------------------------------------------------------------------
+// Cook de UMA (malha, parte): tudo o que depende so da geometria e nada do resto da cena. Roda na
+// fase paralela do main — so LE o ufbx_scene (triangulacao e atributos sao consultas puras) e
+// cada chamada tem os proprios buffers. O resultado sai com offsets RELATIVOS ao proprio Bytes;
+// a montagem serial desloca pelo tamanho do blob naquele ponto.
+struct CookOptions {
+    bool Optimize = true;
+    bool Compress = false;
+    Smile::FMeshCodingOptions Coding;
+    Smile::Cooker::FWeldOptions Weld;
+    bool Lods = true;
+};
+
+using CookedPart = Smile::Cooker::FCookedPart;
+
+template <typename T>
+static void AppendBytes(std::vector<uint8_t>& out, const std::vector<T>& v) {
+    out.insert(out.end(), reinterpret_cast<const uint8_t*>(v.data()),
+               reinterpret_cast<const uint8_t*>(v.data()) + v.size()*sizeof(T));
+}
+
+static CookedPart CookPart(const ufbx_mesh* mesh, const ufbx_mesh_part& part, const CookOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    CookedPart out;
+    std::vector<uint32_t> triBuf(std::max<size_t>(mesh->max_face_triangles * 3, 3));
+
+    // v7: geometria em LOCAL. Sobra do mundo apenas a conversao de eixo RH->LH (nega Z), que
+    // e do ESPACO e nao do no — por isso continua aqui e mantem os bytes iguais entre
+    // instancias. A inversa-transposta saiu junto com o bake: sem transform no vertice, a
+    // normal local nao precisa de correcao de escala (quem aplica escala e a matriz de modelo).
+    //
+    // O espelhamento tambem deixa de ser por no: com o transform fora do vertice, o
+    // determinante negativo passa a viver na ESCALA do TRS, e quem inverte o winding
+    // efetivo e a matriz de modelo. Ficaria errado bakear o flip na geometria compartilhada.
+    // (Medido: nenhuma das 3 cenas tem determinante negativo.)
+    // (Entra no sal do CookCache: trocar a constante invalida as partes cozidas com a outra.)
+    const bool reverseWinding = kReverseWinding;
+
+    SubMesh sm(options.Weld);
+    // Uma parte fechada tem perto de T/2 vertices unicos; costuras de UV/normal empurram para
+    // cima. Reservar T evita quase todo rehash sem dobrar a memoria da parte.
+    sm.Weld.Reserve(part.num_triangles);
+    sm.Vertices.reserve(part.num_triangles);
+    sm.Indices.reserve(part.num_triangles * 3);
+    for (size_t fi = 0; fi < part.face_indices.count; ++fi) {
+        ufbx_face face = mesh->faces.data[part.face_indices.data[fi]];
+        uint32_t numTri = ufbx_triangulate_face(triBuf.data(), triBuf.size(), mesh, face);
+        for (uint32_t t = 0; t < numTri; ++t) {
+            uint32_t corner[3] = { triBuf[t*3+0], triBuf[t*3+1], triBuf[t*3+2] };
+            uint32_t outIdx[3];
+            for (int c = 0; c < 3; ++c) {
+                ufbx_vec3 p = ufbx_get_vertex_vec3(&mesh->vertex_position, corner[c]);
+                ufbx_vec3 n = mesh->vertex_normal.exists
+                            ? ufbx_get_vertex_vec3(&mesh->vertex_normal, corner[c])
+                            : ufbx_vec3{0,1,0};
+                ufbx_vec2 uv = mesh->vertex_uv.exists
+                            ? ufbx_get_vertex_vec2(&mesh->vertex_uv, corner[c])
+                            : ufbx_vec2{0,0};
+                // v7: SEM transform aqui. A posicao e a normal ficam em espaco local; o
+                // geometry_to_world virou o TRS do renderavel. E isto que faz duas
+                // instancias da mesma malha gerarem bytes identicos e poderem ser
+                // deduplicadas — com o bake, cada uma era uma copia unica.
+                double nl = std::sqrt(n.x*n.x + n.y*n.y + n.z*n.z);
+                if (nl > 1e-12) { n.x/=nl; n.y/=nl; n.z/=nl; }
+                Vertex v;
+                v.Position[0] = (float)p.x; v.Position[1] = (float)p.y; v.Position[2] = -(float)p.z; // RH->LH
+                v.Normal[0]   = (float)n.x; v.Normal[1]   = (float)n.y; v.Normal[2]   = -(float)n.z;
+                v.TexCoord[0] = (float)uv.x; v.TexCoord[1] = 1.0f - (float)uv.y; // V flip (FBX->D3D)
+                outIdx[c] = sm.Add(v);
+            }
+            if (reverseWinding) {
+                sm.Indices.push_back(outIdx[0]);
+                sm.Indices.push_back(outIdx[2]);
+                sm.Indices.push_back(outIdx[1]);
+            } else {
+                sm.Indices.push_back(outIdx[0]);
+                sm.Indices.push_back(outIdx[1]);
+                sm.Indices.push_back(outIdx[2]);
+            }
+            ++out.Triangles;
+        }
+    }
+    if (sm.Vertices.empty() || sm.Indices.empty()) {
+        out.Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return out;
+    }
+    out.Empty = false;
+
+    // Reordena ANTES do payload de RT (ver MeshOptimize.h): depois do weld e do winding,
+    // e so a ordem dos triangulos e dos vertices que muda. Sem o passo, o relatorio ainda
+    // mede a ordem original, para comparar com uma rodada otimizada.
+    if (options.Optimize) {
+        out.Cache = Smile::Cooker::OptimizeMesh(sm.Vertices, sm.Indices);
+    } else {
+        out.Cache.Before = Smile::Cooker::AnalyzeVertexCache(sm.Indices, (uint32_t)sm.Vertices.size());
+        out.Cache.After  = out.Cache.Before;
+    }
+
+    Smile::SMeshEntry& e = out.Entry;
+    e.VertexCount = (uint32_t)sm.Vertices.size();
+    e.IndexCount  = (uint32_t)sm.Indices.size();
+    for (int c = 0; c < 3; ++c) { e.AABBMin[c] = sm.Min[c]; e.AABBMax[c] = sm.Max[c]; }
+    // v8: payload de RT, AQUI e nao antes. Neste ponto `sm.Indices` ja passou pelo weld
+    // (sm.Add) e pelo reverseWinding do laco acima, entao o triangulo i deste vetor e
+    // exatamente o PrimitiveIndex i que o BLAS vera. Gerar antes do winding inverteria o
+    // cross e a normal de face sairia trocada — silenciosamente, porque so o facing
+    // mudaria e a imagem so denunciaria no verso.
+    std::vector<Smile::FRTTriangle> rtTris;
+    Smile::BuildRTTriangles(sm.Vertices.data(), (uint32_t)sm.Vertices.size(),
+                            sm.Indices.data(), (uint32_t)sm.Indices.size(), rtTris);
+    e.RTTriangleCount = (uint32_t)rtTris.size();
+    out.RawBytes = sm.Vertices.size()*sizeof(Vertex) + sm.Indices.size()*sizeof(uint32_t)
+                 + rtTris.size()*sizeof(Smile::FRTTriangle);
+
+    std::vector<uint8_t>& bytes = out.Bytes;
+    if (options.Compress) {
+        // v9: as tres regioes viram UM bloco; os offsets crus ficam 0. O bloco e codificado
+        // a partir dos MESMOS vetores que iriam crus, entao o RT continua posicional ao IB.
+        const Smile::FMeshView view{ sm.Vertices, sm.Indices, rtTris };
+        Smile::FCodedMeshBlock block = Smile::EncodeMeshBlock(e, view, options.Coding);
+        e.Flags       = block.Flags;
+        e.RawBytes    = block.RawBytes;
+        e.CodedOffset = bytes.size();
+        e.CodedBytes  = (uint32_t)block.Bytes.size();
+        AppendBytes(bytes, block.Bytes);
+        // Mantem o blob multiplo de 4: a proxima parte pode ser crua (zero-copia exige o
+        // alinhamento do tipo) e o custo e no maximo 3 bytes por mesh.
+        while (bytes.size() % 4) bytes.push_back(0);
+    } else {
+        e.VertexOffset = bytes.size();
+        AppendBytes(bytes, sm.Vertices);
+        e.IndexOffset = bytes.size();
+        AppendBytes(bytes, sm.Indices);
+        e.RTTriangleOffset = bytes.size();
+        AppendBytes(bytes, rtTris);
+    }
+
+    // v10: clusters sobre o MESMO IB que acabou de ir para o blob (cru ou codificado) —
+    // as faixas sao posicionais a ele, como o payload de RT. Alinhamento: toda regiao
+    // acima termina em multiplo de 4, que e o alinhamento do SMeshCluster.
+    std::vector<Smile::SMeshCluster> clusters;
+    Smile::BuildMeshClusters(sm.Vertices, sm.Indices, clusters);
+    e.ClusterOffset = bytes.size();
+    e.ClusterCount  = (uint32_t)clusters.size();
+    AppendBytes(bytes, clusters);
+
+    // v11: LODs do IB FINAL (depois do MeshOptimize), sobre o mesmo VB — os niveis herdam a
+    // ordem de fetch do LOD0. Tabela e indices seguem os clusters, alinhados a 4 como eles.
+    if (options.Lods) {
+        std::vector<Smile::SMeshLod> lods;
+        std::vector<uint32_t> lodIndices;
+        Smile::BuildMeshLods(sm.Vertices, sm.Indices, lods, lodIndices);
+        e.LodOffset = bytes.size();
+        e.LodCount  = (uint32_t)lods.size();
+        AppendBytes(bytes, lods);
+        AppendBytes(bytes, lodIndices);
+    }
+
+    out.Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
 // ----------------------------------------------------------------------------
 int main(int argc, char** argv) {
     // --opaque-glass: vidro cooka OPACO (entra no G-buffer -> reflexoes RT pintam nele) em vez
     // de translucido. P/ cenas de casca oca (Emerald Square: predios vazios atras da janela);
     // cenas com interior real atras do vidro (Bistro) ficam no default translucido.
     bool opaqueGlass = false;
+    // --compress: bloco codificado por mesh (v9). Sem perda; o load troca leitura de disco por
+    // decodificacao paralela. --quantize-positions (implica --compress): posicao em 16 bits na
+    // AABB local da parte — com perda, passo de extensao/65535 por eixo.
+    bool compress = false;
+    Smile::FMeshCodingOptions coding;
+    // --no-optimize: pula a reordenacao de triangulos/vertices (para comparar ou depurar a ordem
+    // original do FBX). A geometria e a mesma nos dois casos; so a ordem muda.
+    bool optimize = true;
+    // --jobs N: threads do cook de geometria (default = todos os cores). A saida e a mesma para
+    // qualquer N — so o tempo muda; --jobs 1 e o cook serial de referencia.
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    // --no-cache: cozinha tudo do zero sem ler nem gravar o .cookcache (medir o cook frio, ou
+    // desconfiar do cache).
+    bool useCache = true;
+    // --weld-epsilon E: solda vertices cujos 8 floats caem na mesma celula de lado E (posicao em
+    // metros, normal e UV na mesma grade). Default 0 = weld exato por bytes, como sempre.
+    Smile::Cooker::FWeldOptions weld;
+    // --no-lods: nao gera a cadeia de LODs (LodCount 0 em toda entrada; o runtime desenha o LOD0).
+    bool lods = true;
+    // --no-textures: nao cozinha texturas (o material guarda o PNG/TGA/JPG e o runtime decodifica
+    // no load, como antes). --tex-compat: BC1/BC3 no lugar do BC7 nos slots de cor.
+    // --tex-quality fast|normal|slow: tier do encoder BC (BlockCompress.h); default normal.
+    bool cookTextures = true;
+    Smile::Cooker::FTextureCookOptions textureOptions;
     std::vector<fs::path> positional;
     for (int i = 1; i < argc; ++i) {
-        if (std::string(argv[i]) == "--opaque-glass") { opaqueGlass = true; continue; }
+        const std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc) { threadCount = (unsigned)std::max(1, std::atoi(argv[++i])); continue; }
+        if (arg == "--opaque-glass") { opaqueGlass = true; continue; }
+        if (arg == "--compress") { compress = true; continue; }
+        if (arg == "--quantize-positions") { compress = true; coding.QuantizePositions = true; continue; }
+        if (arg == "--no-optimize") { optimize = false; continue; }
+        if (arg == "--no-cache") { useCache = false; continue; }
+        if (arg == "--weld-epsilon" && i + 1 < argc) { weld.Epsilon = (float)std::atof(argv[++i]); continue; }
+        if (arg == "--no-lods") { lods = false; continue; }
+        if (arg == "--no-textures") { cookTextures = false; continue; }
+        if (arg == "--tex-compat") { textureOptions.Compat = true; continue; }
+        if (arg == "--tex-quality" && i + 1 < argc) {
+            const std::string tier = argv[++i];
+            if (tier == "fast")        textureOptions.Quality = Smile::Cooker::EBlockQuality::Fast;
+            else if (tier == "normal") textureOptions.Quality = Smile::Cooker::EBlockQuality::Normal;
+            else if (tier == "slow")   textureOptions.Quality = Smile::Cooker::EBlockQuality::Slow;
+            else { std::printf("[Cooker] --tex-quality: esperado fast, normal ou slow (veio '%s')\n", tier.c_str()); return 1; }
+            continue;
+        }
         positional.emplace_back(argv[i]);
     }
     if (positional.empty()) {
-        std::printf("Uso: SmileCooker <entrada.fbx> [saida_sem_extensao] [--opaque-glass]\n");
+        std::printf("Uso: SmileCooker <entrada.fbx> [saida_sem_extensao] [--opaque-glass] [--compress]"
+                    " [--quantize-positions] [--no-optimize] [--jobs N] [--no-cache] [--weld-epsilon E]"
+                    " [--no-lods] [--no-textures] [--tex-compat] [--tex-quality fast|normal|slow]\n");
         return 1;
     }
     fs::path inPath = positional[0];
     fs::path sceneDir = inPath.parent_path();
     fs::path outBase = (positional.size() >= 2) ? positional[1]
                                                 : (sceneDir / inPath.stem());
+    CookOptions cookOptions;
+    cookOptions.Optimize = optimize;
+    cookOptions.Compress = compress;
+    cookOptions.Coding   = coding;
+    cookOptions.Weld     = weld;
+    cookOptions.Lods     = lods;
+
+    // Sal das chaves do cache: tudo o que muda o resultado do CookPart sem estar no FBX.
+    Smile::Cooker::FHasher salt;
+    salt.Add((uint64_t)Smile::kCookedVersion);
+    salt.Add((uint64_t)Smile::Cooker::kCookCacheRevision);
+    salt.Add((uint64_t)((kReverseWinding ? 1u : 0u) | (optimize ? 2u : 0u) | (compress ? 4u : 0u) |
+                        (coding.QuantizePositions ? 8u : 0u) | (lods ? 16u : 0u)));
+    salt.Add((uint64_t)std::bit_cast<uint32_t>(weld.Epsilon > 0.0f ? weld.Epsilon : 0.0f));
+    const uint64_t cacheSalt = salt.Value();
+    fs::path cachePath = outBase; cachePath += ".cookcache";
+    Smile::Cooker::FCookCache cookCache;
+    if (useCache) {
+        std::string cacheError;
+        cookCache.Load(cachePath, cacheError);
+        if (!cacheError.empty())
+            std::printf("[Cooker]   ! cache %s: %s\n", cachePath.string().c_str(), cacheError.c_str());
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    auto msSince = [](std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+    };
 
     std::printf("[Cooker] Carregando FBX: %s\n", inPath.string().c_str());
 
@@ -465,165 +712,285 @@ int main(int argc, char** argv) {
         return base + " [" + std::string(mn, strnlen(mn, Smile::kCookedMaxName)) + "]";
     };
 
+    const double collectStartMs = msSince(t0);
+
     // --- Geometria ---
-    std::vector<Smile::SMeshEntry>     entries;
-    std::vector<Smile::SSceneRenderable> renderables;
-    std::vector<uint8_t>               geo; // blob unico (verts + indices intercalados por mesh)
+    // Tres fases, para o cook pesado rodar em paralelo sem mudar um byte da saida:
+    //   1. Serial, na ordem dos nos: resolve materiais (a ordem de primeira aparicao define os
+    //      indices) e registra cada uso de (malha, parte), com um job por chave inedita.
+    //   2. Paralela: CookPart de cada job, em ordem qualquer, cada um no seu slot.
+    //   3. Serial, na ordem da fase 1: monta entries, blob e renderaveis como o laco unico fazia.
+    // A fase 3 e a unica que decide indices e offsets, e ela so depende da ordem dos nos e do
+    // conteudo (deterministico) de cada job — entao o resultado independe de --jobs.
+    struct PartUse { const ufbx_node* Node; uint32_t Material; uint32_t Job; };
+    struct CookJob { const ufbx_mesh* Mesh; size_t Part; };
+    std::vector<PartUse> uses;
+    std::vector<CookJob> jobs;
 
     // Dedup (v7): a geometria agora sai em espaco LOCAL, entao dois nos que apontam para o mesmo
     // ufbx_mesh produzem bytes IDENTICOS — a diferenca entre eles passou a viver so no transform.
     // Chave = (ufbx_mesh, indice da parte de material). Medido: Emerald Square 2479 -> 281 partes
     // (uma malha usada por 201 nos); Bistro e Sponza nao tem instancing por ponteiro e nao mudam.
-    std::map<std::pair<const ufbx_mesh*, size_t>, uint32_t> meshCache;
-
-    // no -> indice do PRIMEIRO renderavel que ele emitiu (para resolver ParentIndex).
-    std::unordered_map<const ufbx_node*, int32_t> firstRenderableOfNode;
-
-    std::vector<uint32_t> triBuf;
-    std::vector<Smile::FRTTriangle> rtTris; // reusado por parte; ver a geracao abaixo
-    size_t totalTris = 0;
-    size_t totalRtTris = 0;
-    size_t dedupHits = 0;
+    std::map<std::pair<const ufbx_mesh*, size_t>, uint32_t> jobOf;
 
     for (size_t ni = 0; ni < scene->nodes.count; ++ni) {
         const ufbx_node* node = scene->nodes.data[ni];
         if (!node || !node->mesh) continue;
         const ufbx_mesh* mesh = node->mesh;
-        triBuf.resize(std::max<size_t>(mesh->max_face_triangles * 3, 3));
-
-        // v7: geometria em LOCAL. Sobra do mundo apenas a conversao de eixo RH->LH (nega Z), que
-        // e do ESPACO e nao do no — por isso continua aqui e mantem os bytes iguais entre
-        // instancias. A inversa-transposta saiu junto com o bake: sem transform no vertice, a
-        // normal local nao precisa de correcao de escala (quem aplica escala e a matriz de modelo).
-        //
-        // O espelhamento tambem deixa de ser por no: com o transform fora do vertice, o
-        // determinante negativo passa a viver na ESCALA do TRS, e quem inverte o winding
-        // efetivo e a matriz de modelo. Ficaria errado bakear o flip na geometria compartilhada.
-        // (Medido: nenhuma das 3 cenas tem determinante negativo.)
-        const bool reverseWinding = kReverseWinding;
-
-        // Ancestral renderavel mais proximo (o pai direto pode ser um grupo sem mesh).
-        int32_t parentIdx = -1;
-        for (const ufbx_node* a = node->parent; a; a = a->parent) {
-            auto it = firstRenderableOfNode.find(a);
-            if (it != firstRenderableOfNode.end()) { parentIdx = it->second; break; }
-        }
-
         for (size_t pi = 0; pi < mesh->material_parts.count; ++pi) {
-            const ufbx_mesh_part& part = mesh->material_parts.data[pi];
-            if (part.num_triangles == 0) continue;
+            if (mesh->material_parts.data[pi].num_triangles == 0) continue;
 
             // Material desta parte: per-instance (node->materials) tem precedencia.
             const ufbx_material* mat = nullptr;
             if (pi < node->materials.count)      mat = node->materials.data[pi];
             else if (pi < mesh->materials.count) mat = mesh->materials.data[pi];
-            uint32_t matIdx = ResolveMaterial(mat);
-
-            // Ja cozinhamos esta (malha, parte)? Em espaco local os bytes seriam identicos —
-            // so referencia. O MATERIAL nao entra na chave de proposito: ele e por RENDERAVEL
-            // (node->materials tem precedencia sobre mesh->materials), entao duas instancias da
-            // mesma malha podem legitimamente usar materiais diferentes sem duplicar geometria.
-            if (auto hit = meshCache.find({ mesh, pi }); hit != meshCache.end()) {
-                const NodeTRS T = DecomposeToEngineTRS(node->geometry_to_world);
-                Smile::SSceneRenderable r{};
-                r.MeshIndex = hit->second;
-                r.MaterialIndex = matIdx;
-                std::memcpy(r.Position, T.Pos, sizeof(r.Position));
-                std::memcpy(r.RotationEuler, T.Rot, sizeof(r.RotationEuler));
-                std::memcpy(r.Scale, T.Scale, sizeof(r.Scale));
-                r.ParentIndex = parentIdx;
-                SetStr(r.Name, Smile::kCookedMaxName, NodeRenderableName(node, mesh, matIdx));
-                firstRenderableOfNode.emplace(node, (int32_t)renderables.size());
-                renderables.push_back(r);
-                ++dedupHits;
-                continue;
-            }
+            const uint32_t matIdx = ResolveMaterial(mat);
 
-            SubMesh sm;
-            for (size_t fi = 0; fi < part.face_indices.count; ++fi) {
-                ufbx_face face = mesh->faces.data[part.face_indices.data[fi]];
-                uint32_t numTri = ufbx_triangulate_face(triBuf.data(), triBuf.size(), mesh, face);
-                for (uint32_t t = 0; t < numTri; ++t) {
-                    uint32_t corner[3] = { triBuf[t*3+0], triBuf[t*3+1], triBuf[t*3+2] };
-                    uint32_t outIdx[3];
-                    for (int c = 0; c < 3; ++c) {
-                        ufbx_vec3 p = ufbx_get_vertex_vec3(&mesh->vertex_position, corner[c]);
-                        ufbx_vec3 n = mesh->vertex_normal.exists
-                                    ? ufbx_get_vertex_vec3(&mesh->vertex_normal, corner[c])
-                                    : ufbx_vec3{0,1,0};
-                        ufbx_vec2 uv = mesh->vertex_uv.exists
-                                    ? ufbx_get_vertex_vec2(&mesh->vertex_uv, corner[c])
-                                    : ufbx_vec2{0,0};
-                        // v7: SEM transform aqui. A posicao e a normal ficam em espaco local; o
-                        // geometry_to_world virou o TRS do renderavel. E isto que faz duas
-                        // instancias da mesma malha gerarem bytes identicos e poderem ser
-                        // deduplicadas — com o bake, cada uma era uma copia unica.
-                        double nl = std::sqrt(n.x*n.x + n.y*n.y + n.z*n.z);
-                        if (nl > 1e-12) { n.x/=nl; n.y/=nl; n.z/=nl; }
-                        Vertex v;
-                        v.Position[0] = (float)p.x; v.Position[1] = (float)p.y; v.Position[2] = -(float)p.z; // RH->LH
-                        v.Normal[0]   = (float)n.x; v.Normal[1]   = (float)n.y; v.Normal[2]   = -(float)n.z;
-                        v.TexCoord[0] = (float)uv.x; v.TexCoord[1] = 1.0f - (float)uv.y; // V flip (FBX->D3D)
-                        outIdx[c] = sm.Add(v);
+            // O MATERIAL nao entra na chave de proposito: ele e por RENDERAVEL (node->materials
+            // tem precedencia sobre mesh->materials), entao duas instancias da mesma malha podem
+            // legitimamente usar materiais diferentes sem duplicar geometria.
+            const auto [it, inserted] = jobOf.emplace(std::make_pair(mesh, pi), (uint32_t)jobs.size());
+            if (inserted) jobs.push_back({ mesh, pi });
+            uses.push_back({ node, matIdx, it->second });
+        }
+    }
+    const double cookStartMs = msSince(t0);
+
+    std::vector<CookedPart> cooked(jobs.size());
+    {
+        // Maiores primeiro: a fila e por contador atomico, e uma parte enorme pega por ultimo
+        // deixaria todos os outros workers ociosos esperando por ela.
+        std::vector<uint32_t> order(jobs.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return jobs[a].Mesh->material_parts.data[jobs[a].Part].num_triangles >
+                   jobs[b].Mesh->material_parts.data[jobs[b].Part].num_triangles;
+        });
+        std::atomic<size_t> nextJob{ 0 };
+        std::mutex          errorMutex;
+        std::string         error;
+        auto worker = [&] {
+            for (size_t j = nextJob++; j < order.size(); j = nextJob++) {
+                const CookJob& job = jobs[order[j]];
+                const ufbx_mesh_part& part = job.Mesh->material_parts.data[job.Part];
+                try {
+                    if (!useCache) {
+                        cooked[order[j]] = CookPart(job.Mesh, part, cookOptions);
+                        continue;
                     }
-                    if (reverseWinding) {
-                        sm.Indices.push_back(outIdx[0]);
-                        sm.Indices.push_back(outIdx[2]);
-                        sm.Indices.push_back(outIdx[1]);
+                    // Hashear custa uma passada de leitura; cozinhar, weld + otimizacao + RT +
+                    // clusters (+ codec). No acerto, Ms vira o custo do hash e da copia.
+                    const auto start = std::chrono::steady_clock::now();
+                    const uint64_t key = Smile::Cooker::HashPartSource(*job.Mesh, part, cacheSalt);
+                    CookedPart& out = cooked[order[j]];
+                    if (cookCache.Find(key, out)) {
+                        out.Ms = msSince(start);
                     } else {
-                        sm.Indices.push_back(outIdx[0]);
-                        sm.Indices.push_back(outIdx[1]);
-                        sm.Indices.push_back(outIdx[2]);
+                        out = CookPart(job.Mesh, part, cookOptions);
+                        out.Ms = msSince(start);
+                        cookCache.Store(key, out);
                     }
-                    ++totalTris;
+                } catch (const std::exception& ex) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (error.empty()) error = ex.what();
+                    nextJob = order.size();
+                }
+            }
+        };
+        const unsigned workerCount = (unsigned)std::min<size_t>(threadCount, jobs.size());
+        if (workerCount <= 1) {
+            worker();
+        } else {
+            std::vector<std::jthread> workers;
+            for (unsigned i = 0; i < workerCount; ++i) workers.emplace_back(worker);
+        }
+        if (!error.empty()) {
+            std::printf("[Cooker] ERRO no cook das partes: %s\n", error.c_str());
+            ufbx_free_scene(scene);
+            return 4;
+        }
+    }
+    const double assembleStartMs = msSince(t0);
+
+    std::vector<Smile::SMeshEntry>     entries;
+    std::vector<Smile::SSceneRenderable> renderables;
+    std::vector<uint8_t>               geo; // blob unico (regioes de cada mesh em sequencia)
+
+    // no -> indice do PRIMEIRO renderavel que ele emitiu (para resolver ParentIndex).
+    std::unordered_map<const ufbx_node*, int32_t> firstRenderableOfNode;
+    // job -> indice da entrada ja montada; -1 = ainda nao apareceu (ou saiu vazio).
+    std::vector<int32_t> entryOfJob(jobs.size(), -1);
+
+    size_t totalClusters = 0;
+    size_t lodMeshes = 0, lodBytes = 0;
+    size_t lodTris[Smile::kMeshLodMaxLevels] = {};
+    size_t totalTris = 0;
+    size_t totalRtTris = 0;
+    size_t dedupHits = 0;
+    size_t rawGeoBytes = 0; // o que o blob teria sem --compress (para o relatorio)
+    Smile::Cooker::FVertexCacheStats cacheBefore, cacheAfter;
+    size_t optimizeClusters = 0;
+    double cookSerialMs = 0.0; // soma dos jobs: o que a fase 2 custaria numa thread so
+
+    const ufbx_node* parentOf = nullptr;
+    int32_t parentIdx = -1;
+    for (const PartUse& use : uses) {
+        const ufbx_node* node = use.Node;
+        if (node != parentOf) {
+            // Ancestral renderavel mais proximo (o pai direto pode ser um grupo sem mesh).
+            parentOf = node;
+            parentIdx = -1;
+            for (const ufbx_node* a = node->parent; a; a = a->parent) {
+                auto it = firstRenderableOfNode.find(a);
+                if (it != firstRenderableOfNode.end()) { parentIdx = it->second; break; }
+            }
+        }
+
+        const CookedPart& part = cooked[use.Job];
+        if (entryOfJob[use.Job] < 0) {
+            // Primeira vez da chave (ou nova tentativa de uma que saiu vazia, como no laco unico).
+            totalTris += part.Triangles;
+            if (part.Empty) continue;
+
+            Smile::SMeshEntry e = part.Entry;
+            const uint64_t base = geo.size();
+            if (e.Flags & Smile::kMeshEntryCoded) {
+                e.CodedOffset += base;
+            } else {
+                e.VertexOffset     += base;
+                e.IndexOffset      += base;
+                e.RTTriangleOffset += base;
+            }
+            e.ClusterOffset += base;
+            if (e.LodCount > 0) {
+                e.LodOffset += base;
+                // Triangulos por nivel (LOD1..), lidos da propria regiao: a parte pode ter vindo do
+                // cache e nao ha outra copia dos niveis aqui.
+                const uint8_t* levels = part.Bytes.data() + part.Entry.LodOffset;
+                for (uint32_t l = 0; l < e.LodCount && l < Smile::kMeshLodMaxLevels; ++l) {
+                    Smile::SMeshLod level;
+                    std::memcpy(&level, levels + l * sizeof(level), sizeof(level));
+                    lodTris[l] += level.IndexCount / 3u;
+                    lodBytes   += sizeof(level) + level.IndexCount * sizeof(uint32_t);
                 }
+                ++lodMeshes;
             }
-            if (sm.Vertices.empty() || sm.Indices.empty()) continue;
-
-            Smile::SMeshEntry e{};
-            e.VertexCount = (uint32_t)sm.Vertices.size();
-            e.IndexCount  = (uint32_t)sm.Indices.size();
-            for (int c = 0; c < 3; ++c) { e.AABBMin[c] = sm.Min[c]; e.AABBMax[c] = sm.Max[c]; }
-            e.VertexOffset = geo.size();
-            geo.insert(geo.end(), reinterpret_cast<uint8_t*>(sm.Vertices.data()),
-                       reinterpret_cast<uint8_t*>(sm.Vertices.data()) + sm.Vertices.size()*sizeof(Vertex));
-            e.IndexOffset = geo.size();
-            geo.insert(geo.end(), reinterpret_cast<uint8_t*>(sm.Indices.data()),
-                       reinterpret_cast<uint8_t*>(sm.Indices.data()) + sm.Indices.size()*sizeof(uint32_t));
-
-            // v8: payload de RT, AQUI e nao antes. Neste ponto `sm.Indices` ja passou pelo weld
-            // (sm.Add) e pelo reverseWinding do laco acima, entao o triangulo i deste vetor e
-            // exatamente o PrimitiveIndex i que o BLAS vera. Gerar antes do winding inverteria o
-            // cross e a normal de face sairia trocada — silenciosamente, porque so o facing
-            // mudaria e a imagem so denunciaria no verso.
-            rtTris.clear();
-            Smile::BuildRTTriangles(sm.Vertices.data(), (uint32_t)sm.Vertices.size(),
-                                    sm.Indices.data(), (uint32_t)sm.Indices.size(), rtTris);
-            e.RTTriangleOffset = geo.size();
-            e.RTTriangleCount  = (uint32_t)rtTris.size();
-            geo.insert(geo.end(), reinterpret_cast<uint8_t*>(rtTris.data()),
-                       reinterpret_cast<uint8_t*>(rtTris.data()) + rtTris.size()*sizeof(Smile::FRTTriangle));
-            totalRtTris += rtTris.size();
-
-            uint32_t meshIdx = (uint32_t)entries.size();
+            geo.insert(geo.end(), part.Bytes.begin(), part.Bytes.end());
+
+            entryOfJob[use.Job] = (int32_t)entries.size();
             entries.push_back(e);
-            meshCache.emplace(std::make_pair(mesh, pi), meshIdx);
-
-            const NodeTRS T = DecomposeToEngineTRS(node->geometry_to_world);
-            Smile::SSceneRenderable r{};
-            r.MeshIndex = meshIdx;
-            r.MaterialIndex = matIdx;
-            std::memcpy(r.Position, T.Pos, sizeof(r.Position));
-            std::memcpy(r.RotationEuler, T.Rot, sizeof(r.RotationEuler));
-            std::memcpy(r.Scale, T.Scale, sizeof(r.Scale));
-            r.ParentIndex = parentIdx;
-            SetStr(r.Name, Smile::kCookedMaxName, NodeRenderableName(node, mesh, matIdx));
-            firstRenderableOfNode.emplace(node, (int32_t)renderables.size());
-            renderables.push_back(r);
+            totalRtTris += e.RTTriangleCount;
+            totalClusters += e.ClusterCount;
+            rawGeoBytes += part.RawBytes;
+            cacheBefore += part.Cache.Before;
+            cacheAfter  += part.Cache.After;
+            optimizeClusters += part.Cache.Clusters;
+        } else {
+            // Ja cozinhamos esta (malha, parte)? Em espaco local os bytes seriam identicos — so
+            // referencia.
+            ++dedupHits;
         }
+
+        const NodeTRS T = DecomposeToEngineTRS(node->geometry_to_world);
+        Smile::SSceneRenderable r{};
+        r.MeshIndex = (uint32_t)entryOfJob[use.Job];
+        r.MaterialIndex = use.Material;
+        std::memcpy(r.Position, T.Pos, sizeof(r.Position));
+        std::memcpy(r.RotationEuler, T.Rot, sizeof(r.RotationEuler));
+        std::memcpy(r.Scale, T.Scale, sizeof(r.Scale));
+        r.ParentIndex = parentIdx;
+        SetStr(r.Name, Smile::kCookedMaxName, NodeRenderableName(node, node->mesh, use.Material));
+        firstRenderableOfNode.emplace(node, (int32_t)renderables.size());
+        renderables.push_back(r);
     }
+    for (const CookedPart& part : cooked) cookSerialMs += part.Ms;
+    cooked.clear();
+    cooked.shrink_to_fit();
 
     ufbx_free_scene(scene);
+    const double textureStartMs = msSince(t0);
+
+    // --- Texturas ---
+    // Um job por (fonte, slot): a mesma PNG como BaseColor (sRGB, BC7) e como Specular (linear)
+    // sao dois DDS. Rodam em paralelo, maiores primeiro, e cada job so escreve o proprio arquivo —
+    // os materiais sao reescritos depois, em serie.
+    using Smile::Cooker::ETextureSlot;
+    auto textureFields = [](Smile::SSceneMaterial& m) {
+        return std::array<std::pair<char*, ETextureSlot>, 6>{ {
+            { m.BaseColor, ETextureSlot::BaseColor }, { m.Specular,  ETextureSlot::Specular  },
+            { m.Normal,    ETextureSlot::Normal    }, { m.Emissive,  ETextureSlot::Emissive  },
+            { m.Metalness, ETextureSlot::Metalness }, { m.Roughness, ETextureSlot::Roughness } } };
+    };
+    struct TextureJob { std::string Source; ETextureSlot Slot; std::string Output; uint64_t Bytes; };
+    std::vector<TextureJob> textureJobs;
+    std::vector<Smile::Cooker::FTextureCookResult> textureResults;
+    std::map<std::pair<std::string, ETextureSlot>, uint32_t> textureJobOf;
+    if (cookTextures) {
+        for (Smile::SSceneMaterial& m : materials)
+            for (const auto& [field, slot] : textureFields(m)) {
+                const std::string rel(field, strnlen(field, Smile::kCookedMaxPath));
+                if (rel.empty() || ToLower(fs::path(rel).extension().string()) == ".dds") continue;
+                const auto [it, inserted] = textureJobOf.emplace(std::make_pair(rel, slot), (uint32_t)textureJobs.size());
+                if (!inserted) continue;
+                std::error_code ec;
+                const uint64_t bytes = fs::file_size(sceneDir / rel, ec);
+                textureJobs.push_back({ rel, slot, "", ec ? 0 : bytes });
+            }
+        // Textures/Cooked/<nome>.dds; nome repetido (mesma fonte em dois slots, ou foo.png e foo.tga)
+        // leva extensao e slot no nome para nao colidir.
+        std::unordered_map<std::string, uint32_t> stemCount;
+        for (const TextureJob& job : textureJobs) ++stemCount[ToLower(BaseNameNoExt(job.Source))];
+        for (TextureJob& job : textureJobs) {
+            const fs::path src(job.Source);
+            std::string name = src.stem().string();
+            if (stemCount[ToLower(name)] > 1)
+                name += "." + ToLower(src.extension().string().substr(1)) + "." +
+                        Smile::Cooker::TextureSlotName(job.Slot);
+            job.Output = (fs::path("Textures") / "Cooked" / (name + ".dds")).generic_string();
+        }
+
+        textureResults.resize(textureJobs.size());
+        std::vector<uint32_t> order(textureJobs.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return textureJobs[a].Bytes > textureJobs[b].Bytes;
+        });
+        std::atomic<size_t> nextJob{ 0 };
+        auto worker = [&] {
+            for (size_t j = nextJob++; j < order.size(); j = nextJob++) {
+                const TextureJob& job = textureJobs[order[j]];
+                textureResults[order[j]] = Smile::Cooker::CookTexture(sceneDir, job.Source, job.Output, job.Slot,
+                                                                      textureOptions);
+            }
+        };
+        const unsigned workerCount = (unsigned)std::min<size_t>(threadCount, textureJobs.size());
+        // Menos texturas que cores (cena pequena, ou a cauda das grandes): o que sobra vai para as
+        // linhas de blocos de cada textura. Os bytes nao mudam com isso.
+        textureOptions.Threads = std::max(1u, threadCount / std::max(1u, workerCount));
+        if (workerCount <= 1) {
+            worker();
+        } else {
+            std::vector<std::jthread> workers;
+            for (unsigned i = 0; i < workerCount; ++i) workers.emplace_back(worker);
+        }
+
+        // Falha mantem o caminho original: o runtime ainda decodifica a fonte no load.
+        for (Smile::SSceneMaterial& m : materials)
+            for (const auto& [field, slot] : textureFields(m)) {
+                const auto it = textureJobOf.find({ std::string(field, strnlen(field, Smile::kCookedMaxPath)), slot });
+                if (it == textureJobOf.end() || textureResults[it->second].Failed) continue;
+                SetStr(field, Smile::kCookedMaxPath, textureResults[it->second].OutputRelative);
+            }
+    }
+    const double writeStartMs = msSince(t0);
+
+    if (useCache) {
+        const uint64_t lookups = cookCache.Hits() + cookCache.Misses();
+        std::printf("[Cooker] Cache: %llu de %llu partes reaproveitadas (%.1f%%), %llu cozidas\n",
+                    (unsigned long long)cookCache.Hits(), (unsigned long long)lookups,
+                    lookups == 0 ? 0.0 : 100.0 * (double)cookCache.Hits() / (double)lookups,
+                    (unsigned long long)cookCache.Misses());
+    }
 
     std::printf("[Cooker] Meshes: %zu | Renderaveis: %zu | Materiais: %zu | Triangulos: %zu | Geo: %.1f MB\n",
                 entries.size(), renderables.size(), materials.size(), totalTris,
@@ -637,35 +1004,128 @@ int main(int argc, char** argv) {
     std::printf("[Cooker] Payload RT: %zu triangulos unicos x %zu B = %.1f MB (%.1f%% do blob)\n",
                 totalRtTris, sizeof(Smile::FRTTriangle),
                 totalRtTris * sizeof(Smile::FRTTriangle) / (1024.0*1024.0),
-                geo.empty() ? 0.0 : 100.0 * (double)(totalRtTris * sizeof(Smile::FRTTriangle))
-                                  / (double)geo.size());
+                rawGeoBytes == 0 ? 0.0 : 100.0 * (double)(totalRtTris * sizeof(Smile::FRTTriangle))
+                                       / (double)rawGeoBytes);
+    std::printf("[Cooker] Clusters: %zu (%.1f triangulos/cluster, %.1f MB)\n",
+                totalClusters, totalClusters == 0 ? 0.0 : (double)totalRtTris / (double)totalClusters,
+                totalClusters * sizeof(Smile::SMeshCluster) / (1024.0*1024.0));
+    if (lods) {
+        // Soma de cada nivel sobre as partes unicas. Mesh sem cadeia (pequeno demais, ou travado
+        // por costura/borda) nao entra no LOD1+: a coluna mede o que os niveis cobrem, nao a cena.
+        std::printf("[Cooker] LODs: %zu de %zu meshes com cadeia (%.1f MB) | LOD0 %zu", lodMeshes, entries.size(),
+                    lodBytes / (1024.0*1024.0), totalRtTris);
+        for (uint32_t l = 0; l < Smile::kMeshLodMaxLevels && lodTris[l] > 0; ++l)
+            std::printf(" | LOD%u %zu", l + 1, lodTris[l]);
+        std::printf(" triangulos\n");
+    }
+    // ACMR/ATVR agregados pelo total de misses/triangulos/vertices das partes unicas (FIFO 16).
+    std::printf("[Cooker] Cache de vertices%s: ACMR %.3f -> %.3f | ATVR %.3f -> %.3f | %zu clusters de overdraw\n",
+                optimize ? "" : " (--no-optimize)", cacheBefore.ACMR(), cacheAfter.ACMR(),
+                cacheBefore.ATVR(), cacheAfter.ATVR(), optimizeClusters);
+    if (!textureJobs.empty()) {
+        size_t reused = 0, failed = 0;
+        uint64_t sourceBytes = 0, ddsBytes = 0, cookedDdsBytes = 0, rgbaBytes = 0;
+        double textureSerialMs = 0.0;
+        size_t perFormat[5] = {};
+        uint64_t cookedPixels = 0;
+        Smile::Cooker::FBlockQualityReport quality;
+        double worstPsnr = 1e30;
+        size_t worstJob = 0;
+        for (size_t i = 0; i < textureResults.size(); ++i) {
+            const Smile::Cooker::FTextureCookResult& r = textureResults[i];
+            textureSerialMs += r.Ms;
+            if (r.Failed) {
+                ++failed;
+                std::printf("[Cooker]   ! textura %s: %s\n", textureJobs[i].Source.c_str(), r.Error.c_str());
+                continue;
+            }
+            sourceBytes += r.SourceBytes;
+            ddsBytes    += r.OutputBytes;
+            if (r.Reused) {
+                ++reused;
+                continue;
+            }
+            ++perFormat[(size_t)r.Format];
+            cookedDdsBytes += r.OutputBytes;
+            rgbaBytes      += (uint64_t)r.Width * r.Height * 4 * 4 / 3;
+            cookedPixels   += (uint64_t)r.Width * r.Height * 4 / 3;
+            quality.Merge(r.Quality);
+            if (r.Quality.Psnr() < worstPsnr) { worstPsnr = r.Quality.Psnr(); worstJob = i; }
+        }
+        std::printf("[Cooker] Texturas: %zu jobs | %zu cozidas (BC1 %zu, BC3 %zu, BC4 %zu, BC5 %zu, BC7 %zu),"
+                    " %zu reaproveitadas, %zu falhas | fonte %.1f MB -> DDS %.1f MB | soma %.0f ms\n",
+                    textureJobs.size(), textureJobs.size() - reused - failed, perFormat[0], perFormat[1],
+                    perFormat[2], perFormat[3], perFormat[4], reused, failed, sourceBytes / (1024.0*1024.0),
+                    ddsBytes / (1024.0*1024.0), textureSerialMs);
+        // O que as cozidas agora ocupariam decodificadas em RGBA8 no load (mip chain inteira, ~4/3
+        // da mip 0): a VRAM que o DDS substitui.
+        if (cookedDdsBytes > 0)
+            std::printf("[Cooker] Texturas em VRAM: RGBA8 %.1f MB -> BC %.1f MB (%.1fx menor)\n",
+                        rgbaBytes / (1024.0*1024.0), cookedDdsBytes / (1024.0*1024.0),
+                        (double)rgbaBytes / (double)cookedDdsBytes);
+        // Qualidade contra as mips RGBA8 que o LoadCPU geraria da mesma fonte (canais que cada
+        // formato guarda), e a vazao do encode na parede do estagio.
+        if (cookedPixels > 0) {
+            const double textureWallMs = writeStartMs - textureStartMs;
+            std::printf("[Cooker] Texturas BC (%s): PSNR %.2f dB, SSIM %.4f | pior %s %.2f dB | %.1f MPix em %.0f ms"
+                        " (%.1f MPix/s)\n",
+                        Smile::Cooker::BlockQualityName(textureOptions.Quality), quality.Psnr(), quality.Ssim(),
+                        textureJobs[worstJob].Source.c_str(), worstPsnr, cookedPixels / 1e6, textureWallMs,
+                        cookedPixels / 1e3 / std::max(textureWallMs, 1e-3));
+        }
+    }
+    if (compress)
+        std::printf("[Cooker] Codificado%s: %.1f MB -> %.1f MB (%.1f%%)\n",
+                    coding.QuantizePositions ? " (posicao quantizada)" : "",
+                    rawGeoBytes / (1024.0*1024.0), geo.size() / (1024.0*1024.0),
+                    rawGeoBytes == 0 ? 0.0 : 100.0 * (double)geo.size() / (double)rawGeoBytes);
 
+    // Os dois arquivos passam pelo WriteFileIncremental: num recook em que nenhuma parte mudou
+    // de tamanho, o layout e o mesmo e so os blocos diferentes sao regravados (zero, se nada
+    // mudou) — o mtime ainda atualiza, e quem observa o arquivo ve o recook.
+    auto asBytes = []<typename T>(const T* data, size_t count) {
+        return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(data), count * sizeof(T));
+    };
+    uint64_t writtenBytes = 0, outputBytes = 0;
+    auto writeOutput = [&](const char* ext, std::initializer_list<std::span<const uint8_t>> pieces) {
+        fs::path p = outBase; p += ext;
+        const int64_t written = Smile::Cooker::WriteFileIncremental(p, std::span(pieces.begin(), pieces.size()));
+        if (written < 0) { std::printf("[Cooker] ERRO ao gravar %s\n", p.string().c_str()); return false; }
+        writtenBytes += (uint64_t)written;
+        for (const std::span<const uint8_t> piece : pieces) outputBytes += piece.size();
+        std::printf("[Cooker] Escrito: %s\n", p.string().c_str());
+        return true;
+    };
     // --- Escreve .smesh ---
     {
-        fs::path p = outBase; p += ".smesh";
-        FILE* f = std::fopen(p.string().c_str(), "wb");
-        if (!f) { std::printf("[Cooker] ERRO ao abrir %s\n", p.string().c_str()); return 3; }
-        Smile::SMeshHeader h{ Smile::kSMeshMagic, Smile::kCookedVersion, (uint32_t)entries.size(), 0 };
-        std::fwrite(&h, sizeof(h), 1, f);
-        std::fwrite(entries.data(), sizeof(Smile::SMeshEntry), entries.size(), f);
-        std::fwrite(geo.data(), 1, geo.size(), f);
-        std::fclose(f);
-        std::printf("[Cooker] Escrito: %s\n", p.string().c_str());
+        const Smile::SMeshHeader h{ Smile::kSMeshMagic, Smile::kCookedVersion, (uint32_t)entries.size(), 0 };
+        if (!writeOutput(".smesh", { asBytes(&h, 1), asBytes(entries.data(), entries.size()),
+                                     asBytes(geo.data(), geo.size()) }))
+            return 3;
     }
     // --- Escreve .sscene ---
     {
-        fs::path p = outBase; p += ".sscene";
-        FILE* f = std::fopen(p.string().c_str(), "wb");
-        if (!f) { std::printf("[Cooker] ERRO ao abrir %s\n", p.string().c_str()); return 3; }
-        Smile::SSceneHeader h{ Smile::kSSceneMagic, Smile::kCookedVersion,
-                               (uint32_t)materials.size(), (uint32_t)renderables.size() };
-        std::fwrite(&h, sizeof(h), 1, f);
-        std::fwrite(materials.data(), sizeof(Smile::SSceneMaterial), materials.size(), f);
-        std::fwrite(renderables.data(), sizeof(Smile::SSceneRenderable), renderables.size(), f);
-        std::fclose(f);
-        std::printf("[Cooker] Escrito: %s\n", p.string().c_str());
+        const Smile::SSceneHeader h{ Smile::kSSceneMagic, Smile::kCookedVersion,
+                                     (uint32_t)materials.size(), (uint32_t)renderables.size() };
+        if (!writeOutput(".sscene", { asBytes(&h, 1), asBytes(materials.data(), materials.size()),
+                                      asBytes(renderables.data(), renderables.size()) }))
+            return 3;
     }
+    std::printf("[Cooker] Regravado: %.1f de %.1f MB\n", writtenBytes / (1024.0*1024.0),
+                outputBytes / (1024.0*1024.0));
+    // So DEPOIS das saidas: um cook interrompido antes deixa o cache antigo, que continua
+    // coerente com o que ele descreve.
+    if (useCache && !cookCache.Save(cachePath))
+        std::printf("[Cooker]   ! nao foi possivel gravar %s\n", cachePath.string().c_str());
 
+    // Tempo de parede por fase. "soma" e o custo dos jobs numa thread so: soma/cook e o ganho
+    // efetivo do paralelismo, e fbx+coleta+montagem+escrita e o piso serial que sobra.
+    std::printf("[Cooker] Tempos (ms): fbx %.0f | materiais+coleta %.0f | cook %.0f (%zu partes, %u threads,"
+                " soma %.0f) | montagem %.0f | texturas %.0f | escrita %.0f | total %.0f\n",
+                collectStartMs, cookStartMs - collectStartMs, assembleStartMs - cookStartMs, jobs.size(),
+                (unsigned)std::min<size_t>(threadCount, std::max<size_t>(jobs.size(), 1)), cookSerialMs,
+                textureStartMs - assembleStartMs, writeStartMs - textureStartMs, msSince(t0) - writeStartMs,
+                msSince(t0));
     std::printf("[Cooker] OK.\n");
     return 0;
 }